@@ -0,0 +1,44 @@
+/**
+ * Converts the data files written by the loggers in the binary format (observer option "format: binary")
+ * to the text files that are read by the post-processing.
+ *
+ * Each given file "NAME.bin" is converted to the file "NAME" in the same folder. To convert all binary
+ * files of an experiment, call for example
+ *
+ *   find exdata -name '*.bin' -exec ./convert_binary_data {} +
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "coco.h"
+
+int main(int argc, char **argv) {
+  const char *extension = ".bin";
+  char *text_file_name;
+  size_t length;
+  int i;
+
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s FILE.bin [FILE.bin ...]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  for (i = 1; i < argc; i++) {
+    length = strlen(argv[i]);
+    if ((length <= strlen(extension)) || (strcmp(argv[i] + length - strlen(extension), extension) != 0)) {
+      fprintf(stderr, "Skipping %s (the name of a binary data file ends with %s)\n", argv[i], extension);
+      continue;
+    }
+    text_file_name = (char *)malloc(length + 1);
+    if (text_file_name == NULL) {
+      fprintf(stderr, "Out of memory\n");
+      return EXIT_FAILURE;
+    }
+    memcpy(text_file_name, argv[i], length - strlen(extension));
+    text_file_name[length - strlen(extension)] = '\0';
+    coco_observer_convert_binary_file(argv[i], text_file_name);
+    free(text_file_name);
+  }
+  return EXIT_SUCCESS;
+}
@@ -336,17 +336,50 @@ JNIEXPORT jdoubleArray JNICALL Java_CocoJNI_cocoEvaluateFunction
   problem = (coco_problem_t *) jproblem_pointer;
   number_of_objectives = (int) coco_problem_get_number_of_objectives(problem);
 
-  /* Call coco_evaluate_function */
+  /* Call coco_evaluate_function, writing the result directly to the returned array */
   x = (*jenv)->GetDoubleArrayElements(jenv, jx, NULL);
-  y = coco_allocate_vector(number_of_objectives);
+  jy = (*jenv)->NewDoubleArray(jenv, number_of_objectives);
+  y = (*jenv)->GetDoubleArrayElements(jenv, jy, NULL);
   coco_evaluate_function(problem, x, y);
 
-  /* Prepare the return value */
-  jy = (*jenv)->NewDoubleArray(jenv, number_of_objectives);
-  (*jenv)->SetDoubleArrayRegion(jenv, jy, 0, number_of_objectives, y);
+  /* Release resources */
+  (*jenv)->ReleaseDoubleArrayElements(jenv, jy, y, 0);
+  (*jenv)->ReleaseDoubleArrayElements(jenv, jx, x, JNI_ABORT);
+  return jy;
+}
 
-  /* Free resources */
-  coco_free_memory(y);
+/*
+ * Class:     CocoJNI
+ * Method:    cocoEvaluateFunctionBatch
+ * Signature: (J[D)[D
+ */
+JNIEXPORT jdoubleArray JNICALL Java_CocoJNI_cocoEvaluateFunctionBatch
+(JNIEnv *jenv, jclass interface_cls, jlong jproblem_pointer, jdoubleArray jx) {
+
+  coco_problem_t *problem = NULL;
+  double *y = NULL;
+  double *x = NULL;
+  int number_of_objectives, number_of_points;
+  jdoubleArray jy;
+
+  /* This test is both to prevent warning because interface_cls was not used and to check for exceptions */
+  if (interface_cls == NULL) {
+    jclass Exception = (*jenv)->FindClass(jenv, "java/lang/Exception");
+    (*jenv)->ThrowNew(jenv, Exception, "Exception in cocoEvaluateFunctionBatch\n");
+  }
+
+  problem = (coco_problem_t *) jproblem_pointer;
+  number_of_objectives = (int) coco_problem_get_number_of_objectives(problem);
+  number_of_points = (int) ((*jenv)->GetArrayLength(jenv, jx) / (jsize) coco_problem_get_dimension(problem));
+
+  /* Call coco_evaluate_function_batch, writing the results directly to the returned array */
+  x = (*jenv)->GetDoubleArrayElements(jenv, jx, NULL);
+  jy = (*jenv)->NewDoubleArray(jenv, number_of_points * number_of_objectives);
+  y = (*jenv)->GetDoubleArrayElements(jenv, jy, NULL);
+  coco_evaluate_function_batch(problem, x, y, (size_t) number_of_points);
+
+  /* Release resources */
+  (*jenv)->ReleaseDoubleArrayElements(jenv, jy, y, 0);
   (*jenv)->ReleaseDoubleArrayElements(jenv, jx, x, JNI_ABORT);
   return jy;
 }
@@ -374,17 +407,88 @@ JNIEXPORT jdoubleArray JNICALL Java_CocoJNI_cocoEvaluateConstraint
   problem = (coco_problem_t *) jproblem_pointer;
   number_of_constraints = (int) coco_problem_get_number_of_constraints(problem);
 
-  /* Call coco_evaluate_constraint */
+  /* Call coco_evaluate_constraint, writing the result directly to the returned array */
   x = (*jenv)->GetDoubleArrayElements(jenv, jx, NULL);
-  y = coco_allocate_vector(number_of_constraints);
+  jy = (*jenv)->NewDoubleArray(jenv, number_of_constraints);
+  y = (*jenv)->GetDoubleArrayElements(jenv, jy, NULL);
   coco_evaluate_constraint(problem, x, y);
 
-  /* Prepare the return value */
-  jy = (*jenv)->NewDoubleArray(jenv, number_of_constraints);
-  (*jenv)->SetDoubleArrayRegion(jenv, jy, 0, number_of_constraints, y);
+  /* Release resources */
+  (*jenv)->ReleaseDoubleArrayElements(jenv, jy, y, 0);
+  (*jenv)->ReleaseDoubleArrayElements(jenv, jx, x, JNI_ABORT);
+  return jy;
+}
 
-  /* Free resources */
-  coco_free_memory(y);
+/*
+ * Class:     CocoJNI
+ * Method:    cocoEvaluateGradient
+ * Signature: (J[D)[D
+ */
+JNIEXPORT jdoubleArray JNICALL Java_CocoJNI_cocoEvaluateGradient
+(JNIEnv *jenv, jclass interface_cls, jlong jproblem_pointer, jdoubleArray jx) {
+
+  coco_problem_t *problem = NULL;
+  double *gradient = NULL;
+  double *x = NULL;
+  int dimension;
+  jdoubleArray jgradient;
+
+  /* This test is both to prevent warning because interface_cls was not used and to check for exceptions */
+  if (interface_cls == NULL) {
+    jclass Exception = (*jenv)->FindClass(jenv, "java/lang/Exception");
+    (*jenv)->ThrowNew(jenv, Exception, "Exception in cocoEvaluateGradient\n");
+  }
+
+  problem = (coco_problem_t *) jproblem_pointer;
+  dimension = (int) coco_problem_get_dimension(problem);
+
+  /* Call coco_evaluate_gradient, writing the result directly to the returned array */
+  x = (*jenv)->GetDoubleArrayElements(jenv, jx, NULL);
+  jgradient = (*jenv)->NewDoubleArray(jenv, dimension);
+  gradient = (*jenv)->GetDoubleArrayElements(jenv, jgradient, NULL);
+  coco_evaluate_gradient(problem, x, gradient);
+
+  /* Release resources */
+  (*jenv)->ReleaseDoubleArrayElements(jenv, jgradient, gradient, 0);
+  (*jenv)->ReleaseDoubleArrayElements(jenv, jx, x, JNI_ABORT);
+  return jgradient;
+}
+
+/*
+ * Class:     CocoJNI
+ * Method:    cocoEvaluateFunctionAndGradient
+ * Signature: (J[D[D)[D
+ */
+JNIEXPORT jdoubleArray JNICALL Java_CocoJNI_cocoEvaluateFunctionAndGradient
+(JNIEnv *jenv, jclass interface_cls, jlong jproblem_pointer, jdoubleArray jx, jdoubleArray jgradient) {
+
+  coco_problem_t *problem = NULL;
+  double *y = NULL;
+  double *x = NULL;
+  double *gradient = NULL;
+  int number_of_objectives;
+  jdoubleArray jy;
+
+  /* This test is both to prevent warning because interface_cls was not used and to check for exceptions */
+  if (interface_cls == NULL) {
+    jclass Exception = (*jenv)->FindClass(jenv, "java/lang/Exception");
+    (*jenv)->ThrowNew(jenv, Exception, "Exception in cocoEvaluateFunctionAndGradient\n");
+  }
+
+  problem = (coco_problem_t *) jproblem_pointer;
+  number_of_objectives = (int) coco_problem_get_number_of_objectives(problem);
+
+  /* Call coco_evaluate_function_and_gradient, writing the function values directly to the returned array
+   * and the gradient to the given array */
+  x = (*jenv)->GetDoubleArrayElements(jenv, jx, NULL);
+  gradient = (*jenv)->GetDoubleArrayElements(jenv, jgradient, NULL);
+  jy = (*jenv)->NewDoubleArray(jenv, number_of_objectives);
+  y = (*jenv)->GetDoubleArrayElements(jenv, jy, NULL);
+  coco_evaluate_function_and_gradient(problem, x, y, gradient);
+
+  /* Release resources */
+  (*jenv)->ReleaseDoubleArrayElements(jenv, jy, y, 0);
+  (*jenv)->ReleaseDoubleArrayElements(jenv, jgradient, gradient, 0);
   (*jenv)->ReleaseDoubleArrayElements(jenv, jx, x, JNI_ABORT);
   return jy;
 }
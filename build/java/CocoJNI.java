@@ -30,7 +30,10 @@ public class CocoJNI {
 
 	// Functions
 	public static native double[] cocoEvaluateFunction(long problemPointer, double[] x);
+	public static native double[] cocoEvaluateFunctionBatch(long problemPointer, double[] x);
 	public static native double[] cocoEvaluateConstraint(long problemPointer, double[] x);
+	public static native double[] cocoEvaluateGradient(long problemPointer, double[] x);
+	public static native double[] cocoEvaluateFunctionAndGradient(long problemPointer, double[] x, double[] gradient);
 	public static native void cocoRecommendSolution(long problemPointer, double[] x);
 
 	// Getters
@@ -56,6 +56,16 @@ public class Problem {
 		return CocoJNI.cocoEvaluateFunction(this.pointer, x);
 	}
 
+	/**
+	 * Evaluates the function in the points stored one after another in x and returns the results stored
+	 * one after another as an array of doubles. 
+	 * @param x
+	 * @return the results of the function evaluations in the points in x
+	 */
+	public double[] evaluateFunctionBatch(double[] x) {
+		return CocoJNI.cocoEvaluateFunctionBatch(this.pointer, x);
+	}
+
 	/**
 	 * Evaluates the constraint in point x and returns the result as an array of doubles. 
 	 * @param x
@@ -65,6 +75,27 @@ public class Problem {
 		return CocoJNI.cocoEvaluateConstraint(this.pointer, x);
 	}
 
+	/**
+	 * Evaluates the gradient of the function in point x and returns it as an array of doubles (does not
+	 * count as an evaluation). 
+	 * @param x
+	 * @return the gradient of the function in point x
+	 */
+	public double[] evaluateGradient(double[] x) {
+		return CocoJNI.cocoEvaluateGradient(this.pointer, x);
+	}
+
+	/**
+	 * Evaluates the function and its gradient in point x (counts as one evaluation). The gradient is
+	 * written to the given array of dimension doubles.
+	 * @param x
+	 * @param gradient
+	 * @return the result of the function evaluation in point x
+	 */
+	public double[] evaluateFunctionAndGradient(double[] x, double[] gradient) {
+		return CocoJNI.cocoEvaluateFunctionAndGradient(this.pointer, x, gradient);
+	}
+
 	/**
 	 * Recommends solution x (the solution is logged, but its function values are not returned)
 	 * @param x
@@ -385,10 +385,9 @@ class Observer(_Observer):
         - ``f.free()`` in the above example must be called before to observe
           another problem with the "bbob" observer. Otherwise the Python
           interpreter will crash due to an error raised from the C code.
-    
-        - Due to technical sublties between Python/Cython/C, the pointer to the
-          underlying C observer is passed by global assignment with
-          `_update_current_observer_global()`
+          With the option ``thread_safe: 1``, the "bbob" observer can
+          observe several problems at the same time, also from different
+          threads.
 
     """
 
@@ -448,6 +447,32 @@ class Problem(_Problem):
         """
         return super().constraint(x)
 
+    def gradient(self, x):
+        """return the gradient of the objective function at `x`.
+
+        Computing the gradient does not count as an evaluation and is not
+        seen by the observer.
+        """
+        return super().gradient(x)
+
+    def value_and_gradient(self, x):
+        """return the objective function value and its gradient at `x`.
+
+        The value is the same as ``self(x)``: it counts as one evaluation
+        and is seen once by the observer. The gradient is the same as
+        ``self.gradient(x)``.
+        """
+        return super().value_and_gradient(x)
+
+    def evaluate_batch(self, X):
+        """return objective function values of the rows of the 2-D array `X`.
+
+        The result is the same as ``np.array([self(x) for x in X])``,
+        including the number of evaluations and the logged data, but the
+        points are passed to the C code in a single call.
+        """
+        return super().evaluate_batch(X)
+
     def logger_biobj_feed_solution(self, evaluation, y):
         """Feed the given solution to logger_biobj in order to reconstruct its
         output.
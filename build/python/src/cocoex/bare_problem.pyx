@@ -15,6 +15,7 @@ cdef extern from 'coco.h':
 
     char *coco_problem_get_id(coco_problem_t *p)
     void coco_evaluate_function(coco_problem_t *p, double *x, double *y)
+    void coco_evaluate_function_batch(coco_problem_t *p, double *x, double *y, size_t number_of_points)
     void coco_problem_free(coco_problem_t *p)
     void bbob_problem_best_parameter_print(coco_problem_t *p)
     
@@ -139,7 +140,7 @@ cdef class BareProblem:
     def __call__(self, x):
         cdef double[::1] xi
         cdef double[:, ::1] X
-        cdef Py_ssize_t N, D, i
+        cdef Py_ssize_t N, D
         cdef double[::1] y_view
         cdef double y
         if isinstance(x, list):
@@ -156,10 +157,8 @@ cdef class BareProblem:
             D = X.shape[1]
             Y = np.zeros(N, dtype=np.float64)
             y_view = Y
-            for i in range(N):
-                xi = X[i, :]
-                coco_evaluate_function(self._problem, &xi[0], &y)
-                y_view[i] = y
+            if N > 0:
+                coco_evaluate_function_batch(self._problem, &X[0, 0], &y_view[0], N)
             return Y
         else:
           return None
@@ -54,7 +54,12 @@ cdef extern from "coco.h":
 
     void coco_problem_get_initial_solution(coco_problem_t *problem, double *x)
     void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y)
+    void coco_evaluate_function_batch(coco_problem_t *problem, const double *x, double *y,
+                                      const size_t number_of_points)
     void coco_evaluate_constraint(coco_problem_t *problem, const double *x, double *y)
+    void coco_evaluate_gradient(coco_problem_t *problem, const double *x, double *y)
+    void coco_evaluate_function_and_gradient(coco_problem_t *problem, const double *x, double *y,
+                                             double *gradient)
     void coco_recommend_solution(coco_problem_t *problem, const double *x)
 
     int coco_logger_biobj_feed_solution(coco_problem_t *problem, const size_t evaluation, const double *y)
@@ -63,6 +68,10 @@ cdef extern from "coco.h":
 
     coco_problem_t* coco_suite_get_next_problem(coco_suite_t*, coco_observer_t*)
     coco_problem_t* coco_suite_get_problem(coco_suite_t *, const size_t)
+    size_t coco_suite_get_number_of_problems(const coco_suite_t *suite)
+    int coco_suite_get_problem_metadata(coco_suite_t *suite, const size_t problem_index, char **problem_id,
+                                        char **problem_name, size_t *dimension, size_t *number_of_objectives)
+    void coco_free_memory(void *data)
 
     size_t coco_problem_get_suite_dep_index(const coco_problem_t* problem)
     size_t coco_problem_get_dimension(const coco_problem_t *problem)
@@ -93,9 +102,6 @@ cdef bytes _bstring(s):
         raise TypeError("expect a string, got %s" % str(type(s)))
 
 
-cdef coco_observer_t* _current_observer
-
-
 cdef class Suite:
     """see __init__.py"""
     cdef coco_suite_t* suite  # AKA _self
@@ -132,12 +138,15 @@ cdef class Suite:
         assert self.initialized
 
     cdef _initialize(self):
-        """sweeps through `suite` to collect indices and id's to operate by
-        direct access in the remainder"""
-        cdef np.npy_intp shape[1]  # probably completely useless
+        """sweeps through the problem indices of `suite` to collect indices
+        and id's to operate by direct access in the remainder (without
+        constructing the problems)"""
         cdef coco_suite_t* suite
-        cdef coco_problem_t* p
-        cdef bytes _old_level
+        cdef char* problem_id
+        cdef char* problem_name
+        cdef size_t dimension
+        cdef size_t number_of_objectives
+        cdef size_t index
         coco_reset_seeds()
         if self.initialized:
             self.reset()
@@ -155,19 +164,18 @@ cdef class Suite:
         if suite == NULL:
             raise NoSuchSuiteException(self._name)
 
-        while True:
-            old_level = log_level('warning')
-            p = coco_suite_get_next_problem(suite, NULL)
-            log_level(old_level)
-            if not p:
-                break
-            self._indices.append(coco_problem_get_suite_dep_index(p))
-            self._ids.append(coco_problem_get_id(p))
-            self._names.append(coco_problem_get_name(p))
-            self._dimensions.append(coco_problem_get_dimension(p))
-            self._number_of_objectives.append(coco_problem_get_number_of_objectives(p))
-        coco_suite_free(suite)
-        self.suite = coco_suite(self._name, self._instance, self._options)
+        for index in range(coco_suite_get_number_of_problems(suite)):
+            if not coco_suite_get_problem_metadata(suite, index, &problem_id, &problem_name,
+                                                   &dimension, &number_of_objectives):
+                continue
+            self._indices.append(index)
+            self._ids.append(problem_id)
+            self._names.append(problem_name)
+            self._dimensions.append(dimension)
+            self._number_of_objectives.append(number_of_objectives)
+            coco_free_memory(problem_id)
+            coco_free_memory(problem_name)
+        self.suite = suite
         self.initialized = True
         return self
     def reset(self):
@@ -185,7 +193,6 @@ cdef class Suite:
         `next_problem` serves to sweep through the `Suite` smoothly.
         """
         cdef size_t index
-        global _current_observer
         if not self.initialized:
             raise ValueError("Suite has been finalized/free'ed")
         if self.current_problem_:
@@ -474,12 +481,6 @@ cdef class Observer:
         self._observer = coco_observer(self._name, self._options)
         self._state = 'initialized'
 
-    def _update_current_observer_global(self):
-        """assign the global _current_observer variable to self._observer,
-        for purely technical reasons"""
-        global _current_observer
-        _current_observer = self._observer
-
     def observe(self, problem):
         """`observe(problem)` let `self` observe the `problem: Problem` by
         calling `problem.observe_with(self)`.
@@ -606,6 +607,46 @@ cdef class Problem:
                                <double *>np.PyArray_DATA(_x),
                                <double *>np.PyArray_DATA(self.constraint_values))
         return np.array(self.constraint_values, copy=True)
+    def gradient(self, x):
+        """see __init__.py"""
+        cdef np.ndarray[double, ndim=1, mode="c"] _x
+        cdef np.ndarray[double, ndim=1, mode="c"] _gradient
+        x = np.asarray(x, dtype=np.double, order='C')
+        if np.size(x) != self.number_of_variables:
+            raise ValueError(
+                "Dimension, `np.size(x)==%d`, of input `x` does " % np.size(x) +
+                "not match the problem dimension `number_of_variables==%d`."
+                             % self.number_of_variables)
+        if self.problem is NULL:
+            raise InvalidProblemException()
+        _x = x  # this is the final type conversion
+        _gradient = np.zeros(self.number_of_variables, dtype=np.double)
+        coco_evaluate_gradient(self.problem,
+                               <double *>np.PyArray_DATA(_x),
+                               <double *>np.PyArray_DATA(_gradient))
+        return _gradient
+    def value_and_gradient(self, x):
+        """see __init__.py"""
+        cdef np.ndarray[double, ndim=1, mode="c"] _x
+        cdef np.ndarray[double, ndim=1, mode="c"] _gradient
+        assert self.initialized
+        x = np.asarray(x, dtype=np.double, order='C')
+        if np.size(x) != self.number_of_variables:
+            raise ValueError(
+                "Dimension, `np.size(x)==%d`, of input `x` does " % np.size(x) +
+                "not match the problem dimension `number_of_variables==%d`."
+                             % self.number_of_variables)
+        if self.problem is NULL:
+            raise InvalidProblemException()
+        _x = x  # this is the final type conversion
+        _gradient = np.zeros(self.number_of_variables, dtype=np.double)
+        coco_evaluate_function_and_gradient(self.problem,
+                                            <double *>np.PyArray_DATA(_x),
+                                            <double *>np.PyArray_DATA(self.y_values),
+                                            <double *>np.PyArray_DATA(_gradient))
+        if self._number_of_objectives == 1:
+            return self.y_values[0], _gradient
+        return np.array(self.y_values, copy=True), _gradient
     def recommend(self, arx):
         """Recommend a solution, return `None`.
 
@@ -664,10 +705,11 @@ cdef class Problem:
 
         See also: class `Observer`
         """
+        cdef Observer c_observer
         if observer:
             assert self.problem
-            observer._update_current_observer_global()
-            self.problem = coco_problem_add_observer(self.problem, _current_observer)
+            c_observer = observer
+            self.problem = coco_problem_add_observer(self.problem, c_observer._observer)
             self._list_of_observers.append(observer)
         return self
 
@@ -848,6 +890,30 @@ cdef class Problem:
             return self.y_values[0]
         return np.array(self.y_values, copy=True)
 
+    def evaluate_batch(self, X):
+        """return objective function values of the rows of the 2-D input `X`"""
+        cdef np.ndarray[double, ndim=2, mode="c"] _X
+        cdef np.ndarray[double, ndim=2, mode="c"] _Y
+        assert self.initialized
+        X = np.asarray(X, dtype=np.double, order='C')
+        if X.ndim != 2 or X.shape[1] != self.number_of_variables:
+            raise ValueError(
+                "Shape, `np.shape(X)==%s`, of input `X` does " % str(np.shape(X)) +
+                "not match `(number_of_points, number_of_variables==%d)`."
+                             % self.number_of_variables)
+        _X = X  # this is the final type conversion
+        if self.problem is NULL:
+            raise InvalidProblemException()
+        _Y = np.zeros((X.shape[0], self._number_of_objectives), dtype=np.double)
+        if X.shape[0] > 0:
+            coco_evaluate_function_batch(self.problem,
+                                         <double *>np.PyArray_DATA(_X),
+                                         <double *>np.PyArray_DATA(_Y),
+                                         X.shape[0])
+        if self._number_of_objectives == 1:
+            return _Y[:, 0]
+        return _Y
+
     @property
     def id(self):
         "id as string without spaces or weird characters"
@@ -41,3 +41,15 @@ def test_bbob2009():
             test_vector = test_vectors[int(test_vector_id)]
             y = problem(test_vector[:problem.number_of_variables])
             assert y == pytest.approx(float(expected_y))
+
+
+def test_value_and_gradient():
+    suite = Suite("bbob", "instances:1", "dimensions:2,5")
+    for problem in suite:
+        x = np.linspace(-1, 1, problem.dimension)
+        evaluations = problem.evaluations
+        y, gradient = problem.value_and_gradient(x)
+        assert problem.evaluations == evaluations + 1
+        assert y == problem(x)
+        assert np.all(gradient == problem.gradient(x))
+        assert problem.evaluations == evaluations + 2
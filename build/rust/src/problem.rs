@@ -98,6 +98,27 @@ impl Problem<'_> {
         }
     }
 
+    /// Evaluates the problem at all points stored one after another in `x`
+    /// and returns the results one after another in `y`.
+    ///
+    /// The length of `x` must be a multiple of [Problem::dimension] and the
+    /// length of `y` must match the number of points times
+    /// [Problem::number_of_objectives].
+    pub fn evaluate_function_batch(&mut self, x: &[f64], y: &mut [f64]) {
+        let number_of_points = x.len() / self.dimension();
+        assert_eq!(number_of_points * self.dimension(), x.len());
+        assert_eq!(number_of_points * self.number_of_objectives(), y.len());
+
+        unsafe {
+            coco_sys::coco_evaluate_function_batch(
+                self.inner,
+                x.as_ptr(),
+                y.as_mut_ptr(),
+                number_of_points as _,
+            );
+        }
+    }
+
     /// Evaluates the problem constraints in point x and save the result in y.
     ///
     /// The length of `x` must match [Problem::dimension] and the
@@ -111,6 +132,46 @@ impl Problem<'_> {
         }
     }
 
+    /// Evaluates the gradient of the problem function at `x` and returns it in `gradient`.
+    ///
+    /// This does not count as an evaluation and is not seen by the observer.
+    ///
+    /// The lengths of `x` and `gradient` must match [Problem::dimension].
+    pub fn evaluate_gradient(&mut self, x: &[f64], gradient: &mut [f64]) {
+        assert_eq!(self.dimension(), x.len());
+        assert_eq!(self.dimension(), gradient.len());
+
+        unsafe {
+            coco_sys::coco_evaluate_gradient(self.inner, x.as_ptr(), gradient.as_mut_ptr());
+        }
+    }
+
+    /// Evaluates the problem at `x` and returns the result in `y` and the gradient in `gradient`.
+    ///
+    /// This counts as one evaluation, like [Problem::evaluate_function].
+    ///
+    /// The lengths of `x` and `gradient` must match [Problem::dimension] and the
+    /// length of `y` must match [Problem::number_of_objectives].
+    pub fn evaluate_function_and_gradient(
+        &mut self,
+        x: &[f64],
+        y: &mut [f64],
+        gradient: &mut [f64],
+    ) {
+        assert_eq!(self.dimension(), x.len());
+        assert_eq!(self.number_of_objectives(), y.len());
+        assert_eq!(self.dimension(), gradient.len());
+
+        unsafe {
+            coco_sys::coco_evaluate_function_and_gradient(
+                self.inner,
+                x.as_ptr(),
+                y.as_mut_ptr(),
+                gradient.as_mut_ptr(),
+            );
+        }
+    }
+
     /// Returns true if a previous evaluation hit the target value.
     pub fn final_target_hit(&self) -> bool {
         unsafe { coco_sys::coco_problem_final_target_hit(self.inner) == 1 }
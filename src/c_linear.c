@@ -23,6 +23,17 @@ typedef struct {
   double gradient_norm;
 } linear_constraint_data_t;
 
+/**
+ * @brief Data type for a block of linear constraints.
+ *
+ * The gradients of all constraints are stored as the rows of one contiguous matrix, so that the constraints
+ * are evaluated in a single pass over the matrix instead of through one stacked problem per constraint.
+ */
+typedef struct {
+  double *gradients;     /**< @brief The gradients of the constraints (one row per constraint) */
+  double *shift_factors; /**< @brief The shift factors of the constraints divided by the gradient norms */
+} c_linear_block_data_t;
+
 static void c_sum_variables_evaluate(coco_problem_t *self, const double *x, double *y, int update_counter);
 
 static void c_linear_single_evaluate(coco_problem_t *self, const double *x, double *y, int update_counter);
@@ -43,6 +54,16 @@ static coco_problem_t *c_linear_single_cons_bbob_problem_allocate(const size_t f
                                                                   double x_shift_factor,
                                                                   const double *feasible_direction);
 
+static coco_problem_t *
+c_linear_cons_bbob_stacked_problem_allocate(const size_t function, const size_t dimension, const size_t instance,
+                                            const size_t number_of_active_constraints,
+                                            const char *problem_id_template, const char *problem_name_template,
+                                            const double *feasible_direction);
+
+static void c_linear_block_evaluate(coco_problem_t *self, const double *x, double *y, int update_counter);
+
+static coco_problem_t *c_linear_block_allocate(const coco_problem_t *stacked_problem);
+
 static coco_problem_t *
 c_linear_cons_bbob_problem_allocate(const size_t function, const size_t dimension, const size_t instance,
                                     const size_t number_of_active_constraints, const char *problem_id_template,
@@ -87,7 +108,7 @@ static void c_linear_single_evaluate(coco_problem_t *self, const double *x, doub
   for (i = 0, factor = data->x_shift_factor / data->gradient_norm; i < self->number_of_variables; ++i)
     data->x[i] = (data->gradient[i]) * (x[i] - factor * data->gradient[i]);
 
-  inner_problem->evaluate_constraint(inner_problem, data->x, y, update_counter);
+  coco_evaluate_constraint_memoized(inner_problem, data->x, y, update_counter);
 
   inner_problem = NULL;
   data = NULL;
@@ -292,7 +313,8 @@ static void con_update_linear_combination(double *linear_combination, const coco
 
 /**
  * @brief Builds a coco_problem_t containing all the linear constraints
- *        by stacking them all.
+ *        by stacking them all (see c_linear_cons_bbob_problem_allocate()
+ *        for the problem that is used in the suite).
  *
  * The constraints' gradients are randomly generated with distribution
  * 10**U[0,1] * N_i(0, I) * 10**U_i[0,2], where U[a, b] is uniform
@@ -307,9 +329,10 @@ static void con_update_linear_combination(double *linear_combination, const coco
  * coco_problem_t object that is returned by the function.
  */
 static coco_problem_t *
-c_linear_cons_bbob_problem_allocate(const size_t function, const size_t dimension, const size_t instance,
-                                    const size_t number_of_active_constraints, const char *problem_id_template,
-                                    const char *problem_name_template, const double *feasible_direction) {
+c_linear_cons_bbob_stacked_problem_allocate(const size_t function, const size_t dimension, const size_t instance,
+                                            const size_t number_of_active_constraints,
+                                            const char *problem_id_template, const char *problem_name_template,
+                                            const double *feasible_direction) {
 
   const double global_scaling_factor = 100.;
   size_t i, j;
@@ -445,3 +468,162 @@ c_linear_cons_bbob_problem_allocate(const size_t function, const size_t dimensio
 
   return problem_c;
 }
+
+/**
+ * @brief Evaluates the block of linear constraints at the point 'x'
+ *        and stores the results in 'y'.
+ *
+ * Each constraint value is computed exactly as by c_linear_single_evaluate()
+ * and c_sum_variables_evaluate(), with the same operations in the same
+ * order. Four constraints are evaluated in each pass over 'x'.
+ */
+static void c_linear_block_evaluate(coco_problem_t *self, const double *x, double *y, int update_counter) {
+
+  const size_t number_of_variables = self->number_of_variables;
+  const size_t number_of_constraints = self->number_of_constraints;
+  c_linear_block_data_t *data = (c_linear_block_data_t *)self->data;
+  const double *g0, *g1, *g2, *g3;
+  double f0, f1, f2, f3, t0, t1, t2, t3;
+  size_t i, k;
+
+  for (k = 0; k + 4 <= number_of_constraints; k += 4) {
+    g0 = data->gradients + k * number_of_variables;
+    g1 = g0 + number_of_variables;
+    g2 = g1 + number_of_variables;
+    g3 = g2 + number_of_variables;
+    f0 = data->shift_factors[k];
+    f1 = data->shift_factors[k + 1];
+    f2 = data->shift_factors[k + 2];
+    f3 = data->shift_factors[k + 3];
+    y[k] = y[k + 1] = y[k + 2] = y[k + 3] = 0.0;
+    for (i = 0; i < number_of_variables; ++i) {
+      t0 = g0[i] * (x[i] - f0 * g0[i]);
+      t1 = g1[i] * (x[i] - f1 * g1[i]);
+      t2 = g2[i] * (x[i] - f2 * g2[i]);
+      t3 = g3[i] * (x[i] - f3 * g3[i]);
+      /* prevent that the optimal solution is infeasible due to loss of precision when shifted */
+      if (t0 > 1e-11 || t0 < 0)
+        y[k] += t0;
+      if (t1 > 1e-11 || t1 < 0)
+        y[k + 1] += t1;
+      if (t2 > 1e-11 || t2 < 0)
+        y[k + 2] += t2;
+      if (t3 > 1e-11 || t3 < 0)
+        y[k + 3] += t3;
+    }
+  }
+  for (; k < number_of_constraints; ++k) {
+    g0 = data->gradients + k * number_of_variables;
+    f0 = data->shift_factors[k];
+    y[k] = 0.0;
+    for (i = 0; i < number_of_variables; ++i) {
+      t0 = g0[i] * (x[i] - f0 * g0[i]);
+      if (t0 > 1e-11 || t0 < 0)
+        y[k] += t0;
+    }
+  }
+
+  (void)update_counter; /* To silence the compiler */
+}
+
+/**
+ * @brief Frees the block of linear constraints.
+ */
+static void c_linear_block_free(coco_problem_t *problem) {
+
+  c_linear_block_data_t *data = (c_linear_block_data_t *)problem->data;
+  coco_free_memory(data->gradients);
+  coco_free_memory(data->shift_factors);
+  problem->problem_free_function = NULL;
+  coco_problem_free(problem);
+}
+
+/**
+ * @brief Copies the gradients and shift factors of the linear constraints
+ *        of the stacked problem into the rows of the block, in the order
+ *        of the constraint values of the stacked problem, and returns the
+ *        number of rows that were filled.
+ */
+static size_t c_linear_block_fill(c_linear_block_data_t *block_data, size_t row, const coco_problem_t *problem) {
+
+  const coco_problem_stacked_data_t *stacked_data;
+  const linear_constraint_data_t *data;
+  size_t i;
+
+  if (problem->evaluate_constraint == coco_problem_stacked_evaluate_constraint) {
+    stacked_data = (const coco_problem_stacked_data_t *)problem->data;
+    if (coco_problem_get_number_of_constraints(stacked_data->problem1) > 0)
+      row = c_linear_block_fill(block_data, row, stacked_data->problem1);
+    if (coco_problem_get_number_of_constraints(stacked_data->problem2) > 0)
+      row = c_linear_block_fill(block_data, row, stacked_data->problem2);
+    return row;
+  }
+
+  if (problem->evaluate_constraint != c_linear_single_evaluate)
+    coco_error("c_linear_block_fill(): problem %s is not a linear constraint", problem->problem_id);
+  data = (const linear_constraint_data_t *)coco_problem_transformed_get_data(problem);
+  for (i = 0; i < problem->number_of_variables; ++i)
+    block_data->gradients[row * problem->number_of_variables + i] = data->gradient[i];
+  block_data->shift_factors[row] = data->x_shift_factor / data->gradient_norm;
+  return row + 1;
+}
+
+/**
+ * @brief Allocates a problem that evaluates all the linear constraints of
+ *        the stacked problem as one block (see c_linear_block_evaluate()).
+ *
+ * The problem takes its id, name, type, region of interest and initial
+ * solution from the stacked problem, which is left intact.
+ */
+static coco_problem_t *c_linear_block_allocate(const coco_problem_t *stacked_problem) {
+
+  const size_t number_of_variables = stacked_problem->number_of_variables;
+  const size_t number_of_constraints = stacked_problem->number_of_constraints;
+  c_linear_block_data_t *data;
+  coco_problem_t *problem;
+  size_t i;
+
+  data = (c_linear_block_data_t *)coco_allocate_memory(sizeof(*data));
+  data->gradients = coco_allocate_vector(number_of_constraints * number_of_variables);
+  data->shift_factors = coco_allocate_vector(number_of_constraints);
+  if (c_linear_block_fill(data, 0, stacked_problem) != number_of_constraints)
+    coco_error("c_linear_block_allocate(): wrong number of linear constraints in problem %s",
+               stacked_problem->problem_id);
+
+  problem = coco_problem_allocate(number_of_variables, 0, number_of_constraints);
+  problem->evaluate_constraint = c_linear_block_evaluate;
+  problem->problem_free_function = c_linear_block_free;
+  problem->data = data;
+
+  coco_problem_set_id(problem, "%s", stacked_problem->problem_id);
+  coco_problem_set_name(problem, "%s", stacked_problem->problem_name);
+  coco_problem_set_type(problem, "%s", stacked_problem->problem_type);
+  for (i = 0; i < number_of_variables; ++i) {
+    problem->smallest_values_of_interest[i] = stacked_problem->smallest_values_of_interest[i];
+    problem->largest_values_of_interest[i] = stacked_problem->largest_values_of_interest[i];
+  }
+  problem->best_value[0] = stacked_problem->best_value[0];
+  if (stacked_problem->initial_solution != NULL)
+    problem->initial_solution = coco_duplicate_vector(stacked_problem->initial_solution, number_of_variables);
+  return problem;
+}
+
+/**
+ * @brief Builds a coco_problem_t containing all the linear constraints
+ *        (see c_linear_cons_bbob_stacked_problem_allocate()) as one block
+ *        of linear constraints.
+ */
+static coco_problem_t *
+c_linear_cons_bbob_problem_allocate(const size_t function, const size_t dimension, const size_t instance,
+                                    const size_t number_of_active_constraints, const char *problem_id_template,
+                                    const char *problem_name_template, const double *feasible_direction) {
+
+  coco_problem_t *stacked_problem, *problem;
+
+  stacked_problem =
+      c_linear_cons_bbob_stacked_problem_allocate(function, dimension, instance, number_of_active_constraints,
+                                                  problem_id_template, problem_name_template, feasible_direction);
+  problem = c_linear_block_allocate(stacked_problem);
+  coco_problem_free(stacked_problem);
+  return problem;
+}
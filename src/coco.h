@@ -255,6 +255,13 @@ coco_problem_t *coco_suite_get_problem(coco_suite_t *suite, const size_t problem
 coco_problem_t *coco_suite_get_problem_by_function_dimension_instance(coco_suite_t *suite, const size_t function,
                                                                       const size_t dimension, const size_t instance);
 
+/**
+ * @brief Returns the id, name, dimension and number of objectives of the problem of the suite defined by
+ * problem_index without constructing the problem.
+ */
+int coco_suite_get_problem_metadata(coco_suite_t *suite, const size_t problem_index, char **problem_id,
+                                    char **problem_name, size_t *dimension, size_t *number_of_objectives);
+
 /**
  * @brief Returns the number of problems in the given suite.
  */
@@ -274,6 +281,17 @@ size_t coco_suite_get_dimension_from_dimension_index(const coco_suite_t *suite,
  * @brief Returns the instance number in the suite in position instance_idx (counting from 0).
  */
 size_t coco_suite_get_instance_from_instance_index(const coco_suite_t *suite, const size_t instance_idx);
+
+/**
+ * @brief The type of the solver that coco_suite_run_experiment() calls on each problem.
+ */
+typedef void (*coco_solver_function_t)(coco_problem_t *problem, void *solver_data);
+
+/**
+ * @brief Solves all (observed) problems of the suite, using several threads.
+ */
+void coco_suite_run_experiment(coco_suite_t *suite, coco_observer_t *observer, coco_solver_function_t solver,
+                               void *solver_data, const size_t number_of_threads);
 /**@}*/
 
 /**
@@ -386,6 +404,12 @@ const char *coco_observer_get_result_folder(const coco_observer_t *observer);
  */
 void coco_observer_signal_restart(coco_observer_t *observer, coco_problem_t *problem);
 
+/**
+ * @brief Converts a data file written in the binary format (observer option "format: binary") to the
+ * text file it stands for.
+ */
+void coco_observer_convert_binary_file(const char *binary_file_name, const char *text_file_name);
+
 /**@}*/
 
 /***********************************************************************************************************/
@@ -399,11 +423,30 @@ void coco_observer_signal_restart(coco_observer_t *observer, coco_problem_t *pro
  */
 void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y);
 
+/**
+ * @brief Evaluates the problem function in number_of_points points stored consecutively in x and saves the
+ * results consecutively in y.
+ */
+void coco_evaluate_function_batch(coco_problem_t *problem, const double *x, double *y,
+                                  const size_t number_of_points);
+
 /**
  * @brief Evaluates the problem constraints in point x and save the result in y.
  */
 void coco_evaluate_constraint(coco_problem_t *problem, const double *x, double *y);
 
+/**
+ * @brief Evaluates the gradient of the problem function in point x and saves the result in y (does not
+ * count as an evaluation).
+ */
+void coco_evaluate_gradient(coco_problem_t *problem, const double *x, double *y);
+
+/**
+ * @brief Evaluates the problem function and its gradient in point x and saves the results in y and gradient
+ * (counts as one evaluation).
+ */
+void coco_evaluate_function_and_gradient(coco_problem_t *problem, const double *x, double *y, double *gradient);
+
 /**
  * @brief Recommends a solution as the current best guesses to the problem. Not implemented yet.
  */
@@ -556,7 +599,7 @@ double coco_random_normal(coco_random_state_t *state);
 /**@{*/
 
 /**
- * @brief Resets seeds
+ * @brief Resets the seeds of the legacy noise and restarts the noise streams of all noisy problems
  */
 void coco_reset_seeds(void);
 
@@ -645,6 +688,13 @@ coco_archive_t *coco_archive(const char *suite_name, const size_t function, cons
  */
 int coco_archive_add_solution(coco_archive_t *archive, const double y1, const double y2, const char *text);
 
+/**
+ * @brief Adds a batch of solutions with objectives (y1[i], y2[i]) and texts text[i] to the archive, which is
+ * faster than adding them one by one. Returns the number of solutions that were added to the archive.
+ */
+size_t coco_archive_add_solutions(coco_archive_t *archive, const size_t number_of_solutions, const double *y1,
+                                  const double *y2, const char **text);
+
 /**
  * @brief Returns the number of (non-dominated) solutions in the archive (computed first, if needed).
  */
@@ -6,10 +6,13 @@
  * wrapper written in Python, these functions are used to merge archives and compute their hypervolumes.
  */
 
+#include <float.h>
+#include <stdlib.h>
+
 #include "coco.h"
 #include "coco_utilities.c"
 #include "mo_utilities.c"
-#include "mo_avl_tree.c"
+#include "mo_front.c"
 
 /**
  * @brief The COCO archive structure.
@@ -18,46 +21,69 @@
  */
 struct coco_archive_s {
 
-  avl_tree_t *tree; /**< @brief The AVL tree with non-dominated solutions. */
-  double *ideal;    /**< @brief The ideal point. */
-  double *nadir;    /**< @brief The nadir point. */
+  mo_front_t *front; /**< @brief The front of non-dominated solutions. */
+  double *ideal;     /**< @brief The ideal point. */
+  double *nadir;     /**< @brief The nadir point. */
 
   size_t number_of_objectives; /**< @brief Number of objectives (clearly equal to 2). */
 
   int is_up_to_date;          /**< @brief Whether archive fields have been updated since last addition. */
   size_t number_of_solutions; /**< @brief Number of solutions in the archive. */
-  double hypervolume;         /**< @brief Hypervolume of the solutions in the archive. */
+  double hypervolume;         /**< @brief Hypervolume of the solutions in the archive (updated on addition). */
 
-  avl_node_t *current_solution;  /**< @brief Current solution (to return). */
-  avl_node_t *extreme1;          /**< @brief Pointer to the first extreme solution. */
-  avl_node_t *extreme2;          /**< @brief Pointer to the second extreme solution. */
-  int extremes_already_returned; /**< @brief Whether the extreme solutions have already been returned. */
+  void *current_solution;               /**< @brief Current solution (to return). */
+  mo_front_position_t current_position; /**< @brief Position of the current solution in the front. */
+  void *extreme1;                       /**< @brief Pointer to the first extreme solution. */
+  void *extreme2;                       /**< @brief Pointer to the second extreme solution. */
+  int extremes_already_returned;        /**< @brief Whether the extreme solutions have already been returned. */
 };
 
 /**
- * @brief The type for the node's item in the AVL tree used by the archive.
+ * @brief The type for the solutions in the front of the archive.
  *
  * Contains information on the rounded normalized objective values (normalized_y), which are used for
  * computing the indicators and the text, which is used for output.
+ *
+ * The hypervolume contribution of a solution is the area it adds to the hypervolume of the solutions before
+ * it in the front (the ones with smaller values of the second objective), so that the hypervolume of the
+ * archive is the sum of the contributions of its solutions.
  */
 typedef struct {
-  double *normalized_y; /**< @brief The values of normalized objectives of this solution. */
-  char *text;           /**< @brief The text describing the solution (the whole line of the archive). */
+  double *normalized_y;            /**< @brief The values of normalized objectives of this solution. */
+  char *text;                      /**< @brief The text describing the solution (the whole line of the archive). */
+  double hypervolume_contribution; /**< @brief The hypervolume contribution of this solution. */
 } coco_archive_avl_item_t;
 
 /**
- * @brief Creates and returns the information on the solution in the form of a node's item in the AVL tree.
+ * @brief A solution of a batch added with coco_archive_add_solutions().
+ */
+typedef struct {
+  double normalized_y[2]; /**< @brief The values of normalized objectives of this solution. */
+  size_t index;           /**< @brief The index of this solution in the batch. */
+} coco_archive_batch_solution_t;
+
+/**
+ * @brief Creates and returns the information on the solution in the form of an item of the front.
+ *
+ * The item, its normalized_y and its text are stored in a single block of memory.
  */
 static coco_archive_avl_item_t *coco_archive_node_item_create(const double *y, const double *ideal, const double *nadir,
                                                               const size_t num_obj, const char *text) {
 
-  /* Allocate memory to hold the data structure coco_archive_avl_item_t */
-  coco_archive_avl_item_t *item = (coco_archive_avl_item_t *)coco_allocate_memory(sizeof(*item));
+  /* Allocate memory to hold the data structure coco_archive_avl_item_t followed by normalized_y (at an offset
+   * that is a multiple of the size of double) and the text */
+  const size_t offset = ((sizeof(coco_archive_avl_item_t) + sizeof(double) - 1) / sizeof(double)) * sizeof(double);
+  const size_t text_length = strlen(text);
+  coco_archive_avl_item_t *item = (coco_archive_avl_item_t *)coco_allocate_memory(
+      offset + num_obj * sizeof(double) + text_length + 1);
+  item->normalized_y = (double *)((char *)item + offset);
+  item->text = (char *)(item->normalized_y + num_obj);
 
   /* Compute the normalized y */
-  item->normalized_y = mo_normalize(y, ideal, nadir, num_obj);
+  mo_normalize_to(y, ideal, nadir, num_obj, item->normalized_y);
 
-  item->text = coco_strdup(text);
+  memcpy(item->text, text, text_length + 1);
+  item->hypervolume_contribution = 0;
   return item;
 }
 
@@ -65,24 +91,36 @@ static coco_archive_avl_item_t *coco_archive_node_item_create(const double *y, c
  * @brief Frees the data of the given coco_archive_avl_item_t.
  */
 static void coco_archive_node_item_free(coco_archive_avl_item_t *item, void *userdata) {
-  coco_free_memory(item->normalized_y);
-  coco_free_memory(item->text);
   coco_free_memory(item);
   (void)userdata; /* To silence the compiler */
 }
 
 /**
- * @brief Defines the ordering of AVL tree nodes based on the value of the last objective.
+ * @brief Returns the hypervolume contribution of the solution item, which follows the solution
+ * previous_item in the front (previous_item is NULL if item is the first solution).
  */
-static int coco_archive_compare_by_last_objective(const coco_archive_avl_item_t *item1,
-                                                  const coco_archive_avl_item_t *item2, void *userdata) {
-  (void)userdata; /* To silence the compiler */
-  if (coco_double_almost_equal(item1->normalized_y[1], item2->normalized_y[1], mo_precision))
-    return 0;
-  else if (item1->normalized_y[1] < item2->normalized_y[1])
-    return -1;
+static double coco_archive_get_contribution(const coco_archive_avl_item_t *previous_item,
+                                            const coco_archive_avl_item_t *item) {
+  double hyp;
+
+  if ((previous_item == NULL) || !mo_is_within_ROI(item->normalized_y, 2))
+    return 0; /* Hypervolume of the extreme point equals 0 */
+  if (mo_is_within_ROI(previous_item->normalized_y, 2))
+    hyp = (previous_item->normalized_y[0] - item->normalized_y[0]) * (1 - item->normalized_y[1]);
   else
-    return 1;
+    hyp = (1 - item->normalized_y[0]) * (1 - item->normalized_y[1]);
+  assert(hyp >= 0);
+  return hyp;
+}
+
+/**
+ * @brief Frees the given solution, which is dominated by a new solution (called by mo_front_update()), and
+ * subtracts its hypervolume contribution.
+ */
+static void coco_archive_remove_dominated(coco_archive_avl_item_t *item, coco_archive_t *archive) {
+  assert((item != archive->extreme1) && (item != archive->extreme2));
+  archive->hypervolume -= item->hypervolume_contribution;
+  coco_archive_node_item_free(item, NULL);
 }
 
 /**
@@ -93,9 +131,8 @@ static coco_archive_t *coco_archive_allocate(void) {
   /* Allocate memory to hold the data structure coco_archive_t */
   coco_archive_t *archive = (coco_archive_t *)coco_allocate_memory(sizeof(*archive));
 
-  /* Initialize the AVL tree */
-  archive->tree = avl_tree_construct((avl_compare_t)coco_archive_compare_by_last_objective,
-                                     (avl_free_t)coco_archive_node_item_free);
+  /* Initialize the front */
+  archive->front = mo_front_allocate();
 
   archive->ideal = NULL; /* To be allocated in coco_archive() */
   archive->nadir = NULL; /* To be allocated in coco_archive() */
@@ -155,8 +192,8 @@ coco_archive_t *coco_archive(const char *suite_name, const size_t function, cons
   coco_free_memory(text);
   assert(update == 1);
 
-  archive->extreme1 = archive->tree->head;
-  archive->extreme2 = archive->tree->tail;
+  archive->extreme1 = mo_front_get_first(archive->front, &archive->current_position);
+  archive->extreme2 = mo_front_get_last(archive->front);
   assert(archive->extreme1 != archive->extreme2);
 
   coco_free_memory(suite_instance);
@@ -168,12 +205,41 @@ coco_archive_t *coco_archive(const char *suite_name, const size_t function, cons
   return archive;
 }
 
+/**
+ * @brief Adds the given item to the front of the archive (unless it is weakly dominated, in which case it is
+ * freed) and updates the hypervolume of the archive.
+ *
+ * Only the contributions of the new solution and of the solution that follows it change, besides the ones
+ * of the removed solutions.
+ */
+static int coco_archive_add_item(coco_archive_t *archive, coco_archive_avl_item_t *insert_item) {
+
+  coco_archive_avl_item_t *previous, *next;
+  int update;
+
+  /* Remove the solutions dominated by the new one and insert it (unless it is weakly dominated) */
+  update = mo_front_update(archive->front, insert_item->normalized_y, insert_item,
+                           (mo_front_remove_t)coco_archive_remove_dominated, archive, (void **)&previous,
+                           (void **)&next);
+  if (!update) {
+    coco_archive_node_item_free(insert_item, NULL);
+    return 0;
+  }
+
+  insert_item->hypervolume_contribution = coco_archive_get_contribution(previous, insert_item);
+  archive->hypervolume += insert_item->hypervolume_contribution;
+  if (next != NULL) {
+    archive->hypervolume -= next->hypervolume_contribution;
+    next->hypervolume_contribution = coco_archive_get_contribution(insert_item, next);
+    archive->hypervolume += next->hypervolume_contribution;
+  }
+  archive->is_up_to_date = 0;
+  return 1;
+}
+
 int coco_archive_add_solution(coco_archive_t *archive, const double y1, const double y2, const char *text) {
 
   coco_archive_avl_item_t *insert_item;
-  avl_node_t *node, *next_node;
-  int update = 0;
-  int dominance;
 
   double *y = coco_allocate_vector(2);
   y[0] = y1;
@@ -181,61 +247,140 @@ int coco_archive_add_solution(coco_archive_t *archive, const double y1, const do
   insert_item = coco_archive_node_item_create(y, archive->ideal, archive->nadir, archive->number_of_objectives, text);
   coco_free_memory(y);
 
-  /* Find the first point that is not worse than the new point (NULL if such point does not exist) */
-  node = avl_item_search_right(archive->tree, insert_item, NULL);
+  return coco_archive_add_item(archive, insert_item);
+}
 
-  if (node == NULL) {
-    /* The new point is an extreme point */
-    update = 1;
-    next_node = archive->tree->head;
-  } else {
-    dominance = mo_get_dominance(insert_item->normalized_y, ((coco_archive_avl_item_t *)node->item)->normalized_y,
-                                 archive->number_of_objectives);
-    if (dominance > -1) {
-      update = 1;
-      next_node = node->next;
-      if (dominance == 1) {
-        /* The new point dominates the next point, remove the next point */
-        assert((node != archive->extreme1) && (node != archive->extreme2));
-        avl_node_delete(archive->tree, node);
-      }
-    } else {
-      /* The new point is dominated or equal to an existing one, ignore */
-      update = 0;
-    }
+/**
+ * @brief Orders the solutions of a batch by their normalized values of the second objective, then of the
+ * first objective and then by their indices (used by qsort()).
+ */
+static int coco_archive_compare_batch_solutions(const void *a, const void *b) {
+  const coco_archive_batch_solution_t *solution1 = (const coco_archive_batch_solution_t *)a;
+  const coco_archive_batch_solution_t *solution2 = (const coco_archive_batch_solution_t *)b;
+
+  if (solution1->normalized_y[1] != solution2->normalized_y[1])
+    return (solution1->normalized_y[1] < solution2->normalized_y[1]) ? -1 : 1;
+  if (solution1->normalized_y[0] != solution2->normalized_y[0])
+    return (solution1->normalized_y[0] < solution2->normalized_y[0]) ? -1 : 1;
+  if (solution1->index != solution2->index)
+    return (solution1->index < solution2->index) ? -1 : 1;
+  return 0;
+}
+
+/**
+ * @brief Removes the solutions of the batch that are clearly dominated by other solutions of the batch and
+ * returns the number of remaining solutions (which are moved to the beginning of the array).
+ *
+ * The range of the second objective is split into as many buckets as there are solutions. A solution is
+ * removed if a solution in a lower bucket is better in the first objective by at least mo_precision. This
+ * takes linear time and leaves only a few solutions to be sorted when most of them are dominated.
+ */
+static size_t coco_archive_filter_batch(coco_archive_batch_solution_t *solutions,
+                                        const size_t number_of_solutions) {
+
+  const size_t number_of_buckets = number_of_solutions;
+  double *min_y1 = coco_allocate_vector(number_of_buckets);
+  size_t *bucket = coco_allocate_vector_size_t(number_of_solutions);
+  double min_y2 = solutions[0].normalized_y[1], max_y2 = solutions[0].normalized_y[1], scale;
+  size_t i, number_kept = 0;
+
+  for (i = 1; i < number_of_solutions; i++) {
+    if (solutions[i].normalized_y[1] < min_y2)
+      min_y2 = solutions[i].normalized_y[1];
+    if (solutions[i].normalized_y[1] > max_y2)
+      max_y2 = solutions[i].normalized_y[1];
+  }
+  if (!(max_y2 > min_y2)) {
+    coco_free_memory(min_y1);
+    coco_free_memory(bucket);
+    return number_of_solutions;
+  }
+  scale = (double)(number_of_buckets - 1) / (max_y2 - min_y2);
+
+  /* Find the smallest value of the first objective in each bucket */
+  for (i = 0; i < number_of_buckets; i++)
+    min_y1[i] = DBL_MAX;
+  for (i = 0; i < number_of_solutions; i++) {
+    bucket[i] = (size_t)((solutions[i].normalized_y[1] - min_y2) * scale);
+    if (bucket[i] >= number_of_buckets)
+      bucket[i] = number_of_buckets - 1;
+    if (solutions[i].normalized_y[0] < min_y1[bucket[i]])
+      min_y1[bucket[i]] = solutions[i].normalized_y[0];
   }
 
-  if (!update) {
-    coco_archive_node_item_free(insert_item, NULL);
-  } else {
-    /* Perform tree update */
-    while (next_node != NULL) {
-      /* Check the dominance relation between the new node and the next node. There are only two possibilities:
-       * dominance = 0: the new node and the next node are nondominated
-       * dominance = 1: the new node dominates the next node */
-      node = next_node;
-      dominance = mo_get_dominance(insert_item->normalized_y, ((coco_archive_avl_item_t *)node->item)->normalized_y,
-                                   archive->number_of_objectives);
-      if (dominance == 1) {
-        next_node = node->next;
-        /* The new point dominates the next point, remove the next point */
-        assert((node != archive->extreme1) && (node != archive->extreme2));
-        avl_node_delete(archive->tree, node);
-      } else {
-        break;
-      }
-    }
+  /* Turn min_y1[i] into the smallest value of the first objective in the buckets before bucket i */
+  for (i = number_of_buckets - 1; i > 0; i--)
+    min_y1[i] = min_y1[i - 1];
+  min_y1[0] = DBL_MAX;
+  for (i = 1; i < number_of_buckets; i++) {
+    if (min_y1[i - 1] < min_y1[i])
+      min_y1[i] = min_y1[i - 1];
+  }
+
+  for (i = 0; i < number_of_solutions; i++) {
+    if (solutions[i].normalized_y[0] - min_y1[bucket[i]] < mo_precision)
+      solutions[number_kept++] = solutions[i];
+  }
+
+  coco_free_memory(min_y1);
+  coco_free_memory(bucket);
+  return number_kept;
+}
+
+/**
+ * The solutions dominated by other solutions of the batch are filtered out, so that only the nondominated
+ * solutions of the batch are added to the front: most of the dominated solutions are removed in linear time
+ * (see coco_archive_filter_batch()), the rest are sorted by their normalized objective values and the
+ * dominated ones are removed in a single sweep. Of solutions with equal objective values, the one that comes
+ * first in the batch is kept, as when the solutions are added one by one with coco_archive_add_solution().
+ */
+size_t coco_archive_add_solutions(coco_archive_t *archive, const size_t number_of_solutions, const double *y1,
+                                  const double *y2, const char **text) {
+
+  coco_archive_batch_solution_t *solutions;
+  coco_archive_avl_item_t *insert_item;
+  double y[2];
+  size_t i, number_filtered, number_kept = 0, number_added = 0;
+  int dominance = 0;
 
-    if (avl_item_insert(archive->tree, insert_item) == NULL) {
-      coco_archive_node_item_free(insert_item, NULL);
-      coco_warning("Solution %s did not update the archive", text);
-      update = 0;
+  if (number_of_solutions == 0)
+    return 0;
+
+  solutions = (coco_archive_batch_solution_t *)coco_allocate_memory(number_of_solutions * sizeof(*solutions));
+  for (i = 0; i < number_of_solutions; i++) {
+    y[0] = y1[i];
+    y[1] = y2[i];
+    mo_normalize_to(y, archive->ideal, archive->nadir, archive->number_of_objectives, solutions[i].normalized_y);
+    solutions[i].index = i;
+  }
+  number_filtered = coco_archive_filter_batch(solutions, number_of_solutions);
+  qsort(solutions, number_filtered, sizeof(*solutions), coco_archive_compare_batch_solutions);
+
+  /* Keep the nondominated solutions at the beginning of the array. Each solution is compared to the last kept
+   * one, which has the smallest value of the first objective among the kept solutions. */
+  for (i = 0; i < number_filtered; i++) {
+    while (number_kept > 0) {
+      dominance = mo_front_get_dominance(solutions[i].normalized_y, solutions[number_kept - 1].normalized_y);
+      if ((dominance == 1) || ((dominance == -2) && (solutions[i].index < solutions[number_kept - 1].index)))
+        number_kept--;
+      else
+        break;
     }
+    if ((number_kept == 0) || (dominance == 0))
+      solutions[number_kept++] = solutions[i];
+  }
 
-    archive->is_up_to_date = 0;
+  /* Add the nondominated solutions in the order of the front */
+  for (i = 0; i < number_kept; i++) {
+    y[0] = y1[solutions[i].index];
+    y[1] = y2[solutions[i].index];
+    insert_item = coco_archive_node_item_create(y, archive->ideal, archive->nadir, archive->number_of_objectives,
+                                                text[solutions[i].index]);
+    number_added += (size_t)coco_archive_add_item(archive, insert_item);
   }
 
-  return update;
+  coco_free_memory(solutions);
+  return number_added;
 }
 
 /**
@@ -243,36 +388,10 @@ int coco_archive_add_solution(coco_archive_t *archive, const double y1, const do
  */
 static void coco_archive_update(coco_archive_t *archive) {
 
-  double hyp;
-
   if (!archive->is_up_to_date) {
 
-    avl_node_t *node, *left_node;
-    coco_archive_avl_item_t *node_item, *left_node_item;
-
-    /* Updates number_of_solutions */
-
-    archive->number_of_solutions = avl_count(archive->tree);
-
-    /* Updates hypervolume */
-
-    node = archive->tree->head;
-    archive->hypervolume = 0; /* Hypervolume of the extreme point equals 0 */
-    while (node->next) {
-      /* Add hypervolume contributions of the other points that are within ROI */
-      left_node = node->next;
-      node_item = (coco_archive_avl_item_t *)node->item;
-      left_node_item = (coco_archive_avl_item_t *)left_node->item;
-      if (mo_is_within_ROI(left_node_item->normalized_y, archive->number_of_objectives)) {
-        if (mo_is_within_ROI(node_item->normalized_y, archive->number_of_objectives))
-          hyp = (node_item->normalized_y[0] - left_node_item->normalized_y[0]) * (1 - left_node_item->normalized_y[1]);
-        else
-          hyp = (1 - left_node_item->normalized_y[0]) * (1 - left_node_item->normalized_y[1]);
-        assert(hyp >= 0);
-        archive->hypervolume += hyp;
-      }
-      node = left_node;
-    }
+    /* Updates number_of_solutions (the hypervolume is updated when solutions are added) */
+    archive->number_of_solutions = mo_front_get_number_of_points(archive->front);
 
     archive->is_up_to_date = 1;
     archive->current_solution = NULL;
@@ -290,16 +409,16 @@ const char *coco_archive_get_next_solution_text(coco_archive_t *archive) {
 
     if (archive->current_solution == NULL) {
       /* Return the first extreme */
-      text = ((coco_archive_avl_item_t *)archive->extreme1->item)->text;
+      text = ((coco_archive_avl_item_t *)archive->extreme1)->text;
       archive->current_solution = archive->extreme2;
       return text;
     }
 
     if (archive->current_solution == archive->extreme2) {
       /* Return the second extreme */
-      text = ((coco_archive_avl_item_t *)archive->extreme2->item)->text;
+      text = ((coco_archive_avl_item_t *)archive->extreme2)->text;
       archive->extremes_already_returned = 1;
-      archive->current_solution = archive->tree->head;
+      archive->current_solution = mo_front_get_first(archive->front, &archive->current_position);
       return text;
     }
 
@@ -310,13 +429,13 @@ const char *coco_archive_get_next_solution_text(coco_archive_t *archive) {
 
     if ((archive->current_solution == archive->extreme1) || (archive->current_solution == archive->extreme2)) {
       /* Skip this one */
-      archive->current_solution = archive->current_solution->next;
+      archive->current_solution = mo_front_get_next(archive->front, &archive->current_position);
       return coco_archive_get_next_solution_text(archive);
     }
 
     /* Return the current solution and move to the next */
-    text = ((coco_archive_avl_item_t *)archive->current_solution->item)->text;
-    archive->current_solution = archive->current_solution->next;
+    text = ((coco_archive_avl_item_t *)archive->current_solution)->text;
+    archive->current_solution = mo_front_get_next(archive->front, &archive->current_position);
     return text;
   }
 
@@ -337,7 +456,7 @@ void coco_archive_free(coco_archive_t *archive) {
 
   assert(archive != NULL);
 
-  avl_tree_destruct(archive->tree);
+  mo_front_free(archive->front, (mo_front_remove_t)coco_archive_node_item_free, NULL);
   coco_free_memory(archive->ideal);
   coco_free_memory(archive->nadir);
   coco_free_memory(archive);
@@ -0,0 +1,284 @@
+/**
+ * @file coco_cache.c
+ * @brief Implementation of the process-wide cache of instance data shared between problems.
+ *
+ * Rotation matrices, block rotations and permutations of the bbob-based problems depend only on a seed, the
+ * dimension and (for block rotations and permutations) a few layout parameters. Problems that are alive at
+ * the same time and use the same data, or a single problem that uses the same data in several
+ * transformations, share one immutable copy of it instead of computing and storing it again.
+ *
+ * The entries are reference counted. A coco_cache_get_...() function returns a new reference, which needs to
+ * be given back with coco_cache_release(). Transformations that are given cached data keep their own
+ * reference with coco_cache_retain() (and copy the data otherwise), so that an entry is freed as soon as the
+ * last problem that uses it has been freed. All functions are thread-safe.
+ */
+
+#include <assert.h>
+
+#include "coco.h"
+#include "coco_platform.h"
+#include "coco_utilities.c"
+#include "suite_bbob_legacy_code.c"
+#include "transform_vars_blockrotation_helpers.c"
+#include "transform_vars_permutation_helpers.c"
+
+/**
+ * @brief The types of the cached data.
+ */
+typedef enum { COCO_CACHE_ROTATION, COCO_CACHE_BLOCKROTATION, COCO_CACHE_PERMUTATION } coco_cache_data_type_t;
+
+/**
+ * @brief An entry of the cache.
+ *
+ * The key of an entry consists of its type, seed, dimension and parameters (the block sizes of a block
+ * rotation or the number of swaps and the swap range of a permutation).
+ */
+typedef struct coco_cache_entry_s {
+  coco_cache_data_type_t type;
+  long seed;
+  size_t dimension;
+  size_t *parameters;
+  size_t number_of_parameters;
+
+  const void *data;  /**< @brief The cached data as returned to the users */
+  void *memory;      /**< @brief The allocated memory that contains the data */
+  size_t references; /**< @brief The number of references to the data */
+
+  struct coco_cache_entry_s *next;
+} coco_cache_entry_t;
+
+static coco_cache_entry_t *coco_cache_entries = NULL;          /**< @brief The list of cached entries */
+static coco_mutex_t coco_cache_mutex = COCO_MUTEX_INITIALIZER; /**< @brief Guards coco_cache_entries */
+
+/**
+ * @brief Returns the entry with the given key or NULL if there is none (the mutex needs to be locked).
+ */
+static coco_cache_entry_t *coco_cache_find_key(const coco_cache_data_type_t type, const long seed,
+                                               const size_t dimension, const size_t *parameters,
+                                               const size_t number_of_parameters) {
+  coco_cache_entry_t *entry;
+  size_t i;
+
+  for (entry = coco_cache_entries; entry != NULL; entry = entry->next) {
+    if ((entry->type != type) || (entry->seed != seed) || (entry->dimension != dimension) ||
+        (entry->number_of_parameters != number_of_parameters))
+      continue;
+    for (i = 0; i < number_of_parameters; i++) {
+      if (entry->parameters[i] != parameters[i])
+        break;
+    }
+    if (i == number_of_parameters)
+      return entry;
+  }
+  return NULL;
+}
+
+/**
+ * @brief Returns the entry with the given data or NULL if the data is not cached (the mutex needs to be
+ * locked).
+ */
+static coco_cache_entry_t *coco_cache_find_data(const void *data) {
+  coco_cache_entry_t *entry;
+
+  for (entry = coco_cache_entries; entry != NULL; entry = entry->next) {
+    if (entry->data == data)
+      return entry;
+  }
+  return NULL;
+}
+
+/**
+ * @brief Returns a new reference to the cached data with the given key.
+ *
+ * If the data is not cached yet, it is computed into the given (newly allocated) memory and added to the
+ * cache, otherwise the memory is freed. The data is computed outside of the critical section, so that
+ * threads constructing different problems do not wait for each other.
+ */
+static const void *coco_cache_acquire(const coco_cache_data_type_t type, const long seed, const size_t dimension,
+                                      const size_t *parameters, const size_t number_of_parameters,
+                                      void (*compute)(void *memory, void *data, const long seed,
+                                                      const size_t dimension, const size_t *parameters,
+                                                      const size_t number_of_parameters),
+                                      void *memory, void *data) {
+  coco_cache_entry_t *entry;
+  const void *result;
+
+  coco_mutex_lock(&coco_cache_mutex);
+  entry = coco_cache_find_key(type, seed, dimension, parameters, number_of_parameters);
+  if (entry != NULL)
+    entry->references++;
+  coco_mutex_unlock(&coco_cache_mutex);
+
+  if (entry != NULL) {
+    coco_free_memory(memory);
+    return entry->data;
+  }
+
+  compute(memory, data, seed, dimension, parameters, number_of_parameters);
+
+  coco_mutex_lock(&coco_cache_mutex);
+  /* Another thread might have added the same data in the meantime */
+  entry = coco_cache_find_key(type, seed, dimension, parameters, number_of_parameters);
+  if (entry == NULL) {
+    entry = (coco_cache_entry_t *)coco_allocate_memory(sizeof(*entry));
+    entry->type = type;
+    entry->seed = seed;
+    entry->dimension = dimension;
+    entry->parameters = (number_of_parameters > 0) ? coco_duplicate_size_t_vector(parameters, number_of_parameters)
+                                                   : NULL;
+    entry->number_of_parameters = number_of_parameters;
+    entry->data = data;
+    entry->memory = memory;
+    entry->references = 0;
+    entry->next = coco_cache_entries;
+    coco_cache_entries = entry;
+    memory = NULL;
+  }
+  entry->references++;
+  result = entry->data;
+  coco_mutex_unlock(&coco_cache_mutex);
+
+  if (memory != NULL)
+    coco_free_memory(memory);
+  return result;
+}
+
+/**
+ * @brief Computes a rotation matrix (stored in row-major order) for coco_cache_get_rotation().
+ */
+static void coco_cache_compute_rotation(void *memory, COCO_UNUSED void *data, const long seed,
+                                        const size_t dimension, COCO_UNUSED const size_t *parameters,
+                                        COCO_UNUSED const size_t number_of_parameters) {
+  double *M = (double *)memory;
+  double **rows = (double **)coco_allocate_memory(dimension * sizeof(double *));
+  size_t i;
+
+  for (i = 0; i < dimension; i++)
+    rows[i] = M + i * dimension;
+  bbob2009_compute_rotation(rows, seed, dimension);
+  coco_free_memory(rows);
+}
+
+/**
+ * @brief Returns a new reference to the dimension x dimension rotation matrix computed by
+ * bbob2009_compute_rotation() for the given seed, stored in row-major order.
+ */
+static const double *coco_cache_get_rotation(const long seed, const size_t dimension) {
+  double *memory = coco_allocate_vector(dimension * dimension);
+  return (const double *)coco_cache_acquire(COCO_CACHE_ROTATION, seed, dimension, NULL, 0,
+                                            coco_cache_compute_rotation, memory, memory);
+}
+
+/**
+ * @brief Computes a block rotation for coco_cache_get_blockrotation().
+ *
+ * The row pointers (data) are stored after the entries of the blocks (memory) they point to.
+ */
+static void coco_cache_compute_blockrotation(void *memory, void *data, const long seed, const size_t dimension,
+                                             const size_t *block_sizes, const size_t nb_blocks) {
+  double **B = (double **)data;
+  double *row = (double *)memory;
+  size_t i, idx_block, first_row = 0;
+
+  for (idx_block = 0; idx_block < nb_blocks; idx_block++) {
+    for (i = first_row; i < first_row + block_sizes[idx_block]; i++) {
+      B[i] = row;
+      row += block_sizes[idx_block];
+    }
+    first_row += block_sizes[idx_block];
+  }
+  coco_compute_blockrotation(B, seed, dimension, (size_t *)block_sizes, nb_blocks);
+}
+
+/**
+ * @brief Returns a new reference to the block-diagonal rotation computed by coco_compute_blockrotation() for
+ * the given seed and block sizes (in the format of coco_allocate_blockmatrix()).
+ */
+static const double *const *coco_cache_get_blockrotation(const long seed, const size_t dimension,
+                                                         const size_t *block_sizes, const size_t nb_blocks) {
+  size_t i, number_of_entries = 0;
+  void *memory;
+
+  for (i = 0; i < nb_blocks; i++)
+    number_of_entries += block_sizes[i] * block_sizes[i];
+  assert(number_of_entries > 0);
+
+  /* The entries are stored first, so that they are aligned, followed by the row pointers */
+  memory = coco_allocate_memory(number_of_entries * sizeof(double) + dimension * sizeof(double *));
+  return (const double *const *)coco_cache_acquire(COCO_CACHE_BLOCKROTATION, seed, dimension, block_sizes,
+                                                   nb_blocks, coco_cache_compute_blockrotation, memory,
+                                                   (double *)memory + number_of_entries);
+}
+
+/**
+ * @brief Computes a permutation for coco_cache_get_permutation().
+ */
+static void coco_cache_compute_permutation(void *memory, COCO_UNUSED void *data, const long seed,
+                                           const size_t dimension, const size_t *parameters,
+                                           COCO_UNUSED const size_t number_of_parameters) {
+  coco_compute_truncated_uniform_swap_permutation((size_t *)memory, seed, dimension, parameters[0], parameters[1]);
+}
+
+/**
+ * @brief Returns a new reference to the permutation computed by
+ * coco_compute_truncated_uniform_swap_permutation() for the given parameters.
+ */
+static const size_t *coco_cache_get_permutation(const long seed, const size_t dimension, const size_t nb_swaps,
+                                                const size_t swap_range) {
+  size_t parameters[2];
+  size_t *memory = coco_allocate_vector_size_t(dimension);
+
+  parameters[0] = nb_swaps;
+  parameters[1] = swap_range;
+  return (const size_t *)coco_cache_acquire(COCO_CACHE_PERMUTATION, seed, dimension, parameters, 2,
+                                            coco_cache_compute_permutation, memory, memory);
+}
+
+/**
+ * @brief Adds a reference to the given data if it is cached.
+ *
+ * @return 1 if the data is cached and 0 otherwise (in which case the caller needs to copy it).
+ */
+static int coco_cache_retain(const void *data) {
+  coco_cache_entry_t *entry;
+
+  coco_mutex_lock(&coco_cache_mutex);
+  entry = coco_cache_find_data(data);
+  if (entry != NULL)
+    entry->references++;
+  coco_mutex_unlock(&coco_cache_mutex);
+  return (entry != NULL);
+}
+
+/**
+ * @brief Releases a reference to the given cached data and frees the data when it was the last one.
+ */
+static void coco_cache_release(const void *data) {
+  coco_cache_entry_t *entry, **link;
+
+  if (data == NULL)
+    return;
+
+  coco_mutex_lock(&coco_cache_mutex);
+  for (link = &coco_cache_entries; (*link != NULL) && ((*link)->data != data); link = &(*link)->next)
+    ;
+  entry = *link;
+  if (entry == NULL) {
+    coco_mutex_unlock(&coco_cache_mutex);
+    coco_error("coco_cache_release(): the given data is not cached");
+    return; /* Never reached */
+  }
+  if (--entry->references > 0)
+    entry = NULL;
+  else
+    *link = entry->next;
+  coco_mutex_unlock(&coco_cache_mutex);
+
+  /* The last reference has been released */
+  if (entry != NULL) {
+    if (entry->parameters != NULL)
+      coco_free_memory(entry->parameters);
+    coco_free_memory(entry->memory);
+    coco_free_memory(entry);
+  }
+}
@@ -0,0 +1,205 @@
+/**
+ * @file coco_evaluation_cache.c
+ * @brief Implementation of a least-recently-used cache of evaluations.
+ *
+ * The cache maps a key (a vector of doubles, for example a point in the decision space) to a value (a vector
+ * of doubles, for example the objective values in that point). Keys are matched exactly, i.e. bit by bit, so
+ * the cache returns a value only for a point that has been evaluated before. When the cache is full, the
+ * entry that has been used least recently is replaced.
+ *
+ * The entries are found through a hash table, in which the entries of a bucket are chained, and are kept in
+ * a doubly linked list ordered by the time of their last use. All memory is allocated when the cache is
+ * allocated.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+
+/**
+ * @brief Marks the end of a chain or list of entries.
+ */
+#define COCO_EVALUATION_CACHE_NONE ((size_t)-1)
+
+/**
+ * @brief The cache of evaluations.
+ */
+typedef struct {
+  size_t capacity;          /**< @brief The maximal number of entries */
+  size_t number_of_entries; /**< @brief The number of entries in use */
+  size_t key_size;          /**< @brief The number of doubles of a key */
+  size_t value_size;        /**< @brief The number of doubles of a value */
+
+  double *keys;       /**< @brief The keys of the entries */
+  double *values;     /**< @brief The values of the entries */
+  uint64_t *hashes;   /**< @brief The hashes of the keys of the entries */
+  size_t *next;       /**< @brief The next entry in the bucket of each entry */
+  size_t *newer;      /**< @brief The entry used next after each entry */
+  size_t *older;      /**< @brief The entry used last before each entry */
+  size_t newest;      /**< @brief The entry used most recently */
+  size_t oldest;      /**< @brief The entry used least recently */
+  size_t *buckets;    /**< @brief The first entry of each bucket of the hash table */
+  size_t bucket_mask; /**< @brief The number of buckets minus one (the number of buckets is a power of two) */
+
+  size_t hits;   /**< @brief The number of successful lookups */
+  size_t misses; /**< @brief The number of unsuccessful lookups */
+} coco_evaluation_cache_t;
+
+/**
+ * @brief Allocates a cache with the given capacity for keys and values of the given sizes.
+ */
+static coco_evaluation_cache_t *coco_evaluation_cache_allocate(const size_t capacity, const size_t key_size,
+                                                               const size_t value_size) {
+  coco_evaluation_cache_t *cache;
+  size_t i, number_of_buckets = 1;
+
+  if (capacity == 0)
+    coco_error("coco_evaluation_cache_allocate(): the capacity needs to be positive");
+  assert(key_size > 0);
+
+  /* At least two buckets per entry keep the chains short */
+  while (number_of_buckets < 2 * capacity)
+    number_of_buckets *= 2;
+
+  cache = (coco_evaluation_cache_t *)coco_allocate_memory(sizeof(*cache));
+  cache->capacity = capacity;
+  cache->number_of_entries = 0;
+  cache->key_size = key_size;
+  cache->value_size = value_size;
+  cache->keys = coco_allocate_vector(capacity * key_size);
+  cache->values = (value_size > 0) ? coco_allocate_vector(capacity * value_size) : NULL;
+  cache->hashes = (uint64_t *)coco_allocate_memory(capacity * sizeof(uint64_t));
+  cache->next = coco_allocate_vector_size_t(capacity);
+  cache->newer = coco_allocate_vector_size_t(capacity);
+  cache->older = coco_allocate_vector_size_t(capacity);
+  cache->newest = COCO_EVALUATION_CACHE_NONE;
+  cache->oldest = COCO_EVALUATION_CACHE_NONE;
+  cache->buckets = coco_allocate_vector_size_t(number_of_buckets);
+  for (i = 0; i < number_of_buckets; i++)
+    cache->buckets[i] = COCO_EVALUATION_CACHE_NONE;
+  cache->bucket_mask = number_of_buckets - 1;
+  cache->hits = 0;
+  cache->misses = 0;
+  return cache;
+}
+
+/**
+ * @brief Frees the cache.
+ */
+static void coco_evaluation_cache_free(coco_evaluation_cache_t *cache) {
+  coco_free_memory(cache->keys);
+  if (cache->values != NULL)
+    coco_free_memory(cache->values);
+  coco_free_memory(cache->hashes);
+  coco_free_memory(cache->next);
+  coco_free_memory(cache->newer);
+  coco_free_memory(cache->older);
+  coco_free_memory(cache->buckets);
+  coco_free_memory(cache);
+}
+
+/**
+ * @brief Returns the (64-bit FNV-1a) hash of the bytes of the key.
+ */
+static uint64_t coco_evaluation_cache_hash(const coco_evaluation_cache_t *cache, const double *key) {
+  const unsigned char *bytes = (const unsigned char *)key;
+  const size_t number_of_bytes = cache->key_size * sizeof(double);
+  uint64_t hash = (uint64_t)14695981039346656037ULL;
+  size_t i;
+
+  for (i = 0; i < number_of_bytes; i++) {
+    hash ^= bytes[i];
+    hash *= (uint64_t)1099511628211ULL;
+  }
+  /* Mix the high bits into the low ones, which select the bucket */
+  return hash ^ (hash >> 32);
+}
+
+/**
+ * @brief Removes the entry from the list of used entries.
+ */
+static void coco_evaluation_cache_unlink(coco_evaluation_cache_t *cache, const size_t entry) {
+  if (cache->newer[entry] != COCO_EVALUATION_CACHE_NONE)
+    cache->older[cache->newer[entry]] = cache->older[entry];
+  else
+    cache->newest = cache->older[entry];
+  if (cache->older[entry] != COCO_EVALUATION_CACHE_NONE)
+    cache->newer[cache->older[entry]] = cache->newer[entry];
+  else
+    cache->oldest = cache->newer[entry];
+}
+
+/**
+ * @brief Adds the entry to the list of used entries as the one used most recently.
+ */
+static void coco_evaluation_cache_link_newest(coco_evaluation_cache_t *cache, const size_t entry) {
+  cache->newer[entry] = COCO_EVALUATION_CACHE_NONE;
+  cache->older[entry] = cache->newest;
+  if (cache->newest != COCO_EVALUATION_CACHE_NONE)
+    cache->newer[cache->newest] = entry;
+  else
+    cache->oldest = entry;
+  cache->newest = entry;
+}
+
+/**
+ * @brief Looks up the given key and copies its value if it is found.
+ *
+ * @return 1 if the key was found (in which case the entry becomes the one used most recently) and 0
+ * otherwise.
+ */
+static int coco_evaluation_cache_lookup(coco_evaluation_cache_t *cache, const double *key, double *value) {
+  const uint64_t hash = coco_evaluation_cache_hash(cache, key);
+  size_t entry;
+
+  for (entry = cache->buckets[(size_t)hash & cache->bucket_mask]; entry != COCO_EVALUATION_CACHE_NONE;
+       entry = cache->next[entry]) {
+    if ((cache->hashes[entry] == hash) &&
+        (memcmp(cache->keys + entry * cache->key_size, key, cache->key_size * sizeof(double)) == 0))
+      break;
+  }
+  if (entry == COCO_EVALUATION_CACHE_NONE) {
+    cache->misses++;
+    return 0;
+  }
+
+  if (entry != cache->newest) {
+    coco_evaluation_cache_unlink(cache, entry);
+    coco_evaluation_cache_link_newest(cache, entry);
+  }
+  if (cache->value_size > 0)
+    memcpy(value, cache->values + entry * cache->value_size, cache->value_size * sizeof(double));
+  cache->hits++;
+  return 1;
+}
+
+/**
+ * @brief Inserts the given key (which must not be in the cache) with its value, replacing the entry used
+ * least recently if the cache is full.
+ */
+static void coco_evaluation_cache_insert(coco_evaluation_cache_t *cache, const double *key, const double *value) {
+  const uint64_t hash = coco_evaluation_cache_hash(cache, key);
+  size_t entry, *link;
+
+  if (cache->number_of_entries < cache->capacity) {
+    entry = cache->number_of_entries++;
+  } else {
+    /* Remove the entry used least recently from its bucket and from the list */
+    entry = cache->oldest;
+    for (link = &cache->buckets[(size_t)cache->hashes[entry] & cache->bucket_mask]; *link != entry;
+         link = &cache->next[*link])
+      ;
+    *link = cache->next[entry];
+    coco_evaluation_cache_unlink(cache, entry);
+  }
+
+  memcpy(cache->keys + entry * cache->key_size, key, cache->key_size * sizeof(double));
+  if (cache->value_size > 0)
+    memcpy(cache->values + entry * cache->value_size, value, cache->value_size * sizeof(double));
+  cache->hashes[entry] = hash;
+  cache->next[entry] = cache->buckets[(size_t)hash & cache->bucket_mask];
+  cache->buckets[(size_t)hash & cache->bucket_mask] = entry;
+  coco_evaluation_cache_link_newest(cache, entry);
+}
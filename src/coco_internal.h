@@ -36,6 +36,25 @@ typedef void (*coco_problem_free_function_t)(coco_problem_t *problem);
  */
 typedef void (*coco_evaluate_function_t)(coco_problem_t *problem, const double *x, double *y);
 
+/**
+ * @brief The batch evaluate function type.
+ *
+ * This is a template for functions that evaluate the problem function in number_of_points points at once.
+ * The points are stored consecutively (row-major) in x and the results consecutively in y.
+ */
+typedef void (*coco_evaluate_batch_function_t)(coco_problem_t *problem, const double *x, double *y,
+                                               const size_t number_of_points);
+
+/**
+ * @brief The function and gradient evaluate function type.
+ *
+ * This is a template for functions that evaluate the problem function in x (stored in y) together with its
+ * gradient (stored in gradient), so that the intermediate results of the function evaluation can be reused
+ * for the gradient.
+ */
+typedef void (*coco_evaluate_function_and_gradient_t)(coco_problem_t *problem, const double *x, double *y,
+                                                      double *gradient);
+
 /**
  * @brief The evaluate function type with optional counter update.
  *
@@ -97,6 +116,9 @@ typedef struct {
   void *data;                                   /**< @brief Pointer to data, which enables further
                                                 wrapping of the problem */
   coco_data_free_function_t data_free_function; /**< @brief Function to free the contents of data */
+  double *batch_buffer;                         /**< @brief Buffer for the transformed points of a batch
+                                                evaluation (NULL until needed) */
+  size_t batch_buffer_size;                     /**< @brief Number of elements in batch_buffer */
 } coco_problem_transformed_data_t;
 
 /**
@@ -133,8 +155,13 @@ typedef struct {
 struct coco_problem_s {
 
   coco_evaluate_function_t evaluate_function;     /**< @brief  The function for evaluating the problem. */
+  coco_evaluate_batch_function_t evaluate_function_batch; /**< @brief  The function for evaluating the problem
+                                                          in several points at once (NULL if not implemented). */
   coco_evaluate_c_function_t evaluate_constraint; /**< @brief  The function for evaluating the constraints. */
   coco_evaluate_function_t evaluate_gradient; /**< @brief  The function for evaluating the gradient of the function. */
+  coco_evaluate_function_and_gradient_t evaluate_function_and_gradient; /**< @brief  The function for evaluating
+                                                                        the problem and its gradient at once (NULL
+                                                                        if not implemented). */
   coco_recommend_function_t recommend_solution;       /**< @brief  The function for recommending a solution. */
   coco_problem_free_function_t problem_free_function; /**< @brief  The function for freeing this problem. */
 
@@ -151,6 +178,15 @@ struct coco_problem_s {
   int is_noisy;                   /**< @brief*/
   double *last_noise_free_values; /**< @brief*/
 
+  double *scratch;    /**< @brief Scratch memory for the temporaries of a single evaluation (allocated once,
+                      so that evaluations do not need to allocate memory). */
+  size_t scratch_size; /**< @brief Number of doubles in scratch (at least the maximal number of variables,
+                       objectives and constraints found in this problem and the problems it wraps). */
+
+  double *constraint_memo;   /**< @brief The decision vector of the last evaluation of the constraints followed by
+                             the constraint values (allocated by coco_is_feasible(), NULL otherwise). */
+  int is_constraint_memo_set; /**< @brief Whether constraint_memo holds an evaluation. */
+
   double *initial_solution; /**< @brief Initial feasible solution. */
   int is_opt_known;         /**< @brief Whether the optimal (best) value is actually known for this problem. */
   double *best_value;       /**< @brief Optimal (smallest) function value if known, otherwise a reference
@@ -214,6 +250,8 @@ struct coco_observer_s {
   int precision_f;         /**< @brief Output precision for function values. */
   int precision_g;         /**< @brief Output precision for constraint values. */
   int log_discrete_as_int; /**< @brief Whether to output discrete variables in int or double format. */
+  int binary_format;       /**< @brief Whether the data files are written in the binary format. */
+  int is_thread_safe;      /**< @brief Whether several problems can be observed at the same time. */
   void *data;              /**< @brief Void pointer that can be used to point to data specific to an observer. */
 
   coco_data_free_function_t data_free_function;             /**< @brief  The function for freeing this observer. */
@@ -246,6 +284,8 @@ struct coco_suite_s {
 
   int known_optima; /**< @brief Whether the problems of the suite have known optimal values */
 
+  size_t evaluation_cache_size; /**< @brief The number of evaluations cached by mixed-integer problems. */
+
   coco_problem_t *current_problem; /**< @brief Pointer to the currently tackled problem. */
   long current_dimension_idx;      /**< @brief The dimension index of the currently tackled problem. */
   long current_function_idx;       /**< @brief The function index of the currently tackled problem. */
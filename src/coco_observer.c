@@ -443,7 +443,7 @@ static coco_observer_t *coco_observer_allocate(
     const char *result_folder, const char *observer_name, const char *algorithm_name, const char *algorithm_info, const char *settings,
     const size_t number_target_triggers, const double log_target_precision, const double lin_target_precision,
     const size_t number_evaluation_triggers, const char *base_evaluation_triggers, const int precision_x,
-    const int precision_f, const int precision_g, const int log_discrete_as_int) {
+    const int precision_f, const int precision_g, const int log_discrete_as_int, const int binary_format) {
 
   coco_observer_t *observer;
   observer = (coco_observer_t *)coco_allocate_memory(sizeof(*observer));
@@ -462,6 +462,8 @@ static coco_observer_t *coco_observer_allocate(
   observer->precision_f = precision_f;
   observer->precision_g = precision_g;
   observer->log_discrete_as_int = log_discrete_as_int;
+  observer->binary_format = binary_format;
+  observer->is_thread_safe = 0;
   observer->data = NULL;
   observer->data_free_function = NULL;
   observer->logger_allocate_function = NULL;
@@ -475,6 +477,16 @@ void coco_observer_free(coco_observer_t *observer) {
 
   if (observer != NULL) {
     observer->is_active = 0;
+
+    /* Free the data first, so that thread-safe loggers stop using the observer before it is dismantled */
+    if (observer->data != NULL) {
+      if (observer->data_free_function != NULL) {
+        observer->data_free_function(observer->data);
+      }
+      coco_free_memory(observer->data);
+      observer->data = NULL;
+    }
+
     if (observer->observer_name != NULL)
       coco_free_memory(observer->observer_name);
     if (observer->result_folder != NULL)
@@ -489,14 +501,6 @@ void coco_observer_free(coco_observer_t *observer) {
     if (observer->base_evaluation_triggers != NULL)
       coco_free_memory(observer->base_evaluation_triggers);
 
-    if (observer->data != NULL) {
-      if (observer->data_free_function != NULL) {
-        observer->data_free_function(observer->data);
-      }
-      coco_free_memory(observer->data);
-      observer->data = NULL;
-    }
-
     observer->logger_allocate_function = NULL;
     observer->logger_free_function = NULL;
     observer->restart_function = NULL;
@@ -576,6 +580,10 @@ void coco_observer_free(coco_observer_t *observer) {
  * - "log_discrete_as_int: VALUE" determines whether the values of integer
  * variables (in mixed-integer problems) are logged as integers (1) or not (0 -
  * in this case they are logged as doubles). The default value is 0.
+ * - "format: VALUE" determines whether the data files are written as text (text) or in a more compact
+ * binary format (binary), which can be converted to the text files with
+ * coco_observer_convert_binary_file(). The binary format is supported by the bbob, bbob-biobj and rw
+ * observers (and the observers based on them) and is ignored by the others. The default value is text.
  *
  * @return The constructed observer object or NULL if observer_name equals NULL,
  * "" or "no_observer".
@@ -583,8 +591,8 @@ void coco_observer_free(coco_observer_t *observer) {
 coco_observer_t *coco_observer(const char *observer_name, const char *observer_options) {
 
   coco_observer_t *observer;
-  char *path, *outer_folder, *result_folder, *algorithm_name, *algorithm_info, *settings;
-  int precision_x, precision_f, precision_g, log_discrete_as_int;
+  char *path, *outer_folder, *result_folder, *algorithm_name, *algorithm_info, *settings, *format;
+  int precision_x, precision_f, precision_g, log_discrete_as_int, binary_format;
 
   size_t number_target_triggers;
   size_t number_evaluation_triggers;
@@ -609,7 +617,8 @@ coco_observer_t *coco_observer(const char *observer_name, const char *observer_o
                               "precision_x",
                               "precision_f",
                               "precision_g",
-                              "log_discrete_as_int"};
+                              "log_discrete_as_int",
+                              "format"};
   additional_option_keys = NULL; /* To be set by the chosen observer */
 
   if (0 == strcmp(observer_name, "no_observer")) {
@@ -739,10 +748,21 @@ coco_observer_t *coco_observer(const char *observer_name, const char *observer_o
     }
   }
 
-  observer =
-      coco_observer_allocate(path, observer_name, algorithm_name, algorithm_info, settings, number_target_triggers,
-                             log_target_precision, lin_target_precision, number_evaluation_triggers,
-                             base_evaluation_triggers, precision_x, precision_f, precision_g, log_discrete_as_int);
+  binary_format = 0;
+  format = coco_allocate_string(COCO_PATH_MAX + 1);
+  if (coco_options_read_string(observer_options, "format", format) != 0) {
+    if (strcmp(format, "binary") == 0) {
+      binary_format = 1;
+    } else if (strcmp(format, "text") != 0) {
+      coco_warning("coco_observer(): Unsuitable observer option value (format: %s) ignored", format);
+    }
+  }
+  coco_free_memory(format);
+
+  observer = coco_observer_allocate(path, observer_name, algorithm_name, algorithm_info, settings,
+                                    number_target_triggers, log_target_precision, lin_target_precision,
+                                    number_evaluation_triggers, base_evaluation_triggers, precision_x, precision_f,
+                                    precision_g, log_discrete_as_int, binary_format);
 
   coco_free_memory(path);
   coco_free_memory(algorithm_name);
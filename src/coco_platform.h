@@ -90,6 +90,48 @@ int mkdir(const char *pathname, mode_t mode);
 #define S_IRWXU 0700
 #endif
 
+/* Definitions of the mutex used to serialize access to state shared between threads and of the threads
+ * used by coco_suite_run_experiment() (a thread function is declared as
+ * "static COCO_THREAD_RETURN_TYPE name(void *argument)" and returns COCO_THREAD_RETURN_VALUE) */
+#if defined(_WIN32) || defined(_WIN64) || defined(__MINGW64__) || defined(__CYGWIN__)
+typedef SRWLOCK coco_mutex_t;
+#define COCO_MUTEX_INITIALIZER SRWLOCK_INIT
+#define coco_mutex_init(mutex) InitializeSRWLock(mutex)
+#define coco_mutex_destroy(mutex) ((void)(mutex))
+#define coco_mutex_lock(mutex) AcquireSRWLockExclusive(mutex)
+#define coco_mutex_unlock(mutex) ReleaseSRWLockExclusive(mutex)
+typedef HANDLE coco_thread_t;
+#define COCO_THREAD_RETURN_TYPE DWORD WINAPI
+#define COCO_THREAD_RETURN_VALUE 0
+#define coco_thread_create(thread, function, argument)                                                        \
+  ((*(thread) = CreateThread(NULL, 0, function, argument, 0, NULL)) != NULL)
+#define coco_thread_join(thread) (WaitForSingleObject(thread, INFINITE), CloseHandle(thread))
+#else
+#include <pthread.h>
+typedef pthread_mutex_t coco_mutex_t;
+#define COCO_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#define coco_mutex_init(mutex) pthread_mutex_init(mutex, NULL)
+#define coco_mutex_destroy(mutex) pthread_mutex_destroy(mutex)
+#define coco_mutex_lock(mutex) pthread_mutex_lock(mutex)
+#define coco_mutex_unlock(mutex) pthread_mutex_unlock(mutex)
+typedef pthread_t coco_thread_t;
+#define COCO_THREAD_RETURN_TYPE void *
+#define COCO_THREAD_RETURN_VALUE NULL
+#define coco_thread_create(thread, function, argument) (pthread_create(thread, NULL, function, argument) == 0)
+#define coco_thread_join(thread) pthread_join(thread, NULL)
+#endif
+
+/* Relaxed atomic access to global counters and flags that are read much more often than written */
+#if defined(__GNUC__) || defined(__clang__)
+#define COCO_ATOMIC_LOAD(variable) __atomic_load_n(&(variable), __ATOMIC_RELAXED)
+#define COCO_ATOMIC_STORE(variable, value) __atomic_store_n(&(variable), (value), __ATOMIC_RELAXED)
+#define COCO_ATOMIC_INCREMENT(variable) ((void)__atomic_fetch_add(&(variable), 1, __ATOMIC_RELAXED))
+#else
+#define COCO_ATOMIC_LOAD(variable) (variable)
+#define COCO_ATOMIC_STORE(variable, value) ((variable) = (value))
+#define COCO_ATOMIC_INCREMENT(variable) ((variable)++)
+#endif
+
 /* To silence the Visual Studio compiler (C4996 warnings in the python build). */
 #ifdef _MSC_VER
 #pragma warning(disable : 4996)
@@ -15,6 +15,27 @@
  * @name Methods regarding the basic COCO problem
  */
 /**@{*/
+/**
+ * @brief Updates the best observed value and the best observed evaluation number after the evaluation of
+ * x resulted in y.
+ *
+ * Infeasible solutions are not taken into account.
+ */
+static void coco_problem_update_best_observed(coco_problem_t *problem, const double *x, const double *y) {
+  int is_feasible;
+
+  if (y[0] < problem->best_observed_fvalue[0]) {
+    is_feasible = 1;
+    if (coco_problem_get_number_of_constraints(problem) > 0) {
+      is_feasible = coco_is_feasible(problem, x, NULL);
+    }
+    if (is_feasible) {
+      problem->best_observed_fvalue[0] = y[0];
+      problem->best_observed_evaluation[0] = problem->evaluations;
+    }
+  }
+}
+
 /**
  * Evaluates the problem function, increases the number of evaluations and updates the best observed value
  * and the best observed evaluation number.
@@ -29,24 +50,22 @@
 void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
   /* implements a safer version of problem->evaluate(problem, x, y) */
   size_t i, j;
-  int is_feasible;
-  double *z;
 
   assert(problem != NULL);
   assert(problem->evaluate_function != NULL);
 
-  /* Set objective vector to INFINITY if the decision vector contains any INFINITY values */
-  for (i = 0; i < coco_problem_get_dimension(problem); i++) {
-    if (coco_is_inf(x[i])) {
-      for (j = 0; j < coco_problem_get_number_of_objectives(problem); j++) {
-        y[j] = fabs(x[i]);
+  if (COCO_UNLIKELY(!coco_vector_isfinite(x, coco_problem_get_dimension(problem)))) {
+    /* Set objective vector to INFINITY if the decision vector contains any INFINITY values */
+    for (i = 0; i < coco_problem_get_dimension(problem); i++) {
+      if (coco_is_inf(x[i])) {
+        for (j = 0; j < coco_problem_get_number_of_objectives(problem); j++) {
+          y[j] = fabs(x[i]);
+        }
+        return;
       }
-      return;
     }
-  }
 
-  /* Set objective vector to NAN if the decision vector contains any NAN values */
-  if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
+    /* Set objective vector to NAN if the decision vector contains any NAN values */
     coco_vector_set_to_nan(y, coco_problem_get_number_of_objectives(problem));
     return;
   }
@@ -55,20 +74,65 @@ void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y)
   problem->evaluations++; /* each derived class has its own counter, only the most outer will be visible */
 
   /* A little bit of bookkeeping */
-  if (y[0] < problem->best_observed_fvalue[0]) {
-    is_feasible = 1;
-    if (coco_problem_get_number_of_constraints(problem) > 0) {
-      z = coco_allocate_vector(coco_problem_get_number_of_constraints(problem));
-      is_feasible = coco_is_feasible(problem, x, z);
-      coco_free_memory(z);
-    }
-    if (is_feasible) {
-      problem->best_observed_fvalue[0] = y[0];
-      problem->best_observed_evaluation[0] = problem->evaluations;
-    }
+  coco_problem_update_best_observed(problem, x, y);
+}
+
+/**
+ * Evaluates the problem function in number_of_points points at once. The result, the number of evaluations
+ * and the best observed value and evaluation number are the same as if coco_evaluate_function was called
+ * on each of the points in turn.
+ *
+ * Problems that implement evaluate_function_batch receive the whole batch, which saves the overhead of
+ * walking through all the problem layers once per point. If the problem does not implement it or if any
+ * of the points contains NAN or INFINITY values, the points are evaluated one by one.
+ *
+ * @note x must point to a memory region of number_of_points * dimension values and y to a memory region of
+ * number_of_points * number_of_objectives values.
+ *
+ * @param problem The given COCO problem.
+ * @param x The decision vectors stored one after another.
+ * @param y The objective vectors that are the result of the evaluation stored one after another.
+ * @param number_of_points The number of decision vectors in x.
+ */
+void coco_evaluate_function_batch(coco_problem_t *problem, const double *x, double *y,
+                                  const size_t number_of_points) {
+  size_t k, dimension, number_of_objectives;
+
+  assert(problem != NULL);
+  assert(problem->evaluate_function != NULL);
+
+  dimension = coco_problem_get_dimension(problem);
+  number_of_objectives = coco_problem_get_number_of_objectives(problem);
+  if (number_of_points == 0)
+    return;
+
+  if ((problem->evaluate_function_batch == NULL) || !coco_vector_isfinite(x, number_of_points * dimension)) {
+    for (k = 0; k < number_of_points; k++)
+      coco_evaluate_function(problem, x + k * dimension, y + k * number_of_objectives);
+    return;
+  }
+
+  problem->evaluate_function_batch(problem, x, y, number_of_points);
+
+  for (k = 0; k < number_of_points; k++) {
+    problem->evaluations++;
+    coco_problem_update_best_observed(problem, x + k * dimension, y + k * number_of_objectives);
   }
 }
 
+/**
+ * @brief Evaluates the problem function point by point by calling problem->evaluate_function directly.
+ *
+ * Serves as the batch evaluation of basic problems, whose evaluate_function does not call any other
+ * problem, as it skips the checks and bookkeeping already done by coco_evaluate_function_batch.
+ */
+static void coco_problem_evaluate_function_batch_by_loop(coco_problem_t *problem, const double *x, double *y,
+                                                         const size_t number_of_points) {
+  size_t k;
+  for (k = 0; k < number_of_points; k++)
+    problem->evaluate_function(problem, x + k * problem->number_of_variables, y + k * problem->number_of_objectives);
+}
+
 /**
  * Evaluates the problem constraint.
  *
@@ -103,7 +167,7 @@ void coco_evaluate_constraint_optional_update(coco_problem_t *problem, const dou
     return;
   }
 
-  problem->evaluate_constraint(problem, x, y, update_counter);
+  coco_evaluate_constraint_memoized(problem, x, y, update_counter);
   if (update_counter)
     problem->evaluations_constraints++;
 }
@@ -128,6 +192,89 @@ static void bbob_evaluate_gradient(coco_problem_t *problem, const double *x, dou
   problem->evaluate_gradient(problem, x, y);
 }
 
+/**
+ * Evaluates the gradient of the (single-objective) problem function. The gradient is computed analytically
+ * through all the layers of the problem. Evaluating the gradient does not increase the number of evaluations
+ * and is not seen by the observer.
+ *
+ * For functions that are not differentiable everywhere, the gradient is that of the smooth piece containing x.
+ * The rounded variables of the step ellipsoid function do not contribute to it, as the function is constant in
+ * them between two steps. The Katsuura function is piecewise smooth (with kinks at the multiples of 2^-33) and
+ * its gradient is not zero.
+ *
+ * @note Both x and y must point to correctly sized allocated memory regions (y must hold dimension values).
+ *
+ * @param problem The given COCO problem.
+ * @param x The decision vector.
+ * @param y The gradient of the function evaluated at the point x.
+ */
+void coco_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  assert(problem != NULL);
+  if (problem->evaluate_gradient == NULL) {
+    coco_error("coco_evaluate_gradient(): No gradient function implemented for problem %s", problem->problem_id);
+    return; /* Never reached */
+  }
+
+  /* Set the gradient to NAN if the decision vector contains any INFINITY or NAN values */
+  if (!coco_vector_isfinite(x, coco_problem_get_dimension(problem))) {
+    coco_vector_set_to_nan(y, coco_problem_get_dimension(problem));
+    return;
+  }
+
+  problem->evaluate_gradient(problem, x, y);
+}
+
+/**
+ * Evaluates the problem function and its gradient. The result, the number of evaluations and the best
+ * observed value are the same as when calling coco_evaluate_function followed by coco_evaluate_gradient
+ * (the evaluation is counted and observed once).
+ *
+ * Problems that implement evaluate_function_and_gradient perform the transformations of x only once and
+ * reuse their intermediate results for the gradient. If the problem does not implement it or if x contains
+ * NAN or INFINITY values, the function and the gradient are evaluated one after the other.
+ *
+ * @note x and gradient must point to memory regions of dimension values and y to a memory region of
+ * number_of_objectives values.
+ *
+ * @param problem The given COCO problem.
+ * @param x The decision vector.
+ * @param y The objective vector that is the result of the evaluation.
+ * @param gradient The gradient of the function evaluated at the point x.
+ */
+void coco_evaluate_function_and_gradient(coco_problem_t *problem, const double *x, double *y, double *gradient) {
+  assert(problem != NULL);
+  assert(problem->evaluate_function != NULL);
+  if (problem->evaluate_gradient == NULL) {
+    coco_error("coco_evaluate_function_and_gradient(): No gradient function implemented for problem %s",
+               problem->problem_id);
+    return; /* Never reached */
+  }
+
+  if ((problem->evaluate_function_and_gradient == NULL) ||
+      !coco_vector_isfinite(x, coco_problem_get_dimension(problem))) {
+    coco_evaluate_function(problem, x, y);
+    coco_evaluate_gradient(problem, x, gradient);
+    return;
+  }
+
+  problem->evaluate_function_and_gradient(problem, x, y, gradient);
+  problem->evaluations++;
+  coco_problem_update_best_observed(problem, x, y);
+}
+
+/**
+ * @brief Evaluates the problem function and its gradient by calling problem->evaluate_function and
+ * problem->evaluate_gradient directly.
+ *
+ * Serves as the fused evaluation of basic problems, whose evaluate_function does not call any other
+ * problem.
+ */
+static void coco_problem_evaluate_function_and_gradient_by_parts(coco_problem_t *problem, const double *x,
+                                                                 double *y, double *gradient) {
+  problem->evaluate_function(problem, x, y);
+  bbob_evaluate_gradient(problem, x, gradient);
+}
+
 /**
  * Evaluates and logs the given solution (as the coco_evaluate_function), but does not return the evaluated
  * value.
@@ -159,8 +306,10 @@ static coco_problem_t *coco_problem_allocate(const size_t number_of_variables, c
   /* Initialize fields to sane/safe defaults */
   problem->initial_solution = NULL;
   problem->evaluate_function = NULL;
+  problem->evaluate_function_batch = NULL;
   problem->evaluate_constraint = NULL;
   problem->evaluate_gradient = NULL;
+  problem->evaluate_function_and_gradient = NULL;
   problem->recommend_solution = NULL;
   problem->problem_free_function = NULL;
 
@@ -171,6 +320,18 @@ static coco_problem_t *coco_problem_allocate(const size_t number_of_variables, c
   problem->largest_values_of_interest = coco_allocate_vector(number_of_variables);
   problem->number_of_integer_variables = 0; /* No integer variables by default */
 
+  /* The scratch memory is allocated once here so that evaluations do not need to allocate any memory */
+  problem->scratch_size = 1;
+  if (number_of_variables > problem->scratch_size)
+    problem->scratch_size = number_of_variables;
+  if (number_of_objectives > problem->scratch_size)
+    problem->scratch_size = number_of_objectives;
+  if (number_of_constraints > problem->scratch_size)
+    problem->scratch_size = number_of_constraints;
+  problem->scratch = coco_allocate_vector(problem->scratch_size);
+  problem->constraint_memo = NULL;
+  problem->is_constraint_memo_set = 0;
+
   problem->is_noisy = 0;
   problem->last_noise_free_values = NULL;
   if (number_of_objectives > 0)
@@ -221,6 +382,13 @@ static coco_problem_t *coco_problem_duplicate(const coco_problem_t *other) {
 
   problem->versatile_data = other->versatile_data; /* Wassim: make the pointers the same*/
 
+  /* The scratch memory must also be large enough for the temporaries of the (wrapped) other problem */
+  if (other->scratch_size > problem->scratch_size) {
+    coco_free_memory(problem->scratch);
+    problem->scratch_size = other->scratch_size;
+    problem->scratch = coco_allocate_vector(problem->scratch_size);
+  }
+
   /*
    * OME: coco_problem_allocate allocates ->best_parameter. No need to do it here since that leaks memory.
    * if (other->best_parameter) {
@@ -291,6 +459,8 @@ coco_problem_allocate_from_scalars(const char *problem_name, coco_evaluate_funct
   problem->number_of_objectives = 1;
   problem->number_of_constraints = 0;
   problem->evaluate_function = evaluate_function;
+  problem->evaluate_function_batch = coco_problem_evaluate_function_batch_by_loop;
+  problem->evaluate_function_and_gradient = coco_problem_evaluate_function_and_gradient_by_parts;
   problem->problem_free_function = problem_free_function;
 
   for (i = 0; i < number_of_variables; ++i) {
@@ -330,6 +500,10 @@ void coco_problem_free(coco_problem_t *problem) {
       coco_free_memory(problem->initial_solution);
     if (problem->last_noise_free_values != NULL)
       coco_free_memory(problem->last_noise_free_values);
+    if (problem->scratch != NULL)
+      coco_free_memory(problem->scratch);
+    if (problem->constraint_memo != NULL)
+      coco_free_memory(problem->constraint_memo);
     problem->smallest_values_of_interest = NULL;
     problem->largest_values_of_interest = NULL;
     problem->best_parameter = NULL;
@@ -338,6 +512,8 @@ void coco_problem_free(coco_problem_t *problem) {
     problem->nadir_value = NULL;
     problem->suite = NULL;
     problem->initial_solution = NULL;
+    problem->scratch = NULL;
+    problem->constraint_memo = NULL;
     coco_free_memory(problem);
   }
 }
@@ -748,6 +924,27 @@ static coco_problem_t *coco_problem_transformed_get_inner_problem(const coco_pro
   return ((coco_problem_transformed_data_t *)problem->data)->inner_problem;
 }
 
+/**
+ * @brief Returns a buffer of at least size values owned by the transformed problem.
+ *
+ * Used by the batch evaluation functions of transformations to store the transformed points. The buffer
+ * only grows, so that repeated batch evaluations of the same size do not allocate memory.
+ */
+static double *coco_problem_transformed_get_batch_buffer(coco_problem_t *problem, const size_t size) {
+  coco_problem_transformed_data_t *data;
+  assert(problem != NULL);
+  assert(problem->data != NULL);
+  data = (coco_problem_transformed_data_t *)problem->data;
+
+  if (data->batch_buffer_size < size) {
+    if (data->batch_buffer != NULL)
+      coco_free_memory(data->batch_buffer);
+    data->batch_buffer = coco_allocate_vector(size);
+    data->batch_buffer_size = size;
+  }
+  return data->batch_buffer;
+}
+
 /**
  * @brief Calls the coco_evaluate_function function on the inner problem.
  */
@@ -818,6 +1015,10 @@ static void coco_problem_transformed_free_data(coco_problem_t *problem) {
     coco_free_memory(data->data);
     data->data = NULL;
   }
+  if (data->batch_buffer != NULL) {
+    coco_free_memory(data->batch_buffer);
+    data->batch_buffer = NULL;
+  }
   /* Let the generic free problem code deal with the rest of the fields. For this we clear the free_problem
    * function pointer and recall the generic function. */
   problem->problem_free_function = NULL;
@@ -858,6 +1059,8 @@ static coco_problem_t *coco_problem_transformed_allocate(coco_problem_t *inner_p
   problem->inner_problem = inner_problem;
   problem->data = user_data;
   problem->data_free_function = data_free_function;
+  problem->batch_buffer = NULL;
+  problem->batch_buffer_size = 0;
 
   inner_copy = coco_problem_duplicate(inner_problem);
   inner_copy->evaluate_function = coco_problem_transformed_evaluate_function;
@@ -889,7 +1092,6 @@ static void coco_problem_stacked_evaluate_function(coco_problem_t *problem, cons
 
   const size_t number_of_objectives_problem1 = coco_problem_get_number_of_objectives(data->problem1);
   const size_t number_of_objectives_problem2 = coco_problem_get_number_of_objectives(data->problem2);
-  double *cons_values = NULL;
   int is_feasible;
 
   assert(coco_problem_get_number_of_objectives(problem) ==
@@ -904,9 +1106,7 @@ static void coco_problem_stacked_evaluate_function(coco_problem_t *problem, cons
    * than the minimum's.
    */
   if (problem->number_of_constraints > 0) {
-    cons_values = coco_allocate_vector(problem->number_of_constraints);
-    is_feasible = coco_is_feasible(problem, x, cons_values);
-    coco_free_memory(cons_values);
+    is_feasible = coco_is_feasible(problem, x, NULL);
     if (is_feasible)
       assert(y[0] + 1e-13 >= problem->best_value[0]);
   }
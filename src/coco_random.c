@@ -95,6 +95,43 @@ double coco_random_normal(coco_random_state_t *state) {
   return normal;
 }
 
+/**
+ * @brief Computes the Philox4x32-10 bijection of the given 128-bit counter with the given 64-bit key.
+ *
+ * Philox is a counter-based random number generator (Salmon et al., "Parallel random numbers: as easy as
+ * 1, 2, 3", SC 2011): the i-th random value of a stream with key k is simply the image of i under the
+ * bijection defined by k. Streams therefore need no state besides their key and counter, can be reset or
+ * skipped ahead in constant time and are independent of each other.
+ *
+ * @param counter The counter, which is replaced by the four random 32-bit words.
+ * @param key The key.
+ */
+static void coco_random_philox4x32(uint32_t counter[4], const uint32_t key[2]) {
+  uint32_t key0 = key[0], key1 = key[1];
+  uint64_t product0, product1;
+  int round;
+
+  for (round = 0; round < 10; round++) {
+    product0 = (uint64_t)0xD2511F53UL * counter[0];
+    product1 = (uint64_t)0xCD9E8D57UL * counter[2];
+    counter[0] = (uint32_t)(product1 >> 32) ^ counter[1] ^ key0;
+    counter[1] = (uint32_t)product1;
+    counter[2] = (uint32_t)(product0 >> 32) ^ counter[3] ^ key1;
+    counter[3] = (uint32_t)product0;
+    key0 += (uint32_t)0x9E3779B9UL;
+    key1 += (uint32_t)0xBB67AE85UL;
+  }
+}
+
+/**
+ * @brief Returns a uniform random value in (0, 1) with 52 random bits made from two random 32-bit words.
+ *
+ * Only 52 bits are used, so that adding 1/2 is exact and the result can be neither 0 nor 1.
+ */
+static double coco_random_words_to_uniform(const uint32_t word0, const uint32_t word1) {
+  return ((double)(word0 >> 6) * 67108864.0 + (double)(word1 >> 6) + 0.5) / 4503599627370496.0;
+}
+
 /* Be hygienic (for amalgamation) and undef lags. */
 #undef COCO_SHORT_LAG
 #undef COCO_LONG_LAG
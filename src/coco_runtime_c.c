@@ -27,7 +27,7 @@ void coco_error(const char *message, ...) {
 void coco_warning(const char *message, ...) {
   va_list args;
 
-  if (coco_log_level >= COCO_WARNING) {
+  if (COCO_ATOMIC_LOAD(coco_log_level) >= COCO_WARNING) {
     fprintf(stderr, "COCO WARNING: ");
     va_start(args, message);
     vfprintf(stderr, message, args);
@@ -39,7 +39,7 @@ void coco_warning(const char *message, ...) {
 void coco_info(const char *message, ...) {
   va_list args;
 
-  if (coco_log_level >= COCO_INFO) {
+  if (COCO_ATOMIC_LOAD(coco_log_level) >= COCO_INFO) {
     fprintf(stdout, "COCO INFO: ");
     va_start(args, message);
     vfprintf(stdout, message, args);
@@ -56,7 +56,7 @@ void coco_info(const char *message, ...) {
 void coco_info_partial(const char *message, ...) {
   va_list args;
 
-  if (coco_log_level >= COCO_INFO) {
+  if (COCO_ATOMIC_LOAD(coco_log_level) >= COCO_INFO) {
     va_start(args, message);
     vfprintf(stdout, message, args);
     va_end(args);
@@ -67,7 +67,7 @@ void coco_info_partial(const char *message, ...) {
 void coco_debug(const char *message, ...) {
   va_list args;
 
-  if (coco_log_level >= COCO_DEBUG) {
+  if (COCO_ATOMIC_LOAD(coco_log_level) >= COCO_DEBUG) {
     fprintf(stdout, "COCO DEBUG: ");
     va_start(args, message);
     vfprintf(stdout, message, args);
@@ -77,12 +77,25 @@ void coco_debug(const char *message, ...) {
   }
 }
 
+#ifndef NDEBUG
+/**
+ * @brief The number of calls to coco_allocate_memory() so far.
+ *
+ * Only counted in debug builds, where it is used to check that evaluations in a steady state do not
+ * allocate any memory.
+ */
+static size_t coco_number_of_allocations = 0;
+#endif
+
 void *coco_allocate_memory(const size_t size) {
   void *data;
   if (size == 0) {
     coco_error("coco_allocate_memory() called with 0 size.");
     return NULL; /* never reached */
   }
+#ifndef NDEBUG
+  COCO_ATOMIC_INCREMENT(coco_number_of_allocations);
+#endif
   data = malloc(size);
   if (data == NULL)
     coco_error("coco_allocate_memory() failed.");
@@ -0,0 +1,350 @@
+/**
+ * @file coco_simd.c
+ * @brief Definitions of the vectorized exp(), log(), sin() and cos() and of the runtime instruction set
+ * dispatch used by the SIMD versions of the transformations and raw functions.
+ *
+ * The SIMD code is optional and only compiled if COCO_SIMD is defined and the compiler supports the GCC
+ * vector extensions on x86-64 (GCC and Clang). It is off by default, because the vectorized functions are
+ * accurate to a few ulp, while the scalar code reproduces the regression test data bit for bit.
+ *
+ * The functions work on vectors of COCO_SIMD_WIDTH doubles and are written only once. Each kernel is
+ * compiled for AVX-512, AVX2 and SSE2 by COCO_SIMD_DEFINE_KERNEL and the version is chosen at runtime
+ * with CPUID. The AVX-512 version may contract multiplications and additions into FMA instructions, so
+ * that its results can differ from the others in the last bits. Kernels return 1 if they have computed
+ * the result and 0 if the caller has to use the scalar code, which is always the case if COCO_SIMD is
+ * not defined (see COCO_SIMD_RUN).
+ */
+
+#include <math.h>
+#include <float.h>
+#include <string.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+
+#if defined(COCO_SIMD) && defined(__GNUC__) && defined(__x86_64__)
+#define COCO_SIMD_ENABLED 1
+#else
+#define COCO_SIMD_ENABLED 0
+#endif
+
+#if COCO_SIMD_ENABLED
+
+/** @brief The number of doubles in a vector. */
+#define COCO_SIMD_WIDTH 8
+
+/** @brief Vector of doubles. */
+typedef double coco_simd_vector_t __attribute__((vector_size(COCO_SIMD_WIDTH * sizeof(double))));
+
+/** @brief Vector of the bit patterns of doubles, also used for the lane masks of comparisons. */
+typedef uint64_t coco_simd_bits_t __attribute__((vector_size(COCO_SIMD_WIDTH * sizeof(double))));
+
+/** @brief Qualifiers of the vector functions, which are inlined into the kernels of each instruction set. */
+#define COCO_SIMD_INLINE static __inline__ __attribute__((always_inline))
+
+#if !defined(__clang__)
+/* The vector functions are always inlined into the kernels (also in the files including this one), so that
+ * the ABI for returning vectors does not matter */
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+/** @brief Adding and subtracting 1.5 * 2^52 rounds a double of magnitude below 2^51 to an integer. */
+static const double coco_simd_magic = 6755399441055744.0;
+
+/**
+ * @brief The instruction sets for which the kernels are compiled.
+ */
+typedef enum {
+  COCO_SIMD_UNKNOWN = -1,
+  COCO_SIMD_SSE2,
+  COCO_SIMD_AVX2,
+  COCO_SIMD_AVX512
+} coco_simd_level_t;
+
+/**
+ * @brief The instruction set used by the kernels, detected on first use.
+ *
+ * Can be set to a lower level than the detected one (in the unit tests, for example).
+ */
+static int coco_simd_level = COCO_SIMD_UNKNOWN;
+
+/**
+ * @brief Returns the best instruction set supported by the processor and the operating system.
+ */
+static int coco_simd_get_level(void) {
+  int level = COCO_ATOMIC_LOAD(coco_simd_level);
+  if (level == COCO_SIMD_UNKNOWN) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+      level = COCO_SIMD_AVX512;
+    else if (__builtin_cpu_supports("avx2"))
+      level = COCO_SIMD_AVX2;
+    else
+      level = COCO_SIMD_SSE2; /* Part of x86-64 */
+    COCO_ATOMIC_STORE(coco_simd_level, level);
+  }
+  return level;
+}
+
+/**
+ * @brief Defines the kernel name() that calls the version of name_body() compiled for the best available
+ * instruction set.
+ *
+ * The body needs to be a COCO_SIMD_INLINE function returning int.
+ */
+#define COCO_SIMD_DEFINE_KERNEL(name, parameters, arguments)                                                 \
+  static __attribute__((target("avx512f"))) int name##_avx512 parameters { return name##_body arguments; } \
+  static __attribute__((target("avx2"))) int name##_avx2 parameters { return name##_body arguments; }       \
+  static int name##_sse2 parameters { return name##_body arguments; }                                      \
+  static int name parameters {                                                                             \
+    switch (coco_simd_get_level()) {                                                                       \
+    case COCO_SIMD_AVX512:                                                                                 \
+      return name##_avx512 arguments;                                                                      \
+    case COCO_SIMD_AVX2:                                                                                   \
+      return name##_avx2 arguments;                                                                        \
+    default:                                                                                               \
+      return name##_sse2 arguments;                                                                        \
+    }                                                                                                      \
+  }
+
+/** @brief Runs the kernel and evaluates to its return value. */
+#define COCO_SIMD_RUN(kernel, arguments) kernel arguments
+
+/** @brief Returns the lanes of a where the mask is set and the lanes of b elsewhere. */
+#define COCO_SIMD_SELECT(mask, a, b)                                                                         \
+  ((coco_simd_vector_t)(((mask) & (coco_simd_bits_t)(a)) | (~(mask) & (coco_simd_bits_t)(b))))
+
+/** @brief Returns the mask of the lanes of x outside of [lower_bound, upper_bound], including NaNs. */
+#define COCO_SIMD_OUTSIDE(x, lower_bound, upper_bound)                                                       \
+  (~(coco_simd_bits_t)(((x) >= (lower_bound)) & ((x) <= (upper_bound))))
+
+/** @brief Returns fabs(x) in each lane. */
+#define COCO_SIMD_ABS(x) ((coco_simd_vector_t)((coco_simd_bits_t)(x) & ~((uint64_t)1 << 63)))
+
+/** @brief Returns x rounded to an integer in each lane, with ties to even (only valid for |x| < 2^51). */
+#define COCO_SIMD_ROUND(x) (((x) + coco_simd_magic) - coco_simd_magic)
+
+/*
+ * The vector functions below take their vector arguments by address, because GCC informs about the ABI of
+ * vector parameters even for functions that are always inlined.
+ */
+
+/**
+ * @brief Returns the vector with all lanes set to value.
+ */
+COCO_SIMD_INLINE coco_simd_vector_t coco_simd_set(const double value) {
+  const coco_simd_vector_t zero = {0};
+  return zero + value;
+}
+
+/**
+ * @brief Loads COCO_SIMD_WIDTH doubles, which need not be aligned.
+ */
+COCO_SIMD_INLINE coco_simd_vector_t coco_simd_load(const double *x) {
+  coco_simd_vector_t v;
+  memcpy(&v, x, sizeof(v));
+  return v;
+}
+
+/**
+ * @brief Stores COCO_SIMD_WIDTH doubles, which need not be aligned.
+ */
+COCO_SIMD_INLINE void coco_simd_store(double *y, const coco_simd_vector_t *v) {
+  memcpy(y, v, sizeof(*v));
+}
+
+/**
+ * @brief Returns the sum of the lanes.
+ */
+COCO_SIMD_INLINE double coco_simd_sum(const coco_simd_vector_t *v) {
+  double lanes[COCO_SIMD_WIDTH], sum = 0.0;
+  size_t i;
+  memcpy(lanes, v, sizeof(lanes));
+  for (i = 0; i < COCO_SIMD_WIDTH; ++i)
+    sum += lanes[i];
+  return sum;
+}
+
+/**
+ * @brief Returns 1 if any lane of the mask is set and 0 otherwise.
+ */
+COCO_SIMD_INLINE int coco_simd_any(const coco_simd_bits_t *mask) {
+  uint64_t lanes[COCO_SIMD_WIDTH], any = 0;
+  size_t i;
+  memcpy(lanes, mask, sizeof(lanes));
+  for (i = 0; i < COCO_SIMD_WIDTH; ++i)
+    any |= lanes[i];
+  return any != 0;
+}
+
+/**
+ * @brief Returns exp(x) in each lane and marks the lanes outside of [-708, 708] as invalid.
+ *
+ * The argument is reduced to r = x - k log(2) with |r| <= log(2) / 2, so that exp(x) = 2^k exp(r), where
+ * exp(r) is evaluated by its Taylor polynomial of degree 13.
+ */
+COCO_SIMD_INLINE coco_simd_vector_t coco_simd_exp(const coco_simd_vector_t *x, coco_simd_bits_t *invalid) {
+  const coco_simd_vector_t t = *x * 1.4426950408889634 + coco_simd_magic;
+  const coco_simd_vector_t k = t - coco_simd_magic;
+  const coco_simd_vector_t r = (*x - k * 6.93147180369123816490e-01) - k * 1.90821492927058770002e-10;
+  const coco_simd_bits_t two_to_k = ((coco_simd_bits_t)t - (coco_simd_bits_t)coco_simd_set(coco_simd_magic) + 1023)
+                                    << 52;
+  coco_simd_vector_t p;
+
+  p = r * (1.0 / 6227020800.0) + 1.0 / 479001600.0;
+  p = p * r + 1.0 / 39916800.0;
+  p = p * r + 1.0 / 3628800.0;
+  p = p * r + 1.0 / 362880.0;
+  p = p * r + 1.0 / 40320.0;
+  p = p * r + 1.0 / 5040.0;
+  p = p * r + 1.0 / 720.0;
+  p = p * r + 1.0 / 120.0;
+  p = p * r + 1.0 / 24.0;
+  p = p * r + 1.0 / 6.0;
+  p = p * r + 0.5;
+  p = p * r + 1.0;
+  p = p * r + 1.0;
+
+  *invalid |= COCO_SIMD_OUTSIDE(*x, -708.0, 708.0);
+  return p * (coco_simd_vector_t)two_to_k;
+}
+
+/**
+ * @brief Returns log(x) in each lane and marks the lanes that are not positive, subnormal or infinite as
+ * invalid.
+ *
+ * With x = 2^k m and sqrt(2) / 2 < m <= sqrt(2), log(x) = k log(2) + log(m), where log(m) is evaluated
+ * like in fdlibm.
+ */
+COCO_SIMD_INLINE coco_simd_vector_t coco_simd_log(const coco_simd_vector_t *x, coco_simd_bits_t *invalid) {
+  static const double ln2_hi = 6.93147180369123816490e-01, ln2_lo = 1.90821492927058770002e-10;
+  const coco_simd_bits_t bits = (coco_simd_bits_t)*x;
+  const coco_simd_vector_t mantissa =
+      (coco_simd_vector_t)((bits & (((uint64_t)1 << 52) - 1)) | ((uint64_t)1023 << 52));
+  const coco_simd_bits_t is_large = (coco_simd_bits_t)(mantissa > 1.4142135623730951);
+  const coco_simd_bits_t exponent = (bits >> 52) + (is_large & 1);
+  const coco_simd_vector_t k =
+      (coco_simd_vector_t)((coco_simd_bits_t)coco_simd_set(coco_simd_magic) + exponent - 1023) - coco_simd_magic;
+  const coco_simd_vector_t f = COCO_SIMD_SELECT(is_large, 0.5 * mantissa, mantissa) - 1.0;
+  const coco_simd_vector_t s = f / (2.0 + f);
+  const coco_simd_vector_t z = s * s;
+  const coco_simd_vector_t w = z * z;
+  const coco_simd_vector_t t1 = w * (3.999999999940941908e-01 +
+                                     w * (2.222219843214978396e-01 + w * 1.531383769920937332e-01));
+  const coco_simd_vector_t t2 = z * (6.666666666666735130e-01 +
+                                     w * (2.857142874366239149e-01 +
+                                          w * (1.818357216161805012e-01 + w * 1.479819860511658591e-01)));
+  const coco_simd_vector_t hfsq = 0.5 * f * f;
+
+  *invalid |= COCO_SIMD_OUTSIDE(*x, DBL_MIN, DBL_MAX);
+  return k * ln2_hi - ((hfsq - (s * (hfsq + t1 + t2) + k * ln2_lo)) - f);
+}
+
+/**
+ * @brief Returns r = x - q pi / 2 with |r| <= pi / 4 and sets quadrant to q (modulo 4) in each lane, marking
+ * the lanes outside of [-1e8, 1e8] as invalid.
+ *
+ * The products of q and the first three parts of pi / 2 are exact for |q| < 2^27 (Cody and Waite).
+ */
+COCO_SIMD_INLINE coco_simd_vector_t coco_simd_reduce_half_pi(const coco_simd_vector_t *x,
+                                                             coco_simd_bits_t *quadrant,
+                                                             coco_simd_bits_t *invalid) {
+  const coco_simd_vector_t t = *x * 0.63661977236758134 + coco_simd_magic;
+  const coco_simd_vector_t q = t - coco_simd_magic;
+
+  *quadrant = (coco_simd_bits_t)t - (coco_simd_bits_t)coco_simd_set(coco_simd_magic);
+  *invalid |= COCO_SIMD_OUTSIDE(*x, -1e8, 1e8);
+  return (((*x - q * 1.5707963407039642) + q * 1.3909067675399456e-08) - q * 6.123233932053594e-17) -
+         q * 6.36831716351095e-25;
+}
+
+/**
+ * @brief Returns sin(r) in each lane for |r| <= pi / 4 (fdlibm polynomial).
+ */
+COCO_SIMD_INLINE coco_simd_vector_t coco_simd_sin_kernel(const coco_simd_vector_t *r) {
+  const coco_simd_vector_t z = *r * *r;
+  const coco_simd_vector_t p =
+      8.33333333332248946124e-03 +
+      z * (-1.98412698298579493134e-04 +
+           z * (2.75573137070700676789e-06 + z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10)));
+  return *r + (z * *r) * (-1.66666666666666324348e-01 + z * p);
+}
+
+/**
+ * @brief Returns cos(r) in each lane for |r| <= pi / 4 (fdlibm polynomial).
+ */
+COCO_SIMD_INLINE coco_simd_vector_t coco_simd_cos_kernel(const coco_simd_vector_t *r) {
+  const coco_simd_vector_t z = *r * *r;
+  const coco_simd_vector_t p =
+      z * (4.16666666666666019037e-02 +
+           z * (-1.38888888888741095749e-03 +
+                z * (2.48015872894767294178e-05 +
+                     z * (-2.75573143513906633035e-07 +
+                          z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11)))));
+  const coco_simd_vector_t half_z = 0.5 * z;
+  const coco_simd_vector_t w = 1.0 - half_z;
+  return w + (((1.0 - w) - half_z) + z * p);
+}
+
+/**
+ * @brief Returns sin(x) in each lane and marks the lanes outside of [-1e8, 1e8] as invalid.
+ */
+COCO_SIMD_INLINE coco_simd_vector_t coco_simd_sin(const coco_simd_vector_t *x, coco_simd_bits_t *invalid) {
+  coco_simd_bits_t quadrant;
+  const coco_simd_vector_t r = coco_simd_reduce_half_pi(x, &quadrant, invalid);
+  const coco_simd_vector_t v =
+      COCO_SIMD_SELECT(-(quadrant & 1), coco_simd_cos_kernel(&r), coco_simd_sin_kernel(&r));
+  return (coco_simd_vector_t)((coco_simd_bits_t)v ^ ((quadrant & 2) << 62));
+}
+
+/**
+ * @brief Returns cos(x) in each lane and marks the lanes outside of [-1e8, 1e8] as invalid.
+ */
+COCO_SIMD_INLINE coco_simd_vector_t coco_simd_cos(const coco_simd_vector_t *x, coco_simd_bits_t *invalid) {
+  coco_simd_bits_t quadrant;
+  const coco_simd_vector_t r = coco_simd_reduce_half_pi(x, &quadrant, invalid);
+  const coco_simd_vector_t v =
+      COCO_SIMD_SELECT(-(quadrant & 1), coco_simd_sin_kernel(&r), coco_simd_cos_kernel(&r));
+  return (coco_simd_vector_t)((coco_simd_bits_t)v ^ (((quadrant + 1) & 2) << 62));
+}
+
+/**
+ * @brief Computes the sum of cos(2 pi x[i]) and, if sum_squares is not NULL, the sum of x[i]^2 (as needed by
+ * the Rastrigin functions).
+ *
+ * Returns 0 if an x[i] is outside of the range of coco_simd_cos().
+ */
+COCO_SIMD_INLINE int coco_simd_sum_cos_two_pi_body(const double *x, const size_t n, double *sum_cos,
+                                                   double *sum_squares) {
+  coco_simd_vector_t cos_sum = {0}, squares_sum = {0};
+  coco_simd_bits_t invalid = {0};
+  size_t i;
+
+  for (i = 0; i + COCO_SIMD_WIDTH <= n; i += COCO_SIMD_WIDTH) {
+    const coco_simd_vector_t xi = coco_simd_load(x + i);
+    const coco_simd_vector_t two_pi_xi = coco_two_pi * xi;
+    cos_sum += coco_simd_cos(&two_pi_xi, &invalid);
+    squares_sum += xi * xi;
+  }
+  if (coco_simd_any(&invalid))
+    return 0;
+  *sum_cos = coco_simd_sum(&cos_sum);
+  for (; i < n; ++i)
+    *sum_cos += cos(coco_two_pi * x[i]);
+  if (sum_squares != NULL) {
+    *sum_squares = coco_simd_sum(&squares_sum);
+    for (i = n - n % COCO_SIMD_WIDTH; i < n; ++i)
+      *sum_squares += x[i] * x[i];
+  }
+  return 1;
+}
+
+COCO_SIMD_DEFINE_KERNEL(coco_simd_sum_cos_two_pi, (const double *x, const size_t n, double *sum_cos,
+                                                   double *sum_squares), (x, n, sum_cos, sum_squares))
+
+#else
+
+/** @brief Evaluates to 0 (the scalar code is used) if the SIMD code is not compiled. */
+#define COCO_SIMD_RUN(kernel, arguments) 0
+
+#endif
@@ -3,6 +3,7 @@
  * @brief Definitions of functions that manipulate strings.
  */
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
 #include <string.h>
@@ -12,6 +13,8 @@
 
 static size_t *coco_allocate_vector_size_t(const size_t number_of_elements);
 static char *coco_allocate_string(const size_t number_of_elements);
+static int coco_is_nan(const double x);
+static int coco_is_inf(const double x);
 
 /**
  * @brief Creates a duplicate copy of string and returns a pointer to it.
@@ -40,7 +43,7 @@ static char *coco_strdup(const char *string) {
  * @brief Formatted string duplication, with va_list arguments.
  */
 static char *coco_vstrdupf(const char *str, va_list args) {
-  static char buf[COCO_VSTRDUPF_BUFLEN];
+  char buf[COCO_VSTRDUPF_BUFLEN]; /* not static, so that it can be called from several threads */
   long written;
   /* apparently args can only be used once, therefore
    * len = vsnprintf(NULL, 0, str, args) to find out the
@@ -141,7 +144,7 @@ static char **coco_string_split(const char *string, const char delimiter) {
 
   char **result;
   char *str_copy, *ptr, *token;
-  char str_delimiter[2];
+  int end_reached;
   size_t i;
   size_t count = 1;
 
@@ -160,18 +163,23 @@ static char **coco_string_split(const char *string, const char delimiter) {
 
   result = (char **)coco_allocate_memory(count * sizeof(char *));
 
-  /* Iterates through tokens
-   * NOTE: strtok() ignores multiple delimiters, therefore the final number of detected substrings might be
-   * lower than the count. This is OK. */
+  /* Iterates through tokens, ignoring empty ones (like strtok(), which is not used because it is not
+   * reentrant). The final number of detected substrings might therefore be lower than the count.
+   * This is OK. */
   i = 0;
-  /* A char* delimiter needs to be used, otherwise strtok() can surprise */
-  str_delimiter[0] = delimiter;
-  str_delimiter[1] = '\0';
-  token = strtok(str_copy, str_delimiter);
-  while (token) {
-    assert(i < count);
-    *(result + i++) = coco_strdup(token);
-    token = strtok(NULL, str_delimiter);
+  token = str_copy;
+  for (ptr = str_copy;; ptr++) {
+    if ((*ptr == delimiter) || (*ptr == '\0')) {
+      end_reached = (*ptr == '\0');
+      *ptr = '\0';
+      if (*token != '\0') {
+        assert(i < count);
+        *(result + i++) = coco_strdup(token);
+      }
+      if (end_reached)
+        break;
+      token = ptr + 1;
+    }
   }
   *(result + i) = NULL;
 
@@ -480,3 +488,266 @@ static char *coco_string_trim(char *string) {
 
   return string;
 }
+
+/**
+ * @name Fast formatting of numbers (used by the loggers)
+ *
+ * The functions produce exactly the same output as the corresponding printf conversions, but are several
+ * times faster for the usual precisions. Values that could be rounded differently by the fast path (values
+ * very close to a tie, extreme exponents, very high precisions, infinities and NaNs) are passed on to
+ * sprintf().
+ */
+/**@{*/
+
+/**
+ * @brief The maximal length of a number formatted by these functions with precision and width at most 32
+ * (including the terminating '\0').
+ */
+#define COCO_FORMAT_MAX_LENGTH 48
+
+/**
+ * @brief The exact powers of ten 10^i, i = 0, ..., 16, as integers.
+ */
+static const uint64_t coco_format_integer_powers_of_ten[18] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL};
+
+/**
+ * @brief The powers of ten 10^(16 * i), i = 0, ..., 18, as the sum of two doubles (high and low part).
+ */
+static const double coco_format_powers_of_ten_16[19][2] = {
+    {1.0, 0.0},
+    {1e+16, 0.0},
+    {1e+32, -5366162204393472.0},
+    {1e+48, -4.38458430450762e+31},
+    {1e+64, -2.1320419009454396e+47},
+    {1e+80, -2.6609864708367274e+61},
+    {1e+96, -4.9861653971908895e+79},
+    {1e+112, 6.988006530736956e+95},
+    {1e+128, -7.51744869165182e+111},
+    {1e+144, -2.3745432358651106e+127},
+    {1e+160, -6.528407745068227e+142},
+    {1e+176, -7.44898050207432e+158},
+    {1e+192, -4.09008802087614e+175},
+    {1e+208, 1.8136930169189052e+191},
+    {1e+224, 3.0450964820516807e+207},
+    {1e+240, -1.3946113804119925e+223},
+    {1e+256, -3.012765990014054e+239},
+    {1e+272, -6.552261095746788e+255},
+    {1e+288, -7.6304735395750355e+270}};
+
+/**
+ * @brief Computes the exact product of a and b as the sum of product and error (Dekker's algorithm).
+ */
+static void coco_format_two_product(const double a, const double b, double *product, double *error) {
+  const double split = 134217729.0; /* 2^27 + 1 */
+  double t, a_high, a_low, b_high, b_low;
+
+  *product = a * b;
+  t = split * a;
+  a_high = t - (t - a);
+  a_low = a - a_high;
+  t = split * b;
+  b_high = t - (t - b);
+  b_low = b - b_high;
+  *error = ((a_high * b_high - *product) + a_high * b_low + a_low * b_high) + a_low * b_low;
+}
+
+/**
+ * @brief Computes value * 10^exponent with about 100 correct bits as the sum of high and low.
+ */
+static void coco_format_scale(const double value, const int exponent, double *high, double *low) {
+  const int abs_exponent = (exponent < 0) ? -exponent : exponent;
+  const double *power_16 = coco_format_powers_of_ten_16[abs_exponent / 16];
+  const double power_1 = (double)coco_format_integer_powers_of_ten[abs_exponent % 16];
+  double power_high, power_low, product, error, quotient, remainder;
+
+  /* 10^abs_exponent as power_high + power_low */
+  coco_format_two_product(power_16[0], power_1, &power_high, &error);
+  error += power_16[1] * power_1;
+  product = power_high + error;
+  power_low = error - (product - power_high);
+  power_high = product;
+
+  if (exponent >= 0) {
+    coco_format_two_product(power_high, value, &product, &error);
+    error += power_low * value;
+  } else {
+    quotient = value / power_high;
+    coco_format_two_product(quotient, power_high, &product, &error);
+    remainder = ((value - product) - error) - quotient * power_low;
+    product = quotient;
+    error = remainder / power_high;
+  }
+  *high = product + error;
+  *low = error - (*high - product);
+}
+
+/**
+ * @brief Writes the decimal digits of the unsigned value to buffer (without the terminating '\0').
+ *
+ * @return The number of characters written.
+ */
+static size_t coco_format_digits(char *buffer, uint64_t value) {
+  char digits[20];
+  size_t length = 0, i;
+
+  do {
+    digits[length++] = (char)('0' + (int)(value % 10));
+    value /= 10;
+  } while (value > 0);
+  for (i = 0; i < length; i++)
+    buffer[i] = digits[length - 1 - i];
+  return length;
+}
+
+/**
+ * @brief Writes value to buffer like sprintf(buffer, "%lu", value).
+ *
+ * @return The number of characters written (without the terminating '\0').
+ */
+static size_t coco_format_unsigned_long(char *buffer, const unsigned long value) {
+  size_t length = coco_format_digits(buffer, (uint64_t)value);
+  buffer[length] = '\0';
+  return length;
+}
+
+/**
+ * @brief Writes value to buffer like sprintf(buffer, "%d", value).
+ *
+ * @return The number of characters written (without the terminating '\0').
+ */
+static size_t coco_format_int(char *buffer, const int value) {
+  size_t length = 0;
+  uint64_t abs_value = (uint64_t)value;
+
+  if (value < 0) {
+    buffer[length++] = '-';
+    abs_value = (uint64_t)(-(int64_t)value);
+  }
+  length += coco_format_digits(buffer + length, abs_value);
+  buffer[length] = '\0';
+  return length;
+}
+
+/**
+ * @brief Tries to compute the precision + 1 significant digits and the decimal exponent of the finite,
+ * nonzero value, rounded like printf does.
+ *
+ * @return 1 on success and 0 if the result cannot be guaranteed to match printf.
+ */
+static int coco_format_significant_digits(const double abs_value, const int precision, uint64_t *digits,
+                                          int *exponent) {
+  /* The error of the scaled value is below 1e-12, so this margin decides the rounding safely */
+  const double tie_margin = 1e-9;
+  const int number_of_digits = precision + 1;
+  double high, low, fraction;
+  uint64_t integer_part;
+  int trial;
+
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD != 0)
+  /* The double-double arithmetic needs operations rounded to double precision */
+  return 0;
+#endif
+  if ((number_of_digits > 17) || (abs_value < 1e-270) || (abs_value > 1e270))
+    return 0;
+
+  *exponent = (int)floor(log10(abs_value));
+  for (trial = 0; trial < 3; trial++) {
+    /* Scale abs_value to [10^(number_of_digits - 1), 10^number_of_digits) */
+    coco_format_scale(abs_value, number_of_digits - 1 - *exponent, &high, &low);
+    integer_part = (uint64_t)floor(high);
+    fraction = (high - (double)integer_part) + low;
+    while (fraction < 0) {
+      integer_part--;
+      fraction += 1;
+    }
+    while (fraction >= 1) {
+      integer_part++;
+      fraction -= 1;
+    }
+    if (integer_part < coco_format_integer_powers_of_ten[number_of_digits - 1]) {
+      *exponent -= 1;
+      continue;
+    }
+    if (integer_part >= coco_format_integer_powers_of_ten[number_of_digits]) {
+      *exponent += 1;
+      continue;
+    }
+
+    /* Round to nearest (ties, which need the exact value, are left to printf) */
+    if (fabs(fraction - 0.5) < tie_margin)
+      return 0;
+    if (fraction > 0.5)
+      integer_part++;
+    if (integer_part == coco_format_integer_powers_of_ten[number_of_digits]) {
+      integer_part = coco_format_integer_powers_of_ten[number_of_digits - 1];
+      *exponent += 1;
+    }
+    *digits = integer_part;
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Writes value to buffer like sprintf(buffer, "%+*.*e", width, precision, value) if plus_sign is 1
+ * and like sprintf(buffer, "%*.*e", width, precision, value) otherwise.
+ *
+ * The buffer needs room for at least max(width, precision + 8) + 1 characters.
+ *
+ * @return The number of characters written (without the terminating '\0').
+ */
+static size_t coco_format_exponential(char *buffer, const double value, const int width, const int precision,
+                                      const int plus_sign) {
+  char digit_string[20];
+  uint64_t digits = 0;
+  int exponent = 0, is_negative, abs_exponent, i;
+  size_t length = 0, number_of_characters;
+
+  if (coco_is_nan(value) || coco_is_inf(value) || (precision < 0) ||
+      ((value != 0) && !coco_format_significant_digits(fabs(value), precision, &digits, &exponent))) {
+    return (size_t)sprintf(buffer, plus_sign ? "%+*.*e" : "%*.*e", width, precision, value);
+  }
+
+  /* The sign of zero is taken into account as well */
+  is_negative = (value < 0) || ((value == 0) && (1.0 / value < 0));
+  if (is_negative)
+    digit_string[0] = '-';
+
+  /* Sign, first digit, decimal point, other digits, e, sign of the exponent and its (at least two) digits */
+  abs_exponent = (exponent < 0) ? -exponent : exponent;
+  number_of_characters = (size_t)(is_negative || plus_sign) + 1 + (size_t)(precision > 0) + (size_t)precision +
+                         2 + ((abs_exponent >= 100) ? 3 : 2);
+  for (i = 0; i + (int)number_of_characters < width; i++)
+    buffer[length++] = ' ';
+
+  if (is_negative)
+    buffer[length++] = '-';
+  else if (plus_sign)
+    buffer[length++] = '+';
+  if (value == 0) {
+    buffer[length++] = '0';
+    if (precision > 0)
+      buffer[length++] = '.';
+    for (i = 0; i < precision; i++)
+      buffer[length++] = '0';
+  } else {
+    coco_format_digits(digit_string, digits);
+    buffer[length++] = digit_string[0];
+    if (precision > 0)
+      buffer[length++] = '.';
+    memcpy(buffer + length, digit_string + 1, (size_t)precision);
+    length += (size_t)precision;
+  }
+  buffer[length++] = 'e';
+  buffer[length++] = (exponent < 0) ? '-' : '+';
+  if (abs_exponent >= 100)
+    buffer[length++] = (char)('0' + abs_exponent / 100);
+  buffer[length++] = (char)('0' + (abs_exponent / 10) % 10);
+  buffer[length++] = (char)('0' + abs_exponent % 10);
+  buffer[length] = '\0';
+  return length;
+}
+/**@}*/
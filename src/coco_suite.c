@@ -150,6 +150,56 @@ static coco_problem_t *coco_suite_get_problem_from_indices(coco_suite_t *suite,
   return problem;
 }
 
+/**
+ * @brief Sets the id, name and number of objectives of the problem corresponding to the given suite,
+ * function index, dimension index and instance index without constructing the problem (the strings are
+ * to be freed by the caller).
+ *
+ * Suites whose problems are cheap to construct (like the toy suite) construct the problem instead.
+ *
+ * @note This function needs to be updated when a new suite is added to COCO.
+ */
+static void coco_suite_get_problem_metadata_from_indices(coco_suite_t *suite, const size_t function_idx,
+                                                         const size_t dimension_idx, const size_t instance_idx,
+                                                         char **problem_id, char **problem_name,
+                                                         size_t *number_of_objectives) {
+
+  coco_problem_t *problem;
+
+  *number_of_objectives = 1;
+  if (strcmp(suite->suite_name, "bbob") == 0) {
+    suite_bbob_get_problem_id_and_name(suite, function_idx, dimension_idx, instance_idx, problem_id, problem_name);
+  } else if (strcmp(suite->suite_name, "bbob-boxed") == 0) {
+    suite_sbox_cost_get_problem_id_and_name(suite, function_idx, dimension_idx, instance_idx, problem_id,
+                                            problem_name);
+  } else if ((strcmp(suite->suite_name, "bbob-biobj") == 0) || (strcmp(suite->suite_name, "bbob-biobj-ext") == 0)) {
+    suite_biobj_get_problem_id_and_name(suite, function_idx, dimension_idx, instance_idx, problem_id, problem_name);
+    *number_of_objectives = 2;
+  } else if (strncmp(suite->suite_name, "bbob-constrained", 16) == 0) {
+    suite_cons_bbob_get_problem_id_and_name(suite, function_idx, dimension_idx, instance_idx, problem_id,
+                                            problem_name);
+  } else if (strcmp(suite->suite_name, "bbob-largescale") == 0) {
+    suite_largescale_get_problem_id_and_name(suite, function_idx, dimension_idx, instance_idx, problem_id,
+                                             problem_name);
+  } else if (strcmp(suite->suite_name, "bbob-mixint") == 0) {
+    suite_bbob_mixint_get_problem_id_and_name(suite, function_idx, dimension_idx, instance_idx, problem_id,
+                                              problem_name);
+  } else if (strcmp(suite->suite_name, "bbob-biobj-mixint") == 0) {
+    suite_biobj_mixint_get_problem_id_and_name(suite, function_idx, dimension_idx, instance_idx, problem_id,
+                                               problem_name);
+    *number_of_objectives = 2;
+  } else if (strcmp(suite->suite_name, "bbob-noisy") == 0) {
+    suite_bbob_noisy_get_problem_id_and_name(suite, function_idx, dimension_idx, instance_idx, problem_id,
+                                             problem_name);
+  } else {
+    problem = coco_suite_get_problem_from_indices(suite, function_idx, dimension_idx, instance_idx);
+    *problem_id = coco_strdup(problem->problem_id);
+    *problem_name = coco_strdup(problem->problem_name);
+    *number_of_objectives = problem->number_of_objectives;
+    coco_problem_free(problem);
+  }
+}
+
 /**
  * @brief Saves the best indicator value for the given problem in value.
  */
@@ -248,6 +298,7 @@ static coco_suite_t *coco_suite_allocate(const char *suite_name, const size_t nu
   assert(strlen(default_instances) > 0);
   suite->default_instances = coco_strdup(default_instances);
   suite->known_optima = known_optima;
+  suite->evaluation_cache_size = 0;
 
   /* Will be set to the first valid dimension index before the constructor ends
    */
@@ -468,6 +519,44 @@ coco_problem_t *coco_suite_get_problem(coco_suite_t *suite,
                                              instance_idx);
 }
 
+/**
+ * Computes the metadata of the problem from the function, dimension and instance numbers alone, without
+ * constructing the problem (and its rotation matrices, optima etc.), so that the problems of a whole suite
+ * can be enumerated quickly. The id and name are the same as the ones of the problem returned by
+ * coco_suite_get_problem.
+ *
+ * @param suite The given suite.
+ * @param problem_index The index of the problem.
+ * @param problem_id Pointer to the problem id, which is set by this function (to be freed by the caller
+ * with coco_free_memory).
+ * @param problem_name Pointer to the problem name, which is set by this function (to be freed by the
+ * caller with coco_free_memory).
+ * @param dimension Pointer to the problem dimension, which is set by this function.
+ * @param number_of_objectives Pointer to the number of objectives of the problem, which is set by this
+ * function.
+ *
+ * @return 1 if the problem is contained in the suite and 0 if it has been filtered out from the suite (in
+ * which case the output parameters are not set).
+ */
+int coco_suite_get_problem_metadata(coco_suite_t *suite, const size_t problem_index, char **problem_id,
+                                    char **problem_name, size_t *dimension, size_t *number_of_objectives) {
+
+  size_t function_idx = 0, instance_idx = 0, dimension_idx = 0;
+
+  if (problem_index >= coco_suite_get_number_of_problems(suite))
+    return 0;
+  coco_suite_decode_problem_index(suite, problem_index, &function_idx, &dimension_idx, &instance_idx);
+  if ((suite->functions[function_idx] == 0) || (suite->dimensions[dimension_idx] == 0) ||
+      (suite->instances[instance_idx] == 0)) {
+    return 0;
+  }
+
+  coco_suite_get_problem_metadata_from_indices(suite, function_idx, dimension_idx, instance_idx, problem_id,
+                                               problem_name, number_of_objectives);
+  *dimension = suite->dimensions[dimension_idx];
+  return 1;
+}
+
 /**
  * The number of problems in the suite is computed as a product of the number of
  * instances, number of functions and number of dimensions and therefore doesn't
@@ -677,7 +766,20 @@ static int coco_suite_is_next_dimension_found(coco_suite_t *suite) {
  * - "function_indices: VALUES", where VALUES is a list or a range of function
  * indices (starting from 1) to keep in the suite, and
  * - "instance_indices: VALUES", where VALUES is a list or a range of instance
- * indices (starting from 1) to keep in the suite.
+ * indices (starting from 1) to keep in the suite, and
+ * - "noise_generator: NAME" (only for the "bbob-noisy" suite), where NAME is
+ * "stream" (default, each problem draws its noise from its own random stream)
+ * or "legacy" (reproduces the noise sequence of the legacy code, which all
+ * problems share), and
+ * - "evaluation_cache_size: VALUE" (only for the "bbob-mixint" and
+ * "bbob-biobj-mixint" suites), where VALUE is the number of evaluations in
+ * distinct discretized points that each problem caches (default 0, no cache).
+ * Evaluating a problem again in a cached point returns the cached objective
+ * values without evaluating the underlying continuous problem, and
+ * - "instance_search_threads: VALUE" (only for the bi-objective suites), where
+ * VALUE is the number of threads that search for new instances (instances that
+ * are not precomputed) in parallel (default 1). The found instances do not
+ * depend on the number of threads.
  *
  * @return The constructed suite object.
  */
@@ -690,6 +792,7 @@ coco_suite_t *coco_suite(const char *suite_name, const char *suite_instance,
   char *ptr;
   size_t *indices = NULL;
   size_t *dimensions = NULL;
+  size_t evaluation_cache_size, instance_search_threads;
   long dim_found, dim_idx_found;
   int parce_dim = 1, parce_dim_idx = 1;
 
@@ -697,7 +800,8 @@ coco_suite_t *coco_suite(const char *suite_name, const char *suite_instance,
       *redundant_option_keys;
 
   /* Sets the valid keys for suite options and suite instance */
-  const char *known_keys_o[] = {"dimensions", "dimension_indices", "function_indices", "instance_indices"};
+  const char *known_keys_o[] = {"dimensions", "dimension_indices", "function_indices", "instance_indices",
+                                "noise_generator", "evaluation_cache_size", "instance_search_threads"};
   const char *known_keys_i[] = {"year", "instances"};
 
   /* Initialize the suite */
@@ -820,6 +924,22 @@ coco_suite_t *coco_suite(const char *suite_name, const char *suite_instance,
     }
     coco_free_memory(option_string);
 
+    option_string = coco_allocate_string(COCO_PATH_MAX + 1);
+    if (coco_options_read_string(suite_options, "noise_generator", option_string) > 0) {
+      suite_bbob_noisy_set_noise_generator(suite, option_string);
+    }
+    coco_free_memory(option_string);
+
+    if (coco_options_read_size_t(suite_options, "evaluation_cache_size", &evaluation_cache_size) > 0) {
+      if ((strcmp(suite->suite_name, "bbob-mixint") == 0) || (strcmp(suite->suite_name, "bbob-biobj-mixint") == 0))
+        suite->evaluation_cache_size = evaluation_cache_size;
+      else
+        coco_warning("coco_suite(): suite option 'evaluation_cache_size' ignored for suite %s", suite->suite_name);
+    }
+
+    if (coco_options_read_size_t(suite_options, "instance_search_threads", &instance_search_threads) > 0)
+      suite_biobj_set_instance_search_threads(suite, instance_search_threads);
+
     /* Check for redundant option keys for suite options */
     known_option_keys = coco_option_keys_allocate(
         sizeof(known_keys_o) / sizeof(char *), known_keys_o);
@@ -925,7 +1045,7 @@ coco_problem_t *coco_suite_get_next_problem(coco_suite_t *suite, coco_observer_t
   suite->current_problem = problem;
 
   /* Output information regarding the current place in the iteration */
-  if (coco_log_level >= COCO_INFO) {
+  if (COCO_ATOMIC_LOAD(coco_log_level) >= COCO_INFO) {
     if (((long)dimension_idx != previous_dimension_idx) || (previous_instance_idx < 0)) {
       /* A new dimension started */
       char *time_string = coco_current_time_get_string();
@@ -982,9 +1102,9 @@ void coco_suite_decode_problem_index(const coco_suite_t *suite, const size_t pro
                        suite->number_of_dimensions) -
                           1) {
     coco_warning("coco_suite_decode_problem_index(): problem_index too large");
-    function_idx = 0;
-    instance_idx = 0;
-    dimension_idx = 0;
+    *function_idx = 0;
+    *instance_idx = 0;
+    *dimension_idx = 0;
     return;
   }
 
@@ -992,3 +1112,240 @@ void coco_suite_decode_problem_index(const coco_suite_t *suite, const size_t pro
   *function_idx = (problem_index / suite->number_of_instances) % suite->number_of_functions;
   *dimension_idx = problem_index / (suite->number_of_instances * suite->number_of_functions);
 }
+
+/**
+ * @brief A queue of problem indices owned by one worker of coco_suite_run_experiment().
+ *
+ * The owner takes problems from the front of its queue, other workers that have run out of problems steal
+ * them from the back.
+ */
+typedef struct {
+  coco_mutex_t mutex;      /**< @brief Guards first and last */
+  size_t *problem_indices; /**< @brief The problem indices (owned by the experiment) */
+  size_t first;            /**< @brief Position of the next problem to be taken by the owner */
+  size_t last;             /**< @brief Position after the next problem to be stolen by other workers */
+} coco_suite_work_queue_t;
+
+/**
+ * @brief The state of an experiment run by coco_suite_run_experiment().
+ */
+typedef struct {
+  coco_suite_t *suite;                       /**< @brief The suite whose problems are solved */
+  coco_observer_t *observer;                 /**< @brief The observer (or NULL) */
+  coco_solver_function_t solver;             /**< @brief The solver called on each problem */
+  void *solver_data;                         /**< @brief The data passed to the solver */
+  coco_mutex_t suite_mutex;                  /**< @brief Serializes the construction of problems */
+  coco_suite_work_queue_t *queues;           /**< @brief One queue for each worker */
+  size_t number_of_workers;                  /**< @brief The number of workers */
+} coco_suite_experiment_t;
+
+/**
+ * @brief A worker of an experiment.
+ */
+typedef struct {
+  coco_suite_experiment_t *experiment; /**< @brief The experiment */
+  size_t worker_index;                 /**< @brief The index of the worker (and of its queue) */
+} coco_suite_worker_t;
+
+/**
+ * @brief Takes the next problem index from the worker's own queue or steals one from another queue.
+ *
+ * @return 1 if a problem index was found and 0 if all queues are empty.
+ */
+static int coco_suite_worker_next_problem_index(coco_suite_worker_t *worker, size_t *problem_index) {
+  coco_suite_experiment_t *experiment = worker->experiment;
+  coco_suite_work_queue_t *queue;
+  size_t i;
+  int found = 0;
+
+  queue = &experiment->queues[worker->worker_index];
+  coco_mutex_lock(&queue->mutex);
+  if (queue->first < queue->last) {
+    *problem_index = queue->problem_indices[queue->first++];
+    found = 1;
+  }
+  coco_mutex_unlock(&queue->mutex);
+
+  /* No problems are added while the experiment is running, so one pass over the other queues suffices */
+  for (i = 1; (i < experiment->number_of_workers) && !found; i++) {
+    queue = &experiment->queues[(worker->worker_index + i) % experiment->number_of_workers];
+    coco_mutex_lock(&queue->mutex);
+    if (queue->first < queue->last) {
+      *problem_index = queue->problem_indices[--queue->last];
+      found = 1;
+    }
+    coco_mutex_unlock(&queue->mutex);
+  }
+  return found;
+}
+
+/**
+ * @brief Solves (observed) problems until there are none left.
+ */
+static COCO_THREAD_RETURN_TYPE coco_suite_worker_run(void *argument) {
+  coco_suite_worker_t *worker = (coco_suite_worker_t *)argument;
+  coco_suite_experiment_t *experiment = worker->experiment;
+  coco_problem_t *problem;
+  size_t problem_index, function_idx, dimension_idx, instance_idx;
+
+  while (coco_suite_worker_next_problem_index(worker, &problem_index)) {
+    coco_suite_decode_problem_index(experiment->suite, problem_index, &function_idx, &dimension_idx, &instance_idx);
+
+    /* Some suites initialize their data when the first problem is constructed */
+    coco_mutex_lock(&experiment->suite_mutex);
+    problem = coco_suite_get_problem_from_indices(experiment->suite, function_idx, dimension_idx, instance_idx);
+    if ((problem != NULL) && (experiment->observer != NULL))
+      problem = coco_problem_add_observer(problem, experiment->observer);
+    coco_mutex_unlock(&experiment->suite_mutex);
+    if (problem == NULL)
+      continue;
+
+    coco_debug("coco_suite_run_experiment(): worker %lu solves problem %s", (unsigned long)worker->worker_index,
+               coco_problem_get_id(problem));
+    experiment->solver(problem, experiment->solver_data);
+    coco_problem_free(problem);
+  }
+  return COCO_THREAD_RETURN_VALUE;
+}
+
+/**
+ * Solves all problems of the suite with the given solver, using number_of_threads threads that work on
+ * different problems at the same time. The problems are handed out starting with the largest dimension, so
+ * that the most expensive problems do not end up last. Each thread takes the problems from its own queue
+ * and, once it is empty, steals problems from the queues of the other threads.
+ *
+ * The observer needs to be able to observe several problems at the same time (like the bbob observer with
+ * the option "thread_safe: 1"). Each observed problem then gets its own logger output in the usual layout of
+ * the result folder. If the observer does not allow this, the problems are solved by one thread only.
+ *
+ * The solver is called from several threads and must therefore not modify any state shared with other
+ * calls without synchronization. The problems are freed after the solver returns.
+ *
+ * @param suite The suite, whose problems are solved (the iteration through coco_suite_get_next_problem()
+ * is not affected).
+ * @param observer The observer (can be NULL).
+ * @param solver The solver called on each problem.
+ * @param solver_data Additional data passed to each call of the solver.
+ * @param number_of_threads The number of threads to use (0 is treated as 1).
+ */
+void coco_suite_run_experiment(coco_suite_t *suite, coco_observer_t *observer, coco_solver_function_t solver,
+                               void *solver_data, const size_t number_of_threads) {
+
+  coco_suite_experiment_t experiment;
+  coco_suite_worker_t *workers;
+  coco_thread_t *threads;
+  int *is_thread_started;
+  size_t *problem_indices;
+  size_t number_of_problems, number_of_workers, problem_position, worker_index, i;
+  size_t function_idx, dimension_idx, instance_idx;
+  size_t *dimension_order, tmp;
+
+  assert(suite != NULL);
+  assert(solver != NULL);
+
+  number_of_workers = (number_of_threads == 0) ? 1 : number_of_threads;
+  if ((number_of_workers > 1) && (observer != NULL) && (observer->is_active) && !observer->is_thread_safe) {
+    coco_warning("coco_suite_run_experiment(): The %s observer cannot observe several problems at the same "
+                 "time, running on one thread only", observer->observer_name);
+    number_of_workers = 1;
+  }
+
+  /* Order the dimensions by decreasing size */
+  dimension_order = coco_allocate_vector_size_t(suite->number_of_dimensions);
+  for (i = 0; i < suite->number_of_dimensions; i++)
+    dimension_order[i] = i;
+  for (i = 1; i < suite->number_of_dimensions; i++) {
+    for (dimension_idx = i; (dimension_idx > 0) && (suite->dimensions[dimension_order[dimension_idx - 1]] <
+                                                    suite->dimensions[dimension_order[dimension_idx]]);
+         dimension_idx--) {
+      tmp = dimension_order[dimension_idx];
+      dimension_order[dimension_idx] = dimension_order[dimension_idx - 1];
+      dimension_order[dimension_idx - 1] = tmp;
+    }
+  }
+
+  /* Deal the problems round-robin to the workers, so that each starts with one of the costliest problems */
+  number_of_problems = coco_suite_get_number_of_problems(suite);
+  problem_indices = coco_allocate_vector_size_t(number_of_problems);
+  experiment.queues = (coco_suite_work_queue_t *)coco_allocate_memory(number_of_workers *
+                                                                      sizeof(coco_suite_work_queue_t));
+  for (worker_index = 0; worker_index < number_of_workers; worker_index++) {
+    coco_mutex_init(&experiment.queues[worker_index].mutex);
+    experiment.queues[worker_index].first = 0;
+    experiment.queues[worker_index].last = 0;
+  }
+  /* First count the problems of each worker to find the start of each queue */
+  problem_position = 0;
+  for (i = 0; i < suite->number_of_dimensions; i++) {
+    for (function_idx = 0; function_idx < suite->number_of_functions; function_idx++) {
+      for (instance_idx = 0; instance_idx < suite->number_of_instances; instance_idx++) {
+        if ((suite->dimensions[dimension_order[i]] == 0) || (suite->functions[function_idx] == 0) ||
+            (suite->instances[instance_idx] == 0))
+          continue;
+        experiment.queues[problem_position % number_of_workers].last++;
+        problem_position++;
+      }
+    }
+  }
+  for (worker_index = 1; worker_index < number_of_workers; worker_index++) {
+    experiment.queues[worker_index].first = experiment.queues[worker_index - 1].first +
+                                            experiment.queues[worker_index - 1].last;
+  }
+  for (worker_index = 0; worker_index < number_of_workers; worker_index++) {
+    experiment.queues[worker_index].problem_indices = problem_indices + experiment.queues[worker_index].first;
+    experiment.queues[worker_index].first = 0;
+  }
+  problem_position = 0;
+  for (i = 0; i < suite->number_of_dimensions; i++) {
+    for (function_idx = 0; function_idx < suite->number_of_functions; function_idx++) {
+      for (instance_idx = 0; instance_idx < suite->number_of_instances; instance_idx++) {
+        if ((suite->dimensions[dimension_order[i]] == 0) || (suite->functions[function_idx] == 0) ||
+            (suite->instances[instance_idx] == 0))
+          continue;
+        worker_index = problem_position % number_of_workers;
+        experiment.queues[worker_index].problem_indices[problem_position / number_of_workers] =
+            coco_suite_encode_problem_index(suite, function_idx, dimension_order[i], instance_idx);
+        problem_position++;
+      }
+    }
+  }
+  coco_free_memory(dimension_order);
+
+  experiment.suite = suite;
+  experiment.observer = observer;
+  experiment.solver = solver;
+  experiment.solver_data = solver_data;
+  experiment.number_of_workers = number_of_workers;
+  coco_mutex_init(&experiment.suite_mutex);
+
+  /* Worker 0 runs in the calling thread, the others in new threads */
+  workers = (coco_suite_worker_t *)coco_allocate_memory(number_of_workers * sizeof(coco_suite_worker_t));
+  threads = (coco_thread_t *)coco_allocate_memory(number_of_workers * sizeof(coco_thread_t));
+  is_thread_started = (int *)coco_allocate_memory(number_of_workers * sizeof(int));
+  for (worker_index = 0; worker_index < number_of_workers; worker_index++) {
+    workers[worker_index].experiment = &experiment;
+    workers[worker_index].worker_index = worker_index;
+    is_thread_started[worker_index] = 0;
+  }
+  for (worker_index = 1; worker_index < number_of_workers; worker_index++) {
+    /* The problems of a worker whose thread cannot be started are stolen by the other workers */
+    is_thread_started[worker_index] = coco_thread_create(&threads[worker_index], coco_suite_worker_run,
+                                                         &workers[worker_index]);
+    if (!is_thread_started[worker_index])
+      coco_warning("coco_suite_run_experiment(): Could not start thread %lu", (unsigned long)worker_index);
+  }
+  coco_suite_worker_run(&workers[0]);
+  for (worker_index = 1; worker_index < number_of_workers; worker_index++) {
+    if (is_thread_started[worker_index])
+      coco_thread_join(threads[worker_index]);
+  }
+
+  for (worker_index = 0; worker_index < number_of_workers; worker_index++)
+    coco_mutex_destroy(&experiment.queues[worker_index].mutex);
+  coco_mutex_destroy(&experiment.suite_mutex);
+  coco_free_memory(is_thread_started);
+  coco_free_memory(threads);
+  coco_free_memory(workers);
+  coco_free_memory(experiment.queues);
+  coco_free_memory(problem_indices);
+}
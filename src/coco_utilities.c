@@ -29,6 +29,8 @@ static const double chosen_precision = 1e-9;
 
 /**
  * @brief Initializes the logging level to COCO_INFO.
+ *
+ * Always accessed through COCO_ATOMIC_LOAD and COCO_ATOMIC_STORE, since it is read by all threads.
  */
 static coco_log_level_type_e coco_log_level = COCO_INFO;
 
@@ -46,16 +48,16 @@ static coco_log_level_type_e coco_log_level = COCO_INFO;
  */
 const char *coco_set_log_level(const char *log_level) {
 
-  coco_log_level_type_e previous_log_level = coco_log_level;
+  coco_log_level_type_e previous_log_level = COCO_ATOMIC_LOAD(coco_log_level);
 
   if (strcmp(log_level, "error") == 0)
-    coco_log_level = COCO_ERROR;
+    COCO_ATOMIC_STORE(coco_log_level, COCO_ERROR);
   else if (strcmp(log_level, "warning") == 0)
-    coco_log_level = COCO_WARNING;
+    COCO_ATOMIC_STORE(coco_log_level, COCO_WARNING);
   else if (strcmp(log_level, "info") == 0)
-    coco_log_level = COCO_INFO;
+    COCO_ATOMIC_STORE(coco_log_level, COCO_INFO);
   else if (strcmp(log_level, "debug") == 0)
-    coco_log_level = COCO_DEBUG;
+    COCO_ATOMIC_STORE(coco_log_level, COCO_DEBUG);
   else if (strcmp(log_level, "") == 0) {
     /* Do nothing */
   } else {
@@ -999,11 +1001,28 @@ static int coco_is_nan(const double x) {
           ((x >= NAN / (1 + chosen_precision)) && (x <= NAN * (1 + chosen_precision))));
 }
 
+/**
+ * @brief Returns 1 if the input vector of dimension dim contains no NaN of inf values, and 0 otherwise.
+ *
+ * Instead of testing each value with coco_is_nan() and coco_is_inf(), the products of the values with zero
+ * are summed up, which gives NAN if (and only if) any of the values is NAN or INFINITY.
+ */
+static int coco_vector_isfinite(const double *x, const size_t dim) {
+  double check = 0.0;
+  size_t i;
+  for (i = 0; i < dim; i++) {
+    check += x[i] * 0.0;
+  }
+  return check == check;
+}
+
 /**
  * @brief Returns 1 if the input vector of dimension dim contains any NAN values and 0 otherwise.
  */
 static int coco_vector_contains_nan(const double *x, const size_t dim) {
   size_t i;
+  if (COCO_LIKELY(coco_vector_isfinite(x, dim)))
+    return 0;
   for (i = 0; i < dim; i++) {
     if (COCO_UNLIKELY(coco_is_nan(x[i])))
       return 1;
@@ -1041,15 +1060,32 @@ static void coco_vector_set_to_inf(double *y, const size_t dim) {
 }
 
 /**
- * @brief Returns 1 if the input vector of dimension dim contains no NaN of inf values, and 0 otherwise.
+ * @brief Evaluates the constraints of the problem in x like problem->evaluate_constraint(), but reuses the
+ * constraint values of the last evaluation if the problem keeps them (see coco_is_feasible()).
+ *
+ * The stored values are returned only if x equals the last evaluated decision vector bit by bit and the
+ * counters are not to be updated, so that the counters of constraint evaluations of the problem and of the
+ * problems it wraps are increased exactly as without the memo.
  */
-static int coco_vector_isfinite(const double *x, const size_t dim) {
-  size_t i;
-  for (i = 0; i < dim; i++) {
-    if (COCO_UNLIKELY(coco_is_nan(x[i])) || COCO_UNLIKELY(coco_is_inf(x[i])))
-      return 0;
+static void coco_evaluate_constraint_memoized(coco_problem_t *problem, const double *x, double *constraint_values,
+                                              const int update_counter) {
+  const size_t number_of_variables = problem->number_of_variables;
+  const size_t number_of_constraints = problem->number_of_constraints;
+
+  if (problem->constraint_memo == NULL) {
+    problem->evaluate_constraint(problem, x, constraint_values, update_counter);
+    return;
   }
-  return 1;
+  if (!update_counter && problem->is_constraint_memo_set &&
+      (memcmp(problem->constraint_memo, x, number_of_variables * sizeof(double)) == 0)) {
+    memcpy(constraint_values, problem->constraint_memo + number_of_variables, number_of_constraints * sizeof(double));
+    return;
+  }
+
+  problem->evaluate_constraint(problem, x, constraint_values, update_counter);
+  memcpy(problem->constraint_memo, x, number_of_variables * sizeof(double));
+  memcpy(problem->constraint_memo + number_of_variables, constraint_values, number_of_constraints * sizeof(double));
+  problem->is_constraint_memo_set = 1;
 }
 
 /**
@@ -1066,7 +1102,8 @@ static int coco_vector_isfinite(const double *x, const size_t dim) {
  *
  * @param problem The given COCO problem.
  * @param x Decision vector.
- * @param constraint_values Vector of contraints values resulting from evaluation.
+ * @param constraint_values Vector of contraints values resulting from evaluation (if NULL, the values are
+ * stored in the scratch memory of the problem).
  */
 static int coco_is_feasible(coco_problem_t *problem, const double *x, double *constraint_values) {
 
@@ -1084,10 +1121,17 @@ static int coco_is_feasible(coco_problem_t *problem, const double *x, double *co
   assert(problem != NULL);
   assert(problem->evaluate_constraint != NULL);
 
-  if (constraint_values == NULL)
-    cons_values = coco_allocate_vector(problem->number_of_constraints);
+  if (constraint_values == NULL) {
+    assert(problem->scratch_size >= problem->number_of_constraints);
+    cons_values = problem->scratch;
+  }
 
-  problem->evaluate_constraint(problem, x, cons_values, 0);
+  /* The feasibility of a solution is checked by several layers of a problem during one evaluation, so the
+   * constraint values of the last solution are kept */
+  if (problem->constraint_memo == NULL)
+    problem->constraint_memo =
+        coco_allocate_vector(coco_problem_get_dimension(problem) + coco_problem_get_number_of_constraints(problem));
+  coco_evaluate_constraint_memoized(problem, x, cons_values, 0);
 
   for (i = 0; i < coco_problem_get_number_of_constraints(problem); ++i) {
     if (cons_values[i] > 0.0) {
@@ -1096,8 +1140,6 @@ static int coco_is_feasible(coco_problem_t *problem, const double *x, double *co
     }
   }
 
-  if (constraint_values == NULL)
-    coco_free_memory(cons_values);
   return ret_val;
 }
 
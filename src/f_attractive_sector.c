@@ -60,6 +60,22 @@ static void f_attractive_sector_evaluate(coco_problem_t *problem,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the attractive sector function.
+ */
+static void f_attractive_sector_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  f_attractive_sector_data_t *data = (f_attractive_sector_data_t *)problem->data;
+  size_t i;
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    if (data->xopt[i] * x[i] > 0.0) {
+      y[i] = 2.0 * 100.0 * 100.0 * x[i];
+    } else {
+      y[i] = 2.0 * x[i];
+    }
+  }
+}
+
 /**
  * @brief Frees the attractive sector data object.
  */
@@ -88,6 +104,7 @@ f_attractive_sector_allocate(const size_t number_of_variables,
   data = (f_attractive_sector_data_t *)coco_allocate_memory(sizeof(*data));
   data->xopt = coco_duplicate_vector(xopt, number_of_variables);
   problem->data = data;
+  problem->evaluate_gradient = f_attractive_sector_evaluate_gradient;
 
   /* Compute best solution */
   f_attractive_sector_evaluate(problem, problem->best_parameter,
@@ -104,10 +121,9 @@ static coco_problem_t *f_attractive_sector_bbob_problem_allocate(const size_t fu
                                                                  const char *problem_name_template) {
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
-  size_t i, j, k;
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
-  double *current_row, **rot1, **rot2;
+  double **rot1, **rot2;
 
   xopt = coco_allocate_vector(dimension);
   fopt = bbob2009_compute_fopt(function, instance);
@@ -122,17 +138,7 @@ static coco_problem_t *f_attractive_sector_bbob_problem_allocate(const size_t fu
   rot2 = bbob2009_allocate_matrix(dimension, dimension);
   bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
   bbob2009_compute_rotation(rot2, rseed, dimension);
-  for (i = 0; i < dimension; ++i) {
-    b[i] = 0.0;
-    current_row = M + i * dimension;
-    for (j = 0; j < dimension; ++j) {
-      current_row[j] = 0.0;
-      for (k = 0; k < dimension; ++k) {
-        double exponent = 1.0 * (int)k / ((double)(long)dimension - 1.0);
-        current_row[j] += rot1[i][k] * pow(sqrt(10.0), exponent) * rot2[k][j];
-      }
-    }
-  }
+  bbob2009_compute_scaled_rotation_product(M, b, rot1, sqrt(10.0), rot2, dimension);
   bbob2009_free_matrix(rot1, dimension);
   bbob2009_free_matrix(rot2, dimension);
 
@@ -163,11 +169,9 @@ static coco_problem_t *f_attractive_sector_permblockdiag_bbob_problem_allocate(c
 
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
-  double **B1, **B2;
-  const double *const *B1_copy;
-  const double *const *B2_copy;
+  const double *const *B1, *const *B2;
   const double condition = 10.0;
-  size_t *P11, *P12, *P21, *P22;
+  const size_t *P11, *P12, *P21, *P22;
   size_t *block_sizes1, *block_sizes2; /* each of R and Q might have its own parameter values */
   size_t nb_blocks1, nb_blocks2;
   size_t swap_range1, swap_range2;
@@ -190,27 +194,13 @@ static coco_problem_t *f_attractive_sector_permblockdiag_bbob_problem_allocate(c
   nb_swaps1 = coco_get_nb_swaps(dimension, "bbob-largescale");
   nb_swaps2 = coco_get_nb_swaps(dimension, "bbob-largescale");
 
-  B1 = coco_allocate_blockmatrix(dimension, block_sizes1, nb_blocks1);
-  B2 = coco_allocate_blockmatrix(dimension, block_sizes2, nb_blocks2);
-  B1_copy = (const double *const *)
-      B1; /* Wassim: silences the warning, not sure it prevents the modification of B at all levels*/
-  B2_copy = (const double *const *)B2;
-  coco_compute_blockrotation(B1, rseed + 1000000, dimension, block_sizes1,
-                             nb_blocks1);
-  coco_compute_blockrotation(B2, rseed, dimension, block_sizes2, nb_blocks2);
-
-  P11 = coco_allocate_vector_size_t(dimension);
-  P12 = coco_allocate_vector_size_t(dimension);
-  P21 = coco_allocate_vector_size_t(dimension);
-  P22 = coco_allocate_vector_size_t(dimension);
-  coco_compute_truncated_uniform_swap_permutation(
-      P11, rseed + 2000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(
-      P12, rseed + 3000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(
-      P21, rseed + 4000000, dimension, nb_swaps2, swap_range2);
-  coco_compute_truncated_uniform_swap_permutation(
-      P22, rseed + 5000000, dimension, nb_swaps2, swap_range2);
+  B1 = coco_cache_get_blockrotation(rseed + 1000000, dimension, block_sizes1, nb_blocks1);
+  B2 = coco_cache_get_blockrotation(rseed, dimension, block_sizes2, nb_blocks2);
+
+  P11 = coco_cache_get_permutation(rseed + 2000000, dimension, nb_swaps1, swap_range1);
+  P12 = coco_cache_get_permutation(rseed + 3000000, dimension, nb_swaps1, swap_range1);
+  P21 = coco_cache_get_permutation(rseed + 4000000, dimension, nb_swaps2, swap_range2);
+  P22 = coco_cache_get_permutation(rseed + 5000000, dimension, nb_swaps2, swap_range2);
 
   problem = f_attractive_sector_allocate(dimension, xopt);
   problem = transform_obj_norm_by_dim(problem);
@@ -219,12 +209,12 @@ static coco_problem_t *f_attractive_sector_permblockdiag_bbob_problem_allocate(c
   problem = transform_obj_shift(problem, fopt);
 
   problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B1, dimension,
                                          block_sizes1, nb_blocks1);
   problem = transform_vars_permutation(problem, P21, dimension);
   problem = transform_vars_conditioning(problem, condition);
   problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B2, dimension,
                                          block_sizes2, nb_blocks2);
   problem = transform_vars_permutation(problem, P11, dimension);
   problem = transform_vars_shift(problem, xopt, 0);
@@ -233,12 +223,12 @@ static coco_problem_t *f_attractive_sector_permblockdiag_bbob_problem_allocate(c
   coco_problem_set_name(problem, problem_name_template, function, instance, dimension);
   coco_problem_set_type(problem, "2-moderate");
 
-  coco_free_block_matrix(B1, dimension);
-  coco_free_block_matrix(B2, dimension);
-  coco_free_memory(P11);
-  coco_free_memory(P12);
-  coco_free_memory(P21);
-  coco_free_memory(P22);
+  coco_cache_release(B1);
+  coco_cache_release(B2);
+  coco_cache_release(P11);
+  coco_cache_release(P12);
+  coco_cache_release(P21);
+  coco_cache_release(P22);
   coco_free_memory(block_sizes1);
   coco_free_memory(block_sizes2);
   coco_free_memory(xopt);
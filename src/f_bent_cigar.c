@@ -85,9 +85,8 @@ static coco_problem_t *f_bent_cigar_bbob_problem_allocate(const size_t function,
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
 
-  double *M = coco_allocate_vector(dimension * dimension);
-  double *b = coco_allocate_vector(dimension);
-  double **rot1;
+  const double *M;
+  double *b = coco_allocate_vector_with_value(dimension, 0.0);
 
   xopt = coco_allocate_vector(dimension);
   fopt = bbob2009_compute_fopt(function, instance);
@@ -97,10 +96,7 @@ static coco_problem_t *f_bent_cigar_bbob_problem_allocate(const size_t function,
     bbob2009_compute_xopt(xopt, rseed + 1000000, dimension);
   }
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
-  bbob2009_copy_rotation_matrix(rot1, M, b, dimension);
-  bbob2009_free_matrix(rot1, dimension);
+  M = coco_cache_get_rotation(rseed + 1000000, dimension);
 
   problem = f_bent_cigar_allocate(dimension);
   problem = transform_obj_shift(problem, fopt);
@@ -115,7 +111,7 @@ static coco_problem_t *f_bent_cigar_bbob_problem_allocate(const size_t function,
                         dimension);
   coco_problem_set_type(problem, "3-ill-conditioned");
 
-  coco_free_memory(M);
+  coco_cache_release(M);
   coco_free_memory(b);
   coco_free_memory(xopt);
   return problem;
@@ -132,9 +128,8 @@ static coco_problem_t *f_bent_cigar_cons_bbob_problem_allocate(const size_t func
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
 
-  double *M = coco_allocate_vector(dimension * dimension);
-  double *b = coco_allocate_vector(dimension);
-  double **rot1;
+  const double *M;
+  double *b = coco_allocate_vector_with_value(dimension, 0.0);
 
   xopt = coco_allocate_vector(dimension);
   fopt = bbob2009_compute_fopt(function, instance);
@@ -144,10 +139,7 @@ static coco_problem_t *f_bent_cigar_cons_bbob_problem_allocate(const size_t func
     bbob2009_compute_xopt(xopt, rseed + 1000000, dimension);
   }
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
-  bbob2009_copy_rotation_matrix(rot1, M, b, dimension);
-  bbob2009_free_matrix(rot1, dimension);
+  M = coco_cache_get_rotation(rseed + 1000000, dimension);
 
   problem = f_bent_cigar_allocate(dimension);
   problem = transform_obj_shift(problem, fopt);
@@ -158,7 +150,7 @@ static coco_problem_t *f_bent_cigar_cons_bbob_problem_allocate(const size_t func
   coco_problem_set_name(problem, problem_name_template, function, instance, dimension);
   coco_problem_set_type(problem, "3-ill-conditioned");
 
-  coco_free_memory(M);
+  coco_cache_release(M);
   coco_free_memory(b);
   coco_free_memory(xopt);
   return problem;
@@ -78,6 +78,24 @@ static void f_bent_cigar_generalized_evaluate(coco_problem_t *problem,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the generalized bent cigar function.
+ */
+static void f_bent_cigar_generalized_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  static const double condition = 1.0e6;
+  f_bent_cigar_generalized_versatile_data_t *versatile_data =
+      (f_bent_cigar_generalized_versatile_data_t *)problem->versatile_data;
+  size_t i, nb_long_axes;
+
+  nb_long_axes = problem->number_of_variables / versatile_data->proportion_long_axes_denom;
+  if (problem->number_of_variables % versatile_data->proportion_long_axes_denom != 0) {
+    nb_long_axes += 1;
+  }
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] = (i < nb_long_axes) ? 2.0 * x[i] : 2.0 * condition * x[i];
+  }
+}
+
 /**
  * @brief Allocates the basic generalized bent cigar problem.
  */
@@ -88,6 +106,7 @@ static coco_problem_t *f_bent_cigar_generalized_allocate(const size_t number_of_
       "generalized bent cigar function", f_bent_cigar_generalized_evaluate,
       f_bent_cigar_generalized_versatile_data_free, number_of_variables, -5.0, 5.0, 0.0);
   coco_problem_set_id(problem, "%s_d%04lu", "bent_cigar", number_of_variables);
+  problem->evaluate_gradient = f_bent_cigar_generalized_evaluate_gradient;
   problem->versatile_data = (f_bent_cigar_generalized_versatile_data_t *)coco_allocate_memory(
       sizeof(f_bent_cigar_generalized_versatile_data_t));
   ((f_bent_cigar_generalized_versatile_data_t *)problem->versatile_data)->proportion_long_axes_denom =
@@ -108,10 +127,9 @@ static coco_problem_t *f_bent_cigar_generalized_permblockdiag_bbob_problem_alloc
     const char *problem_id_template, const char *problem_name_template) {
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
-  double **B;
-  const double *const *B_copy;
-  size_t *P1 = coco_allocate_vector_size_t(dimension);
-  size_t *P2 = coco_allocate_vector_size_t(dimension);
+  const double *const *B;
+  const size_t *P1;
+  const size_t *P2;
   size_t *block_sizes;
   size_t nb_blocks;
   size_t swap_range;
@@ -130,25 +148,19 @@ static coco_problem_t *f_bent_cigar_generalized_permblockdiag_bbob_problem_alloc
   }
   fopt = bbob2009_compute_fopt(function, instance);
 
-  B = coco_allocate_blockmatrix(dimension, block_sizes, nb_blocks);
-  B_copy = (const double *const *)B;
-
-  coco_compute_blockrotation(B, rseed + 1000000, dimension, block_sizes,
-                             nb_blocks);
-  coco_compute_truncated_uniform_swap_permutation(
-      P1, rseed + 2000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(
-      P2, rseed + 3000000, dimension, nb_swaps, swap_range);
+  B = coco_cache_get_blockrotation(rseed + 1000000, dimension, block_sizes, nb_blocks);
+  P1 = coco_cache_get_permutation(rseed + 2000000, dimension, nb_swaps, swap_range);
+  P2 = coco_cache_get_permutation(rseed + 3000000, dimension, nb_swaps, swap_range);
 
   problem =
       f_bent_cigar_generalized_allocate(dimension, proportion_long_axes_denom);
   problem = transform_vars_permutation(problem, P2, dimension);
-  problem = transform_vars_blockrotation(problem, B_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B, dimension,
                                          block_sizes, nb_blocks);
   problem = transform_vars_permutation(problem, P1, dimension);
   problem = transform_vars_asymmetric(problem, 0.5);
   problem = transform_vars_permutation(problem, P2, dimension);
-  problem = transform_vars_blockrotation(problem, B_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B, dimension,
                                          block_sizes, nb_blocks);
   problem = transform_vars_permutation(problem, P1, dimension);
   problem = transform_vars_shift(problem, xopt, 0);
@@ -161,9 +173,9 @@ static coco_problem_t *f_bent_cigar_generalized_permblockdiag_bbob_problem_alloc
   coco_problem_set_name(problem, problem_name_template, function, instance,
                         dimension);
   coco_problem_set_type(problem, "3-ill-conditioned");
-  coco_free_block_matrix(B, dimension);
-  coco_free_memory(P1);
-  coco_free_memory(P2);
+  coco_cache_release(B);
+  coco_cache_release(P1);
+  coco_cache_release(P2);
   coco_free_memory(block_sizes);
   coco_free_memory(xopt);
   return problem;
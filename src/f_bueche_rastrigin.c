@@ -8,6 +8,7 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_simd.c"
 #include "suite_bbob_legacy_code.c"
 #include "transform_obj_norm_by_dim.c"
 #include "transform_obj_penalize.c"
@@ -30,9 +31,11 @@ static double f_bueche_rastrigin_raw(const double *x,
     return NAN;
   }
 
-  for (i = 0; i < number_of_variables; ++i) {
-    tmp += cos(2 * coco_pi * x[i]);
-    tmp2 += x[i] * x[i];
+  if (!COCO_SIMD_RUN(coco_simd_sum_cos_two_pi, (x, number_of_variables, &tmp, &tmp2))) {
+    for (i = 0; i < number_of_variables; ++i) {
+      tmp += cos(2 * coco_pi * x[i]);
+      tmp2 += x[i] * x[i];
+    }
   }
   result = 10.0 * ((double)(long)number_of_variables - tmp) + tmp2 + 0;
   return result;
@@ -48,6 +51,17 @@ static void f_bueche_rastrigin_evaluate(coco_problem_t *problem,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the raw Bueche-Rastrigin function.
+ */
+static void f_bueche_rastrigin_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] = 2.0 * (10. * coco_pi * sin(2 * coco_pi * x[i]) + x[i]);
+  }
+}
+
 /**
  * @brief Allocates the basic Bueche-Rastrigin problem.
  */
@@ -57,6 +71,7 @@ f_bueche_rastrigin_allocate(const size_t number_of_variables) {
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Bueche-Rastrigin function", f_bueche_rastrigin_evaluate,
                                                                NULL, number_of_variables, -5.0, 5.0, 0.0);
   coco_problem_set_id(problem, "%s_d%02lu", "bueche-rastrigin", number_of_variables);
+  problem->evaluate_gradient = f_bueche_rastrigin_evaluate_gradient;
 
   /* Compute best solution */
   f_bueche_rastrigin_evaluate(problem, problem->best_parameter,
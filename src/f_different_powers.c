@@ -76,6 +76,32 @@ static void f_different_powers_evaluate_gradient(coco_problem_t *problem,
     sum += pow(fabs(x[i]), aux);
   }
 
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    aux = 2.0 + (4.0 * (double)(long)i) / ((double)(long)problem->number_of_variables - 1.0);
+    y[i] = 0.5 * (aux) / sqrt(sum);
+    aux -= 1.0;
+    y[i] *= pow(fabs(x[i]), aux) * sign(x[i]);
+  }
+}
+
+/**
+ * @brief Evaluates the gradient of the function "different powers" scaled by sqrt(f(x)).
+ *
+ * The bbob-constrained problems derive their feasible direction from this (former) gradient, which is kept
+ * so that the problems remain the same to the last bit.
+ */
+static void f_different_powers_evaluate_scaled_gradient(coco_problem_t *problem,
+                                                        const double *x, double *y) {
+
+  size_t i;
+  double sum = 0.0;
+  double aux;
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    aux = 2.0 + (4.0 * (double)(long)i) / ((double)(long)problem->number_of_variables - 1.0);
+    sum += pow(fabs(x[i]), aux);
+  }
+
   for (i = 0; i < problem->number_of_variables; ++i) {
     aux = 2.0 + (4.0 * (double)(long)i) / ((double)(long)problem->number_of_variables - 1.0);
     y[i] = 0.5 * (aux) / (sum);
@@ -113,9 +139,8 @@ static coco_problem_t *f_different_powers_bbob_problem_allocate(const size_t fun
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
 
-  double *M = coco_allocate_vector(dimension * dimension);
-  double *b = coco_allocate_vector(dimension);
-  double **rot1;
+  const double *M;
+  double *b = coco_allocate_vector_with_value(dimension, 0.0);
 
   xopt = coco_allocate_vector(dimension);
   fopt = bbob2009_compute_fopt(function, instance);
@@ -125,10 +150,7 @@ static coco_problem_t *f_different_powers_bbob_problem_allocate(const size_t fun
     bbob2009_compute_xopt(xopt, rseed, dimension);
   }
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
-  bbob2009_copy_rotation_matrix(rot1, M, b, dimension);
-  bbob2009_free_matrix(rot1, dimension);
+  M = coco_cache_get_rotation(rseed + 1000000, dimension);
 
   problem = f_different_powers_allocate(dimension);
   problem = transform_obj_shift(problem, fopt);
@@ -141,7 +163,7 @@ static coco_problem_t *f_different_powers_bbob_problem_allocate(const size_t fun
                         dimension);
   coco_problem_set_type(problem, "3-ill-conditioned");
 
-  coco_free_memory(M);
+  coco_cache_release(M);
   coco_free_memory(b);
   coco_free_memory(xopt);
   return problem;
@@ -166,9 +188,8 @@ static coco_problem_t *f_different_powers_bbob_constrained_problem_allocate(cons
   double *xopt, fopt, result;
   coco_problem_t *problem = NULL;
 
-  double *M = coco_allocate_vector(dimension * dimension);
-  double *b = coco_allocate_vector(dimension);
-  double **rot1;
+  const double *M;
+  double *b = coco_allocate_vector_with_value(dimension, 0.0);
 
   xopt = coco_allocate_vector(dimension);
   fopt = bbob2009_compute_fopt(function, instance);
@@ -191,12 +212,10 @@ static coco_problem_t *f_different_powers_bbob_constrained_problem_allocate(cons
     xopt[i] *= 1e-2 / result;
   }
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
-  bbob2009_copy_rotation_matrix(rot1, M, b, dimension);
-  bbob2009_free_matrix(rot1, dimension);
+  M = coco_cache_get_rotation(rseed + 1000000, dimension);
 
   problem = f_different_powers_allocate(dimension);
+  problem->evaluate_gradient = f_different_powers_evaluate_scaled_gradient;
   problem = transform_obj_shift(problem, fopt);
   problem = transform_vars_affine(problem, M, b, dimension);
   problem = transform_vars_shift(problem, xopt, 0);
@@ -207,7 +226,7 @@ static coco_problem_t *f_different_powers_bbob_constrained_problem_allocate(cons
                         dimension);
   coco_problem_set_type(problem, "3-ill-conditioned");
 
-  coco_free_memory(M);
+  coco_cache_release(M);
   coco_free_memory(b);
   coco_free_memory(xopt);
   return problem;
@@ -225,11 +244,10 @@ static coco_problem_t *f_different_powers_permblockdiag_bbob_problem_allocate(co
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
 
-  double **B;
-  const double *const *B_copy;
+  const double *const *B;
 
-  size_t *P1 = coco_allocate_vector_size_t(dimension);
-  size_t *P2 = coco_allocate_vector_size_t(dimension);
+  const size_t *P1;
+  const size_t *P2;
 
   size_t *block_sizes;
   size_t nb_blocks;
@@ -248,19 +266,14 @@ static coco_problem_t *f_different_powers_permblockdiag_bbob_problem_allocate(co
     bbob2009_compute_xopt(xopt, rseed, dimension);
   }
 
-  B = coco_allocate_blockmatrix(dimension, block_sizes, nb_blocks);
-  B_copy = (const double *const *)B;
-  coco_compute_blockrotation(B, rseed + 1000000, dimension, block_sizes,
-                             nb_blocks);
+  B = coco_cache_get_blockrotation(rseed + 1000000, dimension, block_sizes, nb_blocks);
 
-  coco_compute_truncated_uniform_swap_permutation(
-      P1, rseed + 2000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(
-      P2, rseed + 3000000, dimension, nb_swaps, swap_range);
+  P1 = coco_cache_get_permutation(rseed + 2000000, dimension, nb_swaps, swap_range);
+  P2 = coco_cache_get_permutation(rseed + 3000000, dimension, nb_swaps, swap_range);
 
   problem = f_different_powers_allocate(dimension);
   problem = transform_vars_permutation(problem, P2, dimension);
-  problem = transform_vars_blockrotation(problem, B_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B, dimension,
                                          block_sizes, nb_blocks);
   problem = transform_vars_permutation(problem, P1, dimension);
   problem = transform_vars_shift(problem, xopt, 0);
@@ -274,9 +287,9 @@ static coco_problem_t *f_different_powers_permblockdiag_bbob_problem_allocate(co
                         dimension);
   coco_problem_set_type(problem, "3-ill-conditioned");
 
-  coco_free_block_matrix(B, dimension);
-  coco_free_memory(P1);
-  coco_free_memory(P2);
+  coco_cache_release(B);
+  coco_cache_release(P1);
+  coco_cache_release(P2);
   coco_free_memory(block_sizes);
   coco_free_memory(xopt);
   return problem;
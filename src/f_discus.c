@@ -83,9 +83,8 @@ static coco_problem_t *f_discus_bbob_problem_allocate(const size_t function, con
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
 
-  double *M = coco_allocate_vector(dimension * dimension);
-  double *b = coco_allocate_vector(dimension);
-  double **rot1;
+  const double *M;
+  double *b = coco_allocate_vector_with_value(dimension, 0.0);
 
   xopt = coco_allocate_vector(dimension);
   fopt = bbob2009_compute_fopt(function, instance);
@@ -95,10 +94,7 @@ static coco_problem_t *f_discus_bbob_problem_allocate(const size_t function, con
     bbob2009_compute_xopt(xopt, rseed, dimension);
   }
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
-  bbob2009_copy_rotation_matrix(rot1, M, b, dimension);
-  bbob2009_free_matrix(rot1, dimension);
+  M = coco_cache_get_rotation(rseed + 1000000, dimension);
 
   problem = f_discus_allocate(dimension);
   problem = transform_vars_oscillate(problem);
@@ -112,7 +108,7 @@ static coco_problem_t *f_discus_bbob_problem_allocate(const size_t function, con
                         dimension);
   coco_problem_set_type(problem, "3-ill-conditioned");
 
-  coco_free_memory(M);
+  coco_cache_release(M);
   coco_free_memory(b);
   coco_free_memory(xopt);
   return problem;
@@ -129,9 +125,8 @@ static coco_problem_t *f_discus_cons_bbob_problem_allocate(const size_t function
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
 
-  double *M = coco_allocate_vector(dimension * dimension);
-  double *b = coco_allocate_vector(dimension);
-  double **rot1;
+  const double *M;
+  double *b = coco_allocate_vector_with_value(dimension, 0.0);
 
   xopt = coco_allocate_vector(dimension);
   fopt = bbob2009_compute_fopt(function, instance);
@@ -141,10 +136,7 @@ static coco_problem_t *f_discus_cons_bbob_problem_allocate(const size_t function
     bbob2009_compute_xopt(xopt, rseed, dimension);
   }
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
-  bbob2009_copy_rotation_matrix(rot1, M, b, dimension);
-  bbob2009_free_matrix(rot1, dimension);
+  M = coco_cache_get_rotation(rseed + 1000000, dimension);
 
   problem = f_discus_allocate(dimension);
   problem = transform_vars_affine(problem, M, b, dimension);
@@ -157,7 +149,7 @@ static coco_problem_t *f_discus_cons_bbob_problem_allocate(const size_t function
                         dimension);
   coco_problem_set_type(problem, "3-ill-conditioned");
 
-  coco_free_memory(M);
+  coco_cache_release(M);
   coco_free_memory(b);
   coco_free_memory(xopt);
   return problem;
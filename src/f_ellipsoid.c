@@ -23,6 +23,7 @@
  */
 typedef struct {
   double conditioning;
+  double *coefficients; /**< @brief The precomputed powers of the conditioning */
 } f_ellipsoid_data_t;
 
 /**
@@ -39,8 +40,7 @@ static double f_ellipsoid_raw(const double *x, const size_t number_of_variables,
 
   result = x[i] * x[i];
   for (i = 1; i < number_of_variables; ++i) {
-    const double exponent = 1.0 * (double)(long)i / ((double)(long)number_of_variables - 1.0);
-    result += pow(data->conditioning, exponent) * x[i] * x[i];
+    result += data->coefficients[i] * x[i] * x[i];
   }
 
   return result;
@@ -61,27 +61,44 @@ static void f_ellipsoid_evaluate(coco_problem_t *problem, const double *x,
  */
 static void f_ellipsoid_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
 
-  double exponent;
+  f_ellipsoid_data_t *data = (f_ellipsoid_data_t *)problem->data;
   size_t i = 0;
-  
+
   for (i = 0; i < problem->number_of_variables; ++i) {
-    exponent = 1.0 * (double)(long)i / ((double)(long)problem->number_of_variables - 1.0);
-    y[i] = 2.0 * pow(((f_ellipsoid_data_t *)problem->data)->conditioning, exponent) * x[i];
+    y[i] = 2.0 * data->coefficients[i] * x[i];
   }
 }
 
+/**
+ * @brief Frees the ellipsoid data object.
+ */
+static void f_ellipsoid_free(coco_problem_t *problem) {
+  f_ellipsoid_data_t *data = (f_ellipsoid_data_t *)problem->data;
+  coco_free_memory(data->coefficients);
+  /* Let the generic free problem code deal with all of the coco_problem_t fields */
+  problem->problem_free_function = NULL;
+  coco_problem_free(problem);
+}
+
 /**
  * @brief Allocates the basic ellipsoid problem.
  */
 static coco_problem_t *f_ellipsoid_allocate(const size_t number_of_variables, const double conditioning) {
 
-  coco_problem_t *problem = coco_problem_allocate_from_scalars("ellipsoid function", f_ellipsoid_evaluate, NULL,
-                                                               number_of_variables, -5.0, 5.0, 0.0);
+  size_t i;
+  coco_problem_t *problem = coco_problem_allocate_from_scalars("ellipsoid function", f_ellipsoid_evaluate,
+                                                               f_ellipsoid_free, number_of_variables, -5.0, 5.0, 0.0);
   problem->evaluate_gradient = f_ellipsoid_evaluate_gradient;
   coco_problem_set_id(problem, "%s_d%02lu", "ellipsoid", number_of_variables);
   f_ellipsoid_data_t *data;
   data = (f_ellipsoid_data_t *)coco_allocate_memory(sizeof(*data));
   data->conditioning = conditioning;
+  /* The powers of the conditioning do not depend on x and are computed only once */
+  data->coefficients = coco_allocate_vector(number_of_variables);
+  for (i = 0; i < number_of_variables; ++i) {
+    const double exponent = 1.0 * (double)(long)i / ((double)(long)number_of_variables - 1.0);
+    data->coefficients[i] = pow(conditioning, exponent);
+  }
   problem->data = data;
   /* Compute best solution */
   f_ellipsoid_evaluate(problem, problem->best_parameter, problem->best_value);
@@ -138,9 +155,8 @@ static coco_problem_t *f_ellipsoid_rotated_bbob_problem_allocate(const size_t fu
 
   f_ellipsoid_args_t *f_ellipsoid_args;
   f_ellipsoid_args = ((f_ellipsoid_args_t *)args);
-  double *M = coco_allocate_vector(dimension * dimension);
-  double *b = coco_allocate_vector(dimension);
-  double **rot1;
+  const double *M;
+  double *b = coco_allocate_vector_with_value(dimension, 0.0);
 
   double conditioning = f_ellipsoid_args->conditioning;
   xopt = coco_allocate_vector(dimension);
@@ -151,10 +167,7 @@ static coco_problem_t *f_ellipsoid_rotated_bbob_problem_allocate(const size_t fu
   }
   fopt = bbob2009_compute_fopt(function, instance);
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
-  bbob2009_copy_rotation_matrix(rot1, M, b, dimension);
-  bbob2009_free_matrix(rot1, dimension);
+  M = coco_cache_get_rotation(rseed + 1000000, dimension);
   problem = f_ellipsoid_allocate(dimension, conditioning);
   problem = transform_vars_oscillate(problem);
   problem = transform_vars_affine(problem, M, b, dimension);
@@ -164,7 +177,7 @@ static coco_problem_t *f_ellipsoid_rotated_bbob_problem_allocate(const size_t fu
   coco_problem_set_name(problem, problem_name_template, function, instance, dimension);
   coco_problem_set_type(problem, "3-ill-conditioned");
 
-  coco_free_memory(M);
+  coco_cache_release(M);
   coco_free_memory(b);
   coco_free_memory(xopt);
   return problem;
@@ -179,10 +192,9 @@ static coco_problem_t *f_ellipsoid_permblockdiag_bbob_problem_allocate(const siz
                                                                        const char *problem_name_template) {
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
-  double **B;
-  const double *const *B_copy;
-  size_t *P1 = coco_allocate_vector_size_t(dimension);
-  size_t *P2 = coco_allocate_vector_size_t(dimension);
+  const double *const *B;
+  const size_t *P1;
+  const size_t *P2;
   size_t *block_sizes;
   size_t nb_blocks;
   size_t swap_range;
@@ -200,18 +212,15 @@ static coco_problem_t *f_ellipsoid_permblockdiag_bbob_problem_allocate(const siz
   }
   fopt = bbob2009_compute_fopt(function, instance);
 
-  B = coco_allocate_blockmatrix(dimension, block_sizes, nb_blocks);
-  coco_compute_blockrotation(B, rseed + 1000000, dimension, block_sizes, nb_blocks);
-  B_copy = (const double *const *)
-      B; /*TODO: silences the warning, not sure if it prevents the modification of B at all levels. Check everywhere*/
+  B = coco_cache_get_blockrotation(rseed + 1000000, dimension, block_sizes, nb_blocks);
 
-  coco_compute_truncated_uniform_swap_permutation(P1, rseed + 2000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P2, rseed + 3000000, dimension, nb_swaps, swap_range);
+  P1 = coco_cache_get_permutation(rseed + 2000000, dimension, nb_swaps, swap_range);
+  P2 = coco_cache_get_permutation(rseed + 3000000, dimension, nb_swaps, swap_range);
 
   problem = f_ellipsoid_allocate(dimension, 1.0e6);
   problem = transform_vars_oscillate(problem);
   problem = transform_vars_permutation(problem, P2, dimension);
-  problem = transform_vars_blockrotation(problem, B_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B, dimension,
                                          block_sizes, nb_blocks);
   problem = transform_vars_permutation(problem, P1, dimension);
   problem = transform_vars_shift(problem, xopt, 0);
@@ -223,9 +232,9 @@ static coco_problem_t *f_ellipsoid_permblockdiag_bbob_problem_allocate(const siz
   coco_problem_set_name(problem, problem_name_template, function, instance, dimension);
   coco_problem_set_type(problem, "3-ill-conditioned");
 
-  coco_free_block_matrix(B, dimension);
-  coco_free_memory(P1);
-  coco_free_memory(P2);
+  coco_cache_release(B);
+  coco_cache_release(P1);
+  coco_cache_release(P2);
   coco_free_memory(block_sizes);
   coco_free_memory(xopt);
   return problem;
@@ -274,9 +283,8 @@ static coco_problem_t *f_ellipsoid_rotated_cons_bbob_problem_allocate(const size
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
 
-  double *M = coco_allocate_vector(dimension * dimension);
-  double *b = coco_allocate_vector(dimension);
-  double **rot1;
+  const double *M;
+  double *b = coco_allocate_vector_with_value(dimension, 0.0);
 
   xopt = coco_allocate_vector(dimension);
   if (coco_strfind(problem_name_template, "bbob-boxed suite problem") >= 0) {
@@ -286,10 +294,7 @@ static coco_problem_t *f_ellipsoid_rotated_cons_bbob_problem_allocate(const size
   }
   fopt = bbob2009_compute_fopt(function, instance);
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
-  bbob2009_copy_rotation_matrix(rot1, M, b, dimension);
-  bbob2009_free_matrix(rot1, dimension);
+  M = coco_cache_get_rotation(rseed + 1000000, dimension);
 
   problem = f_ellipsoid_allocate(dimension, 1.0e6);
   problem = transform_vars_affine(problem, M, b, dimension);
@@ -302,7 +307,7 @@ static coco_problem_t *f_ellipsoid_rotated_cons_bbob_problem_allocate(const size
                         dimension);
   coco_problem_set_type(problem, "3-ill-conditioned");
 
-  coco_free_memory(M);
+  coco_cache_release(M);
   coco_free_memory(b);
   coco_free_memory(xopt);
   return problem;
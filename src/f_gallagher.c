@@ -22,8 +22,9 @@
 #include "transform_obj_oscillate.c"
 #include "transform_obj_power.c"
 #include "transform_obj_penalize.c"
+#include "transform_vars_oscillate.c"
 
-#include "f_sphere.c"
+#include "f_gallagher_peaks.c"
 #include "transform_vars_gallagher_blockrotation.c"
 /**
  * @brief A random permutation type for the Gallagher problem.
@@ -41,10 +42,10 @@ typedef struct {
 typedef struct {
   long rseed;
   double *xopt;
-  double **rotation, **x_local, **arr_scales;
-  size_t number_of_peaks;
+  double **rotation;
+  f_gallagher_peaks_t *peaks; /**< @brief The peak locations and scales in the rotated search space */
   double penalty_scale;
-  double *peak_values;
+  double *tmx; /**< @brief Temporary storage for the rotated decision vector */
   coco_problem_free_function_t old_free_problem;
 } f_gallagher_data_t;
 
@@ -70,7 +71,7 @@ static double f_gallagher_raw(const double *x, const size_t number_of_variables,
   size_t i, j; /* Loop over dim */
   double *tmx;
   double a = 0.1;
-  double tmp2, f = 0., f_add, tmp, f_pen = 0., f_true = 0.;
+  double f = 0., f_add, tmp, f_pen = 0., f_true = 0.;
   double fac;
   double result;
 
@@ -90,7 +91,7 @@ static double f_gallagher_raw(const double *x, const size_t number_of_variables,
   f_add = f_pen;
   /* Transformation in search space */
   /* TODO: this should rather be done in f_gallagher */
-  tmx = coco_allocate_vector(number_of_variables);
+  tmx = data->tmx;
   for (i = 0; i < number_of_variables; i++) {
     tmx[i] = 0;
     for (j = 0; j < number_of_variables; ++j) {
@@ -98,15 +99,8 @@ static double f_gallagher_raw(const double *x, const size_t number_of_variables,
     }
   }
   /* Computation core*/
-  for (i = 0; i < data->number_of_peaks; ++i) {
-    tmp2 = 0.;
-    for (j = 0; j < number_of_variables; ++j) {
-      tmp = (tmx[j] - data->x_local[j][i]);
-      tmp2 += data->arr_scales[i][j] * tmp * tmp;
-    }
-    tmp2 = data->peak_values[i] * exp(fac * tmp2);
-    f = coco_double_max(f, tmp2);
-  }
+  f_gallagher_peaks_compute_distances(data->peaks, tmx);
+  f = f_gallagher_peaks_max_value(data->peaks, fac);
 
   f = 10. - f;
   if (f > 0) {
@@ -122,7 +116,6 @@ static double f_gallagher_raw(const double *x, const size_t number_of_variables,
   f_true *= f_true;
   f_true += f_add;
   result = f_true;
-  coco_free_memory(tmx);
   return result;
 }
 
@@ -136,6 +129,49 @@ static void f_gallagher_evaluate(coco_problem_t *problem, const double *x,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the Gallagher function, which is the gradient of the highest peak.
+ */
+static void f_gallagher_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  f_gallagher_data_t *data = (f_gallagher_data_t *)problem->data;
+  const size_t number_of_variables = problem->number_of_variables;
+  const double fac = -0.5 / (double)number_of_variables;
+  double *tmx = data->tmx;
+  double *gradient = problem->scratch;
+  double f, tmp;
+  size_t i, j, peak;
+  tosz_data d;
+
+  assert(problem->scratch_size >= number_of_variables);
+  for (i = 0; i < number_of_variables; i++) {
+    tmx[i] = 0;
+    for (j = 0; j < number_of_variables; ++j) {
+      tmx[i] += data->rotation[i][j] * x[j];
+    }
+    gradient[i] = 0;
+  }
+  f_gallagher_peaks_compute_distances(data->peaks, tmx);
+  peak = f_gallagher_peaks_max_index(data->peaks, fac);
+  f = data->peaks->peak_values[peak] * exp(fac * data->peaks->distances[peak]);
+
+  /* The outer function is tosz(10 - f)^2 */
+  d.alpha = 0.1;
+  f = 10. - f;
+  tmp = 2.0 * tosz_uv(f, &d) * tosz_uv_derivative(f, &d) * (10. - f);
+  f_gallagher_peaks_add_distance_gradient(data->peaks, tmx, peak, -tmp * fac, gradient);
+
+  for (j = 0; j < number_of_variables; ++j) {
+    y[j] = 0;
+    for (i = 0; i < number_of_variables; i++) {
+      y[j] += data->rotation[i][j] * gradient[i];
+    }
+    tmp = fabs(x[j]) - 5.;
+    if (tmp > 0.) {
+      y[j] += 2.0 * data->penalty_scale * tmp * ((x[j] > 0.) ? 1. : -1.);
+    }
+  }
+}
+
 /**
  * @brief Frees the Gallagher data object.
  */
@@ -143,10 +179,9 @@ static void f_gallagher_free(coco_problem_t *problem) {
   f_gallagher_data_t *data;
   data = (f_gallagher_data_t *)problem->data;
   coco_free_memory(data->xopt);
-  coco_free_memory(data->peak_values);
+  coco_free_memory(data->tmx);
   bbob2009_free_matrix(data->rotation, problem->number_of_variables);
-  bbob2009_free_matrix(data->x_local, problem->number_of_variables);
-  bbob2009_free_matrix(data->arr_scales, data->number_of_peaks);
+  f_gallagher_peaks_free(data->peaks);
   problem->problem_free_function = NULL;
   coco_problem_free(problem);
 }
@@ -162,6 +197,7 @@ static coco_problem_t *f_gallagher_bbob_problem_allocate(const size_t function,
                                                          const char *problem_name_template) {
 
   f_gallagher_data_t *data;
+  f_gallagher_peaks_t *peaks;
   /* problem_name and best_parameter will be overwritten below */
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Gallagher function", f_gallagher_evaluate,
                                                                f_gallagher_free, dimension, -5.0, 5.0, 0.0);
@@ -169,7 +205,7 @@ static coco_problem_t *f_gallagher_bbob_problem_allocate(const size_t function,
   const size_t peaks_21 = 21;
   const size_t peaks_101 = 101;
 
-  double fopt;
+  double fopt, tmp;
   size_t i, j, k;
   double maxcondition = 1000.;
   /* maxcondition1 satisfies the old code and the doc but seems wrong in that it
@@ -191,52 +227,51 @@ static coco_problem_t *f_gallagher_bbob_problem_allocate(const size_t function,
   data = (f_gallagher_data_t *)coco_allocate_memory(sizeof(*data));
 
   /* Allocate temporary storage and space for the rotation matrices */
-  data->number_of_peaks = number_of_peaks;
   data->penalty_scale = penalty_scale;
   data->xopt = coco_allocate_vector(dimension);
+  data->tmx = coco_allocate_vector(dimension);
   data->rotation = bbob2009_allocate_matrix(dimension, dimension);
-  data->x_local = bbob2009_allocate_matrix(dimension, data->number_of_peaks);
-  data->arr_scales = bbob2009_allocate_matrix(data->number_of_peaks, dimension);
+  data->peaks = peaks = f_gallagher_peaks_allocate(number_of_peaks, dimension, 0);
 
-  if (data->number_of_peaks == peaks_101) {
+  if (number_of_peaks == peaks_101) {
     maxcondition1 = sqrt(maxcondition1);
     b = 10.;
     c = 5.;
-  } else if (data->number_of_peaks == peaks_21) {
+  } else if (number_of_peaks == peaks_21) {
     b = 9.8;
     c = 4.9;
   } else {
     coco_error("f_gallagher_bbob_problem_allocate(): '%lu' is a non-supported number of peaks",
-               (unsigned long)data->number_of_peaks);
+               (unsigned long)number_of_peaks);
   }
   data->rseed = rseed;
   bbob2009_compute_rotation(data->rotation, rseed, dimension);
 
   /* Initialize all the data of the inner problem */
   random_numbers =
-      coco_allocate_vector(data->number_of_peaks * dimension); /* This is large enough for all cases below */
-  bbob2009_unif(random_numbers, data->number_of_peaks - 1, data->rseed);
-  rperm = (f_gallagher_permutation_t *)coco_allocate_memory(sizeof(*rperm) * (data->number_of_peaks - 1));
-  for (i = 0; i < data->number_of_peaks - 1; ++i) {
+      coco_allocate_vector(number_of_peaks * dimension); /* This is large enough for all cases below */
+  bbob2009_unif(random_numbers, number_of_peaks - 1, data->rseed);
+  rperm = (f_gallagher_permutation_t *)coco_allocate_memory(sizeof(*rperm) * (number_of_peaks - 1));
+  for (i = 0; i < number_of_peaks - 1; ++i) {
     rperm[i].value = random_numbers[i];
     rperm[i].index = i;
   }
-  qsort(rperm, data->number_of_peaks - 1, sizeof(*rperm), f_gallagher_compare_doubles);
+  qsort(rperm, number_of_peaks - 1, sizeof(*rperm), f_gallagher_compare_doubles);
 
   /* Random permutation */
-  arrCondition = coco_allocate_vector(data->number_of_peaks);
+  arrCondition = coco_allocate_vector(number_of_peaks);
   arrCondition[0] = maxcondition1;
-  data->peak_values = coco_allocate_vector(data->number_of_peaks);
-  data->peak_values[0] = 10;
-  for (i = 1; i < data->number_of_peaks; ++i) {
-    arrCondition[i] = pow(maxcondition, (double)(rperm[i - 1].index) / ((double)(data->number_of_peaks - 2)));
-    data->peak_values[i] =
-        (double)(i - 1) / (double)(data->number_of_peaks - 2) * (fitvalues[1] - fitvalues[0]) + fitvalues[0];
+  peaks->peak_values[0] = 10;
+  for (i = 1; i < number_of_peaks; ++i) {
+    arrCondition[i] = pow(maxcondition, (double)(rperm[i - 1].index) / ((double)(number_of_peaks - 2)));
+    peaks->peak_values[i] =
+        (double)(i - 1) / (double)(number_of_peaks - 2) * (fitvalues[1] - fitvalues[0]) + fitvalues[0];
   }
   coco_free_memory(rperm);
+  f_gallagher_peaks_set_log_values(peaks);
 
   rperm = (f_gallagher_permutation_t *)coco_allocate_memory(sizeof(*rperm) * dimension);
-  for (i = 0; i < data->number_of_peaks; ++i) {
+  for (i = 0; i < number_of_peaks; ++i) {
     bbob2009_unif(random_numbers, dimension, data->rseed + (long)(1000 * i));
     for (j = 0; j < dimension; ++j) {
       rperm[j].value = random_numbers[j];
@@ -244,13 +279,13 @@ static coco_problem_t *f_gallagher_bbob_problem_allocate(const size_t function,
     }
     qsort(rperm, dimension, sizeof(*rperm), f_gallagher_compare_doubles);
     for (j = 0; j < dimension; ++j) {
-      data->arr_scales[i][j] = pow(arrCondition[i], /* Lambda^alpha_i from the doc */
+      peaks->scales[j * number_of_peaks + i] = pow(arrCondition[i], /* Lambda^alpha_i from the doc */
                                    ((double)rperm[j].index) / ((double)(dimension - 1)) - 0.5);
     }
   }
   coco_free_memory(rperm);
 
-  bbob2009_unif(random_numbers, dimension * data->number_of_peaks, data->rseed);
+  bbob2009_unif(random_numbers, dimension * number_of_peaks, data->rseed);
 
   /* SBOX-COST wants optima in [-5, 5], the other suites in [-4, 4]. */
   double scale_factor = 0.8;
@@ -261,21 +296,22 @@ static coco_problem_t *f_gallagher_bbob_problem_allocate(const size_t function,
   for (i = 0; i < dimension; ++i) {
     data->xopt[i] = scale_factor * (b * random_numbers[i] - c);
     problem->best_parameter[i] = scale_factor * (b * random_numbers[i] - c);
-    for (j = 0; j < data->number_of_peaks; ++j) {
-      data->x_local[i][j] = 0.;
+    for (j = 0; j < number_of_peaks; ++j) {
+      tmp = 0.;
       for (k = 0; k < dimension; ++k) {
-        data->x_local[i][j] +=
-            data->rotation[i][k] * (b * random_numbers[j * dimension + k] - c);
+        tmp += data->rotation[i][k] * (b * random_numbers[j * dimension + k] - c);
       }
       if (j == 0) {
-        data->x_local[i][j] *= scale_factor;
+        tmp *= scale_factor;
       }
+      peaks->x_local[i * number_of_peaks + j] = tmp;
     }
   }
   coco_free_memory(arrCondition);
   coco_free_memory(random_numbers);
 
   problem->data = data;
+  problem->evaluate_gradient = f_gallagher_evaluate_gradient;
 
   /* Compute best solution */
   f_gallagher_evaluate(problem, problem->best_parameter, problem->best_value);
@@ -299,48 +335,6 @@ static coco_problem_t *f_gallagher_bbob_problem_allocate(const size_t function,
 
 
 
-/**
- * @brief Uses the core function to evaluate the sub problem.
- */
-static void f_gallagher_sub_evaluate_core(coco_problem_t *problem_i,
-                                          const double *x, double *y) {
-
-  assert(problem_i->number_of_objectives == 1);
-  y[0] = f_sphere_raw(x, problem_i->number_of_variables);
-  /*assert(y[0] + 1e-13 >= problem->best_value[0]);*/
-}
-
-/**
- * @brief Allocates the basic gallagher sub problem.
- */
-static coco_problem_t *
-f_gallagher_sub_problem_allocate(const size_t number_of_variables) {
-
-  coco_problem_t *problem_i =
-      coco_problem_allocate_from_scalars("gallagher_sub function", f_gallagher_sub_evaluate_core,
-                                         f_gallagher_versatile_data_free, number_of_variables, -5.0, 5.0, 0.0);
-  f_gallagher_versatile_data_t *versatile_data_tmp;
-  problem_i->versatile_data =
-      (f_gallagher_versatile_data_t *)coco_allocate_memory(sizeof(f_gallagher_versatile_data_t));
-  versatile_data_tmp = ((f_gallagher_versatile_data_t *)problem_i->versatile_data);
-  /* the following are not needed in the sub-problems */
-  versatile_data_tmp->number_of_peaks = 0;
-  versatile_data_tmp->sub_problems = NULL;
-  versatile_data_tmp->rotated_x = NULL;
-  versatile_data_tmp->block_size_map = NULL;
-  versatile_data_tmp->first_non_zero_map = NULL;
-  versatile_data_tmp->block_sizes = NULL;
-  versatile_data_tmp->B = NULL;
-
-  coco_problem_set_id(problem_i, "%s_d%04lu", "gallagher_sub",
-                      number_of_variables);
-
-  /* Compute best solution */
-  /*f_gallagher_sub_evaluate_core(problem, problem->best_parameter,
-   * problem->best_value);*/
-  return problem_i;
-}
-
 /**
  * @brief Implements the gallagher function without connections to any COCO
  * structures. Wassim: core to not conflict with raw for now
@@ -348,34 +342,13 @@ f_gallagher_sub_problem_allocate(const size_t number_of_variables) {
 static double f_gallagher_core(const double *x, size_t number_of_variables,
                                f_gallagher_versatile_data_t *versatile_data) {
 
-  coco_problem_t *problem_i;
   double result = 0;
-  double y, w_i;
-  size_t i, j;
-  double maxf = DBL_MAX;
-  double *x_local;
-  x_local = coco_allocate_vector(number_of_variables);
-
-  for (i = 0; i < versatile_data->number_of_peaks; i++) {
-    for (j = 0; j < number_of_variables; j++) {
-      x_local[j] = x[j]; /*versatile_data->rotated_x[j];*/
-    }
-    problem_i = versatile_data->sub_problems[i];
-    problem_i->evaluate_function(problem_i, x_local, &y);
-    if (i == 0) {
-      w_i = 10;
-    } else {
-      w_i = 1.1 + 8.0 * (((double)i + 1) - 2.0) / (((double)versatile_data->number_of_peaks) - 2.0);
-    }
-    y = w_i *
-        exp(-1.0 / (2.0 * ((double)number_of_variables)) * y); /* Wassim: problem_i->evaluate_function is the sphere on
-                                                                  a transformed coordiante system with conditioning */
-    if (i == 0 || maxf < y) {
-      maxf = y;
-    }
-  }
+  double maxf;
+
+  /* The distances are the sphere function on the transformed coordinate system (with conditioning) of each peak */
+  f_gallagher_peaks_compute_permuted_distances(versatile_data->peaks, x);
+  maxf = f_gallagher_peaks_max_value(versatile_data->peaks, -1.0 / (2.0 * ((double)number_of_variables)));
   result = 10.0 - maxf;
-  coco_free_memory(x_local);
   return result;
 }
 
@@ -393,6 +366,23 @@ static void f_gallagher_evaluate_core(coco_problem_t *problem, const double *x,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the core function, which is the gradient of the highest peak.
+ */
+static void f_gallagher_evaluate_gradient_core(coco_problem_t *problem, const double *x, double *y) {
+  f_gallagher_versatile_data_t *versatile_data = (f_gallagher_versatile_data_t *)problem->versatile_data;
+  f_gallagher_peaks_t *peaks = versatile_data->peaks;
+  const double fac = -1.0 / (2.0 * ((double)problem->number_of_variables));
+  size_t i, peak;
+
+  f_gallagher_peaks_compute_permuted_distances(peaks, x);
+  peak = f_gallagher_peaks_max_index(peaks, fac);
+  for (i = 0; i < problem->number_of_variables; i++)
+    y[i] = 0;
+  f_gallagher_peaks_add_distance_gradient(peaks, x, peak,
+                                          -fac * peaks->peak_values[peak] * exp(fac * peaks->distances[peak]), y);
+}
+
 /**
  * @brief Allocates the basic gallagher problem.
  */
@@ -400,19 +390,20 @@ static coco_problem_t *
 f_gallagher_problem_allocate(const size_t number_of_variables,
                              size_t number_of_peaks) {
 
-  size_t peak_index;
+  size_t i;
   f_gallagher_versatile_data_t *versatile_data;
   coco_problem_t *problem =
       coco_problem_allocate_from_scalars("gallagher function", f_gallagher_evaluate_core,
                                          f_gallagher_versatile_data_free, number_of_variables, -5.0, 5.0, 0.0);
   problem->versatile_data = (f_gallagher_versatile_data_t *)coco_allocate_memory(sizeof(f_gallagher_versatile_data_t));
   versatile_data = (f_gallagher_versatile_data_t *)problem->versatile_data; /* shortcut */
-  versatile_data->number_of_peaks = number_of_peaks;
-  versatile_data->sub_problems = (coco_problem_t **)coco_allocate_memory(number_of_peaks * sizeof(coco_problem_t *));
-  for (peak_index = 0; peak_index < number_of_peaks; peak_index++) {
-    versatile_data->sub_problems[peak_index] =
-        f_gallagher_sub_problem_allocate(number_of_variables);
+  versatile_data->peaks = f_gallagher_peaks_allocate(number_of_peaks, number_of_variables, 1);
+  versatile_data->peaks->peak_values[0] = 10;
+  for (i = 1; i < number_of_peaks; i++) {
+    versatile_data->peaks->peak_values[i] =
+        1.1 + 8.0 * (((double)i + 1) - 2.0) / (((double)number_of_peaks) - 2.0);
   }
+  f_gallagher_peaks_set_log_values(versatile_data->peaks);
   versatile_data->rotated_x = coco_allocate_vector(number_of_variables);
   versatile_data->block_size_map =
       coco_allocate_vector_size_t(number_of_variables);
@@ -422,6 +413,7 @@ f_gallagher_problem_allocate(const size_t number_of_variables,
       coco_allocate_vector_size_t(number_of_variables);
 
   coco_problem_set_id(problem, "%s_d%04lu", "gallagher", number_of_variables);
+  problem->evaluate_gradient = f_gallagher_evaluate_gradient_core;
   problem->best_value[0] = 0;
 
   /* Compute best solution */
@@ -436,14 +428,14 @@ static coco_problem_t *f_gallagher_permblockdiag_bbob_problem_allocate(const siz
                                                                        const char *problem_id_template,
                                                                        const char *problem_name_template) {
 
-  size_t i;
+  size_t i, k;
   size_t peak_index;
   double fopt, *y_i;
   double penalty_factor = 1.0;
-  coco_problem_t *problem = NULL, **problem_i, *rotation_problem;
+  coco_problem_t *problem = NULL, *rotation_problem;
   f_gallagher_versatile_data_t *versatile_data;
-  double **B;
-  const double *const *B_const;
+  f_gallagher_peaks_t *peaks;
+  const double *const *B;
   /*size_t *P1, *P2;*/
   size_t *block_sizes;
   size_t nb_blocks;
@@ -482,9 +474,7 @@ static coco_problem_t *f_gallagher_permblockdiag_bbob_problem_allocate(const siz
   /*swap_range = coco_get_swap_range(dimension, "bbob-largescale");
   nb_swaps = coco_get_nb_swaps(dimension, "bbob-largescale");*/
 
-  B = coco_allocate_blockmatrix(dimension, block_sizes, nb_blocks);
-  coco_compute_blockrotation(B, rseed, dimension, block_sizes, nb_blocks);
-  B_const = (const double *const *)B; /* Required because of the type */
+  B = coco_cache_get_blockrotation(rseed, dimension, block_sizes, nb_blocks);
   /*P1 = coco_allocate_vector_size_t(dimension);
   P2 = coco_allocate_vector_size_t(dimension);
   coco_compute_truncated_uniform_swap_permutation(P1, rseed + 2000000,
@@ -508,12 +498,12 @@ static coco_problem_t *f_gallagher_permblockdiag_bbob_problem_allocate(const siz
     versatile_data->first_non_zero_map[i] = next_bs_change - current_blocksize;
   }
   versatile_data->B =
-      coco_copy_block_matrix(B_const, dimension, block_sizes, nb_blocks);
+      coco_copy_block_matrix(B, dimension, block_sizes, nb_blocks);
 
   rotation_problem = coco_problem_allocate_from_scalars(
       "dummy rotation", NULL, NULL, dimension, -5.0, 5.0, 0.0);
   rotation_problem = transform_vars_blockrotation(
-      rotation_problem, B_const, dimension, block_sizes, nb_blocks);
+      rotation_problem, B, dimension, block_sizes, nb_blocks);
 
   alpha_i_vals = coco_allocate_vector(number_of_peaks - 1);
   for (i = 0; i < number_of_peaks - 1; i++) {
@@ -528,9 +518,8 @@ static coco_problem_t *f_gallagher_permblockdiag_bbob_problem_allocate(const siz
   best_param_before_rotation = coco_allocate_vector(dimension);
   best_param_after_rotation = coco_allocate_vector(dimension);
   tmp_uniform2 = coco_allocate_vector(dimension);
+  peaks = versatile_data->peaks;
   for (peak_index = 0; peak_index < number_of_peaks; peak_index++) {
-    problem_i = &(versatile_data->sub_problems[peak_index]);
-
     /* compute transformation parameters: */
     /* y_i and block-rotate it once and for all */
     y_i = coco_allocate_vector(dimension);
@@ -555,7 +544,6 @@ static coco_problem_t *f_gallagher_permblockdiag_bbob_problem_allocate(const siz
       alpha_i = alpha_i_vals[P_alpha_i[peak_index - 1]]; /*already square-rooted */
     }
 
-    (*problem_i)->best_value[0] = 0; /* to prevent raising the assert */
     /* P_Lambda the permutation */
     P_Lambda = coco_allocate_vector_size_t(dimension); /* random permutation of the values in C_i */
     bbob2009_unif(tmp_uniform2, dimension, rseed + (long)(1000 * peak_index));
@@ -563,14 +551,16 @@ static coco_problem_t *f_gallagher_permblockdiag_bbob_problem_allocate(const siz
     /*coco_compute_random_permutation(P_Lambda, rseed + (long) (1000 *
      * peak_index), dimension);*/
 
-    /* apply var transformations to sub problem*/
-    *problem_i = transform_vars_scale(*problem_i, 1. / sqrt(sqrt(sqrt(alpha_i)))); /* sqrt( alpha^1/4) */
-    *problem_i = transform_vars_conditioning(*problem_i, sqrt(alpha_i));
-    /**problem_i = transform_vars_blockrotation(*problem_i, B_const, dimension,
-     * block_sizes, nb_blocks);*/
-    *problem_i =
-        transform_vars_inverse_permutation(*problem_i, P_Lambda, dimension);
-    *problem_i = transform_vars_shift(*problem_i, y_i, 0);
+    /* The peak is the sphere function composed with the shift by y_i, the inverse permutation P_Lambda,
+     * the conditioning with sqrt(alpha_i) and the scaling by sqrt(alpha_i^1/4) */
+    peaks->peak_scales[peak_index] = 1. / sqrt(sqrt(sqrt(alpha_i)));
+    for (i = 0; i < dimension; i++) {
+      k = P_Lambda[i];
+      peaks->variables[k * number_of_peaks + peak_index] = i;
+      peaks->x_local[k * number_of_peaks + peak_index] = y_i[i];
+      peaks->scales[k * number_of_peaks + peak_index] =
+          pow(sqrt(alpha_i), 0.5 * (double)(long)k / ((double)(long)dimension - 1.0));
+    }
 
     coco_free_memory(P_Lambda);
     coco_free_memory(y_i);
@@ -579,7 +569,7 @@ static coco_problem_t *f_gallagher_permblockdiag_bbob_problem_allocate(const siz
 
   f_gallagher_evaluate_core(problem, best_param_after_rotation,
                             problem->best_value);
-  problem = transform_vars_blockrotation(problem, B_const, dimension,
+  problem = transform_vars_blockrotation(problem, B, dimension,
                                          block_sizes, nb_blocks);
   for (i = 0; i < dimension; i++) {
     problem->best_parameter[i] = best_param_before_rotation[i];
@@ -598,7 +588,7 @@ static coco_problem_t *f_gallagher_permblockdiag_bbob_problem_allocate(const siz
                         dimension);
   coco_problem_set_type(problem, "5-weakly-structured");
 
-  coco_free_block_matrix(B, dimension);
+  coco_cache_release(B);
   coco_free_memory(tmp_uniform);
   coco_free_memory(tmp_uniform2);
   /*coco_free_memory(P1);
@@ -0,0 +1,258 @@
+/**
+ * @file f_gallagher_peaks.c
+ * @brief Implementation of the peak data of the Gallagher functions.
+ *
+ * The data of all peaks is stored in a single block of memory, dimension by dimension: the value of peak i
+ * in coordinate j is found at index j * number_of_peaks + i. The weighted squared distances of a point to
+ * the peaks are thus computed for batches of neighboring peaks at once, which are kept in registers while
+ * sweeping over the coordinates. The terms of each distance are still summed up in the order of the
+ * coordinates, so that the results do not depend on the storage.
+ *
+ * The value of peak i is peak_values[i] * exp(fac * distances[i]) with fac < 0. Before calling exp(),
+ * these values are bounded with their logarithms, so that exp() only needs to be called for the peaks that
+ * can attain the maximum.
+ */
+
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+
+/**
+ * @brief The logarithms of the peak values are compared only if the largest one is above this value.
+ *
+ * This ensures that the maximal peak value and all values that are compared with it are normal numbers.
+ */
+#define F_GALLAGHER_PEAKS_MIN_LOG_VALUE -700.0
+
+/**
+ * @brief Peaks with a logarithm that is smaller than the largest one by more than this margin cannot
+ * attain the maximum.
+ *
+ * The margin is several orders of magnitude larger than the rounding errors of the logarithms.
+ */
+#define F_GALLAGHER_PEAKS_LOG_MARGIN 1e-8
+
+/**
+ * @brief The peak data of a Gallagher function.
+ */
+typedef struct {
+  size_t number_of_peaks;
+  size_t number_of_variables;
+
+  double *x_local;      /**< @brief The peak locations, stored coordinate by coordinate */
+  double *scales;       /**< @brief The scales of the coordinates of the peaks, stored like x_local */
+  size_t *variables;    /**< @brief The variables that correspond to the coordinates (or NULL), stored like x_local */
+  double *peak_scales;  /**< @brief The factors by which the coordinates of each peak are scaled (or NULL) */
+  double *peak_values;  /**< @brief The heights of the peaks */
+  double *log_peak_values;
+  double *distances;    /**< @brief Temporary storage for the weighted squared distances to the peaks */
+
+  void *memory;         /**< @brief The single block of memory that contains all of the above */
+} f_gallagher_peaks_t;
+
+/**
+ * @brief Allocates the peak data.
+ *
+ * If permuted is nonzero, the coordinates of the peaks are permuted variables, which are scaled by a factor
+ * per peak (see f_gallagher_peaks_compute_permuted_distances()).
+ */
+static f_gallagher_peaks_t *f_gallagher_peaks_allocate(const size_t number_of_peaks,
+                                                       const size_t number_of_variables, const int permuted) {
+  f_gallagher_peaks_t *peaks;
+  const size_t size = number_of_peaks * number_of_variables;
+  size_t number_of_doubles = 2 * size + 3 * number_of_peaks;
+  double *memory;
+
+  if (permuted)
+    number_of_doubles += number_of_peaks;
+
+  /* The doubles are stored first, so that they are aligned, followed by the variable indices */
+  memory = (double *)coco_allocate_memory(number_of_doubles * sizeof(double) +
+                                          (permuted ? size * sizeof(size_t) : 0));
+  peaks = (f_gallagher_peaks_t *)coco_allocate_memory(sizeof(*peaks));
+  peaks->number_of_peaks = number_of_peaks;
+  peaks->number_of_variables = number_of_variables;
+  peaks->memory = memory;
+  peaks->x_local = memory;
+  peaks->scales = peaks->x_local + size;
+  peaks->peak_values = peaks->scales + size;
+  peaks->log_peak_values = peaks->peak_values + number_of_peaks;
+  peaks->distances = peaks->log_peak_values + number_of_peaks;
+  peaks->peak_scales = permuted ? peaks->distances + number_of_peaks : NULL;
+  peaks->variables = permuted ? (size_t *)(memory + number_of_doubles) : NULL;
+  return peaks;
+}
+
+/**
+ * @brief Frees the peak data.
+ */
+static void f_gallagher_peaks_free(f_gallagher_peaks_t *peaks) {
+  coco_free_memory(peaks->memory);
+  coco_free_memory(peaks);
+}
+
+/**
+ * @brief Computes the logarithms of the peak values (needs to be called once the peak values are set).
+ */
+static void f_gallagher_peaks_set_log_values(f_gallagher_peaks_t *peaks) {
+  size_t i;
+
+  for (i = 0; i < peaks->number_of_peaks; i++) {
+    assert(peaks->peak_values[i] > 0);
+    peaks->log_peak_values[i] = log(peaks->peak_values[i]);
+  }
+}
+
+/**
+ * @brief Computes the distances of x to the peaks as
+ * distances[i] = sum_j scales[j, i] * (x[j] - x_local[j, i])^2.
+ */
+static void f_gallagher_peaks_compute_distances(f_gallagher_peaks_t *peaks, const double *x) {
+  const size_t number_of_peaks = peaks->number_of_peaks;
+  const size_t number_of_variables = peaks->number_of_variables;
+  const double *x_local, *scales;
+  double *distances = peaks->distances;
+  double tmp0, tmp1, tmp2, tmp3, distance0, distance1, distance2, distance3;
+  size_t i, j;
+
+  /* Batches of four peaks, whose distances are kept in registers */
+  for (i = 0; i + 4 <= number_of_peaks; i += 4) {
+    x_local = peaks->x_local + i;
+    scales = peaks->scales + i;
+    distance0 = distance1 = distance2 = distance3 = 0.;
+    for (j = 0; j < number_of_variables; j++) {
+      tmp0 = x[j] - x_local[0];
+      tmp1 = x[j] - x_local[1];
+      tmp2 = x[j] - x_local[2];
+      tmp3 = x[j] - x_local[3];
+      distance0 += scales[0] * tmp0 * tmp0;
+      distance1 += scales[1] * tmp1 * tmp1;
+      distance2 += scales[2] * tmp2 * tmp2;
+      distance3 += scales[3] * tmp3 * tmp3;
+      x_local += number_of_peaks;
+      scales += number_of_peaks;
+    }
+    distances[i] = distance0;
+    distances[i + 1] = distance1;
+    distances[i + 2] = distance2;
+    distances[i + 3] = distance3;
+  }
+  /* The remaining peaks */
+  for (; i < number_of_peaks; i++) {
+    x_local = peaks->x_local + i;
+    scales = peaks->scales + i;
+    distance0 = 0.;
+    for (j = 0; j < number_of_variables; j++) {
+      tmp0 = x[j] - *x_local;
+      distance0 += *scales * tmp0 * tmp0;
+      x_local += number_of_peaks;
+      scales += number_of_peaks;
+    }
+    distances[i] = distance0;
+  }
+}
+
+/**
+ * @brief Computes the distances of x to the peaks of permuted coordinates as
+ * distances[i] = sum_j (peak_scales[i] * (scales[j, i] * (x[variables[j, i]] - x_local[j, i])))^2.
+ */
+static void f_gallagher_peaks_compute_permuted_distances(f_gallagher_peaks_t *peaks, const double *x) {
+  const size_t number_of_peaks = peaks->number_of_peaks;
+  const double *x_local = peaks->x_local;
+  const double *scales = peaks->scales;
+  const size_t *variables = peaks->variables;
+  double *distances = peaks->distances;
+  double tmp;
+  size_t i, j;
+
+  assert(variables != NULL);
+  for (i = 0; i < number_of_peaks; i++)
+    distances[i] = 0.;
+  for (j = 0; j < peaks->number_of_variables; j++) {
+    for (i = 0; i < number_of_peaks; i++) {
+      tmp = peaks->peak_scales[i] * (scales[i] * (x[variables[i]] - x_local[i]));
+      distances[i] += tmp * tmp;
+    }
+    x_local += number_of_peaks;
+    scales += number_of_peaks;
+    variables += number_of_peaks;
+  }
+}
+
+/**
+ * @brief Returns the largest value of peak_values[i] * exp(fac * distances[i]) (and 0 if it is smaller).
+ *
+ * The result is the same as the one of the straightforward loop over all peaks, which is used when the
+ * distances contain NAN values.
+ */
+static double f_gallagher_peaks_max_value(const f_gallagher_peaks_t *peaks, const double fac) {
+  const size_t number_of_peaks = peaks->number_of_peaks;
+  const double *distances = peaks->distances;
+  double log_value, max_log_value = -DBL_MAX;
+  double threshold, result = 0.;
+  size_t i;
+  int is_nan = 0;
+
+  assert(fac < 0);
+  for (i = 0; i < number_of_peaks; i++) {
+    log_value = peaks->log_peak_values[i] + fac * distances[i];
+    if (log_value > max_log_value)
+      max_log_value = log_value;
+    is_nan |= coco_is_nan(log_value);
+  }
+
+  if (is_nan || (max_log_value < F_GALLAGHER_PEAKS_MIN_LOG_VALUE)) {
+    for (i = 0; i < number_of_peaks; i++)
+      result = coco_double_max(result, peaks->peak_values[i] * exp(fac * distances[i]));
+    return result;
+  }
+
+  threshold = max_log_value - F_GALLAGHER_PEAKS_LOG_MARGIN;
+  for (i = 0; i < number_of_peaks; i++) {
+    if (peaks->log_peak_values[i] + fac * distances[i] >= threshold)
+      result = coco_double_max(result, peaks->peak_values[i] * exp(fac * distances[i]));
+  }
+  return result;
+}
+
+/**
+ * @brief Returns the index of the peak that attains the value returned by f_gallagher_peaks_max_value().
+ *
+ * The distances need to be computed already.
+ */
+static size_t f_gallagher_peaks_max_index(const f_gallagher_peaks_t *peaks, const double fac) {
+  double value, max_value = -DBL_MAX;
+  size_t i, max_index = 0;
+
+  for (i = 0; i < peaks->number_of_peaks; i++) {
+    value = peaks->log_peak_values[i] + fac * peaks->distances[i];
+    if (value > max_value) {
+      max_value = value;
+      max_index = i;
+    }
+  }
+  return max_index;
+}
+
+/**
+ * @brief Adds factor times the gradient of the distance of x to the given peak to gradient.
+ */
+static void f_gallagher_peaks_add_distance_gradient(const f_gallagher_peaks_t *peaks, const double *x,
+                                                    const size_t peak, const double factor, double *gradient) {
+  const size_t number_of_peaks = peaks->number_of_peaks;
+  double scale;
+  size_t j, k;
+
+  for (j = 0; j < peaks->number_of_variables; j++) {
+    k = j * number_of_peaks + peak;
+    if (peaks->variables == NULL) {
+      gradient[j] += factor * 2.0 * peaks->scales[k] * (x[j] - peaks->x_local[k]);
+    } else {
+      scale = peaks->peak_scales[peak] * peaks->scales[k];
+      gradient[peaks->variables[k]] += factor * 2.0 * scale * scale * (x[peaks->variables[k]] - peaks->x_local[k]);
+    }
+  }
+}
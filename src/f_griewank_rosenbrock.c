@@ -9,6 +9,7 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_simd.c"
 #include "suite_bbob_legacy_code.c"
 #include "transform_obj_norm_by_dim.c"
 #include "transform_obj_shift.c"
@@ -25,6 +26,41 @@ typedef struct {
   double facftrue;
 } f_griewank_rosenbrock_data_t;
 
+#if COCO_SIMD_ENABLED
+/**
+ * @brief SIMD version of the sum of the Griewank-Rosenbrock function.
+ *
+ * Returns 0 if a summand is outside of the range of coco_simd_cos().
+ */
+COCO_SIMD_INLINE int f_griewank_rosenbrock_simd_body(const double *x, const size_t number_of_variables,
+                                                     double *result) {
+  coco_simd_vector_t sum = {0};
+  coco_simd_bits_t invalid = {0};
+  size_t i;
+
+  for (i = 0; i + COCO_SIMD_WIDTH < number_of_variables; i += COCO_SIMD_WIDTH) {
+    const coco_simd_vector_t xi = coco_simd_load(x + i);
+    const coco_simd_vector_t c1 = xi * xi - coco_simd_load(x + i + 1);
+    const coco_simd_vector_t c2 = 1.0 - xi;
+    const coco_simd_vector_t tmp = 100.0 * c1 * c1 + c2 * c2;
+    sum += tmp / 4000. - coco_simd_cos(&tmp, &invalid);
+  }
+  if (coco_simd_any(&invalid))
+    return 0;
+  *result = coco_simd_sum(&sum);
+  for (; i < number_of_variables - 1; ++i) {
+    const double c1 = x[i] * x[i] - x[i + 1];
+    const double c2 = 1.0 - x[i];
+    const double tmp = 100.0 * c1 * c1 + c2 * c2;
+    *result += tmp / 4000. - cos(tmp);
+  }
+  return 1;
+}
+
+COCO_SIMD_DEFINE_KERNEL(f_griewank_rosenbrock_simd, (const double *x, const size_t number_of_variables,
+                                                     double *result), (x, number_of_variables, result))
+#endif
+
 /**
  * @brief Implements the Griewank-Rosenbrock function without connections to any
  * COCO structures.
@@ -41,11 +77,13 @@ static double f_griewank_rosenbrock_raw(const double *x, const size_t number_of_
 
   /* Computation core */
   result = 0.0;
-  for (i = 0; i < number_of_variables - 1; ++i) {
-    const double c1 = x[i] * x[i] - x[i + 1];
-    const double c2 = 1.0 - x[i];
-    tmp = 100.0 * c1 * c1 + c2 * c2;
-    result += tmp / 4000. - cos(tmp);
+  if (!COCO_SIMD_RUN(f_griewank_rosenbrock_simd, (x, number_of_variables, &result))) {
+    for (i = 0; i < number_of_variables - 1; ++i) {
+      const double c1 = x[i] * x[i] - x[i + 1];
+      const double c2 = 1.0 - x[i];
+      tmp = 100.0 * c1 * c1 + c2 * c2;
+      result += tmp / 4000. - cos(tmp);
+    }
   }
   result = data->facftrue + data->facftrue * result / (double)(number_of_variables - 1);
 
@@ -62,6 +100,30 @@ static void f_griewank_rosenbrock_evaluate(coco_problem_t *problem,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the Griewank-Rosenbrock function.
+ */
+static void f_griewank_rosenbrock_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  f_griewank_rosenbrock_data_t *data = (f_griewank_rosenbrock_data_t *)problem->data;
+  const size_t number_of_variables = problem->number_of_variables;
+  const double factor = data->facftrue / (double)(number_of_variables - 1);
+  size_t i;
+  double tmp, derivative;
+
+  for (i = 0; i < number_of_variables; ++i) {
+    y[i] = 0.0;
+  }
+  for (i = 0; i < number_of_variables - 1; ++i) {
+    const double c1 = x[i] * x[i] - x[i + 1];
+    const double c2 = 1.0 - x[i];
+    tmp = 100.0 * c1 * c1 + c2 * c2;
+    /* The derivative of the summand with respect to tmp */
+    derivative = factor * (1.0 / 4000. + sin(tmp));
+    y[i] += derivative * (400.0 * c1 * x[i] - 2.0 * c2);
+    y[i + 1] -= derivative * 200.0 * c1;
+  }
+}
+
 /**
  * @brief Allocates the basic Griewank-Rosenbrock problem.
  */
@@ -75,6 +137,7 @@ static coco_problem_t *f_griewank_rosenbrock_allocate(const size_t number_of_var
   data = (f_griewank_rosenbrock_data_t *)coco_allocate_memory(sizeof(*data));
   data->facftrue = facftrue;
   problem->data = data;
+  problem->evaluate_gradient = f_griewank_rosenbrock_evaluate_gradient;
   /* Compute best solution */
   f_griewank_rosenbrock_evaluate(problem, problem->best_parameter,
                                  problem->best_value);
@@ -158,10 +221,9 @@ static coco_problem_t *f_griewank_rosenbrock_permblockdiag_bbob_bbob_problem_all
   double *shift, scales;
   size_t i, j, k, next_bs_change;
 
-  double **B;
-  const double *const *B_copy;
-  size_t *P1 = coco_allocate_vector_size_t(dimension);
-  size_t *P2 = coco_allocate_vector_size_t(dimension);
+  const double *const *B;
+  const size_t *P1;
+  const size_t *P2;
   size_t *block_sizes;
   size_t block_size;
   size_t nb_blocks;
@@ -182,12 +244,9 @@ static coco_problem_t *f_griewank_rosenbrock_permblockdiag_bbob_bbob_problem_all
     shift[i] = -0.5;
   }
 
-  B = coco_allocate_blockmatrix(dimension, block_sizes, nb_blocks);
-  B_copy = (const double *const *)B;
-
-  coco_compute_blockrotation(B, rseed, dimension, block_sizes, nb_blocks);
-  coco_compute_truncated_uniform_swap_permutation(P1, rseed + 2000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P2, rseed + 3000000, dimension, nb_swaps, swap_range);
+  B = coco_cache_get_blockrotation(rseed, dimension, block_sizes, nb_blocks);
+  P1 = coco_cache_get_permutation(rseed + 2000000, dimension, nb_swaps, swap_range);
+  P2 = coco_cache_get_permutation(rseed + 3000000, dimension, nb_swaps, swap_range);
 
   f_griewank_rosenbrock_args_t *f_griewank_rosenbrock_args;
   f_griewank_rosenbrock_args = ((f_griewank_rosenbrock_args_t *)args);
@@ -196,7 +255,7 @@ static coco_problem_t *f_griewank_rosenbrock_permblockdiag_bbob_bbob_problem_all
   problem = transform_vars_shift(problem, shift, 0);
   problem = transform_vars_scale(problem, scales);
   problem = transform_vars_permutation(problem, P2, dimension);
-  problem = transform_vars_blockrotation(problem, B_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B, dimension,
                                          block_sizes, nb_blocks);
   problem = transform_vars_permutation(problem, P1, dimension);
   
@@ -229,9 +288,9 @@ static coco_problem_t *f_griewank_rosenbrock_permblockdiag_bbob_bbob_problem_all
 
   coco_free_memory(best_parameter);
   coco_free_memory(shift);
-  coco_free_block_matrix(B, dimension);
-  coco_free_memory(P1);
-  coco_free_memory(P2);
+  coco_cache_release(B);
+  coco_cache_release(P1);
+  coco_cache_release(P2);
   coco_free_memory(block_sizes);
   return problem;
 }
@@ -9,6 +9,7 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_simd.c"
 #include "coco_utilities.c"
 #include "suite_bbob_legacy_code.c"
 #include "transform_obj_norm_by_dim.c"
@@ -17,6 +18,55 @@
 #include "transform_vars_affine.c"
 #include "transform_vars_shift.c"
 
+#if COCO_SIMD_ENABLED
+/**
+ * @brief SIMD version of the product of the Katsuura function, computed as exp(exponent * sum(log(tmp))).
+ *
+ * Returns 0 if a value of x is too large to be rounded with coco_simd_round().
+ */
+COCO_SIMD_INLINE int f_katsuura_simd_body(const double *x, const size_t number_of_variables, const double exponent,
+                                          double *result) {
+  const coco_simd_vector_t lane = {0, 1, 2, 3, 4, 5, 6, 7};
+  coco_simd_vector_t log_sum = {0};
+  coco_simd_bits_t invalid = {0};
+  double tmp, tmp2, sum;
+  size_t i, j;
+
+  for (i = 0; i + COCO_SIMD_WIDTH <= number_of_variables; i += COCO_SIMD_WIDTH) {
+    const coco_simd_vector_t xi = coco_simd_load(x + i);
+    coco_simd_vector_t vector_tmp = {0};
+    invalid |= COCO_SIMD_OUTSIDE(xi, -262144.0, 262144.0); /* 2^32 * x needs to stay below 2^51 */
+    tmp2 = 1.;
+    for (j = 1; j < 33; ++j) {
+      coco_simd_vector_t scaled_x;
+      tmp2 *= 2.;
+      scaled_x = tmp2 * xi;
+      /* Rounding ties differently than coco_double_round() gives the same distance */
+      vector_tmp += COCO_SIMD_ABS(scaled_x - COCO_SIMD_ROUND(scaled_x)) / tmp2;
+    }
+    vector_tmp = 1.0 + (lane + (double)(long)i + 1) * vector_tmp;
+    log_sum += coco_simd_log(&vector_tmp, &invalid);
+  }
+  if (coco_simd_any(&invalid))
+    return 0;
+  sum = coco_simd_sum(&log_sum);
+  for (; i < number_of_variables; ++i) {
+    tmp = 0;
+    tmp2 = 1.;
+    for (j = 1; j < 33; ++j) {
+      tmp2 *= 2.;
+      tmp += fabs(tmp2 * x[i] - coco_double_round(tmp2 * x[i])) / tmp2;
+    }
+    sum += log(1.0 + ((double)(long)i + 1) * tmp);
+  }
+  *result = exp(exponent * sum);
+  return 1;
+}
+
+COCO_SIMD_DEFINE_KERNEL(f_katsuura_simd, (const double *x, const size_t number_of_variables, const double exponent,
+                                          double *result), (x, number_of_variables, exponent, result))
+#endif
+
 /**
  * @brief Implements the Katsuura function without connections to any COCO
  * structures.
@@ -27,21 +77,25 @@ static double f_katsuura_raw(const double *x,
   size_t i, j;
   double tmp, tmp2;
   double result;
+  const double exponent = 10. / pow((double)number_of_variables, 1.2);
 
   if (coco_vector_contains_nan(x, number_of_variables))
     return NAN;
 
   /* Computation core */
   result = 1.0;
-  for (i = 0; i < number_of_variables; ++i) {
-    tmp = 0;
-    for (j = 1; j < 33; ++j) {
-      tmp2 = pow(2., (double)j);
-      tmp += fabs(tmp2 * x[i] - coco_double_round(tmp2 * x[i])) / tmp2;
+  if (!COCO_SIMD_RUN(f_katsuura_simd, (x, number_of_variables, exponent, &result))) {
+    for (i = 0; i < number_of_variables; ++i) {
+      tmp = 0;
+      tmp2 = 1.;
+      for (j = 1; j < 33; ++j) {
+        tmp2 *= 2.; /* pow(2., j), which is exact */
+        tmp += fabs(tmp2 * x[i] - coco_double_round(tmp2 * x[i])) / tmp2;
+      }
+      tmp = 1.0 + ((double)(long)i + 1) * tmp;
+      /*result *= tmp;*/ /* Wassim TODO: delete once consistency check passed*/
+      result *= pow(tmp, exponent);
     }
-    tmp = 1.0 + ((double)(long)i + 1) * tmp;
-    /*result *= tmp;*/ /* Wassim TODO: delete once consistency check passed*/
-    result *= pow(tmp, 10. / pow((double)number_of_variables, 1.2));
   }
   /*result = 10. / ((double) number_of_variables) / ((double) number_of_variables)
    * (-1. + pow(result, 10. / pow((double) number_of_variables, 1.2)));*/
@@ -60,6 +114,40 @@ static void f_katsuura_evaluate(coco_problem_t *problem, const double *x,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the Katsuura function.
+ *
+ * The function is piecewise smooth with kinks at the multiples of 2^-33 in each coordinate, so that the
+ * gradient is that of the piece that contains x.
+ */
+static void f_katsuura_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  const size_t number_of_variables = problem->number_of_variables;
+  const double exponent = 10. / pow((double)number_of_variables, 1.2);
+  size_t i, j;
+  double tmp, tmp2, derivative, product = 1.0;
+
+  for (i = 0; i < number_of_variables; ++i) {
+    tmp = 0;
+    derivative = 0;
+    tmp2 = 1.;
+    for (j = 1; j < 33; ++j) {
+      tmp2 *= 2.; /* pow(2., j), which is exact */
+      tmp += fabs(tmp2 * x[i] - coco_double_round(tmp2 * x[i])) / tmp2;
+      if (tmp2 * x[i] > coco_double_round(tmp2 * x[i]))
+        derivative += 1.0;
+      else if (tmp2 * x[i] < coco_double_round(tmp2 * x[i]))
+        derivative -= 1.0;
+    }
+    tmp = 1.0 + ((double)(long)i + 1) * tmp;
+    product *= pow(tmp, exponent);
+    /* The derivative of the logarithm of the i-th factor */
+    y[i] = exponent * ((double)(long)i + 1) * derivative / tmp;
+  }
+  for (i = 0; i < number_of_variables; ++i) {
+    y[i] *= 10. / ((double)number_of_variables) / ((double)number_of_variables) * product;
+  }
+}
+
 /**
  * @brief Allocates the basic Katsuura problem.
  */
@@ -68,6 +156,7 @@ static coco_problem_t *f_katsuura_allocate(const size_t number_of_variables) {
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Katsuura function", f_katsuura_evaluate, NULL,
                                                                number_of_variables, -5.0, 5.0, 0.0);
   coco_problem_set_id(problem, "%s_d%02lu", "katsuura", number_of_variables);
+  problem->evaluate_gradient = f_katsuura_evaluate_gradient;
 
   /* Compute best solution */
   f_katsuura_evaluate(problem, problem->best_parameter, problem->best_value);
@@ -83,10 +172,9 @@ static coco_problem_t *f_katsuura_bbob_problem_allocate(const size_t function, c
                                                         const char *problem_name_template) {
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
-  size_t i, j, k;
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
-  double *current_row, **rot1, **rot2;
+  double **rot1, **rot2;
 
   const double penalty_factor = 1.0;
 
@@ -103,17 +191,7 @@ static coco_problem_t *f_katsuura_bbob_problem_allocate(const size_t function, c
   bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
   bbob2009_compute_rotation(rot2, rseed, dimension);
 
-  for (i = 0; i < dimension; ++i) {
-    b[i] = 0.0;
-    current_row = M + i * dimension;
-    for (j = 0; j < dimension; ++j) {
-      current_row[j] = 0.0;
-      for (k = 0; k < dimension; ++k) {
-        double exponent = 1.0 * (int)k / ((double)(long)dimension - 1.0);
-        current_row[j] += rot1[i][k] * pow(sqrt(100), exponent) * rot2[k][j];
-      }
-    }
-  }
+  bbob2009_compute_scaled_rotation_product(M, b, rot1, sqrt(100), rot2, dimension);
 
   problem = f_katsuura_allocate(dimension);
   problem = transform_obj_shift(
@@ -146,15 +224,13 @@ static coco_problem_t *f_katsuura_permblockdiag_bbob_problem_allocate(const size
                                                                       const char *problem_name_template) {
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
-  double **B1;
-  double **B2;
-  const double *const *B1_copy;
-  const double *const *B2_copy;
+  const double *const *B1;
+  const double *const *B2;
   const double penalty_factor = 1.0;
-  size_t *P11 = coco_allocate_vector_size_t(dimension);
-  size_t *P12 = coco_allocate_vector_size_t(dimension);
-  size_t *P21 = coco_allocate_vector_size_t(dimension);
-  size_t *P22 = coco_allocate_vector_size_t(dimension);
+  const size_t *P11;
+  const size_t *P12;
+  const size_t *P21;
+  const size_t *P22;
   size_t *block_sizes1;
   size_t *block_sizes2;
   size_t nb_blocks1;
@@ -181,32 +257,22 @@ static coco_problem_t *f_katsuura_permblockdiag_bbob_problem_allocate(const size
     bbob2009_compute_xopt(xopt, rseed, dimension);
   }
 
-  B1 = coco_allocate_blockmatrix(dimension, block_sizes1, nb_blocks1);
-  B2 = coco_allocate_blockmatrix(dimension, block_sizes2, nb_blocks2);
-  B1_copy = (const double *const *)B1;
-  B2_copy = (const double *const *)B2;
-
-  coco_compute_blockrotation(B1, rseed + 1000000, dimension, block_sizes1,
-                             nb_blocks1);
-  coco_compute_blockrotation(B2, rseed, dimension, block_sizes2, nb_blocks2);
+  B1 = coco_cache_get_blockrotation(rseed + 1000000, dimension, block_sizes1, nb_blocks1);
+  B2 = coco_cache_get_blockrotation(rseed, dimension, block_sizes2, nb_blocks2);
 
-  coco_compute_truncated_uniform_swap_permutation(
-      P11, rseed + 3000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(
-      P12, rseed + 4000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(
-      P21, rseed + 5000000, dimension, nb_swaps2, swap_range2);
-  coco_compute_truncated_uniform_swap_permutation(
-      P22, rseed + 6000000, dimension, nb_swaps2, swap_range2);
+  P11 = coco_cache_get_permutation(rseed + 3000000, dimension, nb_swaps1, swap_range1);
+  P12 = coco_cache_get_permutation(rseed + 4000000, dimension, nb_swaps1, swap_range1);
+  P21 = coco_cache_get_permutation(rseed + 5000000, dimension, nb_swaps2, swap_range2);
+  P22 = coco_cache_get_permutation(rseed + 6000000, dimension, nb_swaps2, swap_range2);
 
   problem = f_katsuura_allocate(dimension);
   problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B1, dimension,
                                          block_sizes2, nb_blocks2);
   problem = transform_vars_permutation(problem, P21, dimension);
   problem = transform_vars_conditioning(problem, 100.0);
   problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B2, dimension,
                                          block_sizes1, nb_blocks1);
   problem = transform_vars_permutation(problem, P11, dimension);
   problem = transform_vars_shift(problem, xopt, 0);
@@ -223,12 +289,12 @@ static coco_problem_t *f_katsuura_permblockdiag_bbob_problem_allocate(const size
                         dimension);
   coco_problem_set_type(problem, "5-weakly-structured");
 
-  coco_free_block_matrix(B1, dimension);
-  coco_free_block_matrix(B2, dimension);
-  coco_free_memory(P11);
-  coco_free_memory(P12);
-  coco_free_memory(P21);
-  coco_free_memory(P22);
+  coco_cache_release(B1);
+  coco_cache_release(B2);
+  coco_cache_release(P11);
+  coco_cache_release(P12);
+  coco_cache_release(P21);
+  coco_cache_release(P22);
   coco_free_memory(block_sizes1);
   coco_free_memory(block_sizes2);
   coco_free_memory(xopt);
@@ -8,6 +8,7 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_simd.c"
 #include "f_sphere.c"
 #include "suite_bbob_legacy_code.c"
 #include "transform_obj_norm_by_dim.c"
@@ -19,9 +20,10 @@
  * @brief Data type for the Lunacek bi-Rastrigin problem.
  */
 typedef struct {
-  double *x_hat, *z;
+  double *x_hat, *z, *tmpvect;
   double *xopt, fopt;
   double **rot1, **rot2;
+  double *scales; /**< @brief The precomputed diagonal of the conditioning matrix */
   long rseed;
   coco_problem_free_function_t old_free_problem;
 } f_lunacek_bi_rastrigin_data_t;
@@ -33,7 +35,6 @@ typedef struct {
 static double f_lunacek_bi_rastrigin_raw(const double *x, const size_t number_of_variables,
                                          f_lunacek_bi_rastrigin_data_t *data) {
   double result;
-  static const double condition = 100.;
   size_t i, j;
   double penalty = 0.0;
   static const double mu0 = 2.5;
@@ -62,12 +63,11 @@ static double f_lunacek_bi_rastrigin_raw(const double *x, const size_t number_of
     }
   }
 
-  tmpvect = coco_allocate_vector(number_of_variables);
+  tmpvect = data->tmpvect;
   /* affine transformation */
   for (i = 0; i < number_of_variables; ++i) {
-    double c1;
+    const double c1 = data->scales[i];
     tmpvect[i] = 0.0;
-    c1 = pow(sqrt(condition), ((double)i) / (double)(number_of_variables - 1));
     for (j = 0; j < number_of_variables; ++j) {
       tmpvect[i] += c1 * data->rot2[i][j] * (data->x_hat[j] - mu0);
     }
@@ -82,11 +82,13 @@ static double f_lunacek_bi_rastrigin_raw(const double *x, const size_t number_of
   for (i = 0; i < number_of_variables; ++i) {
     sum1 += (data->x_hat[i] - mu0) * (data->x_hat[i] - mu0);
     sum2 += (data->x_hat[i] - mu1) * (data->x_hat[i] - mu1);
-    sum3 += cos(2 * coco_pi * data->z[i]);
+  }
+  if (!COCO_SIMD_RUN(coco_simd_sum_cos_two_pi, (data->z, number_of_variables, &sum3, NULL))) {
+    for (i = 0; i < number_of_variables; ++i)
+      sum3 += cos(2 * coco_pi * data->z[i]);
   }
   result = coco_double_min(sum1, d * (double)number_of_variables + s * sum2) +
            10. * ((double)number_of_variables - sum3) + 1e4 * penalty;
-  coco_free_memory(tmpvect);
 
   return result;
 }
@@ -101,6 +103,56 @@ static void f_lunacek_bi_rastrigin_evaluate(coco_problem_t *problem,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the Lunacek bi-Rastrigin function, where the gradient of the smaller
+ * of the two spheres is used.
+ */
+static void f_lunacek_bi_rastrigin_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  f_lunacek_bi_rastrigin_data_t *data = (f_lunacek_bi_rastrigin_data_t *)problem->data;
+  const size_t number_of_variables = problem->number_of_variables;
+  size_t i, j;
+  static const double mu0 = 2.5;
+  static const double d = 1.;
+  const double s = 1. - 0.5 / (sqrt((double)(number_of_variables + 20)) - 4.1);
+  const double mu1 = -sqrt((mu0 * mu0 - d) / s);
+  double *tmpvect = data->tmpvect, *gradient = problem->scratch;
+  double tmp, sum1 = 0., sum2 = 0.;
+
+  assert(problem->scratch_size >= number_of_variables);
+  /* Fills x_hat and z */
+  f_lunacek_bi_rastrigin_raw(x, number_of_variables, data);
+
+  for (i = 0; i < number_of_variables; ++i) {
+    sum1 += (data->x_hat[i] - mu0) * (data->x_hat[i] - mu0);
+    sum2 += (data->x_hat[i] - mu1) * (data->x_hat[i] - mu1);
+  }
+  /* The gradient of the Rastrigin part with respect to z, multiplied by rot1^T and the conditioning */
+  for (j = 0; j < number_of_variables; ++j) {
+    tmpvect[j] = 0.0;
+    for (i = 0; i < number_of_variables; ++i) {
+      tmpvect[j] += data->rot1[i][j] * 20. * coco_pi * sin(2 * coco_pi * data->z[i]);
+    }
+    tmpvect[j] *= data->scales[j];
+  }
+  /* ... and by rot2^T, plus the gradient of the two spheres with respect to x_hat */
+  for (j = 0; j < number_of_variables; ++j) {
+    gradient[j] = 0.0;
+    for (i = 0; i < number_of_variables; ++i) {
+      gradient[j] += data->rot2[i][j] * tmpvect[i];
+    }
+    if (sum1 <= d * (double)number_of_variables + s * sum2)
+      gradient[j] += 2. * (data->x_hat[j] - mu0);
+    else
+      gradient[j] += 2. * s * (data->x_hat[j] - mu1);
+  }
+  for (i = 0; i < number_of_variables; ++i) {
+    y[i] = 2. * ((data->xopt[i] < 0.) ? -1. : 1.) * gradient[i];
+    tmp = fabs(x[i]) - 5.0;
+    if (tmp > 0.0)
+      y[i] += 2e4 * tmp * ((x[i] > 0.0) ? 1. : -1.);
+  }
+}
+
 /**
  * @brief Frees the Lunacek bi-Rastrigin data object.
  */
@@ -109,7 +161,9 @@ static void f_lunacek_bi_rastrigin_free(coco_problem_t *problem) {
   data = (f_lunacek_bi_rastrigin_data_t *)problem->data;
   coco_free_memory(data->x_hat);
   coco_free_memory(data->z);
+  coco_free_memory(data->tmpvect);
   coco_free_memory(data->xopt);
+  coco_free_memory(data->scales);
   bbob2009_free_matrix(data->rot1, problem->number_of_variables);
   bbob2009_free_matrix(data->rot2, problem->number_of_variables);
 
@@ -136,6 +190,7 @@ static coco_problem_t *f_lunacek_bi_rastrigin_bbob_problem_allocate(const size_t
                                          f_lunacek_bi_rastrigin_free, dimension, -5.0, 5.0, 0.0);
 
   const double mu0 = 2.5;
+  const double condition = 100.;
 
   double fopt, *tmpvect;
   size_t i;
@@ -144,10 +199,15 @@ static coco_problem_t *f_lunacek_bi_rastrigin_bbob_problem_allocate(const size_t
   /* Allocate temporary storage and space for the rotation matrices */
   data->x_hat = coco_allocate_vector(dimension);
   data->z = coco_allocate_vector(dimension);
+  data->tmpvect = coco_allocate_vector(dimension);
   data->xopt = coco_allocate_vector(dimension);
   data->rot1 = bbob2009_allocate_matrix(dimension, dimension);
   data->rot2 = bbob2009_allocate_matrix(dimension, dimension);
+  data->scales = coco_allocate_vector(dimension);
   data->rseed = rseed;
+  for (i = 0; i < dimension; ++i) {
+    data->scales[i] = pow(sqrt(condition), ((double)i) / (double)(dimension - 1));
+  }
 
   data->fopt = bbob2009_compute_fopt(24, instance);
   if (coco_strfind(problem_name_template, "bbob-boxed suite problem") >= 0) {
@@ -159,6 +219,7 @@ static coco_problem_t *f_lunacek_bi_rastrigin_bbob_problem_allocate(const size_t
   bbob2009_compute_rotation(data->rot2, rseed, dimension);
 
   problem->data = data;
+  problem->evaluate_gradient = f_lunacek_bi_rastrigin_evaluate_gradient;
 
   /* Compute best solution */
   tmpvect = coco_allocate_vector(dimension);
@@ -206,6 +267,7 @@ f_lunacek_bi_rastrigin_versatile_data_free(coco_problem_t *problem) {
   }
 
   coco_free_memory(versatile_data->x_hat); /*Manh: free the x_hat*/
+  coco_free_memory(versatile_data->x_hat_gradient);
   coco_free_memory(versatile_data);
   problem->versatile_data = NULL;
   problem->problem_free_function = NULL;
@@ -233,6 +295,7 @@ f_lunacek_bi_rastrigin_sub_problem_allocate(const size_t number_of_variables) {
       coco_problem_allocate_from_scalars("lunacek_bi_rastrigin_sub function", f_lunacek_bi_rastrigin_sub_evaluate_core,
                                          NULL, number_of_variables, -5.0, 5.0, 0.0);
   problem_i->versatile_data = NULL;
+  problem_i->evaluate_gradient = f_sphere_evaluate_gradient;
   coco_problem_set_id(problem_i, "%s_d%04lu", "lunacek_bi_rastrigin_sub",
                       number_of_variables);
   f_lunacek_bi_rastrigin_sub_evaluate_core(problem_i, problem_i->best_parameter,
@@ -285,6 +348,27 @@ static void f_lunacek_bi_rastrigin_evaluate_core(coco_problem_t *problem,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the core function with respect to x and stores the gradient of the
+ * smaller sub-problem with respect to x_hat in versatile_data (see transform_vars_x_hat_generic.c).
+ */
+static void f_lunacek_bi_rastrigin_evaluate_gradient_core(coco_problem_t *problem, const double *x, double *y) {
+  f_lunacek_bi_rastrigin_versatile_data_t *versatile_data =
+      (f_lunacek_bi_rastrigin_versatile_data_t *)problem->versatile_data;
+  coco_problem_t *sub_problem;
+  double y0, y1;
+  size_t i;
+
+  versatile_data->sub_problem_mu0->evaluate_function(versatile_data->sub_problem_mu0, versatile_data->x_hat, &y0);
+  versatile_data->sub_problem_mu1->evaluate_function(versatile_data->sub_problem_mu1, versatile_data->x_hat, &y1);
+  sub_problem = (y0 <= y1) ? versatile_data->sub_problem_mu0 : versatile_data->sub_problem_mu1;
+  bbob_evaluate_gradient(sub_problem, versatile_data->x_hat, versatile_data->x_hat_gradient);
+
+  for (i = 0; i < problem->number_of_variables; i++) {
+    y[i] = 20.0 * coco_pi * sin(2 * coco_pi * x[i]);
+  }
+}
+
 /**
  * @brief Allocates the basic lunacek_bi_rastrigin problem.
  */
@@ -299,7 +383,10 @@ f_lunacek_bi_rastrigin_problem_allocate(const size_t number_of_variables) {
       (f_lunacek_bi_rastrigin_versatile_data_t *)coco_allocate_memory(sizeof(f_lunacek_bi_rastrigin_versatile_data_t));
   ((f_lunacek_bi_rastrigin_versatile_data_t *)problem->versatile_data)->x_hat =
       coco_allocate_vector(number_of_variables); /* Manh: Allocate x_hat in versatile_data */
+  ((f_lunacek_bi_rastrigin_versatile_data_t *)problem->versatile_data)->x_hat_gradient =
+      coco_allocate_vector(number_of_variables);
   coco_problem_set_id(problem, "%s_d%04lu", "lunacek_bi_rastrigin", number_of_variables);
+  problem->evaluate_gradient = f_lunacek_bi_rastrigin_evaluate_gradient_core;
   /* Compute the best solution later once the sub-problems are well defined */
   *(problem->best_value) = 0; /* Manh: set default value to avoid assert() in transformation later*/
   return problem;
@@ -316,10 +403,8 @@ static coco_problem_t *f_lunacek_bi_rastrigin_permblockdiag_bbob_problem_allocat
   double penalty_factor = 1e4;
   coco_problem_t *problem = NULL, **sub_problem_tmp;
 
-  double **B1, **B2;
-  const double *const *B1_copy;
-  const double *const *B2_copy;
-  size_t *P11, *P12, *P21, *P22;
+  const double *const *B1, *const *B2;
+  const size_t *P11, *P12, *P21, *P22;
   size_t *block_sizes1, *block_sizes2;
   size_t nb_blocks1, nb_blocks2;
   size_t swap_range1, swap_range2;
@@ -345,26 +430,13 @@ static coco_problem_t *f_lunacek_bi_rastrigin_permblockdiag_bbob_problem_allocat
   nb_swaps1 = coco_get_nb_swaps(dimension, "bbob-largescale");
   nb_swaps2 = coco_get_nb_swaps(dimension, "bbob-largescale");
 
-  B1 = coco_allocate_blockmatrix(dimension, block_sizes1, nb_blocks1);
-  B2 = coco_allocate_blockmatrix(dimension, block_sizes2, nb_blocks2);
-  B1_copy = (const double *const *)B1;
-  B2_copy = (const double *const *)B2;
-  coco_compute_blockrotation(B1, rseed + 1000000, dimension, block_sizes1,
-                             nb_blocks1);
-  coco_compute_blockrotation(B2, rseed, dimension, block_sizes2, nb_blocks2);
-
-  P11 = coco_allocate_vector_size_t(dimension);
-  P12 = coco_allocate_vector_size_t(dimension);
-  P21 = coco_allocate_vector_size_t(dimension);
-  P22 = coco_allocate_vector_size_t(dimension);
-  coco_compute_truncated_uniform_swap_permutation(
-      P11, rseed + 3000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(
-      P12, rseed + 4000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(
-      P21, rseed + 5000000, dimension, nb_swaps2, swap_range2);
-  coco_compute_truncated_uniform_swap_permutation(
-      P22, rseed + 6000000, dimension, nb_swaps2, swap_range2);
+  B1 = coco_cache_get_blockrotation(rseed + 1000000, dimension, block_sizes1, nb_blocks1);
+  B2 = coco_cache_get_blockrotation(rseed, dimension, block_sizes2, nb_blocks2);
+
+  P11 = coco_cache_get_permutation(rseed + 3000000, dimension, nb_swaps1, swap_range1);
+  P12 = coco_cache_get_permutation(rseed + 4000000, dimension, nb_swaps1, swap_range1);
+  P21 = coco_cache_get_permutation(rseed + 5000000, dimension, nb_swaps2, swap_range2);
+  P22 = coco_cache_get_permutation(rseed + 6000000, dimension, nb_swaps2, swap_range2);
 
   problem = f_lunacek_bi_rastrigin_problem_allocate(dimension);
 
@@ -404,13 +476,13 @@ static coco_problem_t *f_lunacek_bi_rastrigin_permblockdiag_bbob_problem_allocat
 
   /* transformations on main problem */
   problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B1, dimension,
                                          block_sizes1, nb_blocks1);
   problem = transform_vars_permutation(problem, P21, dimension);
   problem = transform_vars_conditioning(problem, condition);
 
   problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B2, dimension,
                                          block_sizes2, nb_blocks2);
   problem = transform_vars_permutation(problem, P11, dimension);
   problem = transform_vars_shift(problem, mu0_vector, 0);
@@ -436,12 +508,12 @@ static coco_problem_t *f_lunacek_bi_rastrigin_permblockdiag_bbob_problem_allocat
   coco_problem_set_type(problem, "5-weakly-structured");
 
   coco_free_memory(tmp_normal);
-  coco_free_block_matrix(B1, dimension);
-  coco_free_block_matrix(B2, dimension);
-  coco_free_memory(P11);
-  coco_free_memory(P12);
-  coco_free_memory(P21);
-  coco_free_memory(P22);
+  coco_cache_release(B1);
+  coco_cache_release(B2);
+  coco_cache_release(P11);
+  coco_cache_release(P12);
+  coco_cache_release(P21);
+  coco_cache_release(P22);
   coco_free_memory(block_sizes1);
   coco_free_memory(block_sizes2);
   coco_free_memory(mu0_vector);
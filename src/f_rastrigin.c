@@ -9,6 +9,7 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_simd.c"
 #include "coco_utilities.c"
 #include "suite_bbob_legacy_code.c"
 #include "transform_obj_norm_by_dim.c"
@@ -35,9 +36,11 @@ static double f_rastrigin_raw(const double *x,
   if (coco_vector_contains_nan(x, number_of_variables))
     return NAN;
 
-  for (i = 0; i < number_of_variables; ++i) {
-    sum1 += cos(coco_two_pi * x[i]);
-    sum2 += x[i] * x[i];
+  if (!COCO_SIMD_RUN(coco_simd_sum_cos_two_pi, (x, number_of_variables, &sum1, &sum2))) {
+    for (i = 0; i < number_of_variables; ++i) {
+      sum1 += cos(coco_two_pi * x[i]);
+      sum2 += x[i] * x[i];
+    }
   }
   if (coco_is_inf(sum2)) /* cos(inf) -> nan */
     return sum2;
@@ -135,10 +138,9 @@ static coco_problem_t *f_rastrigin_rotated_bbob_problem_allocate(const size_t fu
                                                                  const char *problem_name_template) {
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
-  size_t i, j, k;
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
-  double *current_row, **rot1, **rot2;
+  double **rot1, **rot2;
 
   xopt = coco_allocate_vector(dimension);
   fopt = bbob2009_compute_fopt(function, instance);
@@ -152,17 +154,7 @@ static coco_problem_t *f_rastrigin_rotated_bbob_problem_allocate(const size_t fu
   rot2 = bbob2009_allocate_matrix(dimension, dimension);
   bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
   bbob2009_compute_rotation(rot2, rseed, dimension);
-  for (i = 0; i < dimension; ++i) {
-    b[i] = 0.0;
-    current_row = M + i * dimension;
-    for (j = 0; j < dimension; ++j) {
-      current_row[j] = 0.0;
-      for (k = 0; k < dimension; ++k) {
-        double exponent = 1.0 * (int)k / ((double)(long)dimension - 1.0);
-        current_row[j] += rot1[i][k] * pow(sqrt(10), exponent) * rot2[k][j];
-      }
-    }
-  }
+  bbob2009_compute_scaled_rotation_product(M, b, rot1, sqrt(10), rot2, dimension);
 
   problem = f_rastrigin_allocate(dimension);
   problem = transform_obj_shift(problem, fopt);
@@ -195,14 +187,12 @@ static coco_problem_t *f_rastrigin_permblockdiag_bbob_problem_allocate(const siz
                                                                        const char *problem_name_template) {
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
-  double **B1;
-  double **B2;
-  const double *const *B1_copy;
-  const double *const *B2_copy;
-  size_t *P11 = coco_allocate_vector_size_t(dimension);
-  size_t *P12 = coco_allocate_vector_size_t(dimension);
-  size_t *P21 = coco_allocate_vector_size_t(dimension);
-  size_t *P22 = coco_allocate_vector_size_t(dimension);
+  const double *const *B1;
+  const double *const *B2;
+  const size_t *P11;
+  const size_t *P12;
+  const size_t *P21;
+  const size_t *P22;
   size_t *block_sizes1, *block_sizes2;
   size_t nb_blocks1, nb_blocks2;
   size_t swap_range1, swap_range2;
@@ -225,34 +215,28 @@ static coco_problem_t *f_rastrigin_permblockdiag_bbob_problem_allocate(const siz
     bbob2009_compute_xopt(xopt, rseed, dimension);
   }
 
-  B1 = coco_allocate_blockmatrix(dimension, block_sizes1, nb_blocks1);
-  B2 = coco_allocate_blockmatrix(dimension, block_sizes2, nb_blocks2);
-  B1_copy = (const double *const *)B1;
-  B2_copy = (const double *const *)B2;
+  B1 = coco_cache_get_blockrotation(rseed + 1000000, dimension, block_sizes1, nb_blocks1);
+  B2 = coco_cache_get_blockrotation(rseed, dimension, block_sizes2, nb_blocks2);
 
-  coco_compute_blockrotation(B1, rseed + 1000000, dimension, block_sizes1,
-                             nb_blocks1);
-  coco_compute_blockrotation(B2, rseed, dimension, block_sizes2, nb_blocks2);
-
-  coco_compute_truncated_uniform_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(P12, rseed + 4000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(P21, rseed + 5000000, dimension, nb_swaps2, swap_range2);
-  coco_compute_truncated_uniform_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps2, swap_range2);
+  P11 = coco_cache_get_permutation(rseed + 3000000, dimension, nb_swaps1, swap_range1);
+  P12 = coco_cache_get_permutation(rseed + 4000000, dimension, nb_swaps1, swap_range1);
+  P21 = coco_cache_get_permutation(rseed + 5000000, dimension, nb_swaps2, swap_range2);
+  P22 = coco_cache_get_permutation(rseed + 6000000, dimension, nb_swaps2, swap_range2);
 
   problem = f_rastrigin_allocate(dimension);
   problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B1, dimension,
                                          block_sizes1, nb_blocks1);
   problem = transform_vars_permutation(problem, P11, dimension);
   problem = transform_vars_conditioning(problem, 10.0);
   problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B2, dimension,
                                          block_sizes2, nb_blocks2);
   problem = transform_vars_permutation(problem, P21, dimension);
   problem = transform_vars_asymmetric(problem, 0.2);
   problem = transform_vars_oscillate(problem);
   problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B1, dimension,
                                          block_sizes1, nb_blocks1);
   problem = transform_vars_permutation(problem, P11, dimension);
   problem = transform_vars_shift(problem, xopt, 0);
@@ -266,12 +250,12 @@ static coco_problem_t *f_rastrigin_permblockdiag_bbob_problem_allocate(const siz
                         dimension);
   coco_problem_set_type(problem, "4-multi-modal");
 
-  coco_free_block_matrix(B1, dimension);
-  coco_free_block_matrix(B2, dimension);
-  coco_free_memory(P11);
-  coco_free_memory(P12);
-  coco_free_memory(P21);
-  coco_free_memory(P22);
+  coco_cache_release(B1);
+  coco_cache_release(B2);
+  coco_cache_release(P11);
+  coco_cache_release(P12);
+  coco_cache_release(P21);
+  coco_cache_release(P22);
   coco_free_memory(block_sizes1);
   coco_free_memory(block_sizes2);
   coco_free_memory(xopt);
@@ -341,14 +325,10 @@ static coco_problem_t *f_rastrigin_rotated_cons_bbob_problem_allocate(const size
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
 
-  double *M = coco_allocate_vector(dimension * dimension);
-  double *b = coco_allocate_vector(dimension);
-  double **rot1;
+  const double *M;
+  double *b = coco_allocate_vector_with_value(dimension, 0.0);
 
-  rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
-  bbob2009_copy_rotation_matrix(rot1, M, b, dimension);
-  bbob2009_free_matrix(rot1, dimension);
+  M = coco_cache_get_rotation(rseed + 1000000, dimension);
 
   xopt = coco_allocate_vector(dimension);
   f_rastrigin_cons_compute_xopt(xopt, rseed, dimension);
@@ -365,7 +345,7 @@ static coco_problem_t *f_rastrigin_rotated_cons_bbob_problem_allocate(const size
                         dimension);
   coco_problem_set_type(problem, "1-separable");
 
-  coco_free_memory(M);
+  coco_cache_release(M);
   coco_free_memory(b);
   coco_free_memory(xopt);
   return problem;
@@ -53,6 +53,23 @@ static void f_rosenbrock_evaluate(coco_problem_t *problem, const double *x,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the Rosenbrock function.
+ */
+static void f_rosenbrock_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  double tmp;
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] = 0.0;
+  }
+  for (i = 0; i < problem->number_of_variables - 1; ++i) {
+    tmp = (x[i] * x[i] - x[i + 1]);
+    y[i] += 400.0 * tmp * x[i] + 2.0 * (x[i] - 1.0);
+    y[i + 1] -= 200.0 * tmp;
+  }
+}
+
 /**
  * @brief Allocates the basic Rosenbrock problem.
  */
@@ -61,6 +78,7 @@ static coco_problem_t *f_rosenbrock_allocate(const size_t number_of_variables) {
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Rosenbrock function", f_rosenbrock_evaluate, NULL,
                                                                number_of_variables, -5.0, 5.0, 1.0);
   coco_problem_set_id(problem, "%s_d%02lu", "rosenbrock", number_of_variables);
+  problem->evaluate_gradient = f_rosenbrock_evaluate_gradient;
 
   /* Compute best solution */
   f_rosenbrock_evaluate(problem, problem->best_parameter, problem->best_value);
@@ -195,10 +213,9 @@ static coco_problem_t *f_rosenbrock_permblockdiag_bbob_problem_allocate(const si
   double *minus_one, factor;
   size_t i;
 
-  double **B;
-  const double *const *B_copy;
-  size_t *P1 = coco_allocate_vector_size_t(dimension);
-  size_t *P2 = coco_allocate_vector_size_t(dimension);
+  const double *const *B;
+  const size_t *P1;
+  const size_t *P2;
   size_t *block_sizes;
   size_t block_size;
   size_t nb_blocks;
@@ -227,20 +244,15 @@ static coco_problem_t *f_rosenbrock_permblockdiag_bbob_problem_allocate(const si
     xopt[i] *= 0.75;
   }
 
-  B = coco_allocate_blockmatrix(dimension, block_sizes, nb_blocks);
-  B_copy = (const double *const *)B;
-
-  coco_compute_blockrotation(B, rseed, dimension, block_sizes, nb_blocks);
-  coco_compute_truncated_uniform_swap_permutation(
-      P1, rseed + 2000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(
-      P2, rseed + 3000000, dimension, nb_swaps, swap_range);
+  B = coco_cache_get_blockrotation(rseed, dimension, block_sizes, nb_blocks);
+  P1 = coco_cache_get_permutation(rseed + 2000000, dimension, nb_swaps, swap_range);
+  P2 = coco_cache_get_permutation(rseed + 3000000, dimension, nb_swaps, swap_range);
 
   problem = f_rosenbrock_allocate(dimension);
   problem = transform_vars_shift(problem, minus_one, 0);
   problem = transform_vars_scale(problem, factor);
   problem = transform_vars_permutation(problem, P2, dimension);
-  problem = transform_vars_blockrotation(problem, B_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B, dimension,
                                          block_sizes, nb_blocks);
   problem = transform_vars_permutation(problem, P1, dimension);
 
@@ -255,9 +267,9 @@ static coco_problem_t *f_rosenbrock_permblockdiag_bbob_problem_allocate(const si
   coco_free_memory(xopt);
   coco_free_memory(best_parameter);
   coco_free_memory(minus_one);
-  coco_free_block_matrix(B, dimension);
-  coco_free_memory(P1);
-  coco_free_memory(P2);
+  coco_cache_release(B);
+  coco_cache_release(P1);
+  coco_cache_release(P2);
   coco_free_memory(block_sizes);
   return problem;
 }
@@ -10,6 +10,7 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_simd.c"
 #include "suite_bbob_legacy_code.c"
 #include "transform_obj_norm_by_dim.c"
 #include "transform_obj_penalize.c"
@@ -19,6 +20,47 @@
 #include "transform_vars_blockrotation.c"
 #include "transform_obj_norm_by_dim.c"
 
+#if COCO_SIMD_ENABLED
+/**
+ * @brief SIMD version of the sum of the Schaffer's F7 function, with pow() computed from exp() and log().
+ *
+ * Returns 0 if a summand is zero or outside of the range of the vector functions.
+ */
+COCO_SIMD_INLINE int f_schaffers_simd_body(const double *x, const size_t number_of_variables, double *result) {
+  coco_simd_vector_t sum = {0};
+  coco_simd_bits_t invalid = {0};
+  size_t i;
+
+  for (i = 0; i + COCO_SIMD_WIDTH < number_of_variables; i += COCO_SIMD_WIDTH) {
+    const coco_simd_vector_t xi = coco_simd_load(x + i);
+    const coco_simd_vector_t xj = coco_simd_load(x + i + 1);
+    const coco_simd_vector_t tmp = xi * xi + xj * xj;
+    const coco_simd_vector_t log_tmp = coco_simd_log(&tmp, &invalid);
+    coco_simd_vector_t power, sin_tmp;
+
+    power = 0.1 * log_tmp;
+    power = 50.0 * coco_simd_exp(&power, &invalid);
+    sin_tmp = coco_simd_sin(&power, &invalid);
+    power = 0.25 * log_tmp;
+    sum += coco_simd_exp(&power, &invalid) * (1.0 + sin_tmp * sin_tmp);
+  }
+  if (coco_simd_any(&invalid))
+    return 0;
+  *result = coco_simd_sum(&sum);
+  for (; i < number_of_variables - 1; ++i) {
+    const double tmp = x[i] * x[i] + x[i + 1] * x[i + 1];
+    const double sin_tmp = sin(50.0 * pow(tmp, 0.1));
+    if (coco_is_inf(tmp))
+      return 0;
+    *result += pow(tmp, 0.25) * (1.0 + sin_tmp * sin_tmp);
+  }
+  return 1;
+}
+
+COCO_SIMD_DEFINE_KERNEL(f_schaffers_simd, (const double *x, const size_t number_of_variables, double *result),
+                        (x, number_of_variables, result))
+#endif
+
 /**
  * @brief Implements the Schaffer's F7 function without connections to any COCO
  * structures.
@@ -36,14 +78,18 @@ static double f_schaffers_raw(const double *x,
 
   /* Computation core */
   result = 0.0;
-  for (i = 0; i < number_of_variables - 1; ++i) {
-    const double tmp = x[i] * x[i] + x[i + 1] * x[i + 1];
-    if (coco_is_inf(tmp) && coco_is_nan(sin(50.0 * pow(tmp, 0.1)))) /* sin(inf) -> nan */
-      /* the second condition is necessary to pass the integration tests under Windows and Linux */
-      return tmp;
-    result += pow(tmp, 0.25) * (1.0 + pow(sin(50.0 * pow(tmp, 0.1)), 2.0));
+  if (!COCO_SIMD_RUN(f_schaffers_simd, (x, number_of_variables, &result))) {
+    for (i = 0; i < number_of_variables - 1; ++i) {
+      const double tmp = x[i] * x[i] + x[i + 1] * x[i + 1];
+      const double sin_tmp = sin(50.0 * pow(tmp, 0.1));
+      if (coco_is_inf(tmp) && coco_is_nan(sin_tmp)) /* sin(inf) -> nan */
+        /* the second condition is necessary to pass the integration tests under Windows and Linux */
+        return tmp;
+      result += pow(tmp, 0.25) * (1.0 + sin_tmp * sin_tmp);
+    }
   }
-  result = pow(result / ((double)(long)number_of_variables - 1.0), 2.0);
+  result /= (double)(long)number_of_variables - 1.0;
+  result = result * result;
 
   return result;
 }
@@ -58,6 +104,36 @@ static void f_schaffers_evaluate(coco_problem_t *problem, const double *x,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the Schaffer's F7 function (where x[i] = x[i + 1] = 0, the terms that
+ * are not differentiable contribute nothing).
+ */
+static void f_schaffers_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  const size_t number_of_variables = problem->number_of_variables;
+  size_t i = 0;
+  double sum = 0.0, derivative;
+
+  for (i = 0; i < number_of_variables; ++i) {
+    y[i] = 0.0;
+  }
+  for (i = 0; i < number_of_variables - 1; ++i) {
+    const double tmp = x[i] * x[i] + x[i + 1] * x[i + 1];
+    const double sin_tmp = sin(50.0 * pow(tmp, 0.1));
+    sum += pow(tmp, 0.25) * (1.0 + sin_tmp * sin_tmp);
+    if (tmp > 0.0) {
+      /* The derivative of the summand with respect to tmp */
+      derivative = 0.25 * pow(tmp, -0.75) * (1.0 + sin_tmp * sin_tmp) +
+                   5.0 * pow(tmp, -0.65) * sin(100.0 * pow(tmp, 0.1));
+      y[i] += derivative * 2.0 * x[i];
+      y[i + 1] += derivative * 2.0 * x[i + 1];
+    }
+  }
+  sum /= (double)(long)number_of_variables - 1.0;
+  for (i = 0; i < number_of_variables; ++i) {
+    y[i] *= 2.0 * sum / ((double)(long)number_of_variables - 1.0);
+  }
+}
+
 /**
  * @brief Allocates the basic Schaffer's F7 problem.
  */
@@ -66,6 +142,7 @@ static coco_problem_t *f_schaffers_allocate(const size_t number_of_variables) {
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Schaffer's function", f_schaffers_evaluate, NULL,
                                                                number_of_variables, -5.0, 5.0, 0.0);
   coco_problem_set_id(problem, "%s_d%02lu", "schaffers", number_of_variables);
+  problem->evaluate_gradient = f_schaffers_evaluate_gradient;
 
   /* Compute best solution */
   f_schaffers_evaluate(problem, problem->best_parameter, problem->best_value);
@@ -144,14 +221,12 @@ static coco_problem_t *f_schaffers_permblockdiag_bbob_problem_allocate(const siz
                                                                        const char *problem_name_template) {
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
-  double **B1;
-  double **B2;
-  const double *const *B1_copy;
-  const double *const *B2_copy;
-  size_t *P11 = coco_allocate_vector_size_t(dimension);
-  size_t *P21 = coco_allocate_vector_size_t(dimension);
-  size_t *P12 = coco_allocate_vector_size_t(dimension);
-  size_t *P22 = coco_allocate_vector_size_t(dimension);
+  const double *const *B1;
+  const double *const *B2;
+  const size_t *P11;
+  const size_t *P21;
+  const size_t *P12;
+  const size_t *P22;
   size_t *block_sizes1;
   size_t *block_sizes2;
   size_t nb_blocks1;
@@ -174,28 +249,23 @@ static coco_problem_t *f_schaffers_permblockdiag_bbob_problem_allocate(const siz
     bbob2009_compute_xopt(xopt, rseed, dimension);
   }
 
-  B1 = coco_allocate_blockmatrix(dimension, block_sizes1, nb_blocks1);
-  B2 = coco_allocate_blockmatrix(dimension, block_sizes2, nb_blocks2);
-  B1_copy = (const double *const *)B1;
-  B2_copy = (const double *const *)B2;
-
-  coco_compute_blockrotation(B1, rseed + 1000000, dimension, block_sizes1, nb_blocks1);
-  coco_compute_blockrotation(B2, rseed, dimension, block_sizes2, nb_blocks2);
+  B1 = coco_cache_get_blockrotation(rseed + 1000000, dimension, block_sizes1, nb_blocks1);
+  B2 = coco_cache_get_blockrotation(rseed, dimension, block_sizes2, nb_blocks2);
 
-  coco_compute_truncated_uniform_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P21, rseed + 4000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P12, rseed + 5000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps, swap_range);
+  P11 = coco_cache_get_permutation(rseed + 3000000, dimension, nb_swaps, swap_range);
+  P21 = coco_cache_get_permutation(rseed + 4000000, dimension, nb_swaps, swap_range);
+  P12 = coco_cache_get_permutation(rseed + 5000000, dimension, nb_swaps, swap_range);
+  P22 = coco_cache_get_permutation(rseed + 6000000, dimension, nb_swaps, swap_range);
 
   problem = f_schaffers_allocate(dimension);
   problem = transform_vars_conditioning(problem, conditioning);
   problem = transform_vars_permutation(problem, P21, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
+  problem = transform_vars_blockrotation(problem, B2, dimension, block_sizes2, nb_blocks2);
   problem = transform_vars_permutation(problem, P11, dimension);
 
   problem = transform_vars_asymmetric(problem, 0.5);
   problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
+  problem = transform_vars_blockrotation(problem, B1, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_permutation(problem, P12, dimension);
 
   problem = transform_vars_shift(problem, xopt, 0);
@@ -206,12 +276,12 @@ static coco_problem_t *f_schaffers_permblockdiag_bbob_problem_allocate(const siz
   coco_problem_set_name(problem, problem_name_template, function, instance, dimension);
   coco_problem_set_type(problem, "4-multi-modal");
 
-  coco_free_block_matrix(B1, dimension);
-  coco_free_block_matrix(B2, dimension);
-  coco_free_memory(P11);
-  coco_free_memory(P21);
-  coco_free_memory(P12);
-  coco_free_memory(P22);
+  coco_cache_release(B1);
+  coco_cache_release(B2);
+  coco_cache_release(P11);
+  coco_cache_release(P21);
+  coco_cache_release(P12);
+  coco_cache_release(P22);
   coco_free_memory(block_sizes1);
   coco_free_memory(block_sizes2);
   coco_free_memory(xopt);
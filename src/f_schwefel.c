@@ -60,6 +60,23 @@ static void f_schwefel_evaluate(coco_problem_t *problem, const double *x,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the Schwefel function.
+ */
+static void f_schwefel_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  double root;
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    const double tmp = fabs(x[i]) - 500.0;
+    root = sqrt(fabs(x[i]));
+    y[i] = -(sin(root) + 0.5 * root * cos(root)) / (double)problem->number_of_variables;
+    if (tmp > 0.0)
+      y[i] += 2.0 * tmp * ((x[i] > 0.0) ? 1.0 : -1.0);
+    y[i] *= 0.01;
+  }
+}
+
 /**
  * @brief Allocates the basic Schwefel problem.
  */
@@ -68,6 +85,7 @@ static coco_problem_t *f_schwefel_allocate(const size_t number_of_variables) {
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Schwefel function", f_schwefel_evaluate, NULL,
                                                                number_of_variables, -5.0, 5.0, 420.96874633);
   coco_problem_set_id(problem, "%s_d%02lu", "schwefel", number_of_variables);
+  problem->evaluate_gradient = f_schwefel_evaluate_gradient;
 
   /* Compute best solution: best_parameter[i] = 200 * fabs(xopt[i]) */
   f_schwefel_evaluate(problem, problem->best_parameter, problem->best_value);
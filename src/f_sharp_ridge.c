@@ -53,6 +53,25 @@ static void f_sharp_ridge_evaluate(coco_problem_t *problem, const double *x,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the sharp ridge function (which is set to zero in the coordinates of the
+ * ridge on the ridge itself).
+ */
+static void f_sharp_ridge_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  static const double alpha = 100.0;
+  size_t i;
+  double norm = 0.0;
+
+  for (i = 1; i < problem->number_of_variables; ++i) {
+    norm += x[i] * x[i];
+  }
+  norm = sqrt(norm);
+  y[0] = 2.0 * x[0];
+  for (i = 1; i < problem->number_of_variables; ++i) {
+    y[i] = (norm > 0.0) ? alpha * x[i] / norm : 0.0;
+  }
+}
+
 /**
  * @brief Allocates the basic sharp ridge problem.
  */
@@ -62,6 +81,7 @@ f_sharp_ridge_allocate(const size_t number_of_variables) {
   coco_problem_t *problem = coco_problem_allocate_from_scalars("sharp ridge function", f_sharp_ridge_evaluate, NULL,
                                                                number_of_variables, -5.0, 5.0, 0.0);
   coco_problem_set_id(problem, "%s_d%02lu", "sharp_ridge", number_of_variables);
+  problem->evaluate_gradient = f_sharp_ridge_evaluate_gradient;
 
   /* Compute best solution */
   f_sharp_ridge_evaluate(problem, problem->best_parameter, problem->best_value);
@@ -77,10 +97,9 @@ static coco_problem_t *f_sharp_ridge_bbob_problem_allocate(const size_t function
                                                            const char *problem_name_template) {
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
-  size_t i, j, k;
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
-  double *current_row, **rot1, **rot2;
+  double **rot1, **rot2;
 
   xopt = coco_allocate_vector(dimension);
   fopt = bbob2009_compute_fopt(function, instance);
@@ -94,17 +113,7 @@ static coco_problem_t *f_sharp_ridge_bbob_problem_allocate(const size_t function
   rot2 = bbob2009_allocate_matrix(dimension, dimension);
   bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
   bbob2009_compute_rotation(rot2, rseed, dimension);
-  for (i = 0; i < dimension; ++i) {
-    b[i] = 0.0;
-    current_row = M + i * dimension;
-    for (j = 0; j < dimension; ++j) {
-      current_row[j] = 0.0;
-      for (k = 0; k < dimension; ++k) {
-        double exponent = 1.0 * (int)k / ((double)(long)dimension - 1.0);
-        current_row[j] += rot1[i][k] * pow(sqrt(10), exponent) * rot2[k][j];
-      }
-    }
-  }
+  bbob2009_compute_scaled_rotation_product(M, b, rot1, sqrt(10), rot2, dimension);
   bbob2009_free_matrix(rot1, dimension);
   bbob2009_free_matrix(rot2, dimension);
   problem = f_sharp_ridge_allocate(dimension);
@@ -85,6 +85,33 @@ static void f_sharp_ridge_generalized_evaluate(coco_problem_t *problem,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the generalized sharp ridge function (which is set to zero in the
+ * coordinates of the ridge on the ridge itself).
+ */
+static void f_sharp_ridge_generalized_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  static const double alpha = 100.0;
+  f_sharp_ridge_generalized_versatile_data_t *versatile_data =
+      (f_sharp_ridge_generalized_versatile_data_t *)problem->versatile_data;
+  size_t i, number_linear_dimensions;
+  double norm = 0.0;
+
+  number_linear_dimensions = problem->number_of_variables / versatile_data->proportion_of_linear_dims;
+  if (problem->number_of_variables % versatile_data->proportion_of_linear_dims != 0) {
+    number_linear_dimensions += 1;
+  }
+  for (i = number_linear_dimensions; i < problem->number_of_variables; ++i) {
+    norm += x[i] * x[i];
+  }
+  norm = sqrt(norm);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    if (i < number_linear_dimensions)
+      y[i] = 2.0 * x[i];
+    else
+      y[i] = (norm > 0.0) ? alpha * x[i] / norm : 0.0;
+  }
+}
+
 /**
  * @brief Allocates the basic sharp ridge problem.
  */
@@ -96,6 +123,7 @@ static coco_problem_t *f_sharp_ridge_generalized_allocate(const size_t number_of
       number_of_variables, -5.0, 5.0, 0.0);
 
   coco_problem_set_id(problem, "%s_d%02lu", "sharp_ridge_generalized", number_of_variables);
+  problem->evaluate_gradient = f_sharp_ridge_generalized_evaluate_gradient;
   problem->versatile_data = (f_sharp_ridge_generalized_versatile_data_t *)coco_allocate_memory(
       sizeof(f_sharp_ridge_generalized_versatile_data_t));
   ((f_sharp_ridge_generalized_versatile_data_t *)problem->versatile_data)->proportion_of_linear_dims =
@@ -117,14 +145,12 @@ static coco_problem_t *f_sharp_ridge_generalized_permblockdiag_bbob_problem_allo
     const char *problem_id_template, const char *problem_name_template) {
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
-  double **B1;
-  double **B2;
-  const double *const *B1_copy;
-  const double *const *B2_copy;
-  size_t *P11 = coco_allocate_vector_size_t(dimension);
-  size_t *P21 = coco_allocate_vector_size_t(dimension);
-  size_t *P12 = coco_allocate_vector_size_t(dimension);
-  size_t *P22 = coco_allocate_vector_size_t(dimension);
+  const double *const *B1;
+  const double *const *B2;
+  const size_t *P11;
+  const size_t *P21;
+  const size_t *P12;
+  const size_t *P22;
   size_t *block_sizes1;
   size_t *block_sizes2;
   size_t nb_blocks1;
@@ -149,27 +175,22 @@ static coco_problem_t *f_sharp_ridge_generalized_permblockdiag_bbob_problem_allo
     bbob2009_compute_xopt(xopt, rseed, dimension);
   }
 
-  B1 = coco_allocate_blockmatrix(dimension, block_sizes1, nb_blocks1);
-  B2 = coco_allocate_blockmatrix(dimension, block_sizes2, nb_blocks2);
-  B1_copy = (const double *const *)B1;
-  B2_copy = (const double *const *)B2;
-
-  coco_compute_blockrotation(B1, rseed + 1000000, dimension, block_sizes1, nb_blocks1);
-  coco_compute_blockrotation(B2, rseed, dimension, block_sizes2, nb_blocks2);
+  B1 = coco_cache_get_blockrotation(rseed + 1000000, dimension, block_sizes1, nb_blocks1);
+  B2 = coco_cache_get_blockrotation(rseed, dimension, block_sizes2, nb_blocks2);
 
-  coco_compute_truncated_uniform_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P21, rseed + 4000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P12, rseed + 5000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps, swap_range);
+  P11 = coco_cache_get_permutation(rseed + 3000000, dimension, nb_swaps, swap_range);
+  P21 = coco_cache_get_permutation(rseed + 4000000, dimension, nb_swaps, swap_range);
+  P12 = coco_cache_get_permutation(rseed + 5000000, dimension, nb_swaps, swap_range);
+  P22 = coco_cache_get_permutation(rseed + 6000000, dimension, nb_swaps, swap_range);
 
   problem = f_sharp_ridge_generalized_allocate(dimension, proportion_of_linear_dims);
   problem = transform_vars_permutation(problem, P21, dimension); /* LIFO */
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
+  problem = transform_vars_blockrotation(problem, B1, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_permutation(problem, P11, dimension);
   problem = transform_vars_conditioning(problem, 10.0);
   problem =
       transform_vars_permutation(problem, P22, dimension); /*Consider replacing P11 and 22 by a single permutation P3*/
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
+  problem = transform_vars_blockrotation(problem, B2, dimension, block_sizes2, nb_blocks2);
   problem = transform_vars_permutation(problem, P12, dimension);
   problem = transform_vars_shift(problem, xopt, 0);
 
@@ -180,12 +201,12 @@ static coco_problem_t *f_sharp_ridge_generalized_permblockdiag_bbob_problem_allo
   coco_problem_set_name(problem, problem_name_template, function, instance, dimension);
   coco_problem_set_type(problem, "3-ill-conditioned");
 
-  coco_free_block_matrix(B1, dimension);
-  coco_free_block_matrix(B2, dimension);
-  coco_free_memory(P11);
-  coco_free_memory(P21);
-  coco_free_memory(P12);
-  coco_free_memory(P22);
+  coco_cache_release(B1);
+  coco_cache_release(B2);
+  coco_cache_release(P11);
+  coco_cache_release(P21);
+  coco_cache_release(P12);
+  coco_cache_release(P22);
   coco_free_memory(block_sizes1);
   coco_free_memory(block_sizes2);
   coco_free_memory(xopt);
@@ -34,6 +34,8 @@ typedef struct {
   double *x, *xx;
   double *xopt, fopt, penalty_scale;
   double **rot1, **rot2;
+  double *scales;       /**< @brief The precomputed diagonal of the first conditioning matrix */
+  double *coefficients; /**< @brief The precomputed coefficients of the ellipsoid */
 } f_step_ellipsoid_data_t;
 
 /**
@@ -43,7 +45,6 @@ typedef struct {
 static double f_step_ellipsoid_raw(const double *x, const size_t number_of_variables,
                                    const f_step_ellipsoid_data_t *data) {
 
-  static const double condition = 100;
   static const double alpha = 10.0;
   size_t i, j;
   double penalty = 0.0, x1;
@@ -62,9 +63,8 @@ static double f_step_ellipsoid_raw(const double *x, const size_t number_of_varia
   }
   penalty = penalty * (data->penalty_scale);
   for (i = 0; i < number_of_variables; ++i) {
-    double c1;
+    const double c1 = data->scales[i];
     data->x[i] = 0.0;
-    c1 = sqrt(pow(condition / 10., (double)i / (double)(number_of_variables - 1)));
     for (j = 0; j < number_of_variables; ++j) {
       data->x[i] += c1 * data->rot2[i][j] * (x[j] - data->xopt[j]);
     }
@@ -89,9 +89,7 @@ static double f_step_ellipsoid_raw(const double *x, const size_t number_of_varia
   /* Computation core */
   result = 0.0;
   for (i = 0; i < number_of_variables; ++i) {
-    double exponent;
-    exponent = (double)(long)i / ((double)(long)number_of_variables - 1.0);
-    result += pow(condition, exponent) * data->xx[i] * data->xx[i];
+    result += data->coefficients[i] * data->xx[i] * data->xx[i];
   }
   result = 0.1 * coco_double_max(fabs(x1) * 1.0e-4, result) + penalty + data->fopt;
 
@@ -108,6 +106,41 @@ static void f_step_ellipsoid_evaluate(coco_problem_t *problem, const double *x,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the step ellipsoid function.
+ *
+ * The rounded variables are piecewise constant, so that only the penalty and the term 1e-4 |x1| (where it
+ * attains the maximum) contribute to the gradient.
+ */
+static void f_step_ellipsoid_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  f_step_ellipsoid_data_t *data = (f_step_ellipsoid_data_t *)problem->data;
+  const size_t number_of_variables = problem->number_of_variables;
+  double x1, result, tmp;
+  size_t i, j;
+
+  /* Computes the rounded and rotated variables data->xx */
+  f_step_ellipsoid_raw(x, number_of_variables, data);
+
+  result = 0.0;
+  for (i = 0; i < number_of_variables; ++i) {
+    result += data->coefficients[i] * data->xx[i] * data->xx[i];
+  }
+  x1 = 0.0;
+  for (j = 0; j < number_of_variables; ++j) {
+    x1 += data->scales[0] * data->rot2[0][j] * (x[j] - data->xopt[j]);
+  }
+
+  for (i = 0; i < number_of_variables; ++i) {
+    tmp = fabs(x[i]) - 5.0;
+    y[i] = (tmp > 0.0) ? data->penalty_scale * 2.0 * tmp * ((x[i] > 0.0) ? 1.0 : -1.0) : 0.0;
+  }
+  if (fabs(x1) * 1.0e-4 >= result && x1 != 0.0) {
+    for (j = 0; j < number_of_variables; ++j) {
+      y[j] += 0.1 * 1.0e-4 * ((x1 > 0.0) ? 1.0 : -1.0) * data->scales[0] * data->rot2[0][j];
+    }
+  }
+}
+
 /**
  * @brief Frees the step ellipsoid data object.
  */
@@ -117,6 +150,8 @@ static void f_step_ellipsoid_free(coco_problem_t *problem) {
   coco_free_memory(data->x);
   coco_free_memory(data->xx);
   coco_free_memory(data->xopt);
+  coco_free_memory(data->scales);
+  coco_free_memory(data->coefficients);
   bbob2009_free_matrix(data->rot1, problem->number_of_variables);
   bbob2009_free_matrix(data->rot2, problem->number_of_variables);
   /* Let the generic free problem code deal with all of the coco_problem_t
@@ -135,6 +170,7 @@ static coco_problem_t *f_step_ellipsoid_bbob_problem_allocate(const size_t funct
                                                               const char *problem_id_template,
                                                               const char *problem_name_template) {
 
+  static const double condition = 100;
   f_step_ellipsoid_data_t *data;
   size_t i;
   coco_problem_t *problem = coco_problem_allocate_from_scalars("step ellipsoid function", f_step_ellipsoid_evaluate,
@@ -147,6 +183,13 @@ static coco_problem_t *f_step_ellipsoid_bbob_problem_allocate(const size_t funct
   data->xopt = coco_allocate_vector(dimension);
   data->rot1 = bbob2009_allocate_matrix(dimension, dimension);
   data->rot2 = bbob2009_allocate_matrix(dimension, dimension);
+  data->scales = coco_allocate_vector(dimension);
+  data->coefficients = coco_allocate_vector(dimension);
+  for (i = 0; i < dimension; ++i) {
+    const double exponent = (double)(long)i / ((double)(long)dimension - 1.0);
+    data->scales[i] = sqrt(pow(condition / 10., (double)i / (double)(dimension - 1)));
+    data->coefficients[i] = pow(condition, exponent);
+  }
 
   f_step_ellipsoid_args_t *f_step_ellipsoid_args;
   f_step_ellipsoid_args = ((f_step_ellipsoid_args_t *)args);
@@ -163,6 +206,7 @@ static coco_problem_t *f_step_ellipsoid_bbob_problem_allocate(const size_t funct
   bbob2009_compute_rotation(data->rot2, rseed, dimension);
 
   problem->data = data;
+  problem->evaluate_gradient = f_step_ellipsoid_evaluate_gradient;
 
   /* Compute best solution
    *
@@ -213,6 +257,33 @@ static void f_step_ellipsoid_permblock_evaluate(coco_problem_t *problem,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the core function with respect to x and sets the derivative with respect
+ * to \hat{z}_1 in the versatile data (for transform_vars_round_step).
+ */
+static void f_step_ellipsoid_permblock_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  static const double condition = 100;
+  const size_t number_of_variables = problem->number_of_variables;
+  f_step_ellipsoid_versatile_data_t *versatile_data = (f_step_ellipsoid_versatile_data_t *)problem->versatile_data;
+  double exponent, result = 0.0;
+  size_t i;
+
+  for (i = 0; i < number_of_variables; ++i) {
+    exponent = (double)(long)i / ((double)(long)number_of_variables - 1.0);
+    y[i] = pow(condition, exponent);
+    result += y[i] * x[i] * x[i];
+  }
+  if (versatile_data->zhat_1 * 1.0e-4 >= result) {
+    versatile_data->zhat_1_derivative = 0.1 * 1.0e-4;
+    for (i = 0; i < number_of_variables; ++i)
+      y[i] = 0.0;
+  } else {
+    versatile_data->zhat_1_derivative = 0.0;
+    for (i = 0; i < number_of_variables; ++i)
+      y[i] *= 0.1 * 2.0 * x[i];
+  }
+}
+
 /**
  * @brief allows to free the versatile_data part of the problem.
  */
@@ -235,6 +306,8 @@ static coco_problem_t *f_step_ellipsoid_allocate(const size_t number_of_variable
   problem->versatile_data =
       (f_step_ellipsoid_versatile_data_t *)coco_allocate_memory(sizeof(f_step_ellipsoid_versatile_data_t));
   ((f_step_ellipsoid_versatile_data_t *)problem->versatile_data)->zhat_1 = 0; /*needed for xopt evaluation*/
+  ((f_step_ellipsoid_versatile_data_t *)problem->versatile_data)->zhat_1_derivative = 0;
+  problem->evaluate_gradient = f_step_ellipsoid_permblock_evaluate_gradient;
   /* add the free function of the allocated versatile_data*/
   problem->problem_free_function = f_step_ellipsoid_versatile_data_free;
 
@@ -259,10 +332,8 @@ static coco_problem_t *f_step_ellipsoid_permblockdiag_bbob_problem_allocate(cons
   double alpha = 10.; /*parameter of rounding*/
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
-  double **B1, **B2;
-  const double *const *B1_copy;
-  const double *const *B2_copy;
-  size_t *P11, *P12, *P21, *P22;
+  const double *const *B1, *const *B2;
+  const size_t *P11, *P12, *P21, *P22;
   size_t *block_sizes1, *block_sizes2, nb_blocks1, nb_blocks2, swap_range1,
       swap_range2, nb_swaps1, nb_swaps2;
   double penalty_factor = 1.;
@@ -282,38 +353,25 @@ static coco_problem_t *f_step_ellipsoid_permblockdiag_bbob_problem_allocate(cons
   nb_swaps1 = coco_get_nb_swaps(dimension, "bbob-largescale");
   nb_swaps2 = coco_get_nb_swaps(dimension, "bbob-largescale");
 
-  B1 = coco_allocate_blockmatrix(dimension, block_sizes1, nb_blocks1);
-  B2 = coco_allocate_blockmatrix(dimension, block_sizes2, nb_blocks2);
-  B1_copy = (const double *const *)B1;
-  B2_copy = (const double *const *)B2;
-  coco_compute_blockrotation(B1, rseed + 1000000, dimension, block_sizes1,
-                             nb_blocks1);
-  coco_compute_blockrotation(B2, rseed, dimension, block_sizes2, nb_blocks2);
-
-  P11 = coco_allocate_vector_size_t(dimension);
-  P12 = coco_allocate_vector_size_t(dimension);
-  P21 = coco_allocate_vector_size_t(dimension);
-  P22 = coco_allocate_vector_size_t(dimension);
-  coco_compute_truncated_uniform_swap_permutation(
-      P11, rseed + 2000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(
-      P12, rseed + 3000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(
-      P21, rseed + 4000000, dimension, nb_swaps2, swap_range2);
-  coco_compute_truncated_uniform_swap_permutation(
-      P22, rseed + 5000000, dimension, nb_swaps2, swap_range2);
+  B1 = coco_cache_get_blockrotation(rseed + 1000000, dimension, block_sizes1, nb_blocks1);
+  B2 = coco_cache_get_blockrotation(rseed, dimension, block_sizes2, nb_blocks2);
+
+  P11 = coco_cache_get_permutation(rseed + 2000000, dimension, nb_swaps1, swap_range1);
+  P12 = coco_cache_get_permutation(rseed + 3000000, dimension, nb_swaps1, swap_range1);
+  P21 = coco_cache_get_permutation(rseed + 4000000, dimension, nb_swaps2, swap_range2);
+  P22 = coco_cache_get_permutation(rseed + 5000000, dimension, nb_swaps2, swap_range2);
 
   problem = f_step_ellipsoid_allocate(dimension);
 
   problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B1, dimension,
                                          block_sizes1, nb_blocks1);
   problem = transform_vars_permutation(problem, P21, dimension);
   problem = transform_vars_round_step(problem, alpha);
 
   problem = transform_vars_conditioning(problem, 10.0);
   problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension,
+  problem = transform_vars_blockrotation(problem, B2, dimension,
                                          block_sizes2, nb_blocks2);
   problem = transform_vars_permutation(problem, P11, dimension);
   problem = transform_vars_shift(problem, xopt, 0);
@@ -328,12 +386,12 @@ static coco_problem_t *f_step_ellipsoid_permblockdiag_bbob_problem_allocate(cons
                         dimension);
   coco_problem_set_type(problem, "2-moderate");
 
-  coco_free_block_matrix(B1, dimension);
-  coco_free_block_matrix(B2, dimension);
-  coco_free_memory(P11);
-  coco_free_memory(P12);
-  coco_free_memory(P21);
-  coco_free_memory(P22);
+  coco_cache_release(B1);
+  coco_cache_release(B2);
+  coco_cache_release(P11);
+  coco_cache_release(P12);
+  coco_cache_release(P21);
+  coco_cache_release(P22);
   coco_free_memory(block_sizes1);
   coco_free_memory(block_sizes2);
   coco_free_memory(xopt);
@@ -9,6 +9,7 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_simd.c"
 #include "suite_bbob_legacy_code.c"
 #include "transform_obj_norm_by_dim.c"
 #include "transform_obj_penalize.c"
@@ -31,6 +32,41 @@ typedef struct {
   double bk[F_WEIERSTRASS_SUMMANDS];
 } f_weierstrass_data_t;
 
+#if COCO_SIMD_ENABLED
+/**
+ * @brief SIMD version of the sum of the Weierstrass function.
+ *
+ * Returns 0 if a value of x is outside of the range of coco_simd_cos().
+ */
+COCO_SIMD_INLINE int f_weierstrass_simd_body(const double *x, const size_t number_of_variables,
+                                             const f_weierstrass_data_t *data, double *result) {
+  coco_simd_vector_t sum = {0};
+  coco_simd_bits_t invalid = {0};
+  size_t i, j;
+
+  for (i = 0; i + COCO_SIMD_WIDTH <= number_of_variables; i += COCO_SIMD_WIDTH) {
+    const coco_simd_vector_t xi = coco_simd_load(x + i);
+    for (j = 0; j < F_WEIERSTRASS_SUMMANDS; ++j) {
+      const coco_simd_vector_t tmp = 2 * coco_pi * (xi + 0.5) * data->bk[j];
+      sum += coco_simd_cos(&tmp, &invalid) * data->ak[j];
+    }
+  }
+  if (coco_simd_any(&invalid))
+    return 0;
+  *result = coco_simd_sum(&sum);
+  for (; i < number_of_variables; ++i) {
+    for (j = 0; j < F_WEIERSTRASS_SUMMANDS; ++j) {
+      *result += cos(2 * coco_pi * (x[i] + 0.5) * data->bk[j]) * data->ak[j];
+    }
+  }
+  return 1;
+}
+
+COCO_SIMD_DEFINE_KERNEL(f_weierstrass_simd, (const double *x, const size_t number_of_variables,
+                                             const f_weierstrass_data_t *data, double *result),
+                        (x, number_of_variables, data, result))
+#endif
+
 /**
  * @brief Implements the Weierstrass function without connections to any COCO
  * structures.
@@ -46,9 +82,11 @@ static double f_weierstrass_raw(const double *x,
     return NAN;
 
   result = 0.0;
-  for (i = 0; i < number_of_variables; ++i) {
-    for (j = 0; j < F_WEIERSTRASS_SUMMANDS; ++j) {
-      result += cos(2 * coco_pi * (x[i] + 0.5) * data->bk[j]) * data->ak[j];
+  if (!COCO_SIMD_RUN(f_weierstrass_simd, (x, number_of_variables, data, &result))) {
+    for (i = 0; i < number_of_variables; ++i) {
+      for (j = 0; j < F_WEIERSTRASS_SUMMANDS; ++j) {
+        result += cos(2 * coco_pi * (x[i] + 0.5) * data->bk[j]) * data->ak[j];
+      }
     }
   }
   result = 10.0 * pow(result / (double)(long)number_of_variables - data->f0, 3.0);
@@ -65,6 +103,28 @@ static void f_weierstrass_evaluate(coco_problem_t *problem, const double *x, dou
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the Weierstrass function.
+ */
+static void f_weierstrass_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  f_weierstrass_data_t *data = (f_weierstrass_data_t *)problem->data;
+  const double n = (double)(long)problem->number_of_variables;
+  size_t i, j;
+  double result = 0.0;
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] = 0.0;
+    for (j = 0; j < F_WEIERSTRASS_SUMMANDS; ++j) {
+      result += cos(2 * coco_pi * (x[i] + 0.5) * data->bk[j]) * data->ak[j];
+      y[i] -= 2 * coco_pi * data->bk[j] * sin(2 * coco_pi * (x[i] + 0.5) * data->bk[j]) * data->ak[j];
+    }
+  }
+  result = result / n - data->f0;
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= 30.0 * result * result / n;
+  }
+}
+
 /**
  * @brief Allocates the basic Weierstrass problem.
  */
@@ -86,6 +146,7 @@ f_weierstrass_allocate(const size_t number_of_variables) {
     data->f0 += data->ak[i] * cos(2 * coco_pi * data->bk[i] * 0.5);
   }
   problem->data = data;
+  problem->evaluate_gradient = f_weierstrass_evaluate_gradient;
 
   /* Compute best solution */
   non_unique_best_value = coco_allocate_vector(number_of_variables);
@@ -105,10 +166,9 @@ static coco_problem_t *f_weierstrass_bbob_problem_allocate(const size_t function
                                                            const char *problem_name_template) {
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
-  size_t i, j, k;
   double *M = coco_allocate_vector(dimension * dimension);
   double *b = coco_allocate_vector(dimension);
-  double *current_row, **rot1, **rot2;
+  double **rot1, **rot2;
 
   const double condition = 100.0;
   const double penalty_factor = 10.0 / (double)dimension;
@@ -125,18 +185,7 @@ static coco_problem_t *f_weierstrass_bbob_problem_allocate(const size_t function
   rot2 = bbob2009_allocate_matrix(dimension, dimension);
   bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
   bbob2009_compute_rotation(rot2, rseed, dimension);
-  for (i = 0; i < dimension; ++i) {
-    b[i] = 0.0;
-    current_row = M + i * dimension;
-    for (j = 0; j < dimension; ++j) {
-      current_row[j] = 0.0;
-      for (k = 0; k < dimension; ++k) {
-        const double base = 1.0 / sqrt(condition);
-        const double exponent = 1.0 * (int)k / ((double)(long)dimension - 1.0);
-        current_row[j] += rot1[i][k] * pow(base, exponent) * rot2[k][j];
-      }
-    }
-  }
+  bbob2009_compute_scaled_rotation_product(M, b, rot1, 1.0 / sqrt(condition), rot2, dimension);
 
   problem = f_weierstrass_allocate(dimension);
   problem = transform_obj_shift(problem, fopt);
@@ -171,14 +220,12 @@ static coco_problem_t *f_weierstrass_permblockdiag_bbob_problem_allocate(const s
                                                                          const char *problem_name_template) {
   double *xopt, fopt;
   coco_problem_t *problem = NULL;
-  double **B1;
-  double **B2;
-  const double *const *B1_copy;
-  const double *const *B2_copy;
-  size_t *P11 = coco_allocate_vector_size_t(dimension);
-  size_t *P21 = coco_allocate_vector_size_t(dimension);
-  size_t *P12 = coco_allocate_vector_size_t(dimension);
-  size_t *P22 = coco_allocate_vector_size_t(dimension);
+  const double *const *B1;
+  const double *const *B2;
+  const size_t *P11;
+  const size_t *P21;
+  const size_t *P12;
+  const size_t *P22;
   size_t *block_sizes1;
   size_t *block_sizes2;
   size_t nb_blocks1;
@@ -200,32 +247,27 @@ static coco_problem_t *f_weierstrass_permblockdiag_bbob_problem_allocate(const s
     bbob2009_compute_xopt(xopt, rseed, dimension);
   }
 
-  B1 = coco_allocate_blockmatrix(dimension, block_sizes1, nb_blocks1);
-  B2 = coco_allocate_blockmatrix(dimension, block_sizes2, nb_blocks2);
-  B1_copy = (const double *const *)B1;
-  B2_copy = (const double *const *)B2;
-
-  coco_compute_blockrotation(B1, rseed + 1000000, dimension, block_sizes1, nb_blocks1);
-  coco_compute_blockrotation(B2, rseed, dimension, block_sizes2, nb_blocks2);
+  B1 = coco_cache_get_blockrotation(rseed + 1000000, dimension, block_sizes1, nb_blocks1);
+  B2 = coco_cache_get_blockrotation(rseed, dimension, block_sizes2, nb_blocks2);
 
-  coco_compute_truncated_uniform_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P21, rseed + 4000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P12, rseed + 5000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps, swap_range);
+  P11 = coco_cache_get_permutation(rseed + 3000000, dimension, nb_swaps, swap_range);
+  P21 = coco_cache_get_permutation(rseed + 4000000, dimension, nb_swaps, swap_range);
+  P12 = coco_cache_get_permutation(rseed + 5000000, dimension, nb_swaps, swap_range);
+  P22 = coco_cache_get_permutation(rseed + 6000000, dimension, nb_swaps, swap_range);
 
   problem = f_weierstrass_allocate(dimension);
   problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
+  problem = transform_vars_blockrotation(problem, B1, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_permutation(problem, P12, dimension);
 
   problem = transform_vars_conditioning(problem, 1.0 / condition);
   problem = transform_vars_permutation(problem, P21, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
+  problem = transform_vars_blockrotation(problem, B2, dimension, block_sizes2, nb_blocks2);
   problem = transform_vars_permutation(problem, P11, dimension);
 
   problem = transform_vars_oscillate(problem);
   problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
+  problem = transform_vars_blockrotation(problem, B1, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_permutation(problem, P12, dimension);
 
   problem = transform_vars_shift(problem, xopt, 0);
@@ -237,12 +279,12 @@ static coco_problem_t *f_weierstrass_permblockdiag_bbob_problem_allocate(const s
   coco_problem_set_name(problem, problem_name_template, function, instance, dimension);
   coco_problem_set_type(problem, "4-multi-modal");
 
-  coco_free_block_matrix(B1, dimension);
-  coco_free_block_matrix(B2, dimension);
-  coco_free_memory(P11);
-  coco_free_memory(P21);
-  coco_free_memory(P12);
-  coco_free_memory(P22);
+  coco_cache_release(B1);
+  coco_cache_release(B2);
+  coco_cache_release(P11);
+  coco_cache_release(P21);
+  coco_cache_release(P12);
+  coco_cache_release(P22);
   coco_free_memory(block_sizes1);
   coco_free_memory(block_sizes2);
   coco_free_memory(xopt);
@@ -20,6 +20,9 @@
  *
  * *1 Note that the decision about which performance targets to use is done on the suite level
  * and passed to the logger during initialization.
+ *
+ * With the observer option "format: binary", the data files are written in the binary format described
+ * in logger_binary.c (the info files are always written as text).
  */
 
 #include <stdio.h>
@@ -28,6 +31,7 @@
 #include <float.h>
 #include <math.h>
 #include <errno.h>
+#include <time.h>
 
 #include "coco.h"
 
@@ -36,6 +40,7 @@
 #include "coco_string.c"
 #include "coco_observer.c"
 #include "observer_bbob.c"
+#include "logger_binary.c"
 
 /**
  * @brief Factor used in logged indicator (f-f*)^+ + sum_i g_i^+ in front of the sum
@@ -52,6 +57,11 @@
  */
 #define LOGGER_BBOB_NUMBER_OF_VARIABLES_THRESHOLD 7
 
+/**
+ * Maximal length of a formatted number in a data file (including the separating space)
+ */
+#define LOGGER_BBOB_MAX_NUMBER_LENGTH 24
+
 /**
  * @brief The bbob logger data type.
  */
@@ -92,6 +102,20 @@ typedef struct {
   coco_observer_evaluations_t *evaluations; /**< @brief Triggers based on the number of evaluations. */
   coco_observer_targets_t *mdat_targets;    /**< @brief Triggers based on target values for recommendations. */
 
+  int impatient;            /**< @brief Whether the data files are flushed after each line */
+  double flush_interval;    /**< @brief The maximal time in seconds between flushes of the data files */
+  size_t buffer_size;       /**< @brief The size of the output buffer of each data file */
+  time_t last_flush_time;   /**< @brief The time of the last flush of the data files */
+  char *line;               /**< @brief Buffer in which a line of a data file is formatted before it is output */
+
+  int binary_format; /**< @brief Whether the data files are written in the binary format */
+  logger_binary_layout_t *constraints_layout; /**< @brief Layout of lines with constraint digits (binary format) */
+  logger_binary_layout_t *value_layout;       /**< @brief Layout of lines with the best value (binary format) */
+
+  observer_bbob_shared_t *shared; /**< @brief State shared with a thread-safe observer (NULL otherwise) */
+  char *info_file_path;           /**< @brief Path to the info file (used only in thread-safe mode) */
+  char *info_header;              /**< @brief Header of the info file entry (used only in thread-safe mode) */
+
 } logger_bbob_data_t;
 
 /**
@@ -170,41 +194,152 @@ static int logger_bbob_start_new_line(coco_observer_t *observer, size_t current_
   return 1;
 }
 
+/**
+ * @brief Flushes the buffered output of all data files
+ */
+static void logger_bbob_flush(logger_bbob_data_t *logger) {
+  if (logger->dat_file != NULL)
+    fflush(logger->dat_file);
+  if (logger->tdat_file != NULL)
+    fflush(logger->tdat_file);
+  if (logger->rdat_file != NULL)
+    fflush(logger->rdat_file);
+  if (logger->mdat_file != NULL)
+    fflush(logger->mdat_file);
+  logger->last_flush_time = time(NULL);
+}
+
+/**
+ * @brief Flushes the output after a line was written to data_file if needed
+ *
+ * Flush output so that impatient users can see progress.
+ * Otherwise it can take a long time until the output appears, so flush at least every flush_interval seconds.
+ */
+static void logger_bbob_flush_if_needed(FILE *data_file, logger_bbob_data_t *logger) {
+  if (logger->impatient)
+    fflush(data_file);
+  else if (difftime(time(NULL), logger->last_flush_time) >= logger->flush_interval)
+    logger_bbob_flush(logger);
+}
+
+/**
+ * @brief Allocates the binary layout of the lines of the data files
+ *
+ * The layout corresponds to the text lines output by logger_bbob_output() with constraint digits (if
+ * with_constraints is 1) or with the best value (otherwise).
+ */
+static logger_binary_layout_t *logger_bbob_layout(const logger_bbob_data_t *logger, const int with_constraints) {
+  logger_binary_layout_t *layout;
+  size_t i, column = 0;
+  size_t number_of_columns = 4 + (with_constraints ? logger->number_of_constraints : 1);
+  size_t number_of_logged_variables = 0;
+
+  if (logger->number_of_variables < LOGGER_BBOB_NUMBER_OF_VARIABLES_THRESHOLD)
+    number_of_logged_variables = logger->number_of_variables;
+  layout = logger_binary_layout_allocate((unsigned char)with_constraints,
+                                         number_of_columns + number_of_logged_variables, "\n");
+
+  logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_COUNTER, 0, 0, 0, '\0');
+  logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_COUNTER, 0, 0, 0, ' ');
+  logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_EXPONENTIAL, 10, 9, 1, ' ');
+  logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_EXPONENTIAL, 10, 9, 1, ' ');
+  if (with_constraints) {
+    for (i = 0; i < logger->number_of_constraints; ++i)
+      logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_INT, 0, 0, 0, (i == 0) ? ' ' : '\0');
+  } else {
+    logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_EXPONENTIAL, 10, 9, 1, ' ');
+  }
+  for (i = 0; i < number_of_logged_variables; i++) {
+    if ((i < logger->number_of_integer_variables) && (logger->log_discrete_as_int))
+      logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_INT, 0, 0, 0, ' ');
+    else
+      logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_EXPONENTIAL, 5, 4, 1, ' ');
+  }
+  return layout;
+}
+
+/**
+ * @brief Outputs a record to a data file in the binary format (see logger_bbob_output())
+ */
+static void logger_bbob_output_record(FILE *data_file, logger_bbob_data_t *logger, const double *x,
+                                      double current_value, double best_value, const double *constraints) {
+  logger_binary_layout_t *layout = logger->value_layout;
+  size_t i;
+
+  if ((logger->number_of_constraints > 0) && (constraints != NULL))
+    layout = logger->constraints_layout;
+
+  logger_binary_record_start(layout);
+  logger_binary_record_add_counter(layout, logger->num_func_evaluations);
+  logger_binary_record_add_counter(layout, logger->num_cons_evaluations);
+  logger_binary_record_add(layout, best_value - logger->optimal_value);
+  logger_binary_record_add(layout, current_value);
+  if (layout == logger->constraints_layout) {
+    for (i = 0; i < logger->number_of_constraints; ++i)
+      logger_binary_record_add(layout, logger_bbob_single_digit_constraint(constraints[i]));
+  } else {
+    logger_binary_record_add(layout, best_value);
+  }
+  if (logger->number_of_variables < LOGGER_BBOB_NUMBER_OF_VARIABLES_THRESHOLD) {
+    for (i = 0; i < logger->number_of_variables; i++) {
+      if ((i < logger->number_of_integer_variables) && (logger->log_discrete_as_int))
+        logger_binary_record_add(layout, coco_double_to_int(x[i]));
+      else
+        logger_binary_record_add(layout, x[i]);
+    }
+  }
+  logger_binary_record_write(data_file, layout);
+}
+
 /**
  * @brief Outputs a formatted line to a data file
  */
 static void logger_bbob_output(FILE *data_file, logger_bbob_data_t *logger, const double *x, double current_value,
                                double best_value, const double *constraints) {
   /* This function contains many hard-coded values (10.9, 22, 5.4) that could be read through
-   * observer options */
-  size_t i;
+   * observer options. The line is formatted in logger->line (as with "%lu %lu %+10.9e %+10.9e ...") and
+   * output at once. */
+  char *line = logger->line;
+  size_t i, length = 0;
+
+  if (logger->binary_format) {
+    logger_bbob_output_record(data_file, logger, x, current_value, best_value, constraints);
+    logger_bbob_flush_if_needed(data_file, logger);
+    return;
+  }
 
-  fprintf(data_file, "%lu %lu %+10.9e %+10.9e ", (unsigned long)logger->num_func_evaluations,
-          (unsigned long)logger->num_cons_evaluations, best_value - logger->optimal_value, current_value);
+  length += coco_format_unsigned_long(line + length, (unsigned long)logger->num_func_evaluations);
+  line[length++] = ' ';
+  length += coco_format_unsigned_long(line + length, (unsigned long)logger->num_cons_evaluations);
+  line[length++] = ' ';
+  length += coco_format_exponential(line + length, best_value - logger->optimal_value, 10, 9, 1);
+  line[length++] = ' ';
+  length += coco_format_exponential(line + length, current_value, 10, 9, 1);
+  line[length++] = ' ';
 
   if ((logger->number_of_constraints > 0) && (constraints != NULL)) {
     for (i = 0; i < logger->number_of_constraints; ++i) {
       /* print 01234567890123..., may happen in the last line of .tdat */
-      fprintf(data_file, "%d", constraints ? logger_bbob_single_digit_constraint(constraints[i]) : (int)(i % 10));
+      length += coco_format_int(line + length,
+                                constraints ? logger_bbob_single_digit_constraint(constraints[i]) : (int)(i % 10));
     }
   } else {
-    fprintf(data_file, "%+10.9e", best_value);
+    length += coco_format_exponential(line + length, best_value, 10, 9, 1);
   }
 
   if (logger->number_of_variables < LOGGER_BBOB_NUMBER_OF_VARIABLES_THRESHOLD) {
     for (i = 0; i < logger->number_of_variables; i++) {
+      line[length++] = ' ';
       if ((i < logger->number_of_integer_variables) && (logger->log_discrete_as_int))
-        fprintf(data_file, " %d", coco_double_to_int(x[i]));
+        length += coco_format_int(line + length, coco_double_to_int(x[i]));
       else
-        fprintf(data_file, " %+5.4e", x[i]);
+        length += coco_format_exponential(line + length, x[i], 5, 4, 1);
     }
   }
-  fprintf(data_file, "\n");
-
-  /* Flush output so that impatient users can see progress.
-   * Otherwise it can take a long time until the output appears.
-   */
-  fflush(data_file);
+  line[length++] = '\n';
+  line[length] = '\0';
+  fputs(line, data_file);
+  logger_bbob_flush_if_needed(data_file, logger);
 }
 
 /**
@@ -223,75 +358,156 @@ static void logger_bbob_open_file(FILE **file, const char *file_path) {
  * @brief Creates the data file (if it didn't exist before) and opens it
  */
 static void logger_bbob_open_data_file(FILE **data_file, const char *path, const char *file_name,
-                                       const char *file_extension) {
+                                       const char *file_extension, const size_t buffer_size,
+                                       const int binary_format) {
   char file_path[COCO_PATH_MAX + 2] = {0};
   char relative_file_path[COCO_PATH_MAX + 2] = {0};
   strncpy(relative_file_path, file_name, COCO_PATH_MAX - strlen(relative_file_path) - 1);
   strncat(relative_file_path, file_extension, COCO_PATH_MAX - strlen(relative_file_path) - 1);
+  if (binary_format)
+    strncat(relative_file_path, LOGGER_BINARY_FILE_EXTENSION, COCO_PATH_MAX - strlen(relative_file_path) - 1);
   coco_join_path(file_path, sizeof(file_path), path, relative_file_path, NULL);
-  logger_bbob_open_file(data_file, file_path);
+  if (!binary_format) {
+    logger_bbob_open_file(data_file, file_path);
+  } else if (*data_file == NULL) {
+    *data_file = logger_binary_open_file(file_path);
+    if (*data_file == NULL) {
+      coco_error("logger_bbob_open_data_file(): Error opening file: %s\nError: %d", file_path, errno);
+    }
+  }
+  setvbuf(*data_file, NULL, _IOFBF, buffer_size);
 }
 
 /**
- * @brief Creates the info file (if it didn't exist before) and opens it
+ * @brief Outputs the header of a run to the data file (and the layouts of its lines in the binary format)
  */
-static void logger_bbob_open_info_file(logger_bbob_data_t *logger, const char *folder, const char *function_string,
-                                       const char *data_file_name, const char *suite_name, int start_new_line) {
-  char data_file_path[COCO_PATH_MAX + 2] = {0};
-  int add_empty_line = 0;
+static void logger_bbob_output_header(FILE *data_file, const logger_bbob_data_t *logger,
+                                      const char *optimal_value_name) {
+  logger_binary_output_text(data_file, logger->binary_format, logger_bbob_header, optimal_value_name,
+                            logger->optimal_value);
+  if (logger->binary_format) {
+    if (logger->constraints_layout != NULL)
+      logger_binary_write_layout(data_file, logger->constraints_layout);
+    logger_binary_write_layout(data_file, logger->value_layout);
+  }
+}
+
+/**
+ * @brief Returns the path to the info file of the logger's function.
+ *
+ * The caller is responsible for freeing the allocated memory using coco_free_memory().
+ */
+static char *logger_bbob_info_file_path(const char *folder, const char *prefix, const char *function_string) {
   char file_name[COCO_PATH_MAX + 2] = {0};
   char file_path[COCO_PATH_MAX + 2] = {0};
+
+  strncpy(file_name, prefix, COCO_PATH_MAX - strlen(file_name) - 1);
+  strncat(file_name, "_f", COCO_PATH_MAX - strlen(file_name) - 1);
+  strncat(file_name, function_string, COCO_PATH_MAX - strlen(file_name) - 1);
+  strncat(file_name, ".info", COCO_PATH_MAX - strlen(file_name) - 1);
+  coco_join_path(file_path, sizeof(file_path), folder, file_name, NULL);
+  return coco_strdup(file_path);
+}
+
+/**
+ * @brief Returns the header of a new line in the info file (the data file name is given without extension).
+ *
+ * The caller is responsible for freeing the allocated memory using coco_free_memory().
+ */
+static char *logger_bbob_info_header(logger_bbob_data_t *logger, coco_observer_t *observer,
+                                     const char *data_file_name, const char *suite_name) {
+  /* Room for the fixed text and the formatted numbers */
+  const size_t length = strlen(suite_name) + strlen(observer->algorithm_name) + strlen(coco_version) +
+                        strlen(observer->observer_name) + strlen(logger_bbob_data_format) +
+                        strlen(observer->settings) + strlen(observer->algorithm_info) + strlen(data_file_name) + 256;
+  char *header = coco_allocate_string(length);
+
+  sprintf(header,
+          "suite = '%s', funcId = %lu, DIM = %lu, Precision = %.3e, "
+          "algId = '%s', coco_version = '%s', logger = '%s', "
+          "data_format = '%s', settings = '%s'\n"
+          "%% %s\n"
+          "%s.dat",
+          suite_name, (unsigned long)logger->function, (unsigned long)logger->number_of_variables, pow(10, -8),
+          observer->algorithm_name, coco_version, observer->observer_name, logger_bbob_data_format,
+          observer->settings, observer->algorithm_info, data_file_name);
+  return header;
+}
+
+/**
+ * @brief Returns whether the file exists and is not empty, in which case an empty line is needed before
+ * a new entry
+ */
+static int logger_bbob_info_file_needs_empty_line(const char *file_path) {
+  FILE *tmp_file = fopen(file_path, "r");
+  if (tmp_file != NULL) {
+    fclose(tmp_file);
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Creates the info file (if it didn't exist before) and opens it
+ */
+static void logger_bbob_open_info_file(logger_bbob_data_t *logger, coco_observer_t *observer, const char *folder,
+                                       const char *function_string, const char *data_file_name,
+                                       const char *suite_name, int start_new_line) {
+  int add_empty_line = 0;
+  char *file_path;
+  char *header;
   FILE **info_file;
-  FILE *tmp_file;
-  coco_observer_t *observer;
   observer_bbob_data_t *observer_data;
 
   coco_debug("Started logger_bbob_open_info_file()");
 
   assert(logger != NULL);
-  assert(logger->observer != NULL);
-  observer = (coco_observer_t *)(logger->observer);
+  assert(observer != NULL);
   observer_data = (observer_bbob_data_t *)(observer->data);
   assert(observer_data != NULL);
 
-  strncpy(data_file_path, data_file_name, COCO_PATH_MAX - strlen(data_file_path) - 1);
-
   info_file = &(logger->info_file);
-
-  strncpy(file_name, observer_data->prefix, COCO_PATH_MAX - strlen(file_name) - 1);
-  strncat(file_name, "_f", COCO_PATH_MAX - strlen(file_name) - 1);
-  strncat(file_name, function_string, COCO_PATH_MAX - strlen(file_name) - 1);
-  strncat(file_name, ".info", COCO_PATH_MAX - strlen(file_name) - 1);
-  coco_join_path(file_path, sizeof(file_path), folder, file_name, NULL);
+  file_path = logger_bbob_info_file_path(folder, observer_data->prefix, function_string);
 
   if (*info_file == NULL) {
-    add_empty_line = 0;
     /* If the file already exists, an empty line is needed */
-    tmp_file = fopen(file_path, "r");
-    if (tmp_file != NULL) {
-      add_empty_line = 1;
-      fclose(tmp_file);
-    }
+    add_empty_line = logger_bbob_info_file_needs_empty_line(file_path);
     logger_bbob_open_file(info_file, file_path);
     if (start_new_line) {
       if (add_empty_line)
         fprintf(*info_file, "\n");
 
-      fprintf(*info_file,
-              "suite = '%s', funcId = %lu, DIM = %lu, Precision = %.3e, "
-              "algId = '%s', coco_version = '%s', logger = '%s', "
-              "data_format = '%s', settings = '%s'\n",
-              suite_name, (unsigned long)logger->function, (unsigned long)logger->number_of_variables, pow(10, -8),
-              observer->algorithm_name, coco_version, observer->observer_name,
-              logger_bbob_data_format, observer->settings);
-      fprintf(*info_file, "%% %s\n", observer->algorithm_info);
-      /* data_file_path does not have the extension */
-      fprintf(*info_file, "%s.dat", data_file_path);
+      header = logger_bbob_info_header(logger, observer, data_file_name, suite_name);
+      fprintf(*info_file, "%s", header);
+      coco_free_memory(header);
     }
   }
+  coco_free_memory(file_path);
   coco_debug("Ended   logger_bbob_open_info_file()");
 }
 
+/**
+ * @brief Writes the whole line of a thread-safe logger to the info file at once
+ *
+ * Since several loggers can write to the same info file, the line is only written when it is complete.
+ */
+static void logger_bbob_write_info_line(logger_bbob_data_t *logger) {
+  FILE *info_file = NULL;
+
+  assert(logger->shared != NULL);
+  coco_mutex_lock(&logger->shared->mutex);
+  if (logger_bbob_info_file_needs_empty_line(logger->info_file_path)) {
+    logger_bbob_open_file(&info_file, logger->info_file_path);
+    fprintf(info_file, "\n");
+  } else {
+    logger_bbob_open_file(&info_file, logger->info_file_path);
+  }
+  fprintf(info_file, "%s, %lu:%lu|%.1e", logger->info_header, (unsigned long)logger->instance,
+          (unsigned long)logger->num_func_evaluations, logger->best_found_value - logger->optimal_value);
+  fclose(info_file);
+  coco_mutex_unlock(&logger->shared->mutex);
+}
+
 /**
  * @brief Generates the files and folders needed by the logger if they don't already exist
  */
@@ -303,7 +519,9 @@ static void logger_bbob_initialize(logger_bbob_data_t *logger, int is_opt_known)
   char *dimension_string;
   char *str_pointer;
   char *relative_path_pointer = NULL;
-  int start_new_line;
+  const char *data_file_extension = logger->binary_format ? ".dat" LOGGER_BINARY_FILE_EXTENSION : ".dat";
+  int start_new_line = 1;
+  coco_observer_t *observer;
   observer_bbob_data_t *observer_data;
 
   coco_debug("Started logger_bbob_initialize()");
@@ -314,8 +532,20 @@ static void logger_bbob_initialize(logger_bbob_data_t *logger, int is_opt_known)
     str_pointer = "Fopt";
 
   assert(logger != NULL);
-  assert(logger->observer != NULL);
-  observer_data = ((observer_bbob_data_t *)((coco_observer_t *)logger->observer)->data);
+  if (logger->shared != NULL) {
+    /* The lock is held until all files are created, so that their names are unique */
+    coco_mutex_lock(&logger->shared->mutex);
+    observer = logger->shared->observer;
+    if (observer == NULL) {
+      coco_mutex_unlock(&logger->shared->mutex);
+      coco_error("logger_bbob_initialize(): The observer was freed before the observed problem was evaluated");
+      return; /* Never reached */
+    }
+  } else {
+    observer = logger->observer;
+  }
+  assert(observer != NULL);
+  observer_data = (observer_bbob_data_t *)observer->data;
 
   function_string = coco_strdupf("%lu", (unsigned long)logger->function);
   dimension_string = coco_strdupf("%lu", (unsigned long)logger->number_of_variables);
@@ -323,39 +553,59 @@ static void logger_bbob_initialize(logger_bbob_data_t *logger, int is_opt_known)
   /* Prepare paths and names */
   strncpy(relative_path, "data_f", COCO_PATH_MAX);
   strncat(relative_path, function_string, COCO_PATH_MAX - strlen(relative_path) - 1);
-  coco_join_path(folder_path, sizeof(folder_path), logger->observer->result_folder, relative_path, NULL);
+  coco_join_path(folder_path, sizeof(folder_path), observer->result_folder, relative_path, NULL);
   coco_create_directory(folder_path);
   strncat(relative_path, "/bbobexp_f", COCO_PATH_MAX - strlen(relative_path) - 1);
   strncat(relative_path, function_string, COCO_PATH_MAX - strlen(relative_path) - 1);
   strncat(relative_path, "_DIM", COCO_PATH_MAX - strlen(relative_path) - 1);
   strncat(relative_path, dimension_string, COCO_PATH_MAX - strlen(relative_path) - 1);
 
-  /* Find out whether a new line in the info file (and a new .?dat file) is needed */
-  start_new_line = logger_bbob_start_new_line(logger->observer, logger->number_of_variables, logger->function);
-  if (start_new_line) {
+  /* Find out whether a new line in the info file (and a new .?dat file) is needed. Thread-safe loggers
+   * always start a new line, since other loggers might use the previous .?dat files at the same time. */
+  if (logger->shared != NULL) {
     relative_path_pointer = coco_strdup(relative_path);
-    coco_create_unique_filename(logger->observer->result_folder, &relative_path_pointer, ".dat");
-    strncpy(observer_data->last_dat_file, relative_path_pointer, COCO_PATH_MAX);
-    observer_data->last_function = logger->function;
-    observer_data->last_dimension = logger->number_of_variables;
+    coco_create_unique_filename(observer->result_folder, &relative_path_pointer, data_file_extension);
   } else {
-    relative_path_pointer = coco_strdup(observer_data->last_dat_file);
+    start_new_line = logger_bbob_start_new_line(observer, logger->number_of_variables, logger->function);
+    if (start_new_line) {
+      relative_path_pointer = coco_strdup(relative_path);
+      coco_create_unique_filename(observer->result_folder, &relative_path_pointer, data_file_extension);
+      strncpy(observer_data->last_dat_file, relative_path_pointer, COCO_PATH_MAX);
+      observer_data->last_function = logger->function;
+      observer_data->last_dimension = logger->number_of_variables;
+    } else {
+      relative_path_pointer = coco_strdup(observer_data->last_dat_file);
+    }
   }
 
-  /* info file */
-  logger_bbob_open_info_file(logger, logger->observer->result_folder, function_string, relative_path_pointer,
-                             logger->suite_name, start_new_line);
-  fprintf(logger->info_file, ", %lu", (unsigned long)logger->instance);
+  /* info file (the line of a thread-safe logger is written when it is freed) */
+  if (logger->shared != NULL) {
+    logger->info_file_path = logger_bbob_info_file_path(observer->result_folder, observer_data->prefix,
+                                                        function_string);
+    logger->info_header = logger_bbob_info_header(logger, observer, relative_path_pointer, logger->suite_name);
+  } else {
+    logger_bbob_open_info_file(logger, observer, observer->result_folder, function_string, relative_path_pointer,
+                               logger->suite_name, start_new_line);
+    fprintf(logger->info_file, ", %lu", (unsigned long)logger->instance);
+  }
 
   /* data files */
-  logger_bbob_open_data_file(&(logger->dat_file), logger->observer->result_folder, relative_path_pointer, ".dat");
-  fprintf(logger->dat_file, logger_bbob_header, str_pointer, logger->optimal_value);
-  logger_bbob_open_data_file(&(logger->tdat_file), logger->observer->result_folder, relative_path_pointer, ".tdat");
-  fprintf(logger->tdat_file, logger_bbob_header, str_pointer, logger->optimal_value);
-  logger_bbob_open_data_file(&(logger->rdat_file), logger->observer->result_folder, relative_path_pointer, ".rdat");
-  fprintf(logger->rdat_file, logger_bbob_header, str_pointer, logger->optimal_value);
-  logger_bbob_open_data_file(&(logger->mdat_file), logger->observer->result_folder, relative_path_pointer, ".mdat");
-  fprintf(logger->mdat_file, logger_bbob_header, str_pointer, logger->optimal_value);
+  logger_bbob_open_data_file(&(logger->dat_file), observer->result_folder, relative_path_pointer, ".dat",
+                             logger->buffer_size, logger->binary_format);
+  logger_bbob_output_header(logger->dat_file, logger, str_pointer);
+  logger_bbob_open_data_file(&(logger->tdat_file), observer->result_folder, relative_path_pointer, ".tdat",
+                             logger->buffer_size, logger->binary_format);
+  logger_bbob_output_header(logger->tdat_file, logger, str_pointer);
+  logger_bbob_open_data_file(&(logger->rdat_file), observer->result_folder, relative_path_pointer, ".rdat",
+                             logger->buffer_size, logger->binary_format);
+  logger_bbob_output_header(logger->rdat_file, logger, str_pointer);
+  logger_bbob_open_data_file(&(logger->mdat_file), observer->result_folder, relative_path_pointer, ".mdat",
+                             logger->buffer_size, logger->binary_format);
+  logger_bbob_output_header(logger->mdat_file, logger, str_pointer);
+  logger->last_flush_time = time(NULL);
+
+  if (logger->shared != NULL)
+    coco_mutex_unlock(&logger->shared->mutex);
 
   logger->is_initialized = 1;
   coco_free_memory(dimension_string);
@@ -366,34 +616,36 @@ static void logger_bbob_initialize(logger_bbob_data_t *logger, int is_opt_known)
 }
 
 /**
- * @brief Evaluates the function, increases the number of evaluations and outputs information according to
- * observer options.
+ * @brief Prepares the logger for the evaluation of the observed problem.
  */
-static void logger_bbob_evaluate(coco_problem_t *problem, const double *x, double *y) {
-  size_t i;
-  double y_logged, max_value = 0, sum_constraints;
-  double *constraints = NULL;
-  logger_bbob_data_t *logger = (logger_bbob_data_t *)coco_problem_transformed_get_data(problem);
+static void logger_bbob_start_evaluation(coco_problem_t *problem, logger_bbob_data_t *logger) {
   coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
-  const int is_feasible = problem->number_of_constraints <= 0 || coco_is_feasible(inner_problem, x, NULL);
 
   if (problem->is_tainted || inner_problem->is_tainted) {
     coco_error("Though shalt not cheat! Trying to evaluate a tainted observed problem. Do _not_ call "
                "coco_problem_best_parameter() on a problem you want to benchmark.");
   }
 
-  coco_debug("Started logger_bbob_evaluate()");
-
   if (!logger->is_initialized) {
     logger_bbob_initialize(logger, problem->is_opt_known);
   }
-  if ((coco_log_level >= COCO_DEBUG) && logger->num_func_evaluations == 0) {
+  if ((COCO_ATOMIC_LOAD(coco_log_level) >= COCO_DEBUG) && logger->num_func_evaluations == 0) {
     coco_debug("%4lu: ", (unsigned long)inner_problem->suite_dep_index);
     coco_debug("on problem %s ... ", coco_problem_get_id(inner_problem));
   }
+}
+
+/**
+ * @brief Updates the logger state with the evaluation of x, which resulted in y, and outputs the
+ * corresponding lines to the data files.
+ */
+static void logger_bbob_log_evaluation(coco_problem_t *problem, logger_bbob_data_t *logger, const double *x,
+                                       const double *y, const int is_feasible) {
+  size_t i;
+  double y_logged, max_value = 0, sum_constraints;
+  double *constraints = NULL;
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
-  /* Fulfill contract of a COCO evaluate function */
-  coco_evaluate_function(inner_problem, x, y);
   logger->num_func_evaluations++;
   logger->current_value = y[0];
   y_logged = y[0];
@@ -412,10 +664,10 @@ static void logger_bbob_evaluate(coco_problem_t *problem, const double *x, doubl
     assert(y_logged + 1e-13 >= logger->optimal_value);
   }
 
-  /* Evaluate the constraints */
+  /* Evaluate the constraints (the values are stored in the scratch memory of the logger problem) */
   if (problem->number_of_constraints > 0) {
-    constraints = coco_allocate_vector(problem->number_of_constraints);
-    inner_problem->evaluate_constraint(inner_problem, x, constraints, 0);
+    constraints = problem->scratch;
+    coco_evaluate_constraint_memoized(inner_problem, x, constraints, 0);
   }
   logger->num_cons_evaluations = problem->evaluations_constraints;
 
@@ -471,14 +723,67 @@ static void logger_bbob_evaluate(coco_problem_t *problem, const double *x, doubl
     logger_bbob_output(logger->rdat_file, logger, x, y_logged, logger->best_found_value, constraints);
     logger->algorithm_restarted = 0;
   }
+}
 
-  /* Free allocated memory */
-  if (problem->number_of_constraints > 0)
-    coco_free_memory(constraints);
+/**
+ * @brief Evaluates the function, increases the number of evaluations and outputs information according to
+ * observer options.
+ */
+static void logger_bbob_evaluate(coco_problem_t *problem, const double *x, double *y) {
+  logger_bbob_data_t *logger = (logger_bbob_data_t *)coco_problem_transformed_get_data(problem);
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  const int is_feasible = problem->number_of_constraints <= 0 || coco_is_feasible(inner_problem, x, NULL);
+
+  coco_debug("Started logger_bbob_evaluate()");
+  logger_bbob_start_evaluation(problem, logger);
+
+  /* Fulfill contract of a COCO evaluate function */
+  coco_evaluate_function(inner_problem, x, y);
+  logger_bbob_log_evaluation(problem, logger, x, y, is_feasible);
 
   coco_debug("Ended   logger_bbob_evaluate()");
 }
 
+/**
+ * @brief Evaluates the function and its gradient, which is logged as a single evaluation.
+ *
+ * Only used for problems without constraints, so that all points are feasible.
+ */
+static void logger_bbob_evaluate_function_and_gradient(coco_problem_t *problem, const double *x, double *y,
+                                                       double *gradient) {
+  logger_bbob_data_t *logger = (logger_bbob_data_t *)coco_problem_transformed_get_data(problem);
+
+  coco_debug("Started logger_bbob_evaluate_function_and_gradient()");
+  logger_bbob_start_evaluation(problem, logger);
+
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), x, y, gradient);
+  logger_bbob_log_evaluation(problem, logger, x, y, 1);
+
+  coco_debug("Ended   logger_bbob_evaluate_function_and_gradient()");
+}
+
+/**
+ * @brief Evaluates the function in a batch of points and logs each of the evaluations in turn.
+ *
+ * Only used for problems without constraints and noise, so that all points are feasible and the
+ * logged values are the function values.
+ */
+static void logger_bbob_evaluate_batch(coco_problem_t *problem, const double *x, double *y,
+                                       const size_t number_of_points) {
+  size_t k;
+  logger_bbob_data_t *logger = (logger_bbob_data_t *)coco_problem_transformed_get_data(problem);
+
+  coco_debug("Started logger_bbob_evaluate_batch()");
+  logger_bbob_start_evaluation(problem, logger);
+
+  coco_evaluate_function_batch(coco_problem_transformed_get_inner_problem(problem), x, y, number_of_points);
+  for (k = 0; k < number_of_points; k++)
+    logger_bbob_log_evaluation(problem, logger, x + k * problem->number_of_variables,
+                               y + k * problem->number_of_objectives, 1);
+
+  coco_debug("Ended   logger_bbob_evaluate_batch()");
+}
+
 /**
  * @brief Evaluates the function and outputs information according to observer options to the file with
  * recommendations. The evaluation result is not returned and the evaluation counter is not increased.
@@ -495,7 +800,7 @@ static void logger_bbob_recommend(coco_problem_t *problem, const double *x) {
   }
 
   /* Fulfill contract of a COCO evaluate function, but do not increase the evaluation counters */
-  y = coco_allocate_vector(problem->number_of_objectives);
+  y = problem->scratch;
   coco_evaluate_function(inner_problem, x, y);
 
   y_logged = y[0];
@@ -503,7 +808,6 @@ static void logger_bbob_recommend(coco_problem_t *problem, const double *x) {
     y_logged = NAN_FOR_LOGGING;
   else if (coco_is_inf(y_logged))
     y_logged = INFINITY_FOR_LOGGING;
-  coco_free_memory(y);
 
   /* Do sanity check */
   if ((problem->is_opt_known) && (is_feasible)) {
@@ -511,10 +815,10 @@ static void logger_bbob_recommend(coco_problem_t *problem, const double *x) {
     assert(y_logged + 1e-13 >= logger->optimal_value);
   }
 
-  /* Evaluate the constraints */
+  /* Evaluate the constraints (the values are stored in the scratch memory of the logger problem) */
   if (problem->number_of_constraints > 0) {
-    constraints = coco_allocate_vector(problem->number_of_constraints);
-    inner_problem->evaluate_constraint(inner_problem, x, constraints, 0);
+    constraints = problem->scratch;
+    coco_evaluate_constraint_memoized(inner_problem, x, constraints, 0);
   }
 
   /* Compute the sum of positive constraint values */
@@ -555,10 +859,6 @@ static void logger_bbob_recommend(coco_problem_t *problem, const double *x) {
       logger->last_logged_eval_mdat = logger->num_func_evaluations;
     }
   }
-
-  /* Free allocated memory */
-  if (problem->number_of_constraints > 0)
-    coco_free_memory(constraints);
 }
 
 /**
@@ -572,7 +872,7 @@ static void logger_bbob_free(void *stuff) {
 
   coco_debug("Started logger_bbob_free()");
 
-  if ((coco_log_level >= COCO_DEBUG) && logger && logger->num_func_evaluations > 0) {
+  if ((COCO_ATOMIC_LOAD(coco_log_level) >= COCO_DEBUG) && logger && logger->num_func_evaluations > 0) {
     coco_debug("best f=%e after %lu fevals (done observing)\n", logger->best_found_value,
                (unsigned long)logger->num_func_evaluations);
   }
@@ -583,6 +883,17 @@ static void logger_bbob_free(void *stuff) {
     logger->info_file = NULL;
   }
 
+  if (logger->info_header != NULL) {
+    logger_bbob_write_info_line(logger);
+    coco_free_memory(logger->info_header);
+    logger->info_header = NULL;
+  }
+
+  if (logger->info_file_path != NULL) {
+    coco_free_memory(logger->info_file_path);
+    logger->info_file_path = NULL;
+  }
+
   if (logger->dat_file != NULL) {
     if (logger->num_func_evaluations != logger->last_logged_eval_dat)
       logger_bbob_output(logger->dat_file, logger, logger->best_found_solution, logger->best_found_value, 
@@ -622,6 +933,16 @@ static void logger_bbob_free(void *stuff) {
     logger->best_recommended_solution = NULL;
   }
 
+  if (logger->line != NULL) {
+    coco_free_memory(logger->line);
+    logger->line = NULL;
+  }
+
+  logger_binary_layout_free(logger->constraints_layout);
+  logger->constraints_layout = NULL;
+  logger_binary_layout_free(logger->value_layout);
+  logger->value_layout = NULL;
+
   if (logger->targets != NULL) {
     coco_observer_targets_free(logger->targets);
     logger->targets = NULL;
@@ -637,6 +958,13 @@ static void logger_bbob_free(void *stuff) {
     logger->mdat_targets = NULL;
   }
 
+  if (logger->shared != NULL) {
+    /* The observer of a thread-safe logger is accessed only through the shared state */
+    observer_bbob_shared_release(logger->shared);
+    logger->shared = NULL;
+    logger->observer = NULL;
+  }
+
   observer = logger->observer;
   if ((observer != NULL) && (observer->is_active == 1)) {
     if (observer->data != NULL) {
@@ -668,6 +996,9 @@ static void logger_bbob_signal_restart(coco_problem_t *problem) {
 
   if (logger->num_func_evaluations > 0)
     logger->algorithm_restarted = 1;
+
+  /* Make the output of the finished run available */
+  logger_bbob_flush(logger);
 }
 
 static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *inner_problem) {
@@ -690,7 +1021,7 @@ static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *in
   assert(observer != NULL);
   observer_data = (observer_bbob_data_t *)observer->data;
   assert(observer_data != NULL);
-  if (observer_data->observed_problem != NULL) {
+  if ((observer_data->shared == NULL) && (observer_data->observed_problem != NULL)) {
     coco_error("logger_bbob(): The observed problem must be closed before a new problem can be observed");
   }
 
@@ -706,6 +1037,17 @@ static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *in
   logger_data->rdat_file = NULL;
   logger_data->mdat_file = NULL;
 
+  logger_data->impatient = observer_data->impatient;
+  logger_data->flush_interval = observer_data->flush_interval;
+  logger_data->buffer_size = observer_data->buffer_size;
+  logger_data->last_flush_time = 0;
+
+  logger_data->shared = NULL;
+  if (observer_data->shared != NULL)
+    logger_data->shared = observer_bbob_shared_acquire(observer_data->shared);
+  logger_data->info_file_path = NULL;
+  logger_data->info_header = NULL;
+
   logger_data->num_func_evaluations = 0;
   logger_data->num_cons_evaluations = 0;
   logger_data->last_logged_eval_mdat = 0;
@@ -727,6 +1069,20 @@ static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *in
   logger_data->log_discrete_as_int = observer->log_discrete_as_int;
   logger_data->number_of_constraints = inner_problem->number_of_constraints;
 
+  /* Two evaluation counters, three function values, the constraint digits and the variables */
+  logger_data->line = coco_allocate_string((5 + LOGGER_BBOB_NUMBER_OF_VARIABLES_THRESHOLD) *
+                                               LOGGER_BBOB_MAX_NUMBER_LENGTH +
+                                           inner_problem->number_of_constraints + 2);
+
+  logger_data->binary_format = observer->binary_format;
+  logger_data->constraints_layout = NULL;
+  logger_data->value_layout = NULL;
+  if (logger_data->binary_format) {
+    if (logger_data->number_of_constraints > 0)
+      logger_data->constraints_layout = logger_bbob_layout(logger_data, 1);
+    logger_data->value_layout = logger_bbob_layout(logger_data, 0);
+  }
+
   /* Initialize triggers performance and evaluation triggers depending on the observer option */
   logger_data->targets = coco_observer_targets(suite->known_optima, observer->lin_target_precision,
                                                observer->number_target_triggers, observer->log_target_precision);
@@ -739,8 +1095,14 @@ static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *in
 
   problem = coco_problem_transformed_allocate(inner_problem, logger_data, logger_bbob_free, observer->observer_name);
   problem->evaluate_function = logger_bbob_evaluate;
+  if (problem->number_of_constraints == 0 && !inner_problem->is_noisy)
+    problem->evaluate_function_batch = logger_bbob_evaluate_batch;
+  if (problem->number_of_objectives == 1 && problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = logger_bbob_evaluate_function_and_gradient;
   problem->recommend_solution = logger_bbob_recommend;
 
-  observer_data->observed_problem = problem;
+  /* A thread-safe observer can observe several problems at the same time */
+  if (observer_data->shared == NULL)
+    observer_data->observed_problem = problem;
   return problem;
 }
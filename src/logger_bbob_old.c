@@ -417,7 +417,7 @@ static void logger_bbob_old_evaluate(coco_problem_t *problem, const double *x, d
   if (!logger->is_initialized) {
     logger_bbob_old_initialize(logger, inner_problem);
   }
-  if ((coco_log_level >= COCO_DEBUG) && logger->number_of_evaluations == 0) {
+  if ((COCO_ATOMIC_LOAD(coco_log_level) >= COCO_DEBUG) && logger->number_of_evaluations == 0) {
     coco_debug("%4lu: ", (unsigned long)inner_problem->suite_dep_index);
     coco_debug("on problem %s ... ", coco_problem_get_id(inner_problem));
   }
@@ -440,8 +440,8 @@ static void logger_bbob_old_evaluate(coco_problem_t *problem, const double *x, d
 
   /* Evaluate the constraints */
   if (problem->number_of_constraints > 0) {
-    cons = coco_allocate_vector(problem->number_of_constraints);
-    inner_problem->evaluate_constraint(inner_problem, x, cons, 0);
+    cons = problem->scratch;
+    coco_evaluate_constraint_memoized(inner_problem, x, cons, 0);
   }
 
   /* Compute the sum of positive constraint values */
@@ -489,10 +489,6 @@ static void logger_bbob_old_evaluate(coco_problem_t *problem, const double *x, d
     logger->written_last_eval = 1;
   }
 
-  /* Free allocated memory */
-  if (problem->number_of_constraints > 0)
-    coco_free_memory(cons);
-
 } /* end logger_bbob_old_evaluate */
 
 /**
@@ -511,7 +507,7 @@ static void logger_bbob_old_free(void *stuff) {
   if (stuff == NULL)
     return;
 
-  if ((coco_log_level >= COCO_DEBUG) && logger && logger->number_of_evaluations > 0) {
+  if ((COCO_ATOMIC_LOAD(coco_log_level) >= COCO_DEBUG) && logger && logger->number_of_evaluations > 0) {
     coco_debug("best f=%e after %lu fevals (done observing)\n", logger->best_fvalue,
                (unsigned long)logger->number_of_evaluations);
   }
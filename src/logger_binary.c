@@ -0,0 +1,427 @@
+/**
+ * @file logger_binary.c
+ * @brief Implementation of the binary format of the data files written by the loggers.
+ *
+ * If the observer option "format: binary" is given, the bbob, bbob-biobj and rw loggers write each data
+ * file (e.g. "bbobexp_f1_DIM2.dat") as a binary file with an additional extension (e.g.
+ * "bbobexp_f1_DIM2.dat.bin"). The binary file stores the numbers instead of their text representation,
+ * but contains enough information to reproduce the text file exactly (see
+ * coco_observer_convert_binary_file()).
+ *
+ * All numbers are stored in little-endian byte order. A binary file starts with the eight characters
+ * "COCOBIN\n" followed by the format version (uint32). Then follows a sequence of blocks, each starting
+ * with one character:
+ * - 'T' (text): the length of the text (uint32) followed by the text (e.g. a header of a data file),
+ * which is copied to the text file verbatim.
+ * - 'L' (layout): defines the columns of the lines of a data file. Contains the layout identifier
+ * (uint8), the length of the line terminator (uint8), the line terminator (e.g. "\n"), the number of
+ * columns (uint32) and five bytes for each column: the type of the column (see
+ * logger_binary_column_type_e), the width, the precision, whether the plus sign is output (all uint8)
+ * and the separator that precedes the column ('\0' for none).
+ * - 'R' (record): a line of a data file. Contains the layout identifier (uint8) and a value for each
+ * column of this layout, which takes 8 (uint64 or double) or 4 (int32) bytes depending on the type of
+ * the column.
+ *
+ * The records that share a layout have a fixed size, so they can be read column by column without any
+ * parsing. A layout is written each time a data file is (re)opened by a logger and holds for all
+ * following records with its identifier.
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <assert.h>
+
+#include "coco.h"
+
+#include "coco_utilities.c"
+#include "coco_string.c"
+
+/**
+ * @brief The extension added to the name of a data file when written in the binary format.
+ */
+#define LOGGER_BINARY_FILE_EXTENSION ".bin"
+
+/**
+ * @brief The first eight characters of each binary data file.
+ */
+#define LOGGER_BINARY_MAGIC "COCOBIN\n"
+
+/**
+ * @brief The version of the binary format.
+ */
+#define LOGGER_BINARY_FORMAT_VERSION 1
+
+/**
+ * @brief The types of the columns and their text formats.
+ */
+typedef enum {
+  LOGGER_BINARY_COUNTER = 1,     /**< @brief Counter stored as uint64, formatted as "%lu" */
+  LOGGER_BINARY_EXPONENTIAL = 2, /**< @brief Double, formatted as "%*.*e" or "%+*.*e" */
+  LOGGER_BINARY_FIXED = 3,       /**< @brief Double, formatted as "%.*f" */
+  LOGGER_BINARY_INT = 4          /**< @brief Integer stored as int32, formatted as "%d" */
+} logger_binary_column_type_e;
+
+/**
+ * @brief A column of a layout.
+ */
+typedef struct {
+  unsigned char type;      /**< @brief The type of the column (see logger_binary_column_type_e). */
+  unsigned char width;     /**< @brief The minimal width of the formatted number. */
+  unsigned char precision; /**< @brief The number of digits after the decimal point. */
+  unsigned char plus_sign; /**< @brief Whether the plus sign of positive numbers is output. */
+  char separator;          /**< @brief The character that precedes the column ('\0' for none). */
+} logger_binary_column_t;
+
+/**
+ * @brief The layout of the lines of a data file together with the record that is currently being filled.
+ */
+typedef struct {
+  unsigned char id;                /**< @brief The identifier of the layout (unique within a data file). */
+  char terminator[4];              /**< @brief The characters that terminate the line. */
+  size_t number_of_columns;        /**< @brief The number of columns. */
+  logger_binary_column_t *columns; /**< @brief The columns. */
+
+  unsigned char *record;       /**< @brief The record that is currently being filled. */
+  size_t record_size;          /**< @brief The size of a complete record (including the tag and identifier). */
+  size_t current_column;       /**< @brief The index of the next column of the current record. */
+  size_t current_record_size;  /**< @brief The number of bytes of the current record filled so far. */
+} logger_binary_layout_t;
+
+/**
+ * @brief Returns the number of bytes used to store a value of the column type.
+ */
+static size_t logger_binary_column_size(const unsigned char type) {
+  return (type == LOGGER_BINARY_INT) ? 4 : 8;
+}
+
+/**
+ * @brief Stores value in number_of_bytes bytes in little-endian byte order.
+ */
+static void logger_binary_put_bytes(unsigned char *bytes, uint64_t value, const size_t number_of_bytes) {
+  size_t i;
+  for (i = 0; i < number_of_bytes; i++) {
+    bytes[i] = (unsigned char)(value & 0xFF);
+    value >>= 8;
+  }
+}
+
+/**
+ * @brief Returns the value stored in number_of_bytes bytes in little-endian byte order.
+ */
+static uint64_t logger_binary_get_bytes(const unsigned char *bytes, const size_t number_of_bytes) {
+  uint64_t value = 0;
+  size_t i;
+  for (i = number_of_bytes; i > 0; i--)
+    value = (value << 8) | bytes[i - 1];
+  return value;
+}
+
+/**
+ * @brief Allocates a layout with the given number of columns and line terminator (of at most 3 characters).
+ *
+ * The columns need to be set with logger_binary_layout_set_column() before the layout is used.
+ */
+static logger_binary_layout_t *logger_binary_layout_allocate(const unsigned char id, const size_t number_of_columns,
+                                                             const char *terminator) {
+  logger_binary_layout_t *layout = (logger_binary_layout_t *)coco_allocate_memory(sizeof(*layout));
+  size_t i;
+
+  assert(strlen(terminator) < sizeof(layout->terminator));
+  layout->id = id;
+  strcpy(layout->terminator, terminator);
+  layout->number_of_columns = number_of_columns;
+  layout->columns = (logger_binary_column_t *)coco_allocate_memory(
+      ((number_of_columns > 0) ? number_of_columns : 1) * sizeof(logger_binary_column_t));
+  for (i = 0; i < number_of_columns; i++) {
+    layout->columns[i].type = LOGGER_BINARY_COUNTER;
+    layout->columns[i].width = 0;
+    layout->columns[i].precision = 0;
+    layout->columns[i].plus_sign = 0;
+    layout->columns[i].separator = '\0';
+  }
+  layout->record = (unsigned char *)coco_allocate_memory(2 + 8 * number_of_columns);
+  layout->record_size = 2 + 8 * number_of_columns;
+  layout->current_column = 0;
+  layout->current_record_size = 0;
+  return layout;
+}
+
+/**
+ * @brief Sets the column with the given index.
+ */
+static void logger_binary_layout_set_column(logger_binary_layout_t *layout, const size_t index,
+                                            const logger_binary_column_type_e type, const int width,
+                                            const int precision, const int plus_sign, const char separator) {
+  size_t i;
+
+  assert(index < layout->number_of_columns);
+  layout->columns[index].type = (unsigned char)type;
+  layout->columns[index].width = (unsigned char)width;
+  layout->columns[index].precision = (unsigned char)precision;
+  layout->columns[index].plus_sign = (unsigned char)(plus_sign != 0);
+  layout->columns[index].separator = separator;
+
+  layout->record_size = 2;
+  for (i = 0; i < layout->number_of_columns; i++)
+    layout->record_size += logger_binary_column_size(layout->columns[i].type);
+}
+
+/**
+ * @brief Frees the layout.
+ */
+static void logger_binary_layout_free(logger_binary_layout_t *layout) {
+  if (layout == NULL)
+    return;
+  coco_free_memory(layout->columns);
+  coco_free_memory(layout->record);
+  coco_free_memory(layout);
+}
+
+/**
+ * @brief Opens the binary file in append mode and writes the magic characters and version if it is empty.
+ *
+ * @return The opened file or NULL if it could not be opened.
+ */
+static FILE *logger_binary_open_file(const char *file_path) {
+  unsigned char version[4];
+  FILE *file = fopen(file_path, "ab");
+
+  if (file == NULL)
+    return NULL;
+  fseek(file, 0, SEEK_END);
+  if (ftell(file) == 0) {
+    fwrite(LOGGER_BINARY_MAGIC, 1, strlen(LOGGER_BINARY_MAGIC), file);
+    logger_binary_put_bytes(version, LOGGER_BINARY_FORMAT_VERSION, 4);
+    fwrite(version, 1, 4, file);
+  }
+  return file;
+}
+
+/**
+ * @brief Writes the layout definition to the binary file.
+ */
+static void logger_binary_write_layout(FILE *file, const logger_binary_layout_t *layout) {
+  unsigned char bytes[4];
+  size_t i;
+
+  fputc('L', file);
+  fputc(layout->id, file);
+  fputc((int)strlen(layout->terminator), file);
+  fwrite(layout->terminator, 1, strlen(layout->terminator), file);
+  logger_binary_put_bytes(bytes, (uint64_t)layout->number_of_columns, 4);
+  fwrite(bytes, 1, 4, file);
+  for (i = 0; i < layout->number_of_columns; i++) {
+    fputc(layout->columns[i].type, file);
+    fputc(layout->columns[i].width, file);
+    fputc(layout->columns[i].precision, file);
+    fputc(layout->columns[i].plus_sign, file);
+    fputc(layout->columns[i].separator, file);
+  }
+}
+
+/**
+ * @brief Outputs the formatted text either to a text file (as with fprintf) or as a text block to a binary
+ * file.
+ */
+static void logger_binary_output_text(FILE *file, const int is_binary, const char *format, ...) {
+  unsigned char length[4];
+  va_list args;
+  char *text;
+
+  va_start(args, format);
+  if (!is_binary) {
+    vfprintf(file, format, args);
+  } else {
+    text = coco_vstrdupf(format, args);
+    fputc('T', file);
+    logger_binary_put_bytes(length, (uint64_t)strlen(text), 4);
+    fwrite(length, 1, 4, file);
+    fwrite(text, 1, strlen(text), file);
+    coco_free_memory(text);
+  }
+  va_end(args);
+}
+
+/**
+ * @brief Starts a new record of the layout.
+ */
+static void logger_binary_record_start(logger_binary_layout_t *layout) {
+  layout->record[0] = 'R';
+  layout->record[1] = layout->id;
+  layout->current_column = 0;
+  layout->current_record_size = 2;
+}
+
+/**
+ * @brief Adds the next value to the current record of the layout (it is converted to the column type).
+ */
+static void logger_binary_record_add(logger_binary_layout_t *layout, const double value) {
+  const unsigned char type = layout->columns[layout->current_column].type;
+  uint64_t bits;
+
+  assert(layout->current_column < layout->number_of_columns);
+  if (type == LOGGER_BINARY_COUNTER) {
+    bits = (uint64_t)value;
+  } else if (type == LOGGER_BINARY_INT) {
+    bits = (uint64_t)(uint32_t)(int32_t)value;
+  } else {
+    memcpy(&bits, &value, sizeof(bits));
+  }
+  logger_binary_put_bytes(layout->record + layout->current_record_size, bits, logger_binary_column_size(type));
+  layout->current_record_size += logger_binary_column_size(type);
+  layout->current_column++;
+}
+
+/**
+ * @brief Adds the next counter value to the current record of the layout.
+ *
+ * Unlike logger_binary_record_add(), this function handles counters that are not exactly representable
+ * as a double.
+ */
+static void logger_binary_record_add_counter(logger_binary_layout_t *layout, const size_t value) {
+  assert(layout->current_column < layout->number_of_columns);
+  assert(layout->columns[layout->current_column].type == LOGGER_BINARY_COUNTER);
+  logger_binary_put_bytes(layout->record + layout->current_record_size, (uint64_t)value, 8);
+  layout->current_record_size += 8;
+  layout->current_column++;
+}
+
+/**
+ * @brief Writes the current (complete) record of the layout to the binary file.
+ */
+static void logger_binary_record_write(FILE *file, const logger_binary_layout_t *layout) {
+  assert(layout->current_column == layout->number_of_columns);
+  assert(layout->current_record_size == layout->record_size);
+  fwrite(layout->record, 1, layout->current_record_size, file);
+}
+
+/**
+ * @brief Reads number_of_bytes bytes from the binary file or raises an error if the file ends prematurely.
+ */
+static void logger_binary_read(FILE *file, unsigned char *bytes, const size_t number_of_bytes,
+                               const char *file_name) {
+  if (fread(bytes, 1, number_of_bytes, file) != number_of_bytes) {
+    coco_error("coco_observer_convert_binary_file(): unexpected end of file %s", file_name);
+  }
+}
+
+void coco_observer_convert_binary_file(const char *binary_file_name, const char *text_file_name) {
+
+  FILE *binary_file, *text_file;
+  logger_binary_layout_t *layouts[256] = {NULL};
+  logger_binary_layout_t *layout;
+  logger_binary_column_t *column;
+  unsigned char bytes[8];
+  char number[COCO_FORMAT_MAX_LENGTH + 2];
+  char *text;
+  size_t i, length;
+  int tag;
+  uint64_t value;
+  double double_value;
+
+  binary_file = fopen(binary_file_name, "rb");
+  if (binary_file == NULL) {
+    coco_error("coco_observer_convert_binary_file(): failed to open file %s", binary_file_name);
+    return; /* Never reached */
+  }
+  logger_binary_read(binary_file, bytes, 8, binary_file_name);
+  if (memcmp(bytes, LOGGER_BINARY_MAGIC, 8) != 0) {
+    coco_error("coco_observer_convert_binary_file(): %s is not a binary data file", binary_file_name);
+  }
+  logger_binary_read(binary_file, bytes, 4, binary_file_name);
+  if (logger_binary_get_bytes(bytes, 4) != LOGGER_BINARY_FORMAT_VERSION) {
+    coco_error("coco_observer_convert_binary_file(): unsupported format version %lu of file %s",
+               (unsigned long)logger_binary_get_bytes(bytes, 4), binary_file_name);
+  }
+
+  text_file = fopen(text_file_name, "w");
+  if (text_file == NULL) {
+    coco_error("coco_observer_convert_binary_file(): failed to open file %s", text_file_name);
+    return; /* Never reached */
+  }
+
+  while ((tag = fgetc(binary_file)) != EOF) {
+    if (tag == 'T') {
+      logger_binary_read(binary_file, bytes, 4, binary_file_name);
+      length = (size_t)logger_binary_get_bytes(bytes, 4);
+      text = coco_allocate_string(length + 1);
+      logger_binary_read(binary_file, (unsigned char *)text, length, binary_file_name);
+      text[length] = '\0';
+      fputs(text, text_file);
+      coco_free_memory(text);
+    } else if (tag == 'L') {
+      logger_binary_read(binary_file, bytes, 2, binary_file_name);
+      if (bytes[1] > 3) {
+        coco_error("coco_observer_convert_binary_file(): corrupted layout in file %s", binary_file_name);
+      }
+      layout = logger_binary_layout_allocate(bytes[0], 0, "");
+      logger_binary_read(binary_file, (unsigned char *)layout->terminator, bytes[1], binary_file_name);
+      layout->terminator[bytes[1]] = '\0';
+      logger_binary_read(binary_file, bytes, 4, binary_file_name);
+      layout->number_of_columns = (size_t)logger_binary_get_bytes(bytes, 4);
+      coco_free_memory(layout->columns);
+      layout->columns = (logger_binary_column_t *)coco_allocate_memory(
+          ((layout->number_of_columns > 0) ? layout->number_of_columns : 1) * sizeof(logger_binary_column_t));
+      layout->record_size = 2;
+      for (i = 0; i < layout->number_of_columns; i++) {
+        logger_binary_read(binary_file, bytes, 5, binary_file_name);
+        layout->columns[i].type = bytes[0];
+        layout->columns[i].width = bytes[1];
+        layout->columns[i].precision = bytes[2];
+        layout->columns[i].plus_sign = bytes[3];
+        layout->columns[i].separator = (char)bytes[4];
+        if ((bytes[0] < LOGGER_BINARY_COUNTER) || (bytes[0] > LOGGER_BINARY_INT) || (bytes[1] > 32) ||
+            (bytes[2] > 32)) {
+          coco_error("coco_observer_convert_binary_file(): corrupted layout in file %s", binary_file_name);
+        }
+        layout->record_size += logger_binary_column_size(bytes[0]);
+      }
+      logger_binary_layout_free(layouts[layout->id]);
+      layouts[layout->id] = layout;
+    } else if (tag == 'R') {
+      logger_binary_read(binary_file, bytes, 1, binary_file_name);
+      layout = layouts[bytes[0]];
+      if (layout == NULL) {
+        coco_error("coco_observer_convert_binary_file(): record with undefined layout %d in file %s",
+                   (int)bytes[0], binary_file_name);
+        return; /* Never reached */
+      }
+      for (i = 0; i < layout->number_of_columns; i++) {
+        column = &layout->columns[i];
+        logger_binary_read(binary_file, bytes, logger_binary_column_size(column->type), binary_file_name);
+        value = logger_binary_get_bytes(bytes, logger_binary_column_size(column->type));
+        length = 0;
+        if (column->separator != '\0')
+          number[length++] = column->separator;
+        if (column->type == LOGGER_BINARY_COUNTER) {
+          length += coco_format_unsigned_long(number + length, (unsigned long)value);
+        } else if (column->type == LOGGER_BINARY_INT) {
+          length += coco_format_int(number + length, (int)(int32_t)(uint32_t)value);
+        } else {
+          memcpy(&double_value, &value, sizeof(double_value));
+          if (column->type == LOGGER_BINARY_EXPONENTIAL) {
+            length += coco_format_exponential(number + length, double_value, column->width, column->precision,
+                                              column->plus_sign);
+          } else {
+            /* The length of fixed-point numbers is not bounded, so they are output directly */
+            number[length] = '\0';
+            fputs(number, text_file);
+            fprintf(text_file, "%.*f", (int)column->precision, double_value);
+            continue;
+          }
+        }
+        number[length] = '\0';
+        fputs(number, text_file);
+      }
+      fputs(layout->terminator, text_file);
+    } else {
+      coco_error("coco_observer_convert_binary_file(): unknown block '%c' in file %s", (char)tag, binary_file_name);
+    }
+  }
+
+  for (i = 0; i < 256; i++)
+    logger_binary_layout_free(layouts[i]);
+  fclose(text_file);
+  fclose(binary_file);
+}
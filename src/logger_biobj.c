@@ -32,6 +32,9 @@
  * instances of that problem.
  * One .adat file is created for each problem function, dimension and instance.
  *
+ * With the observer option "format: binary", the .dat, .tdat, .rdat, .mdat and .adat files are written in
+ * the binary format described in logger_binary.c (the .info files are always written as text).
+ *
  * @note Whenever in this file a ROI is mentioned, it means the (normalized) region of interest in the
  * objective space. The non-normalized ROI is a rectangle with the ideal and nadir points as its two
  * opposite vertices, while the normalized ROI is the square [0, 1]^2. If not specifically mentioned, the
@@ -49,7 +52,9 @@
 #include "coco_problem.c"
 #include "coco_string.c"
 #include "mo_avl_tree.c"
+#include "mo_front.c"
 #include "observer_biobj.c"
+#include "logger_binary.c"
 
 #include "mo_utilities.c"
 
@@ -138,9 +143,16 @@ typedef struct {
 
   size_t previous_evaluations; /**< @brief The number of evaluations from the previous call to the logger. */
 
-  avl_tree_t *archive_tree; /**< @brief The tree keeping currently non-dominated solutions. */
-  avl_tree_t *buffer_tree;  /**< @brief The tree with pointers to nondominated solutions that haven't
-                                 been logged yet. */
+  mo_front_t *archive_front;  /**< @brief The front keeping currently non-dominated solutions. */
+  avl_tree_t *buffer_tree;    /**< @brief The tree with pointers to nondominated solutions that haven't
+                                   been logged yet. */
+  avl_node_pool_t *node_pool; /**< @brief The pool of the nodes of buffer_tree. */
+
+  int binary_format;                   /**< @brief Whether the data files are written in the binary format. */
+  logger_binary_layout_t *adat_layout; /**< @brief Layout of the lines of the .adat file (binary format). */
+  logger_binary_layout_t *mdat_layout; /**< @brief Layout of the lines of the .mdat file (binary format). */
+  logger_binary_layout_t *dat_layout;  /**< @brief Layout of the lines of the .dat files (binary format). */
+  logger_binary_layout_t *tdat_layout; /**< @brief Layout of the lines of the .tdat and .rdat files (binary format). */
 
   /* TODO: Implement other indicators */
   int compute_indicators; /**< @brief Whether to compute the indicators. */
@@ -170,6 +182,8 @@ typedef struct {
 
 /**
  * @brief Creates and returns the information on the solution in the form of a node's item in the AVL tree.
+ *
+ * The item and its vectors x, y and normalized_y are stored in a single block of memory.
  */
 static logger_biobj_avl_item_t *logger_biobj_node_create(const coco_problem_t *problem, const double *x,
                                                          const double *y, const double *constraints,
@@ -179,12 +193,13 @@ static logger_biobj_avl_item_t *logger_biobj_node_create(const coco_problem_t *p
   size_t i;
   double sum_constraints = 0;
 
-  /* Allocate memory to hold the data structure logger_biobj_node_t */
-  logger_biobj_avl_item_t *item = (logger_biobj_avl_item_t *)coco_allocate_memory(sizeof(*item));
-
-  /* Allocate memory to store the (copied) data of the new node */
-  item->x = coco_allocate_vector(dim);
-  item->y = coco_allocate_vector(num_obj);
+  /* Allocate memory to hold the data structure logger_biobj_node_t followed by its vectors (the size of the
+   * structure is a multiple of the alignment of double, since it contains doubles) */
+  logger_biobj_avl_item_t *item = (logger_biobj_avl_item_t *)coco_allocate_memory(
+      sizeof(*item) + (dim + 2 * num_obj) * sizeof(double));
+  item->x = (double *)(item + 1);
+  item->y = item->x + dim;
+  item->normalized_y = item->y + num_obj;
 
   /* Copy the data */
   for (i = 0; i < dim; i++)
@@ -193,7 +208,7 @@ static logger_biobj_avl_item_t *logger_biobj_node_create(const coco_problem_t *p
     item->y[i] = y[i];
 
   /* Compute the normalized y */
-  item->normalized_y = mo_normalize(item->y, problem->best_value, problem->nadir_value, num_obj);
+  mo_normalize_to(item->y, problem->best_value, problem->nadir_value, num_obj, item->normalized_y);
   item->within_ROI = mo_is_within_ROI(item->normalized_y, num_obj);
 
   item->evaluation_number = evaluation_number;
@@ -219,29 +234,10 @@ static logger_biobj_avl_item_t *logger_biobj_node_create(const coco_problem_t *p
  */
 static void logger_biobj_node_free(logger_biobj_avl_item_t *item, void *userdata) {
 
-  coco_free_memory(item->x);
-  coco_free_memory(item->y);
-  coco_free_memory(item->normalized_y);
   coco_free_memory(item);
   (void)userdata; /* To silence the compiler */
 }
 
-/**
- * @brief Defines the ordering of AVL tree nodes based on the value of the last objective.
- *
- * @note This ordering is used by the archive_tree.
- */
-static int avl_tree_compare_by_last_objective(const logger_biobj_avl_item_t *item1,
-                                              const logger_biobj_avl_item_t *item2, void *userdata) {
-  (void)userdata; /* To silence the compiler */
-  if (coco_double_almost_equal(item1->normalized_y[1], item2->normalized_y[1], mo_precision))
-    return 0;
-  else if (item1->normalized_y[1] < item2->normalized_y[1])
-    return -1;
-  else
-    return 1;
-}
-
 /**
  * @brief Defines the ordering of AVL tree nodes based on the evaluation number (the time when the nodes were
  * created).
@@ -259,12 +255,117 @@ static int avl_tree_compare_by_eval_number(const logger_biobj_avl_item_t *item1,
     return 0;
 }
 
+/**
+ * @brief Starts a line of a data file with the evaluation number (like "%lu").
+ *
+ * The line is output to a text file if layout is NULL and as a record of the layout to a binary file
+ * otherwise.
+ */
+static void logger_biobj_output_evaluation(FILE *file, logger_binary_layout_t *layout,
+                                           const size_t evaluation_number) {
+  char number[COCO_FORMAT_MAX_LENGTH + 1];
+
+  if (layout != NULL) {
+    logger_binary_record_start(layout);
+    logger_binary_record_add_counter(layout, evaluation_number);
+  } else {
+    coco_format_unsigned_long(number, (unsigned long)evaluation_number);
+    fputs(number, file);
+  }
+}
+
+/**
+ * @brief Continues a line of a data file with the value preceded by a tab (like "\t%.*e").
+ */
+static void logger_biobj_output_value(FILE *file, logger_binary_layout_t *layout, const double value,
+                                      const int precision) {
+  char number[COCO_FORMAT_MAX_LENGTH + 1];
+
+  if (layout != NULL) {
+    logger_binary_record_add(layout, value);
+  } else {
+    number[0] = '\t';
+    coco_format_exponential(number + 1, value, 0, precision, 0);
+    fputs(number, file);
+  }
+}
+
+/**
+ * @brief Continues a line of a data file with the integer value preceded by a tab (like "\t%d").
+ */
+static void logger_biobj_output_int(FILE *file, logger_binary_layout_t *layout, const int value) {
+  char number[COCO_FORMAT_MAX_LENGTH + 1];
+
+  if (layout != NULL) {
+    logger_binary_record_add(layout, value);
+  } else {
+    number[0] = '\t';
+    coco_format_int(number + 1, value);
+    fputs(number, file);
+  }
+}
+
+/**
+ * @brief Ends a line of a data file (in the text format with the given terminator).
+ */
+static void logger_biobj_output_end_of_line(FILE *file, logger_binary_layout_t *layout, const char *terminator) {
+  if (layout != NULL)
+    logger_binary_record_write(file, layout);
+  else
+    fputs(terminator, file);
+}
+
+/**
+ * @brief Allocates the binary layout of the lines of a data file (.adat or .mdat).
+ *
+ * Each line contains the evaluation number, the objective values, the constraint values and the decision
+ * values (if log_vars is 1).
+ */
+static logger_binary_layout_t *logger_biobj_layout(const logger_biobj_data_t *logger,
+                                                   const size_t number_of_constraints, const int log_vars) {
+  logger_binary_layout_t *layout;
+  size_t i, column = 0;
+  size_t number_of_columns = 1 + logger->number_of_objectives + number_of_constraints;
+
+  if (log_vars)
+    number_of_columns += logger->number_of_variables;
+  layout = logger_binary_layout_allocate(0, number_of_columns, "\t\n");
+  logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_COUNTER, 0, 0, 0, '\0');
+  for (i = 0; i < logger->number_of_objectives + number_of_constraints; i++)
+    logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_EXPONENTIAL, 0, logger->precision_f, 0, '\t');
+  if (log_vars) {
+    for (i = 0; i < logger->number_of_variables; i++) {
+      if ((i < logger->number_of_integer_variables) && (logger->log_discrete_as_int))
+        logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_INT, 0, 0, 0, '\t');
+      else
+        logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_EXPONENTIAL, 0, logger->precision_x, 0, '\t');
+    }
+  }
+  return layout;
+}
+
+/**
+ * @brief Allocates the binary layout of the lines of the indicator files with the evaluation number and
+ * number_of_values indicator values (two for the .dat files and one for the .tdat and .rdat files).
+ */
+static logger_binary_layout_t *logger_biobj_indicator_layout(const logger_biobj_data_t *logger,
+                                                             const size_t number_of_values) {
+  logger_binary_layout_t *layout = logger_binary_layout_allocate(0, 1 + number_of_values, "\n");
+  size_t i;
+
+  logger_binary_layout_set_column(layout, 0, LOGGER_BINARY_COUNTER, 0, 0, 0, '\0');
+  for (i = 1; i <= number_of_values; i++)
+    logger_binary_layout_set_column(layout, i, LOGGER_BINARY_EXPONENTIAL, 0, logger->precision_f, 0, '\t');
+  return layout;
+}
+
 /**
  * @brief Outputs the AVL tree to the given file. Returns the number of nodes in the tree.
  */
-static size_t logger_biobj_tree_output(FILE *file, const avl_tree_t *tree, const size_t dim, const size_t num_int_vars,
-                                       const size_t num_obj, const int log_vars, const int precision_x,
-                                       const int precision_f, const int log_discrete_as_int) {
+static size_t logger_biobj_tree_output(FILE *file, logger_binary_layout_t *layout, const avl_tree_t *tree,
+                                       const size_t dim, const size_t num_int_vars, const size_t num_obj,
+                                       const int log_vars, const int precision_x, const int precision_f,
+                                       const int log_discrete_as_int) {
 
   avl_node_t *solution;
   size_t i;
@@ -275,17 +376,18 @@ static size_t logger_biobj_tree_output(FILE *file, const avl_tree_t *tree, const
     /* There is at least a solution in the tree to output */
     solution = tree->head;
     while (solution != NULL) {
-      fprintf(file, "%lu\t", (unsigned long)((logger_biobj_avl_item_t *)solution->item)->evaluation_number);
+      logger_biobj_output_evaluation(file, layout, ((logger_biobj_avl_item_t *)solution->item)->evaluation_number);
       for (j = 0; j < num_obj; j++)
-        fprintf(file, "%.*e\t", precision_f, ((logger_biobj_avl_item_t *)solution->item)->y[j]);
+        logger_biobj_output_value(file, layout, ((logger_biobj_avl_item_t *)solution->item)->y[j], precision_f);
       if (log_vars) {
         for (i = 0; i < dim; i++)
           if ((i < num_int_vars) && (log_discrete_as_int))
-            fprintf(file, "%d\t", coco_double_to_int(((logger_biobj_avl_item_t *)solution->item)->x[i]));
+            logger_biobj_output_int(file, layout,
+                                    coco_double_to_int(((logger_biobj_avl_item_t *)solution->item)->x[i]));
           else
-            fprintf(file, "%.*e\t", precision_x, ((logger_biobj_avl_item_t *)solution->item)->x[i]);
+            logger_biobj_output_value(file, layout, ((logger_biobj_avl_item_t *)solution->item)->x[i], precision_x);
       }
-      fprintf(file, "\n");
+      logger_biobj_output_end_of_line(file, layout, "\t\n");
       solution = solution->next;
       number_of_nodes++;
     }
@@ -295,154 +397,78 @@ static size_t logger_biobj_tree_output(FILE *file, const avl_tree_t *tree, const
 }
 
 /**
- * @brief Updates the archive and buffer trees with the given node.
+ * @brief Removes the given solution, which is dominated by a new solution, from the buffer tree and the
+ * indicator values and frees it (called by mo_front_update()).
+ */
+static void logger_biobj_remove_dominated(logger_biobj_avl_item_t *item, logger_biobj_data_t *logger) {
+  size_t i;
+
+  if (logger->compute_indicators) {
+    for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
+      logger->indicators[i]->current_value -= item->indicator_contribution[i];
+    }
+  }
+  avl_item_delete(logger->buffer_tree, item);
+  logger_biobj_node_free(item, NULL);
+}
+
+/**
+ * @brief Updates the archive front and buffer tree with the given node.
  *
- * Checks for domination and updates the archive tree and the values of the indicators if the given node is
- * not weakly dominated by existing nodes in the archive tree. This is where the main computation of
- * indicator values takes place.
+ * Checks for domination and updates the archive front and the values of the indicators if the given node is
+ * not weakly dominated by existing nodes in the archive front. This is where the main computation of
+ * indicator values takes place. Only the hypervolume indicator is implemented (see logger_biobj_indicator()).
  *
  * @return 1 if the update was performed and 0 otherwise.
  */
 static int logger_biobj_tree_update(logger_biobj_data_t *logger, logger_biobj_avl_item_t *node_item) {
 
-  avl_node_t *node, *next_node, *new_node;
-  int trigger_update = 0;
-  int dominance;
+  logger_biobj_avl_item_t *next_item, *previous_item;
+  void *next, *previous;
   size_t i;
-  int previous_unavailable = 0;
 
   /* If the node contains an infeasible solution, exit immediately (do not update the tree) */
   if (node_item->is_feasible == 0)
     return 0;
 
-  /* Find the first point that is not worse than the new point (NULL if such point does not exist) */
-  node = avl_item_search_right(logger->archive_tree, node_item, NULL);
-
-  if (node == NULL) {
-    /* The new point is an extreme point */
-    trigger_update = 1;
-    next_node = logger->archive_tree->head;
-  } else {
-    dominance = mo_get_dominance(node_item->normalized_y, ((logger_biobj_avl_item_t *)node->item)->normalized_y,
-                                 logger->number_of_objectives);
-    if (dominance > -1) {
-      trigger_update = 1;
-      next_node = node->next;
-      if (dominance == 1) {
-        /* The new point dominates the next point, remove the next point */
-        if (logger->compute_indicators) {
-          for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-            logger->indicators[i]->current_value -= ((logger_biobj_avl_item_t *)node->item)->indicator_contribution[i];
-          }
-        }
-        avl_item_delete(logger->buffer_tree, node->item);
-        avl_node_delete(logger->archive_tree, node);
-      }
-    } else {
-      /* The new point is dominated or equal to an existing one, nothing more to do */
-      trigger_update = 0;
-    }
-  }
-
-  if (!trigger_update) {
+  assert(logger->number_of_objectives == 2);
+  if (!mo_front_update(logger->archive_front, node_item->normalized_y, node_item,
+                       (mo_front_remove_t)logger_biobj_remove_dominated, logger, &previous, &next)) {
+    /* The new point is dominated or equal to an existing one, nothing more to do */
     logger_biobj_node_free(node_item, NULL);
-  } else {
-    /* Perform tree update */
-    while (next_node != NULL) {
-      /* Check the dominance relation between the new node and the next node. There are only two possibilities:
-       * dominance = 0: the new node and the next node are nondominated
-       * dominance = 1: the new node dominates the next node */
-      node = next_node;
-      dominance = mo_get_dominance(node_item->normalized_y, ((logger_biobj_avl_item_t *)node->item)->normalized_y,
-                                   logger->number_of_objectives);
-      if (dominance == 1) {
-        /* The new point dominates the next point, remove the next point */
-        if (logger->compute_indicators) {
-          for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-            logger->indicators[i]->current_value -= ((logger_biobj_avl_item_t *)node->item)->indicator_contribution[i];
-          }
-        }
-        next_node = node->next;
-        avl_item_delete(logger->buffer_tree, node->item);
-        avl_node_delete(logger->archive_tree, node);
-      } else {
-        break;
+    return 0;
+  }
+  avl_item_insert(logger->buffer_tree, node_item);
+
+  if (logger->compute_indicators && node_item->within_ROI) {
+    /* Compute indicator value for new node and update the indicator value of the affected nodes */
+    next_item = (logger_biobj_avl_item_t *)next;
+    previous_item = (logger_biobj_avl_item_t *)previous;
+
+    if ((next_item != NULL) && next_item->within_ROI) {
+      for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
+        logger->indicators[i]->current_value -= next_item->indicator_contribution[i];
+        next_item->indicator_contribution[i] =
+            (node_item->normalized_y[0] - next_item->normalized_y[0]) * (1 - next_item->normalized_y[1]);
+        assert(next_item->indicator_contribution[i] >= 0);
+        logger->indicators[i]->current_value += next_item->indicator_contribution[i];
       }
     }
 
-    new_node = avl_item_insert(logger->archive_tree, node_item);
-    assert(new_node != NULL);
-    avl_item_insert(logger->buffer_tree, node_item);
-
-    if (logger->compute_indicators) {
-      if (node_item->within_ROI) {
-        /* Compute indicator value for new node and update the indicator value of the affected nodes */
-        logger_biobj_avl_item_t *next_item, *previous_item;
-
-        if (new_node->next != NULL) {
-          next_item = (logger_biobj_avl_item_t *)new_node->next->item;
-          if (next_item->within_ROI) {
-            for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-              logger->indicators[i]->current_value -= next_item->indicator_contribution[i];
-              if (strcmp(logger->indicators[i]->name, "hyp") == 0) {
-                next_item->indicator_contribution[i] =
-                    (node_item->normalized_y[0] - next_item->normalized_y[0]) * (1 - next_item->normalized_y[1]);
-                assert(next_item->indicator_contribution[i] >= 0);
-              } else {
-                coco_error("logger_biobj_tree_update(): Indicator computation not implemented yet for indicator %s",
-                           logger->indicators[i]->name);
-              }
-              logger->indicators[i]->current_value += next_item->indicator_contribution[i];
-            }
-          }
-        }
-
-        previous_unavailable = 0;
-        if (new_node->prev != NULL) {
-          previous_item = (logger_biobj_avl_item_t *)new_node->prev->item;
-          if (previous_item->within_ROI) {
-            for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-              if (strcmp(logger->indicators[i]->name, "hyp") == 0) {
-                node_item->indicator_contribution[i] =
-                    (previous_item->normalized_y[0] - node_item->normalized_y[0]) * (1 - node_item->normalized_y[1]);
-                assert(node_item->indicator_contribution[i] >= 0);
-              } else {
-                coco_error("logger_biobj_tree_update(): Indicator computation not implemented yet for indicator %s",
-                           logger->indicators[i]->name);
-              }
-            }
-          } else {
-            previous_unavailable = 1;
-          }
-        } else {
-          previous_unavailable = 1;
-        }
-
-        if (previous_unavailable) {
-          /* Previous item does not exist or is out of ROI, use reference point instead */
-          for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-            if (strcmp(logger->indicators[i]->name, "hyp") == 0) {
-              node_item->indicator_contribution[i] =
-                  (1 - node_item->normalized_y[0]) * (1 - node_item->normalized_y[1]);
-              assert(node_item->indicator_contribution[i] >= 0);
-            } else {
-              coco_error("logger_biobj_tree_update(): Indicator computation not implemented yet for indicator %s",
-                         logger->indicators[i]->name);
-            }
-          }
-        }
-
-        for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-          if (strcmp(logger->indicators[i]->name, "hyp") == 0) {
-            assert(node_item->indicator_contribution[i] >= 0);
-            logger->indicators[i]->current_value += node_item->indicator_contribution[i];
-          }
-        }
+    for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
+      if ((previous_item != NULL) && previous_item->within_ROI) {
+        node_item->indicator_contribution[i] =
+            (previous_item->normalized_y[0] - node_item->normalized_y[0]) * (1 - node_item->normalized_y[1]);
+      } else {
+        /* Previous item does not exist or is out of ROI, use reference point instead */
+        node_item->indicator_contribution[i] = (1 - node_item->normalized_y[0]) * (1 - node_item->normalized_y[1]);
       }
+      assert(node_item->indicator_contribution[i] >= 0);
+      logger->indicators[i]->current_value += node_item->indicator_contribution[i];
     }
   }
 
-  return trigger_update;
+  return 1;
 }
 
 /**
@@ -468,9 +494,13 @@ static void logger_biobj_indicator_initialize_file(const logger_biobj_data_t *lo
   coco_join_path(path_name, COCO_PATH_MAX, problem->problem_type, NULL);
   coco_create_directory(path_name);
   prefix = coco_remove_from_string(problem->problem_id, "_i", "_d");
-  file_name = coco_strdupf("%s_%s.%s", prefix, indicator->name, file_ending);
+  file_name = coco_strdupf("%s_%s.%s%s", prefix, indicator->name, file_ending,
+                           logger->binary_format ? LOGGER_BINARY_FILE_EXTENSION : "");
   coco_join_path(path_name, COCO_PATH_MAX, file_name, NULL);
-  *f = fopen(path_name, "a");
+  if (logger->binary_format)
+    *f = logger_binary_open_file(path_name);
+  else
+    *f = fopen(path_name, "a");
   if (*f == NULL) {
     coco_error("logger_biobj_indicator_initialize_file() failed to open file '%s'.", path_name);
   }
@@ -479,12 +509,11 @@ static void logger_biobj_indicator_initialize_file(const logger_biobj_data_t *lo
   coco_free_memory(path_name);
 
   /* Output header */
-  if (output_targets)
-    fprintf(*f, header_w_targets, (unsigned long)problem->suite_dep_index, problem->problem_name,
-            (unsigned long)problem->suite_dep_instance, logger->precision_f, indicator->best_value);
-  else
-    fprintf(*f, header_wo_targets, (unsigned long)problem->suite_dep_index, problem->problem_name,
-            (unsigned long)problem->suite_dep_instance, logger->precision_f, indicator->best_value);
+  logger_binary_output_text(*f, logger->binary_format, output_targets ? header_w_targets : header_wo_targets,
+                            (unsigned long)problem->suite_dep_index, problem->problem_name,
+                            (unsigned long)problem->suite_dep_instance, logger->precision_f, indicator->best_value);
+  if (logger->binary_format)
+    logger_binary_write_layout(*f, output_targets ? logger->dat_layout : logger->tdat_layout);
 }
 
 /**
@@ -504,6 +533,13 @@ static logger_biobj_indicator_t *logger_biobj_indicator(const logger_biobj_data_
 
   coco_debug("Started logger_biobj_indicator()");
 
+  /* Only the hypervolume contributions are computed in logger_biobj_tree_update() */
+  if (strcmp(indicator_name, "hyp") != 0) {
+    coco_error("logger_biobj_indicator(): Indicator computation not implemented yet for indicator %s",
+               indicator_name);
+    return NULL; /* Never reached */
+  }
+
   indicator = (logger_biobj_indicator_t *)coco_allocate_memory(sizeof(*indicator));
   assert(observer);
   assert(observer->data);
@@ -579,14 +615,18 @@ static void logger_biobj_indicator_finalize(logger_biobj_indicator_t *indicator,
 
   /* Log the last eval_number in the dat file if wasn't already logged */
   if (!indicator->target_hit) {
-    fprintf(indicator->dat_file, "%lu\t%.*e\t%.*e\n", (unsigned long)logger->num_func_evaluations, logger->precision_f,
-            indicator->overall_value, logger->precision_f, coco_observer_targets_get_last_target(indicator->targets));
+    logger_biobj_output_evaluation(indicator->dat_file, logger->dat_layout, logger->num_func_evaluations);
+    logger_biobj_output_value(indicator->dat_file, logger->dat_layout, indicator->overall_value, logger->precision_f);
+    logger_biobj_output_value(indicator->dat_file, logger->dat_layout,
+                              coco_observer_targets_get_last_target(indicator->targets), logger->precision_f);
+    logger_biobj_output_end_of_line(indicator->dat_file, logger->dat_layout, "\n");
   }
 
   /* Log the last eval_number in the tdat file if wasn't already logged */
   if (!indicator->evaluation_logged) {
-    fprintf(indicator->tdat_file, "%lu\t%.*e\n", (unsigned long)logger->num_func_evaluations, logger->precision_f,
-            indicator->overall_value);
+    logger_biobj_output_evaluation(indicator->tdat_file, logger->tdat_layout, logger->num_func_evaluations);
+    logger_biobj_output_value(indicator->tdat_file, logger->tdat_layout, indicator->overall_value, logger->precision_f);
+    logger_biobj_output_end_of_line(indicator->tdat_file, logger->tdat_layout, "\n");
   }
 
   /* Log the information in the info file */
@@ -703,9 +743,12 @@ static void logger_biobj_output(logger_biobj_data_t *logger, const int update_pe
 
       /* Log to the dat file if a performance target was hit */
       if (indicator->target_hit) {
-        fprintf(indicator->dat_file, "%lu\t%.*e\t%.*e\n", (unsigned long)logger->num_func_evaluations,
-                logger->precision_f, indicator->overall_value, logger->precision_f,
-                coco_observer_targets_get_last_target(indicator->targets));
+        logger_biobj_output_evaluation(indicator->dat_file, logger->dat_layout, logger->num_func_evaluations);
+        logger_biobj_output_value(indicator->dat_file, logger->dat_layout, indicator->overall_value,
+                                  logger->precision_f);
+        logger_biobj_output_value(indicator->dat_file, logger->dat_layout,
+                                  coco_observer_targets_get_last_target(indicator->targets), logger->precision_f);
+        logger_biobj_output_end_of_line(indicator->dat_file, logger->dat_layout, "\n");
       }
 
       if (logger->log_nondom_mode == LOG_NONDOM_READ) {
@@ -714,8 +757,10 @@ static void logger_biobj_output(logger_biobj_data_t *logger, const int update_pe
         for (j = logger->previous_evaluations + 1; j < logger->num_func_evaluations; j++) {
           indicator->evaluation_logged = coco_observer_evaluations_trigger(indicator->evaluations, j);
           if (indicator->evaluation_logged) {
-            fprintf(indicator->tdat_file, "%lu\t%.*e\n", (unsigned long)j, logger->precision_f,
-                    indicator->previous_value);
+            logger_biobj_output_evaluation(indicator->tdat_file, logger->tdat_layout, j);
+            logger_biobj_output_value(indicator->tdat_file, logger->tdat_layout, indicator->previous_value,
+                                      logger->precision_f);
+            logger_biobj_output_end_of_line(indicator->tdat_file, logger->tdat_layout, "\n");
           }
         }
       }
@@ -724,14 +769,18 @@ static void logger_biobj_output(logger_biobj_data_t *logger, const int update_pe
       indicator->evaluation_logged =
           coco_observer_evaluations_trigger(indicator->evaluations, logger->num_func_evaluations);
       if (indicator->evaluation_logged) {
-        fprintf(indicator->tdat_file, "%lu\t%.*e\n", (unsigned long)logger->num_func_evaluations, logger->precision_f,
-                indicator->overall_value);
+        logger_biobj_output_evaluation(indicator->tdat_file, logger->tdat_layout, logger->num_func_evaluations);
+        logger_biobj_output_value(indicator->tdat_file, logger->tdat_layout, indicator->overall_value,
+                                  logger->precision_f);
+        logger_biobj_output_end_of_line(indicator->tdat_file, logger->tdat_layout, "\n");
       }
 
       /* Log to the rdat file if the algorithm was restarted */
       if (logger->algorithm_restarted) {
-        fprintf(indicator->rdat_file, "%lu\t%.*e\n", (unsigned long)logger->num_func_evaluations, logger->precision_f,
-                indicator->overall_value);
+        logger_biobj_output_evaluation(indicator->rdat_file, logger->tdat_layout, logger->num_func_evaluations);
+        logger_biobj_output_value(indicator->rdat_file, logger->tdat_layout, indicator->overall_value,
+                                  logger->precision_f);
+        logger_biobj_output_end_of_line(indicator->rdat_file, logger->tdat_layout, "\n");
       }
     }
   }
@@ -763,8 +812,8 @@ static void logger_biobj_evaluate(coco_problem_t *problem, const double *x, doub
 
   /* Evaluate the constraints */
   if (problem->number_of_constraints > 0) {
-    constraints = coco_allocate_vector(problem->number_of_constraints);
-    inner_problem->evaluate_constraint(inner_problem, x, constraints, 0);
+    constraints = problem->scratch;
+    coco_evaluate_constraint_memoized(inner_problem, x, constraints, 0);
   }
   logger->num_cons_evaluations = problem->evaluations_constraints;
 
@@ -779,7 +828,7 @@ static void logger_biobj_evaluate(coco_problem_t *problem, const double *x, doub
   /* If the archive was updated and you need to log all nondominated solutions, output the new solution to
    * nondom_file */
   if (update_performed && (logger->log_nondom_mode == LOG_NONDOM_ALL)) {
-    logger_biobj_tree_output(logger->adat_file, logger->buffer_tree, logger->number_of_variables,
+    logger_biobj_tree_output(logger->adat_file, logger->adat_layout, logger->buffer_tree, logger->number_of_variables,
                              logger->number_of_integer_variables, logger->number_of_objectives, logger->log_vars,
                              logger->precision_x, logger->precision_f, logger->log_discrete_as_int);
     avl_tree_purge(logger->buffer_tree);
@@ -790,10 +839,6 @@ static void logger_biobj_evaluate(coco_problem_t *problem, const double *x, doub
 
   /* Output according to observer options */
   logger_biobj_output(logger, update_performed, node_item);
-
-  /* Free allocated memory */
-  if (problem->number_of_constraints > 0)
-    coco_free_memory(constraints);
 }
 
 /**
@@ -820,7 +865,7 @@ static void logger_biobj_recommend(coco_problem_t *problem, const double *x) {
   /* Evaluate the constraints */
   if (problem->number_of_constraints > 0) {
     constraints = coco_allocate_vector(problem->number_of_constraints);
-    inner_problem->evaluate_constraint(inner_problem, x, constraints, 0);
+    coco_evaluate_constraint_memoized(inner_problem, x, constraints, 0);
   }
   logger->num_cons_evaluations = problem->evaluations_constraints;
 
@@ -833,19 +878,19 @@ static void logger_biobj_recommend(coco_problem_t *problem, const double *x) {
   }
 
   /* Log to the mdat file */
-  fprintf(logger->mdat_file, "%lu\t", (unsigned long)logger->num_func_evaluations);
+  logger_biobj_output_evaluation(logger->mdat_file, logger->mdat_layout, logger->num_func_evaluations);
   for (j = 0; j < problem->number_of_objectives; j++)
-    fprintf(logger->mdat_file, "%.*e\t", logger->precision_f, y[j]);
+    logger_biobj_output_value(logger->mdat_file, logger->mdat_layout, y[j], logger->precision_f);
   for (j = 0; j < problem->number_of_constraints; j++)
-    fprintf(logger->mdat_file, "%.*e\t", logger->precision_f, constraints[j]);
+    logger_biobj_output_value(logger->mdat_file, logger->mdat_layout, constraints[j], logger->precision_f);
   if (logger->log_vars) {
     for (i = 0; i < logger->number_of_variables; i++)
       if ((i < logger->number_of_integer_variables) && (logger->log_discrete_as_int))
-        fprintf(logger->mdat_file, "%d\t", coco_double_to_int(x[i]));
+        logger_biobj_output_int(logger->mdat_file, logger->mdat_layout, coco_double_to_int(x[i]));
       else
-        fprintf(logger->mdat_file, "%.*e\t", logger->precision_x, x[i]);
+        logger_biobj_output_value(logger->mdat_file, logger->mdat_layout, x[i], logger->precision_x);
   }
-  fprintf(logger->mdat_file, "\n");
+  logger_biobj_output_end_of_line(logger->mdat_file, logger->mdat_layout, "\t\n");
 
   /* Free allocated memory */
   coco_free_memory(y);
@@ -912,23 +957,20 @@ int coco_logger_biobj_feed_solution(coco_problem_t *problem, const size_t evalua
 static void logger_biobj_finalize(logger_biobj_data_t *logger) {
 
   avl_tree_t *resorted_tree;
-  avl_node_t *solution;
+  mo_front_position_t position;
+  void *solution;
 
   coco_debug("Started logger_biobj_finalize()");
 
-  /* Re-sort archive_tree according to time stamp and then output it */
+  /* Re-sort archive_front according to time stamp and then output it */
   resorted_tree = avl_tree_construct((avl_compare_t)avl_tree_compare_by_eval_number, NULL);
+  avl_tree_set_allocator(resorted_tree, &logger->node_pool->allocator);
 
-  if (logger->archive_tree->tail) {
-    /* There is at least a solution in the tree to output */
-    solution = logger->archive_tree->head;
-    while (solution != NULL) {
-      avl_item_insert(resorted_tree, solution->item);
-      solution = solution->next;
-    }
-  }
+  for (solution = mo_front_get_first(logger->archive_front, &position); solution != NULL;
+       solution = mo_front_get_next(logger->archive_front, &position))
+    avl_item_insert(resorted_tree, solution);
 
-  logger_biobj_tree_output(logger->adat_file, resorted_tree, logger->number_of_variables,
+  logger_biobj_tree_output(logger->adat_file, logger->adat_layout, resorted_tree, logger->number_of_variables,
                            logger->number_of_integer_variables, logger->number_of_objectives, logger->log_vars,
                            logger->precision_x, logger->precision_f, logger->log_discrete_as_int);
 
@@ -964,7 +1006,8 @@ static void logger_biobj_free(void *stuff) {
 
   if (((logger->log_nondom_mode == LOG_NONDOM_ALL) || (logger->log_nondom_mode == LOG_NONDOM_FINAL)) &&
       (logger->adat_file != NULL)) {
-    fprintf(logger->adat_file, "%% evaluations = %lu\n", (unsigned long)logger->num_func_evaluations);
+    logger_binary_output_text(logger->adat_file, logger->binary_format, "%% evaluations = %lu\n",
+                              (unsigned long)logger->num_func_evaluations);
     fclose(logger->adat_file);
     logger->adat_file = NULL;
   }
@@ -974,8 +1017,14 @@ static void logger_biobj_free(void *stuff) {
     logger->mdat_file = NULL;
   }
 
-  avl_tree_destruct(logger->archive_tree);
   avl_tree_destruct(logger->buffer_tree);
+  mo_front_free(logger->archive_front, (mo_front_remove_t)logger_biobj_node_free, NULL);
+  avl_node_pool_destruct(logger->node_pool);
+
+  logger_binary_layout_free(logger->adat_layout);
+  logger_binary_layout_free(logger->mdat_layout);
+  logger_binary_layout_free(logger->dat_layout);
+  logger_binary_layout_free(logger->tdat_layout);
 
   observer = logger->observer;
   if ((observer != NULL) && (observer->is_active == 1)) {
@@ -1067,6 +1116,19 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *i
   else
     logger_data->log_vars = 1;
 
+  logger_data->binary_format = observer->binary_format;
+  logger_data->adat_layout = NULL;
+  logger_data->mdat_layout = NULL;
+  logger_data->dat_layout = NULL;
+  logger_data->tdat_layout = NULL;
+  if (logger_data->binary_format) {
+    logger_data->adat_layout = logger_biobj_layout(logger_data, 0, logger_data->log_vars);
+    logger_data->mdat_layout = logger_biobj_layout(logger_data, inner_problem->number_of_constraints,
+                                                   logger_data->log_vars);
+    logger_data->dat_layout = logger_biobj_indicator_layout(logger_data, 2);
+    logger_data->tdat_layout = logger_biobj_indicator_layout(logger_data, 1);
+  }
+
   /* Initialize logging of nondominated solutions into the archive file */
   if ((logger_data->log_nondom_mode == LOG_NONDOM_ALL) || (logger_data->log_nondom_mode == LOG_NONDOM_FINAL)) {
 
@@ -1078,14 +1140,19 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *i
 
     /* Construct file name */
     if (logger_data->log_nondom_mode == LOG_NONDOM_ALL)
-      file_name = coco_strdupf("%s_nondom_all.adat", inner_problem->problem_id);
+      file_name = coco_strdupf("%s_nondom_all.adat%s", inner_problem->problem_id,
+                               logger_data->binary_format ? LOGGER_BINARY_FILE_EXTENSION : "");
     else if (logger_data->log_nondom_mode == LOG_NONDOM_FINAL)
-      file_name = coco_strdupf("%s_nondom_final.adat", inner_problem->problem_id);
+      file_name = coco_strdupf("%s_nondom_final.adat%s", inner_problem->problem_id,
+                               logger_data->binary_format ? LOGGER_BINARY_FILE_EXTENSION : "");
     coco_join_path(path_name, COCO_PATH_MAX, file_name, NULL);
     coco_free_memory(file_name);
 
     /* Open and initialize the archive file */
-    logger_data->adat_file = fopen(path_name, "a");
+    if (logger_data->binary_format)
+      logger_data->adat_file = logger_binary_open_file(path_name);
+    else
+      logger_data->adat_file = fopen(path_name, "a");
     if (logger_data->adat_file == NULL) {
       coco_error("logger_biobj() failed to open file '%s'.", path_name);
       return NULL; /* Never reached */
@@ -1093,21 +1160,27 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *i
     coco_free_memory(path_name);
 
     /* Output header information */
-    fprintf(logger_data->adat_file, "%% instance = %lu, name = %s\n", (unsigned long)inner_problem->suite_dep_instance,
-            inner_problem->problem_name);
+    logger_binary_output_text(logger_data->adat_file, logger_data->binary_format, "%% instance = %lu, name = %s\n",
+                              (unsigned long)inner_problem->suite_dep_instance, inner_problem->problem_name);
     if (logger_data->log_vars) {
-      fprintf(logger_data->adat_file, "%% function evaluation | %lu objectives | %lu variables\n",
-              (unsigned long)inner_problem->number_of_objectives, (unsigned long)inner_problem->number_of_variables);
+      logger_binary_output_text(logger_data->adat_file, logger_data->binary_format,
+                                "%% function evaluation | %lu objectives | %lu variables\n",
+                                (unsigned long)inner_problem->number_of_objectives,
+                                (unsigned long)inner_problem->number_of_variables);
     } else {
-      fprintf(logger_data->adat_file, "%% function evaluation | %lu objectives \n",
-              (unsigned long)inner_problem->number_of_objectives);
+      logger_binary_output_text(logger_data->adat_file, logger_data->binary_format,
+                                "%% function evaluation | %lu objectives \n",
+                                (unsigned long)inner_problem->number_of_objectives);
     }
+    if (logger_data->binary_format)
+      logger_binary_write_layout(logger_data->adat_file, logger_data->adat_layout);
   }
 
-  /* Initialize the AVL trees */
-  logger_data->archive_tree =
-      avl_tree_construct((avl_compare_t)avl_tree_compare_by_last_objective, (avl_free_t)logger_biobj_node_free);
+  /* Initialize the archive front and the AVL tree */
+  logger_data->archive_front = mo_front_allocate();
   logger_data->buffer_tree = avl_tree_construct((avl_compare_t)avl_tree_compare_by_eval_number, NULL);
+  logger_data->node_pool = avl_node_pool_construct();
+  avl_tree_set_allocator(logger_data->buffer_tree, &logger_data->node_pool->allocator);
 
   /* Initialize the indicators */
   if (logger_data->compute_indicators) {
@@ -1133,13 +1206,16 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *i
 
   /* Construct file name */
   prefix = coco_remove_from_string(problem->problem_id, "_i", "_d");
-  file_name = coco_strdupf("%s.mdat", prefix);
+  file_name = coco_strdupf("%s.mdat%s", prefix, logger_data->binary_format ? LOGGER_BINARY_FILE_EXTENSION : "");
   coco_join_path(path_name, COCO_PATH_MAX, file_name, NULL);
   coco_free_memory(file_name);
   coco_free_memory(prefix);
 
   /* Open and initialize the recommendation file */
-  logger_data->mdat_file = fopen(path_name, "a");
+  if (logger_data->binary_format)
+    logger_data->mdat_file = logger_binary_open_file(path_name);
+  else
+    logger_data->mdat_file = fopen(path_name, "a");
   if (logger_data->mdat_file == NULL) {
     coco_error("logger_biobj() failed to open file '%s'.", path_name);
     return NULL; /* Never reached */
@@ -1147,14 +1223,19 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *i
   coco_free_memory(path_name);
 
   /* Output header information */
-  fprintf(logger_data->mdat_file, "%% instance = %lu, name = %s\n%% function evaluation | %lu objectives",
-          (unsigned long)inner_problem->suite_dep_instance, inner_problem->problem_name,
-          (unsigned long)inner_problem->number_of_objectives);
+  logger_binary_output_text(logger_data->mdat_file, logger_data->binary_format,
+                            "%% instance = %lu, name = %s\n%% function evaluation | %lu objectives",
+                            (unsigned long)inner_problem->suite_dep_instance, inner_problem->problem_name,
+                            (unsigned long)inner_problem->number_of_objectives);
   if (inner_problem->number_of_constraints > 0)
-    fprintf(logger_data->mdat_file, " | %lu constraints", (unsigned long)inner_problem->number_of_constraints);
+    logger_binary_output_text(logger_data->mdat_file, logger_data->binary_format, " | %lu constraints",
+                              (unsigned long)inner_problem->number_of_constraints);
   if (logger_data->log_vars)
-    fprintf(logger_data->mdat_file, " | %lu variables", (unsigned long)inner_problem->number_of_variables);
-  fprintf(logger_data->mdat_file, "\n");
+    logger_binary_output_text(logger_data->mdat_file, logger_data->binary_format, " | %lu variables",
+                              (unsigned long)inner_problem->number_of_variables);
+  logger_binary_output_text(logger_data->mdat_file, logger_data->binary_format, "\n");
+  if (logger_data->binary_format)
+    logger_binary_write_layout(logger_data->mdat_file, logger_data->mdat_layout);
 
   coco_debug("Ended   logger_biobj()");
 
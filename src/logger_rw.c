@@ -9,6 +9,9 @@
  *
  * @note This logger can be used with single- and multi-objective problems, but in the multi-objective
  * case, all solutions are always logged.
+ *
+ * With the observer option "format: binary", the "txt" files are written in the binary format described
+ * in logger_binary.c.
  */
 
 #include <stdio.h>
@@ -22,6 +25,7 @@
 #include "coco_problem.c"
 #include "coco_string.c"
 #include "observer_rw.c"
+#include "logger_binary.c"
 
 /**
  * @brief The rw logger data type.
@@ -47,6 +51,11 @@ typedef struct {
   int precision_f;         /**< @brief Precision for outputting objective values. */
   int precision_g;         /**< @brief Precision for outputting constraint values. */
   int log_discrete_as_int; /**< @brief Whether to output discrete variables in int or double format. */
+
+  char *line; /**< @brief Buffer in which a line is formatted before it is output. */
+
+  int binary_format;              /**< @brief Whether the output file is written in the binary format. */
+  logger_binary_layout_t *layout; /**< @brief Layout of the lines of the output file (binary format). */
 } logger_rw_data_t;
 
 /**
@@ -58,9 +67,10 @@ static void logger_rw_evaluate(coco_problem_t *problem, const double *x, double
   logger_rw_data_t *logger;
   coco_problem_t *inner_problem;
   double *constraints = NULL;
-  size_t i;
+  size_t i, length = 0;
   int log_this_time = 1;
   time_t start, end;
+  char *line;
 
   logger = (logger_rw_data_t *)coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
@@ -78,8 +88,8 @@ static void logger_rw_evaluate(coco_problem_t *problem, const double *x, double
 
   /* Evaluate the constraints */
   if (problem->number_of_constraints > 0) {
-    constraints = coco_allocate_vector(problem->number_of_constraints);
-    inner_problem->evaluate_constraint(inner_problem, x, constraints, 0);
+    constraints = problem->scratch;
+    coco_evaluate_constraint_memoized(inner_problem, x, constraints, 0);
   }
   logger->num_cons_evaluations = problem->evaluations_constraints;
 
@@ -92,32 +102,61 @@ static void logger_rw_evaluate(coco_problem_t *problem, const double *x, double
     logger->best_value = logger->current_value;
   else if (problem->number_of_objectives == 1)
     log_this_time = !logger->log_only_better;
-  if ((logger->num_func_evaluations == 1) || log_this_time) {
-    fprintf(logger->out_file, "%lu\t", (unsigned long)logger->num_func_evaluations);
-    fprintf(logger->out_file, "%lu\t", (unsigned long)logger->num_cons_evaluations);
+  if (((logger->num_func_evaluations == 1) || log_this_time) && logger->binary_format) {
+    logger_binary_record_start(logger->layout);
+    logger_binary_record_add_counter(logger->layout, logger->num_func_evaluations);
+    logger_binary_record_add_counter(logger->layout, logger->num_cons_evaluations);
     for (i = 0; i < problem->number_of_objectives; i++)
-      fprintf(logger->out_file, "%+.*e\t", logger->precision_f, y[i]);
+      logger_binary_record_add(logger->layout, y[i]);
     if (logger->log_vars) {
       for (i = 0; i < problem->number_of_variables; i++) {
         if ((i < problem->number_of_integer_variables) && (logger->log_discrete_as_int))
-          fprintf(logger->out_file, "%d\t", coco_double_to_int(x[i]));
+          logger_binary_record_add(logger->layout, coco_double_to_int(x[i]));
         else
-          fprintf(logger->out_file, "%+.*e\t", logger->precision_x, x[i]);
+          logger_binary_record_add(logger->layout, x[i]);
       }
     }
     if (logger->log_cons) {
       for (i = 0; i < problem->number_of_constraints; i++)
-        fprintf(logger->out_file, "%+.*e\t", logger->precision_g, constraints[i]);
+        logger_binary_record_add(logger->layout, constraints[i]);
+    }
+    if (logger->log_time)
+      logger_binary_record_add(logger->layout, difftime(end, start));
+    logger_binary_record_write(logger->out_file, logger->layout);
+  } else if ((logger->num_func_evaluations == 1) || log_this_time) {
+    /* The line is formatted in logger->line and output at once */
+    line = logger->line;
+    length += coco_format_unsigned_long(line + length, (unsigned long)logger->num_func_evaluations);
+    line[length++] = '\t';
+    length += coco_format_unsigned_long(line + length, (unsigned long)logger->num_cons_evaluations);
+    line[length++] = '\t';
+    for (i = 0; i < problem->number_of_objectives; i++) {
+      length += coco_format_exponential(line + length, y[i], 0, logger->precision_f, 1);
+      line[length++] = '\t';
+    }
+    if (logger->log_vars) {
+      for (i = 0; i < problem->number_of_variables; i++) {
+        if ((i < problem->number_of_integer_variables) && (logger->log_discrete_as_int))
+          length += coco_format_int(line + length, coco_double_to_int(x[i]));
+        else
+          length += coco_format_exponential(line + length, x[i], 0, logger->precision_x, 1);
+        line[length++] = '\t';
+      }
+    }
+    if (logger->log_cons) {
+      for (i = 0; i < problem->number_of_constraints; i++) {
+        length += coco_format_exponential(line + length, constraints[i], 0, logger->precision_g, 1);
+        line[length++] = '\t';
+      }
     }
     /* Log time in seconds */
     if (logger->log_time)
-      fprintf(logger->out_file, "%.0f\t", difftime(end, start));
-    fprintf(logger->out_file, "\n");
+      length += (size_t)sprintf(line + length, "%.0f\t", difftime(end, start));
+    line[length++] = '\n';
+    line[length] = '\0';
+    fputs(line, logger->out_file);
   }
   fflush(logger->out_file);
-
-  if (problem->number_of_constraints > 0)
-    coco_free_memory(constraints);
 }
 
 /**
@@ -134,6 +173,51 @@ static void logger_rw_free(void *stuff) {
     fclose(logger->out_file);
     logger->out_file = NULL;
   }
+
+  if (logger->line != NULL) {
+    coco_free_memory(logger->line);
+    logger->line = NULL;
+  }
+
+  logger_binary_layout_free(logger->layout);
+  logger->layout = NULL;
+}
+
+/**
+ * @brief Allocates the binary layout of the lines output by logger_rw_evaluate().
+ */
+static logger_binary_layout_t *logger_rw_layout(const logger_rw_data_t *logger, const coco_problem_t *problem) {
+  logger_binary_layout_t *layout;
+  size_t i, column = 0;
+  size_t number_of_columns = 2 + problem->number_of_objectives;
+
+  if (logger->log_vars)
+    number_of_columns += problem->number_of_variables;
+  if (logger->log_cons)
+    number_of_columns += problem->number_of_constraints;
+  if (logger->log_time)
+    number_of_columns++;
+  layout = logger_binary_layout_allocate(0, number_of_columns, "\t\n");
+
+  logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_COUNTER, 0, 0, 0, '\0');
+  logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_COUNTER, 0, 0, 0, '\t');
+  for (i = 0; i < problem->number_of_objectives; i++)
+    logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_EXPONENTIAL, 0, logger->precision_f, 1, '\t');
+  if (logger->log_vars) {
+    for (i = 0; i < problem->number_of_variables; i++) {
+      if ((i < problem->number_of_integer_variables) && (logger->log_discrete_as_int))
+        logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_INT, 0, 0, 0, '\t');
+      else
+        logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_EXPONENTIAL, 0, logger->precision_x, 1, '\t');
+    }
+  }
+  if (logger->log_cons) {
+    for (i = 0; i < problem->number_of_constraints; i++)
+      logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_EXPONENTIAL, 0, logger->precision_g, 1, '\t');
+  }
+  if (logger->log_time)
+    logger_binary_layout_set_column(layout, column++, LOGGER_BINARY_FIXED, 0, 0, 0, '\t');
+  return layout;
 }
 
 /**
@@ -151,6 +235,8 @@ static coco_problem_t *logger_rw(coco_observer_t *observer, coco_problem_t *inne
   logger_rw_data_t *logger_data;
   observer_rw_data_t *observer_data;
   char *path_name, *file_name = NULL;
+  FILE *out_file;
+  int binary_format;
 
   logger_data = (logger_rw_data_t *)coco_allocate_memory(sizeof(*logger_data));
   logger_data->num_func_evaluations = 0;
@@ -183,15 +269,29 @@ static coco_problem_t *logger_rw(coco_observer_t *observer, coco_problem_t *inne
   logger_data->best_value = DBL_MAX;
   logger_data->current_value = DBL_MAX;
 
+  /* Two evaluation counters, the objectives, variables and constraints and the evaluation time */
+  logger_data->line = coco_allocate_string((3 + inner_problem->number_of_objectives +
+                                            inner_problem->number_of_variables +
+                                            inner_problem->number_of_constraints) * COCO_FORMAT_MAX_LENGTH);
+
+  logger_data->binary_format = observer->binary_format;
+  logger_data->layout = NULL;
+  if (logger_data->binary_format)
+    logger_data->layout = logger_rw_layout(logger_data, inner_problem);
+
   /* Construct file name */
   path_name = coco_allocate_string(COCO_PATH_MAX + 1);
   memcpy(path_name, observer->result_folder, strlen(observer->result_folder) + 1);
   coco_create_directory(path_name);
-  file_name = coco_strdupf("%s_rw.txt", coco_problem_get_id(inner_problem));
+  file_name = coco_strdupf("%s_rw.txt%s", coco_problem_get_id(inner_problem),
+                           logger_data->binary_format ? LOGGER_BINARY_FILE_EXTENSION : "");
   coco_join_path(path_name, COCO_PATH_MAX, file_name, NULL);
 
   /* Open and initialize the output file */
-  logger_data->out_file = fopen(path_name, "a");
+  if (logger_data->binary_format)
+    logger_data->out_file = logger_binary_open_file(path_name);
+  else
+    logger_data->out_file = fopen(path_name, "a");
   if (logger_data->out_file == NULL) {
     coco_error("logger_rw() failed to open file '%s'.", path_name);
     return NULL; /* Never reached */
@@ -199,25 +299,32 @@ static coco_problem_t *logger_rw(coco_observer_t *observer, coco_problem_t *inne
   coco_free_memory(path_name);
   coco_free_memory(file_name);
 
-  /* Output header information */
-  fprintf(logger_data->out_file, "\n%% suite = '%s', problem_id = '%s', problem_name = '%s', coco_version = '%s'\n",
-          coco_problem_get_suite(inner_problem)->suite_name, coco_problem_get_id(inner_problem),
-          coco_problem_get_name(inner_problem), coco_version);
-  fprintf(logger_data->out_file, "%% f-evaluations | g-evaluations | %lu objective",
-          (unsigned long)inner_problem->number_of_objectives);
+  /* Output header information (as text or as text blocks of the binary file) */
+  out_file = logger_data->out_file;
+  binary_format = logger_data->binary_format;
+  logger_binary_output_text(out_file, binary_format,
+                            "\n%% suite = '%s', problem_id = '%s', problem_name = '%s', coco_version = '%s'\n",
+                            coco_problem_get_suite(inner_problem)->suite_name, coco_problem_get_id(inner_problem),
+                            coco_problem_get_name(inner_problem), coco_version);
+  logger_binary_output_text(out_file, binary_format, "%% f-evaluations | g-evaluations | %lu objective",
+                            (unsigned long)inner_problem->number_of_objectives);
   if (inner_problem->number_of_objectives > 1)
-    fprintf(logger_data->out_file, "s");
+    logger_binary_output_text(out_file, binary_format, "s");
   if (logger_data->log_vars)
-    fprintf(logger_data->out_file, " | %lu variable", (unsigned long)inner_problem->number_of_variables);
+    logger_binary_output_text(out_file, binary_format, " | %lu variable",
+                              (unsigned long)inner_problem->number_of_variables);
   if (inner_problem->number_of_variables > 1)
-    fprintf(logger_data->out_file, "s");
+    logger_binary_output_text(out_file, binary_format, "s");
   if (logger_data->log_cons)
-    fprintf(logger_data->out_file, " | %lu constraint", (unsigned long)inner_problem->number_of_constraints);
+    logger_binary_output_text(out_file, binary_format, " | %lu constraint",
+                              (unsigned long)inner_problem->number_of_constraints);
   if (inner_problem->number_of_constraints > 1)
-    fprintf(logger_data->out_file, "s");
+    logger_binary_output_text(out_file, binary_format, "s");
   if (logger_data->log_time)
-    fprintf(logger_data->out_file, " | evaluation time (s)");
-  fprintf(logger_data->out_file, "\n");
+    logger_binary_output_text(out_file, binary_format, " | evaluation time (s)");
+  logger_binary_output_text(out_file, binary_format, "\n");
+  if (binary_format)
+    logger_binary_write_layout(out_file, logger_data->layout);
 
   problem = coco_problem_transformed_allocate(inner_problem, logger_data, logger_rw_free, observer->observer_name);
   problem->evaluate_function = logger_rw_evaluate;
@@ -154,12 +154,6 @@ static int avl_check_balance(avl_node_t *avlnode) {
 }
 
 #ifdef AVL_COUNT
-static unsigned long avl_count(const avl_tree_t *avltree) {
-  if (!avltree)
-    return 0;
-  return AVL_NODE_COUNT(avltree->top);
-}
-
 #if (!AVL_TREE_COMMENT_UNUSED)
 static avl_node_t *avl_at(const avl_tree_t *avltree, unsigned long index) {
   avl_node_t *avlnode;
@@ -236,33 +230,6 @@ static const avl_node_t *avl_search_leftmost_equal(const avl_tree_t *tree, const
 }
 #endif
 
-static const avl_node_t *avl_search_rightmost_equal(const avl_tree_t *tree, const avl_node_t *node, const void *item) {
-  avl_compare_t cmp = tree->cmpitem;
-  void *userdata = tree->userdata;
-  const avl_node_t *r = node;
-
-  for (;;) {
-    for (;;) {
-      node = node->right;
-      if (!node)
-        return r;
-      if (cmp(item, node->item, userdata))
-        break;
-      r = node;
-    }
-    for (;;) {
-      node = node->left;
-      if (!node)
-        return r;
-      if (!cmp(item, node->item, userdata))
-        break;
-    }
-    r = node;
-  }
-
-  return NULL; /* To silence the compiler */
-}
-
 /* Searches for an item, returning either some exact
  * match, or (if no exact match could be found) the first (leftmost)
  * of the nodes that have an item larger than the search item.
@@ -380,28 +347,6 @@ static avl_node_t *avl_item_search_left(const avl_tree_t *tree, const void *item
 }
 #endif
 
-/* Searches for an item, returning either the last (rightmost) exact
- * match, or (if no exact match could be found) the last (rightmost)
- * of the nodes that have an item smaller than the search item.
- * If exact is not NULL, *exact will be set to:
- *    0  if the returned node is inequal or NULL
- *    1  if the returned node is equal
- * Returns NULL if no equal or smaller element could be found.
- * O(lg n) */
-static avl_node_t *avl_item_search_right(const avl_tree_t *tree, const void *item, int *exact) {
-  const avl_node_t *node;
-  int c;
-
-  if (!exact)
-    exact = &c;
-
-  node = avl_search_rightish(tree, item, exact);
-  if (*exact)
-    return AVL_CONST_NODE(avl_search_rightmost_equal(tree, node, item));
-
-  return AVL_CONST_NODE(node);
-}
-
 /* Searches for the item in the tree and returns a matching node if found
  * or NULL if not.
  * O(lg n) */
@@ -506,6 +451,102 @@ static void avl_tree_destruct(avl_tree_t *avltree) {
   free(avltree);
 }
 
+/* A pool of nodes that can be shared by several trees (see avl_tree_set_allocator()).
+ * The nodes are allocated in blocks of growing size and the nodes given back to the pool
+ * are kept in a list for reuse, so that inserting and deleting nodes mostly avoids malloc()
+ * and free(). The memory of the nodes is free()d only when the pool is destructed, which
+ * must happen after all the trees that use the pool have been destructed or purged. */
+
+#define AVL_NODE_POOL_MIN_BLOCK_SIZE 64
+#define AVL_NODE_POOL_MAX_BLOCK_SIZE 65536
+
+typedef struct avl_node_pool {
+  avl_allocator_t allocator; /* Needs to be the first member */
+  avl_node_t *blocks;        /* The blocks of nodes, chained through the next pointer of their first node */
+  avl_node_t *unused;        /* The nodes of the last block that have not been used yet */
+  size_t number_of_unused;
+  size_t block_size;         /* The number of nodes of the last block */
+  avl_node_t *free_nodes;    /* The nodes given back to the pool, chained through their next pointer */
+} avl_node_pool_t;
+
+static avl_node_t *avl_node_pool_allocate(avl_allocator_t *allocator) {
+  avl_node_pool_t *pool = (avl_node_pool_t *)allocator;
+  avl_node_t *node, *block;
+  size_t block_size;
+
+  if (pool->free_nodes) {
+    node = pool->free_nodes;
+    pool->free_nodes = node->next;
+    return node;
+  }
+
+  if (pool->number_of_unused == 0) {
+    block_size = pool->block_size * 2;
+    if (block_size < AVL_NODE_POOL_MIN_BLOCK_SIZE)
+      block_size = AVL_NODE_POOL_MIN_BLOCK_SIZE;
+    if (block_size > AVL_NODE_POOL_MAX_BLOCK_SIZE)
+      block_size = AVL_NODE_POOL_MAX_BLOCK_SIZE;
+    /* The first node of the block links the blocks */
+    block = (avl_node_t *)malloc((block_size + 1) * sizeof(avl_node_t));
+    if (!block)
+      return NULL;
+    block->next = pool->blocks;
+    pool->blocks = block;
+    pool->unused = block + 1;
+    pool->number_of_unused = block_size;
+    pool->block_size = block_size;
+  }
+
+  pool->number_of_unused--;
+  return pool->unused++;
+}
+
+static void avl_node_pool_deallocate(avl_allocator_t *allocator, avl_node_t *node) {
+  avl_node_pool_t *pool = (avl_node_pool_t *)allocator;
+  node->next = pool->free_nodes;
+  pool->free_nodes = node;
+}
+
+/* Allocates and initializes a new pool of nodes.
+ * Returns NULL if memory could not be allocated.
+ * O(1) */
+static avl_node_pool_t *avl_node_pool_construct(void) {
+  avl_node_pool_t *pool = (avl_node_pool_t *)malloc(sizeof(avl_node_pool_t));
+  if (pool) {
+    pool->allocator.allocate = avl_node_pool_allocate;
+    pool->allocator.deallocate = avl_node_pool_deallocate;
+    pool->blocks = NULL;
+    pool->unused = NULL;
+    pool->number_of_unused = 0;
+    pool->block_size = 0;
+    pool->free_nodes = NULL;
+  }
+  return pool;
+}
+
+/* Frees the pool together with all its nodes.
+ * O(number of blocks) */
+static void avl_node_pool_destruct(avl_node_pool_t *pool) {
+  avl_node_t *block, *next;
+  if (!pool)
+    return;
+  for (block = pool->blocks; block; block = next) {
+    next = block->next;
+    free(block);
+  }
+  free(pool);
+}
+
+/* Makes the (empty) tree allocate its nodes with the given allocator
+ * (or with malloc() if the allocator is NULL).
+ * Returns the value of avltree (even if it's NULL).
+ * O(1) */
+static avl_tree_t *avl_tree_set_allocator(avl_tree_t *avltree, avl_allocator_t *allocator) {
+  if (avltree)
+    avltree->allocator = allocator;
+  return avltree;
+}
+
 static void avl_node_clear(avl_node_t *newnode) {
   newnode->left = newnode->right = NULL;
 #ifdef AVL_COUNT
@@ -534,7 +575,7 @@ static avl_node_t *avl_alloc(avl_tree_t *avltree, const void *item) {
   avl_allocate_t allocate;
   if (allocator) {
     allocate = allocator->allocate;
-    if (allocator) {
+    if (allocate) {
       newnode = allocate(allocator);
     } else {
       errno = ENOSYS;
@@ -634,12 +675,6 @@ static avl_node_t *avl_node_insert_left(avl_tree_t *avltree, avl_node_t *newnode
 }
 #endif
 
-#if (!AVL_TREE_COMMENT_UNUSED)
-static avl_node_t *avl_node_insert_right(avl_tree_t *avltree, avl_node_t *newnode) {
-  return avl_node_insert_after(avltree, avl_item_search_right(avltree, newnode->item, NULL), newnode);
-}
-#endif
-
 #if (!AVL_TREE_COMMENT_UNUSED)
 static avl_node_t *avl_node_insert_somewhere(avl_tree_t *avltree, avl_node_t *newnode) {
   return avl_node_insert_after(avltree, avl_search_rightish(avltree, newnode->item, NULL), newnode);
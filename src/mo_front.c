@@ -0,0 +1,410 @@
+/**
+ * @file mo_front.c
+ * @brief Implementation of a front of mutually nondominated solutions of a bi-objective problem.
+ *
+ * The solutions of a bi-objective front sorted by the second objective are also sorted (in the reverse
+ * order) by the first objective. The front is therefore kept as a sorted array, which is split into blocks
+ * of at most MO_FRONT_BLOCK_SIZE points, so that inserting and removing points only moves the points of a
+ * single block. Each point stores a copy of the normalized objective values of its solution next to a
+ * pointer to the solution (the item), so that searching the front does not need to access the items.
+ *
+ * A new solution is inserted in three steps: the position of the solution is found by binary searches of
+ * the blocks and of the points of a block, the run of points that are dominated by the new solution (which
+ * always follows this position) is removed and the new solution takes its place. The neighbors of the new
+ * solution, which are needed to update its hypervolume contribution and the one of its successor, are
+ * returned as well.
+ */
+
+#include <string.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+#include "mo_utilities.c"
+
+/**
+ * @brief The maximal number of points in a block of the front.
+ */
+#define MO_FRONT_BLOCK_SIZE 256
+
+/**
+ * @brief A point of the front, i.e. a solution and its normalized objective values.
+ */
+typedef struct {
+  double normalized_y[2]; /**< @brief The normalized objective values of the solution. */
+  void *item;             /**< @brief The solution. */
+} mo_front_point_t;
+
+/**
+ * @brief A block of consecutive points of the front.
+ */
+typedef struct {
+  size_t number_of_points;
+  mo_front_point_t points[MO_FRONT_BLOCK_SIZE];
+} mo_front_block_t;
+
+/**
+ * @brief A front of mutually nondominated solutions sorted by increasing values of the second objective.
+ */
+typedef struct {
+  mo_front_block_t **blocks; /**< @brief The blocks, none of which is empty. */
+  size_t number_of_blocks;
+  size_t max_number_of_blocks; /**< @brief The number of blocks for which memory is allocated. */
+  size_t number_of_points;
+} mo_front_t;
+
+/**
+ * @brief The position of a point in the front (valid until the front is changed).
+ */
+typedef struct {
+  size_t block;
+  size_t index;
+} mo_front_position_t;
+
+/**
+ * @brief The type of the functions that are called with the solutions removed from the front.
+ */
+typedef void (*mo_front_remove_t)(void *item, void *userdata);
+
+/**
+ * @brief Allocates an empty front.
+ */
+static mo_front_t *mo_front_allocate(void) {
+  mo_front_t *front = (mo_front_t *)coco_allocate_memory(sizeof(*front));
+  front->max_number_of_blocks = 16;
+  front->blocks = (mo_front_block_t **)coco_allocate_memory(front->max_number_of_blocks * sizeof(mo_front_block_t *));
+  front->number_of_blocks = 0;
+  front->number_of_points = 0;
+  return front;
+}
+
+/**
+ * @brief Frees the front, calling free_item (if it is not NULL) with each of its solutions.
+ */
+static void mo_front_free(mo_front_t *front, mo_front_remove_t free_item, void *userdata) {
+  size_t b, i;
+
+  for (b = 0; b < front->number_of_blocks; b++) {
+    if (free_item != NULL) {
+      for (i = 0; i < front->blocks[b]->number_of_points; i++)
+        free_item(front->blocks[b]->points[i].item, userdata);
+    }
+    coco_free_memory(front->blocks[b]);
+  }
+  coco_free_memory(front->blocks);
+  coco_free_memory(front);
+}
+
+/**
+ * @brief Returns the number of solutions in the front.
+ */
+static size_t mo_front_get_number_of_points(const mo_front_t *front) {
+  return front->number_of_points;
+}
+
+/**
+ * @brief Returns the first solution of the front (or NULL if the front is empty) and sets its position.
+ */
+static void *mo_front_get_first(const mo_front_t *front, mo_front_position_t *position) {
+  position->block = 0;
+  position->index = 0;
+  return (front->number_of_blocks > 0) ? front->blocks[0]->points[0].item : NULL;
+}
+
+/**
+ * @brief Returns the last solution of the front (or NULL if the front is empty).
+ */
+static void *mo_front_get_last(const mo_front_t *front) {
+  const mo_front_block_t *block;
+
+  if (front->number_of_blocks == 0)
+    return NULL;
+  block = front->blocks[front->number_of_blocks - 1];
+  return block->points[block->number_of_points - 1].item;
+}
+
+/**
+ * @brief Moves the position to the next solution of the front and returns it (or NULL if there is none).
+ */
+static void *mo_front_get_next(const mo_front_t *front, mo_front_position_t *position) {
+  if (position->block >= front->number_of_blocks)
+    return NULL;
+  position->index++;
+  if (position->index >= front->blocks[position->block]->number_of_points) {
+    position->block++;
+    position->index = 0;
+    if (position->block >= front->number_of_blocks)
+      return NULL;
+  }
+  return front->blocks[position->block]->points[position->index].item;
+}
+
+/**
+ * @brief Orders the normalized solutions by the value of the second objective (values closer together than
+ * mo_precision are equal), like strcmp().
+ */
+static int mo_front_compare(const double *normalized_y1, const double *normalized_y2) {
+  if (coco_double_almost_equal(normalized_y1[1], normalized_y2[1], mo_precision))
+    return 0;
+  else if (normalized_y1[1] < normalized_y2[1])
+    return -1;
+  else
+    return 1;
+}
+
+/**
+ * @brief Checks the dominance relation in the unconstrained minimization case between two normalized
+ * solutions of a bi-objective problem.
+ *
+ * If two values are closer together than mo_precision, they are treated as equal.
+ *
+ * @return
+ *  1 if normalized_y1 dominates normalized_y2 <br>
+ *  0 if normalized_y1 and normalized_y2 are non-dominated <br>
+ * -1 if normalized_y2 dominates normalized_y1 <br>
+ * -2 if normalized_y1 is identical to normalized_y2
+ */
+static int mo_front_get_dominance(const double *normalized_y1, const double *normalized_y2) {
+  int flag1 = 0, flag2 = 0;
+
+  if (!coco_double_almost_equal(normalized_y1[0], normalized_y2[0], mo_precision)) {
+    flag1 = normalized_y1[0] < normalized_y2[0];
+    flag2 = normalized_y1[0] > normalized_y2[0];
+  }
+  if (!coco_double_almost_equal(normalized_y1[1], normalized_y2[1], mo_precision)) {
+    flag1 |= normalized_y1[1] < normalized_y2[1];
+    flag2 |= normalized_y1[1] > normalized_y2[1];
+  }
+
+  if (flag1 && !flag2)
+    return 1;
+  else if (!flag1 && flag2)
+    return -1;
+  else if (flag1 && flag2)
+    return 0;
+  else
+    return -2;
+}
+
+/**
+ * @brief Finds the last point that is not larger than the given normalized solution (see mo_front_compare()).
+ *
+ * @return 1 if the point was found (and stored in position) and 0 if all points are larger.
+ */
+static int mo_front_search(const mo_front_t *front, const double *normalized_y, mo_front_position_t *position) {
+  const mo_front_block_t *block;
+  size_t low, high, middle;
+
+  /* Find the last block whose first point is not larger */
+  low = 0;
+  high = front->number_of_blocks;
+  while (low < high) {
+    middle = low + (high - low) / 2;
+    if (mo_front_compare(normalized_y, front->blocks[middle]->points[0].normalized_y) >= 0)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  if (low == 0)
+    return 0;
+  position->block = low - 1;
+
+  /* Find the last point of the block that is not larger */
+  block = front->blocks[position->block];
+  low = 1;
+  high = block->number_of_points;
+  while (low < high) {
+    middle = low + (high - low) / 2;
+    if (mo_front_compare(normalized_y, block->points[middle].normalized_y) >= 0)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  position->index = low - 1;
+  return 1;
+}
+
+/**
+ * @brief Inserts an empty block at the given index of the list of blocks and returns it.
+ */
+static mo_front_block_t *mo_front_insert_block(mo_front_t *front, const size_t block_index) {
+  mo_front_block_t **blocks;
+
+  if (front->number_of_blocks == front->max_number_of_blocks) {
+    front->max_number_of_blocks *= 2;
+    blocks = (mo_front_block_t **)coco_allocate_memory(front->max_number_of_blocks * sizeof(mo_front_block_t *));
+    memcpy(blocks, front->blocks, front->number_of_blocks * sizeof(mo_front_block_t *));
+    coco_free_memory(front->blocks);
+    front->blocks = blocks;
+  }
+  memmove(front->blocks + block_index + 1, front->blocks + block_index,
+          (front->number_of_blocks - block_index) * sizeof(mo_front_block_t *));
+  front->blocks[block_index] = (mo_front_block_t *)coco_allocate_memory(sizeof(mo_front_block_t));
+  front->blocks[block_index]->number_of_points = 0;
+  front->number_of_blocks++;
+  return front->blocks[block_index];
+}
+
+/**
+ * @brief Inserts the point at the given position (splitting a full block) and updates the position to the
+ * one of the inserted point.
+ */
+static void mo_front_insert_point(mo_front_t *front, mo_front_position_t *position, const mo_front_point_t *point) {
+  mo_front_block_t *block, *new_block;
+  const size_t half = MO_FRONT_BLOCK_SIZE / 2;
+
+  if (front->number_of_blocks == 0)
+    mo_front_insert_block(front, 0);
+  block = front->blocks[position->block];
+
+  if (block->number_of_points == MO_FRONT_BLOCK_SIZE) {
+    /* Move the second half of the points to a new block */
+    new_block = mo_front_insert_block(front, position->block + 1);
+    memcpy(new_block->points, block->points + half, (MO_FRONT_BLOCK_SIZE - half) * sizeof(mo_front_point_t));
+    new_block->number_of_points = MO_FRONT_BLOCK_SIZE - half;
+    block->number_of_points = half;
+    if (position->index > half) {
+      position->block++;
+      position->index -= half;
+      block = new_block;
+    }
+  }
+
+  memmove(block->points + position->index + 1, block->points + position->index,
+          (block->number_of_points - position->index) * sizeof(mo_front_point_t));
+  block->points[position->index] = *point;
+  block->number_of_points++;
+  front->number_of_points++;
+}
+
+/**
+ * @brief Removes number_of_points points starting at the given position (blocks that become empty are
+ * removed as well).
+ */
+static void mo_front_remove_points(mo_front_t *front, const mo_front_position_t *position,
+                                   size_t number_of_points) {
+  mo_front_block_t *block;
+  size_t block_index = position->block, index = position->index, count;
+
+  front->number_of_points -= number_of_points;
+  while (number_of_points > 0) {
+    block = front->blocks[block_index];
+    count = block->number_of_points - index;
+    if (count > number_of_points)
+      count = number_of_points;
+    memmove(block->points + index, block->points + index + count,
+            (block->number_of_points - index - count) * sizeof(mo_front_point_t));
+    block->number_of_points -= count;
+    number_of_points -= count;
+    if (block->number_of_points == 0) {
+      coco_free_memory(block);
+      front->number_of_blocks--;
+      memmove(front->blocks + block_index, front->blocks + block_index + 1,
+              (front->number_of_blocks - block_index) * sizeof(mo_front_block_t *));
+    } else {
+      block_index++;
+    }
+    index = 0;
+  }
+}
+
+/**
+ * @brief Returns the point at the given position or the next one if the index is past the end of the block
+ * (NULL if there is none), updating the position accordingly.
+ */
+static mo_front_point_t *mo_front_get_point(const mo_front_t *front, mo_front_position_t *position) {
+  if ((position->block < front->number_of_blocks) &&
+      (position->index >= front->blocks[position->block]->number_of_points)) {
+    position->block++;
+    position->index = 0;
+  }
+  if (position->block >= front->number_of_blocks)
+    return NULL;
+  return &front->blocks[position->block]->points[position->index];
+}
+
+/**
+ * @brief Updates the front with the given solution.
+ *
+ * If the solution is not weakly dominated by a solution of the front, the solutions it dominates are removed
+ * from the front (and remove_item is called with each of them, if it is not NULL) and the solution is
+ * inserted. The front must not be accessed by remove_item.
+ *
+ * @param front The front.
+ * @param normalized_y The normalized objective values of the solution (two objectives are assumed).
+ * @param item The solution.
+ * @param remove_item The function called with the removed solutions (or NULL).
+ * @param userdata The data passed to remove_item.
+ * @param previous_item Set to the solution before the inserted one (or NULL if there is none or if the
+ * solution was not inserted).
+ * @param next_item Set to the solution after the inserted one (or NULL, see previous_item).
+ * @return 1 if the solution was inserted and 0 otherwise.
+ */
+static int mo_front_update(mo_front_t *front, const double *normalized_y, void *item,
+                           mo_front_remove_t remove_item, void *userdata, void **previous_item,
+                           void **next_item) {
+  mo_front_position_t position, scan_position;
+  mo_front_point_t point, *next_point;
+  size_t number_dominated = 0;
+  int dominance;
+
+  *previous_item = NULL;
+  *next_item = NULL;
+
+  /* Find the last point that is not worse in the second objective than the new point */
+  if (mo_front_search(front, normalized_y, &position)) {
+    point = front->blocks[position.block]->points[position.index];
+    dominance = mo_front_get_dominance(normalized_y, point.normalized_y);
+    if (dominance < 0) {
+      /* The new point is dominated or equal to an existing one */
+      return 0;
+    }
+    if (dominance == 0)
+      position.index++;
+  } else {
+    /* The new point is an extreme point */
+    position.block = 0;
+    position.index = 0;
+  }
+
+  /* Remove the points dominated by the new point, which follow it */
+  scan_position = position;
+  for (;;) {
+    next_point = mo_front_get_point(front, &scan_position);
+    if ((next_point == NULL) || (mo_front_get_dominance(normalized_y, next_point->normalized_y) != 1))
+      break;
+    if (remove_item != NULL)
+      remove_item(next_point->item, userdata);
+    number_dominated++;
+    scan_position.index++;
+  }
+  if (number_dominated > 0) {
+    (void)mo_front_get_point(front, &position);
+    mo_front_remove_points(front, &position, number_dominated);
+  }
+
+  /* Insert the new point (at the end of the last block if it follows all points) */
+  if ((position.block >= front->number_of_blocks) && (front->number_of_blocks > 0)) {
+    position.block = front->number_of_blocks - 1;
+    position.index = front->blocks[position.block]->number_of_points;
+  } else if ((position.block < front->number_of_blocks) &&
+             (position.index > front->blocks[position.block]->number_of_points)) {
+    position.index = front->blocks[position.block]->number_of_points;
+  }
+  point.normalized_y[0] = normalized_y[0];
+  point.normalized_y[1] = normalized_y[1];
+  point.item = item;
+  mo_front_insert_point(front, &position, &point);
+
+  /* Find the neighbors */
+  if (position.index > 0)
+    *previous_item = front->blocks[position.block]->points[position.index - 1].item;
+  else if (position.block > 0)
+    *previous_item = front->blocks[position.block - 1]
+                         ->points[front->blocks[position.block - 1]->number_of_points - 1].item;
+  scan_position.block = position.block;
+  scan_position.index = position.index + 1;
+  next_point = mo_front_get_point(front, &scan_position);
+  if (next_point != NULL)
+    *next_item = next_point->item;
+  return 1;
+}
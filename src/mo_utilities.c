@@ -40,22 +40,22 @@ static double mo_get_norm(const double *first, const double *second, const size_
 }
 
 /**
- * @brief Creates a rounded normalized version of the given solution w.r.t. the given ROI.
+ * @brief Computes a rounded normalized version of the given solution w.r.t. the given ROI and stores it in
+ * normalized_y.
  *
  * If the solution seems to be better than the extremes it is corrected (2 objectives are assumed).
- * The caller is responsible for freeing the allocated memory using coco_free_memory().
  */
-static double *mo_normalize(const double *y, const double *ideal, const double *nadir, const size_t num_obj) {
+static void mo_normalize_to(const double *y, const double *ideal, const double *nadir, const size_t num_obj,
+                            double *normalized_y) {
 
   size_t i;
-  double *normalized_y = coco_allocate_vector(num_obj);
 
   for (i = 0; i < num_obj; i++) {
     assert((nadir[i] - ideal[i]) > mo_discretization);
     normalized_y[i] = (y[i] - ideal[i]) / (nadir[i] - ideal[i]);
     normalized_y[i] = coco_double_round(normalized_y[i] / mo_discretization) * mo_discretization;
     if (normalized_y[i] < 0) {
-      coco_warning("mo_normalize(): Adjusting %.15e to %.15e", y[i], ideal[i]);
+      coco_warning("mo_normalize_to(): Adjusting %.15e to %.15e", y[i], ideal[i]);
       normalized_y[i] = 0;
     }
   }
@@ -63,51 +63,10 @@ static double *mo_normalize(const double *y, const double *ideal, const double *
   for (i = 0; i < num_obj; i++) {
     assert(num_obj == 2);
     if (coco_double_almost_equal(normalized_y[i], 0, mo_precision) && (normalized_y[1 - i] < 1)) {
-      coco_warning("mo_normalize(): Adjusting %.15e to %.15e", y[1 - i], nadir[1 - i]);
+      coco_warning("mo_normalize_to(): Adjusting %.15e to %.15e", y[1 - i], nadir[1 - i]);
       normalized_y[1 - i] = 1;
     }
   }
-
-  return normalized_y;
-}
-
-/**
- * @brief Checks the dominance relation in the unconstrained minimization case between two normalized
- * solutions in the objective space.
- *
- * If two values are closer together than mo_precision, they are treated as equal.
- *
- * @return
- *  1 if normalized_y1 dominates normalized_y2 <br>
- *  0 if normalized_y1 and normalized_y2 are non-dominated <br>
- * -1 if normalized_y2 dominates normalized_y1 <br>
- * -2 if normalized_y1 is identical to normalized_y2
- */
-static int mo_get_dominance(const double *normalized_y1, const double *normalized_y2, const size_t num_obj) {
-
-  size_t i;
-  int flag1 = 0;
-  int flag2 = 0;
-
-  for (i = 0; i < num_obj; i++) {
-    if (coco_double_almost_equal(normalized_y1[i], normalized_y2[i], mo_precision)) {
-      continue;
-    } else if (normalized_y1[i] < normalized_y2[i]) {
-      flag1 = 1;
-    } else if (normalized_y1[i] > normalized_y2[i]) {
-      flag2 = 1;
-    }
-  }
-
-  if (flag1 && !flag2) {
-    return 1;
-  } else if (!flag1 && flag2) {
-    return -1;
-  } else if (flag1 && flag2) {
-    return 0;
-  } else { /* (!flag1 && !flag2) */
-    return -2;
-  }
 }
 
 /**
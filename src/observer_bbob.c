@@ -11,6 +11,43 @@ static void logger_bbob_free(void *logger);
 static void logger_bbob_signal_restart(coco_problem_t *problem);
 static void logger_bbob_data_nullify_observer(void *logger_data);
 
+/**
+ * @brief The state shared by a thread-safe bbob observer and its loggers.
+ *
+ * It is reference counted, because the loggers can outlive the observer.
+ */
+typedef struct {
+  coco_mutex_t mutex;          /**< @brief Serializes the access to the observer and the info files */
+  size_t number_of_references; /**< @brief The number of objects (observer and loggers) using this struct */
+  coco_observer_t *observer;   /**< @brief Pointer to the observer (NULL after the observer has been freed) */
+} observer_bbob_shared_t;
+
+/**
+ * @brief Adds a reference to the shared state and returns it.
+ */
+static observer_bbob_shared_t *observer_bbob_shared_acquire(observer_bbob_shared_t *shared) {
+  coco_mutex_lock(&shared->mutex);
+  shared->number_of_references++;
+  coco_mutex_unlock(&shared->mutex);
+  return shared;
+}
+
+/**
+ * @brief Removes a reference to the shared state and frees it when it was the last one.
+ */
+static void observer_bbob_shared_release(observer_bbob_shared_t *shared) {
+  size_t number_of_references;
+
+  coco_mutex_lock(&shared->mutex);
+  number_of_references = --shared->number_of_references;
+  coco_mutex_unlock(&shared->mutex);
+
+  if (number_of_references == 0) {
+    coco_mutex_destroy(&shared->mutex);
+    coco_free_memory(shared);
+  }
+}
+
 /**
  * @brief The bbob observer data type.
  *
@@ -27,6 +64,12 @@ typedef struct {
   size_t last_function;  /**< @brief The function that was logged last */
   size_t last_dimension; /**< @brief The dimension that was logged last */
   char *last_dat_file;   /**< @brief The name of the .dat file that was last used for logging */
+
+  observer_bbob_shared_t *shared; /**< @brief The state shared with the loggers (NULL if not thread-safe) */
+
+  int impatient;         /**< @brief Whether the data files are flushed after each line */
+  double flush_interval; /**< @brief The maximal time in seconds between flushes of the data files */
+  size_t buffer_size;    /**< @brief The size of the output buffer of each data file */
 } observer_bbob_data_t;
 
 /**
@@ -49,6 +92,15 @@ static void observer_bbob_data_free(void *stuff) {
     data->last_dat_file = NULL;
   }
 
+  /* Let the loggers of a thread-safe observer know that it no longer exists */
+  if (data->shared != NULL) {
+    coco_mutex_lock(&data->shared->mutex);
+    data->shared->observer = NULL;
+    coco_mutex_unlock(&data->shared->mutex);
+    observer_bbob_shared_release(data->shared);
+    data->shared = NULL;
+  }
+
   /* Make sure that the observed problem's pointer to the observer points to NULL */
   if (data->observed_problem != NULL) {
     problem = (coco_problem_t *)data->observed_problem;
@@ -67,13 +119,27 @@ static void observer_bbob_data_free(void *stuff) {
  * Possible options:
  *
  * - "prefix: STRING" defines the prefix of the name of the info files. The default value is "bbobex".
+ *
+ * - "thread_safe: 0/1" whether several problems can be observed at the same time, possibly from different
+ * threads (default is 0). In this mode each observed problem gets its own .?dat files and its line in the
+ * info file is written at once when the problem is freed. Output files are created under a mutex.
+ *
+ * - "impatient: 0/1" whether the data files are flushed after each line, so that the progress can be
+ * followed while the experiment is running (default is 0). Otherwise the output of each data file is
+ * buffered and flushed when the buffer is full, when a line is written at least flush_interval seconds after
+ * the last flush, when the algorithm restarts and when the problem is freed.
+ *
+ * - "flush_interval: VALUE" the number of seconds after which buffered output is flushed (default is 10).
+ *
+ * - "buffer_size: VALUE" the size in bytes of the output buffer of each data file (default is 65536).
  */
 static void observer_bbob(coco_observer_t *observer, const char *options, coco_option_keys_t **option_keys) {
 
   observer_bbob_data_t *observer_data;
+  int thread_safe = 0;
   /* Sets the valid keys for bbob observer options
    * IMPORTANT: This list should be up-to-date with the code and the documentation */
-  const char *known_keys[] = {"prefix"};
+  const char *known_keys[] = {"prefix", "thread_safe", "impatient", "flush_interval", "buffer_size"};
   *option_keys = coco_option_keys_allocate(sizeof(known_keys) / sizeof(char *), known_keys);
 
   observer_data = (observer_bbob_data_t *)coco_allocate_memory(sizeof(*observer_data));
@@ -89,6 +155,36 @@ static void observer_bbob(coco_observer_t *observer, const char *options, coco_o
     strcpy(observer_data->prefix, "bbobexp");
   }
 
+  observer_data->impatient = 0;
+  if (coco_options_read_int(options, "impatient", &observer_data->impatient) == 0) {
+    observer_data->impatient = 0;
+  }
+  observer_data->flush_interval = 10;
+  if (coco_options_read_double(options, "flush_interval", &observer_data->flush_interval) != 0) {
+    if (observer_data->flush_interval < 0) {
+      coco_warning("observer_bbob(): Unsuitable observer option value (flush_interval: %f) ignored",
+                   observer_data->flush_interval);
+      observer_data->flush_interval = 10;
+    }
+  }
+  observer_data->buffer_size = 65536;
+  if (coco_options_read_size_t(options, "buffer_size", &observer_data->buffer_size) != 0) {
+    if (observer_data->buffer_size == 0) {
+      coco_warning("observer_bbob(): Unsuitable observer option value (buffer_size: %lu) ignored",
+                   (unsigned long)observer_data->buffer_size);
+      observer_data->buffer_size = 65536;
+    }
+  }
+
+  observer_data->shared = NULL;
+  if ((coco_options_read_int(options, "thread_safe", &thread_safe) != 0) && (thread_safe != 0)) {
+    observer_data->shared = (observer_bbob_shared_t *)coco_allocate_memory(sizeof(*observer_data->shared));
+    coco_mutex_init(&observer_data->shared->mutex);
+    observer_data->shared->number_of_references = 1;
+    observer_data->shared->observer = observer;
+    observer->is_thread_safe = 1;
+  }
+
   observer->logger_allocate_function = logger_bbob;
   observer->logger_free_function = logger_bbob_free;
   observer->restart_function = logger_bbob_signal_restart;
@@ -26,6 +26,7 @@
 #include "f_sphere.c"
 #include "f_step_ellipsoid.c"
 #include "f_weierstrass.c"
+#include "transform_compiled.c"
 
 static coco_suite_t *coco_suite_allocate(const char *suite_name, const size_t number_of_functions,
                                          const size_t number_of_dimensions, const size_t *dimensions,
@@ -77,6 +78,12 @@ static const char *suite_bbob_get_instances_by_year(const int year) {
   }
 }
 
+/** @brief The template of the ids of the bbob problems. */
+static const char *suite_bbob_problem_id_template = "bbob_f%03lu_i%02lu_d%02lu";
+
+/** @brief The template of the names of the bbob problems. */
+static const char *suite_bbob_problem_name_template = "BBOB suite problem f%lu instance %lu in %luD";
+
 /**
  * @brief Creates and returns a BBOB problem without needing the actual bbob suite.
  *
@@ -85,8 +92,8 @@ static const char *suite_bbob_get_instances_by_year(const int year) {
 coco_problem_t *coco_get_bbob_problem(const size_t function, const size_t dimension, const size_t instance) {
   coco_problem_t *problem = NULL;
 
-  const char *problem_id_template = "bbob_f%03lu_i%02lu_d%02lu";
-  const char *problem_name_template = "BBOB suite problem f%lu instance %lu in %luD";
+  const char *problem_id_template = suite_bbob_problem_id_template;
+  const char *problem_name_template = suite_bbob_problem_name_template;
 
   const long rseed = (long)(function + 10000 * instance);
   const long rseed_3 = (long)(3 + 10000 * instance);
@@ -188,6 +195,8 @@ coco_problem_t *coco_get_bbob_problem(const size_t function, const size_t dimens
     return NULL; /* Never reached */
   }
 
+  /* Collapse the transformations into a flat sequence of operations for faster evaluation */
+  problem = transform_compiled(problem);
   return problem;
 }
 
@@ -217,3 +226,26 @@ static coco_problem_t *suite_bbob_get_problem(coco_suite_t *suite, const size_t
 
   return problem;
 }
+
+/**
+ * @brief Returns the id and name of the problem from the bbob suite that corresponds to the given parameters
+ * without constructing the problem.
+ *
+ * @param suite The COCO suite.
+ * @param function_idx Index of the function (starting from 0).
+ * @param dimension_idx Index of the dimension (starting from 0).
+ * @param instance_idx Index of the instance (starting from 0).
+ * @param problem_id Pointer to the problem id, which is set by this function (to be freed by the caller).
+ * @param problem_name Pointer to the problem name, which is set by this function (to be freed by the caller).
+ */
+static void suite_bbob_get_problem_id_and_name(const coco_suite_t *suite, const size_t function_idx,
+                                               const size_t dimension_idx, const size_t instance_idx,
+                                               char **problem_id, char **problem_name) {
+
+  const unsigned long function = (unsigned long)suite->functions[function_idx];
+  const unsigned long dimension = (unsigned long)suite->dimensions[dimension_idx];
+  const unsigned long instance = (unsigned long)suite->instances[instance_idx];
+
+  *problem_id = coco_strdupf(suite_bbob_problem_id_template, function, instance, dimension);
+  *problem_name = coco_strdupf(suite_bbob_problem_name_template, function, instance, dimension);
+}
@@ -14,6 +14,12 @@
 /** @brief Maximal dimension used in BBOB2009. */
 #define SUITE_BBOB2009_MAX_DIM 40
 
+/** @brief Largest sample size for which bbob2009_gauss() keeps its temporary data on the stack. */
+#define BBOB2009_GAUSS_STACK_SIZE 64
+
+/** @brief Number of columns that bbob2009_compute_rotation() orthonormalizes together. */
+#define BBOB2009_ROTATION_BLOCK_SIZE 16
+
 /** @brief Computes the minimum of the two values. */
 static double bbob2009_fmin(double a, double b) { return (a < b) ? a : b; }
 
@@ -109,8 +115,12 @@ static double **bbob2009_reshape(double **B, double *vector, const size_t m, con
  */
 static void bbob2009_gauss(double *g, const size_t N, const long seed) {
   size_t i;
-  double uniftmp[6000];
-  assert(2 * N < 6000);
+  double uniftmp_on_stack[2 * BBOB2009_GAUSS_STACK_SIZE];
+  double *uniftmp = uniftmp_on_stack;
+
+  /* Only larger samples (like the ones used for rotation matrices) need to be allocated */
+  if (N > BBOB2009_GAUSS_STACK_SIZE)
+    uniftmp = coco_allocate_vector(2 * N);
   bbob2009_unif(uniftmp, 2 * N, seed);
 
   for (i = 0; i < N; i++) {
@@ -118,38 +128,103 @@ static void bbob2009_gauss(double *g, const size_t N, const long seed) {
     if (g[i] == 0.)
       g[i] = 1e-99;
   }
+  if (uniftmp != uniftmp_on_stack)
+    coco_free_memory(uniftmp);
   return;
 }
 
+/**
+ * @brief Subtracts from the vector v of length n its projection onto the (normalized) vector u.
+ */
+static void bbob2009_remove_projection(double *v, const double *u, const size_t n) {
+  double prod = 0;
+  size_t k;
+
+  for (k = 0; k < n; k++)
+    prod += v[k] * u[k];
+  for (k = 0; k < n; k++)
+    v[k] -= prod * u[k];
+}
+
 /**
  * @brief Computes a DIM by DIM rotation matrix based on seed and stores it in B.
+ *
+ * The columns of a matrix of normally distributed numbers are orthonormalized with the modified Gram-Schmidt
+ * process. The columns are stored contiguously while they are orthonormalized and are processed in blocks
+ * of BBOB2009_ROTATION_BLOCK_SIZE columns: once the columns of a block are orthonormalized, their
+ * projections are removed from all the following columns while the block is still in the cache. Each column
+ * still has the projections onto all previous columns removed in the original order, so the result is
+ * exactly the same as the one of the original column-by-column implementation.
  */
 static void bbob2009_compute_rotation(double **B, const long seed, const size_t DIM) {
-  /* To ensure temporary data fits into gvec */
   double prod;
-  double gvect[2000];
-  size_t i, j, k; /* Loop over pairs of column vectors. */
+  double *columns = coco_allocate_vector(DIM * DIM);
+  double *column;
+  size_t block_start, block_end;
+  size_t i, j, k;
 
-  assert(DIM * DIM < 2000);
+  /* The column i of the matrix is stored in columns[i * DIM], ..., columns[i * DIM + DIM - 1] */
+  bbob2009_gauss(columns, DIM * DIM, seed);
 
-  bbob2009_gauss(gvect, DIM * DIM, seed);
-  bbob2009_reshape(B, gvect, DIM, DIM);
-  /*1st coordinate is row, 2nd is column.*/
+  for (block_start = 0; block_start < DIM; block_start += BBOB2009_ROTATION_BLOCK_SIZE) {
+    block_end = block_start + BBOB2009_ROTATION_BLOCK_SIZE;
+    if (block_end > DIM)
+      block_end = DIM;
 
-  for (i = 0; i < DIM; i++) {
-    for (j = 0; j < i; j++) {
+    /* Orthonormalize the columns of the block */
+    for (i = block_start; i < block_end; i++) {
+      column = columns + i * DIM;
+      for (j = block_start; j < i; j++)
+        bbob2009_remove_projection(column, columns + j * DIM, DIM);
       prod = 0;
       for (k = 0; k < DIM; k++)
-        prod += B[k][i] * B[k][j];
+        prod += column[k] * column[k];
       for (k = 0; k < DIM; k++)
-        B[k][i] -= prod * B[k][j];
+        column[k] /= sqrt(prod);
+    }
+
+    /* Remove the projections onto the columns of the block from the following columns */
+    for (i = block_end; i < DIM; i++) {
+      column = columns + i * DIM;
+      for (j = block_start; j < block_end; j++)
+        bbob2009_remove_projection(column, columns + j * DIM, DIM);
+    }
+  }
+
+  /*1st coordinate is row, 2nd is column.*/
+  bbob2009_reshape(B, columns, DIM, DIM);
+  coco_free_memory(columns);
+}
+
+/**
+ * @brief Computes the matrix M = rot1 * diag(base^(k / (DIM - 1))) * rot2 used by the ill-conditioned rotated
+ * functions and sets b to zero.
+ *
+ * The entries of M are summed up in the same order as by the original triple loop (so the result is exactly
+ * the same), but pow() is called only DIM times and the rows of rot2 are read contiguously.
+ */
+static void bbob2009_compute_scaled_rotation_product(double *M, double *b, double **rot1, const double base,
+                                                     double **rot2, const size_t DIM) {
+  size_t i, j, k;
+  double *scaling = coco_allocate_vector(DIM);
+  double *current_row, factor;
+
+  for (k = 0; k < DIM; ++k) {
+    double exponent = 1.0 * (int)k / ((double)(long)DIM - 1.0);
+    scaling[k] = pow(base, exponent);
+  }
+  for (i = 0; i < DIM; ++i) {
+    b[i] = 0.0;
+    current_row = M + i * DIM;
+    for (j = 0; j < DIM; ++j)
+      current_row[j] = 0.0;
+    for (k = 0; k < DIM; ++k) {
+      factor = rot1[i][k] * scaling[k];
+      for (j = 0; j < DIM; ++j)
+        current_row[j] += factor * rot2[k][j];
     }
-    prod = 0;
-    for (k = 0; k < DIM; k++)
-      prod += B[k][i] * B[k][i];
-    for (k = 0; k < DIM; k++)
-      B[k][i] /= sqrt(prod);
   }
+  coco_free_memory(scaling);
 }
 
 static void bbob2009_copy_rotation_matrix(double **rot, double *M, double *b, const size_t DIM) {
@@ -48,6 +48,9 @@ static const char *suite_bbob_mixint_get_instances_by_year(const int year) {
   return "1-15";
 }
 
+/** @brief The template of the ids of the bbob-mixint problems. */
+static const char *suite_bbob_mixint_problem_id_template = "bbob-mixint_f%03lu_i%02lu_d%02lu";
+
 /**
  * @brief Creates and returns a mixed-integer bbob problem without needing the actual bbob-mixint
  * suite.
@@ -56,11 +59,13 @@ static const char *suite_bbob_mixint_get_instances_by_year(const int year) {
  * @param dimension Dimension
  * @param instance Instance
  * @param coco_get_problem_function The function that is used to access the continuous problem.
+ * @param cache_size The number of evaluations cached by the discretization (0 for no cache).
  * @return The problem that corresponds to the given parameters.
  */
 static coco_problem_t *coco_get_bbob_mixint_problem(const size_t function, const size_t dimension,
                                                     const size_t instance,
-                                                    const coco_get_problem_function_t coco_get_problem_function) {
+                                                    const coco_get_problem_function_t coco_get_problem_function,
+                                                    const size_t cache_size) {
   coco_problem_t *problem = NULL;
 
   /* The cardinality of variables (0 = continuous variables should always come last) */
@@ -103,11 +108,12 @@ static coco_problem_t *coco_get_bbob_mixint_problem(const size_t function, const
 
   inner_problem_id = problem->problem_id;
 
-  problem = transform_vars_discretize(problem, smallest_values_of_interest, largest_values_of_interest, num_integer);
+  problem = transform_vars_discretize(problem, smallest_values_of_interest, largest_values_of_interest, num_integer,
+                                      cache_size);
 
   problem = transform_obj_scale(problem, suite_bbob_mixint_scaling_factors[function - 1]);
 
-  coco_problem_set_id(problem, "bbob-mixint_f%03lu_i%02lu_d%02lu", function, instance, dimension);
+  coco_problem_set_id(problem, suite_bbob_mixint_problem_id_template, function, instance, dimension);
   coco_problem_set_name(problem, "mixint(%s)", inner_problem_id);
 
   coco_free_memory(smallest_values_of_interest);
@@ -139,9 +145,11 @@ static coco_problem_t *suite_bbob_mixint_get_problem(coco_suite_t *suite, const
   const size_t instance = suite->instances[instance_idx];
 
   if (dimension < dim_large_scale)
-    problem = coco_get_bbob_mixint_problem(function, dimension, instance, coco_get_bbob_problem);
+    problem = coco_get_bbob_mixint_problem(function, dimension, instance, coco_get_bbob_problem,
+                                           suite->evaluation_cache_size);
   else
-    problem = coco_get_bbob_mixint_problem(function, dimension, instance, coco_get_largescale_problem);
+    problem = coco_get_bbob_mixint_problem(function, dimension, instance, coco_get_largescale_problem,
+                                           suite->evaluation_cache_size);
 
   problem->suite_dep_function = function;
   problem->suite_dep_instance = instance;
@@ -149,3 +157,28 @@ static coco_problem_t *suite_bbob_mixint_get_problem(coco_suite_t *suite, const
 
   return problem;
 }
+
+/**
+ * @brief Returns the id and name of the problem from the bbob-mixint suite that corresponds to the given
+ * parameters without constructing the problem.
+ *
+ * @see suite_bbob_get_problem_id_and_name
+ */
+static void suite_bbob_mixint_get_problem_id_and_name(const coco_suite_t *suite, const size_t function_idx,
+                                                      const size_t dimension_idx, const size_t instance_idx,
+                                                      char **problem_id, char **problem_name) {
+
+  const unsigned long function = (unsigned long)suite->functions[function_idx];
+  const unsigned long dimension = (unsigned long)suite->dimensions[dimension_idx];
+  const unsigned long instance = (unsigned long)suite->instances[instance_idx];
+  const unsigned long dim_large_scale = 50; /* Switch to large-scale functions for dimensions over 50 */
+  char *inner_problem_id;
+
+  *problem_id = coco_strdupf(suite_bbob_mixint_problem_id_template, function, instance, dimension);
+  if (dimension < dim_large_scale)
+    inner_problem_id = coco_strdupf(suite_bbob_problem_id_template, function, instance, dimension);
+  else
+    inner_problem_id = coco_strdupf(suite_largescale_problem_id_template, function, instance, dimension);
+  *problem_name = coco_strdupf("mixint(%s)", inner_problem_id);
+  coco_free_memory(inner_problem_id);
+}
@@ -48,18 +48,57 @@ static const char *suite_bbob_noisy_get_instances_by_year(const int year) {
   }
 }
 
+/** @brief The template of the ids of the bbob-noisy problems. */
+static const char *suite_bbob_noisy_problem_id_template = "bbob_noisy_f%lu_i%02lu_d%02lu";
+
+/** @brief The template of the names of the bbob-noisy problems (before they are wrapped by the noise model). */
+static const char *suite_bbob_noisy_problem_name_template = "BBOB-NOISY suite problem f%lu instance %lu in %luD";
+
+/**
+ * @brief Data of the bbob-noisy suite.
+ */
+typedef struct {
+  int legacy_noise; /**< @brief Whether the noise reproduces the sequence of the legacy code */
+} suite_bbob_noisy_data_t;
+
+/**
+ * @brief Sets the generator of the noise of the suite problems given by the "noise_generator" suite option.
+ *
+ * The generator is either "stream" (default), where each problem draws its noise from its own random stream,
+ * or "legacy", where all problems draw their noise from the same seeds as in the legacy code.
+ */
+static void suite_bbob_noisy_set_noise_generator(coco_suite_t *suite, const char *noise_generator) {
+  suite_bbob_noisy_data_t *data;
+
+  if (strcmp(suite->suite_name, "bbob-noisy") != 0) {
+    coco_warning("suite_bbob_noisy_set_noise_generator(): suite option 'noise_generator' ignored for suite %s",
+                 suite->suite_name);
+    return;
+  }
+  if ((strcmp(noise_generator, "stream") != 0) && (strcmp(noise_generator, "legacy") != 0)) {
+    coco_warning("suite_bbob_noisy_set_noise_generator(): unknown noise generator '%s' ignored", noise_generator);
+    return;
+  }
+  if (suite->data == NULL)
+    suite->data = coco_allocate_memory(sizeof(suite_bbob_noisy_data_t));
+  data = (suite_bbob_noisy_data_t *)suite->data;
+  data->legacy_noise = (strcmp(noise_generator, "legacy") == 0);
+}
+
 /**
  * @brief Creates and returns a BBOB problem without needing the actual bbob suite.
  *
  * Useful for other suites as well (see for example suite_biobj.c).
+ *
+ * If legacy_noise is nonzero, the noise reproduces the sequence of the legacy code (see coco_noise_stream_t).
  */
 static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const size_t dimension,
-                                                   const size_t instance) {
+                                                   const size_t instance, const int legacy_noise) {
   coco_problem_t *problem = NULL;
   coco_problem_t *inner_problem = NULL;
 
-  const char *problem_id_template = "bbob_noisy_f%lu_i%02lu_d%02lu";
-  const char *problem_name_template = "BBOB-NOISY suite problem f%lu instance %lu in %luD";
+  const char *problem_id_template = suite_bbob_noisy_problem_id_template;
+  const char *problem_name_template = suite_bbob_noisy_problem_name_template;
 
   long rseed;
   const long rseed_1 = (long)(1 + 10000 * instance);
@@ -76,81 +115,81 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
     inner_problem = f_sphere_bbob_problem_allocate(function, dimension, instance, rseed, problem_id_template,
                                                    problem_name_template);
     double beta = 0.01;
-    problem = transform_obj_gaussian_noise(inner_problem, beta);
+    problem = transform_obj_gaussian_noise(inner_problem, beta, legacy_noise);
   } else if (function == 102) {
     rseed = rseed_1;
     inner_problem = f_sphere_bbob_problem_allocate(function, dimension, instance, rseed, problem_id_template,
                                                    problem_name_template);
     double alpha = 0.01 * (0.49 + 1 / (double)dimension);
     double beta = 0.01;
-    problem = transform_obj_uniform_noise(inner_problem, alpha, beta);
+    problem = transform_obj_uniform_noise(inner_problem, alpha, beta, legacy_noise);
   } else if (function == 103) {
     rseed = rseed_1;
     inner_problem = f_sphere_bbob_problem_allocate(function, dimension, instance, rseed, problem_id_template,
                                                    problem_name_template);
     double alpha = 0.01;
     double p = 0.05;
-    problem = transform_obj_cauchy_noise(inner_problem, alpha, p);
+    problem = transform_obj_cauchy_noise(inner_problem, alpha, p, legacy_noise);
   } else if (function == 104) {
     rseed = rseed_8;
     inner_problem = f_rosenbrock_bbob_problem_allocate(function, dimension, instance, rseed, problem_id_template,
                                                        problem_name_template);
     double beta = 0.01;
-    problem = transform_obj_gaussian_noise(inner_problem, beta);
+    problem = transform_obj_gaussian_noise(inner_problem, beta, legacy_noise);
   } else if (function == 105) {
     rseed = rseed_8;
     inner_problem = f_rosenbrock_bbob_problem_allocate(function, dimension, instance, rseed, problem_id_template,
                                                        problem_name_template);
     double alpha = 0.01 * (0.49 + 1 / (double)dimension);
     double beta = 0.01;
-    problem = transform_obj_uniform_noise(inner_problem, alpha, beta);
+    problem = transform_obj_uniform_noise(inner_problem, alpha, beta, legacy_noise);
   } else if (function == 106) {
     rseed = rseed_8;
     inner_problem = f_rosenbrock_bbob_problem_allocate(function, dimension, instance, rseed, problem_id_template,
                                                        problem_name_template);
     double alpha = 0.01;
     double p = 0.05;
-    problem = transform_obj_cauchy_noise(inner_problem, alpha, p);
+    problem = transform_obj_cauchy_noise(inner_problem, alpha, p, legacy_noise);
   } else if (function == 107) {
     rseed = rseed_1;
     inner_problem = f_sphere_bbob_problem_allocate(function, dimension, instance, rseed, problem_id_template,
                                                    problem_name_template);
     double beta = 1.0;
-    problem = transform_obj_gaussian_noise(inner_problem, beta);
+    problem = transform_obj_gaussian_noise(inner_problem, beta, legacy_noise);
   } else if (function == 108) {
     rseed = rseed_1;
     inner_problem = f_sphere_bbob_problem_allocate(function, dimension, instance, rseed, problem_id_template,
                                                    problem_name_template);
     double alpha = 0.49 + 1.0 / (double)dimension;
     double beta = 1.0;
-    problem = transform_obj_uniform_noise(inner_problem, alpha, beta);
+    problem = transform_obj_uniform_noise(inner_problem, alpha, beta, legacy_noise);
   } else if (function == 109) {
     rseed = rseed_1;
     inner_problem = f_sphere_bbob_problem_allocate(function, dimension, instance, rseed, problem_id_template,
                                                    problem_name_template);
     double alpha = 1.0;
     double p = 0.2;
-    problem = transform_obj_cauchy_noise(inner_problem, alpha, p);
+    problem = transform_obj_cauchy_noise(inner_problem, alpha, p, legacy_noise);
   } else if (function == 110) {
     rseed = rseed_8;
     inner_problem = f_rosenbrock_bbob_problem_allocate(function, dimension, instance, rseed, problem_id_template,
                                                        problem_name_template);
     double beta = 1.0;
-    problem = transform_obj_gaussian_noise(inner_problem, beta);
+    problem = transform_obj_gaussian_noise(inner_problem, beta, legacy_noise);
   } else if (function == 111) {
     rseed = rseed_8;
     inner_problem = f_rosenbrock_bbob_problem_allocate(function, dimension, instance, rseed, problem_id_template,
                                                        problem_name_template);
     double alpha = 0.49 + 1.0 / (double)dimension;
     double beta = 1.0;
-    problem = transform_obj_uniform_noise(inner_problem, alpha, beta);
+    problem = transform_obj_uniform_noise(inner_problem, alpha, beta, legacy_noise);
   } else if (function == 112) {
     rseed = rseed_8;
     inner_problem = f_rosenbrock_bbob_problem_allocate(function, dimension, instance, rseed, problem_id_template,
                                                        problem_name_template);
     double alpha = 1.0;
     double p = 0.2;
-    problem = transform_obj_cauchy_noise(inner_problem, alpha, p);
+    problem = transform_obj_cauchy_noise(inner_problem, alpha, p, legacy_noise);
   } else if (function == 113) {
     rseed = rseed_7;
     f_step_ellipsoid_args_t args;
@@ -158,7 +197,7 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
     inner_problem = f_step_ellipsoid_bbob_problem_allocate(function, dimension, instance, rseed, &args,
                                                            problem_id_template, problem_name_template);
     double beta = 1.0;
-    problem = transform_obj_gaussian_noise(inner_problem, beta);
+    problem = transform_obj_gaussian_noise(inner_problem, beta, legacy_noise);
   } else if (function == 114) {
     rseed = rseed_7;
     f_step_ellipsoid_args_t args;
@@ -167,7 +206,7 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
                                                            problem_id_template, problem_name_template);
     double alpha = 0.49 + 1.0 / (double)dimension;
     double beta = 1.0;
-    problem = transform_obj_uniform_noise(inner_problem, alpha, beta);
+    problem = transform_obj_uniform_noise(inner_problem, alpha, beta, legacy_noise);
   } else if (function == 115) {
     rseed = rseed_7;
     f_step_ellipsoid_args_t args;
@@ -176,7 +215,7 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
                                                            problem_id_template, problem_name_template);
     double alpha = 1.0;
     double p = 0.2;
-    problem = transform_obj_cauchy_noise(inner_problem, alpha, p);
+    problem = transform_obj_cauchy_noise(inner_problem, alpha, p, legacy_noise);
   } else if (function == 116) {
     rseed = rseed_10;
     f_ellipsoid_args_t args;
@@ -184,7 +223,7 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
     inner_problem = f_ellipsoid_rotated_bbob_problem_allocate(function, dimension, instance, rseed, &args,
                                                               problem_id_template, problem_name_template);
     double beta = 1.0;
-    problem = transform_obj_gaussian_noise(inner_problem, beta);
+    problem = transform_obj_gaussian_noise(inner_problem, beta, legacy_noise);
   } else if (function == 117) {
     rseed = rseed_10;
     f_ellipsoid_args_t args;
@@ -193,7 +232,7 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
                                                               problem_id_template, problem_name_template);
     double alpha = 0.49 + 1.0 / (double)dimension;
     double beta = 1.0;
-    problem = transform_obj_uniform_noise(inner_problem, alpha, beta);
+    problem = transform_obj_uniform_noise(inner_problem, alpha, beta, legacy_noise);
   } else if (function == 118) {
     rseed = rseed_10;
     f_ellipsoid_args_t args;
@@ -202,27 +241,27 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
                                                               problem_id_template, problem_name_template);
     double alpha = 1.0;
     double p = 0.2;
-    problem = transform_obj_cauchy_noise(inner_problem, alpha, p);
+    problem = transform_obj_cauchy_noise(inner_problem, alpha, p, legacy_noise);
   } else if (function == 119) {
     rseed = rseed_14;
     inner_problem = f_different_powers_bbob_problem_allocate(function, dimension, instance, rseed, problem_id_template,
                                                              problem_name_template);
     double beta = 1.0;
-    problem = transform_obj_gaussian_noise(inner_problem, beta);
+    problem = transform_obj_gaussian_noise(inner_problem, beta, legacy_noise);
   } else if (function == 120) {
     rseed = rseed_14;
     inner_problem = f_different_powers_bbob_problem_allocate(function, dimension, instance, rseed, problem_id_template,
                                                              problem_name_template);
     double alpha = 0.49 + 1.0 / (double)dimension;
     double beta = 1.0;
-    problem = transform_obj_uniform_noise(inner_problem, alpha, beta);
+    problem = transform_obj_uniform_noise(inner_problem, alpha, beta, legacy_noise);
   } else if (function == 121) {
     rseed = rseed_14;
     inner_problem = f_different_powers_bbob_problem_allocate(function, dimension, instance, rseed, problem_id_template,
                                                              problem_name_template);
     double alpha = 1.0;
     double p = 0.2;
-    problem = transform_obj_cauchy_noise(inner_problem, alpha, p);
+    problem = transform_obj_cauchy_noise(inner_problem, alpha, p, legacy_noise);
   } else if (function == 122) {
     rseed = rseed_17;
     f_schaffers_args_t args;
@@ -231,7 +270,7 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
     inner_problem = f_schaffers_bbob_problem_allocate(function, dimension, instance, rseed, &args, problem_id_template,
                                                       problem_name_template);
     double beta = 1.0;
-    problem = transform_obj_gaussian_noise(inner_problem, beta);
+    problem = transform_obj_gaussian_noise(inner_problem, beta, legacy_noise);
   } else if (function == 123) {
     rseed = rseed_17;
     f_schaffers_args_t args;
@@ -241,7 +280,7 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
                                                       problem_name_template);
     double alpha = 0.49 + 1.0 / (double)dimension;
     double beta = 1.0;
-    problem = transform_obj_uniform_noise(inner_problem, alpha, beta);
+    problem = transform_obj_uniform_noise(inner_problem, alpha, beta, legacy_noise);
   } else if (function == 124) {
     rseed = rseed_17;
     f_schaffers_args_t args;
@@ -251,7 +290,7 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
                                                       problem_name_template);
     double alpha = 1.0;
     double p = 0.2;
-    problem = transform_obj_cauchy_noise(inner_problem, alpha, p);
+    problem = transform_obj_cauchy_noise(inner_problem, alpha, p, legacy_noise);
   } else if (function == 125) {
     rseed = rseed_19;
     f_griewank_rosenbrock_args_t args;
@@ -259,7 +298,7 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
     inner_problem = f_griewank_rosenbrock_bbob_problem_allocate(function, dimension, instance, rseed, &args,
                                                                 problem_id_template, problem_name_template);
     double beta = 1.0;
-    problem = transform_obj_gaussian_noise(inner_problem, beta);
+    problem = transform_obj_gaussian_noise(inner_problem, beta, legacy_noise);
   } else if (function == 126) {
     rseed = rseed_19;
     f_griewank_rosenbrock_args_t args;
@@ -268,7 +307,7 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
                                                                 problem_id_template, problem_name_template);
     double alpha = 0.49 + 1.0 / (double)dimension;
     double beta = 1.0;
-    problem = transform_obj_uniform_noise(inner_problem, alpha, beta);
+    problem = transform_obj_uniform_noise(inner_problem, alpha, beta, legacy_noise);
   } else if (function == 127) {
     rseed = rseed_19;
     f_griewank_rosenbrock_args_t args;
@@ -277,7 +316,7 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
                                                                 problem_id_template, problem_name_template);
     double alpha = 1.0;
     double p = 0.2;
-    problem = transform_obj_cauchy_noise(inner_problem, alpha, p);
+    problem = transform_obj_cauchy_noise(inner_problem, alpha, p, legacy_noise);
   } else if (function == 128) {
     rseed = rseed_21;
     f_gallagher_args_t args;
@@ -286,7 +325,7 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
     inner_problem = f_gallagher_bbob_problem_allocate(function, dimension, instance, rseed, &args, problem_id_template,
                                                       problem_name_template);
     double beta = 1.0;
-    problem = transform_obj_gaussian_noise(inner_problem, beta);
+    problem = transform_obj_gaussian_noise(inner_problem, beta, legacy_noise);
   } else if (function == 129) {
     rseed = rseed_21;
     f_gallagher_args_t args;
@@ -296,7 +335,7 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
                                                       problem_name_template);
     double alpha = 0.49 + 1.0 / (double)dimension;
     double beta = 1.0;
-    problem = transform_obj_uniform_noise(inner_problem, alpha, beta);
+    problem = transform_obj_uniform_noise(inner_problem, alpha, beta, legacy_noise);
   } else if (function == 130) {
     rseed = rseed_21;
     f_gallagher_args_t args;
@@ -306,7 +345,7 @@ static coco_problem_t *coco_get_bbob_noisy_problem(const size_t function, const
                                                       problem_name_template);
     double alpha = 1.0;
     double p = 0.2;
-    problem = transform_obj_cauchy_noise(inner_problem, alpha, p);
+    problem = transform_obj_cauchy_noise(inner_problem, alpha, p, legacy_noise);
   } else {
     coco_error("coco_get_bbob_noisy_problem(): cannot retrieve problem f%lu instance %lu in %luD",
                (unsigned long)function, (unsigned long)instance, (unsigned long)dimension);
@@ -328,15 +367,39 @@ static coco_problem_t *suite_bbob_noisy_get_problem(coco_suite_t *suite, const s
                                                     const size_t dimension_idx, const size_t instance_idx) {
 
   coco_problem_t *problem = NULL;
+  const suite_bbob_noisy_data_t *data = (const suite_bbob_noisy_data_t *)suite->data;
 
   const size_t function = suite->functions[function_idx];
   const size_t dimension = suite->dimensions[dimension_idx];
   const size_t instance = suite->instances[instance_idx];
 
-  problem = coco_get_bbob_noisy_problem(function, dimension, instance);
+  problem = coco_get_bbob_noisy_problem(function, dimension, instance, (data != NULL) && data->legacy_noise);
 
   problem->suite_dep_function = function;
   problem->suite_dep_instance = instance;
   problem->suite_dep_index = coco_suite_encode_problem_index(suite, function_idx, dimension_idx, instance_idx);
   return problem;
 }
+
+/**
+ * @brief Returns the id and name of the problem from the bbob-noisy suite that corresponds to the given
+ * parameters without constructing the problem.
+ *
+ * @see suite_bbob_get_problem_id_and_name
+ */
+static void suite_bbob_noisy_get_problem_id_and_name(const coco_suite_t *suite, const size_t function_idx,
+                                                     const size_t dimension_idx, const size_t instance_idx,
+                                                     char **problem_id, char **problem_name) {
+
+  const unsigned long function = (unsigned long)suite->functions[function_idx];
+  const unsigned long dimension = (unsigned long)suite->dimensions[dimension_idx];
+  const unsigned long instance = (unsigned long)suite->instances[instance_idx];
+  /* The noise models of the functions f101, f102, ... alternate between gaussian, uniform and cauchy */
+  const char *noise_models[] = {"gaussian_noise_model", "uniform_noise_model", "cauchy_noise_model"};
+  char *inner_problem_name;
+
+  *problem_id = coco_strdupf(suite_bbob_noisy_problem_id_template, function, instance, dimension);
+  inner_problem_name = coco_strdupf(suite_bbob_noisy_problem_name_template, function, instance, dimension);
+  *problem_name = coco_strdupf("%s(%s)", noise_models[(function - 101) % 3], inner_problem_name);
+  coco_free_memory(inner_problem_name);
+}
@@ -6,6 +6,7 @@
 
 #include "coco.h"
 #include "coco_internal.h"
+#include "coco_platform.h"
 #include "coco_random.c"
 #include "coco_problem.c"
 #include "suite_bbob_legacy_code.c"
@@ -17,6 +18,8 @@
 /**{@*/
 static long RANDSEED = 30;  /** < @brief Random seed for sampling Uniform noise*/
 static long RANDNSEED = 30; /** < @brief Random seed for sampling Gaussian noise*/
+static coco_mutex_t coco_random_seeds_mutex = COCO_MUTEX_INITIALIZER; /** < @brief Guards both random seeds*/
+static size_t coco_noise_stream_resets = 0; /** < @brief Number of calls to coco_reset_seeds()*/
 
 /**
  * @brief Increases the normal random seed by one unit
@@ -39,23 +42,30 @@ void increase_random_seed(void) {
 }
 
 /**
- * @brief Resets both random seeds to the initial values
+ * @brief Resets both random seeds to the initial values and restarts the noise streams of all problems
  */
 void coco_reset_seeds(void) {
+  coco_mutex_lock(&coco_random_seeds_mutex);
   RANDSEED = 30;
   RANDNSEED = 30;
+  coco_mutex_unlock(&coco_random_seeds_mutex);
+  COCO_ATOMIC_INCREMENT(coco_noise_stream_resets);
 }
 
 /**
  * @brief Returns a sample from the gaussian distribution
  * using the legacy code for random number generations
  * Returns a double
+ *
+ * The seeds are shared by all noisy problems, so samples drawn from several threads are serialized.
  */
 double coco_sample_gaussian_noise(void) {
   double gaussian_noise;
   double gaussian_noise_ptr[1] = {0.0};
+  coco_mutex_lock(&coco_random_seeds_mutex);
   increase_random_n_seed();
   bbob2009_gauss(&gaussian_noise_ptr[0], 1, RANDNSEED);
+  coco_mutex_unlock(&coco_random_seeds_mutex);
   gaussian_noise = gaussian_noise_ptr[0];
   return gaussian_noise;
 }
@@ -68,11 +78,93 @@ double coco_sample_gaussian_noise(void) {
 double coco_sample_uniform_noise(void) {
   double uniform_noise_term;
   double noise_vector[1] = {0.0};
+  coco_mutex_lock(&coco_random_seeds_mutex);
   increase_random_seed();
   bbob2009_unif(&noise_vector[0], 1, RANDSEED);
+  coco_mutex_unlock(&coco_random_seeds_mutex);
   uniform_noise_term = noise_vector[0];
   return uniform_noise_term;
 }
+
+/**
+ * @brief The noise stream of a noisy problem.
+ *
+ * Each noisy problem draws its noise from its own stream of the counter-based Philox generator, whose key
+ * is derived from the problem id. The noise of a problem thus only depends on the number of its previous
+ * evaluations (since its construction or the last call to coco_reset_seeds()), costs a constant time per
+ * sample and is not affected by other problems or threads.
+ *
+ * In the legacy mode, the noise is drawn with coco_sample_gaussian_noise() and coco_sample_uniform_noise()
+ * instead, which reproduces the sequence of the legacy code (where all problems share the same seeds).
+ */
+typedef struct {
+  int legacy;          /**< @brief Whether the legacy seeds are used */
+  uint32_t key[2];     /**< @brief The key of the stream */
+  uint64_t counter;    /**< @brief The number of samples drawn since the last reset */
+  size_t resets;       /**< @brief The value of coco_noise_stream_resets at the last reset */
+} coco_noise_stream_t;
+
+/**
+ * @brief Initializes the noise stream of the problem with the given id.
+ */
+static void coco_noise_stream_init(coco_noise_stream_t *stream, const char *problem_id, const int legacy) {
+  /* 64-bit FNV-1a hash of the problem id */
+  uint64_t hash = (uint64_t)0xCBF29CE4UL << 32 | (uint64_t)0x84222325UL;
+  const char *c;
+
+  for (c = problem_id; *c != '\0'; c++) {
+    hash ^= (uint64_t)(unsigned char)*c;
+    hash *= (uint64_t)0x100UL << 32 | (uint64_t)0x1B3UL;
+  }
+  stream->legacy = legacy;
+  stream->key[0] = (uint32_t)hash;
+  stream->key[1] = (uint32_t)(hash >> 32);
+  stream->counter = 0;
+  stream->resets = COCO_ATOMIC_LOAD(coco_noise_stream_resets);
+}
+
+/**
+ * @brief Returns the next four random 32-bit words of the noise stream.
+ */
+static void coco_noise_stream_next(coco_noise_stream_t *stream, uint32_t words[4]) {
+  const size_t resets = COCO_ATOMIC_LOAD(coco_noise_stream_resets);
+
+  if (stream->resets != resets) {
+    stream->counter = 0;
+    stream->resets = resets;
+  }
+  words[0] = (uint32_t)stream->counter;
+  words[1] = (uint32_t)(stream->counter >> 32);
+  words[2] = 0;
+  words[3] = 0;
+  coco_random_philox4x32(words, stream->key);
+  stream->counter++;
+}
+
+/**
+ * @brief Returns a sample from the gaussian distribution drawn from the noise stream.
+ */
+static double coco_noise_stream_sample_gaussian(coco_noise_stream_t *stream) {
+  uint32_t words[4];
+
+  if (stream->legacy)
+    return coco_sample_gaussian_noise();
+  coco_noise_stream_next(stream, words);
+  return sqrt(-2 * log(coco_random_words_to_uniform(words[0], words[1]))) *
+         cos(2 * coco_pi * coco_random_words_to_uniform(words[2], words[3]));
+}
+
+/**
+ * @brief Returns a sample from the uniform distribution on (0, 1) drawn from the noise stream.
+ */
+static double coco_noise_stream_sample_uniform(coco_noise_stream_t *stream) {
+  uint32_t words[4];
+
+  if (stream->legacy)
+    return coco_sample_uniform_noise();
+  coco_noise_stream_next(stream, words);
+  return coco_random_words_to_uniform(words[0], words[1]);
+}
 /**@}*/
 
 /***********************************************************************************************************/
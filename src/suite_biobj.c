@@ -46,7 +46,7 @@ static coco_suite_t *suite_biobj_initialize(const char *suite_name) {
     return NULL;
   }
 
-  suite->data_free_function = suite_biobj_new_inst_free;
+  suite->data = suite_biobj_new_inst_allocate();
 
   return suite;
 }
@@ -77,14 +77,14 @@ static coco_problem_t *suite_biobj_get_problem(coco_suite_t *suite, const size_t
                                                const size_t dimension_idx, const size_t instance_idx) {
 
   coco_problem_t *problem = NULL;
-  suite_biobj_new_inst_t *new_inst_data = (suite_biobj_new_inst_t *)suite->data;
+  const suite_biobj_new_inst_t *new_inst_data = (const suite_biobj_new_inst_t *)suite->data;
 
   const size_t function = suite->functions[function_idx];
   const size_t dimension = suite->dimensions[dimension_idx];
   const size_t instance = suite->instances[instance_idx];
 
-  problem = coco_get_biobj_problem(function, dimension, instance, coco_get_bbob_problem, &new_inst_data,
-                                   suite->number_of_instances, suite->dimensions, suite->number_of_dimensions);
+  problem = coco_get_biobj_problem(function, dimension, instance, coco_get_bbob_problem, new_inst_data,
+                                   suite->dimensions, suite->number_of_dimensions);
 
   problem->suite_dep_function = function;
   problem->suite_dep_instance = instance;
@@ -93,3 +93,26 @@ static coco_problem_t *suite_biobj_get_problem(coco_suite_t *suite, const size_t
 
   return problem;
 }
+
+/**
+ * @brief Returns the id and name of the problem from the bbob-biobj suite that corresponds to the given
+ * parameters without constructing the problem.
+ *
+ * @see suite_bbob_get_problem_id_and_name
+ */
+static void suite_biobj_get_problem_id_and_name(const coco_suite_t *suite, const size_t function_idx,
+                                                const size_t dimension_idx, const size_t instance_idx,
+                                                char **problem_id, char **problem_name) {
+
+  const suite_biobj_new_inst_t *new_inst_data = (const suite_biobj_new_inst_t *)suite->data;
+
+  const size_t function = suite->functions[function_idx];
+  const size_t dimension = suite->dimensions[dimension_idx];
+  const size_t instance = suite->instances[instance_idx];
+
+  *problem_id = coco_strdupf(suite_biobj_problem_id_template, (unsigned long)function, (unsigned long)instance,
+                             (unsigned long)dimension);
+  *problem_name = coco_get_biobj_problem_name(function, dimension, instance, suite_bbob_problem_id_template,
+                                              new_inst_data, suite->dimensions,
+                                              suite->number_of_dimensions);
+}
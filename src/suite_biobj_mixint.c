@@ -16,7 +16,6 @@
 static coco_suite_t *coco_suite_allocate(const char *suite_name, const size_t number_of_functions,
                                          const size_t number_of_dimensions, const size_t *dimensions,
                                          const char *default_instances, const int known_optima);
-static void suite_biobj_new_inst_free(void *stuff);
 
 /**
  * @brief Sets the dimensions and default instances for the bbob-biobj-mixint suite.
@@ -28,7 +27,7 @@ static coco_suite_t *suite_biobj_mixint_initialize(void) {
   const size_t num_dimensions = sizeof(dimensions) / sizeof(dimensions[0]);
 
   suite = coco_suite_allocate("bbob-biobj-mixint", 92, num_dimensions, dimensions, "instances: 1-15", 0);
-  suite->data_free_function = suite_biobj_new_inst_free;
+  suite->data = suite_biobj_new_inst_allocate();
 
   return suite;
 }
@@ -44,6 +43,9 @@ static const char *suite_biobj_mixint_get_instances_by_year(const int year) {
   return "1-15";
 }
 
+/** @brief The template of the ids of the bbob-biobj-mixint problems. */
+static const char *suite_biobj_mixint_problem_id_template = "bbob-biobj-mixint_f%03lu_i%02lu_d%03lu";
+
 /**
  * @brief Creates and returns a mixed-integer bi-objective bbob problem without needing the actual
  * bbob-mixint suite.
@@ -56,18 +58,18 @@ static const char *suite_biobj_mixint_get_instances_by_year(const int year) {
  * @param dimension Dimension
  * @param instance Instance
  * @param coco_get_problem_function The function that is used to access the single-objective problem.
- * @param new_inst_data Structure containing information on new instance data.
- * @param num_new_instances The number of new instances.
+ * @param new_inst_data The settings of the search for new instances (or NULL for the defaults).
  * @param dimensions An array of dimensions to take into account when creating new instances.
  * @param num_dimensions The number of dimensions to take into account when creating new instances.
+ * @param cache_size The number of evaluations cached by the discretizations (0 for no cache).
  * @return The problem that corresponds to the given parameters.
  */
 static coco_problem_t *coco_get_biobj_mixint_problem(const size_t function, const size_t dimension,
                                                      const size_t instance,
                                                      const coco_get_problem_function_t coco_get_problem_function,
-                                                     suite_biobj_new_inst_t **new_inst_data,
-                                                     const size_t num_new_instances, const size_t *dimensions,
-                                                     const size_t num_dimensions) {
+                                                     const suite_biobj_new_inst_t *new_inst_data,
+                                                     const size_t *dimensions, const size_t num_dimensions,
+                                                     const size_t cache_size) {
 
   coco_problem_t *problem_cont = NULL, *problem = NULL;
   coco_problem_t *problem1, *problem2;
@@ -88,7 +90,7 @@ static coco_problem_t *coco_get_biobj_mixint_problem(const size_t function, cons
 
   /* First, find the underlying single-objective continuous problems */
   problem_cont = coco_get_biobj_problem(function, dimension, instance, coco_get_problem_function, new_inst_data,
-                                        num_new_instances, dimensions, num_dimensions);
+                                        dimensions, num_dimensions);
   assert(problem_cont != NULL);
   problem1_cont = ((coco_problem_stacked_data_t *)problem_cont->data)->problem1;
   problem2_cont = ((coco_problem_stacked_data_t *)problem_cont->data)->problem2;
@@ -130,10 +132,10 @@ static coco_problem_t *coco_get_biobj_mixint_problem(const size_t function, cons
   }
 
   /* Second, discretize the single-objective problems */
-  problem1_mixint =
-      transform_vars_discretize(problem1, smallest_values_of_interest, largest_values_of_interest, num_integer);
-  problem2_mixint =
-      transform_vars_discretize(problem2, smallest_values_of_interest, largest_values_of_interest, num_integer);
+  problem1_mixint = transform_vars_discretize(problem1, smallest_values_of_interest, largest_values_of_interest,
+                                              num_integer, cache_size);
+  problem2_mixint = transform_vars_discretize(problem2, smallest_values_of_interest, largest_values_of_interest,
+                                              num_integer, cache_size);
 
   /* Third, scale the objective values */
   function1 = coco_problem_get_suite_dep_function(problem1);
@@ -147,7 +149,7 @@ static coco_problem_t *coco_get_biobj_mixint_problem(const size_t function, cons
 
   /* Use the standard stacked problem_id as problem_name and construct a new problem_id */
   coco_problem_set_name(problem, problem->problem_id);
-  coco_problem_set_id(problem, "bbob-biobj-mixint_f%03lu_i%02lu_d%03lu", (unsigned long)function,
+  coco_problem_set_id(problem, suite_biobj_mixint_problem_id_template, (unsigned long)function,
                       (unsigned long)instance, (unsigned long)dimension);
 
   /* Construct problem type */
@@ -174,7 +176,7 @@ static coco_problem_t *suite_biobj_mixint_get_problem(coco_suite_t *suite, const
                                                       const size_t dimension_idx, const size_t instance_idx) {
 
   coco_problem_t *problem = NULL;
-  suite_biobj_new_inst_t *new_inst_data = (suite_biobj_new_inst_t *)suite->data;
+  const suite_biobj_new_inst_t *new_inst_data = (const suite_biobj_new_inst_t *)suite->data;
   const size_t dim_large_scale = 50; /* Switch to large-scale functions for dimensions over 50 */
 
   const size_t function = suite->functions[function_idx];
@@ -182,11 +184,13 @@ static coco_problem_t *suite_biobj_mixint_get_problem(coco_suite_t *suite, const
   const size_t instance = suite->instances[instance_idx];
 
   if (dimension < dim_large_scale)
-    problem = coco_get_biobj_mixint_problem(function, dimension, instance, coco_get_bbob_problem, &new_inst_data,
-                                            suite->number_of_instances, suite->dimensions, suite->number_of_dimensions);
+    problem = coco_get_biobj_mixint_problem(function, dimension, instance, coco_get_bbob_problem, new_inst_data,
+                                            suite->dimensions, suite->number_of_dimensions,
+                                            suite->evaluation_cache_size);
   else
-    problem = coco_get_biobj_mixint_problem(function, dimension, instance, coco_get_largescale_problem, &new_inst_data,
-                                            suite->number_of_instances, suite->dimensions, suite->number_of_dimensions);
+    problem = coco_get_biobj_mixint_problem(function, dimension, instance, coco_get_largescale_problem, new_inst_data,
+                                            suite->dimensions, suite->number_of_dimensions,
+                                            suite->evaluation_cache_size);
 
   problem->suite_dep_function = function;
   problem->suite_dep_instance = instance;
@@ -194,3 +198,28 @@ static coco_problem_t *suite_biobj_mixint_get_problem(coco_suite_t *suite, const
 
   return problem;
 }
+
+/**
+ * @brief Returns the id and name of the problem from the bbob-biobj-mixint suite that corresponds to the given
+ * parameters without constructing the problem.
+ *
+ * @see suite_bbob_get_problem_id_and_name
+ */
+static void suite_biobj_mixint_get_problem_id_and_name(const coco_suite_t *suite, const size_t function_idx,
+                                                       const size_t dimension_idx, const size_t instance_idx,
+                                                       char **problem_id, char **problem_name) {
+
+  const suite_biobj_new_inst_t *new_inst_data = (const suite_biobj_new_inst_t *)suite->data;
+  const size_t dim_large_scale = 50; /* Switch to large-scale functions for dimensions over 50 */
+
+  const size_t function = suite->functions[function_idx];
+  const size_t dimension = suite->dimensions[dimension_idx];
+  const size_t instance = suite->instances[instance_idx];
+
+  *problem_id = coco_strdupf(suite_biobj_mixint_problem_id_template, (unsigned long)function,
+                             (unsigned long)instance, (unsigned long)dimension);
+  *problem_name = coco_get_biobj_problem_name(
+      function, dimension, instance,
+      (dimension < dim_large_scale) ? suite_bbob_problem_id_template : suite_largescale_problem_id_template,
+      new_inst_data, suite->dimensions, suite->number_of_dimensions);
+}
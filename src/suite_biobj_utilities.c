@@ -6,11 +6,15 @@
  * value, some care must be taken when selecting the instances. The already verified instances are stored in
  * suite_biobj_instances. If a new instance of the problem is called, a check ensures that the two underlying
  * single-objective instances create a true bi-objective problem. However, these new instances need to be
- * manually added to suite_biobj_instances, otherwise they will be computed each time the suite constructor
- * is invoked with these instances.
+ * manually added to suite_biobj_instances, otherwise they will be computed again in each process that
+ * invokes them.
  */
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "coco.h"
+#include "coco_platform.h"
 #include "suite_biobj_best_values_hyp.c"
 
 /**
@@ -24,92 +28,433 @@ static const size_t suite_biobj_instances[][3] = {{1, 2, 4},    {2, 3, 5},    {3
                                                   {11, 23, 24}, {12, 25, 26}, {13, 27, 28}, {14, 29, 30}, {15, 31, 34}};
 
 /**
- * @brief A structure containing information about the new instances.
+ * @brief The template of the ids of the bi-objective problems.
+ *
+ * Attention! Any change to the problem id affects also archive processing!
+ */
+static const char *suite_biobj_problem_id_template = "bbob-biobj_f%02lu_i%02lu_d%02lu";
+
+/**
+ * @brief The settings of the search for new instances of the bi-objective suites (the data of these suites).
  */
 typedef struct {
+  size_t number_of_threads; /**< @brief The number of threads that check candidate instances in parallel. */
+} suite_biobj_new_inst_t;
+
+/**
+ * @brief Allocates the settings of the search for new instances with their default values (freed by the suite).
+ */
+static suite_biobj_new_inst_t *suite_biobj_new_inst_allocate(void) {
+  suite_biobj_new_inst_t *data = (suite_biobj_new_inst_t *)coco_allocate_memory(sizeof(*data));
+  data->number_of_threads = 1;
+  return data;
+}
+
+/**
+ * @brief Sets the number of threads used to search for new instances of the given bi-objective suite.
+ */
+static void suite_biobj_set_instance_search_threads(coco_suite_t *suite, const size_t number_of_threads) {
+  if ((strcmp(suite->suite_name, "bbob-biobj") != 0) && (strcmp(suite->suite_name, "bbob-biobj-ext") != 0) &&
+      (strcmp(suite->suite_name, "bbob-biobj-mixint") != 0)) {
+    coco_warning("suite_biobj_set_instance_search_threads(): suite option 'instance_search_threads' ignored for "
+                 "suite %s", suite->suite_name);
+    return;
+  }
+  ((suite_biobj_new_inst_t *)suite->data)->number_of_threads = (number_of_threads > 0) ? number_of_threads : 1;
+}
 
-  size_t **new_instances; /**< @brief A matrix of new instances (equal in form to suite_biobj_instances)
-                                that needs to be used only when an instance that is not in
-                                suite_biobj_instances is being invoked. */
+/**
+ * @brief The maximal number of dimensions of the instances remembered by suite_biobj_remember_new_instance().
+ */
+#define SUITE_BIOBJ_MAX_REMEMBERED_DIMENSIONS 8
 
-  size_t max_new_instances; /**< @brief The maximal number of new instances. */
+/**
+ * @brief The maximal number of instances remembered by suite_biobj_remember_new_instance().
+ */
+#define SUITE_BIOBJ_MAX_REMEMBERED_INSTANCES 256
 
-} suite_biobj_new_inst_t;
+/**
+ * @brief A new instance, i.e. the second instance found for the given first instance and dimensions.
+ */
+typedef struct {
+  size_t instance1;
+  size_t instance2;
+  size_t number_of_dimensions;
+  size_t dimensions[SUITE_BIOBJ_MAX_REMEMBERED_DIMENSIONS];
+} suite_biobj_remembered_instance_t;
 
 /**
- * @brief  Frees the memory of the given suite_biobj_new_inst_t object.
+ * @brief The new instances found so far in this process, so that each one is searched for only once.
  */
-static void suite_biobj_new_inst_free(void *stuff) {
+static suite_biobj_remembered_instance_t suite_biobj_remembered_instances[SUITE_BIOBJ_MAX_REMEMBERED_INSTANCES];
+static size_t suite_biobj_number_of_remembered_instances = 0;
+static coco_mutex_t suite_biobj_remembered_instances_mutex = COCO_MUTEX_INITIALIZER;
 
-  suite_biobj_new_inst_t *data;
+/**
+ * @brief The new instances 16-120 of the bbob-biobj and bbob-biobj-ext suites as triples biobj_instance -
+ * problem1_instance - problem2_instance, valid for the dimensions suite_biobj_precomputed_dimensions.
+ *
+ * The instances have been computed with suite_biobj_search_new_instance() and need to be computed again
+ * whenever the single-objective problems or the checks of suite_biobj_check_inst_consistency() change.
+ */
+static const size_t suite_biobj_precomputed_instances[][3] = {
+    {16, 33, 34}, {17, 35, 36}, {18, 37, 38}, {19, 39, 40}, {20, 41, 42}, {21, 43, 44}, {22, 45, 47},
+    {23, 47, 48}, {24, 49, 51}, {25, 51, 52}, {26, 53, 54}, {27, 55, 56}, {28, 57, 58}, {29, 59, 60},
+    {30, 61, 63}, {31, 63, 64}, {32, 65, 68}, {33, 67, 68}, {34, 69, 70}, {35, 71, 72}, {36, 73, 74},
+    {37, 75, 77}, {38, 77, 79}, {39, 79, 80}, {40, 81, 82}, {41, 83, 84}, {42, 85, 86}, {43, 87, 88},
+    {44, 89, 91}, {45, 91, 92}, {46, 93, 94}, {47, 95, 97}, {48, 97, 98}, {49, 99, 100}, {50, 101, 102},
+    {51, 103, 104}, {52, 105, 106}, {53, 107, 108}, {54, 109, 110}, {55, 111, 112}, {56, 113, 114},
+    {57, 115, 116}, {58, 117, 118}, {59, 119, 120}, {60, 121, 122}, {61, 123, 125}, {62, 125, 126},
+    {63, 127, 128}, {64, 129, 130}, {65, 131, 132}, {66, 133, 135}, {67, 135, 136}, {68, 137, 138},
+    {69, 139, 141}, {70, 141, 142}, {71, 143, 144}, {72, 145, 148}, {73, 147, 148}, {74, 149, 151},
+    {75, 151, 152}, {76, 153, 156}, {77, 155, 156}, {78, 157, 158}, {79, 159, 160}, {80, 161, 162},
+    {81, 163, 164}, {82, 165, 166}, {83, 167, 169}, {84, 169, 170}, {85, 171, 175}, {86, 173, 175},
+    {87, 175, 176}, {88, 177, 178}, {89, 179, 180}, {90, 181, 182}, {91, 183, 184}, {92, 185, 186},
+    {93, 187, 188}, {94, 189, 190}, {95, 191, 192}, {96, 193, 196}, {97, 195, 196}, {98, 197, 198},
+    {99, 199, 200}, {100, 201, 202}, {101, 203, 205}, {102, 205, 206}, {103, 207, 208}, {104, 209, 210},
+    {105, 211, 212}, {106, 213, 214}, {107, 215, 216}, {108, 217, 218}, {109, 219, 220}, {110, 221, 222},
+    {111, 223, 224}, {112, 225, 226}, {113, 227, 228}, {114, 229, 230}, {115, 231, 232}, {116, 233, 237},
+    {117, 235, 237}, {118, 237, 238}, {119, 239, 240}, {120, 241, 242}};
+static const size_t suite_biobj_precomputed_dimensions[] = {2, 3, 5, 10, 20, 40};
+
+/**
+ * @brief The new instances 16-120 of the bbob-biobj-mixint suite, valid for the dimensions
+ * suite_biobj_mixint_precomputed_dimensions (see suite_biobj_precomputed_instances).
+ */
+static const size_t suite_biobj_mixint_precomputed_instances[][3] = {
+    {16, 33, 34}, {17, 35, 36}, {18, 37, 38}, {19, 39, 40}, {20, 41, 42}, {21, 43, 44}, {22, 45, 46},
+    {23, 47, 48}, {24, 49, 50}, {25, 51, 52}, {26, 53, 54}, {27, 55, 56}, {28, 57, 58}, {29, 59, 60},
+    {30, 61, 62}, {31, 63, 64}, {32, 65, 66}, {33, 67, 68}, {34, 69, 70}, {35, 71, 72}, {36, 73, 74},
+    {37, 75, 77}, {38, 77, 78}, {39, 79, 80}, {40, 81, 82}, {41, 83, 84}, {42, 85, 86}, {43, 87, 88},
+    {44, 89, 90}, {45, 91, 92}, {46, 93, 94}, {47, 95, 96}, {48, 97, 98}, {49, 99, 100}, {50, 101, 102},
+    {51, 103, 104}, {52, 105, 106}, {53, 107, 108}, {54, 109, 110}, {55, 111, 112}, {56, 113, 114},
+    {57, 115, 116}, {58, 117, 118}, {59, 119, 120}, {60, 121, 122}, {61, 123, 124}, {62, 125, 126},
+    {63, 127, 128}, {64, 129, 130}, {65, 131, 132}, {66, 133, 134}, {67, 135, 136}, {68, 137, 138},
+    {69, 139, 141}, {70, 141, 142}, {71, 143, 144}, {72, 145, 146}, {73, 147, 148}, {74, 149, 150},
+    {75, 151, 152}, {76, 153, 154}, {77, 155, 156}, {78, 157, 158}, {79, 159, 160}, {80, 161, 162},
+    {81, 163, 164}, {82, 165, 166}, {83, 167, 169}, {84, 169, 170}, {85, 171, 172}, {86, 173, 174},
+    {87, 175, 176}, {88, 177, 178}, {89, 179, 180}, {90, 181, 182}, {91, 183, 184}, {92, 185, 186},
+    {93, 187, 188}, {94, 189, 190}, {95, 191, 192}, {96, 193, 194}, {97, 195, 196}, {98, 197, 198},
+    {99, 199, 200}, {100, 201, 202}, {101, 203, 204}, {102, 205, 206}, {103, 207, 208}, {104, 209, 210},
+    {105, 211, 212}, {106, 213, 214}, {107, 215, 216}, {108, 217, 218}, {109, 219, 220}, {110, 221, 222},
+    {111, 223, 224}, {112, 225, 226}, {113, 227, 228}, {114, 229, 230}, {115, 231, 232}, {116, 233, 234},
+    {117, 235, 236}, {118, 237, 238}, {119, 239, 240}, {120, 241, 242}};
+static const size_t suite_biobj_mixint_precomputed_dimensions[] = {5, 10, 20, 40, 80, 160};
+
+/**
+ * @brief Returns the second instance of the given precomputed instances for the given first instance if they
+ * are valid for the given dimensions (or 0).
+ */
+static size_t suite_biobj_find_precomputed_instance(const size_t (*instances)[3], const size_t num_instances,
+                                                    const size_t *valid_dimensions, const size_t num_valid_dimensions,
+                                                    const size_t instance1, const size_t *dimensions,
+                                                    const size_t number_of_dimensions) {
   size_t i;
 
-  assert(stuff != NULL);
-  data = (suite_biobj_new_inst_t *)stuff;
+  if ((number_of_dimensions != num_valid_dimensions) ||
+      (memcmp(valid_dimensions, dimensions, number_of_dimensions * sizeof(size_t)) != 0))
+    return 0;
+  for (i = 0; i < num_instances; i++) {
+    if (instances[i][1] == instance1)
+      return instances[i][2];
+  }
+  return 0;
+}
 
-  if (data->new_instances) {
-    for (i = 0; i < data->max_new_instances; i++) {
-      if (data->new_instances[i]) {
-        coco_free_memory(data->new_instances[i]);
-        data->new_instances[i] = NULL;
-      }
-    }
+/**
+ * @brief Returns the second instance found before (or precomputed) for the given first instance and
+ * dimensions (or 0).
+ */
+static size_t suite_biobj_recall_new_instance(const size_t instance1, const size_t *dimensions,
+                                              const size_t number_of_dimensions) {
+  const suite_biobj_remembered_instance_t *remembered;
+  size_t i, instance2;
+
+  instance2 = suite_biobj_find_precomputed_instance(
+      suite_biobj_precomputed_instances,
+      sizeof(suite_biobj_precomputed_instances) / sizeof(suite_biobj_precomputed_instances[0]),
+      suite_biobj_precomputed_dimensions,
+      sizeof(suite_biobj_precomputed_dimensions) / sizeof(suite_biobj_precomputed_dimensions[0]), instance1,
+      dimensions, number_of_dimensions);
+  if (instance2 == 0)
+    instance2 = suite_biobj_find_precomputed_instance(
+        suite_biobj_mixint_precomputed_instances,
+        sizeof(suite_biobj_mixint_precomputed_instances) / sizeof(suite_biobj_mixint_precomputed_instances[0]),
+        suite_biobj_mixint_precomputed_dimensions,
+        sizeof(suite_biobj_mixint_precomputed_dimensions) / sizeof(suite_biobj_mixint_precomputed_dimensions[0]),
+        instance1, dimensions, number_of_dimensions);
+  if (instance2 != 0)
+    return instance2;
+
+  coco_mutex_lock(&suite_biobj_remembered_instances_mutex);
+  for (i = 0; (i < suite_biobj_number_of_remembered_instances) && (instance2 == 0); i++) {
+    remembered = &suite_biobj_remembered_instances[i];
+    if ((remembered->instance1 == instance1) && (remembered->number_of_dimensions == number_of_dimensions) &&
+        (memcmp(remembered->dimensions, dimensions, number_of_dimensions * sizeof(size_t)) == 0))
+      instance2 = remembered->instance2;
   }
-  coco_free_memory(data->new_instances);
-  data->new_instances = NULL;
+  coco_mutex_unlock(&suite_biobj_remembered_instances_mutex);
+  return instance2;
 }
 
 /**
- * @brief  Performs a few checks and returns whether the two given problem instances should break the search
- * for new instances in suite_biobj_get_new_instance().
+ * @brief Remembers the second instance found for the given first instance and dimensions (if there is room).
  */
-static int suite_biobj_check_inst_consistency(const size_t dimension, size_t function1, size_t instance1,
-                                              size_t function2, size_t instance2) {
-  coco_problem_t *problem = NULL;
-  coco_problem_t *problem1, *problem2;
-  int break_search = 0;
-  double norm;
-  double *smallest_values_of_interest, *largest_values_of_interest;
-  const double apart_enough = 1e-4;
+static void suite_biobj_remember_new_instance(const size_t instance1, const size_t instance2,
+                                              const size_t *dimensions, const size_t number_of_dimensions) {
+  suite_biobj_remembered_instance_t *remembered;
+
+  if (number_of_dimensions > SUITE_BIOBJ_MAX_REMEMBERED_DIMENSIONS)
+    return;
+  coco_mutex_lock(&suite_biobj_remembered_instances_mutex);
+  if (suite_biobj_number_of_remembered_instances < SUITE_BIOBJ_MAX_REMEMBERED_INSTANCES) {
+    remembered = &suite_biobj_remembered_instances[suite_biobj_number_of_remembered_instances++];
+    remembered->instance1 = instance1;
+    remembered->instance2 = instance2;
+    remembered->number_of_dimensions = number_of_dimensions;
+    memcpy(remembered->dimensions, dimensions, number_of_dimensions * sizeof(size_t));
+  }
+  coco_mutex_unlock(&suite_biobj_remembered_instances_mutex);
+}
 
-  problem1 = coco_get_bbob_problem(function1, dimension, instance1);
-  problem2 = coco_get_bbob_problem(function2, dimension, instance2);
+/**
+ * @brief Performs a few checks and returns whether the two given problems should break the search for new
+ * instances in suite_biobj_get_new_instance().
+ *
+ * The checks are the ones of the bi-objective problem stacked from the two problems: its ideal and nadir
+ * points need to be apart enough in the objective space and its extreme optimal points in the decision space.
+ */
+static int suite_biobj_check_inst_consistency(coco_problem_t *problem1, coco_problem_t *problem2) {
 
-  /* Set smallest and largest values of interest to some value (not important which, it just needs to be a
-   * vector of doubles of the right dimension) */
-  smallest_values_of_interest = coco_allocate_vector_with_value(dimension, -100);
-  largest_values_of_interest = coco_allocate_vector_with_value(dimension, 100);
-  problem = coco_problem_stacked_allocate(problem1, problem2, smallest_values_of_interest, largest_values_of_interest);
-  coco_free_memory(smallest_values_of_interest);
-  coco_free_memory(largest_values_of_interest);
+  double ideal[2], nadir[2];
+  double norm;
+  const double apart_enough = 1e-4;
 
   /* Check whether the ideal and nadir points are too close in the objective space */
-  norm = mo_get_norm(problem->best_value, problem->nadir_value, 2);
+  ideal[0] = problem1->best_value[0];
+  ideal[1] = problem2->best_value[0];
+  coco_evaluate_function(problem1, problem2->best_parameter, &nadir[0]);
+  coco_evaluate_function(problem2, problem1->best_parameter, &nadir[1]);
+  norm = mo_get_norm(ideal, nadir, 2);
   if (norm < 1e-1) { /* TODO How to set this value in a sensible manner? */
-    coco_debug(
-        "suite_biobj_check_inst_consistency(): The ideal and nadir points of %s are too close in the objective space",
-        problem->problem_id);
-    coco_debug("norm = %e, ideal = %e\t%e, nadir = %e\t%e", norm, problem->best_value[0], problem->best_value[1],
-               problem->nadir_value[0], problem->nadir_value[1]);
-    break_search = 1;
+    coco_debug("suite_biobj_check_inst_consistency(): The ideal and nadir points of %s and %s are too close in the "
+               "objective space", problem1->problem_id, problem2->problem_id);
+    coco_debug("norm = %e, ideal = %e\t%e, nadir = %e\t%e", norm, ideal[0], ideal[1], nadir[0], nadir[1]);
+    return 1;
   }
 
   /* Check whether the extreme optimal points are too close in the decision space */
-  norm = mo_get_norm(problem1->best_parameter, problem2->best_parameter, problem->number_of_variables);
+  norm = mo_get_norm(problem1->best_parameter, problem2->best_parameter, problem1->number_of_variables);
   if (norm < apart_enough) {
-    coco_debug("suite_biobj_check_inst_consistency(): The extreme points of %s are too close in the decision space",
-               problem->problem_id);
+    coco_debug("suite_biobj_check_inst_consistency(): The extreme points of %s and %s are too close in the "
+               "decision space", problem1->problem_id, problem2->problem_id);
     coco_debug("norm = %e", norm);
-    break_search = 1;
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief The maximal number of candidates checked in the search for a new instance.
+ */
+#define SUITE_BIOBJ_MAX_INSTANCE_TRIES 1000
+
+/**
+ * @brief The state of a search for a new instance shared by the threads that check the candidates.
+ *
+ * The candidates instance1 + 1, ..., instance1 + max_tries are handed out in increasing order. A candidate
+ * is abandoned as soon as a smaller one has been found to be appropriate, so the result is the smallest
+ * appropriate candidate, no matter how many threads check the candidates.
+ */
+typedef struct {
+  size_t instance1;
+  const size_t *bbob_functions;
+  size_t num_bbob_functions;
+  const size_t *sel_bbob_functions;
+  size_t num_sel_bbob_functions;
+  const size_t *dimensions; /**< @brief The dimensions to check (without the filtered ones) */
+  size_t num_dimensions;
+  size_t max_tries;
+
+  coco_mutex_t mutex;
+  size_t next_candidate;  /**< @brief The number of the next candidate to check (guarded by mutex) */
+  size_t found_candidate; /**< @brief The number of the smallest appropriate candidate or max_tries + 1 (ditto) */
+} suite_biobj_instance_search_t;
+
+/**
+ * @brief Returns the bbob problem of the given function (index) and dimension (index) from the table of
+ * problems, constructing it at first use.
+ *
+ * The problems of the first instance and of a candidate are constructed only once for all the checks of the
+ * candidate, instead of once for each pair of functions.
+ */
+static coco_problem_t *suite_biobj_get_search_problem(coco_problem_t **problems,
+                                                      const suite_biobj_instance_search_t *search,
+                                                      const size_t function_idx, const size_t dimension_idx,
+                                                      const size_t instance) {
+  const size_t i = dimension_idx * search->num_bbob_functions + function_idx;
+  if (problems[i] == NULL)
+    problems[i] = coco_get_bbob_problem(search->bbob_functions[function_idx], search->dimensions[dimension_idx],
+                                        instance);
+  return problems[i];
+}
+
+/**
+ * @brief Returns the index of the given function in search->bbob_functions.
+ */
+static size_t suite_biobj_get_search_function_idx(const suite_biobj_instance_search_t *search,
+                                                  const size_t function) {
+  size_t i;
+  for (i = 0; i < search->num_bbob_functions; i++) {
+    if (search->bbob_functions[i] == function)
+      return i;
+  }
+  coco_error("suite_biobj_get_search_function_idx(): function %lu not found", (unsigned long)function);
+  return 0; /* Never reached */
+}
+
+/**
+ * @brief Returns 1 if the given candidate is an appropriate second instance and 0 if it is not (or if its
+ * check was abandoned because a smaller candidate has been found).
+ *
+ * An instance is "appropriate" if the ideal and nadir points in the objective space and the two extreme
+ * optimal points in the decisions space are apart enough for all problems (all dimensions and function
+ * combinations).
+ */
+static int suite_biobj_is_appropriate_instance(suite_biobj_instance_search_t *search, coco_problem_t **problems1,
+                                               coco_problem_t **problems2, const size_t candidate) {
+  const size_t instance2 = search->instance1 + candidate;
+  size_t d, f1, f2, found_candidate;
+  coco_problem_t *problem1, *problem2;
+
+  for (f1 = 0; f1 < search->num_bbob_functions; f1++) {
+    /* Give up if a smaller candidate has been found in the meantime */
+    coco_mutex_lock(&search->mutex);
+    found_candidate = search->found_candidate;
+    coco_mutex_unlock(&search->mutex);
+    if (found_candidate < candidate)
+      return 0;
+
+    for (f2 = f1 + 1; f2 < search->num_bbob_functions; f2++) {
+      for (d = 0; d < search->num_dimensions; d++) {
+        problem1 = suite_biobj_get_search_problem(problems1, search, f1, d, search->instance1);
+        problem2 = suite_biobj_get_search_problem(problems2, search, f2, d, instance2);
+        if (suite_biobj_check_inst_consistency(problem1, problem2))
+          return 0;
+      }
+    }
   }
 
-  /* Clean up */
-  if (problem) {
-    coco_problem_stacked_free(problem);
-    problem = NULL;
+  /* Finally, check all functions (f,f) with f in {f1, f2, f6, f8, f13, f14, f15, f17, f20, f21}: */
+  for (f1 = 0; f1 < search->num_sel_bbob_functions; f1++) {
+    f2 = suite_biobj_get_search_function_idx(search, search->sel_bbob_functions[f1]);
+    for (d = 0; d < search->num_dimensions; d++) {
+      problem1 = suite_biobj_get_search_problem(problems1, search, f2, d, search->instance1);
+      problem2 = suite_biobj_get_search_problem(problems2, search, f2, d, instance2);
+      if (suite_biobj_check_inst_consistency(problem1, problem2))
+        return 0;
+    }
   }
+  return 1;
+}
 
-  return break_search;
+/**
+ * @brief Frees the problems of the table and sets them to NULL.
+ */
+static void suite_biobj_free_search_problems(coco_problem_t **problems, const size_t number_of_problems) {
+  size_t i;
+  for (i = 0; i < number_of_problems; i++) {
+    if (problems[i] != NULL) {
+      coco_problem_free(problems[i]);
+      problems[i] = NULL;
+    }
+  }
+}
+
+/**
+ * @brief Checks candidates of the search until there are no more candidates that could improve the result.
+ */
+static COCO_THREAD_RETURN_TYPE suite_biobj_check_candidates(void *argument) {
+  suite_biobj_instance_search_t *search = (suite_biobj_instance_search_t *)argument;
+  const size_t number_of_problems = search->num_bbob_functions * search->num_dimensions;
+  coco_problem_t **problems1, **problems2;
+  size_t i, candidate;
+
+  /* Each thread has its own problems, since problems cannot be evaluated by several threads at once */
+  problems1 = (coco_problem_t **)coco_allocate_memory(number_of_problems * sizeof(coco_problem_t *));
+  problems2 = (coco_problem_t **)coco_allocate_memory(number_of_problems * sizeof(coco_problem_t *));
+  for (i = 0; i < number_of_problems; i++)
+    problems1[i] = problems2[i] = NULL;
+
+  for (;;) {
+    coco_mutex_lock(&search->mutex);
+    candidate = search->next_candidate;
+    if ((candidate > search->max_tries) || (candidate > search->found_candidate)) {
+      coco_mutex_unlock(&search->mutex);
+      break;
+    }
+    search->next_candidate++;
+    coco_mutex_unlock(&search->mutex);
+
+    if (suite_biobj_is_appropriate_instance(search, problems1, problems2, candidate)) {
+      coco_mutex_lock(&search->mutex);
+      if (candidate < search->found_candidate)
+        search->found_candidate = candidate;
+      coco_mutex_unlock(&search->mutex);
+    }
+    suite_biobj_free_search_problems(problems2, number_of_problems);
+  }
+
+  suite_biobj_free_search_problems(problems1, number_of_problems);
+  coco_free_memory(problems1);
+  coco_free_memory(problems2);
+  return COCO_THREAD_RETURN_VALUE;
+}
+
+/**
+ * @brief Returns the instance number of the second problem/objective for the given first instance that
+ * passes the checks of suite_biobj_is_appropriate_instance() in all given dimensions (or 0 if there is none
+ * within a maximum number of tries).
+ *
+ * The candidates instance1 + 1, instance1 + 2, ... are checked by number_of_threads threads (see
+ * suite_biobj_instance_search_t), which gives the same result as checking them one after the other.
+ */
+static size_t suite_biobj_search_new_instance(const size_t number_of_threads, const size_t instance1,
+                                              const size_t *bbob_functions, const size_t num_bbob_functions,
+                                              const size_t *sel_bbob_functions, const size_t num_sel_bbob_functions,
+                                              const size_t *dimensions, const size_t num_dimensions) {
+  suite_biobj_instance_search_t search;
+  size_t thread_idx;
+  coco_thread_t *threads;
+  int *is_thread_started;
+
+  search.instance1 = instance1;
+  search.bbob_functions = bbob_functions;
+  search.num_bbob_functions = num_bbob_functions;
+  search.sel_bbob_functions = sel_bbob_functions;
+  search.num_sel_bbob_functions = num_sel_bbob_functions;
+  search.dimensions = dimensions;
+  search.num_dimensions = num_dimensions;
+  search.max_tries = SUITE_BIOBJ_MAX_INSTANCE_TRIES;
+  coco_mutex_init(&search.mutex);
+  search.next_candidate = 1;
+  search.found_candidate = search.max_tries + 1;
+
+  /* The calling thread checks candidates as well */
+  threads = (coco_thread_t *)coco_allocate_memory(number_of_threads * sizeof(coco_thread_t));
+  is_thread_started = (int *)coco_allocate_memory(number_of_threads * sizeof(int));
+  for (thread_idx = 1; thread_idx < number_of_threads; thread_idx++)
+    is_thread_started[thread_idx] = coco_thread_create(&threads[thread_idx], suite_biobj_check_candidates, &search);
+  suite_biobj_check_candidates(&search);
+  for (thread_idx = 1; thread_idx < number_of_threads; thread_idx++) {
+    if (is_thread_started[thread_idx])
+      coco_thread_join(threads[thread_idx]);
+  }
+  coco_free_memory(threads);
+  coco_free_memory(is_thread_started);
+  coco_mutex_destroy(&search.mutex);
+
+  return (search.found_candidate > search.max_tries) ? 0 : instance1 + search.found_candidate;
 }
 
 /**
@@ -121,106 +466,59 @@ static int suite_biobj_check_inst_consistency(const size_t dimension, size_t fun
  * An appropriate instance is the one for which the resulting bi-objective problem (in any considered
  * dimension) has the ideal and nadir points apart enough in the objective space and the extreme optimal
  * points apart enough in the decision space. When the instance has been found, it is output through
- * coco_warning, so that the user can see it and eventually manually add it to suite_biobj_instances.
+ * coco_info, so that the user can see it and eventually manually add it to suite_biobj_instances.
+ *
+ * The candidates are checked by new_inst_data->number_of_threads threads. The result is remembered for the
+ * rest of the process (see suite_biobj_remember_new_instance()). The search is skipped for precomputed
+ * instances (see suite_biobj_precomputed_instances).
  */
-static size_t suite_biobj_get_new_instance(suite_biobj_new_inst_t *new_inst_data, const size_t instance,
+static size_t suite_biobj_get_new_instance(const suite_biobj_new_inst_t *new_inst_data, const size_t instance,
                                            const size_t instance1, const size_t *bbob_functions,
                                            const size_t num_bbob_functions, const size_t *sel_bbob_functions,
                                            const size_t num_sel_bbob_functions, const size_t *dimensions,
                                            const size_t num_dimensions) {
 
-  size_t instance2 = 0;
-  size_t num_tries = 0;
-  const size_t max_tries = 1000;
-  int appropriate_instance_found = 0, break_search, warning_produced = 0;
-  size_t d, f1, f2, i;
-  size_t function1, function2, dimension;
-
-  while ((!appropriate_instance_found) && (num_tries < max_tries)) {
-    num_tries++;
-    instance2 = instance1 + num_tries;
-    break_search = 0;
-
-    /* An instance is "appropriate" if the ideal and nadir points in the objective space and the two
-     * extreme optimal points in the decisions space are apart enough for all problems (all dimensions
-     * and function combinations); therefore iterate over all dimensions and function combinations */
-
-    for (f1 = 0; (f1 < num_bbob_functions - 1) && !break_search; f1++) {
-      function1 = bbob_functions[f1];
-      for (f2 = f1 + 1; (f2 < num_bbob_functions) && !break_search; f2++) {
-        function2 = bbob_functions[f2];
-        for (d = 0; (d < num_dimensions) && !break_search; d++) {
-          dimension = dimensions[d];
-
-          if (dimension == 0) {
-            if (!warning_produced)
-              coco_warning("suite_biobj_get_new_instance(): remove filtering of dimensions to get generally acceptable "
-                           "instances!");
-            warning_produced = 1;
-            continue;
-          }
-
-          break_search = suite_biobj_check_inst_consistency(dimension, function1, instance1, function2, instance2);
-        }
-      }
-    }
+  size_t *checked_dimensions;
+  size_t d, instance2, num_checked_dimensions = 0;
 
-    /* Finally, check all functions (f,f) with f in {f1, f2, f6, f8, f13, f14, f15, f17, f20, f21}: */
-    for (f1 = 0; (f1 < num_sel_bbob_functions) && !break_search; f1++) {
-      function1 = sel_bbob_functions[f1];
-      function2 = sel_bbob_functions[f1];
-      for (d = 0; (d < num_dimensions) && !break_search; d++) {
-        dimension = dimensions[d];
-
-        if (dimension == 0) {
-          if (!warning_produced)
-            coco_warning("suite_biobj_get_new_instance(): remove filtering of dimensions to get generally acceptable "
-                         "instances!");
-          warning_produced = 1;
-          continue;
-        }
-
-        break_search = suite_biobj_check_inst_consistency(dimension, function1, instance1, function2, instance2);
-      }
-    }
-
-    if (break_search) {
-      /* The search was broken, continue with next instance2 */
-      continue;
-    } else {
-      /* An appropriate instance was found */
-      appropriate_instance_found = 1;
-      coco_info("suite_biobj_get_new_instance(): Instance %lu created from instances %lu and %lu",
-                (unsigned long)instance, (unsigned long)instance1, (unsigned long)instance2);
-
-      /* Save the instance to new_instances */
-      for (i = 0; i < new_inst_data->max_new_instances; i++) {
-        if (new_inst_data->new_instances[i][0] == 0) {
-          new_inst_data->new_instances[i][0] = instance;
-          new_inst_data->new_instances[i][1] = instance1;
-          new_inst_data->new_instances[i][2] = instance2;
-          break;
-        };
-      }
-    }
+  /* Only the dimensions that have not been filtered are checked */
+  checked_dimensions = coco_allocate_vector_size_t(num_dimensions);
+  for (d = 0; d < num_dimensions; d++) {
+    if (dimensions[d] != 0)
+      checked_dimensions[num_checked_dimensions++] = dimensions[d];
+  }
+  if (num_checked_dimensions < num_dimensions)
+    coco_warning("suite_biobj_get_new_instance(): remove filtering of dimensions to get generally acceptable "
+                 "instances!");
+
+  instance2 = suite_biobj_recall_new_instance(instance1, checked_dimensions, num_checked_dimensions);
+  if (instance2 != 0) {
+    coco_free_memory(checked_dimensions);
+    return instance2;
   }
 
-  if (!appropriate_instance_found) {
+  instance2 = suite_biobj_search_new_instance((new_inst_data != NULL) ? new_inst_data->number_of_threads : 1,
+                                              instance1, bbob_functions, num_bbob_functions, sel_bbob_functions,
+                                              num_sel_bbob_functions, checked_dimensions, num_checked_dimensions);
+  if (instance2 == 0) {
+    coco_free_memory(checked_dimensions);
     coco_error("suite_biobj_get_new_instance(): Could not find suitable instance %lu in %lu tries",
-               (unsigned long)instance, (unsigned long)num_tries);
+               (unsigned long)instance, (unsigned long)SUITE_BIOBJ_MAX_INSTANCE_TRIES);
     return 0; /* Never reached */
   }
 
+  coco_info("suite_biobj_get_new_instance(): Instance %lu created from instances %lu and %lu",
+            (unsigned long)instance, (unsigned long)instance1, (unsigned long)instance2);
+  suite_biobj_remember_new_instance(instance1, instance2, checked_dimensions, num_checked_dimensions);
+  coco_free_memory(checked_dimensions);
   return instance2;
 }
 
 /**
- * @brief Creates and returns a bi-objective problem without needing a suite.
- *
- * Useful for creating suites based on the bi-objective problems.
+ * @brief Computes the functions and instances of the two single-objective problems that make up the given
+ * bi-objective problem.
  *
- * Creates the bi-objective problem by constructing it from two single-objective problems. If the
- * invoked instance number is not in suite_biobj_instances, the function uses the following formula
+ * If the invoked instance number is not in suite_biobj_instances, the function uses the following formula
  * to construct a new appropriate instance:
  *   problem1_instance = 2 * biobj_instance + 1
  *   problem2_instance = problem1_instance + 1
@@ -228,19 +526,20 @@ static size_t suite_biobj_get_new_instance(suite_biobj_new_inst_t *new_inst_data
  * If needed, problem2_instance is increased (see also the explanation in suite_biobj_get_new_instance).
  *
  * @param function Function
- * @param dimension Dimension
  * @param instance Instance
- * @param coco_get_problem_function The function that is used to access the single-objective problem.
- * @param new_inst_data Structure containing information on new instance data.
- * @param num_new_instances The number of new instances.
+ * @param new_inst_data The settings of the search for new instances (or NULL for the defaults).
  * @param dimensions An array of dimensions to take into account when creating new instances.
  * @param num_dimensions The number of dimensions to take into account when creating new instances.
- * @return The problem that corresponds to the given parameters.
+ * @param problem1_function Pointer to the function of the first single-objective problem (set by this function).
+ * @param problem1_instance Pointer to the instance of the first single-objective problem (set by this function).
+ * @param problem2_function Pointer to the function of the second single-objective problem (set by this function).
+ * @param problem2_instance Pointer to the instance of the second single-objective problem (set by this function).
  */
-static coco_problem_t *coco_get_biobj_problem(const size_t function, const size_t dimension, const size_t instance,
-                                              const coco_get_problem_function_t coco_get_problem_function,
-                                              suite_biobj_new_inst_t **new_inst_data, const size_t num_new_instances,
-                                              const size_t *dimensions, const size_t num_dimensions) {
+static void coco_get_biobj_problem_components(const size_t function, const size_t instance,
+                                              const suite_biobj_new_inst_t *new_inst_data,
+                                              const size_t *dimensions, const size_t num_dimensions,
+                                              size_t *problem1_function, size_t *problem1_instance,
+                                              size_t *problem2_function, size_t *problem2_instance) {
 
   /* Selected functions from the bbob suite that are used to construct the original bbob-biobj suite. */
   const size_t sel_bbob_functions[] = {1, 2, 6, 8, 13, 14, 15, 17, 20, 21};
@@ -250,18 +549,14 @@ static coco_problem_t *coco_get_biobj_problem(const size_t function, const size_
                                        13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24};
   const size_t num_all_bbob_functions = 24;
 
-  coco_problem_t *problem1 = NULL, *problem2 = NULL, *problem = NULL;
   size_t instance1 = 0, instance2 = 0;
   size_t function1_idx, function2_idx;
   const size_t function_idx = function - 1;
 
-  size_t i, j;
+  size_t i;
   const size_t num_existing_instances = sizeof(suite_biobj_instances) / sizeof(suite_biobj_instances[0]);
   int instance_found = 0;
 
-  double *smallest_values_of_interest = coco_allocate_vector_with_value(dimension, -100);
-  double *largest_values_of_interest = coco_allocate_vector_with_value(dimension, 100);
-
   /* Determine the corresponding single-objective function indices */
   if (function_idx < 55) {
     /* A "magic" formula to compute the BBOB function index from the bi-objective function index */
@@ -396,76 +691,69 @@ static coco_problem_t *coco_get_biobj_problem(const size_t function, const size_
     }
   }
 
-  if ((!instance_found) && ((*new_inst_data) != NULL)) {
-    /* Next, search for instance in new_instances */
-    for (i = 0; i < (*new_inst_data)->max_new_instances; i++) {
-      if ((*new_inst_data)->new_instances[i][0] == 0)
-        break;
-      if ((*new_inst_data)->new_instances[i][0] == instance) {
-        /* The instance has been found in new_instances */
-        instance1 = (*new_inst_data)->new_instances[i][1];
-        instance2 = (*new_inst_data)->new_instances[i][2];
-        instance_found = 1;
-        break;
-      }
-    }
-  }
-
   if (!instance_found) {
-    int must_free = 0;
-    /* Finally, if the instance is not found, create a new one */
-
-    if ((*new_inst_data) == NULL) {
-      /* Allocate space needed for saving new instances */
-      (*new_inst_data) = (suite_biobj_new_inst_t *)coco_allocate_memory(sizeof(**new_inst_data));
-      must_free = 1;
-
-      /* Most often the actual number of new instances will be lower than max_new_instances, because
-       * some of them are already in suite_biobj_instances. However, in order to avoid iterating over
-       * suite_biobj_new_inst_t, the allocation uses max_new_instances. */
-      (*new_inst_data)->max_new_instances = num_new_instances;
-
-      (*new_inst_data)->new_instances =
-          (size_t **)coco_allocate_memory((*new_inst_data)->max_new_instances * sizeof(size_t *));
-      for (i = 0; i < (*new_inst_data)->max_new_instances; i++) {
-        (*new_inst_data)->new_instances[i] = (size_t *)malloc(3 * sizeof(size_t));
-        for (j = 0; j < 3; j++) {
-          (*new_inst_data)->new_instances[i][j] = 0;
-        }
-      }
-    }
-
-    /* A simple formula to set the first instance */
+    /* Otherwise, search for a new one (or recall the one found before), starting from a simple formula for the
+     * first instance */
     instance1 = 2 * instance + 1;
-    instance2 =
-        suite_biobj_get_new_instance((*new_inst_data), instance, instance1, all_bbob_functions, num_all_bbob_functions,
-                                     sel_bbob_functions, num_sel_bbob_functions, dimensions, num_dimensions);
-    if (must_free) {
-      coco_free_memory(*new_inst_data);
-    }
+    instance2 = suite_biobj_get_new_instance(new_inst_data, instance, instance1, all_bbob_functions,
+                                             num_all_bbob_functions, sel_bbob_functions, num_sel_bbob_functions,
+                                             dimensions, num_dimensions);
   }
 
-  /* Construct the problem based on the function index and dimension */
+  /* Store the function and instance numbers of the underlying problems */
   if (function_idx < 55) {
-    problem1 = coco_get_problem_function(sel_bbob_functions[function1_idx], dimension, instance1);
-    problem2 = coco_get_problem_function(sel_bbob_functions[function2_idx], dimension, instance2);
-    /* Store function numbers of the underlying problems */
-    problem1->suite_dep_function = sel_bbob_functions[function1_idx];
-    problem2->suite_dep_function = sel_bbob_functions[function2_idx];
-
+    *problem1_function = sel_bbob_functions[function1_idx];
+    *problem2_function = sel_bbob_functions[function2_idx];
   } else {
-    problem1 = coco_get_problem_function(all_bbob_functions[function1_idx], dimension, instance1);
-    problem2 = coco_get_problem_function(all_bbob_functions[function2_idx], dimension, instance2);
-    problem1->suite_dep_function = all_bbob_functions[function1_idx];
-    problem2->suite_dep_function = all_bbob_functions[function2_idx];
+    *problem1_function = all_bbob_functions[function1_idx];
+    *problem2_function = all_bbob_functions[function2_idx];
   }
+  *problem1_instance = instance1;
+  *problem2_instance = instance2;
+}
+
+/**
+ * @brief Creates and returns a bi-objective problem without needing a suite.
+ *
+ * Useful for creating suites based on the bi-objective problems.
+ *
+ * Creates the bi-objective problem by constructing it from two single-objective problems (see
+ * coco_get_biobj_problem_components for how they are chosen).
+ *
+ * @param function Function
+ * @param dimension Dimension
+ * @param instance Instance
+ * @param coco_get_problem_function The function that is used to access the single-objective problem.
+ * @param new_inst_data The settings of the search for new instances (or NULL for the defaults).
+ * @param dimensions An array of dimensions to take into account when creating new instances.
+ * @param num_dimensions The number of dimensions to take into account when creating new instances.
+ * @return The problem that corresponds to the given parameters.
+ */
+static coco_problem_t *coco_get_biobj_problem(const size_t function, const size_t dimension, const size_t instance,
+                                              const coco_get_problem_function_t coco_get_problem_function,
+                                              const suite_biobj_new_inst_t *new_inst_data,
+                                              const size_t *dimensions, const size_t num_dimensions) {
+  coco_problem_t *problem1 = NULL, *problem2 = NULL, *problem = NULL;
+  size_t function1, function2, instance1, instance2;
+
+  double *smallest_values_of_interest = coco_allocate_vector_with_value(dimension, -100);
+  double *largest_values_of_interest = coco_allocate_vector_with_value(dimension, 100);
+
+  coco_get_biobj_problem_components(function, instance, new_inst_data, dimensions, num_dimensions, &function1,
+                                    &instance1, &function2, &instance2);
+
+  /* Construct the problem based on the function and dimension */
+  problem1 = coco_get_problem_function(function1, dimension, instance1);
+  problem2 = coco_get_problem_function(function2, dimension, instance2);
+  /* Store function numbers of the underlying problems */
+  problem1->suite_dep_function = function1;
+  problem2->suite_dep_function = function2;
 
   problem = coco_problem_stacked_allocate(problem1, problem2, smallest_values_of_interest, largest_values_of_interest);
 
   /* Use the standard stacked problem_id as problem_name and construct a new problem_id */
   coco_problem_set_name(problem, problem->problem_id);
-  /* Attention! Any change to the problem id affects also archive processing! */
-  coco_problem_set_id(problem, "bbob-biobj_f%02lu_i%02lu_d%02lu", (unsigned long)function, (unsigned long)instance,
+  coco_problem_set_id(problem, suite_biobj_problem_id_template, (unsigned long)function, (unsigned long)instance,
                       (unsigned long)dimension);
 
   /* Construct problem type */
@@ -477,33 +765,142 @@ static coco_problem_t *coco_get_biobj_problem(const size_t function, const size_
   return problem;
 }
 
+/**
+ * @brief Returns the name of the given bi-objective problem without constructing it.
+ *
+ * The name is the id of the stacked problem, that is, the ids of the two single-objective problems
+ * (constructed using problem_id_template) separated by "__".
+ */
+static char *coco_get_biobj_problem_name(const size_t function, const size_t dimension, const size_t instance,
+                                         const char *problem_id_template, const suite_biobj_new_inst_t *new_inst_data,
+                                         const size_t *dimensions, const size_t num_dimensions) {
+  size_t function1, function2, instance1, instance2;
+  char *problem1_id, *problem2_id, *problem_name;
+
+  coco_get_biobj_problem_components(function, instance, new_inst_data, dimensions, num_dimensions, &function1,
+                                    &instance1, &function2, &instance2);
+  problem1_id = coco_strdupf(problem_id_template, (unsigned long)function1, (unsigned long)instance1,
+                             (unsigned long)dimension);
+  problem2_id = coco_strdupf(problem_id_template, (unsigned long)function2, (unsigned long)instance2,
+                             (unsigned long)dimension);
+  problem_name = coco_strdupf("%s__%s", problem1_id, problem2_id);
+  coco_free_memory(problem1_id);
+  coco_free_memory(problem2_id);
+  return problem_name;
+}
+
+/**
+ * @brief A best value of an indicator, parsed from a string of a best-value table.
+ */
+typedef struct {
+  const char *key;   /**< @brief The key, pointing to the string of the table (not terminated after the key) */
+  size_t key_length; /**< @brief The length of the key */
+  double value;      /**< @brief The best value */
+} suite_biobj_best_value_t;
+
+/**
+ * @brief The number of best known hypervolume values.
+ */
+#define SUITE_BIOBJ_NUMBER_OF_BEST_HYP_VALUES (sizeof(suite_biobj_best_values_hyp) / sizeof(char *))
+
+/**
+ * @brief The best known hypervolume values sorted by key, built at first use by suite_biobj_index_best_values().
+ */
+static suite_biobj_best_value_t suite_biobj_best_hyp_values[SUITE_BIOBJ_NUMBER_OF_BEST_HYP_VALUES];
+static int suite_biobj_best_hyp_values_indexed = 0;
+static coco_mutex_t suite_biobj_best_hyp_values_mutex = COCO_MUTEX_INITIALIZER;
+
+/**
+ * @brief Compares two keys of the given lengths like strcmp().
+ */
+static int suite_biobj_compare_keys(const char *key1, const size_t key_length1, const char *key2,
+                                    const size_t key_length2) {
+  const int result = memcmp(key1, key2, (key_length1 < key_length2) ? key_length1 : key_length2);
+  if (result != 0)
+    return result;
+  return (key_length1 < key_length2) ? -1 : (key_length1 > key_length2);
+}
+
+/**
+ * @brief Compares two best values by their keys (for qsort()).
+ */
+static int suite_biobj_compare_best_values(const void *a, const void *b) {
+  const suite_biobj_best_value_t *best_value1 = (const suite_biobj_best_value_t *)a;
+  const suite_biobj_best_value_t *best_value2 = (const suite_biobj_best_value_t *)b;
+  return suite_biobj_compare_keys(best_value1->key, best_value1->key_length, best_value2->key,
+                                  best_value2->key_length);
+}
+
+/**
+ * @brief Parses the strings "KEY VALUE" of the given best-value table into best_values and sorts them by key.
+ */
+static void suite_biobj_index_best_values(const char *const *table, const size_t count,
+                                          suite_biobj_best_value_t *best_values) {
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    best_values[i].key = table[i];
+    best_values[i].key_length = strcspn(table[i], " \t");
+    best_values[i].value = strtod(table[i] + best_values[i].key_length, NULL);
+  }
+  qsort(best_values, count, sizeof(suite_biobj_best_value_t), suite_biobj_compare_best_values);
+}
+
+/**
+ * @brief Returns the best value with the given key in the sorted best_values (or NULL if there is none).
+ */
+static const suite_biobj_best_value_t *suite_biobj_find_best_value(const suite_biobj_best_value_t *best_values,
+                                                                   const size_t count, const char *key) {
+  const size_t key_length = strlen(key);
+  size_t low = 0, high = count, middle;
+  int result;
+
+  while (low < high) {
+    middle = low + (high - low) / 2;
+    result = suite_biobj_compare_keys(best_values[middle].key, best_values[middle].key_length, key, key_length);
+    if (result == 0)
+      return &best_values[middle];
+    if (result < 0)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  return NULL;
+}
+
 /**
  * @brief Saves the best known value for the hypervolume indicator matching the given key.
  *
  * If a suite does not have known optima or it has known optima but the key is not found,
  * the default value is used.
+ *
+ * The table of best values is parsed and sorted at the first call, so that each call only needs a binary
+ * search.
  */
 static void suite_biobj_get_best_hyp_value(const int known_optima, const char *key, double *value) {
 
   static const double default_value = 1.0;
-  size_t i, count;
-  char *curr_key;
+  const suite_biobj_best_value_t *best_value;
   *value = default_value;
 
   if (known_optima) {
-    curr_key = coco_allocate_string(COCO_PATH_MAX + 1);
-    count = sizeof(suite_biobj_best_values_hyp) / sizeof(char *);
-    for (i = 0; i < count; i++) {
-      sscanf(suite_biobj_best_values_hyp[i], "%s %lf", curr_key, value);
-      if (strcmp(curr_key, key) == 0) {
-        coco_free_memory(curr_key);
-        return;
-      }
+    coco_mutex_lock(&suite_biobj_best_hyp_values_mutex);
+    if (!suite_biobj_best_hyp_values_indexed) {
+      suite_biobj_index_best_values(suite_biobj_best_values_hyp, SUITE_BIOBJ_NUMBER_OF_BEST_HYP_VALUES,
+                                    suite_biobj_best_hyp_values);
+      suite_biobj_best_hyp_values_indexed = 1;
+    }
+    coco_mutex_unlock(&suite_biobj_best_hyp_values_mutex);
+
+    best_value = suite_biobj_find_best_value(suite_biobj_best_hyp_values, SUITE_BIOBJ_NUMBER_OF_BEST_HYP_VALUES,
+                                             key);
+    if (best_value != NULL) {
+      *value = best_value->value;
+      return;
     }
     /* If it comes to this point, the key was not found */
     coco_warning("suite_biobj_get_best_hyp_value(): best value of %s could not be found; set to %f", key,
                  default_value);
-    coco_free_memory(curr_key);
   } else {
     coco_warning("suite_biobj_get_best_hyp_value(): best value of %s is not known; set to %f", key, default_value);
   }
@@ -44,6 +44,12 @@ static const char *suite_cons_bbob_get_instances_by_year(const int year) {
   }
 }
 
+/** @brief The template of the ids of the problems in the constrained suites (the first argument is the suite name). */
+static const char *suite_cons_bbob_problem_id_template = "%s_f%03lu_i%02lu_d%02lu";
+
+/** @brief The template of the names of the problems in the constrained suites. */
+static const char *suite_cons_bbob_problem_name_template = "%s suite problem f%lu instance %lu in %luD";
+
 /**
  * @brief Creates and returns a constrained BBOB problem.
  */
@@ -185,10 +191,29 @@ static coco_problem_t *suite_cons_bbob_get_problem(coco_suite_t *suite, const si
   /* Use the standard stacked problem_id as problem_name and
    * construct a new suite-specific problem_id
    */
-  coco_problem_set_id(problem, "%s_f%03lu_i%02lu_d%02lu", suite->suite_name, (unsigned long)function,
+  coco_problem_set_id(problem, suite_cons_bbob_problem_id_template, suite->suite_name, (unsigned long)function,
                       (unsigned long)instance, (unsigned long)dimension);
-  coco_problem_set_name(problem, "%s suite problem f%lu instance %lu in %luD", suite->suite_name,
-                        (unsigned long)function, (unsigned long)instance, (unsigned long)dimension);
+  coco_problem_set_name(problem, suite_cons_bbob_problem_name_template, suite->suite_name, (unsigned long)function,
+                        (unsigned long)instance, (unsigned long)dimension);
 
   return problem;
 }
+
+/**
+ * @brief Returns the id and name of the problem from the bbob-constrained suite that corresponds to the given
+ * parameters without constructing the problem.
+ *
+ * @see suite_bbob_get_problem_id_and_name
+ */
+static void suite_cons_bbob_get_problem_id_and_name(const coco_suite_t *suite, const size_t function_idx,
+                                                    const size_t dimension_idx, const size_t instance_idx,
+                                                    char **problem_id, char **problem_name) {
+
+  const unsigned long function = (unsigned long)suite->functions[function_idx];
+  const unsigned long dimension = (unsigned long)suite->dimensions[dimension_idx];
+  const unsigned long instance = (unsigned long)suite->instances[instance_idx];
+
+  *problem_id = coco_strdupf(suite_cons_bbob_problem_id_template, suite->suite_name, function, instance, dimension);
+  *problem_name =
+      coco_strdupf(suite_cons_bbob_problem_name_template, suite->suite_name, function, instance, dimension);
+}
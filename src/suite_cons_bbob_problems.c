@@ -72,7 +72,9 @@
  *
  * First, we create a coco_problem_t object for the objective function.
  * Then, coco_problem_t objects are created for each constraint and
- * stacked together into a single coco_problem_t object (see "c_linear.c").
+ * stacked together into a single coco_problem_t object, which is then
+ * replaced by one block of linear constraints that evaluates all
+ * constraints at once (see "c_linear.c").
  * Finally, the coco_problem_t object containing the constraints and
  * the coco_problem_t object containing the objective function are
  * stacked together to form the constrained function.
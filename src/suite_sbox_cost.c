@@ -68,6 +68,14 @@ static const char *suite_sbox_cost_get_instances_by_year(const int year) {
   }
 }
 
+/** @brief The template of the ids of the bbob-boxed problems. */
+static const char *suite_sbox_cost_problem_id_template =
+    "bbob-boxed_f%03lu_i%02lu_d%02lu";
+
+/** @brief The template of the names of the bbob-boxed problems. */
+static const char *suite_sbox_cost_problem_name_template =
+    "bbob-boxed suite problem f%lu instance %lu in %luD";
+
 /**
  * @brief Creates and returns a bbob-boxed problem without needing the actual
  * bbob-boxed suite.
@@ -77,9 +85,8 @@ static coco_problem_t *coco_get_bbob_boxed_problem(const size_t function,
                                                   const size_t instance) {
   coco_problem_t *problem = NULL;
 
-  const char *problem_id_template = "bbob-boxed_f%03lu_i%02lu_d%02lu";
-  const char *problem_name_template =
-      "bbob-boxed suite problem f%lu instance %lu in %luD";
+  const char *problem_id_template = suite_sbox_cost_problem_id_template;
+  const char *problem_name_template = suite_sbox_cost_problem_name_template;
 
   const long rseed = (long)(function + 10000 * instance);
   const long rseed_3 = (long)(3 + 10000 * instance);
@@ -235,3 +242,27 @@ static coco_problem_t *suite_sbox_cost_get_problem(coco_suite_t *suite,
 
   return problem;
 }
+
+/**
+ * @brief Returns the id and name of the problem from the bbob-boxed suite that corresponds to the given
+ * parameters without constructing the problem.
+ *
+ * @see suite_bbob_get_problem_id_and_name
+ */
+static void suite_sbox_cost_get_problem_id_and_name(const coco_suite_t *suite, const size_t function_idx,
+                                                    const size_t dimension_idx, const size_t instance_idx,
+                                                    char **problem_id, char **problem_name) {
+
+  const unsigned long function = (unsigned long)suite->functions[function_idx];
+  const unsigned long dimension = (unsigned long)suite->dimensions[dimension_idx];
+  const unsigned long instance = (unsigned long)suite->instances[instance_idx];
+  char *inner_problem_name;
+
+  *problem_id = coco_strdupf(suite_sbox_cost_problem_id_template, function,
+                             instance, dimension);
+  /* The name is set before the problem is wrapped by transform_vars_enforce_box() */
+  inner_problem_name = coco_strdupf(suite_sbox_cost_problem_name_template,
+                                    function, instance, dimension);
+  *problem_name = coco_strdupf("transform_vars_enforce_box(%s)", inner_problem_name);
+  coco_free_memory(inner_problem_name);
+}
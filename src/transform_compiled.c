@@ -0,0 +1,446 @@
+/**
+ * @file transform_compiled.c
+ * @brief Implementation of collapsing a chain of transformations into a flat sequence of operations.
+ *
+ * A bbob problem consists of a raw function wrapped into several transformations, each of which is a
+ * problem of its own with its own scratch vector and bookkeeping. The compiled problem walks this chain
+ * once when it is created and records the supported transformations as a flat array of operations. An
+ * evaluation then runs through this array on two scratch vectors and finally evaluates the first layer
+ * that was not compiled (usually the raw function).
+ *
+ * The operations are carried out exactly as in the evaluate functions of the transformations (and the
+ * INFINITY/NAN handling of coco_evaluate_function between the layers is replicated), so that the results
+ * are bit-identical to evaluating the chain of transformations. The wrapped chain is kept intact and is
+ * still used for everything but the function evaluation.
+ */
+
+#include <assert.h>
+#include <math.h>
+
+#include "coco.h"
+#include "coco_problem.c"
+#include "suite_bbob_legacy_code.c"
+#include "transform_obj_norm_by_dim.c"
+#include "transform_obj_oscillate.c"
+#include "transform_obj_penalize.c"
+#include "transform_obj_power.c"
+#include "transform_obj_scale.c"
+#include "transform_obj_shift.c"
+#include "transform_vars_affine.c"
+#include "transform_vars_asymmetric.c"
+#include "transform_vars_brs.c"
+#include "transform_vars_conditioning.c"
+#include "transform_vars_oscillate.c"
+#include "transform_vars_scale.c"
+#include "transform_vars_shift.c"
+#include "transform_vars_x_hat.c"
+#include "transform_vars_z_hat.c"
+
+/**
+ * @brief The types of the compiled operations.
+ */
+typedef enum {
+  TRANSFORM_COMPILED_VARS_SHIFT,
+  TRANSFORM_COMPILED_VARS_AFFINE,
+  TRANSFORM_COMPILED_VARS_OSCILLATE,
+  TRANSFORM_COMPILED_VARS_ASYMMETRIC,
+  TRANSFORM_COMPILED_VARS_MULTIPLY, /**< @brief Multiplication by precomputed coefficients */
+  TRANSFORM_COMPILED_VARS_SCALE,
+  TRANSFORM_COMPILED_VARS_BRS,
+  TRANSFORM_COMPILED_VARS_Z_HAT,
+  TRANSFORM_COMPILED_OBJ_SHIFT,
+  TRANSFORM_COMPILED_OBJ_SCALE,
+  TRANSFORM_COMPILED_OBJ_POWER,
+  TRANSFORM_COMPILED_OBJ_OSCILLATE,
+  TRANSFORM_COMPILED_OBJ_PENALIZE
+} transform_compiled_operation_type_t;
+
+/**
+ * @brief A single compiled operation.
+ *
+ * Operations on the decision vector are applied on the way in (from the outer to the inner layers) and
+ * operations on the objective vector on the way out (from the inner to the outer layers).
+ */
+typedef struct {
+  transform_compiled_operation_type_t type;
+  coco_problem_t *layer;  /**< @brief The layer the operation was compiled from (owns vector and matrix) */
+  double value;           /**< @brief Scalar parameter (offset, factor, exponent, alpha or beta) */
+  const double *vector;   /**< @brief Vector parameter (offset, b, xopt or coefficients) */
+  const double *matrix;   /**< @brief Matrix parameter (M of the affine transformation) */
+  double *coefficients;   /**< @brief Coefficients computed at compile time (owned by the operation) */
+  double penalty;         /**< @brief Penalty computed on the way in (transform_obj_penalize) */
+} transform_compiled_operation_t;
+
+/**
+ * @brief Data type for transform_compiled.
+ */
+typedef struct {
+  transform_compiled_operation_t *operations;
+  size_t number_of_operations;
+  coco_problem_t *terminal_problem; /**< @brief The first layer that was not compiled */
+  int terminal_is_transformed;      /**< @brief Whether the terminal problem is a transformation itself */
+  double *x1, *x2;                  /**< @brief Scratch vectors */
+} transform_compiled_data_t;
+
+/**
+ * @brief Adds an operation compiled from the given layer and returns it.
+ */
+static transform_compiled_operation_t *transform_compiled_add(transform_compiled_data_t *data,
+                                                              const transform_compiled_operation_type_t type,
+                                                              coco_problem_t *layer) {
+  transform_compiled_operation_t *operation = &data->operations[data->number_of_operations++];
+  operation->type = type;
+  operation->layer = layer;
+  operation->value = 0;
+  operation->vector = NULL;
+  operation->matrix = NULL;
+  operation->coefficients = NULL;
+  operation->penalty = 0;
+  return operation;
+}
+
+/**
+ * @brief Compiles the given layer into an operation.
+ *
+ * Returns 1 if the layer was compiled (or can be skipped) and 0 if the layer is not supported, in which
+ * case the layer becomes the terminal problem.
+ */
+static int transform_compiled_compile_layer(transform_compiled_data_t *data, coco_problem_t *layer) {
+  transform_compiled_operation_t *operation;
+  const size_t n = layer->number_of_variables;
+  size_t i;
+
+  if (layer->number_of_constraints > 0 || layer->is_noisy)
+    return 0;
+
+  if (layer->evaluate_function == coco_problem_transformed_evaluate_function) {
+    /* Layers that only pass the evaluation through need no operation */
+    return 1;
+  } else if (layer->evaluate_function == transform_vars_shift_evaluate_function) {
+    transform_vars_shift_data_t *d = (transform_vars_shift_data_t *)coco_problem_transformed_get_data(layer);
+    operation = transform_compiled_add(data, TRANSFORM_COMPILED_VARS_SHIFT, layer);
+    operation->vector = d->offset;
+  } else if (layer->evaluate_function == transform_vars_affine_evaluate_function) {
+    transform_vars_affine_data_t *d = (transform_vars_affine_data_t *)coco_problem_transformed_get_data(layer);
+    operation = transform_compiled_add(data, TRANSFORM_COMPILED_VARS_AFFINE, layer);
+    operation->vector = d->b;
+    operation->matrix = d->M;
+  } else if (layer->evaluate_function == transform_vars_oscillate_evaluate_function) {
+    transform_vars_oscillate_data_t *d =
+        (transform_vars_oscillate_data_t *)coco_problem_transformed_get_data(layer);
+    operation = transform_compiled_add(data, TRANSFORM_COMPILED_VARS_OSCILLATE, layer);
+    operation->value = d->alpha;
+  } else if (layer->evaluate_function == transform_vars_asymmetric_evaluate_function) {
+    transform_vars_asymmetric_data_t *d =
+        (transform_vars_asymmetric_data_t *)coco_problem_transformed_get_data(layer);
+    operation = transform_compiled_add(data, TRANSFORM_COMPILED_VARS_ASYMMETRIC, layer);
+    operation->value = d->beta;
+  } else if (layer->evaluate_function == transform_vars_conditioning_evaluate) {
+    transform_vars_conditioning_data_t *d =
+        (transform_vars_conditioning_data_t *)coco_problem_transformed_get_data(layer);
+    operation = transform_compiled_add(data, TRANSFORM_COMPILED_VARS_MULTIPLY, layer);
+    operation->vector = d->coefficients;
+  } else if (layer->evaluate_function == transform_vars_x_hat_evaluate) {
+    transform_vars_x_hat_data_t *d = (transform_vars_x_hat_data_t *)coco_problem_transformed_get_data(layer);
+    operation = transform_compiled_add(data, TRANSFORM_COMPILED_VARS_MULTIPLY, layer);
+    operation->coefficients = coco_allocate_vector(n);
+    bbob2009_unif(operation->coefficients, n, d->seed);
+    for (i = 0; i < n; ++i)
+      operation->coefficients[i] = (operation->coefficients[i] < 0.5) ? -1.0 : 1.0;
+    operation->vector = operation->coefficients;
+  } else if (layer->evaluate_function == transform_vars_scale_evaluate) {
+    transform_vars_scale_data_t *d = (transform_vars_scale_data_t *)coco_problem_transformed_get_data(layer);
+    operation = transform_compiled_add(data, TRANSFORM_COMPILED_VARS_SCALE, layer);
+    operation->value = d->factor;
+  } else if (layer->evaluate_function == transform_vars_brs_evaluate) {
+    transform_vars_brs_data_t *d = (transform_vars_brs_data_t *)coco_problem_transformed_get_data(layer);
+    operation = transform_compiled_add(data, TRANSFORM_COMPILED_VARS_BRS, layer);
+    operation->vector = d->factors;
+  } else if (layer->evaluate_function == transform_vars_z_hat_evaluate) {
+    transform_vars_z_hat_data_t *d = (transform_vars_z_hat_data_t *)coco_problem_transformed_get_data(layer);
+    operation = transform_compiled_add(data, TRANSFORM_COMPILED_VARS_Z_HAT, layer);
+    operation->vector = d->xopt;
+  } else if (layer->evaluate_function == transform_obj_shift_evaluate_function) {
+    transform_obj_shift_data_t *d = (transform_obj_shift_data_t *)coco_problem_transformed_get_data(layer);
+    operation = transform_compiled_add(data, TRANSFORM_COMPILED_OBJ_SHIFT, layer);
+    operation->value = d->offset;
+  } else if (layer->evaluate_function == transform_obj_scale_evaluate_function) {
+    transform_obj_scale_data_t *d = (transform_obj_scale_data_t *)coco_problem_transformed_get_data(layer);
+    operation = transform_compiled_add(data, TRANSFORM_COMPILED_OBJ_SCALE, layer);
+    operation->value = d->factor;
+  } else if (layer->evaluate_function == transform_obj_norm_by_dim_evaluate) {
+    operation = transform_compiled_add(data, TRANSFORM_COMPILED_OBJ_SCALE, layer);
+    operation->value = bbob2009_fmin(1, 40. / ((double)n));
+  } else if (layer->evaluate_function == transform_obj_power_evaluate) {
+    transform_obj_power_data_t *d = (transform_obj_power_data_t *)coco_problem_transformed_get_data(layer);
+    operation = transform_compiled_add(data, TRANSFORM_COMPILED_OBJ_POWER, layer);
+    operation->value = d->exponent;
+  } else if (layer->evaluate_function == transform_obj_oscillate_evaluate) {
+    transform_compiled_add(data, TRANSFORM_COMPILED_OBJ_OSCILLATE, layer);
+  } else if (layer->evaluate_function == transform_obj_penalize_evaluate) {
+    transform_obj_penalize_data_t *d = (transform_obj_penalize_data_t *)coco_problem_transformed_get_data(layer);
+    operation = transform_compiled_add(data, TRANSFORM_COMPILED_OBJ_PENALIZE, layer);
+    operation->value = d->factor;
+  } else {
+    return 0;
+  }
+  return 1;
+}
+
+/**
+ * @brief Applies the operation on the decision vector x and returns the resulting decision vector.
+ *
+ * The result is stored in one of the scratch vectors. Coordinate-wise operations work in place if x is
+ * already a scratch vector.
+ */
+static const double *transform_compiled_apply_vars(transform_compiled_data_t *data,
+                                                   transform_compiled_operation_t *operation, const double *x) {
+  coco_problem_t *layer = operation->layer;
+  const size_t n = layer->number_of_variables;
+  double *result = (x == data->x1) ? data->x1 : data->x2;
+  size_t i, j;
+
+  switch (operation->type) {
+  case TRANSFORM_COMPILED_VARS_SHIFT:
+    for (i = 0; i < n; ++i)
+      result[i] = x[i] - operation->vector[i];
+    break;
+  case TRANSFORM_COMPILED_VARS_AFFINE: {
+    const size_t inner_n = coco_problem_transformed_get_inner_problem(layer)->number_of_variables;
+    result = (x == data->x1) ? data->x2 : data->x1;
+    for (i = 0; i < inner_n; ++i) {
+      const double *current_row = operation->matrix + i * n;
+      result[i] = operation->vector[i];
+      for (j = 0; j < n; ++j) {
+        result[i] += x[j] * current_row[j];
+      }
+    }
+    break;
+  }
+  case TRANSFORM_COMPILED_VARS_OSCILLATE: {
+    tosz_data d;
+    if (COCO_SIMD_RUN(tosz_simd, (x, result, n, operation->value)))
+      break;
+    d.alpha = operation->value;
+    for (i = 0; i < n; ++i)
+      result[i] = tosz_uv(x[i], &d);
+    break;
+  }
+  case TRANSFORM_COMPILED_VARS_ASYMMETRIC: {
+    tasy_data d;
+    if (COCO_SIMD_RUN(tasy_simd, (x, result, n, operation->value)))
+      break;
+    d.beta = operation->value;
+    d.n = n;
+    for (i = 0; i < n; ++i) {
+      d.i = i;
+      result[i] = tasy_uv(x[i], &d);
+    }
+    break;
+  }
+  case TRANSFORM_COMPILED_VARS_MULTIPLY:
+    for (i = 0; i < n; ++i)
+      result[i] = operation->vector[i] * x[i];
+    break;
+  case TRANSFORM_COMPILED_VARS_SCALE:
+    for (i = 0; i < n; ++i)
+      result[i] = operation->value * x[i];
+    break;
+  case TRANSFORM_COMPILED_VARS_BRS:
+    for (i = 0; i < n; ++i) {
+      double factor = operation->vector[i];
+      if (x[i] > 0.0 && i % 2 == 0) {
+        factor *= 10.0;
+      }
+      result[i] = factor * x[i];
+    }
+    break;
+  case TRANSFORM_COMPILED_VARS_Z_HAT:
+    /* Backwards, so that x[i - 1] is still unchanged when working in place */
+    for (i = n - 1; i > 0; --i)
+      result[i] = x[i] + 0.25 * (x[i - 1] - 2.0 * fabs(operation->vector[i - 1]));
+    result[0] = x[0];
+    break;
+  case TRANSFORM_COMPILED_OBJ_PENALIZE:
+    operation->penalty = transform_obj_penalize_compute_penalty(layer, x);
+    return x;
+  default:
+    /* Operations on the objective vector leave x unchanged */
+    return x;
+  }
+  return result;
+}
+
+/**
+ * @brief Applies the operation on the objective vector y in place.
+ */
+static void transform_compiled_apply_obj(transform_compiled_operation_t *operation, double *y) {
+  const size_t number_of_objectives = operation->layer->number_of_objectives;
+  size_t i;
+
+  switch (operation->type) {
+  case TRANSFORM_COMPILED_OBJ_SHIFT:
+    for (i = 0; i < number_of_objectives; i++)
+      y[i] += operation->value;
+    break;
+  case TRANSFORM_COMPILED_OBJ_SCALE:
+    for (i = 0; i < number_of_objectives; i++)
+      y[i] *= operation->value;
+    break;
+  case TRANSFORM_COMPILED_OBJ_POWER:
+    for (i = 0; i < number_of_objectives; i++)
+      y[i] = pow(y[i], operation->value);
+    break;
+  case TRANSFORM_COMPILED_OBJ_OSCILLATE:
+    for (i = 0; i < number_of_objectives; i++)
+      y[i] = transform_obj_oscillate_value(y[i]);
+    break;
+  case TRANSFORM_COMPILED_OBJ_PENALIZE:
+    for (i = 0; i < number_of_objectives; i++)
+      y[i] += operation->value * operation->penalty;
+    break;
+  default:
+    /* Operations on the decision vector leave y unchanged */
+    break;
+  }
+}
+
+/**
+ * @brief Checks the input of a layer for INFINITY and NAN values as coco_evaluate_function would do.
+ *
+ * Returns 1 and sets y accordingly if the evaluation of the layer stops here.
+ */
+static int transform_compiled_check_input(const coco_problem_t *layer, const double *x, double *y) {
+  size_t i, j;
+
+  if (coco_vector_isfinite(x, layer->number_of_variables))
+    return 0;
+  for (i = 0; i < layer->number_of_variables; i++) {
+    if (coco_is_inf(x[i])) {
+      for (j = 0; j < layer->number_of_objectives; j++) {
+        y[j] = fabs(x[i]);
+      }
+      return 1;
+    }
+  }
+  if (coco_vector_contains_nan(x, layer->number_of_variables)) {
+    coco_vector_set_to_nan(y, layer->number_of_objectives);
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Evaluates the compiled operations.
+ */
+static void transform_compiled_evaluate(coco_problem_t *problem, const double *x, double *y) {
+  transform_compiled_data_t *data = (transform_compiled_data_t *)coco_problem_transformed_get_data(problem);
+  const double *current_x = x;
+  size_t i, number_of_applied;
+
+  if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
+    coco_vector_set_to_nan(y, coco_problem_get_number_of_objectives(problem));
+    return;
+  }
+
+  /* On the way in, the input of each layer (but the first, which was checked by the caller) is checked
+   * as in the original chain of coco_evaluate_function calls */
+  for (number_of_applied = 0; number_of_applied < data->number_of_operations; number_of_applied++) {
+    transform_compiled_operation_t *operation = &data->operations[number_of_applied];
+    if (number_of_applied > 0 && transform_compiled_check_input(operation->layer, current_x, y))
+      break;
+    current_x = transform_compiled_apply_vars(data, operation, current_x);
+  }
+  if (number_of_applied == data->number_of_operations) {
+    if (data->terminal_is_transformed) {
+      coco_evaluate_function(data->terminal_problem, current_x, y);
+    } else if (!transform_compiled_check_input(data->terminal_problem, current_x, y)) {
+      /* Basic problems are evaluated directly, as nobody looks at their counters */
+      data->terminal_problem->evaluate_function(data->terminal_problem, current_x, y);
+    }
+  }
+
+  /* On the way out */
+  for (i = number_of_applied; i > 0; i--)
+    transform_compiled_apply_obj(&data->operations[i - 1], y);
+
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
+/**
+ * @brief Evaluates the function and its gradient with the original chain of layers, which implement the
+ * reverse pass.
+ */
+static void transform_compiled_evaluate_function_and_gradient(coco_problem_t *problem, const double *x,
+                                                              double *y, double *gradient) {
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), x, y, gradient);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
+/**
+ * @brief Frees the data object.
+ */
+static void transform_compiled_free(void *thing) {
+  transform_compiled_data_t *data = (transform_compiled_data_t *)thing;
+  size_t i;
+  for (i = 0; i < data->number_of_operations; i++) {
+    if (data->operations[i].coefficients != NULL)
+      coco_free_memory(data->operations[i].coefficients);
+  }
+  coco_free_memory(data->operations);
+  coco_free_memory(data->x1);
+  coco_free_memory(data->x2);
+}
+
+/**
+ * @brief Creates the transformation.
+ *
+ * Returns the inner problem unchanged if less than two of its layers can be compiled.
+ */
+static coco_problem_t *transform_compiled(coco_problem_t *inner_problem) {
+  transform_compiled_data_t *data;
+  coco_problem_t *problem, *layer;
+  size_t number_of_layers = 0, max_number_of_variables = 0;
+
+  /* Count the layers to know how much memory is needed */
+  for (layer = inner_problem; layer->problem_free_function == coco_problem_transformed_free;
+       layer = coco_problem_transformed_get_inner_problem(layer)) {
+    number_of_layers++;
+  }
+
+  data = (transform_compiled_data_t *)coco_allocate_memory(sizeof(*data));
+  data->operations = (transform_compiled_operation_t *)coco_allocate_memory((number_of_layers + 1) *
+                                                                            sizeof(transform_compiled_operation_t));
+  data->number_of_operations = 0;
+
+  for (layer = inner_problem; layer->problem_free_function == coco_problem_transformed_free;
+       layer = coco_problem_transformed_get_inner_problem(layer)) {
+    if (!transform_compiled_compile_layer(data, layer))
+      break;
+    if (layer->number_of_variables > max_number_of_variables)
+      max_number_of_variables = layer->number_of_variables;
+  }
+  data->terminal_problem = layer;
+  data->terminal_is_transformed = (layer->problem_free_function == coco_problem_transformed_free);
+  if (layer->number_of_variables > max_number_of_variables)
+    max_number_of_variables = layer->number_of_variables;
+
+  data->x1 = coco_allocate_vector(max_number_of_variables);
+  data->x2 = coco_allocate_vector(max_number_of_variables);
+
+  if (data->number_of_operations < 2) {
+    transform_compiled_free(data);
+    coco_free_memory(data);
+    return inner_problem;
+  }
+
+  problem = coco_problem_transformed_allocate(inner_problem, data, transform_compiled_free, "transform_compiled");
+  problem->evaluate_function = transform_compiled_evaluate;
+  problem->evaluate_function_batch = coco_problem_evaluate_function_batch_by_loop;
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_compiled_evaluate_function_and_gradient;
+  /* The compiled problem is transparent to the outside */
+  coco_problem_set_name(problem, "%s", inner_problem->problem_name);
+
+  return problem;
+}
@@ -11,6 +11,7 @@
 typedef struct {
   double alpha;
   double p;
+  coco_noise_stream_t stream;
 } transform_obj_cauchy_noise_data_t;
 
 /**
@@ -21,9 +22,9 @@ static void transform_obj_cauchy_noise_evaluate_function(coco_problem_t *problem
   transform_obj_cauchy_noise_data_t *data;
   data = (transform_obj_cauchy_noise_data_t *)coco_problem_transformed_get_data(problem);
   double uniform_indicator, numerator_normal_variate, denominator_normal_variate;
-  uniform_indicator = coco_sample_uniform_noise();
-  numerator_normal_variate = coco_sample_gaussian_noise();
-  denominator_normal_variate = coco_sample_gaussian_noise();
+  uniform_indicator = coco_noise_stream_sample_uniform(&data->stream);
+  numerator_normal_variate = coco_noise_stream_sample_gaussian(&data->stream);
+  denominator_normal_variate = coco_noise_stream_sample_gaussian(&data->stream);
   denominator_normal_variate = fabs(denominator_normal_variate + 1e-199);
   double cauchy_noise = numerator_normal_variate / (denominator_normal_variate);
   cauchy_noise = uniform_indicator < data->p ? 1e3 + cauchy_noise : 1e3;
@@ -39,13 +40,17 @@ static void transform_obj_cauchy_noise_evaluate_function(coco_problem_t *problem
 
 /**
  * @brief Allocates a noisy problem with cauchy noise.
+ *
+ * If legacy_noise is nonzero, the noise reproduces the sequence of the legacy code (see coco_noise_stream_t).
  */
-static coco_problem_t *transform_obj_cauchy_noise(coco_problem_t *inner_problem, const double alpha, const double p) {
+static coco_problem_t *transform_obj_cauchy_noise(coco_problem_t *inner_problem, const double alpha, const double p,
+                                                  const int legacy_noise) {
   coco_problem_t *problem;
   transform_obj_cauchy_noise_data_t *data;
   data = (transform_obj_cauchy_noise_data_t *)coco_allocate_memory(sizeof(*data));
   data->alpha = alpha;
   data->p = p;
+  coco_noise_stream_init(&data->stream, inner_problem->problem_id, legacy_noise);
   problem = coco_problem_transformed_allocate(inner_problem, data, NULL, "cauchy_noise_model");
   problem->evaluate_function = transform_obj_cauchy_noise_evaluate_function;
   problem->is_noisy = 1;
@@ -10,6 +10,7 @@
  */
 typedef struct {
   double beta;
+  coco_noise_stream_t stream;
 } transform_obj_gaussian_noise_data_t;
 
 /**
@@ -20,7 +21,7 @@ static void transform_obj_gaussian_noise_evaluate_function(coco_problem_t *probl
   double fopt = *(inner_problem->best_value);
   transform_obj_gaussian_noise_data_t *data;
   data = (transform_obj_gaussian_noise_data_t *)coco_problem_transformed_get_data(problem);
-  double gaussian_noise = coco_sample_gaussian_noise();
+  double gaussian_noise = coco_noise_stream_sample_gaussian(&data->stream);
   gaussian_noise = exp(data->beta * gaussian_noise);
   double tol = 1e-8;
   inner_problem->evaluate_function(inner_problem, x, y);
@@ -34,12 +35,16 @@ static void transform_obj_gaussian_noise_evaluate_function(coco_problem_t *probl
 
 /**
  * @brief Allocates a noisy problem with gaussian noise.
+ *
+ * If legacy_noise is nonzero, the noise reproduces the sequence of the legacy code (see coco_noise_stream_t).
  */
-static coco_problem_t *transform_obj_gaussian_noise(coco_problem_t *inner_problem, const double beta) {
+static coco_problem_t *transform_obj_gaussian_noise(coco_problem_t *inner_problem, const double beta,
+                                                    const int legacy_noise) {
   coco_problem_t *problem;
   transform_obj_gaussian_noise_data_t *data;
   data = (transform_obj_gaussian_noise_data_t *)coco_allocate_memory(sizeof(*data));
   data->beta = beta;
+  coco_noise_stream_init(&data->stream, inner_problem->problem_id, legacy_noise);
   problem = coco_problem_transformed_allocate(inner_problem, data, NULL, "gaussian_noise_model");
   problem->evaluate_function = transform_obj_gaussian_noise_evaluate_function;
   problem->is_noisy = 1;
@@ -21,6 +21,36 @@ static void transform_obj_norm_by_dim_evaluate(coco_problem_t *problem, const do
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformation.
+ */
+static void transform_obj_norm_by_dim_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  const double factor = bbob2009_fmin(1, 40. / ((double)problem->number_of_variables));
+  size_t i;
+
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), x, y);
+  for (i = 0; i < problem->number_of_variables; i++) {
+    y[i] *= factor;
+  }
+}
+
+/**
+ * @brief Evaluates the transformation and its gradient.
+ */
+static void transform_obj_norm_by_dim_evaluate_function_and_gradient(coco_problem_t *problem, const double *x,
+                                                                     double *y, double *gradient) {
+  const double factor = bbob2009_fmin(1, 40. / ((double)problem->number_of_variables));
+  size_t i;
+
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), x, y, gradient);
+  y[0] *= factor;
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+
+  for (i = 0; i < problem->number_of_variables; i++) {
+    gradient[i] *= factor;
+  }
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -29,5 +59,8 @@ static coco_problem_t *transform_obj_norm_by_dim(coco_problem_t *inner_problem)
 
   problem = coco_problem_transformed_allocate(inner_problem, NULL, NULL, "transform_obj_norm_by_dim");
   problem->evaluate_function = transform_obj_norm_by_dim_evaluate;
+  problem->evaluate_gradient = transform_obj_norm_by_dim_evaluate_gradient;
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_obj_norm_by_dim_evaluate_function_and_gradient;
   return problem;
 }
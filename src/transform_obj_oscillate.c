@@ -8,12 +8,29 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "transform_vars_oscillate.c"
+
+/**
+ * @brief Oscillates a single objective value.
+ */
+static double transform_obj_oscillate_value(const double y) {
+  static const double factor = 0.1;
+  double log_y;
+
+  if (y == 0)
+    return y;
+  log_y = log(fabs(y)) / factor;
+  if (y > 0) {
+    return pow(exp(log_y + 0.49 * (sin(log_y) + sin(0.79 * log_y))), factor);
+  } else {
+    return -pow(exp(log_y + 0.49 * (sin(0.55 * log_y) + sin(0.31 * log_y))), factor);
+  }
+}
 
 /**
  * @brief Evaluates the transformation.
  */
 static void transform_obj_oscillate_evaluate(coco_problem_t *problem, const double *x, double *y) {
-  static const double factor = 0.1;
   size_t i;
 
   if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
@@ -23,16 +40,49 @@ static void transform_obj_oscillate_evaluate(coco_problem_t *problem, const doub
   coco_evaluate_function(coco_problem_transformed_get_inner_problem(problem), x, y);
 
   for (i = 0; i < problem->number_of_objectives; i++) {
-    if (y[i] != 0) {
-      double log_y;
-      log_y = log(fabs(y[i])) / factor;
-      if (y[i] > 0) {
-        y[i] = pow(exp(log_y + 0.49 * (sin(log_y) + sin(0.79 * log_y))), factor);
-      } else {
-        y[i] = -pow(exp(log_y + 0.49 * (sin(0.55 * log_y) + sin(0.31 * log_y))), factor);
-      }
-    }
+    y[i] = transform_obj_oscillate_value(y[i]);
+  }
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
+/**
+ * @brief Evaluates the gradient of the transformation, which is the gradient of the inner function times the
+ * derivative of the oscillation at the inner function value.
+ */
+static void transform_obj_oscillate_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  double value, derivative;
+  tosz_data d;
+  size_t i;
+
+  assert(problem->number_of_objectives == 1);
+  coco_evaluate_function(inner_problem, x, &value);
+  bbob_evaluate_gradient(inner_problem, x, y);
+
+  d.alpha = 0.1;
+  derivative = tosz_uv_derivative(value, &d);
+  for (i = 0; i < problem->number_of_variables; i++) {
+    y[i] *= derivative;
+  }
+}
+
+/**
+ * @brief Evaluates the transformation and its gradient, which reuses the inner function value.
+ */
+static void transform_obj_oscillate_evaluate_function_and_gradient(coco_problem_t *problem, const double *x,
+                                                                   double *y, double *gradient) {
+  double derivative;
+  tosz_data d;
+  size_t i;
+
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), x, y, gradient);
+
+  d.alpha = 0.1;
+  derivative = tosz_uv_derivative(y[0], &d);
+  for (i = 0; i < problem->number_of_variables; i++) {
+    gradient[i] *= derivative;
   }
+  y[0] = transform_obj_oscillate_value(y[0]);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
@@ -43,6 +93,9 @@ static coco_problem_t *transform_obj_oscillate(coco_problem_t *inner_problem) {
   coco_problem_t *problem;
   problem = coco_problem_transformed_allocate(inner_problem, NULL, NULL, "transform_obj_oscillate");
   problem->evaluate_function = transform_obj_oscillate_evaluate;
+  problem->evaluate_gradient = transform_obj_oscillate_evaluate_gradient;
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_obj_oscillate_evaluate_function_and_gradient;
   /* Compute best value */
   /* Maybe not the most efficient solution */
   transform_obj_oscillate_evaluate(problem, problem->best_parameter, problem->best_value);
@@ -17,20 +17,14 @@ typedef struct {
 } transform_obj_penalize_data_t;
 
 /**
- * @brief Evaluates the transformation.
+ * @brief Computes the penalty of x, i.e. the sum of the squared distances to the ROI of its coordinates.
  */
-static void transform_obj_penalize_evaluate(coco_problem_t *problem, const double *x, double *y) {
-  transform_obj_penalize_data_t *data = (transform_obj_penalize_data_t *)coco_problem_transformed_get_data(problem);
+static double transform_obj_penalize_compute_penalty(const coco_problem_t *problem, const double *x) {
   const double *lower_bounds = problem->smallest_values_of_interest;
   const double *upper_bounds = problem->largest_values_of_interest;
   double penalty = 0.0;
   size_t i;
 
-  if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
-    coco_vector_set_to_nan(y, coco_problem_get_number_of_objectives(problem));
-    return;
-  }
-
   for (i = 0; i < problem->number_of_variables; ++i) {
     const double c1 = x[i] - upper_bounds[i];
     const double c2 = lower_bounds[i] - x[i];
@@ -41,6 +35,23 @@ static void transform_obj_penalize_evaluate(coco_problem_t *problem, const doubl
       penalty += c2 * c2;
     }
   }
+  return penalty;
+}
+
+/**
+ * @brief Evaluates the transformation.
+ */
+static void transform_obj_penalize_evaluate(coco_problem_t *problem, const double *x, double *y) {
+  transform_obj_penalize_data_t *data = (transform_obj_penalize_data_t *)coco_problem_transformed_get_data(problem);
+  double penalty;
+  size_t i;
+
+  if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
+    coco_vector_set_to_nan(y, coco_problem_get_number_of_objectives(problem));
+    return;
+  }
+
+  penalty = transform_obj_penalize_compute_penalty(problem, x);
   assert(coco_problem_transformed_get_inner_problem(problem) != NULL);
   coco_evaluate_function(coco_problem_transformed_get_inner_problem(problem), x, y);
 
@@ -50,6 +61,56 @@ static void transform_obj_penalize_evaluate(coco_problem_t *problem, const doubl
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformation.
+ */
+static void transform_obj_penalize_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  transform_obj_penalize_data_t *data = (transform_obj_penalize_data_t *)coco_problem_transformed_get_data(problem);
+  const double *lower_bounds = problem->smallest_values_of_interest;
+  const double *upper_bounds = problem->largest_values_of_interest;
+  size_t i;
+
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), x, y);
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    const double c1 = x[i] - upper_bounds[i];
+    const double c2 = lower_bounds[i] - x[i];
+    if (c1 > 0.0) {
+      y[i] += 2.0 * data->factor * c1;
+    } else if (c2 > 0.0) {
+      y[i] -= 2.0 * data->factor * c2;
+    }
+  }
+}
+
+/**
+ * @brief Evaluates the transformation and its gradient.
+ */
+static void transform_obj_penalize_evaluate_function_and_gradient(coco_problem_t *problem, const double *x,
+                                                                  double *y, double *gradient) {
+  transform_obj_penalize_data_t *data = (transform_obj_penalize_data_t *)coco_problem_transformed_get_data(problem);
+  const double *lower_bounds = problem->smallest_values_of_interest;
+  const double *upper_bounds = problem->largest_values_of_interest;
+  double penalty = 0.0;
+  size_t i;
+
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), x, y, gradient);
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    const double c1 = x[i] - upper_bounds[i];
+    const double c2 = lower_bounds[i] - x[i];
+    if (c1 > 0.0) {
+      penalty += c1 * c1;
+      gradient[i] += 2.0 * data->factor * c1;
+    } else if (c2 > 0.0) {
+      penalty += c2 * c2;
+      gradient[i] -= 2.0 * data->factor * c2;
+    }
+  }
+  y[0] += data->factor * penalty;
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -62,6 +123,9 @@ static coco_problem_t *transform_obj_penalize(coco_problem_t *inner_problem, con
   data->factor = factor;
   problem = coco_problem_transformed_allocate(inner_problem, data, NULL, "transform_obj_penalize");
   problem->evaluate_function = transform_obj_penalize_evaluate;
+  problem->evaluate_gradient = transform_obj_penalize_evaluate_gradient;
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_obj_penalize_evaluate_function_and_gradient;
   /* No need to update the best value as the best parameter is feasible */
   return problem;
 }
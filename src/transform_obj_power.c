@@ -37,6 +37,64 @@ static void transform_obj_power_evaluate(coco_problem_t *problem, const double *
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformation in a batch of points.
+ */
+static void transform_obj_power_evaluate_batch(coco_problem_t *problem, const double *x, double *y,
+                                               const size_t number_of_points) {
+  transform_obj_power_data_t *data;
+  size_t i;
+
+  data = (transform_obj_power_data_t *)coco_problem_transformed_get_data(problem);
+  coco_evaluate_function_batch(coco_problem_transformed_get_inner_problem(problem), x, y, number_of_points);
+
+  for (i = 0; i < number_of_points * problem->number_of_objectives; i++) {
+    y[i] = pow(y[i], data->exponent);
+  }
+  for (i = 0; i < number_of_points; i++)
+    assert(y[i * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+}
+
+/**
+ * @brief Evaluates the gradient of the transformation with the chain rule.
+ */
+static void transform_obj_power_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  transform_obj_power_data_t *data;
+  double value, derivative;
+  size_t i;
+
+  assert(problem->number_of_objectives == 1);
+  data = (transform_obj_power_data_t *)coco_problem_transformed_get_data(problem);
+  coco_evaluate_function(inner_problem, x, &value);
+  bbob_evaluate_gradient(inner_problem, x, y);
+
+  derivative = data->exponent * pow(value, data->exponent - 1.0);
+  for (i = 0; i < problem->number_of_variables; i++) {
+    y[i] *= derivative;
+  }
+}
+
+/**
+ * @brief Evaluates the transformation and its gradient, which reuses the inner function value.
+ */
+static void transform_obj_power_evaluate_function_and_gradient(coco_problem_t *problem, const double *x, double *y,
+                                                               double *gradient) {
+  transform_obj_power_data_t *data;
+  double derivative;
+  size_t i;
+
+  data = (transform_obj_power_data_t *)coco_problem_transformed_get_data(problem);
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), x, y, gradient);
+
+  derivative = data->exponent * pow(y[0], data->exponent - 1.0);
+  for (i = 0; i < problem->number_of_variables; i++) {
+    gradient[i] *= derivative;
+  }
+  y[0] = pow(y[0], data->exponent);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -49,6 +107,10 @@ static coco_problem_t *transform_obj_power(coco_problem_t *inner_problem, const
 
   problem = coco_problem_transformed_allocate(inner_problem, data, NULL, "transform_obj_power");
   problem->evaluate_function = transform_obj_power_evaluate;
+  problem->evaluate_function_batch = transform_obj_power_evaluate_batch;
+  problem->evaluate_gradient = transform_obj_power_evaluate_gradient;
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_obj_power_evaluate_function_and_gradient;
   /* Compute best value */
   transform_obj_power_evaluate(problem, problem->best_parameter, problem->best_value);
   return problem;
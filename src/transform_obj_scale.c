@@ -20,7 +20,6 @@ typedef struct {
  */
 static void transform_obj_scale_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
   transform_obj_scale_data_t *data;
-  double *cons_values;
   int is_feasible;
   size_t i;
 
@@ -36,15 +35,31 @@ static void transform_obj_scale_evaluate_function(coco_problem_t *problem, const
     y[i] *= data->factor;
 
   if (problem->number_of_constraints > 0) {
-    cons_values = coco_allocate_vector(problem->number_of_constraints);
-    is_feasible = coco_is_feasible(problem, x, cons_values);
-    coco_free_memory(cons_values);
+    is_feasible = coco_is_feasible(problem, x, NULL);
     if (is_feasible)
       assert(y[0] + 1e-13 >= problem->best_value[0]);
   } else
     assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformed function in a batch of points.
+ */
+static void transform_obj_scale_evaluate_function_batch(coco_problem_t *problem, const double *x, double *y,
+                                                        const size_t number_of_points) {
+  transform_obj_scale_data_t *data;
+  size_t i;
+
+  data = (transform_obj_scale_data_t *)coco_problem_transformed_get_data(problem);
+  coco_evaluate_function_batch(coco_problem_transformed_get_inner_problem(problem), x, y, number_of_points);
+
+  for (i = 0; i < number_of_points * problem->number_of_objectives; i++)
+    y[i] *= data->factor;
+
+  for (i = 0; i < number_of_points; i++)
+    assert(y[i * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Evaluates the gradient of the transformed function at x
  */
@@ -65,6 +80,22 @@ static void transform_obj_scale_evaluate_gradient(coco_problem_t *problem, const
   }
 }
 
+/**
+ * @brief Evaluates the transformed function and its gradient at x.
+ */
+static void transform_obj_scale_evaluate_function_and_gradient(coco_problem_t *problem, const double *x, double *y,
+                                                               double *gradient) {
+  transform_obj_scale_data_t *data = (transform_obj_scale_data_t *)coco_problem_transformed_get_data(problem);
+  size_t i;
+
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), x, y, gradient);
+  y[0] *= data->factor;
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    gradient[i] *= data->factor;
+  }
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -80,8 +111,14 @@ static coco_problem_t *transform_obj_scale(coco_problem_t *inner_problem, const
   if (inner_problem->number_of_objectives > 0)
     problem->evaluate_function = transform_obj_scale_evaluate_function;
 
+  if (inner_problem->number_of_objectives > 0 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_batch = transform_obj_scale_evaluate_function_batch;
+
   problem->evaluate_gradient = transform_obj_scale_evaluate_gradient;
 
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_obj_scale_evaluate_function_and_gradient;
+
   for (i = 0; i < problem->number_of_objectives; ++i)
     problem->best_value[i] *= factor;
 
@@ -11,6 +11,7 @@
 typedef struct {
   double alpha;
   double beta;
+  coco_noise_stream_t stream;
 } transform_obj_uniform_noise_data_t;
 
 /**
@@ -22,8 +23,8 @@ static void transform_obj_uniform_noise_evaluate_function(coco_problem_t *proble
   double fopt = *(inner_problem->best_value);
   transform_obj_uniform_noise_data_t *data;
   data = (transform_obj_uniform_noise_data_t *)coco_problem_transformed_get_data(problem);
-  uniform_noise_term1 = coco_sample_uniform_noise();
-  uniform_noise_term2 = coco_sample_uniform_noise();
+  uniform_noise_term1 = coco_noise_stream_sample_uniform(&data->stream);
+  uniform_noise_term2 = coco_noise_stream_sample_uniform(&data->stream);
   double uniform_noise_factor = pow(uniform_noise_term1, data->beta);
   inner_problem->evaluate_function(inner_problem, x, y);
   for (size_t i = 0; i < problem->number_of_objectives; i++) {
@@ -41,14 +42,17 @@ static void transform_obj_uniform_noise_evaluate_function(coco_problem_t *proble
 
 /**
  * @brief Allocates a noisy problem with uniform noise.
+ *
+ * If legacy_noise is nonzero, the noise reproduces the sequence of the legacy code (see coco_noise_stream_t).
  */
 static coco_problem_t *transform_obj_uniform_noise(coco_problem_t *inner_problem, const double alpha,
-                                                   const double beta) {
+                                                   const double beta, const int legacy_noise) {
   coco_problem_t *problem;
   transform_obj_uniform_noise_data_t *data;
   data = (transform_obj_uniform_noise_data_t *)coco_allocate_memory(sizeof(*data));
   data->alpha = alpha;
   data->beta = beta;
+  coco_noise_stream_init(&data->stream, inner_problem->problem_id, legacy_noise);
   problem = coco_problem_transformed_allocate(inner_problem, data, NULL, "uniform_noise_model");
   problem->evaluate_function = transform_obj_uniform_noise_evaluate_function;
   problem->is_noisy = 1;
@@ -15,12 +15,15 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_cache.c"
 
 /**
  * @brief Data type for transform_vars_affine.
  */
 typedef struct {
-  double *M, *b, *x;
+  const double *M; /**< @brief Either M_copy or data from the instance cache (see coco_cache.c) */
+  double *M_copy;  /**< @brief The copy of M if it is not cached and NULL otherwise */
+  double *b, *x;
 } transform_vars_affine_data_t;
 
 /**
@@ -28,7 +31,6 @@ typedef struct {
  */
 static void transform_vars_affine_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
   size_t i, j;
-  double *cons_values;
   int is_feasible;
   transform_vars_affine_data_t *data;
   coco_problem_t *inner_problem;
@@ -53,15 +55,48 @@ static void transform_vars_affine_evaluate_function(coco_problem_t *problem, con
   coco_evaluate_function(inner_problem, data->x, y);
 
   if (problem->number_of_constraints > 0) {
-    cons_values = coco_allocate_vector(problem->number_of_constraints);
-    is_feasible = coco_is_feasible(problem, x, cons_values);
-    coco_free_memory(cons_values);
+    is_feasible = coco_is_feasible(problem, x, NULL);
     if (is_feasible)
       assert(y[0] + 1e-13 >= problem->best_value[0]);
   } else
     assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformed objective function in a batch of points.
+ */
+static void transform_vars_affine_evaluate_function_batch(coco_problem_t *problem, const double *x, double *y,
+                                                          const size_t number_of_points) {
+  size_t i, j, k;
+  const size_t n = problem->number_of_variables;
+  transform_vars_affine_data_t *data;
+  coco_problem_t *inner_problem;
+  double *transformed_x;
+
+  data = (transform_vars_affine_data_t *)coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  transformed_x =
+      coco_problem_transformed_get_batch_buffer(problem, number_of_points * inner_problem->number_of_variables);
+
+  for (k = 0; k < number_of_points; ++k) {
+    const double *current_x = x + k * n;
+    double *current_transformed_x = transformed_x + k * inner_problem->number_of_variables;
+    for (i = 0; i < inner_problem->number_of_variables; ++i) {
+      /* data->M has problem->number_of_variables columns and inner_problem->number_of_variables rows. */
+      const double *current_row = data->M + i * n;
+      current_transformed_x[i] = data->b[i];
+      for (j = 0; j < n; ++j) {
+        current_transformed_x[i] += current_x[j] * current_row[j];
+      }
+    }
+  }
+
+  coco_evaluate_function_batch(inner_problem, transformed_x, y, number_of_points);
+
+  for (k = 0; k < number_of_points; ++k)
+    assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Evaluates the transformed constraint.
  */
@@ -87,31 +122,17 @@ static void transform_vars_affine_evaluate_constraint(coco_problem_t *problem, c
       data->x[i] += x[j] * current_row[j];
     }
   }
-  inner_problem->evaluate_constraint(inner_problem, data->x, y, update_counter);
+  coco_evaluate_constraint_memoized(inner_problem, data->x, y, update_counter);
 }
 
 /**
- * @brief Evaluates the gradient of the transformed function.
+ * @brief Computes the transformed decision vector Mx + b in data->x.
  */
-static void transform_vars_affine_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+static void transform_vars_affine_apply(coco_problem_t *problem, const double *x) {
   size_t i, j;
-  transform_vars_affine_data_t *data;
-  coco_problem_t *inner_problem;
-  double *current_row;
-  double *gradient;
-
-  if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
-    coco_vector_set_to_nan(y, coco_problem_get_number_of_objectives(problem));
-    return;
-  }
-
-  data = (transform_vars_affine_data_t *)coco_problem_transformed_get_data(problem);
-  inner_problem = coco_problem_transformed_get_inner_problem(problem);
-
-  gradient = coco_allocate_vector(inner_problem->number_of_variables);
-
-  for (i = 0; i < inner_problem->number_of_variables; ++i)
-    gradient[i] = 0.0;
+  transform_vars_affine_data_t *data = (transform_vars_affine_data_t *)coco_problem_transformed_get_data(problem);
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  const double *current_row;
 
   for (i = 0; i < inner_problem->number_of_variables; ++i) {
     /* data->M has problem->number_of_variables columns and inner_problem->number_of_variables rows. */
@@ -121,24 +142,69 @@ static void transform_vars_affine_evaluate_gradient(coco_problem_t *problem, con
       data->x[i] += x[j] * current_row[j];
     }
   }
+}
 
-  bbob_evaluate_gradient(inner_problem, data->x, y);
+/**
+ * @brief Turns the gradient of the inner function at Mx + b, given in y, into the gradient of the
+ * transformed function at x.
+ *
+ * grad_(f o g )(x), where g(x) = M * x + b, equals to M^T * grad_f(M *x + b), which is accumulated in the
+ * scratch memory of the problem.
+ */
+static void transform_vars_affine_backpropagate(coco_problem_t *problem, double *y) {
+  size_t i, j;
+  transform_vars_affine_data_t *data = (transform_vars_affine_data_t *)coco_problem_transformed_get_data(problem);
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  const double *current_row;
+  double *gradient;
 
-  /* grad_(f o g )(x), where g(x) = M * x + b, equals to
-   * M^T * grad_f(M *x + b)
-   */
-  for (j = 0; j < inner_problem->number_of_variables; ++j) {
-    for (i = 0; i < inner_problem->number_of_variables; ++i) {
-      current_row = data->M + i * problem->number_of_variables;
+  assert(problem->scratch_size >= problem->number_of_variables);
+  gradient = problem->scratch;
+
+  for (j = 0; j < problem->number_of_variables; ++j)
+    gradient[j] = 0.0;
+
+  /* Row by row, so that M is read contiguously (each gradient[j] is still summed up in the order of i) */
+  for (i = 0; i < inner_problem->number_of_variables; ++i) {
+    current_row = data->M + i * problem->number_of_variables;
+    for (j = 0; j < problem->number_of_variables; ++j) {
       gradient[j] += y[i] * current_row[j];
     }
   }
 
-  for (i = 0; i < inner_problem->number_of_variables; ++i)
-    y[i] = gradient[i];
+  for (j = 0; j < problem->number_of_variables; ++j)
+    y[j] = gradient[j];
+}
+
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_vars_affine_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  transform_vars_affine_data_t *data;
+
+  if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
+    coco_vector_set_to_nan(y, coco_problem_get_number_of_objectives(problem));
+    return;
+  }
+
+  data = (transform_vars_affine_data_t *)coco_problem_transformed_get_data(problem);
+  transform_vars_affine_apply(problem, x);
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y);
+  transform_vars_affine_backpropagate(problem, y);
+}
 
-  current_row = NULL;
-  coco_free_memory(gradient);
+/**
+ * @brief Evaluates the transformed function and its gradient, for which the transformed decision vector
+ * is computed only once.
+ */
+static void transform_vars_affine_evaluate_function_and_gradient(coco_problem_t *problem, const double *x,
+                                                                 double *y, double *gradient) {
+  transform_vars_affine_data_t *data = (transform_vars_affine_data_t *)coco_problem_transformed_get_data(problem);
+
+  transform_vars_affine_apply(problem, x);
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y, gradient);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+  transform_vars_affine_backpropagate(problem, gradient);
 }
 
 /**
@@ -146,13 +212,18 @@ static void transform_vars_affine_evaluate_gradient(coco_problem_t *problem, con
  */
 static void transform_vars_affine_free(void *thing) {
   transform_vars_affine_data_t *data = (transform_vars_affine_data_t *)thing;
-  coco_free_memory(data->M);
+  if (data->M_copy == NULL)
+    coco_cache_release(data->M);
+  else
+    coco_free_memory(data->M_copy);
   coco_free_memory(data->b);
   coco_free_memory(data->x);
 }
 
 /**
  * @brief Creates the transformation.
+ *
+ * If M has been obtained from the instance cache, the transformation shares it, otherwise M is copied.
  */
 static coco_problem_t *transform_vars_affine(coco_problem_t *inner_problem, const double *M, const double *b,
                                              const size_t number_of_variables) {
@@ -169,7 +240,13 @@ static coco_problem_t *transform_vars_affine(coco_problem_t *inner_problem, cons
 
   entries_in_M = inner_problem->number_of_variables * number_of_variables;
   data = (transform_vars_affine_data_t *)coco_allocate_memory(sizeof(*data));
-  data->M = coco_duplicate_vector(M, entries_in_M);
+  if (coco_cache_retain(M)) {
+    data->M = M;
+    data->M_copy = NULL;
+  } else {
+    data->M_copy = coco_duplicate_vector(M, entries_in_M);
+    data->M = data->M_copy;
+  }
   data->b = coco_duplicate_vector(b, inner_problem->number_of_variables);
   data->x = coco_allocate_vector(inner_problem->number_of_variables);
 
@@ -178,11 +255,17 @@ static coco_problem_t *transform_vars_affine(coco_problem_t *inner_problem, cons
   if (inner_problem->number_of_objectives > 0)
     problem->evaluate_function = transform_vars_affine_evaluate_function;
 
+  if (inner_problem->number_of_objectives > 0 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_batch = transform_vars_affine_evaluate_function_batch;
+
   if (inner_problem->number_of_constraints > 0)
     problem->evaluate_constraint = transform_vars_affine_evaluate_constraint;
 
   problem->evaluate_gradient = transform_vars_affine_evaluate_gradient;
 
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_vars_affine_evaluate_function_and_gradient;
+
   /* Update the best parameter by computing
      problem->best_parameter = M^T * (inner_problem->best_parameter - b).
 
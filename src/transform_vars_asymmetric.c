@@ -11,6 +11,7 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_simd.c"
 #include "brentq.c"
 
 /**
@@ -45,6 +46,18 @@ static double tasy_uv(double xi, tasy_data *d) {
   return yi;
 }
 
+/**
+ * @brief Derivative of the univariate asymmetric non-linear transformation tasy_uv.
+ */
+static double tasy_uv_derivative(double xi, tasy_data *d) {
+  double factor;
+  if (xi > 0.0) {
+    factor = (d->beta * (double)(long)d->i) / ((double)(long)d->n - 1.0);
+    return tasy_uv(xi, d) * (factor * log(xi) / (2.0 * sqrt(xi)) + (1.0 + factor * sqrt(xi)) / xi);
+  }
+  return 1.0;
+}
+
 /**
  * @brief Inverse of asymmetric non-linear transformation tasy_uv obtained with brentq.
  */
@@ -54,22 +67,73 @@ static double tasy_uv_inv(double yi, tasy_data *d) {
   return xi;
 }
 
+#if COCO_SIMD_ENABLED
+/**
+ * @brief SIMD version of the coordinate-wise asymmetric transformation of the n values in x into y, which
+ * may be x.
+ *
+ * Blocks with values outside of the range of the vector functions and the remaining values are transformed
+ * with tasy_uv().
+ */
+COCO_SIMD_INLINE int tasy_simd_body(const double *x, double *y, const size_t n, const double beta) {
+  const coco_simd_vector_t lane = {0, 1, 2, 3, 4, 5, 6, 7};
+  size_t i, j;
+  tasy_data d;
+
+  d.beta = beta;
+  d.n = n;
+  for (i = 0; i + COCO_SIMD_WIDTH <= n; i += COCO_SIMD_WIDTH) {
+    const coco_simd_vector_t xi = coco_simd_load(x + i);
+    const coco_simd_bits_t is_positive = (coco_simd_bits_t)(xi > 0.0);
+    const coco_simd_vector_t factor = (beta * (lane + (double)(long)i)) / ((double)(long)n - 1.0);
+    /* The non-positive values are kept, so that their logarithm is not needed */
+    const coco_simd_vector_t positive_xi = COCO_SIMD_SELECT(is_positive, xi, coco_simd_set(1.0));
+    coco_simd_bits_t invalid = {0};
+    coco_simd_vector_t log_x, tmp, yi;
+
+    log_x = coco_simd_log(&positive_xi, &invalid);
+    tmp = 0.5 * log_x;
+    tmp = 1.0 + factor * coco_simd_exp(&tmp, &invalid); /* The exponent with sqrt(x) */
+    tmp *= log_x;
+    yi = coco_simd_exp(&tmp, &invalid);
+    yi = COCO_SIMD_SELECT(is_positive, yi, xi);
+    if (coco_simd_any(&invalid)) {
+      for (j = i; j < i + COCO_SIMD_WIDTH; ++j) {
+        d.i = j;
+        y[j] = tasy_uv(x[j], &d);
+      }
+    } else {
+      coco_simd_store(y + i, &yi);
+    }
+  }
+  for (; i < n; ++i) {
+    d.i = i;
+    y[i] = tasy_uv(x[i], &d);
+  }
+  return 1;
+}
+
+COCO_SIMD_DEFINE_KERNEL(tasy_simd, (const double *x, double *y, const size_t n, const double beta),
+                        (x, y, n, beta))
+#endif
+
 /**
  * @brief Multivariate, coordinate-wise, asymmetric non-linear transformation.
  */
 static void tasy(transform_vars_asymmetric_data_t *data, const double *x, size_t number_of_variables) {
   size_t i;
-  tasy_data *d;
-  d = coco_allocate_memory(sizeof(*d));
+  tasy_data d;
 
-  d->beta = data->beta;
-  d->n = number_of_variables;
+  if (COCO_SIMD_RUN(tasy_simd, (x, data->x, number_of_variables, data->beta)))
+    return;
+
+  d.beta = data->beta;
+  d.n = number_of_variables;
 
   for (i = 0; i < number_of_variables; ++i) {
-    d->i = i;
-    data->x[i] = tasy_uv(x[i], d);
+    d.i = i;
+    data->x[i] = tasy_uv(x[i], &d);
   }
-  coco_free_memory(d);
 }
 
 /**
@@ -77,7 +141,6 @@ static void tasy(transform_vars_asymmetric_data_t *data, const double *x, size_t
  */
 static void transform_vars_asymmetric_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
 
-  double *cons_values;
   int is_feasible;
   transform_vars_asymmetric_data_t *data;
   coco_problem_t *inner_problem;
@@ -95,15 +158,95 @@ static void transform_vars_asymmetric_evaluate_function(coco_problem_t *problem,
   coco_evaluate_function(inner_problem, data->x, y);
 
   if (problem->number_of_constraints > 0) {
-    cons_values = coco_allocate_vector(problem->number_of_constraints);
-    is_feasible = coco_is_feasible(problem, x, cons_values);
-    coco_free_memory(cons_values);
+    is_feasible = coco_is_feasible(problem, x, NULL);
     if (is_feasible)
       assert(y[0] + 1e-13 >= problem->best_value[0]);
   } else
     assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformed function in a batch of points.
+ */
+static void transform_vars_asymmetric_evaluate_function_batch(coco_problem_t *problem, const double *x, double *y,
+                                                              const size_t number_of_points) {
+  size_t i, k;
+  const size_t n = problem->number_of_variables;
+  tasy_data d;
+  transform_vars_asymmetric_data_t *data;
+  double *asymmetric_x;
+
+  data = (transform_vars_asymmetric_data_t *)coco_problem_transformed_get_data(problem);
+  asymmetric_x = coco_problem_transformed_get_batch_buffer(problem, number_of_points * n);
+
+  d.beta = data->beta;
+  d.n = n;
+  for (k = 0; k < number_of_points; ++k) {
+    if (COCO_SIMD_RUN(tasy_simd, (x + k * n, asymmetric_x + k * n, n, d.beta)))
+      continue;
+    for (i = 0; i < n; ++i) {
+      d.i = i;
+      asymmetric_x[k * n + i] = tasy_uv(x[k * n + i], &d);
+    }
+  }
+
+  coco_evaluate_function_batch(coco_problem_transformed_get_inner_problem(problem), asymmetric_x, y,
+                               number_of_points);
+
+  for (k = 0; k < number_of_points; ++k)
+    assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+}
+
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_vars_asymmetric_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  tasy_data d;
+  transform_vars_asymmetric_data_t *data;
+
+  if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
+    coco_vector_set_to_nan(y, coco_problem_get_dimension(problem));
+    return;
+  }
+
+  data = (transform_vars_asymmetric_data_t *)coco_problem_transformed_get_data(problem);
+
+  tasy(data, x, problem->number_of_variables);
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y);
+
+  /* The transformation is coordinate-wise, so that its Jacobian is diagonal */
+  d.beta = data->beta;
+  d.n = problem->number_of_variables;
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    d.i = i;
+    y[i] *= tasy_uv_derivative(x[i], &d);
+  }
+}
+
+/**
+ * @brief Evaluates the transformed function and its gradient.
+ */
+static void transform_vars_asymmetric_evaluate_function_and_gradient(coco_problem_t *problem, const double *x,
+                                                                     double *y, double *gradient) {
+  size_t i;
+  tasy_data d;
+  transform_vars_asymmetric_data_t *data;
+
+  data = (transform_vars_asymmetric_data_t *)coco_problem_transformed_get_data(problem);
+
+  tasy(data, x, problem->number_of_variables);
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y, gradient);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+
+  d.beta = data->beta;
+  d.n = problem->number_of_variables;
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    d.i = i;
+    gradient[i] *= tasy_uv_derivative(x[i], &d);
+  }
+}
+
 /**
  * @brief Evaluates the transformed constraint.
  */
@@ -136,7 +279,7 @@ static void transform_vars_asymmetric_evaluate_constraint(coco_problem_t *proble
       data->x[i] = x[i];
     }
   }
-  inner_problem->evaluate_constraint(inner_problem, data->x, y, update_counter);
+  coco_evaluate_constraint_memoized(inner_problem, data->x, y, update_counter);
 }
 
 static void transform_vars_asymmetric_free(void *thing) {
@@ -160,6 +303,14 @@ static coco_problem_t *transform_vars_asymmetric(coco_problem_t *inner_problem,
   if (inner_problem->number_of_objectives > 0)
     problem->evaluate_function = transform_vars_asymmetric_evaluate_function;
 
+  if (inner_problem->number_of_objectives > 0 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_batch = transform_vars_asymmetric_evaluate_function_batch;
+
+  problem->evaluate_gradient = transform_vars_asymmetric_evaluate_gradient;
+
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_vars_asymmetric_evaluate_function_and_gradient;
+
   if (inner_problem->number_of_constraints > 0)
     problem->evaluate_constraint = transform_vars_asymmetric_evaluate_constraint;
 
@@ -4,47 +4,170 @@
  * decision values.
  *
  * x |-> Bx
- * The matrix B is stored in a 2-D array. Only the content of the blocks are
- * stored
+ * Only the content of the blocks is stored, block by block and row by row in a single block of memory, so
+ * that the product is computed with a small dense kernel per block.
  */
 
 #include <assert.h>
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_cache.c"
 #include "transform_vars_blockrotation_helpers.c"
 #include "transform_vars_permutation_helpers.c" /* for coco_duplicate_size_t_vector */
 
+/**
+ * @brief The block size for which the product with a block is specialized (the block size of bbob-largescale,
+ * which needs to be a multiple of eight).
+ */
+#define TRANSFORM_VARS_BLOCKROTATION_COMMON_BLOCK_SIZE 40
+
 /**
  * @brief Data type for transform_vars_blockrotation.
  */
 typedef struct {
-  double **B; /**< @brief the block-diagonal matrices*/
+  const double *const *B; /**< @brief the block-diagonal matrices if they are from the instance cache and NULL
+                             otherwise */
+  const double *blocks;   /**< @brief the entries of the blocks, stored block by block and row by row */
+  double *blocks_copy;    /**< @brief the copy of the entries if B is not cached and NULL otherwise */
   double *Bx;
+  double *x_block;        /**< @brief the input of the current block, gathered into contiguous memory */
   size_t dimension;
-  size_t *block_sizes;        /**< @brief the list of block-sizes*/
-  size_t nb_blocks;           /**< @brief the number of blocks in the matrix */
-  size_t *block_size_map;     /**< @brief maps a row to the block-size of the block to
-                                 which it belong, keep until better way is found */
-  size_t *first_non_zero_map; /**< @brief maps a row to the index of its first
-                                 non zero element */
+  size_t *block_sizes;    /**< @brief the list of block-sizes*/
+  size_t nb_blocks;       /**< @brief the number of blocks in the matrix */
 } transform_vars_blockrotation_t;
 
 /*
  * @brief return i-th row of blockrotation problem->data->B in y.
  */
 static void transform_vars_blockrotation_get_row(coco_problem_t *problem, size_t i, double *y) {
-  size_t j, current_blocksize, first_non_zero_ind; /* cp-paste from apply */
+  size_t j, idx_block, first_row = 0;
+  const double *block;
+  transform_vars_blockrotation_t *data;
+
+  data = (transform_vars_blockrotation_t *)coco_problem_transformed_get_data(problem);
+  block = data->blocks;
+  for (idx_block = 0; i >= first_row + data->block_sizes[idx_block]; idx_block++) {
+    block += data->block_sizes[idx_block] * data->block_sizes[idx_block];
+    first_row += data->block_sizes[idx_block];
+  }
+
+  for (j = 0; j < data->dimension; ++j)
+    y[j] = 0;
+  for (j = 0; j < data->block_sizes[idx_block]; ++j)
+    y[first_row + j] = block[(i - first_row) * data->block_sizes[idx_block] + j];
+}
+
+/**
+ * @brief Computes the product of a block of the given size with x in y.
+ *
+ * Four rows are multiplied with x at once, so that their sums are independent of each other. Each sum is
+ * still computed in the order of the columns, which keeps the results bit-identical to the row-by-row
+ * product.
+ */
+static void transform_vars_blockrotation_multiply_block(const double *block, const size_t block_size,
+                                                        const double *x, double *y) {
+  const double *row;
+  double sum0, sum1, sum2, sum3;
+  size_t i, j;
+
+  for (i = 0; i + 4 <= block_size; i += 4) {
+    row = block + i * block_size;
+    sum0 = sum1 = sum2 = sum3 = 0;
+    for (j = 0; j < block_size; ++j) {
+      sum0 += row[j] * x[j];
+      sum1 += row[block_size + j] * x[j];
+      sum2 += row[2 * block_size + j] * x[j];
+      sum3 += row[3 * block_size + j] * x[j];
+    }
+    y[i] = sum0;
+    y[i + 1] = sum1;
+    y[i + 2] = sum2;
+    y[i + 3] = sum3;
+  }
+  for (; i < block_size; ++i) {
+    row = block + i * block_size;
+    sum0 = 0;
+    for (j = 0; j < block_size; ++j)
+      sum0 += row[j] * x[j];
+    y[i] = sum0;
+  }
+}
+
+/**
+ * @brief Computes the product of a block of the common block size with x in y.
+ *
+ * As the size is known at compile time, eight rows are multiplied with x at once.
+ */
+static void transform_vars_blockrotation_multiply_common_block(const double *block, const double *x, double *y) {
+  const size_t size = TRANSFORM_VARS_BLOCKROTATION_COMMON_BLOCK_SIZE;
+  const double *row;
+  double sum0, sum1, sum2, sum3, sum4, sum5, sum6, sum7;
+  size_t i, j;
+
+  for (i = 0; i < size; i += 8) {
+    row = block + i * size;
+    sum0 = sum1 = sum2 = sum3 = sum4 = sum5 = sum6 = sum7 = 0;
+    for (j = 0; j < size; ++j) {
+      sum0 += row[j] * x[j];
+      sum1 += row[size + j] * x[j];
+      sum2 += row[2 * size + j] * x[j];
+      sum3 += row[3 * size + j] * x[j];
+      sum4 += row[4 * size + j] * x[j];
+      sum5 += row[5 * size + j] * x[j];
+      sum6 += row[6 * size + j] * x[j];
+      sum7 += row[7 * size + j] * x[j];
+    }
+    y[i] = sum0;
+    y[i + 1] = sum1;
+    y[i + 2] = sum2;
+    y[i + 3] = sum3;
+    y[i + 4] = sum4;
+    y[i + 5] = sum5;
+    y[i + 6] = sum6;
+    y[i + 7] = sum7;
+  }
+}
+
+/**
+ * @brief Computes y[output_index[i]] = (B u)[i] with u[j] = x[input_index[j]], where either index may be NULL
+ * for the identity.
+ *
+ * This fuses the gather of a permutation before and the one of a permutation after the block rotation
+ * into its product. The product is computed block by block, with a kernel that is unrolled for the common
+ * block size of bbob-largescale.
+ */
+static void transform_vars_blockrotation_multiply(coco_problem_t *problem, const double *x,
+                                                  const size_t *input_index, double *y,
+                                                  const size_t *output_index) {
+  size_t i, block_size, idx_block, first_row = 0;
+  const double *block, *block_x;
+  double *block_y;
   transform_vars_blockrotation_t *data;
 
   data = (transform_vars_blockrotation_t *)coco_problem_transformed_get_data(problem);
-  current_blocksize = data->block_size_map[i];
-  first_non_zero_ind = data->first_non_zero_map[i];
+  block = data->blocks;
+  for (idx_block = 0; idx_block < data->nb_blocks; idx_block++) {
+    block_size = data->block_sizes[idx_block];
+    block_x = x + first_row;
+    if (input_index != NULL) {
+      for (i = 0; i < block_size; ++i)
+        data->x_block[i] = x[input_index[first_row + i]];
+      block_x = data->x_block;
+    }
+    block_y = (output_index != NULL) ? data->Bx : y + first_row;
 
-  for (j = 0; j < data->dimension; ++j) {
-    y[j] = (j < first_non_zero_ind || j >= first_non_zero_ind + current_blocksize)
-               ? 0
-               : data->B[i][j - first_non_zero_ind]; /*all B lines start at 0*/
+    if (block_size == TRANSFORM_VARS_BLOCKROTATION_COMMON_BLOCK_SIZE)
+      transform_vars_blockrotation_multiply_common_block(block, block_x, block_y);
+    else
+      transform_vars_blockrotation_multiply_block(block, block_size, block_x, block_y);
+
+    if (output_index != NULL) {
+      for (i = 0; i < block_size; ++i)
+        y[output_index[first_row + i]] = block_y[i];
+    }
+    block += block_size * block_size;
+    first_row += block_size;
   }
 }
 
@@ -53,20 +176,12 @@ static void transform_vars_blockrotation_get_row(coco_problem_t *problem, size_t
  * in the problem data.
  */
 static void transform_vars_blockrotation_apply(coco_problem_t *problem, const double *x, double *y) {
-  size_t i, j, current_blocksize, first_non_zero_ind;
+  size_t i;
   transform_vars_blockrotation_t *data;
 
   data = (transform_vars_blockrotation_t *)coco_problem_transformed_get_data(problem);
   assert(x != data->Bx);
-  for (i = 0; i < data->dimension; ++i) {
-    current_blocksize = data->block_size_map[i];
-    first_non_zero_ind = data->first_non_zero_map[i];
-    data->Bx[i] = 0;
-    /*compute y[i] = < B[i,:] , x >  */
-    for (j = first_non_zero_ind; j < first_non_zero_ind + current_blocksize; ++j) {
-      data->Bx[i] += data->B[i][j - first_non_zero_ind] * x[j]; /*all B lines start at 0*/
-    }
-  }
+  transform_vars_blockrotation_multiply(problem, x, NULL, data->Bx, NULL);
   if (y != data->Bx) {
     for (i = 0; i < data->dimension; ++i) {
       y[i] = data->Bx[i];
@@ -79,19 +194,78 @@ static void transform_vars_blockrotation_evaluate(coco_problem_t *problem, const
   transform_vars_blockrotation_t *data;
   data = (transform_vars_blockrotation_t *)coco_problem_transformed_get_data(problem);
 
-  transform_vars_blockrotation_apply(problem, x, data->Bx);
+  transform_vars_blockrotation_multiply(problem, x, NULL, data->Bx, NULL);
 
   coco_evaluate_function(inner_problem, data->Bx, y);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Computes y = B^T y, where the result is first accumulated in the scratch space of the problem.
+ */
+static void transform_vars_blockrotation_backpropagate(coco_problem_t *problem, double *y) {
+  size_t i, j, block_size, idx_block, first_row = 0;
+  const double *row;
+  transform_vars_blockrotation_t *data;
+  double *gradient;
+
+  data = (transform_vars_blockrotation_t *)coco_problem_transformed_get_data(problem);
+  assert(problem->scratch_size >= data->dimension);
+  gradient = problem->scratch;
+
+  for (j = 0; j < data->dimension; ++j)
+    gradient[j] = 0;
+  row = data->blocks;
+  for (idx_block = 0; idx_block < data->nb_blocks; idx_block++) {
+    block_size = data->block_sizes[idx_block];
+    for (i = first_row; i < first_row + block_size; ++i) {
+      for (j = 0; j < block_size; ++j) {
+        gradient[first_row + j] += row[j] * y[i];
+      }
+      row += block_size;
+    }
+    first_row += block_size;
+  }
+  for (j = 0; j < data->dimension; ++j)
+    y[j] = gradient[j];
+}
+
+/**
+ * @brief Evaluates the gradient of the transformed function, which is B^T times the gradient of the inner
+ * function at Bx.
+ */
+static void transform_vars_blockrotation_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  transform_vars_blockrotation_t *data;
+
+  data = (transform_vars_blockrotation_t *)coco_problem_transformed_get_data(problem);
+  transform_vars_blockrotation_apply(problem, x, data->Bx);
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->Bx, y);
+  transform_vars_blockrotation_backpropagate(problem, y);
+}
+
+/**
+ * @brief Evaluates the transformed function and its gradient.
+ */
+static void transform_vars_blockrotation_evaluate_function_and_gradient(coco_problem_t *problem, const double *x,
+                                                                        double *y, double *gradient) {
+  transform_vars_blockrotation_t *data;
+
+  data = (transform_vars_blockrotation_t *)coco_problem_transformed_get_data(problem);
+  transform_vars_blockrotation_apply(problem, x, data->Bx);
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), data->Bx, y, gradient);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+  transform_vars_blockrotation_backpropagate(problem, gradient);
+}
+
 static void transform_vars_blockrotation_free(void *stuff) {
   transform_vars_blockrotation_t *data = (transform_vars_blockrotation_t *)stuff;
-  coco_free_block_matrix(data->B, data->dimension);
+  if (data->B != NULL)
+    coco_cache_release(data->B);
+  else
+    coco_free_memory(data->blocks_copy);
   coco_free_memory(data->block_sizes);
   coco_free_memory(data->Bx);
-  coco_free_memory(data->block_size_map);
-  coco_free_memory(data->first_non_zero_map);
+  coco_free_memory(data->x_block);
 }
 
 /*
@@ -118,35 +292,54 @@ static void transform_vars_blockrotation_test(coco_problem_t *problem, double pr
   coco_free_memory(y);
 }
 
+/**
+ * @brief Creates the transformation.
+ *
+ * If B has been obtained from the instance cache, whose blocks are stored in one block of memory in the
+ * order of the rows, the transformation shares it, otherwise the blocks are copied into this layout.
+ */
 static coco_problem_t *transform_vars_blockrotation(coco_problem_t *inner_problem, const double *const *B,
                                                     const size_t number_of_variables, const size_t *block_sizes,
                                                     const size_t nb_blocks) {
   coco_problem_t *problem;
   transform_vars_blockrotation_t *data;
-  size_t idx_blocksize, next_bs_change, current_blocksize;
-  size_t i;
+  size_t i, j, idx_block, first_row, number_of_entries = 0, max_block_size = 0;
   assert(number_of_variables > 0); /*tmp*/
   data = (transform_vars_blockrotation_t *)coco_allocate_memory(sizeof(*data));
   data->dimension = number_of_variables;
-  data->B = coco_copy_block_matrix(B, number_of_variables, block_sizes, nb_blocks);
+  for (idx_block = 0; idx_block < nb_blocks; idx_block++) {
+    number_of_entries += block_sizes[idx_block] * block_sizes[idx_block];
+    if (block_sizes[idx_block] > max_block_size)
+      max_block_size = block_sizes[idx_block];
+  }
+  if (coco_cache_retain(B)) {
+    data->B = B;
+    data->blocks = B[0];
+    data->blocks_copy = NULL;
+  } else {
+    data->B = NULL;
+    data->blocks_copy = coco_allocate_vector(number_of_entries);
+    data->blocks = data->blocks_copy;
+  }
+  number_of_entries = 0;
+  first_row = 0;
+  for (idx_block = 0; idx_block < nb_blocks; idx_block++) {
+    for (i = first_row; i < first_row + block_sizes[idx_block]; i++) {
+      if (data->blocks_copy == NULL) {
+        assert(B[i] == data->blocks + number_of_entries);
+      } else {
+        for (j = 0; j < block_sizes[idx_block]; j++)
+          data->blocks_copy[number_of_entries + j] = B[i][j];
+      }
+      number_of_entries += block_sizes[idx_block];
+    }
+    first_row += block_sizes[idx_block];
+  }
   data->Bx = coco_allocate_vector(inner_problem->number_of_variables);
+  data->x_block = coco_allocate_vector(max_block_size);
   data->block_sizes = coco_duplicate_size_t_vector(block_sizes, nb_blocks);
   data->nb_blocks = nb_blocks;
-  data->block_size_map = coco_allocate_vector_size_t(number_of_variables);
-  data->first_non_zero_map = coco_allocate_vector_size_t(number_of_variables);
-
-  idx_blocksize = 0;
-  next_bs_change = block_sizes[idx_blocksize];
-  for (i = 0; i < number_of_variables; i++) {
-    if (i >= next_bs_change) {
-      idx_blocksize++;
-      next_bs_change += block_sizes[idx_blocksize];
-    }
-    current_blocksize = block_sizes[idx_blocksize];
-    data->block_size_map[i] = current_blocksize;
-    data->first_non_zero_map[i] = next_bs_change - current_blocksize; /* next_bs_change serves also as a
-                                                                         cumsum for blocksizes*/
-  }
+
   if (coco_problem_best_parameter_not_zero(inner_problem)) {
     coco_debug("transform_vars_blockrotation(): 'best_parameter' not updated, "
                "set to NAN");
@@ -155,6 +348,9 @@ static coco_problem_t *transform_vars_blockrotation(coco_problem_t *inner_proble
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_blockrotation_free,
                                               "transform_vars_blockrotation");
   problem->evaluate_function = transform_vars_blockrotation_evaluate;
+  problem->evaluate_gradient = transform_vars_blockrotation_evaluate_gradient;
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_vars_blockrotation_evaluate_function_and_gradient;
 
   if (number_of_variables < 100) {
     /* 1e-11 still passes and 1e-12 fails under macOS */
@@ -14,6 +14,7 @@
  */
 typedef struct {
   double *x;
+  double *factors; /**< @brief The precomputed factors (without the factor 10 for positive values) */
 } transform_vars_brs_data_t;
 
 /**
@@ -34,11 +35,7 @@ static void transform_vars_brs_evaluate(coco_problem_t *problem, const double *x
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
   for (i = 0; i < problem->number_of_variables; ++i) {
-    /* Function documentation says we should compute 10^(0.5 *
-     * (i-1)/(D-1)). Instead we compute the equivalent
-     * sqrt(10)^((i-1)/(D-1)) just like the legacy code.
-     */
-    factor = pow(sqrt(10.0), (double)(long)i / ((double)(long)problem->number_of_variables - 1.0));
+    factor = data->factors[i];
     /* Documentation specifies odd indices and starts indexing
      * from 1, we use all even indices since C starts indexing
      * with 0.
@@ -52,12 +49,75 @@ static void transform_vars_brs_evaluate(coco_problem_t *problem, const double *x
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Computes the transformed decision vector in data->x and the factors by which the coordinates of x
+ * are multiplied in factors.
+ */
+static void transform_vars_brs_apply(coco_problem_t *problem, const double *x, double *factors) {
+  size_t i;
+  double factor;
+  transform_vars_brs_data_t *data;
+
+  data = (transform_vars_brs_data_t *)coco_problem_transformed_get_data(problem);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    factor = data->factors[i];
+    if (x[i] > 0.0 && i % 2 == 0) {
+      factor *= 10.0;
+    }
+    factors[i] = factor;
+    data->x[i] = factor * x[i];
+  }
+}
+
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_vars_brs_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  transform_vars_brs_data_t *data;
+  double *factors;
+
+  data = (transform_vars_brs_data_t *)coco_problem_transformed_get_data(problem);
+  assert(problem->scratch_size >= problem->number_of_variables);
+  factors = problem->scratch;
+
+  transform_vars_brs_apply(problem, x, factors);
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y);
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= factors[i];
+  }
+}
+
+/**
+ * @brief Evaluates the transformed function and its gradient.
+ */
+static void transform_vars_brs_evaluate_function_and_gradient(coco_problem_t *problem, const double *x, double *y,
+                                                              double *gradient) {
+  size_t i;
+  transform_vars_brs_data_t *data;
+  double *factors;
+
+  data = (transform_vars_brs_data_t *)coco_problem_transformed_get_data(problem);
+  assert(problem->scratch_size >= problem->number_of_variables);
+  factors = problem->scratch;
+
+  transform_vars_brs_apply(problem, x, factors);
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y, gradient);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    gradient[i] *= factors[i];
+  }
+}
+
 /**
  * @brief Frees the data object.
  */
 static void transform_vars_brs_free(void *thing) {
   transform_vars_brs_data_t *data = (transform_vars_brs_data_t *)thing;
   coco_free_memory(data->x);
+  coco_free_memory(data->factors);
 }
 
 /**
@@ -66,11 +126,23 @@ static void transform_vars_brs_free(void *thing) {
 static coco_problem_t *transform_vars_brs(coco_problem_t *inner_problem) {
   transform_vars_brs_data_t *data;
   coco_problem_t *problem;
+  size_t i;
 
   data = (transform_vars_brs_data_t *)coco_allocate_memory(sizeof(*data));
   data->x = coco_allocate_vector(inner_problem->number_of_variables);
+  data->factors = coco_allocate_vector(inner_problem->number_of_variables);
+  for (i = 0; i < inner_problem->number_of_variables; ++i) {
+    /* Function documentation says we should compute 10^(0.5 *
+     * (i-1)/(D-1)). Instead we compute the equivalent
+     * sqrt(10)^((i-1)/(D-1)) just like the legacy code.
+     */
+    data->factors[i] = pow(sqrt(10.0), (double)(long)i / ((double)(long)inner_problem->number_of_variables - 1.0));
+  }
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_brs_free, "transform_vars_brs");
   problem->evaluate_function = transform_vars_brs_evaluate;
+  problem->evaluate_gradient = transform_vars_brs_evaluate_gradient;
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_vars_brs_evaluate_function_and_gradient;
 
   if (coco_problem_best_parameter_not_zero(inner_problem)) {
     coco_warning("transform_vars_brs(): 'best_parameter' not updated, set to NAN");
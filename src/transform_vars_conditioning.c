@@ -15,6 +15,7 @@
 typedef struct {
   double *x;
   double alpha;
+  double *coefficients; /**< @brief The precomputed scaling coefficients */
 } transform_vars_conditioning_data_t;
 
 /**
@@ -34,15 +35,38 @@ static void transform_vars_conditioning_evaluate(coco_problem_t *problem, const
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
   for (i = 0; i < problem->number_of_variables; ++i) {
-    /* OME: We could precalculate the scaling coefficients if we
-     * really wanted to.
-     */
-    data->x[i] = pow(data->alpha, 0.5 * (double)(long)i / ((double)(long)problem->number_of_variables - 1.0)) * x[i];
+    data->x[i] = data->coefficients[i] * x[i];
   }
   coco_evaluate_function(inner_problem, data->x, y);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformation in a batch of points.
+ */
+static void transform_vars_conditioning_evaluate_batch(coco_problem_t *problem, const double *x, double *y,
+                                                       const size_t number_of_points) {
+  size_t i, k;
+  const size_t n = problem->number_of_variables;
+  transform_vars_conditioning_data_t *data;
+  double *conditioned_x;
+
+  data = (transform_vars_conditioning_data_t *)coco_problem_transformed_get_data(problem);
+  conditioned_x = coco_problem_transformed_get_batch_buffer(problem, number_of_points * n);
+
+  for (k = 0; k < number_of_points; ++k) {
+    for (i = 0; i < n; ++i) {
+      conditioned_x[k * n + i] = data->coefficients[i] * x[k * n + i];
+    }
+  }
+
+  coco_evaluate_function_batch(coco_problem_transformed_get_inner_problem(problem), conditioned_x, y,
+                               number_of_points);
+
+  for (k = 0; k < number_of_points; ++k)
+    assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Evaluates the gradient of the transformed function.
  */
@@ -60,10 +84,11 @@ static void transform_vars_conditioning_evaluate_gradient(coco_problem_t *proble
   data = (transform_vars_conditioning_data_t *)coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
-  gradient = coco_allocate_vector(inner_problem->number_of_variables);
+  assert(problem->scratch_size >= inner_problem->number_of_variables);
+  gradient = problem->scratch;
 
   for (i = 0; i < problem->number_of_variables; ++i) {
-    gradient[i] = pow(data->alpha, 0.5 * (double)(long)i / ((double)(long)problem->number_of_variables - 1.0));
+    gradient[i] = data->coefficients[i];
     data->x[i] = gradient[i] * x[i];
   }
   bbob_evaluate_gradient(inner_problem, data->x, y);
@@ -73,13 +98,32 @@ static void transform_vars_conditioning_evaluate_gradient(coco_problem_t *proble
 
   for (i = 0; i < inner_problem->number_of_variables; ++i)
     y[i] = gradient[i];
+}
 
-  coco_free_memory(gradient);
+/**
+ * @brief Evaluates the transformed function and its gradient.
+ */
+static void transform_vars_conditioning_evaluate_function_and_gradient(coco_problem_t *problem, const double *x,
+                                                                       double *y, double *gradient) {
+  size_t i;
+  transform_vars_conditioning_data_t *data;
+
+  data = (transform_vars_conditioning_data_t *)coco_problem_transformed_get_data(problem);
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    data->x[i] = data->coefficients[i] * x[i];
+  }
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y, gradient);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+
+  for (i = 0; i < problem->number_of_variables; ++i)
+    gradient[i] *= data->coefficients[i];
 }
 
 static void transform_vars_conditioning_free(void *thing) {
   transform_vars_conditioning_data_t *data = (transform_vars_conditioning_data_t *)thing;
   coco_free_memory(data->x);
+  coco_free_memory(data->coefficients);
 }
 
 /**
@@ -88,14 +132,24 @@ static void transform_vars_conditioning_free(void *thing) {
 static coco_problem_t *transform_vars_conditioning(coco_problem_t *inner_problem, const double alpha) {
   transform_vars_conditioning_data_t *data;
   coco_problem_t *problem;
+  size_t i;
 
   data = (transform_vars_conditioning_data_t *)coco_allocate_memory(sizeof(*data));
   data->x = coco_allocate_vector(inner_problem->number_of_variables);
   data->alpha = alpha;
+  data->coefficients = coco_allocate_vector(inner_problem->number_of_variables);
+  for (i = 0; i < inner_problem->number_of_variables; ++i) {
+    data->coefficients[i] =
+        pow(alpha, 0.5 * (double)(long)i / ((double)(long)inner_problem->number_of_variables - 1.0));
+  }
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_conditioning_free,
                                               "transform_vars_conditioning");
   problem->evaluate_function = transform_vars_conditioning_evaluate;
+  if (inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_batch = transform_vars_conditioning_evaluate_batch;
   problem->evaluate_gradient = transform_vars_conditioning_evaluate_gradient;
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_vars_conditioning_evaluate_function_and_gradient;
 
   if (coco_problem_best_parameter_not_zero(inner_problem)) {
     coco_warning("transform_vars_conditioning(): 'best_parameter' not updated, set to NAN");
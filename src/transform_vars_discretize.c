@@ -19,27 +19,74 @@
  */
 
 #include <assert.h>
+#include <string.h>
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_evaluation_cache.c"
+
+/**
+ * @brief The largest number of integer values of a coordinate for which the discretized values are tabulated.
+ */
+#define TRANSFORM_VARS_DISCRETIZE_MAX_TABLE_SIZE 1024
+
+/**
+ * @brief The map of an integer coordinate of the outer problem to the coordinate of the inner problem.
+ *
+ * The integer value d in [outer_l, outer_u] is mapped to
+ * inner_l + (inner_u - inner_l) * (d - outer_l) / (outer_u - outer_l) - offset. If the bounds of the coordinate
+ * are integers and there are not too many of them, these values are computed at construction and looked up
+ * in the table values.
+ */
+typedef struct {
+  double outer_l, outer_u;
+  double inner_l, inner_u;
+  double offset;
+  double *values; /**< @brief The inner values of outer_l, outer_l + 1, ..., outer_u (or NULL) */
+} transform_vars_discretize_coordinate_t;
 
 /**
  * @brief Data type for transform_vars_discretize.
  */
 typedef struct {
-  double *offset;
+  transform_vars_discretize_coordinate_t *coordinates; /**< @brief The maps of the integer coordinates */
+  double *values;                                      /**< @brief The memory of the tables of all coordinates */
+  coco_evaluation_cache_t *cache;                      /**< @brief The cache of evaluations (or NULL) */
 } transform_vars_discretize_data_t;
 
+/**
+ * @brief Returns the coordinate of the inner problem that corresponds to the integer value d.
+ */
+static double transform_vars_discretize_map(const transform_vars_discretize_coordinate_t *coordinate,
+                                            const double d) {
+  return coordinate->inner_l +
+         (coordinate->inner_u - coordinate->inner_l) * (d - coordinate->outer_l) /
+             (coordinate->outer_u - coordinate->outer_l) - coordinate->offset;
+}
+
+/**
+ * @brief Returns the number of tabulated values of the coordinate (0 if its values are not tabulated).
+ */
+static size_t transform_vars_discretize_get_table_size(const transform_vars_discretize_coordinate_t *coordinate) {
+  const double number_of_values = coordinate->outer_u - coordinate->outer_l + 1;
+
+  if ((coordinate->outer_l != coco_double_round(coordinate->outer_l)) ||
+      (coordinate->outer_u != coco_double_round(coordinate->outer_u)) ||
+      (number_of_values > TRANSFORM_VARS_DISCRETIZE_MAX_TABLE_SIZE))
+    return 0;
+  return (size_t)number_of_values;
+}
+
 /**
  * @brief Evaluates the transformed objective function.
  */
 static void transform_vars_discretize_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
   size_t i;
   transform_vars_discretize_data_t *data;
+  const transform_vars_discretize_coordinate_t *coordinate;
   coco_problem_t *inner_problem;
   double *discretized_x;
-  double l, u, inner_l, inner_u, outer_l, outer_u;
-  int n;
+  double d;
 
   if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
     coco_vector_set_to_nan(y, coco_problem_get_number_of_objectives(problem));
@@ -49,29 +96,29 @@ static void transform_vars_discretize_evaluate_function(coco_problem_t *problem,
   data = (transform_vars_discretize_data_t *)coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
-  /* Transform x to fit in the discretized space */
-  discretized_x = coco_duplicate_vector(x, problem->number_of_variables);
+  /* Transform x to fit in the discretized space (stored in the scratch memory of the problem) */
+  discretized_x = problem->scratch;
+  memcpy(discretized_x + problem->number_of_integer_variables, x + problem->number_of_integer_variables,
+         (problem->number_of_variables - problem->number_of_integer_variables) * sizeof(double));
   for (i = 0; i < problem->number_of_integer_variables; ++i) {
-    outer_l = problem->smallest_values_of_interest[i];
-    outer_u = problem->largest_values_of_interest[i];
-    l = inner_problem->smallest_values_of_interest[i];
-    u = inner_problem->largest_values_of_interest[i];
-    n = coco_double_to_int(outer_u) - coco_double_to_int(outer_l) + 1; /* number of integer values in this coordinate */
-    assert(n > 1);
-    inner_l = l + (u - l) / (n + 1);
-    inner_u = u - (u - l) / (n + 1);
-    /* Make sure you the bounds are respected */
-    discretized_x[i] = coco_double_round(x[i]);
-    if (discretized_x[i] < outer_l)
-      discretized_x[i] = outer_l;
-    if (discretized_x[i] > outer_u)
-      discretized_x[i] = outer_u;
-    discretized_x[i] =
-        inner_l + (inner_u - inner_l) * (discretized_x[i] - outer_l) / (outer_u - outer_l) - data->offset[i];
+    coordinate = &data->coordinates[i];
+    /* Make sure the bounds are respected */
+    d = coco_double_round(x[i]);
+    if (d < coordinate->outer_l)
+      d = coordinate->outer_l;
+    if (d > coordinate->outer_u)
+      d = coordinate->outer_u;
+    if (coordinate->values != NULL)
+      discretized_x[i] = coordinate->values[(size_t)(d - coordinate->outer_l)];
+    else
+      discretized_x[i] = transform_vars_discretize_map(coordinate, d);
   }
 
+  if ((data->cache != NULL) && coco_evaluation_cache_lookup(data->cache, discretized_x, y))
+    return;
   coco_evaluate_function(inner_problem, discretized_x, y);
-  coco_free_memory(discretized_x);
+  if (data->cache != NULL)
+    coco_evaluation_cache_insert(data->cache, discretized_x, y);
 }
 
 /**
@@ -79,26 +126,40 @@ static void transform_vars_discretize_evaluate_function(coco_problem_t *problem,
  */
 static void transform_vars_discretize_free(void *thing) {
   transform_vars_discretize_data_t *data = (transform_vars_discretize_data_t *)thing;
-  coco_free_memory(data->offset);
+  coco_free_memory(data->coordinates);
+  if (data->values != NULL)
+    coco_free_memory(data->values);
+  if (data->cache != NULL)
+    coco_evaluation_cache_free(data->cache);
 }
 
 /**
  * @brief Creates the transformation.
+ *
+ * If cache_size is positive, the evaluations of the inner problem in the last cache_size distinct
+ * discretized points are cached, so that evaluating the problem in the same point again does not evaluate
+ * the inner problem (see coco_evaluation_cache_t). This is only valid for deterministic inner problems.
  */
 static coco_problem_t *transform_vars_discretize(coco_problem_t *inner_problem,
                                                  const double *smallest_values_of_interest,
                                                  const double *largest_values_of_interest,
-                                                 const size_t number_of_integer_variables) {
+                                                 const size_t number_of_integer_variables,
+                                                 const size_t cache_size) {
   transform_vars_discretize_data_t *data;
+  transform_vars_discretize_coordinate_t *coordinate;
   coco_problem_t *problem = NULL;
-  double l, u, inner_l, inner_u, outer_l, outer_u;
+  double l, u, outer_l, outer_u;
   double outer_xopt, inner_xopt, inner_approx_xopt;
   const double precision_offset = 1e-7; /* Needed to avoid issues with rounding doubles */
   int n;
-  size_t i;
+  size_t i, k, table_size, number_of_values = 0;
+  double *values;
 
   data = (transform_vars_discretize_data_t *)coco_allocate_memory(sizeof(*data));
-  data->offset = coco_allocate_vector(inner_problem->number_of_variables);
+  data->coordinates = (transform_vars_discretize_coordinate_t *)coco_allocate_memory(
+      number_of_integer_variables * sizeof(transform_vars_discretize_coordinate_t));
+  data->values = NULL;
+  data->cache = NULL;
 
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_discretize_free,
                                               "transform_vars_discretize");
@@ -109,20 +170,25 @@ static coco_problem_t *transform_vars_discretize(coco_problem_t *inner_problem,
     assert(smallest_values_of_interest[i] < largest_values_of_interest[i]);
     problem->smallest_values_of_interest[i] = smallest_values_of_interest[i];
     problem->largest_values_of_interest[i] = largest_values_of_interest[i];
-    data->offset[i] = 0;
     if (i < number_of_integer_variables) {
-      /* Compute the offset for integer variables */
+      /* Compute the map and the offset for integer variables */
+      coordinate = &data->coordinates[i];
       outer_l = problem->smallest_values_of_interest[i];
       outer_u = problem->largest_values_of_interest[i];
       l = inner_problem->smallest_values_of_interest[i];
       u = inner_problem->largest_values_of_interest[i];
       n = coco_double_to_int(outer_u) - coco_double_to_int(outer_l) + 1; /* number of integer values */
       assert(n > 1);
-      inner_l = l + (u - l) / (n + 1);
-      inner_u = u - (u - l) / (n + 1);
+      coordinate->outer_l = outer_l;
+      coordinate->outer_u = outer_u;
+      coordinate->inner_l = l + (u - l) / (n + 1);
+      coordinate->inner_u = u - (u - l) / (n + 1);
+      coordinate->offset = 0;
+      coordinate->values = NULL;
       /* Find the location of the optimum in the coordinates of the outer problem */
       inner_xopt = inner_problem->best_parameter[i];
-      outer_xopt = outer_l + (outer_u - outer_l) * (inner_xopt - inner_l) / (inner_u - inner_l);
+      outer_xopt = outer_l + (outer_u - outer_l) * (inner_xopt - coordinate->inner_l) /
+                                 (coordinate->inner_u - coordinate->inner_l);
       outer_xopt = coco_double_round(outer_xopt + precision_offset);
       /* Make sure you the bounds are respected */
       if (outer_xopt < outer_l)
@@ -131,12 +197,33 @@ static coco_problem_t *transform_vars_discretize(coco_problem_t *inner_problem,
         outer_xopt = outer_u;
       problem->best_parameter[i] = outer_xopt;
       /* Find the value corresponding to outer_xopt in the coordinates of the inner problem */
-      inner_approx_xopt = inner_l + (inner_u - inner_l) * (outer_xopt - outer_l) / (outer_u - outer_l);
+      inner_approx_xopt = transform_vars_discretize_map(coordinate, outer_xopt);
       /* Compute the difference between the inner_approx_xopt and inner_xopt */
-      data->offset[i] = inner_approx_xopt - inner_xopt;
+      coordinate->offset = inner_approx_xopt - inner_xopt;
+      number_of_values += transform_vars_discretize_get_table_size(coordinate);
+    }
+  }
+
+  /* Tabulate the values of the coordinates with integer bounds (the same values as computed by the map) */
+  if (number_of_values > 0) {
+    data->values = coco_allocate_vector(number_of_values);
+    values = data->values;
+    for (i = 0; i < number_of_integer_variables; i++) {
+      coordinate = &data->coordinates[i];
+      table_size = transform_vars_discretize_get_table_size(coordinate);
+      if (table_size == 0)
+        continue;
+      for (k = 0; k < table_size; k++)
+        values[k] = transform_vars_discretize_map(coordinate, coordinate->outer_l + (double)k);
+      coordinate->values = values;
+      values += table_size;
     }
   }
 
+  if (cache_size > 0)
+    data->cache = coco_evaluation_cache_allocate(cache_size, problem->number_of_variables,
+                                                 problem->number_of_objectives);
+
   if (inner_problem->number_of_objectives > 0)
     problem->evaluate_function = transform_vars_discretize_evaluate_function;
 
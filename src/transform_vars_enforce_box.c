@@ -13,7 +13,6 @@
  */
 static void transform_vars_enforce_box_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
   size_t i;
-  double *cons_values;
   int is_feasible;
   coco_problem_t *inner_problem;
 
@@ -35,9 +34,7 @@ static void transform_vars_enforce_box_evaluate_function(coco_problem_t *problem
   coco_evaluate_function(inner_problem, x, y);
 
   if (problem->number_of_constraints > 0) {
-    cons_values = coco_allocate_vector(problem->number_of_constraints);
-    is_feasible = coco_is_feasible(problem, x, cons_values);
-    coco_free_memory(cons_values);
+    is_feasible = coco_is_feasible(problem, x, NULL);
     if (is_feasible) {
       assert(y[0] + 1e-13 >= problem->best_value[0]);
     }
@@ -9,6 +9,7 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "f_gallagher_peaks.c"
 #include "transform_vars_blockrotation_helpers.c"
 /* #include "coco_utilities.c" */
 
@@ -32,8 +33,7 @@ static void transform_vars_gallagher_blockrotation_free(void *thing) {
  */
 typedef struct {
   double *x;
-  size_t number_of_peaks;
-  coco_problem_t **sub_problems;
+  f_gallagher_peaks_t *peaks;
   double *rotated_x;
   size_t nb_blocks, *block_sizes, *block_size_map, *first_non_zero_map;
   double **B;
@@ -43,13 +43,9 @@ typedef struct {
  * @brief allows to free the gallagher_versatile_data part of the problem.
  */
 static void f_gallagher_versatile_data_free(coco_problem_t *problem) {
-  size_t i;
   f_gallagher_versatile_data_t *versatile_data = (f_gallagher_versatile_data_t *)problem->versatile_data;
-  if (versatile_data->sub_problems != NULL) {
-    for (i = 0; i < versatile_data->number_of_peaks; i++) {
-      coco_problem_free(versatile_data->sub_problems[i]);
-    }
-    coco_free_memory(versatile_data->sub_problems);
+  if (versatile_data->peaks != NULL) {
+    f_gallagher_peaks_free(versatile_data->peaks);
   }
   if (versatile_data->rotated_x != NULL) {
     coco_free_memory(versatile_data->rotated_x);
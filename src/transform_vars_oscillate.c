@@ -11,6 +11,7 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_simd.c"
 #include "brentq.c"
 
 /**
@@ -48,6 +49,23 @@ static double tosz_uv(double xi, tosz_data *d) {
   return yi;
 }
 
+/**
+ * @brief Derivative of the univariate oscillating non-linear transformation tosz_uv.
+ *
+ * At 0, where tosz_uv oscillates infinitely often, the derivative is taken to be 1.
+ */
+static double tosz_uv_derivative(double xi, tosz_data *d) {
+  double tmp;
+  if (xi > 0.0) {
+    tmp = log(xi) / d->alpha;
+    return tosz_uv(xi, d) / xi * (1.0 + 0.49 * (cos(tmp) + 0.79 * cos(0.79 * tmp)));
+  } else if (xi < 0.0) {
+    tmp = log(-xi) / d->alpha;
+    return tosz_uv(xi, d) / xi * (1.0 + 0.49 * (0.55 * cos(0.55 * tmp) + 0.31 * cos(0.31 * tmp)));
+  }
+  return 1.0;
+}
+
 /**
  * @brief Inverse of oscillating non-linear transformation tosz_uv obtained with brentq.
  */
@@ -57,27 +75,72 @@ static double tosz_uv_inv(double yi, tosz_data *d) {
   return xi;
 }
 
+#if COCO_SIMD_ENABLED
+/**
+ * @brief SIMD version of the coordinate-wise oscillating transformation of the n values in x into y, which
+ * may be x.
+ *
+ * Blocks with values outside of the range of the vector functions (zeros, for example) and the remaining
+ * values are transformed with tosz_uv().
+ */
+COCO_SIMD_INLINE int tosz_simd_body(const double *x, double *y, const size_t n, const double alpha) {
+  size_t i, j;
+  tosz_data d;
+
+  d.alpha = alpha;
+  for (i = 0; i + COCO_SIMD_WIDTH <= n; i += COCO_SIMD_WIDTH) {
+    const coco_simd_vector_t xi = coco_simd_load(x + i);
+    const coco_simd_bits_t is_positive = (coco_simd_bits_t)(xi > 0.0);
+    const coco_simd_vector_t abs_xi = COCO_SIMD_ABS(xi);
+    coco_simd_bits_t invalid = {0};
+    coco_simd_vector_t tmp, tmp1, tmp2, base, yi;
+
+    tmp = coco_simd_log(&abs_xi, &invalid) / alpha;
+    tmp1 = COCO_SIMD_SELECT(is_positive, tmp, 0.55 * tmp);
+    tmp2 = COCO_SIMD_SELECT(is_positive, 0.79 * tmp, 0.31 * tmp);
+    base = tmp + 0.49 * (coco_simd_sin(&tmp1, &invalid) + coco_simd_sin(&tmp2, &invalid));
+    /* pow(exp(base), alpha) overflows in the scalar code for large values */
+    invalid |= COCO_SIMD_OUTSIDE(base, -700.0, 700.0);
+    base *= alpha;
+    yi = coco_simd_exp(&base, &invalid);
+    yi = COCO_SIMD_SELECT(is_positive, yi, -yi);
+    if (coco_simd_any(&invalid)) {
+      for (j = i; j < i + COCO_SIMD_WIDTH; ++j)
+        y[j] = tosz_uv(x[j], &d);
+    } else {
+      coco_simd_store(y + i, &yi);
+    }
+  }
+  for (; i < n; ++i)
+    y[i] = tosz_uv(x[i], &d);
+  return 1;
+}
+
+COCO_SIMD_DEFINE_KERNEL(tosz_simd, (const double *x, double *y, const size_t n, const double alpha),
+                        (x, y, n, alpha))
+#endif
+
 /**
  * @brief Multivariate, coordinate-wise, oscillating non-linear transformation.
  */
 static void tosz(transform_vars_oscillate_data_t *data, const double *x, size_t number_of_variables) {
   size_t i;
-  tosz_data *d;
-  d = coco_allocate_memory(sizeof(*d));
+  tosz_data d;
 
-  d->alpha = data->alpha;
+  if (COCO_SIMD_RUN(tosz_simd, (x, data->oscillated_x, number_of_variables, data->alpha)))
+    return;
+
+  d.alpha = data->alpha;
 
   for (i = 0; i < number_of_variables; ++i) {
-    data->oscillated_x[i] = tosz_uv(x[i], d);
+    data->oscillated_x[i] = tosz_uv(x[i], &d);
   }
-  coco_free_memory(d);
 }
 
 /**
  * @brief Evaluates the transformed objective functions.
  */
 static void transform_vars_oscillate_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
-  double *cons_values;
   int is_feasible;
   transform_vars_oscillate_data_t *data;
   coco_problem_t *inner_problem;
@@ -96,15 +159,87 @@ static void transform_vars_oscillate_evaluate_function(coco_problem_t *problem,
   coco_evaluate_function(inner_problem, data->oscillated_x, y);
 
   if (problem->number_of_constraints > 0) {
-    cons_values = coco_allocate_vector(problem->number_of_constraints);
-    is_feasible = coco_is_feasible(problem, x, cons_values);
-    coco_free_memory(cons_values);
+    is_feasible = coco_is_feasible(problem, x, NULL);
     if (is_feasible)
       assert(y[0] + 1e-13 >= problem->best_value[0]);
   } else
     assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformed objective functions in a batch of points.
+ */
+static void transform_vars_oscillate_evaluate_function_batch(coco_problem_t *problem, const double *x, double *y,
+                                                             const size_t number_of_points) {
+  size_t i;
+  tosz_data d;
+  transform_vars_oscillate_data_t *data;
+  double *oscillated_x;
+
+  data = (transform_vars_oscillate_data_t *)coco_problem_transformed_get_data(problem);
+  oscillated_x = coco_problem_transformed_get_batch_buffer(problem, number_of_points * problem->number_of_variables);
+
+  d.alpha = data->alpha;
+  if (!COCO_SIMD_RUN(tosz_simd, (x, oscillated_x, number_of_points * problem->number_of_variables, d.alpha))) {
+    for (i = 0; i < number_of_points * problem->number_of_variables; ++i) {
+      oscillated_x[i] = tosz_uv(x[i], &d);
+    }
+  }
+
+  coco_evaluate_function_batch(coco_problem_transformed_get_inner_problem(problem), oscillated_x, y,
+                               number_of_points);
+
+  for (i = 0; i < number_of_points; ++i)
+    assert(y[i * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+}
+
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_vars_oscillate_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  tosz_data d;
+  transform_vars_oscillate_data_t *data;
+
+  if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
+    coco_vector_set_to_nan(y, coco_problem_get_dimension(problem));
+    return;
+  }
+
+  data = (transform_vars_oscillate_data_t *)coco_problem_transformed_get_data(problem);
+
+  tosz(data, x, problem->number_of_variables);
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->oscillated_x, y);
+
+  /* The transformation is coordinate-wise, so that its Jacobian is diagonal */
+  d.alpha = data->alpha;
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= tosz_uv_derivative(x[i], &d);
+  }
+}
+
+/**
+ * @brief Evaluates the transformed function and its gradient.
+ */
+static void transform_vars_oscillate_evaluate_function_and_gradient(coco_problem_t *problem, const double *x,
+                                                                    double *y, double *gradient) {
+  size_t i;
+  tosz_data d;
+  transform_vars_oscillate_data_t *data;
+
+  data = (transform_vars_oscillate_data_t *)coco_problem_transformed_get_data(problem);
+
+  tosz(data, x, problem->number_of_variables);
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), data->oscillated_x, y,
+                                      gradient);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+
+  d.alpha = data->alpha;
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    gradient[i] *= tosz_uv_derivative(x[i], &d);
+  }
+}
+
 /**
  * @brief Evaluates the transformed constraints.
  */
@@ -138,7 +273,7 @@ static void transform_vars_oscillate_evaluate_constraint(coco_problem_t *problem
       oscillated_x[i] = 0.0;
     }
   }
-  inner_problem->evaluate_constraint(inner_problem, oscillated_x, y, update_counter);
+  coco_evaluate_constraint_memoized(inner_problem, oscillated_x, y, update_counter);
 }
 
 /**
@@ -165,6 +300,14 @@ static coco_problem_t *transform_vars_oscillate(coco_problem_t *inner_problem) {
   if (inner_problem->number_of_objectives > 0)
     problem->evaluate_function = transform_vars_oscillate_evaluate_function;
 
+  if (inner_problem->number_of_objectives > 0 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_batch = transform_vars_oscillate_evaluate_function_batch;
+
+  problem->evaluate_gradient = transform_vars_oscillate_evaluate_gradient;
+
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_vars_oscillate_evaluate_function_and_gradient;
+
   if (inner_problem->number_of_constraints > 0)
     problem->evaluate_constraint = transform_vars_oscillate_evaluate_constraint;
 
@@ -7,14 +7,19 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_cache.c"
 #include "transform_vars_permutation_helpers.c"
+#include "transform_vars_blockrotation.c"
 
 /**
  * @brief Data type for transform_vars_permutation.
  */
 typedef struct {
   double *x;
-  size_t *P; /**< @brief the permutation matrices*/
+  const size_t *P; /**< @brief the permutation, either P_copy or data from the instance cache */
+  size_t *P_copy;  /**< @brief the copy of the permutation if it is not cached and NULL otherwise */
+  coco_problem_t *fused_inner_problem; /**< @brief the problem evaluated after a fused block rotation (or NULL) */
+  size_t *fused_output_index;          /**< @brief where the fused block rotation stores its output (or NULL) */
 } transform_vars_permutation_t;
 
 static void transform_vars_permutation_evaluate(coco_problem_t *problem, const double *x, double *y) {
@@ -32,57 +37,153 @@ static void transform_vars_permutation_evaluate(coco_problem_t *problem, const d
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
-static void transform_vars_permutation_free(void *thing) {
-  transform_vars_permutation_t *data = (transform_vars_permutation_t *)thing;
-  coco_free_memory(data->x);
-  coco_free_memory(data->P);
-}
-
-static coco_problem_t *transform_vars_permutation(coco_problem_t *inner_problem, const size_t *P,
-                                                  const size_t number_of_variables) {
-  coco_problem_t *problem;
+/**
+ * @brief Evaluates the gradient of the transformed function, which is the gradient of the inner function
+ * permuted back.
+ */
+static void transform_vars_permutation_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
   transform_vars_permutation_t *data;
+  coco_problem_t *inner_problem;
+  double *gradient;
 
-  assert(number_of_variables == inner_problem->number_of_variables); /*tmp*/
+  data = (transform_vars_permutation_t *)coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  assert(problem->scratch_size >= inner_problem->number_of_variables);
+  gradient = problem->scratch;
 
-  data = (transform_vars_permutation_t *)coco_allocate_memory(sizeof(*data));
-  data->x = coco_allocate_vector(number_of_variables);
-  data->P = coco_duplicate_size_t_vector(P, number_of_variables);
+  for (i = 0; i < inner_problem->number_of_variables; ++i) {
+    data->x[i] = x[data->P[i]];
+  }
+  bbob_evaluate_gradient(inner_problem, data->x, gradient);
 
-  problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_permutation_free,
-                                              "transform_vars_permutation");
-  problem->evaluate_function = transform_vars_permutation_evaluate;
-  return problem;
+  for (i = 0; i < inner_problem->number_of_variables; ++i) {
+    y[data->P[i]] = gradient[i];
+  }
 }
 
-static void transform_vars_inverse_permutation_evaluate(coco_problem_t *problem, const double *x, double *y) {
+/**
+ * @brief Evaluates the transformed function and its gradient.
+ */
+static void transform_vars_permutation_evaluate_function_and_gradient(coco_problem_t *problem, const double *x,
+                                                                      double *y, double *gradient) {
   size_t i;
   transform_vars_permutation_t *data;
   coco_problem_t *inner_problem;
+  double *inner_gradient;
 
   data = (transform_vars_permutation_t *)coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  assert(problem->scratch_size >= inner_problem->number_of_variables);
+  inner_gradient = problem->scratch;
+
   for (i = 0; i < inner_problem->number_of_variables; ++i) {
-    data->x[data->P[i]] = x[i];
+    data->x[i] = x[data->P[i]];
   }
-
-  coco_evaluate_function(inner_problem, data->x, y);
+  coco_evaluate_function_and_gradient(inner_problem, data->x, y, inner_gradient);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
+
+  for (i = 0; i < inner_problem->number_of_variables; ++i) {
+    gradient[data->P[i]] = inner_gradient[i];
+  }
 }
 
-static coco_problem_t *transform_vars_inverse_permutation(coco_problem_t *inner_problem, const size_t *P,
-                                                          const size_t number_of_variables) {
-  coco_problem_t *problem;
+/**
+ * @brief Evaluates the permutation together with the block rotation it wraps (and the permutation the block
+ * rotation wraps, if any) in a single pass of the block rotation kernel.
+ *
+ * The fused layers are skipped, so that their counters are not updated (nobody looks at them). Their checks
+ * of the input for INFINITY and NAN values are left to the next layer, which sees a permutation of the same
+ * values, so that the result does not change.
+ */
+static void transform_vars_permutation_blockrotation_evaluate(coco_problem_t *problem, const double *x,
+                                                              double *y) {
   transform_vars_permutation_t *data;
 
-  assert(number_of_variables == inner_problem->number_of_variables);
+  data = (transform_vars_permutation_t *)coco_problem_transformed_get_data(problem);
+  transform_vars_blockrotation_multiply(coco_problem_transformed_get_inner_problem(problem), x, data->P, data->x,
+                                        data->fused_output_index);
+
+  coco_evaluate_function(data->fused_inner_problem, data->x, y);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
+static void transform_vars_permutation_free(void *thing) {
+  transform_vars_permutation_t *data = (transform_vars_permutation_t *)thing;
+  coco_free_memory(data->x);
+  if (data->fused_output_index != NULL)
+    coco_free_memory(data->fused_output_index);
+  if (data->P_copy == NULL)
+    coco_cache_release(data->P);
+  else
+    coco_free_memory(data->P_copy);
+}
+
+/**
+ * @brief Allocates the data of the transformation, which shares P if it has been obtained from the instance
+ * cache and copies it otherwise.
+ */
+static transform_vars_permutation_t *transform_vars_permutation_allocate_data(const size_t *P,
+                                                                              const size_t number_of_variables) {
+  transform_vars_permutation_t *data;
 
   data = (transform_vars_permutation_t *)coco_allocate_memory(sizeof(*data));
   data->x = coco_allocate_vector(number_of_variables);
-  data->P = coco_duplicate_size_t_vector(P, number_of_variables);
+  if (coco_cache_retain(P)) {
+    data->P = P;
+    data->P_copy = NULL;
+  } else {
+    data->P_copy = coco_duplicate_size_t_vector(P, number_of_variables);
+    data->P = data->P_copy;
+  }
+  data->fused_inner_problem = NULL;
+  data->fused_output_index = NULL;
+  return data;
+}
+
+/**
+ * @brief Fuses the permutation with the block rotation it wraps, and with the permutation that the block
+ * rotation wraps, if any.
+ */
+static void transform_vars_permutation_fuse_blockrotation(coco_problem_t *problem) {
+  transform_vars_permutation_t *data, *inner_data;
+  coco_problem_t *blockrotation, *inner_problem;
+  size_t i;
+
+  blockrotation = coco_problem_transformed_get_inner_problem(problem);
+  if (blockrotation->evaluate_function != transform_vars_blockrotation_evaluate ||
+      problem->number_of_constraints > 0)
+    return;
+
+  data = (transform_vars_permutation_t *)coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(blockrotation);
+  data->fused_inner_problem = inner_problem;
+  if (inner_problem->evaluate_function == transform_vars_permutation_evaluate) {
+    /* The inner permutation reads (Bx)[P[i]] into position i */
+    inner_data = (transform_vars_permutation_t *)coco_problem_transformed_get_data(inner_problem);
+    data->fused_output_index = coco_allocate_vector_size_t(problem->number_of_variables);
+    for (i = 0; i < problem->number_of_variables; ++i)
+      data->fused_output_index[inner_data->P[i]] = i;
+    data->fused_inner_problem = coco_problem_transformed_get_inner_problem(inner_problem);
+  }
+  problem->evaluate_function = transform_vars_permutation_blockrotation_evaluate;
+}
+
+static coco_problem_t *transform_vars_permutation(coco_problem_t *inner_problem, const size_t *P,
+                                                  const size_t number_of_variables) {
+  coco_problem_t *problem;
+  transform_vars_permutation_t *data;
+
+  assert(number_of_variables == inner_problem->number_of_variables); /*tmp*/
+
+  data = transform_vars_permutation_allocate_data(P, number_of_variables);
 
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_permutation_free,
-                                              "transform_vars_inverse_permutation");
-  problem->evaluate_function = transform_vars_inverse_permutation_evaluate;
+                                              "transform_vars_permutation");
+  problem->evaluate_function = transform_vars_permutation_evaluate;
+  problem->evaluate_gradient = transform_vars_permutation_evaluate_gradient;
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_vars_permutation_evaluate_function_and_gradient;
+  transform_vars_permutation_fuse_blockrotation(problem);
   return problem;
 }
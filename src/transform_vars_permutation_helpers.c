@@ -15,13 +15,22 @@
 
 /* TODO: Document this file in doxygen style! */
 
-static double *perm_random_data; /* global variable used to generate the random permutations */
+/**
+ * @brief A value together with its index, sorted to obtain the permutation that sorts the values.
+ *
+ * Keeping the value next to the index (instead of in a global array indexed by the comparison function)
+ * allows to compute permutations from several threads at the same time.
+ */
+typedef struct {
+  double value; /**< @brief The value used for sorting */
+  size_t index; /**< @brief The index of the value before sorting */
+} coco_permutation_item_t;
 
 /**
  * @brief Comparison function used for sorting. In our case, it serves as a random permutation generator
  */
 static int f_compare_doubles_for_random_permutation(const void *a, const void *b) {
-  double temp = perm_random_data[*(const size_t *)a] - perm_random_data[*(const size_t *)b];
+  double temp = ((const coco_permutation_item_t *)a)->value - ((const coco_permutation_item_t *)b)->value;
   if (temp > 0)
     return 1;
   else if (temp < 0)
@@ -31,34 +40,42 @@ static int f_compare_doubles_for_random_permutation(const void *a, const void *b
 }
 
 /**
- * @brief generates a random, uniformly sampled, permutation and puts it in P
- * Wassim: move to coco_utilities?
+ * @brief Puts the permutation that sorts the given n values in P
  */
-static void coco_compute_random_permutation(size_t *P, long seed, size_t n) {
+static void coco_compute_sorting_permutation(size_t *P, const double *values, size_t n) {
   size_t i;
+  coco_permutation_item_t *items;
 
-  perm_random_data = coco_allocate_vector(n);
-  bbob2009_gauss(perm_random_data, n, seed);
+  items = (coco_permutation_item_t *)coco_allocate_memory(n * sizeof(*items));
   for (i = 0; i < n; i++) {
-    P[i] = i;
+    items[i].value = values[i];
+    items[i].index = i;
+  }
+  qsort(items, n, sizeof(*items), f_compare_doubles_for_random_permutation);
+  for (i = 0; i < n; i++) {
+    P[i] = items[i].index;
   }
-  qsort(P, n, sizeof(size_t), f_compare_doubles_for_random_permutation);
-  coco_free_memory(perm_random_data);
+  coco_free_memory(items);
+}
+
+/**
+ * @brief generates a random, uniformly sampled, permutation and puts it in P
+ * Wassim: move to coco_utilities?
+ */
+static void coco_compute_random_permutation(size_t *P, long seed, size_t n) {
+  double *random_data;
+
+  random_data = coco_allocate_vector(n);
+  bbob2009_gauss(random_data, n, seed);
+  coco_compute_sorting_permutation(P, random_data, n);
+  coco_free_memory(random_data);
 }
 
 /**
  * @brief generates a permutation by sorting a sequence and puts it in P
  */
 static void coco_compute_permutation_from_sequence(size_t *P, double *seq, size_t length) {
-  size_t i;
-
-  perm_random_data = coco_allocate_vector(length);
-  for (i = 0; i < length; i++) {
-    P[i] = i;
-    perm_random_data[i] = seq[i];
-  }
-  qsort(P, length, sizeof(size_t), f_compare_doubles_for_random_permutation);
-  coco_free_memory(perm_random_data);
+  coco_compute_sorting_permutation(P, seq, length);
 }
 
 /**
@@ -88,6 +105,7 @@ static void coco_compute_truncated_uniform_swap_permutation(size_t *P, long seed
   size_t i, idx_swap;
   size_t lower_bound, upper_bound, first_swap_var, second_swap_var, tmp;
   size_t *idx_order;
+  double *random_data;
 
   if (n <= 40) {
     /* Do an identity permutation for dimensions <= 40 */
@@ -96,19 +114,18 @@ static void coco_compute_truncated_uniform_swap_permutation(size_t *P, long seed
     return;
   }
 
-  perm_random_data = coco_allocate_vector(n);
-  bbob2009_unif(perm_random_data, n, seed);
+  random_data = coco_allocate_vector(n);
+  bbob2009_unif(random_data, n, seed);
 
   idx_order = coco_allocate_vector_size_t(n);
   for (i = 0; i < n; i++) {
     P[i] = i;
-    idx_order[i] = i;
   }
 
   if (swap_range > 0) {
-    /*sort the random data in perm_random_data and arrange idx_order accordingly*/
+    /*sort the random data and arrange idx_order accordingly*/
     /*did not use coco_compute_random_permutation to only use the seed once*/
-    qsort(idx_order, n, sizeof(size_t), f_compare_doubles_for_random_permutation);
+    coco_compute_sorting_permutation(idx_order, random_data, n);
     for (idx_swap = 0; idx_swap < nb_swaps; idx_swap++) {
       first_swap_var = idx_order[idx_swap];
       if (first_swap_var < swap_range) {
@@ -137,7 +154,7 @@ static void coco_compute_truncated_uniform_swap_permutation(size_t *P, long seed
     coco_compute_random_permutation(P, seed, n);
   }
   coco_free_memory(idx_order);
-  coco_free_memory(perm_random_data);
+  coco_free_memory(random_data);
 }
 
 /**
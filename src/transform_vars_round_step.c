@@ -23,12 +23,14 @@ typedef struct {
  */
 typedef struct {
   double zhat_1; /**< @brief contains the value of \hat{z}_1 that is used to compute the fintess */
+  double zhat_1_derivative; /**< @brief the derivative of the fitness with respect to \hat{z}_1 (set by the
+                                 gradient of the core function) */
 } f_step_ellipsoid_versatile_data_t;
 
 /**
- * @brief Evaluates the transformation.
+ * @brief Sets \hat{z}_1 in the versatile data and rounds x into data->rounded_x.
  */
-static void transform_vars_round_step_evaluate(coco_problem_t *problem, const double *x, double *y) {
+static void transform_vars_round_step_apply(coco_problem_t *problem, const double *x) {
   size_t i;
   transform_vars_round_step_data_t *data;
   coco_problem_t *inner_problem;
@@ -49,10 +51,42 @@ static void transform_vars_round_step_evaluate(coco_problem_t *problem, const do
       data->rounded_x[i] = coco_double_round(data->alpha * x[i]) / data->alpha;
     }
   }
-  coco_evaluate_function(inner_problem, data->rounded_x, y);
+}
+
+/**
+ * @brief Evaluates the transformation.
+ */
+static void transform_vars_round_step_evaluate(coco_problem_t *problem, const double *x, double *y) {
+  transform_vars_round_step_data_t *data;
+
+  data = (transform_vars_round_step_data_t *)coco_problem_transformed_get_data(problem);
+  transform_vars_round_step_apply(problem, x);
+  coco_evaluate_function(coco_problem_transformed_get_inner_problem(problem), data->rounded_x, y);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ *
+ * The rounded variables are piecewise constant, so that the gradient is zero except for the dependence of
+ * the function on \hat{z}_1 = d |x[0]|, whose derivative is set by the gradient of the inner function.
+ */
+static void transform_vars_round_step_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  transform_vars_round_step_data_t *data;
+  f_step_ellipsoid_versatile_data_t *versatile_data;
+
+  data = (transform_vars_round_step_data_t *)coco_problem_transformed_get_data(problem);
+  versatile_data = (f_step_ellipsoid_versatile_data_t *)problem->versatile_data;
+  transform_vars_round_step_apply(problem, x);
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->rounded_x, y);
+
+  for (i = 0; i < problem->number_of_variables; ++i)
+    y[i] = 0.0;
+  if (x[0] != 0.0)
+    y[0] = versatile_data->zhat_1_derivative * (double)problem->number_of_variables * ((x[0] > 0.0) ? 1.0 : -1.0);
+}
+
 /**
  * @brief Frees the data object.
  */
@@ -76,6 +110,7 @@ static coco_problem_t *transform_vars_round_step(coco_problem_t *inner_problem,
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_round_step_free,
                                               "transform_vars_round_step");
   problem->evaluate_function = transform_vars_round_step_evaluate;
+  problem->evaluate_gradient = transform_vars_round_step_evaluate_gradient;
   /* Compute best parameter */
   for (i = 0; i < problem->number_of_variables; i++) {
     if (fabs(problem->best_parameter[i]) > 0.5) {
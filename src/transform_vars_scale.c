@@ -42,6 +42,44 @@ static void transform_vars_scale_evaluate(coco_problem_t *problem, const double
   } while (0);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_vars_scale_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  transform_vars_scale_data_t *data;
+
+  data = (transform_vars_scale_data_t *)coco_problem_transformed_get_data(problem);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    data->x[i] = data->factor * x[i];
+  }
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y);
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= data->factor;
+  }
+}
+
+/**
+ * @brief Evaluates the transformed function and its gradient.
+ */
+static void transform_vars_scale_evaluate_function_and_gradient(coco_problem_t *problem, const double *x,
+                                                                double *y, double *gradient) {
+  size_t i;
+  transform_vars_scale_data_t *data;
+
+  data = (transform_vars_scale_data_t *)coco_problem_transformed_get_data(problem);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    data->x[i] = data->factor * x[i];
+  }
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y, gradient);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    gradient[i] *= data->factor;
+  }
+}
+
 /**
  * @brief Frees the data object.
  */
@@ -63,6 +101,9 @@ static coco_problem_t *transform_vars_scale(coco_problem_t *inner_problem, const
 
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_scale_free, "transform_vars_scale");
   problem->evaluate_function = transform_vars_scale_evaluate;
+  problem->evaluate_gradient = transform_vars_scale_evaluate_gradient;
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_vars_scale_evaluate_function_and_gradient;
   /* Compute best parameter */
   if (data->factor != 0.) {
     for (i = 0; i < problem->number_of_variables; i++) {
@@ -21,7 +21,6 @@ typedef struct {
  */
 static void transform_vars_shift_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
   size_t i;
-  double *cons_values;
   int is_feasible;
   transform_vars_shift_data_t *data;
   coco_problem_t *inner_problem;
@@ -41,15 +40,38 @@ static void transform_vars_shift_evaluate_function(coco_problem_t *problem, cons
   coco_evaluate_function(inner_problem, data->shifted_x, y);
 
   if (problem->number_of_constraints > 0) {
-    cons_values = coco_allocate_vector(problem->number_of_constraints);
-    is_feasible = coco_is_feasible(problem, x, cons_values);
-    coco_free_memory(cons_values);
+    is_feasible = coco_is_feasible(problem, x, NULL);
     if (is_feasible)
       assert(y[0] + 1e-13 >= problem->best_value[0]);
   } else
     assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformed objective function in a batch of points.
+ */
+static void transform_vars_shift_evaluate_function_batch(coco_problem_t *problem, const double *x, double *y,
+                                                         const size_t number_of_points) {
+  size_t i, k;
+  const size_t n = problem->number_of_variables;
+  transform_vars_shift_data_t *data;
+  double *shifted_x;
+
+  data = (transform_vars_shift_data_t *)coco_problem_transformed_get_data(problem);
+  shifted_x = coco_problem_transformed_get_batch_buffer(problem, number_of_points * n);
+
+  for (k = 0; k < number_of_points; ++k) {
+    for (i = 0; i < n; ++i) {
+      shifted_x[k * n + i] = x[k * n + i] - data->offset[i];
+    }
+  }
+
+  coco_evaluate_function_batch(coco_problem_transformed_get_inner_problem(problem), shifted_x, y, number_of_points);
+
+  for (k = 0; k < number_of_points; ++k)
+    assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Evaluates the transformed constraint function.
  */
@@ -70,7 +92,7 @@ static void transform_vars_shift_evaluate_constraint(coco_problem_t *problem, co
   for (i = 0; i < problem->number_of_variables; ++i) {
     data->shifted_x[i] = x[i] - data->offset[i];
   }
-  inner_problem->evaluate_constraint(inner_problem, data->shifted_x, y, update_counter);
+  coco_evaluate_constraint_memoized(inner_problem, data->shifted_x, y, update_counter);
 }
 
 /**
@@ -95,6 +117,22 @@ static void transform_vars_shift_evaluate_gradient(coco_problem_t *problem, cons
   bbob_evaluate_gradient(inner_problem, data->shifted_x, y);
 }
 
+/**
+ * @brief Evaluates the transformed function and its gradient at x.
+ */
+static void transform_vars_shift_evaluate_function_and_gradient(coco_problem_t *problem, const double *x,
+                                                                double *y, double *gradient) {
+  size_t i;
+  transform_vars_shift_data_t *data = (transform_vars_shift_data_t *)coco_problem_transformed_get_data(problem);
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    data->shifted_x[i] = x[i] - data->offset[i];
+  }
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), data->shifted_x, y,
+                                      gradient);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Frees the data object.
  */
@@ -125,11 +163,19 @@ static coco_problem_t *transform_vars_shift(coco_problem_t *inner_problem, const
   if (inner_problem->number_of_objectives > 0 && shift_constraint_only == 0)
     problem->evaluate_function = transform_vars_shift_evaluate_function;
 
+  if (inner_problem->number_of_objectives > 0 && shift_constraint_only == 0 &&
+      inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_batch = transform_vars_shift_evaluate_function_batch;
+
   if (inner_problem->number_of_constraints > 0)
     problem->evaluate_constraint = transform_vars_shift_evaluate_constraint;
 
   problem->evaluate_gradient = transform_vars_shift_evaluate_gradient;
 
+  if (inner_problem->number_of_objectives == 1 && shift_constraint_only == 0 &&
+      inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_vars_shift_evaluate_function_and_gradient;
+
   /* Update the best parameter */
   for (i = 0; i < problem->number_of_variables; i++)
     problem->best_parameter[i] += data->offset[i];
@@ -48,6 +48,64 @@ static void transform_vars_x_hat_evaluate(coco_problem_t *problem, const double
   } while (0);
 }
 
+/**
+ * @brief Computes the transformed decision vector in data->x and the signs by which the coordinates of x
+ * are multiplied in signs.
+ */
+static void transform_vars_x_hat_apply(coco_problem_t *problem, const double *x, double *signs) {
+  size_t i;
+  transform_vars_x_hat_data_t *data;
+
+  data = (transform_vars_x_hat_data_t *)coco_problem_transformed_get_data(problem);
+  bbob2009_unif(signs, problem->number_of_variables, data->seed);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    signs[i] = (signs[i] < 0.5) ? -1.0 : 1.0;
+    data->x[i] = signs[i] * x[i];
+  }
+}
+
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_vars_x_hat_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  transform_vars_x_hat_data_t *data;
+  double *signs;
+
+  data = (transform_vars_x_hat_data_t *)coco_problem_transformed_get_data(problem);
+  assert(problem->scratch_size >= problem->number_of_variables);
+  signs = problem->scratch;
+
+  transform_vars_x_hat_apply(problem, x, signs);
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y);
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= signs[i];
+  }
+}
+
+/**
+ * @brief Evaluates the transformed function and its gradient.
+ */
+static void transform_vars_x_hat_evaluate_function_and_gradient(coco_problem_t *problem, const double *x,
+                                                                double *y, double *gradient) {
+  size_t i;
+  transform_vars_x_hat_data_t *data;
+  double *signs;
+
+  data = (transform_vars_x_hat_data_t *)coco_problem_transformed_get_data(problem);
+  assert(problem->scratch_size >= problem->number_of_variables);
+  signs = problem->scratch;
+
+  transform_vars_x_hat_apply(problem, x, signs);
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y, gradient);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    gradient[i] *= signs[i];
+  }
+}
+
 /**
  * @brief Frees the data object.
  */
@@ -70,6 +128,9 @@ static coco_problem_t *transform_vars_x_hat(coco_problem_t *inner_problem, const
 
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_x_hat_free, "transform_vars_x_hat");
   problem->evaluate_function = transform_vars_x_hat_evaluate;
+  problem->evaluate_gradient = transform_vars_x_hat_evaluate_gradient;
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_vars_x_hat_evaluate_function_and_gradient;
   if (coco_problem_best_parameter_not_zero(problem)) {
     bbob2009_unif(data->x, problem->number_of_variables, data->seed);
     for (i = 0; i < problem->number_of_variables; ++i)
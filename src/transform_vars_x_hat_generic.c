@@ -27,6 +27,7 @@ typedef struct {
   coco_problem_t *sub_problem_mu0;
   coco_problem_t *sub_problem_mu1;
   double *x_hat;
+  double *x_hat_gradient; /**< @brief The gradient of the core function with respect to x_hat */
 } f_lunacek_bi_rastrigin_versatile_data_t;
 
 /**
@@ -47,6 +48,29 @@ static void transform_vars_x_hat_generic_evaluate(coco_problem_t *problem, const
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ *
+ * The core function also depends on x_hat directly, so that its gradient with respect to x_hat is added to
+ * the gradient that is propagated through the inner transformations.
+ */
+static void transform_vars_x_hat_generic_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  transform_vars_x_hat_generic_data_t *data;
+
+  data = (transform_vars_x_hat_generic_data_t *)coco_problem_transformed_get_data(problem);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    data->x[i] = 2.0 * data->sign_vector[i] * x[i];
+    ((f_lunacek_bi_rastrigin_versatile_data_t *)problem->versatile_data)->x_hat[i] = data->x[i];
+  }
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y);
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] += ((f_lunacek_bi_rastrigin_versatile_data_t *)problem->versatile_data)->x_hat_gradient[i];
+    y[i] *= 2.0 * data->sign_vector[i];
+  }
+}
+
 /**
  * @brief Frees the data object.
  */
@@ -74,6 +98,7 @@ static coco_problem_t *transform_vars_x_hat_generic(coco_problem_t *inner_proble
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_x_hat_generic_free,
                                               "transform_vars_x_hat_generic");
   problem->evaluate_function = transform_vars_x_hat_generic_evaluate;
+  problem->evaluate_gradient = transform_vars_x_hat_generic_evaluate_gradient;
 
   return problem;
 }
@@ -42,6 +42,49 @@ static void transform_vars_z_hat_evaluate(coco_problem_t *problem, const double
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_vars_z_hat_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  transform_vars_z_hat_data_t *data;
+
+  data = (transform_vars_z_hat_data_t *)coco_problem_transformed_get_data(problem);
+
+  data->z[0] = x[0];
+  for (i = 1; i < problem->number_of_variables; ++i) {
+    data->z[i] = x[i] + 0.25 * (x[i - 1] - 2.0 * fabs(data->xopt[i - 1]));
+  }
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->z, y);
+
+  /* z[i] depends on x[i] and x[i - 1] */
+  for (i = 0; i + 1 < problem->number_of_variables; ++i) {
+    y[i] += 0.25 * y[i + 1];
+  }
+}
+
+/**
+ * @brief Evaluates the transformed function and its gradient.
+ */
+static void transform_vars_z_hat_evaluate_function_and_gradient(coco_problem_t *problem, const double *x,
+                                                                double *y, double *gradient) {
+  size_t i;
+  transform_vars_z_hat_data_t *data;
+
+  data = (transform_vars_z_hat_data_t *)coco_problem_transformed_get_data(problem);
+
+  data->z[0] = x[0];
+  for (i = 1; i < problem->number_of_variables; ++i) {
+    data->z[i] = x[i] + 0.25 * (x[i - 1] - 2.0 * fabs(data->xopt[i - 1]));
+  }
+  coco_evaluate_function_and_gradient(coco_problem_transformed_get_inner_problem(problem), data->z, y, gradient);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+
+  for (i = 0; i + 1 < problem->number_of_variables; ++i) {
+    gradient[i] += 0.25 * gradient[i + 1];
+  }
+}
+
 /**
  * @brief Frees the data object.
  */
@@ -63,6 +106,9 @@ static coco_problem_t *transform_vars_z_hat(coco_problem_t *inner_problem, const
 
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_z_hat_free, "transform_vars_z_hat");
   problem->evaluate_function = transform_vars_z_hat_evaluate;
+  problem->evaluate_gradient = transform_vars_z_hat_evaluate_gradient;
+  if (inner_problem->number_of_objectives == 1 && inner_problem->number_of_constraints == 0)
+    problem->evaluate_function_and_gradient = transform_vars_z_hat_evaluate_function_and_gradient;
   /* TODO: implement best_parameter transformation if needed in the case of not zero:
      see also issue #814.
   The correct update of best_parameter seems not too difficult and should not anymore
@@ -0,0 +1,141 @@
+/**
+ * Times the pre-processing of bi-objective archives with coco_archive_t: adding solutions one by one while
+ * querying the hypervolume after each addition, adding them one by one and querying the hypervolume only at
+ * the end, and adding them in a single batch with coco_archive_add_solutions().
+ *
+ * For comparison, the queries are also answered by recomputing the hypervolume from the whole archive after
+ * each addition, as coco_archive_get_hypervolume() used to do.
+ */
+#include <stdio.h>
+#include <time.h>
+
+#include "coco.c"
+
+/** Ways of adding the solutions to the archive */
+#define BENCH_QUERY_RECOMPUTED 0
+#define BENCH_QUERY_INCREMENTAL 1
+#define BENCH_ONE_BY_ONE 2
+#define BENCH_BATCH 3
+
+/**
+ * Returns the time in seconds since start.
+ */
+static double bench_seconds_since(const clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Recomputes the hypervolume from all solutions of the archive.
+ */
+static double bench_recompute_hypervolume(coco_archive_t *archive) {
+  mo_front_position_t position;
+  coco_archive_avl_item_t *item, *previous_item;
+  double hypervolume = 0;
+
+  previous_item = (coco_archive_avl_item_t *)mo_front_get_first(archive->front, &position);
+  while ((item = (coco_archive_avl_item_t *)mo_front_get_next(archive->front, &position)) != NULL) {
+    hypervolume += coco_archive_get_contribution(previous_item, item);
+    previous_item = item;
+  }
+  return hypervolume;
+}
+
+/**
+ * Returns the average time in microseconds per solution of adding the solutions to a new archive in the
+ * given way.
+ */
+static double bench_archive(const size_t number_of_solutions, const double *y1, const double *y2,
+                            const char **text, const int way, double *hypervolume) {
+  coco_archive_t *archive;
+  size_t i, repetitions = 0;
+  clock_t start = clock();
+
+  do {
+    archive = coco_archive("bbob-biobj", 1, 10, 1);
+    *hypervolume = 0;
+    if (way == BENCH_BATCH) {
+      coco_archive_add_solutions(archive, number_of_solutions, y1, y2, text);
+    } else {
+      for (i = 0; i < number_of_solutions; i++) {
+        coco_archive_add_solution(archive, y1[i], y2[i], text[i]);
+        if (way == BENCH_QUERY_RECOMPUTED)
+          *hypervolume += bench_recompute_hypervolume(archive);
+        else if (way == BENCH_QUERY_INCREMENTAL)
+          *hypervolume += coco_archive_get_hypervolume(archive);
+      }
+    }
+    if ((way == BENCH_ONE_BY_ONE) || (way == BENCH_BATCH))
+      *hypervolume = coco_archive_get_hypervolume(archive);
+    coco_archive_free(archive);
+    repetitions++;
+  } while (bench_seconds_since(start) < 0.5);
+
+  return 1e6 * bench_seconds_since(start) / (double)(repetitions * number_of_solutions);
+}
+
+/**
+ * Fills y1, y2 and text with solutions near a front that moves towards the ideal point by the given amount
+ * (most solutions are dominated if the front moves, as in the archive of a run, and most solutions are
+ * nondominated otherwise, as when archives of several runs are merged).
+ */
+static void bench_create_solutions(const size_t number_of_solutions, const double movement, double *y1,
+                                   double *y2, char **text) {
+  coco_random_state_t *random_generator = coco_random_new(1);
+  coco_archive_t *archive = coco_archive("bbob-biobj", 1, 10, 1);
+  double t, s;
+  size_t i;
+
+  for (i = 0; i < number_of_solutions; i++) {
+    t = coco_random_uniform(random_generator);
+    s = 1.0 - movement * (double)i / (double)number_of_solutions + 1e-3 * coco_random_uniform(random_generator);
+    y1[i] = archive->ideal[0] + s * t * (archive->nadir[0] - archive->ideal[0]);
+    y2[i] = archive->ideal[1] + s * (1 - t) * (archive->nadir[1] - archive->ideal[1]);
+    text[i] = coco_strdupf("%lu\t%.15e\t%.15e\n", (unsigned long)i + 1, y1[i], y2[i]);
+  }
+  coco_archive_free(archive);
+  coco_random_free(random_generator);
+}
+
+int main(void) {
+  const size_t numbers_of_solutions[] = {1000, 10000, 100000, 1000000};
+  const size_t max_number_of_solutions = 1000000;
+  const double movements[] = {0.1, 0};
+  const char *names[] = {"archive of a run", "merged archives"};
+  double *y1 = coco_allocate_vector(max_number_of_solutions);
+  double *y2 = coco_allocate_vector(max_number_of_solutions);
+  char **text = (char **)coco_allocate_memory(max_number_of_solutions * sizeof(char *));
+  double hypervolume;
+  size_t i, j;
+  int way;
+
+  coco_set_log_level("warning");
+
+  for (j = 0; j < sizeof(movements) / sizeof(movements[0]); j++) {
+    bench_create_solutions(max_number_of_solutions, movements[j], y1, y2, text);
+
+    printf("%sadding solutions to the archive (%s) [us per solution]\n", (j > 0) ? "\n" : "", names[j]);
+    printf("           query after each addition  query at the end\n");
+    printf(" solutions   recomputed  incremental   one by one        batch\n");
+    for (i = 0; i < sizeof(numbers_of_solutions) / sizeof(numbers_of_solutions[0]); i++) {
+      printf("%10lu", (unsigned long)numbers_of_solutions[i]);
+      for (way = BENCH_QUERY_RECOMPUTED; way <= BENCH_BATCH; way++) {
+        if ((way == BENCH_QUERY_RECOMPUTED) && (numbers_of_solutions[i] > 10000)) {
+          printf(" %12s", "-"); /* Takes too long */
+          continue;
+        }
+        printf(" %12.3f",
+               bench_archive(numbers_of_solutions[i], y1, y2, (const char **)text, way, &hypervolume));
+      }
+      printf("\n");
+      fflush(stdout);
+    }
+
+    for (i = 0; i < max_number_of_solutions; i++)
+      coco_free_memory(text[i]);
+  }
+
+  coco_free_memory(text);
+  coco_free_memory(y1);
+  coco_free_memory(y2);
+  return 0;
+}
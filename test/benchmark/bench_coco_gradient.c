@@ -0,0 +1,70 @@
+/**
+ * Times coco_evaluate_function_and_gradient() on bbob and bbob-largescale problems versus the dimension and
+ * compares it with separate calls of coco_evaluate_function() and coco_evaluate_gradient().
+ */
+#include <stdio.h>
+#include <time.h>
+
+#include "coco.c"
+
+/** Minimal time in seconds spent on each measurement */
+#define BENCH_MIN_SECONDS 0.2
+
+/**
+ * Returns the time in seconds since start.
+ */
+static double bench_seconds_since(const clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Returns the average time in microseconds of evaluating the function and its gradient in a point of the
+ * given problem, either with the combined call (if combined is nonzero) or with two separate calls.
+ */
+static double bench_gradient(coco_problem_t *problem, const int combined) {
+  const size_t dimension = coco_problem_get_dimension(problem);
+  double *x = coco_allocate_vector(dimension);
+  double *gradient = coco_allocate_vector(dimension);
+  double y;
+  size_t i, repetitions = 0;
+  clock_t start;
+
+  for (i = 0; i < dimension; i++)
+    x[i] = 0.1 * (double)(i % 7) - 0.3;
+  start = clock();
+  do {
+    x[repetitions % dimension] += 1e-9;
+    if (combined) {
+      coco_evaluate_function_and_gradient(problem, x, &y, gradient);
+    } else {
+      coco_evaluate_function(problem, x, &y);
+      coco_evaluate_gradient(problem, x, gradient);
+    }
+    repetitions++;
+  } while (bench_seconds_since(start) < BENCH_MIN_SECONDS);
+
+  coco_free_memory(x);
+  coco_free_memory(gradient);
+  return 1e6 * bench_seconds_since(start) / (double)repetitions;
+}
+
+int main(void) {
+  const size_t functions[] = {2, 10, 15, 21};
+  const size_t dimensions[] = {10, 40, 160, 640};
+  coco_problem_t *problem;
+  size_t i, j;
+
+  printf("                             separate [us]   combined [us]\n");
+  for (i = 0; i < sizeof(functions) / sizeof(functions[0]); i++) {
+    for (j = 0; j < sizeof(dimensions) / sizeof(dimensions[0]); j++) {
+      problem = dimensions[j] <= 40 ? coco_get_bbob_problem(functions[i], dimensions[j], 1)
+                                    : coco_get_largescale_problem(functions[i], dimensions[j], 1);
+      printf("%-15s f%02lu d%4lu %15.3f %15.3f\n", dimensions[j] <= 40 ? "bbob" : "bbob-largescale",
+             (unsigned long)functions[i], (unsigned long)dimensions[j], bench_gradient(problem, 0),
+             bench_gradient(problem, 1));
+      fflush(stdout);
+      coco_problem_free(problem);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * Compares the throughput of the number formatting used by the loggers (coco_format_exponential()) with the
+ * one of sprintf() and fprintf().
+ */
+#include <stdio.h>
+#include <time.h>
+
+#include "coco.c"
+
+#define BENCH_NUMBER_OF_VALUES 1000000
+
+/**
+ * Returns the time in seconds since start.
+ */
+static double bench_seconds_since(const clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Prints the throughput of both formatting functions for the given precision and width.
+ */
+static void bench_format(const double *values, const int width, const int precision) {
+  char buffer[COCO_FORMAT_MAX_LENGTH];
+  size_t i, checksum = 0;
+  double time_sprintf, time_coco;
+  clock_t start;
+
+  start = clock();
+  for (i = 0; i < BENCH_NUMBER_OF_VALUES; i++)
+    checksum += (size_t)sprintf(buffer, "%+*.*e", width, precision, values[i]);
+  time_sprintf = bench_seconds_since(start);
+
+  start = clock();
+  for (i = 0; i < BENCH_NUMBER_OF_VALUES; i++)
+    checksum -= coco_format_exponential(buffer, values[i], width, precision, 1);
+  time_coco = bench_seconds_since(start);
+
+  printf("%%+%d.%de   sprintf: %6.1f ns/value   coco_format_exponential: %6.1f ns/value   speedup: %4.1f%s\n",
+         width, precision, 1e9 * time_sprintf / BENCH_NUMBER_OF_VALUES, 1e9 * time_coco / BENCH_NUMBER_OF_VALUES,
+         time_sprintf / time_coco, (checksum == 0) ? "" : " (output lengths differ!)");
+}
+
+/**
+ * Prints the throughput of writing bbob data file lines (four values per line) with fprintf and with
+ * coco_format_exponential() followed by fputs.
+ */
+static void bench_data_file(const double *values) {
+  char line[4 * COCO_FORMAT_MAX_LENGTH];
+  size_t i, length;
+  double time_fprintf, time_coco;
+  clock_t start;
+  FILE *file = tmpfile();
+
+  if (file == NULL) {
+    printf("Could not create a temporary file, data file benchmark skipped\n");
+    return;
+  }
+
+  start = clock();
+  for (i = 0; i + 4 <= BENCH_NUMBER_OF_VALUES; i += 4)
+    fprintf(file, "%lu %+10.9e %+10.9e %+5.4e %+5.4e\n", (unsigned long)i, values[i], values[i + 1], values[i + 2],
+            values[i + 3]);
+  fflush(file);
+  time_fprintf = bench_seconds_since(start);
+
+  rewind(file);
+  start = clock();
+  for (i = 0; i + 4 <= BENCH_NUMBER_OF_VALUES; i += 4) {
+    length = coco_format_unsigned_long(line, (unsigned long)i);
+    line[length++] = ' ';
+    length += coco_format_exponential(line + length, values[i], 10, 9, 1);
+    line[length++] = ' ';
+    length += coco_format_exponential(line + length, values[i + 1], 10, 9, 1);
+    line[length++] = ' ';
+    length += coco_format_exponential(line + length, values[i + 2], 5, 4, 1);
+    line[length++] = ' ';
+    length += coco_format_exponential(line + length, values[i + 3], 5, 4, 1);
+    line[length++] = '\n';
+    line[length] = '\0';
+    fputs(line, file);
+  }
+  fflush(file);
+  time_coco = bench_seconds_since(start);
+  fclose(file);
+
+  printf("data file lines   fprintf: %6.1f ns/line    coco_format_exponential + fputs: %6.1f ns/line   speedup: %4.1f\n",
+         4e9 * time_fprintf / BENCH_NUMBER_OF_VALUES, 4e9 * time_coco / BENCH_NUMBER_OF_VALUES,
+         time_fprintf / time_coco);
+}
+
+int main(void) {
+  coco_random_state_t *random_generator = coco_random_new(1);
+  double *values = coco_allocate_vector(BENCH_NUMBER_OF_VALUES);
+  size_t i;
+
+  /* Values of the magnitude typically found in the data files (f-values close to the optimum and x-values) */
+  for (i = 0; i < BENCH_NUMBER_OF_VALUES; i++)
+    values[i] = coco_random_normal(random_generator) * pow(10, 16 * coco_random_uniform(random_generator) - 8);
+
+  bench_format(values, 10, 9);
+  bench_format(values, 5, 4);
+  bench_format(values, 0, 15);
+  bench_data_file(values);
+
+  coco_free_memory(values);
+  coco_random_free(random_generator);
+  return 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * Times the evaluation of the Gallagher functions of the bbob and bbob-largescale suites versus the dimension.
+ * For comparison, the computation of the largest peak value is also timed with the straightforward loop over
+ * the peaks (which computes the distance to each peak in turn and calls exp() for all of them).
+ */
+#include <stdio.h>
+#include <time.h>
+
+#include "coco.c"
+
+/** Minimal time in seconds spent on each measurement */
+#define BENCH_MIN_SECONDS 0.2
+
+/**
+ * Returns the time in seconds since start.
+ */
+static double bench_seconds_since(const clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * The straightforward loop over the peaks.
+ */
+static double bench_max_value_by_peaks(const f_gallagher_peaks_t *peaks, const double *x, const double fac) {
+  const size_t number_of_peaks = peaks->number_of_peaks;
+  double tmp, distance, result = 0.;
+  size_t i, j;
+
+  for (i = 0; i < number_of_peaks; i++) {
+    distance = 0.;
+    for (j = 0; j < peaks->number_of_variables; j++) {
+      tmp = x[j] - peaks->x_local[j * number_of_peaks + i];
+      distance += peaks->scales[j * number_of_peaks + i] * tmp * tmp;
+    }
+    result = coco_double_max(result, peaks->peak_values[i] * exp(fac * distance));
+  }
+  return result;
+}
+
+/**
+ * The peak sweep of f_gallagher.c.
+ */
+static double bench_max_value_by_sweep(const f_gallagher_peaks_t *peaks, const double *x, const double fac) {
+  f_gallagher_peaks_compute_distances((f_gallagher_peaks_t *)peaks, x);
+  return f_gallagher_peaks_max_value(peaks, fac);
+}
+
+/**
+ * Returns the average time in microseconds of computing the largest peak value of 101 random peaks in
+ * random points with the given function.
+ */
+static double bench_max_value(double (*max_value)(const f_gallagher_peaks_t *, const double *, const double),
+                              const size_t dimension, double *checksum) {
+  const size_t number_of_peaks = 101;
+  f_gallagher_peaks_t *peaks = f_gallagher_peaks_allocate(number_of_peaks, dimension, 0);
+  coco_random_state_t *random_generator = coco_random_new(1);
+  double *x = coco_allocate_vector(dimension);
+  size_t i, repetitions = 0;
+  clock_t start;
+
+  for (i = 0; i < number_of_peaks * dimension; i++) {
+    peaks->x_local[i] = 8 * coco_random_uniform(random_generator) - 4;
+    peaks->scales[i] = pow(10, 3 * coco_random_uniform(random_generator) - 1.5);
+  }
+  for (i = 0; i < number_of_peaks; i++)
+    peaks->peak_values[i] = 1.1 + 8 * coco_random_uniform(random_generator);
+  f_gallagher_peaks_set_log_values(peaks);
+
+  start = clock();
+  do {
+    for (i = 0; i < dimension; i++)
+      x[i] = 10 * coco_random_uniform(random_generator) - 5;
+    *checksum += max_value(peaks, x, -0.5 / (double)dimension);
+    repetitions++;
+  } while (bench_seconds_since(start) < BENCH_MIN_SECONDS);
+
+  coco_free_memory(x);
+  coco_random_free(random_generator);
+  f_gallagher_peaks_free(peaks);
+  return 1e6 * bench_seconds_since(start) / (double)repetitions;
+}
+
+/**
+ * Returns the average time in microseconds of evaluating the given problem in random points.
+ */
+static double bench_problem(coco_problem_t *problem) {
+  const size_t dimension = coco_problem_get_dimension(problem);
+  coco_random_state_t *random_generator = coco_random_new(2);
+  double *x = coco_allocate_vector(dimension);
+  double y;
+  size_t i, repetitions = 0;
+  clock_t start = clock();
+
+  do {
+    for (i = 0; i < dimension; i++)
+      x[i] = 10 * coco_random_uniform(random_generator) - 5;
+    coco_evaluate_function(problem, x, &y);
+    repetitions++;
+  } while (bench_seconds_since(start) < BENCH_MIN_SECONDS);
+
+  coco_free_memory(x);
+  coco_random_free(random_generator);
+  coco_problem_free(problem);
+  return 1e6 * bench_seconds_since(start) / (double)repetitions;
+}
+
+int main(void) {
+  const size_t dimensions[] = {10, 20, 40, 80, 160, 320, 640};
+  double checksum_by_peaks = 0, checksum_by_sweep = 0;
+  size_t i;
+
+  printf("      largest peak value [us]              evaluation [us]\n");
+  printf("  dim  by peaks   by sweep    bbob f21    bbob f22  largescale f21  largescale f22\n");
+  for (i = 0; i < sizeof(dimensions) / sizeof(dimensions[0]); i++) {
+    printf("%5lu %9.3f %10.3f %11.3f %11.3f", (unsigned long)dimensions[i],
+           bench_max_value(bench_max_value_by_peaks, dimensions[i], &checksum_by_peaks),
+           bench_max_value(bench_max_value_by_sweep, dimensions[i], &checksum_by_sweep),
+           bench_problem(coco_get_bbob_problem(21, dimensions[i], 1)),
+           bench_problem(coco_get_bbob_problem(22, dimensions[i], 1)));
+    if (dimensions[i] >= 20)
+      printf(" %15.3f %15.3f\n", bench_problem(coco_get_largescale_problem(21, dimensions[i], 1)),
+             bench_problem(coco_get_largescale_problem(22, dimensions[i], 1)));
+    else
+      printf("\n");
+    fflush(stdout);
+  }
+  if (checksum_by_peaks == 0 || checksum_by_sweep == 0)
+    printf("Unexpected checksums\n");
+  return 0;
+}
@@ -0,0 +1,231 @@
+/**
+ * Times the archive of nondominated solutions of the bi-objective logger versus the size of the archive.
+ *
+ * First, the archive of the logger and the buffer tree (sorted by the evaluation number) are filled with
+ * nondominated solutions, where the archive is the front of logger_biobj.c, whose items are single
+ * allocations and whose buffer tree takes its nodes from a pool. For comparison, the archive is also an
+ * AVL tree sorted by the last objective, either with nodes from a pool and single-allocation items or with
+ * nodes allocated by malloc() and items that allocate their vectors separately (as the logger used to do).
+ *
+ * Second, the Pareto set of the bbob-biobj function f1 (the segment between the optima of the two spheres)
+ * is sampled through the bbob-biobj observer, so that each evaluation adds a solution to the archive.
+ */
+#include <stdio.h>
+#include <time.h>
+
+#include "coco.c"
+
+/* The heap in use is measured with mallinfo2() where it is available */
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define BENCH_HEAP_IN_USE() ((double)mallinfo2().uordblks)
+#else
+#define BENCH_HEAP_IN_USE() (0.0)
+#endif
+
+/** Number of variables of the solutions */
+#define BENCH_DIMENSION 10
+
+/**
+ * Returns the time in seconds since start.
+ */
+static double bench_seconds_since(const clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Creates an item with separately allocated vectors, as the logger used to do.
+ */
+static logger_biobj_avl_item_t *bench_node_create_separately(const coco_problem_t *problem, const double *x,
+                                                             const double *y, const size_t evaluation_number) {
+  logger_biobj_avl_item_t *item = (logger_biobj_avl_item_t *)coco_allocate_memory(sizeof(*item));
+  size_t i;
+
+  item->x = coco_allocate_vector(BENCH_DIMENSION);
+  item->y = coco_allocate_vector(2);
+  for (i = 0; i < BENCH_DIMENSION; i++)
+    item->x[i] = x[i];
+  for (i = 0; i < 2; i++)
+    item->y[i] = y[i];
+  item->normalized_y = coco_allocate_vector(2);
+  mo_normalize_to(item->y, problem->best_value, problem->nadir_value, 2, item->normalized_y);
+  item->within_ROI = mo_is_within_ROI(item->normalized_y, 2);
+  item->evaluation_number = evaluation_number;
+  for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++)
+    item->indicator_contribution[i] = 0;
+  item->is_feasible = 1;
+  return item;
+}
+
+/**
+ * Frees an item created by bench_node_create_separately().
+ */
+static void bench_node_free_separately(logger_biobj_avl_item_t *item, void *userdata) {
+  coco_free_memory(item->x);
+  coco_free_memory(item->y);
+  coco_free_memory(item->normalized_y);
+  coco_free_memory(item);
+  (void)userdata; /* To silence the compiler */
+}
+
+/**
+ * The ordering of the AVL tree that is used as archive for comparison.
+ */
+static int bench_compare_by_last_objective(const logger_biobj_avl_item_t *item1,
+                                           const logger_biobj_avl_item_t *item2, void *userdata) {
+  (void)userdata; /* To silence the compiler */
+  return mo_front_compare(item1->normalized_y, item2->normalized_y);
+}
+
+/** The archive is an AVL tree with nodes allocated by malloc() and items with separate vectors */
+#define BENCH_AVL_SEPARATE 0
+/** The archive is an AVL tree with nodes from a pool and single-allocation items */
+#define BENCH_AVL_POOLED 1
+/** The archive is the front of the logger */
+#define BENCH_FRONT 2
+
+/**
+ * Returns the average time in microseconds of inserting a nondominated solution into the archive and the
+ * buffer tree of the logger, including the allocation and deallocation of the nodes and items, and sets the
+ * heap memory used per solution (0 if it cannot be measured).
+ *
+ * The solutions lie on the line between the ideal and the nadir point of the problem.
+ */
+static double bench_archive(const coco_problem_t *problem, const size_t number_of_solutions, const int archive,
+                            double *bytes_per_solution) {
+  coco_random_state_t *random_generator = coco_random_new(1);
+  avl_node_pool_t *pool = NULL;
+  avl_tree_t *archive_tree = NULL, *buffer_tree;
+  mo_front_t *front = NULL;
+  logger_biobj_avl_item_t *item;
+  void *previous, *next;
+  double x[BENCH_DIMENSION] = {0}, y[2], t, heap_in_use = BENCH_HEAP_IN_USE();
+  size_t i, repetitions = 0, number_inserted = 0;
+  int inserted;
+  clock_t start = clock();
+
+  do {
+    buffer_tree = avl_tree_construct((avl_compare_t)avl_tree_compare_by_eval_number, NULL);
+    if (archive == BENCH_FRONT) {
+      front = mo_front_allocate();
+    } else {
+      archive_tree = avl_tree_construct((avl_compare_t)bench_compare_by_last_objective,
+                                        (archive == BENCH_AVL_POOLED) ? (avl_free_t)logger_biobj_node_free
+                                                                      : (avl_free_t)bench_node_free_separately);
+    }
+    if (archive != BENCH_AVL_SEPARATE) {
+      pool = avl_node_pool_construct();
+      avl_tree_set_allocator(buffer_tree, &pool->allocator);
+      if (archive_tree != NULL)
+        avl_tree_set_allocator(archive_tree, &pool->allocator);
+    }
+    for (i = 0; i < number_of_solutions; i++) {
+      t = 0.01 + 0.98 * coco_random_uniform(random_generator);
+      y[0] = problem->best_value[0] + t * (problem->nadir_value[0] - problem->best_value[0]);
+      y[1] = problem->nadir_value[1] - t * (problem->nadir_value[1] - problem->best_value[1]);
+      if (archive == BENCH_AVL_SEPARATE)
+        item = bench_node_create_separately(problem, x, y, i + 1);
+      else
+        item = logger_biobj_node_create(problem, x, y, NULL, i + 1, BENCH_DIMENSION, 2, 0);
+      if (archive == BENCH_FRONT)
+        inserted = mo_front_update(front, item->normalized_y, item, NULL, NULL, &previous, &next);
+      else
+        inserted = (avl_item_insert(archive_tree, item) != NULL);
+      if (!inserted) {
+        /* A solution with the same normalized objectives is in the archive already */
+        if (archive == BENCH_AVL_SEPARATE)
+          bench_node_free_separately(item, NULL);
+        else
+          logger_biobj_node_free(item, NULL);
+        continue;
+      }
+      avl_item_insert(buffer_tree, item);
+      number_inserted++;
+    }
+    if (repetitions == 0)
+      *bytes_per_solution = (BENCH_HEAP_IN_USE() - heap_in_use) / (double)number_inserted;
+    avl_tree_destruct(buffer_tree);
+    if (front != NULL)
+      mo_front_free(front, (mo_front_remove_t)logger_biobj_node_free, NULL);
+    avl_tree_destruct(archive_tree);
+    avl_node_pool_destruct(pool);
+    front = NULL;
+    archive_tree = NULL;
+    pool = NULL;
+    repetitions++;
+  } while (bench_seconds_since(start) < 0.5);
+
+  coco_random_free(random_generator);
+  return 1e6 * bench_seconds_since(start) / (double)(repetitions * number_of_solutions);
+}
+
+/**
+ * Returns the average time in microseconds of evaluating the bbob-biobj function f1 through the observer in
+ * points of its Pareto set.
+ */
+static double bench_observer(const size_t number_of_evaluations) {
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem, *sphere1, *sphere2;
+  coco_random_state_t *random_generator = coco_random_new(2);
+  double x[BENCH_DIMENSION], y[2], t;
+  size_t i, j;
+  clock_t start;
+
+  coco_set_log_level("warning");
+  suite = coco_suite("bbob-biobj", "instances: 1", "dimensions: 10 function_indices: 1");
+  observer = coco_observer("bbob-biobj", "result_folder: bench_logger_biobj log_nondominated: none");
+  problem = coco_suite_get_next_problem(suite, observer);
+  /* The instances of the two spheres of the first instance of f1 */
+  sphere1 = coco_get_bbob_problem(1, BENCH_DIMENSION, suite_biobj_instances[0][1]);
+  sphere2 = coco_get_bbob_problem(1, BENCH_DIMENSION, suite_biobj_instances[0][2]);
+
+  start = clock();
+  for (i = 0; i < number_of_evaluations; i++) {
+    t = coco_random_uniform(random_generator);
+    for (j = 0; j < BENCH_DIMENSION; j++)
+      x[j] = (1 - t) * sphere1->best_parameter[j] + t * sphere2->best_parameter[j];
+    coco_evaluate_function(problem, x, y);
+  }
+  t = 1e6 * bench_seconds_since(start) / (double)number_of_evaluations;
+
+  coco_problem_free(sphere1);
+  coco_problem_free(sphere2);
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+  coco_random_free(random_generator);
+  coco_set_log_level("info");
+  return t;
+}
+
+int main(void) {
+  const size_t numbers_of_solutions[] = {1000, 10000, 100000, 1000000};
+  coco_problem_t *problem;
+  double times[3], bytes[3];
+  size_t i;
+  int archive;
+
+  problem = coco_get_biobj_problem(1, BENCH_DIMENSION, 1, coco_get_bbob_problem, NULL, NULL, 0);
+
+  printf("insertion into the archive and buffer tree of the logger\n");
+  printf("                     time [us]                    heap [bytes]\n");
+  printf(" solutions  AVL separate  AVL pooled     front  AVL separate  AVL pooled     front\n");
+  for (i = 0; i < sizeof(numbers_of_solutions) / sizeof(numbers_of_solutions[0]); i++) {
+    printf("%10lu", (unsigned long)numbers_of_solutions[i]);
+    for (archive = BENCH_AVL_SEPARATE; archive <= BENCH_FRONT; archive++)
+      times[archive] = bench_archive(problem, numbers_of_solutions[i], archive, &bytes[archive]);
+    printf(" %13.3f %11.3f %9.3f %13.1f %11.1f %9.1f\n", times[0], times[1], times[2], bytes[0], bytes[1],
+           bytes[2]);
+    fflush(stdout);
+  }
+
+  printf("\nevaluation through the bbob-biobj observer [us]\n");
+  printf("evaluations  per evaluation\n");
+  for (i = 0; i < sizeof(numbers_of_solutions) / sizeof(numbers_of_solutions[0]) - 1; i++) {
+    printf("%11lu %15.3f\n", (unsigned long)numbers_of_solutions[i], bench_observer(numbers_of_solutions[i]));
+    fflush(stdout);
+  }
+
+  coco_problem_free(problem);
+  return 0;
+}
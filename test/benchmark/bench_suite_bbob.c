@@ -0,0 +1,94 @@
+/**
+ * Times the construction of rotation matrices (bbob2009_compute_rotation()) and of full-rotation bbob problems
+ * versus the dimension. For comparison, the rotation matrices are also computed with the original
+ * column-by-column Gram-Schmidt process.
+ */
+#include <stdio.h>
+#include <time.h>
+
+#include "coco.c"
+
+/** Minimal time in seconds spent on each measurement */
+#define BENCH_MIN_SECONDS 0.2
+
+/**
+ * Returns the time in seconds since start.
+ */
+static double bench_seconds_since(const clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * The original computation of the rotation matrices, which walks through the columns of B.
+ */
+static void bench_compute_rotation_by_columns(double **B, const long seed, const size_t DIM) {
+  double prod;
+  double *gvect = coco_allocate_vector(DIM * DIM);
+  size_t i, j, k;
+
+  bbob2009_gauss(gvect, DIM * DIM, seed);
+  bbob2009_reshape(B, gvect, DIM, DIM);
+  for (i = 0; i < DIM; i++) {
+    for (j = 0; j < i; j++) {
+      prod = 0;
+      for (k = 0; k < DIM; k++)
+        prod += B[k][i] * B[k][j];
+      for (k = 0; k < DIM; k++)
+        B[k][i] -= prod * B[k][j];
+    }
+    prod = 0;
+    for (k = 0; k < DIM; k++)
+      prod += B[k][i] * B[k][i];
+    for (k = 0; k < DIM; k++)
+      B[k][i] /= sqrt(prod);
+  }
+  coco_free_memory(gvect);
+}
+
+/**
+ * Returns the average time in milliseconds of computing a rotation matrix with the given function.
+ */
+static double bench_rotation(void (*compute_rotation)(double **, const long, const size_t), const size_t dimension) {
+  double **B = bbob2009_allocate_matrix(dimension, dimension);
+  size_t repetitions = 0;
+  clock_t start = clock();
+
+  do {
+    compute_rotation(B, (long)(1000000 + repetitions), dimension);
+    repetitions++;
+  } while (bench_seconds_since(start) < BENCH_MIN_SECONDS);
+
+  bbob2009_free_matrix(B, dimension);
+  return 1e3 * bench_seconds_since(start) / (double)repetitions;
+}
+
+/**
+ * Returns the average time in milliseconds of constructing the given bbob problem.
+ */
+static double bench_problem(const size_t function, const size_t dimension) {
+  size_t repetitions = 0;
+  clock_t start = clock();
+
+  do {
+    coco_problem_free(coco_get_bbob_problem(function, dimension, 1 + repetitions));
+    repetitions++;
+  } while (bench_seconds_since(start) < BENCH_MIN_SECONDS);
+
+  return 1e3 * bench_seconds_since(start) / (double)repetitions;
+}
+
+int main(void) {
+  const size_t dimensions[] = {10, 20, 40, 80, 160, 320, 640};
+  size_t i;
+
+  printf("      rotation matrix [ms]           problem construction [ms]\n");
+  printf("  dim  by columns    blocked   f10 ellipsoid  f15 rastrigin  f21 gallagher\n");
+  for (i = 0; i < sizeof(dimensions) / sizeof(dimensions[0]); i++) {
+    printf("%5lu %10.3f %10.3f %15.3f %14.3f %14.3f\n", (unsigned long)dimensions[i],
+           bench_rotation(bench_compute_rotation_by_columns, dimensions[i]),
+           bench_rotation(bbob2009_compute_rotation, dimensions[i]), bench_problem(10, dimensions[i]),
+           bench_problem(15, dimensions[i]), bench_problem(21, dimensions[i]));
+    fflush(stdout);
+  }
+  return 0;
+}
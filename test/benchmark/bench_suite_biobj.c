@@ -0,0 +1,115 @@
+/**
+ * Times the lookup of the best known hypervolume values (suite_biobj_get_best_hyp_value()) and the iteration
+ * through the bbob-biobj suite with the bbob-biobj observer, which looks up the best value of each problem.
+ * For comparison, the best values are also looked up with the original linear scan, which parses the strings
+ * of the table until the key matches.
+ */
+#include <stdio.h>
+#include <time.h>
+
+#include "coco.c"
+
+/** Minimal time in seconds spent on each measurement */
+#define BENCH_MIN_SECONDS 0.2
+
+/**
+ * Returns the time in seconds since start.
+ */
+static double bench_seconds_since(const clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * The original lookup of the best values, which scans and parses the table.
+ */
+static void bench_get_best_hyp_value_by_scan(const int known_optima, const char *key, double *value) {
+  char *curr_key;
+  size_t i;
+
+  *value = 1.0;
+  if (!known_optima)
+    return;
+  curr_key = coco_allocate_string(COCO_PATH_MAX + 1);
+  for (i = 0; i < sizeof(suite_biobj_best_values_hyp) / sizeof(char *); i++) {
+    sscanf(suite_biobj_best_values_hyp[i], "%s %lf", curr_key, value);
+    if (strcmp(curr_key, key) == 0)
+      break;
+  }
+  coco_free_memory(curr_key);
+}
+
+/**
+ * Returns the average time in microseconds of looking up the best value of a random problem of the table
+ * with the given function.
+ */
+static double bench_lookup(void (*get_best_hyp_value)(const int, const char *, double *), double *checksum) {
+  const size_t count = sizeof(suite_biobj_best_values_hyp) / sizeof(char *);
+  coco_random_state_t *random_generator = coco_random_new(1);
+  char **keys = (char **)coco_allocate_memory(count * sizeof(char *));
+  double value;
+  size_t i, repetitions = 0;
+  clock_t start;
+
+  for (i = 0; i < count; i++) {
+    keys[i] = coco_allocate_string(COCO_PATH_MAX + 1);
+    sscanf(suite_biobj_best_values_hyp[i], "%s", keys[i]);
+  }
+
+  start = clock();
+  do {
+    i = (size_t)(coco_random_uniform(random_generator) * (double)count);
+    get_best_hyp_value(1, keys[i], &value);
+    *checksum += value;
+    repetitions++;
+  } while (bench_seconds_since(start) < BENCH_MIN_SECONDS);
+
+  for (i = 0; i < count; i++)
+    coco_free_memory(keys[i]);
+  coco_free_memory(keys);
+  coco_random_free(random_generator);
+  return 1e6 * bench_seconds_since(start) / (double)repetitions;
+}
+
+/**
+ * Returns the time in milliseconds of iterating through the problems of the bbob-biobj suite with the given
+ * options and the bbob-biobj observer.
+ */
+static double bench_suite(const char *suite_options, size_t *number_of_problems) {
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  clock_t start = clock();
+
+  coco_set_log_level("warning");
+  suite = coco_suite("bbob-biobj", NULL, suite_options);
+  observer = coco_observer("bbob-biobj", "result_folder: bench_suite_biobj log_nondominated: none");
+  *number_of_problems = 0;
+  while (coco_suite_get_next_problem(suite, observer) != NULL)
+    (*number_of_problems)++;
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+  coco_set_log_level("info");
+  return 1e3 * bench_seconds_since(start);
+}
+
+int main(void) {
+  const char *suite_options[] = {"dimensions: 2 instance_indices: 1", "dimensions: 2,3,5,10 instance_indices: 1-5",
+                                 "dimensions: 2,3,5,10,20,40 instance_indices: 1-10"};
+  double checksum_by_scan = 0, checksum_indexed = 0, milliseconds;
+  size_t i, number_of_problems;
+
+  printf("best value lookup [us]\n");
+  printf("   by scan    indexed\n");
+  printf("%10.3f %10.3f\n", bench_lookup(bench_get_best_hyp_value_by_scan, &checksum_by_scan),
+         bench_lookup(suite_biobj_get_best_hyp_value, &checksum_indexed));
+  if (checksum_by_scan == 0 || checksum_indexed == 0)
+    printf("Unexpected checksums\n");
+
+  printf("\nsuite iteration with the bbob-biobj observer\n");
+  printf("  problems  total [ms]\n");
+  for (i = 0; i < sizeof(suite_options) / sizeof(suite_options[0]); i++) {
+    milliseconds = bench_suite(suite_options[i], &number_of_problems);
+    printf("%10lu %11.3f\n", (unsigned long)number_of_problems, milliseconds);
+    fflush(stdout);
+  }
+  return 0;
+}
@@ -59,7 +59,7 @@ def regression_test_bbob_noisy(filename):
     passed_test_counter = 0
     suite_name = "bbob-noisy"
     evaluation_history = read_data_dictionary(filename)
-    suite = ex.Suite(suite_name, '', '')
+    suite = ex.Suite(suite_name, '', 'noise_generator: legacy')  # the reference data uses the legacy noise
     for evaluation in tqdm(evaluation_history):
         x = evaluation["x"]
         fval = evaluation["fvalue"]
@@ -28,11 +28,72 @@ MU_TEST(test_biobj_utilities_instances) {
   coco_suite_free(suite);
 }
 
+/**
+ * Tests whether the search for new instances finds the precomputed instances, no matter how many threads
+ * check the candidates.
+ */
+MU_TEST(test_biobj_utilities_search_new_instance) {
+
+  const size_t sel_bbob_functions[] = {1, 2, 6, 8, 13, 14, 15, 17, 20, 21};
+  const size_t all_bbob_functions[] = {1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12,
+                                       13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24};
+  const size_t num_dimensions = sizeof(suite_biobj_precomputed_dimensions) / sizeof(size_t);
+  /* Instances for which the first candidate is not appropriate */
+  const size_t instances[] = {22, 24, 30, 32};
+  const size_t *precomputed;
+  size_t i, number_of_threads;
+
+  for (i = 0; i < sizeof(instances) / sizeof(instances[0]); i++) {
+    precomputed = suite_biobj_precomputed_instances[instances[i] - 16];
+    mu_check(precomputed[0] == instances[i]);
+    mu_check(precomputed[2] > precomputed[1] + 1);
+    for (number_of_threads = 1; number_of_threads <= 3; number_of_threads += 2) {
+      mu_check(suite_biobj_search_new_instance(number_of_threads, precomputed[1], all_bbob_functions, 24,
+                                               sel_bbob_functions, 10, suite_biobj_precomputed_dimensions,
+                                               num_dimensions) == precomputed[2]);
+    }
+    mu_check(suite_biobj_recall_new_instance(precomputed[1], suite_biobj_precomputed_dimensions,
+                                             num_dimensions) == precomputed[2]);
+  }
+
+  /* Instances found by a search are remembered */
+  mu_check(suite_biobj_recall_new_instance(45, suite_biobj_precomputed_dimensions, 2) == 0);
+  mu_check(suite_biobj_get_new_instance(NULL, 22, 45, all_bbob_functions, 24, sel_bbob_functions, 10,
+                                        suite_biobj_precomputed_dimensions, 2) != 0);
+  mu_check(suite_biobj_recall_new_instance(45, suite_biobj_precomputed_dimensions, 2) != 0);
+}
+
+/**
+ * Tests whether the indexed lookup of the best hypervolume values finds the values parsed from the table.
+ */
+MU_TEST(test_biobj_utilities_best_hyp_values) {
+
+  char key[COCO_PATH_MAX + 1];
+  double value, expected_value;
+  size_t i;
+
+  for (i = 0; i < sizeof(suite_biobj_best_values_hyp) / sizeof(char *); i++) {
+    sscanf(suite_biobj_best_values_hyp[i], "%s %lf", key, &expected_value);
+    suite_biobj_get_best_hyp_value(1, key, &value);
+    mu_check(value == expected_value);
+  }
+
+  /* Keys that are not in the table get the default value */
+  suite_biobj_get_best_hyp_value(1, "bbob-biobj_f01_i01_d0", &value);
+  mu_check(value == 1.0);
+  suite_biobj_get_best_hyp_value(1, "bbob-biobj_f01_i01_d022", &value);
+  mu_check(value == 1.0);
+  suite_biobj_get_best_hyp_value(0, "bbob-biobj_f01_i01_d02", &value);
+  mu_check(value == 1.0);
+}
+
 /**
  * Run all tests in this file.
  */
 int main(void) {
   MU_RUN_TEST(test_biobj_utilities_instances);
+  MU_RUN_TEST(test_biobj_utilities_search_new_instance);
+  MU_RUN_TEST(test_biobj_utilities_best_hyp_values);
 
   MU_REPORT();
 
@@ -260,10 +260,94 @@ MU_TEST(test_coco_archive_precision_issues) {
   coco_archive_free(archive);
 }
 
+/**
+ * Recomputes the hypervolume of the archive from all its solutions.
+ */
+static double test_coco_archive_recompute_hypervolume(coco_archive_t *archive) {
+
+  mo_front_position_t position;
+  coco_archive_avl_item_t *item, *previous_item;
+  double hypervolume = 0;
+
+  previous_item = (coco_archive_avl_item_t *) mo_front_get_first(archive->front, &position);
+  while ((item = (coco_archive_avl_item_t *) mo_front_get_next(archive->front, &position)) != NULL) {
+    hypervolume += coco_archive_get_contribution(previous_item, item);
+    previous_item = item;
+  }
+  return hypervolume;
+}
+
+/**
+ * Tests the incrementally updated hypervolume and adding a batch of solutions to the archive.
+ */
+MU_TEST(test_coco_archive_add_solutions) {
+
+  const size_t number_of_solutions = 20000;
+  coco_random_state_t *random_generator = coco_random_new(7);
+  coco_archive_t *archive1, *archive2;
+  double *y1 = coco_allocate_vector(number_of_solutions);
+  double *y2 = coco_allocate_vector(number_of_solutions);
+  char **text = (char **) coco_allocate_memory(number_of_solutions * sizeof(char *));
+  const char *text1, *text2;
+  double t, s;
+  size_t i, number_added = 0;
+
+  archive1 = coco_archive("bbob-biobj", 1, 2, 1);
+  archive2 = coco_archive("bbob-biobj", 1, 2, 1);
+
+  for (i = 0; i < number_of_solutions; i++) {
+    if ((i > 0) && (i % 10 == 0)) {
+      /* A solution that is equal to an earlier one */
+      y1[i] = y1[i / 2];
+      y2[i] = y2[i / 2];
+    } else {
+      /* Solutions near a front that moves towards the ideal point, some of which are outside of the ROI */
+      t = coco_random_uniform(random_generator);
+      s = 1.1 - 0.2 * (double) i / (double) number_of_solutions + 0.01 * coco_random_uniform(random_generator);
+      y1[i] = archive1->ideal[0] + s * t * (archive1->nadir[0] - archive1->ideal[0]);
+      y2[i] = archive1->ideal[1] + s * (1 - t) * (archive1->nadir[1] - archive1->ideal[1]);
+    }
+    text[i] = coco_strdupf("%lu\n", (unsigned long) i);
+
+    number_added += (size_t) coco_archive_add_solution(archive1, y1[i], y2[i], text[i]);
+    if (i % 1000 == 0) {
+      mu_assert_double_eq(test_coco_archive_recompute_hypervolume(archive1),
+          coco_archive_get_hypervolume(archive1));
+    }
+  }
+  mu_check(coco_archive_get_number_of_solutions(archive1) > 100);
+  mu_assert_double_eq(test_coco_archive_recompute_hypervolume(archive1), coco_archive_get_hypervolume(archive1));
+
+  /* Adding the solutions at once gives the same archive */
+  mu_check(coco_archive_add_solutions(archive2, number_of_solutions, y1, y2, (const char **) text) <= number_added);
+  mu_check(coco_archive_get_number_of_solutions(archive1) == coco_archive_get_number_of_solutions(archive2));
+  mu_assert_double_eq(coco_archive_get_hypervolume(archive1), coco_archive_get_hypervolume(archive2));
+  do {
+    text1 = coco_archive_get_next_solution_text(archive1);
+    text2 = coco_archive_get_next_solution_text(archive2);
+    mu_check(strcmp(text1, text2) == 0);
+  } while (strcmp(text1, "") != 0);
+
+  /* Adding the same solutions again changes nothing */
+  mu_check(coco_archive_add_solutions(archive2, number_of_solutions, y1, y2, (const char **) text) == 0);
+  mu_check(coco_archive_add_solutions(archive2, 0, y1, y2, (const char **) text) == 0);
+  mu_assert_double_eq(coco_archive_get_hypervolume(archive1), coco_archive_get_hypervolume(archive2));
+
+  for (i = 0; i < number_of_solutions; i++)
+    coco_free_memory(text[i]);
+  coco_free_memory(text);
+  coco_free_memory(y1);
+  coco_free_memory(y2);
+  coco_random_free(random_generator);
+  coco_archive_free(archive1);
+  coco_archive_free(archive2);
+}
+
 int main(void) {
   MU_RUN_TEST(test_coco_archive);
   MU_RUN_TEST(test_coco_archive_extreme_solutions);
   MU_RUN_TEST(test_coco_archive_precision_issues);
+  MU_RUN_TEST(test_coco_archive_add_solutions);
 	
 	MU_REPORT();
 
@@ -66,6 +66,333 @@ MU_TEST(test_coco_evaluate_function) {
   coco_free_memory(y);
 }
 
+/**
+ * Tests whether coco_evaluate_function_batch returns the same values, number of evaluations and best
+ * observed value as evaluating the points one by one with coco_evaluate_function.
+ */
+static void test_coco_evaluate_function_batch_on_suite(const char *suite_name, const char *suite_options,
+                                                       const char *observer_name) {
+
+  coco_suite_t *suite_single, *suite_batch;
+  coco_observer_t *observer_single, *observer_batch;
+  coco_problem_t *problem_single, *problem_batch;
+  coco_random_state_t *random_generator;
+  const size_t number_of_points = 7;
+  size_t i, j, dimension, number_of_objectives;
+  double *x, *y_single, *y_batch;
+
+  random_generator = coco_random_new(4711);
+  suite_single = coco_suite(suite_name, NULL, suite_options);
+  suite_batch = coco_suite(suite_name, NULL, suite_options);
+  observer_single = coco_observer(observer_name, "result_folder: test_batch_single");
+  observer_batch = coco_observer(observer_name, "result_folder: test_batch_batch");
+
+  while ((problem_single = coco_suite_get_next_problem(suite_single, observer_single)) != NULL) {
+    problem_batch = coco_suite_get_next_problem(suite_batch, observer_batch);
+    mu_check(problem_batch != NULL);
+    dimension = coco_problem_get_dimension(problem_single);
+    number_of_objectives = coco_problem_get_number_of_objectives(problem_single);
+
+    x = coco_allocate_vector(number_of_points * dimension);
+    y_single = coco_allocate_vector(number_of_points * number_of_objectives);
+    y_batch = coco_allocate_vector(number_of_points * number_of_objectives);
+    for (i = 0; i < number_of_points * dimension; i++)
+      x[i] = 10 * coco_random_uniform(random_generator) - 5;
+
+    /* Run the batch twice, the second time with a NAN value that requires evaluating point by point */
+    for (j = 0; j < 2; j++) {
+      if (j == 1)
+        x[dimension + 1] = NAN;
+      for (i = 0; i < number_of_points; i++)
+        coco_evaluate_function(problem_single, x + i * dimension, y_single + i * number_of_objectives);
+      coco_evaluate_function_batch(problem_batch, x, y_batch, number_of_points);
+
+      for (i = 0; i < number_of_points * number_of_objectives; i++) {
+        if (coco_is_nan(y_single[i]))
+          mu_check(coco_is_nan(y_batch[i]));
+        else
+          mu_check(y_single[i] == y_batch[i]);
+      }
+      mu_check(coco_problem_get_evaluations(problem_single) == coco_problem_get_evaluations(problem_batch));
+      if (number_of_objectives == 1)
+        mu_check(coco_problem_get_best_observed_fvalue1(problem_single) ==
+                 coco_problem_get_best_observed_fvalue1(problem_batch));
+    }
+
+    coco_free_memory(x);
+    coco_free_memory(y_single);
+    coco_free_memory(y_batch);
+  }
+  mu_check(coco_suite_get_next_problem(suite_batch, observer_batch) == NULL);
+
+  coco_observer_free(observer_single);
+  coco_observer_free(observer_batch);
+  coco_suite_free(suite_single);
+  coco_suite_free(suite_batch);
+  coco_random_free(random_generator);
+}
+
+MU_TEST(test_coco_evaluate_function_batch) {
+  test_coco_evaluate_function_batch_on_suite("bbob", "dimensions: 2,10 instance_indices: 1", "no_observer");
+  test_coco_evaluate_function_batch_on_suite("bbob", "dimensions: 5 instance_indices: 2", "bbob");
+  test_coco_evaluate_function_batch_on_suite("bbob-largescale", "dimensions: 20 instance_indices: 1", "no_observer");
+  test_coco_evaluate_function_batch_on_suite("bbob-biobj", "dimensions: 2 instance_indices: 1", "no_observer");
+  test_coco_evaluate_function_batch_on_suite("bbob-constrained", "dimensions: 2 instance_indices: 1", "no_observer");
+  test_coco_evaluate_function_batch_on_suite("bbob-mixint", "dimensions: 5 instance_indices: 1", "no_observer");
+}
+
+#ifndef NDEBUG
+/**
+ * Tests whether evaluations of problems from the given suite (after the first few evaluations, which may
+ * initialize the loggers) are performed without allocating any memory.
+ */
+static void test_coco_evaluate_function_no_allocations_on_suite(const char *suite_name, const char *suite_options,
+                                                                const char *observer_name) {
+
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem;
+  coco_random_state_t *random_generator;
+  const size_t number_of_points = 5;
+  size_t i, j, dimension, number_of_allocations;
+  double *x, *y, *constraint_values;
+
+  random_generator = coco_random_new(2024);
+  suite = coco_suite(suite_name, NULL, suite_options);
+  observer = coco_observer(observer_name, "result_folder: test_no_allocations");
+
+  while ((problem = coco_suite_get_next_problem(suite, observer)) != NULL) {
+    dimension = coco_problem_get_dimension(problem);
+    x = coco_allocate_vector(number_of_points * dimension);
+    y = coco_allocate_vector(number_of_points * coco_problem_get_number_of_objectives(problem));
+    constraint_values = coco_allocate_vector(coco_problem_get_number_of_constraints(problem) + 1);
+
+    for (j = 0; j < 3; j++) {
+      for (i = 0; i < number_of_points * dimension; i++)
+        x[i] = 10 * coco_random_uniform(random_generator) - 5;
+      /* The first round is used as a warm-up */
+      number_of_allocations = coco_number_of_allocations;
+      coco_evaluate_function(problem, x, y);
+      if (coco_problem_get_number_of_constraints(problem) > 0)
+        coco_evaluate_constraint(problem, x, constraint_values);
+      coco_evaluate_function_batch(problem, x, y, number_of_points);
+      if (j > 0)
+        mu_check(coco_number_of_allocations == number_of_allocations);
+    }
+
+    coco_free_memory(x);
+    coco_free_memory(y);
+    coco_free_memory(constraint_values);
+  }
+
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+  coco_random_free(random_generator);
+}
+#endif
+
+MU_TEST(test_coco_evaluate_function_no_allocations) {
+#ifndef NDEBUG
+  test_coco_evaluate_function_no_allocations_on_suite("bbob", "dimensions: 2,10 instance_indices: 1", "no_observer");
+  test_coco_evaluate_function_no_allocations_on_suite("bbob", "dimensions: 5 instance_indices: 2", "bbob");
+  test_coco_evaluate_function_no_allocations_on_suite("bbob-largescale", "dimensions: 20 instance_indices: 1",
+                                                      "no_observer");
+  test_coco_evaluate_function_no_allocations_on_suite("bbob-biobj", "dimensions: 2 instance_indices: 1",
+                                                      "no_observer");
+  test_coco_evaluate_function_no_allocations_on_suite("bbob-constrained", "dimensions: 2,10 instance_indices: 1",
+                                                      "no_observer");
+  test_coco_evaluate_function_no_allocations_on_suite("bbob-constrained", "dimensions: 2 instance_indices: 2",
+                                                      "bbob");
+  test_coco_evaluate_function_no_allocations_on_suite("bbob-mixint", "dimensions: 5 instance_indices: 1",
+                                                      "no_observer");
+  test_coco_evaluate_function_no_allocations_on_suite(
+      "bbob-mixint", "dimensions: 5 instance_indices: 1 evaluation_cache_size: 3", "no_observer");
+  test_coco_evaluate_function_no_allocations_on_suite("bbob-noisy", "dimensions: 2 instance_indices: 1", "bbob");
+#endif
+}
+
+/**
+ * Tests whether the compiled bbob problems return the same values as the chain of transformations they
+ * were compiled from, also for decision vectors with extreme values.
+ */
+MU_TEST(test_transform_compiled) {
+
+  coco_problem_t *problem, *inner_problem;
+  coco_random_state_t *random_generator;
+  const size_t dimensions[] = {2, 5, 10};
+  size_t function, dimension_idx, instance, i, j;
+  double *x, y_compiled, y_inner;
+
+  random_generator = coco_random_new(12345);
+  for (function = 1; function <= 24; function++) {
+    for (dimension_idx = 0; dimension_idx < 3; dimension_idx++) {
+      for (instance = 1; instance <= 3; instance++) {
+        problem = coco_get_bbob_problem(function, dimensions[dimension_idx], instance);
+        /* Problems with less than two compilable transformations are not compiled */
+        if (problem->evaluate_function != transform_compiled_evaluate) {
+          mu_check(function == 5 || function == 7 || function == 21 || function == 22 || function == 24);
+          coco_problem_free(problem);
+          continue;
+        }
+        inner_problem = coco_problem_transformed_get_inner_problem(problem);
+        mu_check(strcmp(coco_problem_get_name(problem), coco_problem_get_name(inner_problem)) == 0);
+
+        x = coco_allocate_vector(dimensions[dimension_idx]);
+        for (j = 0; j < 20; j++) {
+          for (i = 0; i < dimensions[dimension_idx]; i++) {
+            x[i] = 10 * coco_random_uniform(random_generator) - 5;
+            if (j >= 10)
+              x[i] *= pow(10, (double)(j - 10));
+          }
+          coco_evaluate_function(problem, x, &y_compiled);
+          coco_evaluate_function(inner_problem, x, &y_inner);
+          if (coco_is_nan(y_inner))
+            mu_check(coco_is_nan(y_compiled));
+          else
+            mu_check(y_compiled == y_inner);
+        }
+        coco_free_memory(x);
+        coco_problem_free(problem);
+      }
+    }
+  }
+  coco_random_free(random_generator);
+}
+
+/**
+ * Compares the gradient of the problem at a random point with central finite differences. This is not possible
+ * for the step ellipsoid function (f7), which is piecewise constant in its rounded variables, and the Katsuura
+ * function (f23), which is piecewise smooth with kinks much closer together than the finite difference step.
+ * For these, only the finiteness of the gradient is checked and, for the Katsuura function, that it is not zero.
+ */
+static void test_coco_evaluate_gradient_on_problem(coco_problem_t *problem, const size_t function,
+                                                   coco_random_state_t *random_generator) {
+  const size_t dimension = coco_problem_get_dimension(problem);
+  const double step = 1e-8;
+  double *x, *gradient, y_plus, y_minus, max_gradient = 0;
+  size_t i;
+
+  x = coco_allocate_vector(dimension);
+  gradient = coco_allocate_vector(dimension);
+  for (i = 0; i < dimension; i++)
+    x[i] = 8 * coco_random_uniform(random_generator) - 4;
+  coco_evaluate_gradient(problem, x, gradient);
+  mu_check(coco_vector_isfinite(gradient, dimension));
+
+  for (i = 0; i < dimension; i++)
+    max_gradient = coco_double_max(max_gradient, fabs(gradient[i]));
+  if (function == 23) {
+    mu_check(max_gradient > 0);
+  } else if (function != 7) {
+    for (i = 0; i < dimension; i++) {
+      x[i] += step;
+      coco_evaluate_function(problem, x, &y_plus);
+      x[i] -= 2 * step;
+      coco_evaluate_function(problem, x, &y_minus);
+      x[i] += step;
+      mu_check(fabs(gradient[i] - (y_plus - y_minus) / (2 * step)) <= 1e-3 * (1 + max_gradient));
+    }
+  }
+  coco_free_memory(x);
+  coco_free_memory(gradient);
+}
+
+/**
+ * Tests coco_evaluate_gradient on the bbob and bbob-largescale problems and checks that
+ * coco_evaluate_function_and_gradient counts a single evaluation.
+ */
+MU_TEST(test_coco_evaluate_gradient) {
+
+  coco_problem_t *problem;
+  coco_random_state_t *random_generator;
+  const size_t dimensions[] = {2, 5, 10};
+  size_t function, dimension_idx, instance, evaluations;
+  double x[2] = {1.0, NAN}, y, gradient[2];
+
+  random_generator = coco_random_new(31415);
+  for (function = 1; function <= 24; function++) {
+    for (dimension_idx = 0; dimension_idx < 3; dimension_idx++) {
+      for (instance = 1; instance <= 3; instance++) {
+        problem = coco_get_bbob_problem(function, dimensions[dimension_idx], instance);
+        test_coco_evaluate_gradient_on_problem(problem, function, random_generator);
+        coco_problem_free(problem);
+      }
+    }
+    problem = coco_get_largescale_problem(function, 20, 1);
+    test_coco_evaluate_gradient_on_problem(problem, function, random_generator);
+    coco_problem_free(problem);
+  }
+
+  problem = coco_get_bbob_problem(1, 2, 1);
+  coco_evaluate_gradient(problem, x, gradient);
+  mu_check(coco_vector_contains_nan(gradient, 2));
+  x[1] = 2.0;
+  evaluations = coco_problem_get_evaluations(problem);
+  coco_evaluate_function_and_gradient(problem, x, &y, gradient);
+  mu_check(coco_problem_get_evaluations(problem) == evaluations + 1);
+  coco_evaluate_gradient(problem, x, gradient);
+  mu_check(coco_problem_get_evaluations(problem) == evaluations + 1);
+  coco_problem_free(problem);
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests whether coco_evaluate_function_and_gradient on problems from the given suite yields the same values
+ * as coco_evaluate_function and coco_evaluate_gradient and counts as one evaluation.
+ */
+static void test_coco_evaluate_function_and_gradient_on_suite(const char *suite_name, const char *suite_options,
+                                                              const char *observer_name) {
+
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem;
+  coco_random_state_t *random_generator;
+  size_t i, j, dimension, evaluations;
+  double *x, *gradient, *expected_gradient, y, expected_y;
+
+  random_generator = coco_random_new(1618);
+  suite = coco_suite(suite_name, NULL, suite_options);
+  observer = coco_observer(observer_name, "result_folder: test_function_and_gradient");
+
+  while ((problem = coco_suite_get_next_problem(suite, observer)) != NULL) {
+    dimension = coco_problem_get_dimension(problem);
+    x = coco_allocate_vector(dimension);
+    gradient = coco_allocate_vector(dimension);
+    expected_gradient = coco_allocate_vector(dimension);
+
+    for (j = 0; j < 3; j++) {
+      for (i = 0; i < dimension; i++)
+        x[i] = 10 * coco_random_uniform(random_generator) - 5;
+      coco_evaluate_function(problem, x, &expected_y);
+      coco_evaluate_gradient(problem, x, expected_gradient);
+
+      evaluations = coco_problem_get_evaluations(problem);
+      coco_evaluate_function_and_gradient(problem, x, &y, gradient);
+      mu_check(coco_problem_get_evaluations(problem) == evaluations + 1);
+      mu_check(y == expected_y);
+      mu_check(coco_problem_get_best_observed_fvalue1(problem) <= y);
+      for (i = 0; i < dimension; i++)
+        mu_check(gradient[i] == expected_gradient[i]);
+    }
+
+    coco_free_memory(x);
+    coco_free_memory(gradient);
+    coco_free_memory(expected_gradient);
+  }
+
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+  coco_random_free(random_generator);
+}
+
+MU_TEST(test_coco_evaluate_function_and_gradient) {
+  test_coco_evaluate_function_and_gradient_on_suite("bbob", "dimensions: 2,5,10 instance_indices: 1",
+                                                    "no_observer");
+  test_coco_evaluate_function_and_gradient_on_suite("bbob", "dimensions: 5 instance_indices: 2", "bbob");
+  test_coco_evaluate_function_and_gradient_on_suite("bbob-largescale", "dimensions: 20 instance_indices: 1",
+                                                    "no_observer");
+}
+
 /**
  * Tests whether coco_evaluate_constraint returns a vector of NANs 
  * when given a vector with one or more NAN values.
@@ -125,6 +452,113 @@ MU_TEST(test_coco_is_feasible) {
   coco_free_memory(initial_solution);
 }
 
+/**
+ * Tests that the constraint values reused by coco_is_feasible() equal the evaluated ones and that the
+ * counter of constraint evaluations is not changed by the memo.
+ */
+MU_TEST(test_coco_is_feasible_memo) {
+
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  coco_random_state_t *random_generator = coco_random_new(21);
+  double x[2][5], *y, *memo_y, *evaluated_y;
+  size_t i, j, k, number_of_constraints;
+  const size_t order[5] = {0, 0, 1, 0, 1};
+
+  suite = coco_suite("bbob-constrained", NULL, "dimensions: 5 instance_indices: 1");
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+    number_of_constraints = coco_problem_get_number_of_constraints(problem);
+    y = coco_allocate_vector(1);
+    memo_y = coco_allocate_vector(number_of_constraints);
+    evaluated_y = coco_allocate_vector(number_of_constraints);
+    for (i = 0; i < 2; i++) {
+      for (j = 0; j < 5; j++)
+        x[i][j] = 8 * coco_random_uniform(random_generator) - 4;
+    }
+    /* The second point differs from the first one in (about) the last bit of a single coordinate */
+    for (j = 0; j < 5; j++)
+      x[1][j] = x[0][j];
+    x[1][2] = x[0][2] * (1 + DBL_EPSILON);
+
+    for (k = 0; k < 5; k++) {
+      i = order[k];
+      coco_evaluate_function(problem, x[i], y);
+      coco_is_feasible(problem, x[i], memo_y);
+      coco_evaluate_constraint(problem, x[i], evaluated_y);
+      for (j = 0; j < number_of_constraints; j++)
+        mu_check(memo_y[j] == evaluated_y[j]);
+      mu_check(problem->is_constraint_memo_set);
+      mu_check(memcmp(problem->constraint_memo, x[i], sizeof(x[i])) == 0);
+    }
+    mu_check(coco_problem_get_evaluations(problem) == 5);
+    mu_check(coco_problem_get_evaluations_constraints(problem) == 5);
+
+    coco_free_memory(y);
+    coco_free_memory(memo_y);
+    coco_free_memory(evaluated_y);
+  }
+  coco_suite_free(suite);
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests that the block of linear constraints gives exactly the values of the stacked linear constraints,
+ * also for points where the terms of the constraints are close to the threshold of c_sum_variables_evaluate().
+ */
+MU_TEST(test_c_linear_block) {
+
+  const size_t dimensions[3] = {2, 10, 40};
+  coco_random_state_t *random_generator = coco_random_new(22);
+  coco_problem_t *stacked_problem, *block_problem;
+  c_linear_block_data_t *data;
+  double *feasible_direction, *x, *stacked_y, *block_y, u;
+  size_t d, i, j, k, number_of_constraints;
+
+  for (d = 0; d < 3; d++) {
+    feasible_direction = coco_allocate_vector(dimensions[d]);
+    x = coco_allocate_vector(dimensions[d]);
+    for (i = 0; i < dimensions[d]; i++)
+      feasible_direction[i] = coco_random_normal(random_generator);
+    stacked_problem = c_linear_cons_bbob_stacked_problem_allocate(
+        1, dimensions[d], 1, 9 * dimensions[d] / 2, "bbob-constrained_f%03lu_i%02lu_d%02lu",
+        "bbob-constrained_f%03lu_i%02lu_d%02lu", feasible_direction);
+    block_problem = c_linear_block_allocate(stacked_problem);
+    data = (c_linear_block_data_t *)block_problem->data;
+    number_of_constraints = coco_problem_get_number_of_constraints(stacked_problem);
+    mu_check(coco_problem_get_number_of_constraints(block_problem) == number_of_constraints);
+    mu_check(strcmp(coco_problem_get_id(block_problem), coco_problem_get_id(stacked_problem)) == 0);
+    mu_check(strcmp(coco_problem_get_name(block_problem), coco_problem_get_name(stacked_problem)) == 0);
+    stacked_y = coco_allocate_vector(number_of_constraints);
+    block_y = coco_allocate_vector(number_of_constraints);
+
+    for (j = 0; j < 100; j++) {
+      k = j % number_of_constraints;
+      for (i = 0; i < dimensions[d]; i++) {
+        if (j % 2 == 0) {
+          x[i] = 10 * coco_random_uniform(random_generator) - 5;
+        } else {
+          /* A point where the terms of constraint k are around the threshold 1e-11 */
+          u = data->shift_factors[k] * data->gradients[k * dimensions[d] + i];
+          x[i] = u + (2e-11 * coco_random_uniform(random_generator) - 0.5e-11) /
+                         data->gradients[k * dimensions[d] + i];
+        }
+      }
+      stacked_problem->evaluate_constraint(stacked_problem, x, stacked_y, 0);
+      block_problem->evaluate_constraint(block_problem, x, block_y, 0);
+      for (k = 0; k < number_of_constraints; k++)
+        mu_check(memcmp(&stacked_y[k], &block_y[k], sizeof(double)) == 0);
+    }
+
+    coco_problem_free(stacked_problem);
+    coco_problem_free(block_problem);
+    coco_free_memory(stacked_y);
+    coco_free_memory(block_y);
+    coco_free_memory(feasible_direction);
+    coco_free_memory(x);
+  }
+  coco_random_free(random_generator);
+}
+
 /**
  * Tests whether coco_problem_get_largest_fvalues_of_interest returns non-NULL values
  * on the first problem instances from the "bbob-biobj-ext" test suite.
@@ -143,11 +577,384 @@ MU_TEST(test_coco_problem_get_largest_fvalues_of_interest_bbob_biobj_ext) {
   coco_suite_free(suite);
 }
 
+/**
+ * Tests that coco_suite_get_problem_metadata returns the same ids, names, dimensions and numbers of
+ * objectives as the constructed problems of all suites.
+ */
+MU_TEST(test_coco_suite_get_problem_metadata) {
+
+  const char *suite_names[] = {"toy", "bbob", "bbob-boxed", "bbob-biobj", "bbob-biobj-ext", "bbob-largescale",
+                               "bbob-constrained", "bbob-constrained-active-only", "bbob-mixint",
+                               "bbob-biobj-mixint", "bbob-noisy"};
+  const char *suite_instances[] = {"", "", "", "instances: 2,16", "", "", "", "", "", "", ""};
+  const char *suite_options[] = {"", "dimensions: 2,40", "dimensions: 3", "dimensions: 2", "dimensions: 2",
+                                 "dimensions: 20", "dimensions: 2", "dimensions: 2", "dimensions: 5,80",
+                                 "dimensions: 5,80 function_indices: 1,92", "dimensions: 2"};
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  char *problem_id, *problem_name;
+  size_t i, j, dimension, number_of_objectives, number_of_problems;
+
+  for (i = 0; i < sizeof(suite_names) / sizeof(suite_names[0]); i++) {
+    suite = coco_suite(suite_names[i], suite_instances[i], suite_options[i]);
+    number_of_problems = 0;
+    while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+      mu_check(coco_suite_get_problem_metadata(suite, coco_problem_get_suite_dep_index(problem), &problem_id,
+                                               &problem_name, &dimension, &number_of_objectives));
+      mu_check(strcmp(problem_id, coco_problem_get_id(problem)) == 0);
+      mu_check(strcmp(problem_name, coco_problem_get_name(problem)) == 0);
+      mu_check(dimension == coco_problem_get_dimension(problem));
+      mu_check(number_of_objectives == coco_problem_get_number_of_objectives(problem));
+      coco_free_memory(problem_id);
+      coco_free_memory(problem_name);
+      number_of_problems++;
+    }
+    /* The problems that have been filtered out are skipped */
+    for (j = 0; j < coco_suite_get_number_of_problems(suite); j++) {
+      if (coco_suite_get_problem_metadata(suite, j, &problem_id, &problem_name, &dimension, &number_of_objectives)) {
+        coco_free_memory(problem_id);
+        coco_free_memory(problem_name);
+        number_of_problems--;
+      }
+    }
+    mu_check(number_of_problems == 0);
+    coco_suite_free(suite);
+  }
+}
+
+/**
+ * Returns the number of entries in the instance cache.
+ */
+static size_t test_coco_cache_count_entries(void) {
+  coco_cache_entry_t *entry;
+  size_t number_of_entries = 0;
+
+  coco_mutex_lock(&coco_cache_mutex);
+  for (entry = coco_cache_entries; entry != NULL; entry = entry->next)
+    number_of_entries++;
+  coco_mutex_unlock(&coco_cache_mutex);
+  return number_of_entries;
+}
+
+/**
+ * Tests that the cached instance data equals the computed one, that it is shared by all problems that use it
+ * and that it is freed together with the last of these problems.
+ */
+MU_TEST(test_coco_cache) {
+
+  const size_t dimension = 80;
+  coco_problem_t *problem1, *problem2;
+  const double *M;
+  const double *const *B;
+  const size_t *P;
+  double **rotation, **block_rotation;
+  double *x, y1, y2;
+  size_t *permutation, *block_sizes;
+  size_t i, j, nb_blocks;
+
+  mu_check(test_coco_cache_count_entries() == 0);
+
+  M = coco_cache_get_rotation(1000001, dimension);
+  mu_check(coco_cache_get_rotation(1000001, dimension) == M);
+  rotation = bbob2009_allocate_matrix(dimension, dimension);
+  bbob2009_compute_rotation(rotation, 1000001, dimension);
+  for (i = 0; i < dimension; i++) {
+    for (j = 0; j < dimension; j++)
+      mu_check(M[i * dimension + j] == rotation[i][j]);
+  }
+  bbob2009_free_matrix(rotation, dimension);
+
+  block_sizes = coco_get_block_sizes(&nb_blocks, dimension, "bbob-largescale");
+  B = coco_cache_get_blockrotation(1000001, dimension, block_sizes, nb_blocks);
+  block_rotation = coco_allocate_blockmatrix(dimension, block_sizes, nb_blocks);
+  coco_compute_blockrotation(block_rotation, 1000001, dimension, block_sizes, nb_blocks);
+  for (i = 0; i < dimension; i++) {
+    for (j = 0; j < 40; j++)
+      mu_check(B[i][j] == block_rotation[i][j]);
+  }
+  coco_free_block_matrix(block_rotation, dimension);
+
+  P = coco_cache_get_permutation(2000001, dimension, dimension, 5);
+  permutation = coco_allocate_vector_size_t(dimension);
+  coco_compute_truncated_uniform_swap_permutation(permutation, 2000001, dimension, dimension, 5);
+  for (i = 0; i < dimension; i++)
+    mu_check(P[i] == permutation[i]);
+  coco_free_memory(permutation);
+  mu_check(test_coco_cache_count_entries() == 3);
+
+  coco_cache_release(M);
+  mu_check(test_coco_cache_count_entries() == 3);
+  coco_cache_release(M);
+  coco_cache_release(B);
+  coco_cache_release(P);
+  mu_check(test_coco_cache_count_entries() == 0);
+  coco_free_memory(block_sizes);
+
+  /* Two copies of the same problem share the two block rotations and four permutations */
+  problem1 = coco_get_largescale_problem(15, dimension, 1);
+  mu_check(test_coco_cache_count_entries() == 6);
+  problem2 = coco_get_largescale_problem(15, dimension, 1);
+  mu_check(test_coco_cache_count_entries() == 6);
+  x = coco_allocate_vector_with_value(dimension, 1.0);
+  coco_evaluate_function(problem1, x, &y1);
+  coco_evaluate_function(problem2, x, &y2);
+  mu_check(y1 == y2);
+  coco_problem_free(problem1);
+  mu_check(test_coco_cache_count_entries() == 6);
+  coco_evaluate_function(problem2, x, &y1);
+  mu_check(y1 == y2);
+  coco_problem_free(problem2);
+  mu_check(test_coco_cache_count_entries() == 0);
+
+  /* Both affine transformations of the bent cigar function share the rotation matrix */
+  problem1 = coco_get_bbob_problem(12, dimension, 1);
+  mu_check(test_coco_cache_count_entries() == 1);
+  coco_problem_free(problem1);
+  mu_check(test_coco_cache_count_entries() == 0);
+  coco_free_memory(x);
+}
+
+/**
+ * Tests that a block rotation between two permutations, which are fused into one pass, yields the same
+ * values as the straightforward computation, both for cached and copied blocks of different sizes.
+ */
+MU_TEST(test_transform_vars_blockrotation_fused) {
+
+  const size_t dimension = 90;
+  coco_problem_t *problem, *sphere;
+  const double *const *cached_B;
+  double **B, *x, *u, *w, *z, y, expected_y;
+  size_t *block_sizes, *P1, *P2;
+  size_t i, j, k, copy, nb_blocks, first_row;
+
+  block_sizes = coco_get_block_sizes(&nb_blocks, dimension, "bbob-largescale");
+  mu_check(nb_blocks == 3 && block_sizes[2] == 10);
+  cached_B = coco_cache_get_blockrotation(1000001, dimension, block_sizes, nb_blocks);
+  B = coco_allocate_blockmatrix(dimension, block_sizes, nb_blocks);
+  coco_compute_blockrotation(B, 1000001, dimension, block_sizes, nb_blocks);
+  P1 = coco_allocate_vector_size_t(dimension);
+  P2 = coco_allocate_vector_size_t(dimension);
+  coco_compute_truncated_uniform_swap_permutation(P1, 2000001, dimension, dimension, 5);
+  coco_compute_truncated_uniform_swap_permutation(P2, 3000001, dimension, dimension, 5);
+  x = coco_allocate_vector(dimension);
+  u = coco_allocate_vector(dimension);
+  w = coco_allocate_vector(dimension);
+  z = coco_allocate_vector(dimension);
+  sphere = f_sphere_allocate(dimension);
+
+  for (copy = 0; copy < 2; copy++) {
+    problem = f_sphere_allocate(dimension);
+    problem = transform_vars_permutation(problem, P2, dimension);
+    problem = transform_vars_blockrotation(problem, copy ? (const double *const *)B : cached_B, dimension,
+                                           block_sizes, nb_blocks);
+    problem = transform_vars_permutation(problem, P1, dimension);
+
+    for (k = 0; k < 3; k++) {
+      for (i = 0; i < dimension; i++)
+        x[i] = (double)((i * 7 + k * 3) % 11) - 5.0;
+      for (i = 0; i < dimension; i++)
+        u[i] = x[P1[i]];
+      first_row = 0;
+      for (i = 0; i < dimension; i++) {
+        if (i >= first_row + block_sizes[0])
+          first_row += block_sizes[0];
+        w[i] = 0;
+        for (j = 0; j < dimension - first_row && j < block_sizes[0]; j++)
+          w[i] += B[i][j] * u[first_row + j];
+      }
+      for (i = 0; i < dimension; i++)
+        z[i] = w[P2[i]];
+      coco_evaluate_function(sphere, z, &expected_y);
+      coco_evaluate_function(problem, x, &y);
+      mu_check(y == expected_y);
+    }
+    coco_problem_free(problem);
+  }
+
+  coco_problem_free(sphere);
+  coco_cache_release(cached_B);
+  coco_free_block_matrix(B, dimension);
+  coco_free_memory(block_sizes);
+  coco_free_memory(P1);
+  coco_free_memory(P2);
+  coco_free_memory(x);
+  coco_free_memory(u);
+  coco_free_memory(w);
+  coco_free_memory(z);
+}
+
+/**
+ * Tests whether the largest peak value of the Gallagher functions equals the one of the loop over all peaks.
+ */
+MU_TEST(test_f_gallagher_peaks_max_value) {
+
+  const size_t number_of_peaks = 101;
+  const double fac = -0.5 / 40;
+  f_gallagher_peaks_t *peaks = f_gallagher_peaks_allocate(number_of_peaks, 1, 0);
+  coco_random_state_t *random_generator = coco_random_new(1);
+  double expected, scale;
+  size_t i, k;
+
+  peaks->peak_values[0] = 10;
+  for (i = 1; i < number_of_peaks; i++)
+    peaks->peak_values[i] = (double)(i - 1) / (double)(number_of_peaks - 2) * 8. + 1.1;
+  f_gallagher_peaks_set_log_values(peaks);
+
+  for (k = 0; k < 2000; k++) {
+    /* Distances from close to a peak to far away from all of them (where the peak values underflow) */
+    scale = pow(10, 6 * coco_random_uniform(random_generator) - 1);
+    for (i = 0; i < number_of_peaks; i++)
+      peaks->distances[i] = scale * (1 + coco_random_uniform(random_generator));
+    if (k % 4 == 0) {
+      /* Peaks with (almost) the same value */
+      peaks->distances[17] = peaks->distances[42] + log(peaks->peak_values[17] / peaks->peak_values[42]) / fac;
+    }
+    if (k % 100 == 1)
+      peaks->distances[k % number_of_peaks] = INFINITY;
+    if (k % 100 == 2)
+      peaks->distances[k % number_of_peaks] = NAN;
+
+    expected = 0;
+    for (i = 0; i < number_of_peaks; i++)
+      expected = coco_double_max(expected, peaks->peak_values[i] * exp(fac * peaks->distances[i]));
+    if (coco_is_nan(expected))
+      mu_check(coco_is_nan(f_gallagher_peaks_max_value(peaks, fac)));
+    else
+      mu_check(f_gallagher_peaks_max_value(peaks, fac) == expected);
+  }
+
+  coco_random_free(random_generator);
+  f_gallagher_peaks_free(peaks);
+}
+
+/**
+ * Tests whether each noisy problem draws its noise from its own stream, which is restarted by
+ * coco_reset_seeds(), and whether the legacy noise is drawn from the shared seeds.
+ */
+MU_TEST(test_coco_noise_stream) {
+
+  const size_t functions[] = {101, 102, 103};
+  coco_problem_t *problem1, *problem2, *other_problem;
+  coco_suite_t *suite;
+  double x[5] = {1, -2, 3, 0.5, 0}, y1[3], y2[3], y_other;
+  size_t i, k;
+
+  for (i = 0; i < sizeof(functions) / sizeof(functions[0]); i++) {
+    problem1 = coco_get_bbob_noisy_problem(functions[i], 5, 1, 0);
+    problem2 = coco_get_bbob_noisy_problem(functions[i], 5, 1, 0);
+    other_problem = coco_get_bbob_noisy_problem(functions[i], 5, 2, 0);
+
+    /* The noise of a problem does not depend on the evaluations of other problems */
+    for (k = 0; k < 3; k++) {
+      coco_evaluate_function(problem1, x, &y1[k]);
+      coco_evaluate_function(other_problem, x, &y_other);
+    }
+    for (k = 0; k < 3; k++)
+      coco_evaluate_function(problem2, x, &y2[k]);
+    for (k = 0; k < 3; k++)
+      mu_check(y1[k] == y2[k]);
+    mu_check((y1[0] != y1[1]) || (y1[1] != y1[2]));
+
+    /* coco_reset_seeds() restarts the streams */
+    coco_reset_seeds();
+    coco_evaluate_function(problem2, x, &y2[0]);
+    mu_check(y1[0] == y2[0]);
+
+    coco_problem_free(problem1);
+    coco_problem_free(problem2);
+    coco_problem_free(other_problem);
+  }
+
+  /* The legacy noise of a problem depends on the evaluations of the other problems */
+  suite = coco_suite("bbob-noisy", NULL, "dimensions: 5 function_indices: 1 noise_generator: legacy");
+  problem1 = coco_suite_get_next_problem(suite, NULL);
+  coco_reset_seeds();
+  coco_evaluate_function(problem1, x, &y1[0]);
+  coco_evaluate_function(problem1, x, &y1[1]);
+  coco_reset_seeds();
+  coco_evaluate_function(problem1, x, &y2[0]);
+  mu_check(y1[0] == y2[0]);
+  coco_reset_seeds();
+  other_problem = coco_get_bbob_noisy_problem(101, 5, 2, 1);
+  coco_evaluate_function(other_problem, x, &y_other);
+  coco_evaluate_function(problem1, x, &y2[1]);
+  mu_check(y1[1] == y2[1]);
+  coco_problem_free(other_problem);
+  coco_suite_free(suite);
+}
+
+/**
+ * Tests whether the mixed-integer problems with an evaluation cache return the same values as the ones
+ * without it, while evaluating the continuous problems only in new points.
+ */
+MU_TEST(test_transform_vars_discretize_cache) {
+
+  const char *suite_names[] = {"bbob-mixint", "bbob-biobj-mixint"};
+  coco_suite_t *suite, *cached_suite;
+  coco_problem_t *problem, *cached_problem, *inner_problem;
+  coco_random_state_t *random_generator = coco_random_new(1234);
+  transform_vars_discretize_data_t *data;
+  double x[3][5], y[2], cached_y[2];
+  const size_t order[6] = {0, 1, 2, 0, 1, 0};
+  size_t i, j, k, s, number_of_objectives;
+
+  for (s = 0; s < 2; s++) {
+    suite = coco_suite(suite_names[s], NULL, "dimensions: 5 instance_indices: 1 function_indices: 1-3");
+    cached_suite = coco_suite(suite_names[s], NULL,
+                              "dimensions: 5 instance_indices: 1 function_indices: 1-3 evaluation_cache_size: 2");
+    while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+      cached_problem = coco_suite_get_next_problem(cached_suite, NULL);
+      number_of_objectives = coco_problem_get_number_of_objectives(problem);
+
+      /* Points that only differ in their first (binary) variable, the last two are discretized to the same
+       * point */
+      for (j = 0; j < 5; j++)
+        x[0][j] = x[1][j] = x[2][j] = 6 * coco_random_uniform(random_generator) - 3;
+      x[0][0] = 0;
+      x[1][0] = 1;
+      x[2][0] = 1.2;
+
+      for (k = 0; k < 6; k++) {
+        i = order[k];
+        coco_evaluate_function(problem, x[i], y);
+        coco_evaluate_function(cached_problem, x[i], cached_y);
+        for (j = 0; j < number_of_objectives; j++)
+          mu_check(y[j] == cached_y[j]);
+      }
+      mu_check(coco_problem_get_evaluations(cached_problem) == 6);
+
+      /* Only the first evaluations in x0 and x1 evaluate the continuous problem */
+      if (number_of_objectives == 1) {
+        inner_problem = coco_problem_transformed_get_inner_problem(cached_problem);
+        data = (transform_vars_discretize_data_t *)coco_problem_transformed_get_data(inner_problem);
+        mu_check(data->cache->misses == 2 && data->cache->hits == 4);
+        mu_check(coco_problem_get_evaluations(coco_problem_transformed_get_inner_problem(inner_problem)) == 2);
+      }
+    }
+    coco_suite_free(suite);
+    coco_suite_free(cached_suite);
+  }
+  coco_random_free(random_generator);
+}
+
 int main(void) {
   MU_RUN_TEST(test_coco_evaluate_function);
+  MU_RUN_TEST(test_coco_evaluate_function_batch);
+  MU_RUN_TEST(test_coco_evaluate_function_no_allocations);
+  MU_RUN_TEST(test_transform_compiled);
+  MU_RUN_TEST(test_coco_evaluate_gradient);
+  MU_RUN_TEST(test_coco_evaluate_function_and_gradient);
   MU_RUN_TEST(test_coco_evaluate_constraint);
   MU_RUN_TEST(test_coco_is_feasible);
+  MU_RUN_TEST(test_coco_is_feasible_memo);
+  MU_RUN_TEST(test_c_linear_block);
   MU_RUN_TEST(test_coco_problem_get_largest_fvalues_of_interest_bbob_biobj_ext);
+  MU_RUN_TEST(test_coco_suite_get_problem_metadata);
+  MU_RUN_TEST(test_coco_cache);
+  MU_RUN_TEST(test_transform_vars_blockrotation_fused);
+  MU_RUN_TEST(test_f_gallagher_peaks_max_value);
+  MU_RUN_TEST(test_coco_noise_stream);
+  MU_RUN_TEST(test_transform_vars_discretize_cache);
 	
 	MU_REPORT();
 
@@ -0,0 +1,232 @@
+#include "minunit.h"
+
+#define COCO_SIMD /* The tests compare the SIMD code with the scalar code */
+#include "coco.c"
+#include "about_equal.h"
+
+#if COCO_SIMD_ENABLED
+
+/**
+ * Returns 1 if a and b agree up to a relative error of 1e-12 (or are both equal and not finite).
+ */
+static int simd_about_equal(const double a, const double b) {
+  if (a == b || (coco_is_nan(a) && coco_is_nan(b)))
+    return 1;
+  if (fabs(a - b) <= 1e-12 * coco_double_max(fabs(a), fabs(b)))
+    return 1;
+  fprintf(stderr, "ERROR: simd_about_equal failed: %.17g != %.17g\n", a, b);
+  return 0;
+}
+
+/**
+ * Fills x with random values of magnitudes between 10^min_exponent and 10^max_exponent and random signs.
+ */
+static void simd_random_vector(coco_random_state_t *random_generator, double *x, const size_t n,
+                               const double min_exponent, const double max_exponent) {
+  size_t i;
+  for (i = 0; i < n; ++i) {
+    x[i] = pow(10., min_exponent + (max_exponent - min_exponent) * coco_random_uniform(random_generator));
+    if (coco_random_uniform(random_generator) < 0.5)
+      x[i] = -x[i];
+  }
+}
+
+/**
+ * Tests the SIMD version of the oscillating transformation, also in place and with values for which the
+ * scalar code is used.
+ */
+MU_TEST(test_tosz_simd) {
+  const size_t n = 45;
+  coco_random_state_t *random_generator = coco_random_new(1);
+  double x[45], y[45], z[45];
+  tosz_data d;
+  size_t i;
+  int level, max_level;
+
+  coco_simd_level = COCO_SIMD_UNKNOWN;
+  max_level = coco_simd_get_level();
+  d.alpha = 0.1;
+  simd_random_vector(random_generator, x, n, -8, 3);
+  x[3] = 0.0;
+  x[20] = 1e35;     /* pow(exp(.), alpha) overflows in tosz_uv() */
+  x[27] = -1e-310;  /* Subnormal */
+  x[40] = INFINITY; /* In the tail */
+
+  for (level = COCO_SIMD_SSE2; level <= max_level; ++level) {
+    coco_simd_level = level;
+    mu_check(tosz_simd(x, y, n, d.alpha));
+    for (i = 0; i < n; ++i)
+      mu_check(simd_about_equal(y[i], tosz_uv(x[i], &d)));
+    memcpy(z, x, sizeof(z));
+    mu_check(tosz_simd(z, z, n, d.alpha));
+    mu_check(memcmp(z, y, sizeof(z)) == 0);
+  }
+  coco_simd_level = COCO_SIMD_UNKNOWN;
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests the SIMD version of the asymmetric transformation, also in place and with values for which the
+ * scalar code is used.
+ */
+MU_TEST(test_tasy_simd) {
+  const size_t n = 45;
+  coco_random_state_t *random_generator = coco_random_new(2);
+  double x[45], y[45], z[45];
+  tasy_data d;
+  size_t i;
+  int level, max_level;
+
+  coco_simd_level = COCO_SIMD_UNKNOWN;
+  max_level = coco_simd_get_level();
+  d.beta = 0.5;
+  d.n = n;
+  simd_random_vector(random_generator, x, n, -8, 2);
+  x[5] = 0.0;
+  x[12] = 1e300; /* pow() overflows */
+  x[33] = 1e-310;
+
+  for (level = COCO_SIMD_SSE2; level <= max_level; ++level) {
+    coco_simd_level = level;
+    mu_check(tasy_simd(x, y, n, d.beta));
+    for (i = 0; i < n; ++i) {
+      d.i = i;
+      mu_check(simd_about_equal(y[i], tasy_uv(x[i], &d)));
+    }
+    memcpy(z, x, sizeof(z));
+    mu_check(tasy_simd(z, z, n, d.beta));
+    mu_check(memcmp(z, y, sizeof(z)) == 0);
+  }
+  coco_simd_level = COCO_SIMD_UNKNOWN;
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests the SIMD sums of the Rastrigin, Weierstrass, Griewank-Rosenbrock, Schaffer's F7 and Katsuura
+ * functions.
+ */
+MU_TEST(test_raw_functions_simd) {
+  const size_t n = 43;
+  coco_random_state_t *random_generator = coco_random_new(3);
+  double x[43], sum_cos, sum_squares, expected_cos, expected_squares, result, expected, tmp, tmp2;
+  f_weierstrass_data_t data;
+  const size_t summands = sizeof(data.ak) / sizeof(data.ak[0]);
+  size_t i, j;
+  int level, max_level;
+
+  coco_simd_level = COCO_SIMD_UNKNOWN;
+  max_level = coco_simd_get_level();
+  for (i = 0; i < summands; ++i) {
+    data.ak[i] = pow(0.5, (double)i);
+    data.bk[i] = pow(3., (double)i);
+  }
+  for (i = 0; i < n; ++i)
+    x[i] = 10. * coco_random_uniform(random_generator) - 5.;
+
+  for (level = COCO_SIMD_SSE2; level <= max_level; ++level) {
+    coco_simd_level = level;
+
+    expected_cos = expected_squares = 0.0;
+    for (i = 0; i < n; ++i) {
+      expected_cos += cos(coco_two_pi * x[i]);
+      expected_squares += x[i] * x[i];
+    }
+    mu_check(coco_simd_sum_cos_two_pi(x, n, &sum_cos, &sum_squares));
+    mu_check(about_equal_value(sum_cos, expected_cos));
+    mu_check(simd_about_equal(sum_squares, expected_squares));
+    mu_check(coco_simd_sum_cos_two_pi(x, 5, &sum_cos, NULL)); /* Only the scalar tail */
+
+    expected = 0.0;
+    for (i = 0; i < n; ++i) {
+      for (j = 0; j < summands; ++j)
+        expected += cos(2 * coco_pi * (x[i] + 0.5) * data.bk[j]) * data.ak[j];
+    }
+    mu_check(f_weierstrass_simd(x, n, &data, &result));
+    mu_check(about_equal_value(result, expected));
+
+    expected = 0.0;
+    for (i = 0; i < n - 1; ++i) {
+      tmp = 100.0 * (x[i] * x[i] - x[i + 1]) * (x[i] * x[i] - x[i + 1]) + (1.0 - x[i]) * (1.0 - x[i]);
+      expected += tmp / 4000. - cos(tmp);
+    }
+    mu_check(f_griewank_rosenbrock_simd(x, n, &result));
+    mu_check(about_equal_value(result, expected));
+
+    expected = 0.0;
+    for (i = 0; i < n - 1; ++i) {
+      tmp = x[i] * x[i] + x[i + 1] * x[i + 1];
+      expected += pow(tmp, 0.25) * (1.0 + sin(50.0 * pow(tmp, 0.1)) * sin(50.0 * pow(tmp, 0.1)));
+    }
+    mu_check(f_schaffers_simd(x, n, &result));
+    mu_check(about_equal_value(result, expected));
+
+    expected = 1.0;
+    for (i = 0; i < n; ++i) {
+      tmp = 0;
+      for (j = 1; j < 33; ++j) {
+        tmp2 = pow(2., (double)j);
+        tmp += fabs(tmp2 * x[i] - coco_double_round(tmp2 * x[i])) / tmp2;
+      }
+      expected *= pow(1.0 + ((double)(long)i + 1) * tmp, 0.5);
+    }
+    mu_check(f_katsuura_simd(x, n, 0.5, &result));
+    mu_check(about_equal_value(result, expected));
+  }
+
+  /* Values outside of the range of the vector functions are left to the scalar code */
+  x[2] = 1e300;
+  mu_check(!coco_simd_sum_cos_two_pi(x, n, &sum_cos, &sum_squares));
+  mu_check(!f_weierstrass_simd(x, n, &data, &result));
+  mu_check(!f_griewank_rosenbrock_simd(x, n, &result));
+  mu_check(!f_schaffers_simd(x, n, &result));
+  mu_check(!f_katsuura_simd(x, n, 0.5, &result));
+  x[2] = x[3] = 0.0;
+  mu_check(!f_schaffers_simd(x, n, &result));
+
+  coco_simd_level = COCO_SIMD_UNKNOWN;
+  coco_random_free(random_generator);
+}
+
+#endif
+
+/**
+ * Tests that the problems evaluated with the SIMD code agree with the values of the scalar code to the
+ * precision of the bbob2009 test cases.
+ */
+MU_TEST(test_coco_simd_problems) {
+  const size_t functions[] = {3, 15, 16, 17, 19, 23, 24};
+  const double expected[] = {2045.4163811543656, 3071.4618221879605, 168.77841149468031, 4.1974663804532781,
+                             -89.303019428957185, 23.402153485728075, 919.61942164952063};
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  double x[40], y;
+  size_t i;
+
+  for (i = 0; i < 40; ++i)
+    x[i] = 0.1 * (double)(long)i - 2.0;
+
+  suite = coco_suite("bbob", "", "dimensions: 40 instance_indices: 1");
+  for (i = 0; i < sizeof(functions) / sizeof(functions[0]); ++i) {
+    problem = coco_suite_get_problem_by_function_dimension_instance(suite, functions[i], 40, 1);
+    coco_evaluate_function(problem, x, &y);
+    mu_check(about_equal_value(y, expected[i]));
+    coco_problem_free(problem);
+  }
+  coco_suite_free(suite);
+}
+
+/**
+ * Run all tests in this file.
+ */
+int main(void) {
+#if COCO_SIMD_ENABLED
+  MU_RUN_TEST(test_tosz_simd);
+  MU_RUN_TEST(test_tasy_simd);
+  MU_RUN_TEST(test_raw_functions_simd);
+#endif
+  MU_RUN_TEST(test_coco_simd_problems);
+
+  MU_REPORT();
+
+  return minunit_status;
+}
@@ -40,11 +40,75 @@ MU_TEST(test_coco_string_trim) {
 	}
 }
 
+/**
+ * Tests that coco_format_exponential(), coco_format_unsigned_long() and coco_format_int() produce the same
+ * output as sprintf().
+ */
+MU_TEST(test_coco_format) {
+
+  const double special_values[] = {0.0, -0.0, 0.5, 1.5, 2.5, 0.125, -0.375, 9.5, 9.9999999995, 99.5, 1e22, 1e23,
+                                   0.1, 1.0 / 3.0, 123456789.0, 1e-300, 1e300, 5e-324, DBL_MAX, -DBL_MIN};
+  coco_random_state_t *random_generator = coco_random_new(12345);
+  char expected[COCO_FORMAT_MAX_LENGTH], actual[COCO_FORMAT_MAX_LENGTH];
+  double value;
+  size_t i, length;
+  int precision, width, plus_sign;
+
+  for (i = 0; i < sizeof(special_values) / sizeof(double); i++) {
+    for (precision = 0; precision <= 32; precision++) {
+      for (width = 0; width <= 32; width += 8) {
+        plus_sign = precision % 2;
+        length = coco_format_exponential(actual, special_values[i], width, precision, plus_sign);
+        sprintf(expected, plus_sign ? "%+*.*e" : "%*.*e", width, precision, special_values[i]);
+        mu_check(strcmp(actual, expected) == 0);
+        mu_check(length == strlen(expected));
+      }
+    }
+  }
+
+  /* Infinite and undefined values */
+  coco_format_exponential(actual, INFINITY, 10, 9, 1);
+  sprintf(expected, "%+10.9e", INFINITY);
+  mu_check(strcmp(actual, expected) == 0);
+  coco_format_exponential(actual, -INFINITY, 5, 4, 0);
+  sprintf(expected, "%5.4e", -INFINITY);
+  mu_check(strcmp(actual, expected) == 0);
+  coco_format_exponential(actual, NAN, 10, 9, 1);
+  sprintf(expected, "%+10.9e", NAN);
+  mu_check(strcmp(actual, expected) == 0);
+
+  /* Random values of all magnitudes */
+  for (i = 0; i < 200000; i++) {
+    value = coco_random_uniform(random_generator) * pow(10, 600 * coco_random_uniform(random_generator) - 300);
+    if (i % 2 == 0)
+      value = -value;
+    precision = (int)(i % 18);
+    plus_sign = (int)(i % 3 == 0);
+    coco_format_exponential(actual, value, 10, precision, plus_sign);
+    sprintf(expected, plus_sign ? "%+10.*e" : "%10.*e", precision, value);
+    mu_check(strcmp(actual, expected) == 0);
+  }
+
+  /* Integers */
+  coco_format_unsigned_long(actual, 0);
+  mu_check(strcmp(actual, "0") == 0);
+  coco_format_unsigned_long(actual, 1234567890UL);
+  mu_check(strcmp(actual, "1234567890") == 0);
+  coco_format_int(actual, -2147483647 - 1);
+  sprintf(expected, "%d", -2147483647 - 1);
+  mu_check(strcmp(actual, expected) == 0);
+  coco_format_int(actual, 7);
+  mu_check(strcmp(actual, "7") == 0);
+
+  coco_random_free(random_generator);
+}
+
 /**
  * Run all tests in this file.
  */
 int main(void) {
   MU_RUN_TEST(test_coco_string_trim);
+  MU_RUN_TEST(test_coco_format);
 
   MU_REPORT();
 
@@ -0,0 +1,302 @@
+#include <stdio.h>
+#include <pthread.h>
+
+#include "minunit.h"
+#include "about_equal.h"
+
+#include "coco.c"
+
+#define TEST_COCO_THREADS_NUMBER_OF_THREADS 4
+#define TEST_COCO_THREADS_NUMBER_OF_POINTS 20
+
+/**
+ * The work of one thread: evaluate every number_of_threads-th problem of its own instance of the suite.
+ */
+typedef struct {
+  const char *suite_name;
+  const char *suite_options;
+  coco_observer_t *observer; /* Shared by all threads (or NULL) */
+  size_t thread_index;
+  size_t number_of_threads;
+  double *values;            /* TEST_COCO_THREADS_NUMBER_OF_POINTS values for each problem of the suite */
+  size_t number_of_problems; /* The number of problems evaluated by this thread */
+} test_coco_threads_work_t;
+
+/**
+ * Evaluates the problems assigned to one thread at deterministic points.
+ */
+static void *test_coco_threads_run(void *argument) {
+  test_coco_threads_work_t *work = (test_coco_threads_work_t *)argument;
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  coco_random_state_t *random_generator;
+  const double *lower, *upper;
+  double x[40], y[2], constraints[400];
+  size_t problem_index, i, j, dimension;
+
+  suite = coco_suite(work->suite_name, "", work->suite_options);
+  work->number_of_problems = 0;
+  for (problem_index = work->thread_index; problem_index < coco_suite_get_number_of_problems(suite);
+       problem_index += work->number_of_threads) {
+    problem = coco_suite_get_problem(suite, problem_index);
+    if (problem == NULL) /* Filtered out by the suite options */
+      continue;
+    if (work->observer != NULL)
+      problem = coco_problem_add_observer(problem, work->observer);
+    dimension = coco_problem_get_dimension(problem);
+    lower = coco_problem_get_smallest_values_of_interest(problem);
+    upper = coco_problem_get_largest_values_of_interest(problem);
+    random_generator = coco_random_new((uint32_t)(problem_index + 1));
+    for (j = 0; j < TEST_COCO_THREADS_NUMBER_OF_POINTS; j++) {
+      for (i = 0; i < dimension; i++)
+        x[i] = lower[i] + (upper[i] - lower[i]) * coco_random_uniform(random_generator);
+      coco_evaluate_function(problem, x, y);
+      if (coco_problem_get_number_of_constraints(problem) > 0)
+        coco_evaluate_constraint(problem, x, constraints);
+      work->values[problem_index * TEST_COCO_THREADS_NUMBER_OF_POINTS + j] = y[0];
+    }
+    coco_random_free(random_generator);
+    coco_problem_free(problem);
+    work->number_of_problems++;
+  }
+  coco_suite_free(suite);
+  return NULL;
+}
+
+/**
+ * Evaluates all problems of the suite using the given number of threads and returns the values.
+ */
+static double *test_coco_threads_evaluate_suite(const char *suite_name, const char *suite_options,
+                                                coco_observer_t *observer, size_t number_of_threads) {
+  test_coco_threads_work_t work[TEST_COCO_THREADS_NUMBER_OF_THREADS];
+  pthread_t threads[TEST_COCO_THREADS_NUMBER_OF_THREADS];
+  coco_suite_t *suite;
+  double *values;
+  size_t number_of_values, i, t;
+
+  suite = coco_suite(suite_name, "", suite_options);
+  number_of_values = coco_suite_get_number_of_problems(suite) * TEST_COCO_THREADS_NUMBER_OF_POINTS;
+  coco_suite_free(suite);
+  values = coco_allocate_vector(number_of_values);
+  for (i = 0; i < number_of_values; i++)
+    values[i] = 0;
+
+  for (t = 0; t < number_of_threads; t++) {
+    work[t].suite_name = suite_name;
+    work[t].suite_options = suite_options;
+    work[t].observer = observer;
+    work[t].thread_index = t;
+    work[t].number_of_threads = number_of_threads;
+    work[t].values = values;
+    pthread_create(&threads[t], NULL, test_coco_threads_run, &work[t]);
+  }
+  for (t = 0; t < number_of_threads; t++)
+    pthread_join(threads[t], NULL);
+  return values;
+}
+
+/**
+ * Checks that concurrent evaluations give the same results as sequential ones for the given suite.
+ */
+static int test_coco_threads_suite_matches_sequential(const char *suite_name, const char *suite_options) {
+  double *sequential, *concurrent;
+  coco_suite_t *suite;
+  size_t i, number_of_values;
+  int result = 1;
+
+  suite = coco_suite(suite_name, "", suite_options);
+  number_of_values = coco_suite_get_number_of_problems(suite) * TEST_COCO_THREADS_NUMBER_OF_POINTS;
+  coco_suite_free(suite);
+
+  sequential = test_coco_threads_evaluate_suite(suite_name, suite_options, NULL, 1);
+  concurrent = test_coco_threads_evaluate_suite(suite_name, suite_options, NULL,
+                                                TEST_COCO_THREADS_NUMBER_OF_THREADS);
+  for (i = 0; i < number_of_values; i++) {
+    if (sequential[i] != concurrent[i])
+      result = 0;
+  }
+  coco_free_memory(sequential);
+  coco_free_memory(concurrent);
+  return result;
+}
+
+/**
+ * Tests that problems of several suites can be constructed and evaluated from several threads at once.
+ */
+MU_TEST(test_coco_threads_evaluate_function) {
+  double *values;
+
+  mu_check(test_coco_threads_suite_matches_sequential("bbob", "dimensions: 2,5,10 instance_indices: 1-2"));
+  mu_check(test_coco_threads_suite_matches_sequential("bbob-largescale",
+                                                      "dimensions: 20,40 function_indices: 1,5,15 "
+                                                      "instance_indices: 1"));
+  mu_check(test_coco_threads_suite_matches_sequential("bbob-constrained",
+                                                      "dimensions: 2,10 instance_indices: 1"));
+  mu_check(test_coco_threads_suite_matches_sequential("bbob-mixint", "dimensions: 5,10 instance_indices: 1"));
+  mu_check(test_coco_threads_suite_matches_sequential("bbob-biobj", "dimensions: 2,5 instance_indices: 1"));
+  /* Each noisy problem draws its noise from its own stream */
+  mu_check(test_coco_threads_suite_matches_sequential("bbob-noisy", "dimensions: 2,5 instance_indices: 1"));
+
+  /* The legacy noise is drawn from seeds shared by all threads, so only check that the evaluation works */
+  values = test_coco_threads_evaluate_suite("bbob-noisy", "dimensions: 2,5 instance_indices: 1 noise_generator: legacy",
+                                            NULL, TEST_COCO_THREADS_NUMBER_OF_THREADS);
+  coco_free_memory(values);
+}
+
+/**
+ * Counts the lines of the file that start with the given string.
+ */
+static size_t test_coco_threads_count_lines_starting_with(const char *file_name, const char *start) {
+  FILE *file;
+  char line[4096];
+  size_t count = 0;
+
+  file = fopen(file_name, "r");
+  if (file == NULL)
+    return 0;
+  while (fgets(line, sizeof(line), file) != NULL) {
+    if (strncmp(line, start, strlen(start)) == 0)
+      count++;
+  }
+  fclose(file);
+  return count;
+}
+
+/**
+ * Tests the thread-safe mode of the bbob observer, which observes several problems at the same time.
+ */
+MU_TEST(test_coco_threads_observer_bbob) {
+  const char *suite_options = "dimensions: 2,3,5 function_indices: 1-6 instance_indices: 1-5";
+  coco_observer_t *observer;
+  double *values;
+  char *result_folder, *file_name;
+  size_t function, number_of_lines = 0;
+
+  observer = coco_observer("bbob", "result_folder: threads thread_safe: 1");
+  result_folder = coco_strdup(observer->result_folder);
+  values = test_coco_threads_evaluate_suite("bbob", suite_options, observer, TEST_COCO_THREADS_NUMBER_OF_THREADS);
+  coco_observer_free(observer);
+  coco_free_memory(values);
+
+  /* Each observed problem gets its own line in the info file and its own .dat file */
+  for (function = 1; function <= 6; function++) {
+    file_name = coco_strdupf("%s%sbbobexp_f%lu.info", result_folder, coco_path_separator, (unsigned long)function);
+    number_of_lines += test_coco_threads_count_lines_starting_with(file_name, "suite = 'bbob'");
+    coco_free_memory(file_name);
+  }
+  mu_check(number_of_lines == 3 * 6 * 5);
+
+  file_name = coco_strdupf("%s%sdata_f1%sbbobexp_f1_DIM2-0004.dat", result_folder, coco_path_separator,
+                           coco_path_separator);
+  mu_check(coco_file_exists(file_name));
+  mu_check(test_coco_threads_count_lines_starting_with(file_name, "%") == 1);
+  coco_free_memory(file_name);
+
+  /* The observer might be freed before the observed problems */
+  observer = coco_observer("bbob", "result_folder: threads thread_safe: 1");
+  coco_free_memory(result_folder);
+  result_folder = coco_strdup(observer->result_folder);
+  {
+    coco_suite_t *suite = coco_suite("bbob", "", "dimensions: 2 function_indices: 1 instance_indices: 1-2");
+    coco_problem_t *problem1 = coco_problem_add_observer(coco_suite_get_problem(suite, 0), observer);
+    coco_problem_t *problem2 = coco_problem_add_observer(coco_suite_get_problem(suite, 1), observer);
+    double x[2] = {0, 0}, y[1];
+
+    coco_evaluate_function(problem1, x, y);
+    coco_evaluate_function(problem2, x, y);
+    coco_observer_free(observer);
+    coco_problem_free(problem2);
+    coco_problem_free(problem1);
+    coco_suite_free(suite);
+  }
+  file_name = coco_strdupf("%s%sbbobexp_f1.info", result_folder, coco_path_separator);
+  mu_check(test_coco_threads_count_lines_starting_with(file_name, "suite = 'bbob'") == 2);
+  coco_free_memory(file_name);
+
+  coco_free_memory(result_folder);
+}
+
+/**
+ * A solver that evaluates the problem a few times and counts how often each problem was solved.
+ */
+static void test_coco_threads_solver(coco_problem_t *problem, void *solver_data) {
+  size_t *number_of_solves = (size_t *)solver_data;
+  double x[40], y[2];
+  size_t i, j;
+
+  for (j = 0; j < TEST_COCO_THREADS_NUMBER_OF_POINTS; j++) {
+    for (i = 0; i < coco_problem_get_dimension(problem); i++)
+      x[i] = (double)j / TEST_COCO_THREADS_NUMBER_OF_POINTS;
+    coco_evaluate_function(problem, x, y);
+  }
+  /* Each problem is solved by one thread only */
+  number_of_solves[coco_problem_get_suite_dep_index(problem)]++;
+}
+
+/**
+ * Tests that coco_suite_run_experiment() solves each problem of the suite exactly once.
+ */
+MU_TEST(test_coco_threads_suite_run_experiment) {
+  const char *suite_options = "dimensions: 2,5,10,20 function_indices: 1,2,8,9 instance_indices: 1-3";
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  size_t *number_of_solves;
+  size_t i, number_of_problems, number_of_threads, function_idx, dimension_idx, instance_idx;
+  char *file_name;
+  int all_solved_once, is_in_suite;
+
+  suite = coco_suite("bbob", "", suite_options);
+  number_of_problems = coco_suite_get_number_of_problems(suite);
+  number_of_solves = coco_allocate_vector_size_t(number_of_problems);
+
+  for (number_of_threads = 0; number_of_threads <= 5; number_of_threads++) {
+    for (i = 0; i < number_of_problems; i++)
+      number_of_solves[i] = 0;
+    coco_suite_run_experiment(suite, NULL, test_coco_threads_solver, number_of_solves, number_of_threads);
+    all_solved_once = 1;
+    for (i = 0; i < number_of_problems; i++) {
+      coco_suite_decode_problem_index(suite, i, &function_idx, &dimension_idx, &instance_idx);
+      is_in_suite = (suite->functions[function_idx] != 0) && (suite->dimensions[dimension_idx] != 0) &&
+                    (suite->instances[instance_idx] != 0);
+      if (number_of_solves[i] != (size_t)is_in_suite)
+        all_solved_once = 0;
+    }
+    mu_check(all_solved_once);
+  }
+
+  /* With a thread-safe observer, all problems get logged */
+  observer = coco_observer("bbob", "result_folder: threads thread_safe: 1");
+  for (i = 0; i < number_of_problems; i++)
+    number_of_solves[i] = 0;
+  coco_suite_run_experiment(suite, observer, test_coco_threads_solver, number_of_solves, 4);
+  file_name = coco_strdupf("%s%sbbobexp_f9.info", observer->result_folder, coco_path_separator);
+  coco_observer_free(observer);
+  mu_check(test_coco_threads_count_lines_starting_with(file_name, "suite = 'bbob'") == 4 * 3);
+  coco_free_memory(file_name);
+
+  /* Observers that observe one problem at a time are used with one thread */
+  observer = coco_observer("bbob", "result_folder: threads");
+  coco_suite_run_experiment(suite, observer, test_coco_threads_solver, number_of_solves, 4);
+  file_name = coco_strdupf("%s%sbbobexp_f9.info", observer->result_folder, coco_path_separator);
+  coco_observer_free(observer);
+  mu_check(test_coco_threads_count_lines_starting_with(file_name, "suite = 'bbob'") == 4);
+  coco_free_memory(file_name);
+
+  coco_free_memory(number_of_solves);
+  coco_suite_free(suite);
+}
+
+/**
+ * Run all tests in this file.
+ */
+int main(void) {
+  coco_set_log_level("error");
+
+  MU_RUN_TEST(test_coco_threads_evaluate_function);
+  MU_RUN_TEST(test_coco_threads_observer_bbob);
+  MU_RUN_TEST(test_coco_threads_suite_run_experiment);
+
+  MU_REPORT();
+
+  return MU_EXIT_CODE;
+}
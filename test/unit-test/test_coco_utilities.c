@@ -538,6 +538,104 @@ MU_TEST(test_coco_is_orthogonal) {
   coco_free_memory(M);
 }
 
+/**
+ * Tests that bbob2009_compute_rotation returns orthogonal matrices also in dimensions larger than the ones
+ * used in BBOB2009.
+ */
+MU_TEST(test_bbob2009_compute_rotation) {
+
+  const size_t dimensions[] = {1, 2, 40, 45, 100};
+  double **B, *M, *b, *x, y;
+  coco_problem_t *problem;
+  size_t i;
+
+  for (i = 0; i < sizeof(dimensions) / sizeof(dimensions[0]); i++) {
+    B = bbob2009_allocate_matrix(dimensions[i], dimensions[i]);
+    M = coco_allocate_vector(dimensions[i] * dimensions[i]);
+    b = coco_allocate_vector(dimensions[i]);
+    bbob2009_compute_rotation(B, 1000000 + (long)i, dimensions[i]);
+    bbob2009_copy_rotation_matrix(B, M, b, dimensions[i]);
+    mu_check(coco_is_orthogonal(M, dimensions[i], dimensions[i]));
+    bbob2009_free_matrix(B, dimensions[i]);
+    coco_free_memory(M);
+    coco_free_memory(b);
+  }
+
+  /* A full-rotation bbob problem in 80-D */
+  problem = coco_get_bbob_problem(10, 80, 1);
+  x = coco_allocate_vector(80);
+  coco_problem_get_initial_solution(problem, x);
+  coco_evaluate_function(problem, x, &y);
+  mu_check(y > coco_problem_get_final_target_fvalue1(problem));
+  coco_free_memory(x);
+  coco_problem_free(problem);
+}
+
+/**
+ * Tests coco_random_philox4x32 on the known-answer vectors of the reference implementation (Random123).
+ */
+MU_TEST(test_coco_random_philox4x32) {
+
+  uint32_t counter1[4] = {0, 0, 0, 0}, key1[2] = {0, 0};
+  uint32_t counter2[4] = {0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL};
+  uint32_t key2[2] = {0xFFFFFFFFUL, 0xFFFFFFFFUL};
+  uint32_t counter3[4] = {0x243F6A88UL, 0x85A308D3UL, 0x13198A2EUL, 0x03707344UL};
+  uint32_t key3[2] = {0xA4093822UL, 0x299F31D0UL};
+  double u;
+
+  coco_random_philox4x32(counter1, key1);
+  mu_check(counter1[0] == 0x6627E8D5UL && counter1[1] == 0xE169C58DUL && counter1[2] == 0xBC57AC4CUL &&
+           counter1[3] == 0x9B00DBD8UL);
+  coco_random_philox4x32(counter2, key2);
+  mu_check(counter2[0] == 0x408F276DUL && counter2[1] == 0x41C83B0EUL && counter2[2] == 0xA20BC7C6UL &&
+           counter2[3] == 0x6D5451FDUL);
+  coco_random_philox4x32(counter3, key3);
+  mu_check(counter3[0] == 0xD16CFE09UL && counter3[1] == 0x94FDCCEBUL && counter3[2] == 0x5001E420UL &&
+           counter3[3] == 0x24126EA1UL);
+
+  /* The uniform values lie strictly between 0 and 1 */
+  u = coco_random_words_to_uniform(0, 0);
+  mu_check(u > 0 && u < 1e-15);
+  u = coco_random_words_to_uniform(0xFFFFFFFFUL, 0xFFFFFFFFUL);
+  mu_check(u < 1 && u > 1 - 1e-15);
+}
+
+/**
+ * Tests the least-recently-used replacement of coco_evaluation_cache_t.
+ */
+MU_TEST(test_coco_evaluation_cache) {
+
+  coco_evaluation_cache_t *cache = coco_evaluation_cache_allocate(2, 3, 2);
+  double key1[3] = {1, 2, 3}, key2[3] = {1, 2, 4}, key3[3] = {0, 2, 3}, key4[3] = {-0.0, 2, 3};
+  double value1[2] = {1, -1}, value2[2] = {2, -2}, value3[2] = {3, -3}, value[2] = {0, 0};
+
+  mu_check(!coco_evaluation_cache_lookup(cache, key1, value));
+  coco_evaluation_cache_insert(cache, key1, value1);
+  coco_evaluation_cache_insert(cache, key2, value2);
+  mu_check(coco_evaluation_cache_lookup(cache, key1, value));
+  mu_check(value[0] == 1 && value[1] == -1);
+
+  /* key2 is replaced, since key1 was used more recently */
+  coco_evaluation_cache_insert(cache, key3, value3);
+  mu_check(!coco_evaluation_cache_lookup(cache, key2, value));
+  mu_check(coco_evaluation_cache_lookup(cache, key3, value));
+  mu_check(value[0] == 3 && value[1] == -3);
+  mu_check(coco_evaluation_cache_lookup(cache, key1, value));
+  mu_check(value[0] == 1 && value[1] == -1);
+
+  /* Keys are matched exactly */
+  mu_check(!coco_evaluation_cache_lookup(cache, key4, value));
+
+  /* key3 is replaced */
+  coco_evaluation_cache_insert(cache, key2, value2);
+  mu_check(!coco_evaluation_cache_lookup(cache, key3, value));
+  mu_check(coco_evaluation_cache_lookup(cache, key2, value));
+  mu_check(value[0] == 2 && value[1] == -2);
+  mu_check(cache->hits == 4 && cache->misses == 4);
+
+  coco_evaluation_cache_free(cache);
+}
+
 /**
  * Run all tests in this file.
  */
@@ -553,6 +651,9 @@ int main(void) {
   MU_RUN_TEST(test_coco_string_parse_ranges);
   MU_RUN_TEST(test_coco_create_remove_directory);
   MU_RUN_TEST(test_coco_is_orthogonal);
+  MU_RUN_TEST(test_bbob2009_compute_rotation);
+  MU_RUN_TEST(test_coco_random_philox4x32);
+  MU_RUN_TEST(test_coco_evaluation_cache);
 
   MU_REPORT();
 
@@ -25,6 +25,27 @@ int count_lines_in_file(const char *filename) {
     return lines;
 }
 
+/**
+ * Returns 1 if the two files have the same contents and 0 otherwise.
+ */
+static int files_are_equal(const char *filename1, const char *filename2) {
+  FILE *file1 = fopen(filename1, "rb");
+  FILE *file2 = fopen(filename2, "rb");
+  int ch1, ch2, result = 0;
+  if ((file1 != NULL) && (file2 != NULL)) {
+    do {
+      ch1 = fgetc(file1);
+      ch2 = fgetc(file2);
+    } while ((ch1 == ch2) && (ch1 != EOF));
+    result = (ch1 == ch2);
+  }
+  if (file1 != NULL)
+    fclose(file1);
+  if (file2 != NULL)
+    fclose(file2);
+  return result;
+}
+
 /**
  * Tests the logarithmic and linear triggers via the bbob logger.
  */
@@ -227,12 +248,131 @@ MU_TEST(test_logger_bbob_last_line) {
 }
 
 
+/**
+ * Test when the buffered output of the data files appears in the files.
+ */
+MU_TEST(test_logger_bbob_flush) {
+
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem;
+
+  double *x = coco_allocate_vector(2);
+  double *y = coco_allocate_vector(1);
+  char *filename;
+
+  /* Buffered output appears at a restart and when the problem is freed */
+  suite = coco_suite("bbob", "", "dimensions: 2 function_indices: 1 instance_indices: 1");
+  observer = coco_observer("bbob", "flush_interval: 1000");
+  problem = coco_suite_get_next_problem(suite, observer);
+  filename = coco_strdupf("%s%s%s%s%s", observer->result_folder, coco_path_separator, "data_f1",
+    coco_path_separator, "bbobexp_f1_DIM2.dat");
+
+  x[0] = 0; x[1] = 0;
+  coco_evaluate_function(problem, x, y);
+  x[0] = 0; x[1] = -1;
+  coco_evaluate_function(problem, x, y);
+  mu_check(count_lines_in_file(filename) == 0);
+  coco_observer_signal_restart(observer, problem);
+  mu_check(count_lines_in_file(filename) == 3);
+  x[0] = 0.2; x[1] = -1.1;
+  coco_evaluate_function(problem, x, y);
+  mu_check(count_lines_in_file(filename) == 3);
+  coco_suite_free(suite);
+  mu_check(count_lines_in_file(filename) == 4);
+  coco_free_memory(filename);
+  coco_observer_free(observer);
+
+  /* Impatient users see each line right away */
+  suite = coco_suite("bbob", "", "dimensions: 2 function_indices: 1 instance_indices: 1");
+  observer = coco_observer("bbob", "impatient: 1");
+  problem = coco_suite_get_next_problem(suite, observer);
+  filename = coco_strdupf("%s%s%s%s%s", observer->result_folder, coco_path_separator, "data_f1",
+    coco_path_separator, "bbobexp_f1_DIM2.dat");
+
+  x[0] = 0; x[1] = 0;
+  coco_evaluate_function(problem, x, y);
+  mu_check(count_lines_in_file(filename) == 2);
+  x[0] = 0; x[1] = -1;
+  coco_evaluate_function(problem, x, y);
+  mu_check(count_lines_in_file(filename) == 3);
+  coco_suite_free(suite);
+  coco_free_memory(filename);
+  coco_observer_free(observer);
+
+  coco_free_memory(x);
+  coco_free_memory(y);
+}
+
+/**
+ * Tests that the data files written in the binary format are converted to the same files as written in the
+ * text format.
+ */
+MU_TEST(test_logger_bbob_binary_format) {
+
+  const char *extensions[4] = { ".dat", ".tdat", ".rdat", ".mdat" };
+  const char *formats[2] = { "text", "binary" };
+  char *folders[2];
+  char *text_filename, *binary_filename, *converted_filename;
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem;
+  coco_random_state_t *random_generator;
+  double *x = coco_allocate_vector(2);
+  double y[1];
+  char *options;
+  size_t i, j, k;
+
+  for (i = 0; i < 2; i++) {
+    random_generator = coco_random_new(1);
+    suite = coco_suite("bbob", "", "dimensions: 2 function_indices: 1,2 instance_indices: 1,2");
+    options = coco_strdupf("result_folder: binary_format format: %s", formats[i]);
+    observer = coco_observer("bbob", options);
+    while ((problem = coco_suite_get_next_problem(suite, observer)) != NULL) {
+      for (j = 0; j < 200; j++) {
+        for (k = 0; k < 2; k++)
+          x[k] = 10 * coco_random_uniform(random_generator) - 5;
+        coco_evaluate_function(problem, x, y);
+      }
+    }
+    folders[i] = coco_strdup(observer->result_folder);
+    coco_observer_free(observer);
+    coco_suite_free(suite);
+    coco_free_memory(options);
+    coco_random_free(random_generator);
+  }
+
+  for (j = 1; j <= 2; j++) {
+    for (k = 0; k < 4; k++) {
+      text_filename = coco_strdupf("%s%sdata_f%lu%sbbobexp_f%lu_DIM2%s", folders[0], coco_path_separator,
+                                   (unsigned long)j, coco_path_separator, (unsigned long)j, extensions[k]);
+      converted_filename = coco_strdupf("%s%sdata_f%lu%sbbobexp_f%lu_DIM2%s", folders[1], coco_path_separator,
+                                        (unsigned long)j, coco_path_separator, (unsigned long)j, extensions[k]);
+      binary_filename = coco_strdupf("%s%s", converted_filename, LOGGER_BINARY_FILE_EXTENSION);
+      mu_check(coco_file_exists(binary_filename));
+      coco_observer_convert_binary_file(binary_filename, converted_filename);
+      mu_check(files_are_equal(text_filename, converted_filename));
+      coco_free_memory(text_filename);
+      coco_free_memory(binary_filename);
+      coco_free_memory(converted_filename);
+    }
+  }
+
+  for (i = 0; i < 2; i++) {
+    coco_remove_directory(folders[i]);
+    coco_free_memory(folders[i]);
+  }
+  coco_free_memory(x);
+}
+
 /**
  * Run all tests in this file.
  */
 int main(void) {
   MU_RUN_TEST(test_logger_bbob_triggers);
   MU_RUN_TEST(test_logger_bbob_last_line);
+  MU_RUN_TEST(test_logger_bbob_flush);
+  MU_RUN_TEST(test_logger_bbob_binary_format);
 
   MU_REPORT();
 
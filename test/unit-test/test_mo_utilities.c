@@ -43,41 +43,37 @@ MU_TEST(test_mo_get_norm) {
 }
 
 /**
- * Tests the function mo_normalize.
+ * Tests the function mo_normalize_to.
  */
-MU_TEST(test_mo_normalize) {
+MU_TEST(test_mo_normalize_to) {
 
   double *y = coco_allocate_vector(2);
   double *ideal = coco_allocate_vector(2);
   double *nadir = coco_allocate_vector(2);
-  double *result;
+  double result[2];
 
   ideal[0] = 100;
   ideal[1] = 0.2;
   nadir[0] = 200;
   nadir[1] = 0.22;
 
-  result = mo_normalize(ideal, ideal, nadir, 2);
+  mo_normalize_to(ideal, ideal, nadir, 2, result);
   /* Note that the ideal point gets adjusted to be equal to an extreme point! */
   mu_check(about_equal_2d(result, 0, 1));
-  coco_free_memory(result);
 
-  result = mo_normalize(nadir, ideal, nadir, 2);
+  mo_normalize_to(nadir, ideal, nadir, 2, result);
   mu_check(about_equal_2d(result, 1, 1));
-  coco_free_memory(result);
 
   y[0] = 50;
   y[1] = 0.1;
-  result = mo_normalize(y, ideal, nadir, 2);
+  mo_normalize_to(y, ideal, nadir, 2, result);
   /* Note that a point better than the ideal point gets adjusted to be equal to an extreme point! */
   mu_check(about_equal_2d(result, 0, 1));
-  coco_free_memory(result);
 
   y[0] = 180;
   y[1] = 0.21;
-  result = mo_normalize(y, ideal, nadir, 2);
+  mo_normalize_to(y, ideal, nadir, 2, result);
   mu_check(about_equal_2d(result, 0.8, 0.5));
-  coco_free_memory(result);
 
   coco_free_memory(y);
   coco_free_memory(ideal);
@@ -85,9 +81,9 @@ MU_TEST(test_mo_normalize) {
 }
 
 /**
- * Tests the function mo_get_dominance.
+ * Tests the function mo_front_get_dominance.
  */
-MU_TEST(test_mo_get_dominance) {
+MU_TEST(test_mo_front_get_dominance) {
 
   double *a = coco_allocate_vector(2);
   double *b = coco_allocate_vector(2);
@@ -99,11 +95,11 @@ MU_TEST(test_mo_get_dominance) {
   c[0] = 0.6;  c[1] = 0.4;
   d[0] = 0.6;  d[1] = 0.4;
 
-  mu_check(mo_get_dominance(a, b, 2) == 0);
-  mu_check(mo_get_dominance(c, b, 2) == -1);
-  mu_check(mo_get_dominance(b, d, 2) == 1);
-  mu_check(mo_get_dominance(c, d, 2) == -2);
-  mu_check(mo_get_dominance(a, a, 2) == -2);
+  mu_check(mo_front_get_dominance(a, b) == 0);
+  mu_check(mo_front_get_dominance(c, b) == -1);
+  mu_check(mo_front_get_dominance(b, d) == 1);
+  mu_check(mo_front_get_dominance(c, d) == -2);
+  mu_check(mo_front_get_dominance(a, a) == -2);
 
   coco_free_memory(a);
   coco_free_memory(b);
@@ -164,15 +160,175 @@ MU_TEST(test_mo_get_distance_to_ROI) {
   coco_free_memory(y);
 }
 
+/**
+ * Compares two items of the AVL trees of test_mo_avl_tree_node_pool.
+ */
+static int test_mo_avl_tree_compare(const size_t *item1, const size_t *item2, void *userdata) {
+  (void)userdata; /* To silence the compiler */
+  return AVL_CMP(*item1, *item2);
+}
+
+/**
+ * Tests AVL trees that share a pool of nodes.
+ */
+MU_TEST(test_mo_avl_tree_node_pool) {
+
+  const size_t number_of_items = 1000;
+  size_t *items = coco_allocate_vector_size_t(number_of_items);
+  avl_node_pool_t *pool = avl_node_pool_construct();
+  avl_tree_t *tree1 = avl_tree_construct((avl_compare_t)test_mo_avl_tree_compare, NULL);
+  avl_tree_t *tree2 = avl_tree_construct((avl_compare_t)test_mo_avl_tree_compare, NULL);
+  avl_node_t *node;
+  size_t i, count;
+
+  avl_tree_set_allocator(tree1, &pool->allocator);
+  avl_tree_set_allocator(tree2, &pool->allocator);
+
+  /* Insert the items in a scrambled order */
+  for (i = 0; i < number_of_items; i++) {
+    items[i] = (i * 7919) % number_of_items;
+    mu_check(avl_item_insert(tree1, &items[i]) != NULL);
+    mu_check(avl_item_insert(tree2, &items[i]) != NULL);
+  }
+
+  /* Delete the odd items from the first tree and insert them again, reusing the nodes */
+  for (i = 0; i < number_of_items; i++) {
+    if (items[i] % 2 == 1)
+      avl_item_delete(tree1, &items[i]);
+  }
+  mu_check(AVL_NODE_COUNT(tree1->top) == number_of_items / 2);
+  mu_check(pool->free_nodes != NULL);
+  for (i = 0; i < number_of_items; i++) {
+    if (items[i] % 2 == 1)
+      mu_check(avl_item_insert(tree1, &items[i]) != NULL);
+  }
+  mu_check(pool->free_nodes == NULL);
+
+  /* Both trees contain all items in order */
+  mu_check(AVL_NODE_COUNT(tree1->top) == number_of_items);
+  mu_check(AVL_NODE_COUNT(tree2->top) == number_of_items);
+  for (node = tree1->head, count = 0; node != NULL; node = node->next, count++)
+    mu_check(*(size_t *)node->item == count);
+  mu_check(count == number_of_items);
+  for (node = tree2->head, count = 0; node != NULL; node = node->next, count++)
+    mu_check(*(size_t *)node->item == count);
+  mu_check(count == number_of_items);
+
+  avl_tree_purge(tree1);
+  mu_check(tree1->head == NULL);
+  mu_check(avl_item_insert(tree1, &items[0]) != NULL);
+
+  avl_tree_destruct(tree1);
+  avl_tree_destruct(tree2);
+  avl_node_pool_destruct(pool);
+  coco_free_memory(items);
+}
+
 /**
  * Run all tests in this file.
  */
+/**
+ * Counts the solutions removed from the front in test_mo_front.
+ */
+static void test_mo_front_remove(void *item, void *userdata) {
+  (void)item; /* To silence the compiler */
+  (*(size_t *)userdata)++;
+}
+
+/**
+ * Tests the front of nondominated solutions against a brute-force archive, with enough solutions to fill
+ * several blocks of the front.
+ */
+MU_TEST(test_mo_front) {
+
+  const size_t number_of_solutions = 5000;
+  coco_random_state_t *random_generator = coco_random_new(12);
+  mo_front_t *front = mo_front_allocate();
+  mo_front_position_t position;
+  double *y = coco_allocate_vector(2 * number_of_solutions);
+  size_t *archive = coco_allocate_vector_size_t(number_of_solutions);
+  size_t i, j, k, archive_size = 0, number_removed = 0, expected_removed = 0;
+  void *item, *previous_item, *next_item;
+  double t, s;
+  int dominated, inserted;
+
+  for (i = 0; i < number_of_solutions; i++) {
+    /* Points near a front that moves slowly towards the ideal point, so that the front grows large */
+    t = coco_random_uniform(random_generator);
+    s = 1.0 - 0.01 * (double)i / (double)number_of_solutions + 1e-4 * coco_random_uniform(random_generator);
+    y[2 * i] = s * t;
+    y[2 * i + 1] = s * (1 - t);
+
+    /* The brute-force archive */
+    dominated = 0;
+    for (j = 0; j < archive_size; j++) {
+      if (mo_front_get_dominance(&y[2 * i], &y[2 * archive[j]]) < 0) {
+        dominated = 1;
+        break;
+      }
+    }
+    if (!dominated) {
+      for (j = 0, k = 0; j < archive_size; j++) {
+        if (mo_front_get_dominance(&y[2 * i], &y[2 * archive[j]]) == 1)
+          expected_removed++;
+        else
+          archive[k++] = archive[j];
+      }
+      archive_size = k;
+      archive[archive_size++] = i;
+    }
+
+    inserted = mo_front_update(front, &y[2 * i], &y[2 * i], test_mo_front_remove, &number_removed,
+                               &previous_item, &next_item);
+    mu_check(inserted == !dominated);
+    mu_check(number_removed == expected_removed);
+    mu_check(mo_front_get_number_of_points(front) == archive_size);
+    if (inserted) {
+      /* The neighbors are the solutions closest to the new one in the second objective */
+      mu_check((previous_item == NULL) || (((double *)previous_item)[1] < y[2 * i + 1]));
+      mu_check((next_item == NULL) || (((double *)next_item)[1] > y[2 * i + 1]));
+      for (j = 0; j < archive_size; j++) {
+        if (archive[j] == i)
+          continue;
+        if (y[2 * archive[j] + 1] < y[2 * i + 1])
+          mu_check((previous_item != NULL) && (((double *)previous_item)[1] >= y[2 * archive[j] + 1]));
+        else
+          mu_check((next_item != NULL) && (((double *)next_item)[1] <= y[2 * archive[j] + 1]));
+      }
+    }
+  }
+  mu_check(archive_size > 2 * MO_FRONT_BLOCK_SIZE);
+
+  /* The front contains the solutions of the brute-force archive sorted by the second objective */
+  previous_item = NULL;
+  for (item = mo_front_get_first(front, &position), k = 0; item != NULL; item = mo_front_get_next(front, &position)) {
+    for (j = 0; j < archive_size; j++) {
+      if (&y[2 * archive[j]] == item)
+        break;
+    }
+    mu_check(j < archive_size);
+    mu_check((previous_item == NULL) || (((double *)previous_item)[1] < ((double *)item)[1]));
+    previous_item = item;
+    k++;
+  }
+  mu_check(k == archive_size);
+  mu_check(mo_front_get_last(front) == previous_item);
+
+  mo_front_free(front, test_mo_front_remove, &number_removed);
+  mu_check(number_removed == expected_removed + archive_size);
+  coco_free_memory(archive);
+  coco_free_memory(y);
+  coco_random_free(random_generator);
+}
+
 int main(void) {
   MU_RUN_TEST(test_mo_get_norm);
-  MU_RUN_TEST(test_mo_normalize);
-  MU_RUN_TEST(test_mo_get_dominance);
+  MU_RUN_TEST(test_mo_normalize_to);
+  MU_RUN_TEST(test_mo_front_get_dominance);
   MU_RUN_TEST(test_mo_is_within_ROI);
   MU_RUN_TEST(test_mo_get_distance_to_ROI);
+  MU_RUN_TEST(test_mo_avl_tree_node_pool);
+  MU_RUN_TEST(test_mo_front);
 
   MU_REPORT();
 